@@ -306,6 +306,11 @@ public:
 
   virtual bool processGroups();
 
+  /// Returns true if separate instances of the algorithm may execute
+  /// concurrently on the members of WorkspaceGroup inputs. Algorithms must
+  /// opt in to this once they have been checked for shared state.
+  virtual bool isGroupProcessingThreadSafe() const { return false; }
+
   void copyNonWorkspaceProperties(IAlgorithm *alg, int periodNum);
 
   const Parallel::Communicator &communicator() const;
@@ -374,7 +379,7 @@ protected:
 
   friend class WorkspaceHistory; // Allow workspace history loading to adjust
                                  // g_execCount
-  static size_t
+  static std::atomic<size_t>
       g_execCount; ///< Counter to keep track of algorithm execution order
 
   virtual void setOtherProperties(IAlgorithm *alg,
@@ -431,6 +436,18 @@ private:
 
   bool doCallProcessGroups(Mantid::Types::Core::DateAndTime &start_time);
 
+  bool processGroupsInParallel() const;
+
+  std::shared_ptr<Algorithm>
+  createGroupEntryAlgorithm(const size_t entry,
+                            std::vector<std::string> &outputWSNames);
+
+  void executeGroupEntry(IAlgorithm &alg, const size_t entry) const;
+
+  void addToOutputGroups(
+      const std::vector<std::shared_ptr<WorkspaceGroup>> &outGroups,
+      const std::vector<std::string> &outputWSNames) const;
+
   void fillHistory(const std::vector<Workspace_sptr> &outputWorkspaces);
 
   // Report that the algorithm has completed.
@@ -0,0 +1,86 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/IAlgorithm_fwd.h"
+#include "MantidAPI/Workspace_fwd.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** AlgorithmGraph : Executes a directed acyclic graph of algorithms, connected
+  through their workspace properties, running independent branches
+  concurrently.
+
+  Each node is an initialized algorithm whose non-workspace properties have
+  been set. connect() passes an output workspace of one node to an input of
+  another, which must have been added later, so the graph can never contain
+  a cycle. execute() runs every node once its inputs are available on a pool
+  of worker threads, starting the nodes on the longest remaining path first.
+  The OpenMP threads available to a node are shared between the nodes running
+  when it starts, so the cores are not oversubscribed.
+
+  The graph keeps a workspace only until the last node that consumes it has
+  finished, unless it was marked with keepOutput(). Outputs that no node
+  consumes are always kept. The graph releases its reference to each algorithm
+  once it has executed, so holding on to an algorithm elsewhere keeps its
+  workspaces alive.
+*/
+class MANTID_API_DLL AlgorithmGraph {
+public:
+  /// Identifies a node of the graph
+  using NodeID = size_t;
+
+  NodeID addNode(const IAlgorithm_sptr &algorithm);
+  void connect(const NodeID producer, const std::string &outputProperty,
+               const NodeID consumer, const std::string &inputProperty);
+  void keepOutput(const NodeID node, const std::string &outputProperty);
+
+  void execute(size_t maxConcurrentNodes = 0);
+
+  Workspace_sptr getOutput(const NodeID node,
+                           const std::string &outputProperty) const;
+  /// The number of nodes in the graph
+  size_t size() const { return m_nodes.size(); }
+  /// Returns true if execute() has completed successfully
+  bool isExecuted() const { return m_executed; }
+
+private:
+  /// A workspace passed from one node to another
+  struct Edge {
+    NodeID producer;
+    std::string outputProperty;
+    NodeID consumer;
+    std::string inputProperty;
+  };
+
+  struct Node {
+    IAlgorithm_sptr algorithm;
+    /// Indices into m_edges of the workspaces the node consumes and produces
+    std::vector<size_t> inputs, outputs;
+    /// The output workspaces that must outlive their consumers
+    std::vector<std::string> kept;
+    /// The output workspaces, held until their last consumer has finished
+    std::map<std::string, Workspace_sptr> results;
+  };
+
+  void checkNotStarted() const;
+  void checkNode(const NodeID node) const;
+
+  std::vector<Node> m_nodes;
+  std::vector<Edge> m_edges;
+  bool m_started = false;
+  bool m_executed = false;
+};
+
+} // namespace API
+} // namespace Mantid
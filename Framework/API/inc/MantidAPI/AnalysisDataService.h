@@ -16,6 +16,10 @@
 
 #include <Poco/AutoPtr.h>
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 namespace Mantid {
 
 namespace API {
@@ -24,6 +28,7 @@ namespace API {
 // Forward declaration
 //----------------------------------------------------------------------
 
+class MatrixWorkspace;
 class WorkspaceGroup;
 
 /** The Analysis data service stores instances of the Workspace objects and
@@ -39,6 +44,17 @@ class WorkspaceGroup;
     @author L C Chapon, ISIS, Rutherford Appleton Laboratory
 
     Modified to inherit from DataService
+
+    The service can be given a memory budget. When the workspaces it holds
+    need more memory than the budget, the histogram data of the least recently
+    used matrix workspaces that nothing outside the service holds are written
+    to a local binary file and released from the workspace, which stays in the
+    service. The workspace reads its data back the next time it is used. numpy
+    arrays wrapping the data of a workspace hold it, so it is not spilled
+    while they exist. Weak handles, such as python handles, do not hold it:
+    the data they see while they use it is freed only once the service is
+    again the only holder. The budget is enforced again as workspaces are
+    added.
 */
 class MANTID_API_DLL AnalysisDataServiceImpl final
     : public Kernel::DataService<API::Workspace> {
@@ -86,6 +102,22 @@ public:
 
   //@}
 
+  /// The memory held by the workspaces and the activity of the memory budget
+  struct MemoryStatistics {
+    /// The memory budget in bytes, or zero if there is no budget
+    size_t budget = 0;
+    /// The memory of the workspaces held in memory, in bytes
+    size_t residentMemory = 0;
+    /// The memory released by spilling workspaces to disk, in bytes
+    size_t spilledMemory = 0;
+    /// The number of workspaces currently spilled to disk
+    size_t spilledWorkspaces = 0;
+    /// The number of times a workspace has been spilled
+    size_t spills = 0;
+    /// The number of times a spilled workspace has been read back
+    size_t reloads = 0;
+  };
+
 public:
   /// Return the list of illegal characters as one string
   const std::string &illegalCharacters() const;
@@ -143,7 +175,40 @@ public:
   std::map<std::string, Workspace_sptr> topLevelItems() const;
   void shutdown() override;
 
+  /** @name Methods to limit the memory held by the service */
+  //@{
+  void setMemoryBudget(size_t bytes);
+  size_t memoryBudget() const;
+  MemoryStatistics memoryStatistics() const;
+  //@}
+
+protected:
+  void prepareForAccess(const Workspace_sptr &workspace) const override;
+  void objectRemoved(const Workspace_sptr &workspace) override;
+
 private:
+  struct SpillCounters;
+  struct SpilledData;
+  /// The memory and spill state of a workspace held by the service
+  struct SpillEntry {
+    std::weak_ptr<Workspace> workspace;
+    /// The value of m_accessCounter when the workspace was last accessed
+    size_t lastAccess = 0;
+    /// The memory of the workspace when it was added or last spilled
+    size_t memory = 0;
+    /// The spilled data, expired once the workspace has read it back
+    std::weak_ptr<SpilledData> spilled;
+    /// True while the released histograms are kept for other holders
+    bool releasedInUse = false;
+  };
+
+  void trackWorkspace(const Workspace_sptr &workspace);
+  size_t residentMemory() const;
+  void enforceMemoryBudget();
+  void discardReleasedHistograms();
+  bool spill(const Workspace_sptr &workspace, SpillEntry &entry);
+  std::string spillFileName();
+
   /// Checks the name is valid, throwing if not
   void verifyName(const std::string &name,
                   const std::shared_ptr<API::WorkspaceGroup> &workspace);
@@ -160,6 +225,22 @@ private:
 
   /// The string of illegal characters
   std::string m_illegalChars;
+  /// The memory budget in bytes, zero if unlimited
+  std::atomic<size_t> m_memoryBudget;
+  /// Guards the spill state below
+  mutable std::mutex m_spillMutex;
+  /// The spill state of each workspace, keyed by its address
+  mutable std::unordered_map<const Workspace *, SpillEntry> m_spillEntries;
+  /// Incremented on each access to order workspaces by their last use
+  mutable size_t m_accessCounter = 0;
+  /// The memory of the workspaces held by the service, spilled or not
+  size_t m_trackedMemory = 0;
+  /// The spilled memory and the number of spills and reloads
+  std::shared_ptr<SpillCounters> m_spillCounters;
+  /// Used to give spill files unique names
+  size_t m_spillFileCounter = 0;
+  /// The number of entries whose released histograms are still kept
+  size_t m_releasedInUse = 0;
 };
 
 using AnalysisDataService =
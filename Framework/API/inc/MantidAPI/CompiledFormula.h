@@ -0,0 +1,159 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** CompiledFormula : A muParser expression compiled once for evaluation over
+  whole arrays.
+
+  The formula is parsed into an expression graph in which common
+  subexpressions are shared and constant subexpressions are folded. It is
+  evaluated a block of points at a time, one operation after another, so
+  that every operation is a simple loop over contiguous arrays that the
+  compiler can vectorise. Subexpressions that depend only on the parameters
+  are evaluated once per call rather than once per point.
+
+  A formula may use variables, which have a value for every point, and
+  parameters, which have one value for all of the points. The derivatives
+  of the formula with respect to the parameters are found symbolically when
+  it is compiled and are evaluated in the same way.
+
+  The syntax and functions are those of the default muParser, with the
+  Mantid extra functions erf and erfc. Formulas using anything else, such as
+  assignments or several comma separated expressions, cannot be compiled and
+  the constructor throws std::invalid_argument, so that callers can fall back
+  to muParser.
+*/
+class MANTID_API_DLL CompiledFormula {
+public:
+  CompiledFormula(const std::string &formula,
+                  const std::vector<std::string> &variables,
+                  const std::vector<std::string> &parameters = {},
+                  const std::map<std::string, double> &constants = {});
+
+  /// @returns The number of variables of the formula
+  size_t numberOfVariables() const { return m_numberOfVariables; }
+  /// @returns The number of parameters of the formula
+  size_t numberOfParameters() const { return m_derivatives.size(); }
+
+  void evaluate(double *out, size_t n,
+                const std::vector<const double *> &variables,
+                const std::vector<double> &parameters = {}) const;
+  void evaluateDerivatives(const std::vector<double *> &derivatives, size_t n,
+                           const std::vector<const double *> &variables,
+                           const std::vector<double> &parameters) const;
+
+private:
+  /// The operations of the nodes of the expression graph
+  enum class Op {
+    Constant,
+    Parameter,
+    Variable,
+    Negate,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+    Less,
+    Greater,
+    LessEqual,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    And,
+    Or,
+    Select,
+    Min,
+    Max,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Sinh,
+    Cosh,
+    Tanh,
+    Asinh,
+    Acosh,
+    Atanh,
+    Exp,
+    Log,
+    Log10,
+    Log2,
+    Sqrt,
+    Abs,
+    Sign,
+    Rint,
+    Erf,
+    Erfc
+  };
+
+  /// A node of the expression graph. Its arguments are always earlier nodes.
+  struct Node {
+    Op op;
+    /// The value of a Constant
+    double value;
+    /// The index of a Parameter or Variable
+    size_t index;
+    /// The number of arguments
+    size_t nArgs;
+    /// The indices of the argument nodes
+    std::array<size_t, 3> args;
+    /// True if the node does not depend on any variable
+    bool uniform;
+  };
+
+  class Parser;
+
+  static const std::map<std::string, Op> &oneArgumentFunctions();
+  static double apply(Op op, double a, double b, double c);
+  size_t node(Op op, std::initializer_list<size_t> args, double value = 0.0,
+              size_t index = 0);
+  size_t constant(double value) { return node(Op::Constant, {}, value); }
+  bool isConstant(size_t index, double value) const;
+  size_t add(size_t lhs, size_t rhs);
+  size_t subtract(size_t lhs, size_t rhs);
+  size_t multiply(size_t lhs, size_t rhs);
+  size_t divide(size_t lhs, size_t rhs);
+  size_t negate(size_t arg);
+  size_t derivative(size_t index, size_t parameter,
+                    std::map<size_t, size_t> &cache);
+  void evaluateRoots(const std::vector<size_t> &roots,
+                     const std::vector<double *> &out, size_t n,
+                     const std::vector<const double *> &variables,
+                     const std::vector<double> &parameters) const;
+
+  /// The nodes of the expression graph
+  std::vector<Node> m_nodes;
+  /// The nodes by their operation, value, index and arguments while the
+  /// graph is being built, so that equal subexpressions are shared
+  std::map<std::tuple<Op, uint64_t, size_t, std::array<size_t, 3>>, size_t>
+      m_lookup;
+  /// The node of the formula
+  size_t m_root;
+  /// The nodes of the derivatives with respect to each parameter
+  std::vector<size_t> m_derivatives;
+  /// The number of variables
+  size_t m_numberOfVariables;
+};
+
+} // namespace API
+} // namespace Mantid
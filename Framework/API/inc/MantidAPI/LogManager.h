@@ -7,10 +7,13 @@
 #pragma once
 
 #include "MantidAPI/DllConfig.h"
+#include "MantidKernel/CaseInsensitiveMap.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/Statistics.h"
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace NeXus {
@@ -93,6 +96,15 @@ public:
   template <class TYPE>
   void addProperty(const std::string &name, const TYPE &value,
                    const std::string &units, bool overwrite = false);
+  /// Add a property that is created when it is first accessed
+  void addDeferredProperty(
+      const std::string &name,
+      std::function<std::unique_ptr<Kernel::Property>()> create,
+      bool overwrite = false);
+  /// Whether the named property has yet to be created
+  bool isDeferredProperty(const std::string &name) const;
+  /// Create all properties that have been deferred
+  void materializeDeferredProperties() const;
 
   /// Does the property exist on the object
   bool hasProperty(const std::string &name) const;
@@ -203,6 +215,8 @@ protected:
   /// Load the run from a NeXus file with a given group name
   void loadNexus(::NeXus::File *file,
                  const std::map<std::string, std::string> &entries);
+  /// Create the named property if it has been deferred
+  void materializeDeferredProperty(const std::string &name) const;
   /// A pointer to a property manager
   std::unique_ptr<Kernel::PropertyManager> m_manager;
   /// Name of the log entry containing the proton charge when retrieved using
@@ -210,6 +224,14 @@ protected:
   static const char *PROTON_CHARGE_LOG_NAME;
 
 private:
+  struct DeferredProperty;
+  /// The properties yet to be created. They are shared with copies of this
+  /// object, so that each is only created once.
+  mutable Kernel::CaseInsensitiveMap<std::shared_ptr<DeferredProperty>>
+      m_deferred;
+  /// Guards m_deferred and the lookups in m_manager that may create one of
+  /// its properties. Recursive as the public methods call each other.
+  mutable std::recursive_mutex m_deferredMutex;
   /// Cache for the retrieved single values
   std::unique_ptr<Kernel::Cache<
       std::pair<std::string, Kernel::Math::StatisticType>, double>>
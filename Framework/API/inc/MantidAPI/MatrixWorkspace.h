@@ -14,6 +14,7 @@
 #include "MantidKernel/EmptyValues.h"
 
 #include <atomic>
+#include <functional>
 #include <mutex>
 
 namespace Mantid {
@@ -128,6 +129,22 @@ public:
   size_t getMemorySize() const override;
   virtual size_t getMemorySizeForXAxes() const;
 
+  /// Reads released histograms back, in workspace index order
+  using HistogramSource =
+      std::function<std::vector<HistogramData::Histogram>()>;
+  /// Stores the histograms of a workspace, returning how to read them back,
+  /// or an empty source if they could not be stored
+  using HistogramStore =
+      std::function<HistogramSource(const MatrixWorkspace &)>;
+  /// Store the histograms elsewhere and set them aside, if the workspace
+  /// supports it. They are read back when the data is next used.
+  virtual bool releaseHistograms(const HistogramStore & /*store*/) {
+    return false;
+  }
+  /// Free the histograms set aside by releaseHistograms(). Only call this
+  /// when nothing can still refer to them.
+  virtual void discardReleasedHistograms() {}
+
   // Section required for iteration
   /// Returns the number of single indexable items in the workspace
   virtual std::size_t size() const = 0;
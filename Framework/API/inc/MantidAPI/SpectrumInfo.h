@@ -11,8 +11,11 @@
 #include "MantidKernel/V3D.h"
 #include "MantidKernel/cow_ptr.h"
 
+#include <array>
+#include <atomic>
+#include <limits>
 #include <memory>
-
+#include <mutex>
 #include <vector>
 
 namespace Mantid {
@@ -44,6 +47,15 @@ class ExperimentInfo;
   are no thread-safety guarantees for write operations (non-const access). Reads
   concurrent with writes or concurrent writes are not allowed.
 
+  In addition to the per-spectrum accessors SpectrumInfo provides bulk,
+  cached geometry columns (l2s(), twoThetas(), difcs(), ...) holding one value
+  per spectrum in a contiguous array. A column is computed in parallel on
+  first access and reused until detector/component positions, rotations or
+  scale factors, or the spectrum grouping change. Entries for which the
+  corresponding per-spectrum accessor would throw (e.g. 2-theta of a monitor or
+  a spectrum without detectors) are NaN. References returned by the column
+  accessors are invalidated by the next call of the same accessor after a
+  geometry or grouping change.
 
   @author Simon Heybrock
   @date 2016
@@ -75,6 +87,15 @@ public:
 
   void setMasked(const size_t index, bool masked);
 
+  const std::vector<double> &l2s() const;
+  const std::vector<double> &twoThetas() const;
+  const std::vector<double> &signedTwoThetas() const;
+  const std::vector<double> &azimuthals() const;
+  const std::vector<double> &difcs() const;
+  const std::vector<double> &eFixeds() const;
+  const std::vector<double> &solidAngles() const;
+  void invalidateGeometryCache() const;
+
   // This is likely to be deprecated/removed with the introduction of
   // Instrument-2.0: The concept of detector groups will probably be dropped so
   // returning a single detector for a spectrum will not be possible anymore.
@@ -98,12 +119,45 @@ private:
   const SpectrumDefinition &
   checkAndGetSpectrumDefinition(const size_t index) const;
 
+  enum class GeometryColumn : size_t {
+    L2,
+    TwoTheta,
+    SignedTwoTheta,
+    Azimuthal,
+    DIFC,
+    EFixed,
+    SolidAngle,
+    NumberOfColumns
+  };
+  /// One bulk geometry column and the state it was computed for.
+  struct CachedColumn {
+    std::vector<double> values;
+    bool valid{false};
+    size_t geometryRevision{0};
+    size_t groupingRevision{0};
+    size_t parameterMapRevision{0};
+    double parameter{std::numeric_limits<double>::quiet_NaN()};
+  };
+  const std::vector<double> &
+  cachedColumn(const GeometryColumn column,
+               const double parameter =
+                   std::numeric_limits<double>::quiet_NaN()) const;
+  double computeColumnValue(const GeometryColumn column,
+                            const SpectrumDefinition &spectrumDefinition,
+                            const double parameter) const;
+
   const ExperimentInfo &m_experimentInfo;
   Geometry::DetectorInfo &m_detectorInfo;
   const Beamline::SpectrumInfo &m_spectrumInfo;
   mutable std::vector<std::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+
+  mutable std::array<CachedColumn,
+                     static_cast<size_t>(GeometryColumn::NumberOfColumns)>
+      m_geometryColumns;
+  mutable std::mutex m_geometryColumnsMutex;
+  mutable std::atomic<size_t> m_groupingRevision{0};
 };
 
 using SpectrumInfoIt = SpectrumInfoIterator<SpectrumInfo>;
@@ -10,7 +10,9 @@
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/DeprecatedAlgorithm.h"
+#include "MantidAPI/FileProperty.h"
 #include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/MultipleFileProperty.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/WorkspaceHistory.h"
 
@@ -21,6 +23,7 @@
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/Timer.h"
+#include "MantidKernel/Tracing.h"
 #include "MantidKernel/UsageService.h"
 
 #include "MantidParallel/Communicator.h"
@@ -103,7 +106,7 @@ template MANTID_API_DLL bool Algorithm::isEmpty<std::size_t>(const std::size_t);
 //=============================================================================================
 
 /// Initialize static algorithm counter
-size_t Algorithm::g_execCount = 0;
+std::atomic<size_t> Algorithm::g_execCount{0};
 
 /// Constructor
 Algorithm::Algorithm()
@@ -539,6 +542,10 @@ void Algorithm::clearWorkspaceCaches() {
  */
 
 bool Algorithm::executeInternal() {
+  // Child algorithms run on the same thread so their spans nest in this one
+  Tracing::Span traceSpan(name(), "algorithm");
+  traceSpan.addArgument("version", version());
+  traceSpan.addArgument("child", m_isChildAlgorithm ? 1. : 0.);
   Timer timer;
   bool algIsExecuted = false;
   AlgorithmManager::Instance().notifyAlgorithmStarting(this->getAlgorithmID());
@@ -679,6 +686,7 @@ bool Algorithm::executeInternal() {
       startTime = Mantid::Types::Core::DateAndTime::getCurrentTime();
       // Call the concrete algorithm's exec method
       this->exec(executionMode);
+      Tracing::recordMemoryUsage();
       registerFeatureUsage();
       // Check for a cancellation request in case the concrete algorithm doesn't
       interruption_point();
@@ -1453,147 +1461,237 @@ bool Algorithm::processGroups() {
     }
   }
 
-  double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
-  // Go through each entry in the input group(s)
-  for (size_t entry = 0; entry < m_groupSize; entry++) {
-    // use create Child Algorithm that look like this one
-    Algorithm_sptr alg_sptr = this->createChildAlgorithm(
-        this->name(), progress_proportion * static_cast<double>(entry),
-        progress_proportion * (1 + static_cast<double>(entry)),
-        this->isLogging(), this->version());
-    // Make a child algorithm and turn off history recording for it, but always
-    // store result in the ADS
-    alg_sptr->setChild(true);
-    alg_sptr->setAlwaysStoreInADS(true);
-    alg_sptr->enableHistoryRecordingForChild(false);
-    alg_sptr->setRethrows(true);
-
-    IAlgorithm *alg = alg_sptr.get();
-    // Set all non-workspace properties
-    this->copyNonWorkspaceProperties(alg, int(entry) + 1);
-
-    std::string outputBaseName;
-
-    // ---------- Set all the input workspaces ----------------------------
-    for (size_t iwp = 0; iwp < m_unrolledInputWorkspaces.size(); iwp++) {
-      std::vector<Workspace_sptr> &thisGroup = m_unrolledInputWorkspaces[iwp];
-      if (!thisGroup.empty()) {
-        // By default (for a single group) point to the first/only workspace
-        Workspace_sptr ws = thisGroup[0];
-
-        if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
-          // Either: this is the single group
-          // OR: all inputs are groups
-          // ... so get then entry^th workspace in this group
-          if (entry < thisGroup.size()) {
-            ws = thisGroup[entry];
-          } else {
-            // This can happen when one has more than one input group
-            // workspaces, having different sizes. For example one workspace
-            // group is the corrections which has N parts (e.g. weights for
-            // polarized measurement) while the other one is the actual input
-            // workspace group, where each item needs to be corrected together
-            // with all N inputs of the second group. In this case processGroup
-            // needs to be overridden, which is currently not possible in
-            // python.
-            throw std::runtime_error(
-                "Unable to process over groups; consider passing workspaces "
-                "one-by-one or override processGroup method of the algorithm.");
-          }
-        }
-        // Append the names together
-        if (!outputBaseName.empty())
-          outputBaseName += "_";
-        outputBaseName += ws->getName();
-
-        // Set the property using the name of that workspace
-        if (auto *prop = dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
-          if (ws->getName().empty()) {
-            alg->setProperty(prop->name(), ws);
-          } else {
-            alg->setPropertyValue(prop->name(), ws->getName());
-          }
+  // Serially, or concurrently, execute the algorithm on each entry in the
+  // input group(s)
+  std::vector<std::vector<std::string>> outputWSNames(m_groupSize);
+  if (processGroupsInParallel()) {
+    // Child algorithms are created up front as creating them is not thread
+    // safe
+    std::vector<Algorithm_sptr> algorithms(m_groupSize);
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      algorithms[entry] =
+          createGroupEntryAlgorithm(entry, outputWSNames[entry]);
+    }
+
+    std::vector<std::exception_ptr> errors(m_groupSize);
+    const auto groupSize = static_cast<int64_t>(m_groupSize);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t entry = 0; entry < groupSize; ++entry) {
+      try {
+        executeGroupEntry(*algorithms[entry], static_cast<size_t>(entry));
+      } catch (...) {
+        errors[entry] = std::current_exception();
+      }
+    }
+
+    // Fill the output groups in order, stopping at the first failure as the
+    // serial loop would
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      if (errors[entry])
+        std::rethrow_exception(errors[entry]);
+      addToOutputGroups(outGroups, outputWSNames[entry]);
+    }
+  } else {
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      auto alg = createGroupEntryAlgorithm(entry, outputWSNames[entry]);
+      executeGroupEntry(*alg, entry);
+      // this has to be done after execute() because a workspace must exist
+      // when it is added to a group
+      addToOutputGroups(outGroups, outputWSNames[entry]);
+    }
+  }
+
+  // restore group notifications
+  for (auto &outGroup : outGroups) {
+    outGroup->observeADSNotifications(true);
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------------------------------
+/** Returns true if the base processGroups() should execute the members of the
+ * group(s) concurrently. This is enabled by algorithms.processgroups.parallel
+ * for algorithms that have opted in through isGroupProcessingThreadSafe(),
+ * are not given in/out workspaces, which could be shared between members, and
+ * do not access files, as the NeXus and HDF libraries are not thread safe.
+ */
+bool Algorithm::processGroupsInParallel() const {
+  if (m_groupSize < 2 || !isGroupProcessingThreadSafe())
+    return false;
+  const auto enabled = ConfigService::Instance().getValue<bool>(
+      "algorithms.processgroups.parallel");
+  if (!enabled.get_value_or(false))
+    return false;
+  const auto isSetInOut = [](IWorkspaceProperty *wsProp) {
+    const auto *prop = dynamic_cast<Property *>(wsProp);
+    return prop && prop->direction() == Direction::InOut &&
+           !prop->value().empty();
+  };
+  if (std::any_of(m_outputWorkspaceProps.cbegin(),
+                  m_outputWorkspaceProps.cend(), isSetInOut))
+    return false;
+  const auto &props = getProperties();
+  return std::none_of(props.cbegin(), props.cend(), [](const Property *prop) {
+    return dynamic_cast<const FileProperty *>(prop) ||
+           dynamic_cast<const MultipleFileProperty *>(prop);
+  });
+}
+
+/** Create the child algorithm that processes one entry of the group(s)
+ *
+ * @param entry :: The index of the entry in the group(s)
+ * @param outputWSNames :: Set to the names of the output workspaces
+ * @return the child algorithm, with all of its properties set
+ */
+Algorithm_sptr
+Algorithm::createGroupEntryAlgorithm(const size_t entry,
+                                     std::vector<std::string> &outputWSNames) {
+  const double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
+  // use create Child Algorithm that look like this one
+  Algorithm_sptr alg_sptr = this->createChildAlgorithm(
+      this->name(), progress_proportion * static_cast<double>(entry),
+      progress_proportion * (1 + static_cast<double>(entry)),
+      this->isLogging(), this->version());
+  // Make a child algorithm and turn off history recording for it, but always
+  // store result in the ADS
+  alg_sptr->setChild(true);
+  alg_sptr->setAlwaysStoreInADS(true);
+  alg_sptr->enableHistoryRecordingForChild(false);
+  alg_sptr->setRethrows(true);
+
+  IAlgorithm *alg = alg_sptr.get();
+  // Set all non-workspace properties
+  this->copyNonWorkspaceProperties(alg, int(entry) + 1);
+
+  std::string outputBaseName;
+
+  // ---------- Set all the input workspaces ----------------------------
+  for (size_t iwp = 0; iwp < m_unrolledInputWorkspaces.size(); iwp++) {
+    std::vector<Workspace_sptr> &thisGroup = m_unrolledInputWorkspaces[iwp];
+    if (!thisGroup.empty()) {
+      // By default (for a single group) point to the first/only workspace
+      Workspace_sptr ws = thisGroup[0];
+
+      if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
+        // Either: this is the single group
+        // OR: all inputs are groups
+        // ... so get then entry^th workspace in this group
+        if (entry < thisGroup.size()) {
+          ws = thisGroup[entry];
         } else {
-          throw std::logic_error("Found a Workspace property which doesn't "
-                                 "inherit from Property.");
+          // This can happen when one has more than one input group
+          // workspaces, having different sizes. For example one workspace
+          // group is the corrections which has N parts (e.g. weights for
+          // polarized measurement) while the other one is the actual input
+          // workspace group, where each item needs to be corrected together
+          // with all N inputs of the second group. In this case processGroup
+          // needs to be overridden, which is currently not possible in
+          // python.
+          throw std::runtime_error(
+              "Unable to process over groups; consider passing workspaces "
+              "one-by-one or override processGroup method of the algorithm.");
         }
-      } // not an empty (i.e. optional) input
-    }   // for each InputWorkspace property
-
-    std::vector<std::string> outputWSNames(m_pureOutputWorkspaceProps.size());
-    // ---------- Set all the output workspaces ----------------------------
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      if (auto *prop =
-              dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
-        // Default name = "in1_in2_out"
-        const std::string inName = prop->value();
-        if (inName.empty())
-          continue;
-        std::string outName;
-        if (m_groupsHaveSimilarNames) {
-          outName.append(inName).append("_").append(
-              Strings::toString(entry + 1));
+      }
+      // Append the names together
+      if (!outputBaseName.empty())
+        outputBaseName += "_";
+      outputBaseName += ws->getName();
+
+      // Set the property using the name of that workspace
+      if (auto *prop = dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
+        if (ws->getName().empty()) {
+          alg->setProperty(prop->name(), ws);
         } else {
-          outName.append(outputBaseName).append("_").append(inName);
+          alg->setPropertyValue(prop->name(), ws->getName());
         }
-
-        auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
-                                      m_inputWorkspaceProps.end(),
-                                      WorkspacePropertyValueIs(inName));
-
-        // Overwrite workspaces in any input property if they have the same
-        // name as an output (i.e. copy name button in algorithm dialog used)
-        // (only need to do this for a single input, multiple will be handled
-        // by ADS)
-        if (inputProp != m_inputWorkspaceProps.end()) {
-          const auto &inputGroup =
-              m_unrolledInputWorkspaces[inputProp -
-                                        m_inputWorkspaceProps.begin()];
-          if (!inputGroup.empty())
-            outName = inputGroup[entry]->getName();
-        }
-        // Except if all inputs had similar names, then the name is "out_1"
-
-        // Set in the output
-        alg->setPropertyValue(prop->name(), outName);
-
-        outputWSNames[owp] = outName;
       } else {
         throw std::logic_error("Found a Workspace property which doesn't "
                                "inherit from Property.");
       }
-    } // for each OutputWorkspace property
+    } // not an empty (i.e. optional) input
+  }   // for each InputWorkspace property
+
+  outputWSNames.assign(m_pureOutputWorkspaceProps.size(), "");
+  // ---------- Set all the output workspaces ----------------------------
+  for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+    if (auto *prop =
+            dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
+      // Default name = "in1_in2_out"
+      const std::string inName = prop->value();
+      if (inName.empty())
+        continue;
+      std::string outName;
+      if (m_groupsHaveSimilarNames) {
+        outName.append(inName).append("_").append(Strings::toString(entry + 1));
+      } else {
+        outName.append(outputBaseName).append("_").append(inName);
+      }
 
-    // ------------ Execute the algo --------------
-    try {
-      alg->execute();
-    } catch (std::exception &e) {
-      std::ostringstream msg;
-      msg << "Execution of " << this->name() << " for group entry "
-          << (entry + 1) << " failed: ";
-      msg << e.what(); // Add original message
-      throw std::runtime_error(msg.str());
-    }
+      auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
+                                    m_inputWorkspaceProps.end(),
+                                    WorkspacePropertyValueIs(inName));
+
+      // Overwrite workspaces in any input property if they have the same
+      // name as an output (i.e. copy name button in algorithm dialog used)
+      // (only need to do this for a single input, multiple will be handled
+      // by ADS)
+      if (inputProp != m_inputWorkspaceProps.end()) {
+        const auto &inputGroup =
+            m_unrolledInputWorkspaces[inputProp -
+                                      m_inputWorkspaceProps.begin()];
+        if (!inputGroup.empty())
+          outName = inputGroup[entry]->getName();
+      }
+      // Except if all inputs had similar names, then the name is "out_1"
 
-    // ------------ Fill in the output workspace group ------------------
-    // this has to be done after execute() because a workspace must exist
-    // when it is added to a group
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      auto *prop = dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp]);
-      if (prop && prop->value().empty())
-        continue;
-      // And add it to the output group
-      outGroups[owp]->add(outputWSNames[owp]);
+      // Set in the output
+      alg->setPropertyValue(prop->name(), outName);
+
+      outputWSNames[owp] = outName;
+    } else {
+      throw std::logic_error("Found a Workspace property which doesn't "
+                             "inherit from Property.");
     }
+  } // for each OutputWorkspace property
 
-  } // for each entry in each group
+  return alg_sptr;
+}
 
-  // restore group notifications
-  for (auto &outGroup : outGroups) {
-    outGroup->observeADSNotifications(true);
+/** Execute the child algorithm for one entry of the group(s)
+ *
+ * @param alg :: The algorithm from createGroupEntryAlgorithm()
+ * @param entry :: The index of the entry in the group(s)
+ * @throw std::runtime_error if the execution fails
+ */
+void Algorithm::executeGroupEntry(IAlgorithm &alg, const size_t entry) const {
+  try {
+    alg.execute();
+  } catch (std::exception &e) {
+    std::ostringstream msg;
+    msg << "Execution of " << this->name() << " for group entry "
+        << (entry + 1) << " failed: ";
+    msg << e.what(); // Add original message
+    throw std::runtime_error(msg.str());
   }
+}
 
-  return true;
+/** Add the outputs of one entry to the output workspace group(s)
+ *
+ * @param outGroups :: The output groups, one for each output property that
+ * is set
+ * @param outputWSNames :: The names of the entry's output workspaces
+ */
+void Algorithm::addToOutputGroups(
+    const std::vector<WorkspaceGroup_sptr> &outGroups,
+    const std::vector<std::string> &outputWSNames) const {
+  for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+    auto *prop = dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp]);
+    if (prop && prop->value().empty())
+      continue;
+    // And add it to the output group
+    outGroups[owp]->add(outputWSNames[owp]);
+  }
 }
 
 //--------------------------------------------------------------------------------------------
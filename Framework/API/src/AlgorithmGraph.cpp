@@ -0,0 +1,311 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/IAlgorithm.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/Workspace.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Property.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace Mantid {
+namespace API {
+
+using Kernel::Direction;
+using Kernel::Property;
+
+namespace {
+/**
+ * Returns the named workspace property of an algorithm
+ * @param algorithm :: The algorithm
+ * @param name :: The name of the property
+ * @param output :: True for an output property, false for an input
+ * @throws std::invalid_argument if it is not a workspace property in that
+ * direction
+ */
+IWorkspaceProperty *workspaceProperty(const IAlgorithm &algorithm,
+                                      const std::string &name,
+                                      const bool output) {
+  Property *prop = algorithm.getPointerToProperty(name);
+  auto *wsProp = dynamic_cast<IWorkspaceProperty *>(prop);
+  const bool isInput = prop->direction() != Direction::Output;
+  const bool isOutput = prop->direction() != Direction::Input;
+  if (!wsProp || (output ? !isOutput : !isInput)) {
+    throw std::invalid_argument(name + " is not an " +
+                                (output ? "output" : "input") +
+                                " workspace property of " + algorithm.name());
+  }
+  return wsProp;
+}
+} // namespace
+
+/**
+ * Add an algorithm to the graph. It is initialized if necessary and is
+ * executed as a child algorithm, so that its outputs are not stored in the
+ * analysis data service.
+ * @param algorithm :: The algorithm, with its non-workspace properties set
+ * @returns The ID of the new node
+ */
+AlgorithmGraph::NodeID
+AlgorithmGraph::addNode(const IAlgorithm_sptr &algorithm) {
+  if (!algorithm)
+    throw std::invalid_argument("Cannot add an empty algorithm to the graph");
+  checkNotStarted();
+  if (!algorithm->isInitialized())
+    algorithm->initialize();
+  algorithm->setChild(true);
+  algorithm->setRethrows(true);
+  // Give nameless outputs a temporary name to satisfy the validators, as for
+  // any child algorithm
+  for (auto *prop : algorithm->getProperties()) {
+    auto *wsProp = dynamic_cast<IWorkspaceProperty *>(prop);
+    if (wsProp && prop->direction() == Direction::Output &&
+        prop->value().empty() && !wsProp->isOptional()) {
+      prop->createTemporaryValue();
+    }
+  }
+  m_nodes.emplace_back();
+  m_nodes.back().algorithm = algorithm;
+  return m_nodes.size() - 1;
+}
+
+/**
+ * Pass an output workspace of one node to an input of another
+ * @param producer :: The node that creates the workspace
+ * @param outputProperty :: The name of the producer's output property
+ * @param consumer :: The node that uses the workspace. It must have been added
+ * after the producer
+ * @param inputProperty :: The name of the consumer's input property
+ */
+void AlgorithmGraph::connect(const NodeID producer,
+                             const std::string &outputProperty,
+                             const NodeID consumer,
+                             const std::string &inputProperty) {
+  checkNotStarted();
+  checkNode(producer);
+  checkNode(consumer);
+  if (producer >= consumer) {
+    throw std::invalid_argument(
+        "A node can only consume the outputs of nodes added before it");
+  }
+  workspaceProperty(*m_nodes[producer].algorithm, outputProperty, true);
+  workspaceProperty(*m_nodes[consumer].algorithm, inputProperty, false);
+  m_nodes[producer].outputs.emplace_back(m_edges.size());
+  m_nodes[consumer].inputs.emplace_back(m_edges.size());
+  m_edges.push_back({producer, outputProperty, consumer, inputProperty});
+}
+
+/**
+ * Keep an output workspace after the nodes consuming it have finished, so
+ * that it can be retrieved with getOutput()
+ * @param node :: The node that creates the workspace
+ * @param outputProperty :: The name of the node's output property
+ */
+void AlgorithmGraph::keepOutput(const NodeID node,
+                                const std::string &outputProperty) {
+  checkNotStarted();
+  checkNode(node);
+  workspaceProperty(*m_nodes[node].algorithm, outputProperty, true);
+  m_nodes[node].kept.emplace_back(outputProperty);
+}
+
+/**
+ * Execute every node of the graph, each once all of its inputs are available.
+ * If a node fails, no further nodes are started and the error is rethrown once
+ * the running nodes have finished. A graph can only be executed once.
+ * @param maxConcurrentNodes :: The maximum number of nodes to run at the same
+ * time. If zero, the number of OpenMP threads is used.
+ */
+void AlgorithmGraph::execute(size_t maxConcurrentNodes) {
+  checkNotStarted();
+  m_started = true;
+  const size_t numNodes = m_nodes.size();
+  const int cores = std::max(1, PARALLEL_GET_MAX_THREADS);
+  if (maxConcurrentNodes == 0)
+    maxConcurrentNodes = static_cast<size_t>(cores);
+
+  // The longest path from each node to the end of the graph. Consumers are
+  // always added after their producers, so one backwards pass is enough
+  std::vector<size_t> pathLength(numNodes, 1);
+  for (size_t id = numNodes; id-- > 0;) {
+    for (const auto edge : m_nodes[id].outputs) {
+      pathLength[id] =
+          std::max(pathLength[id], pathLength[m_edges[edge].consumer] + 1);
+    }
+  }
+
+  // The number of unfinished producers of each node and of unfinished
+  // consumers of each output
+  std::vector<size_t> waiting(numNodes);
+  std::map<std::pair<NodeID, std::string>, size_t> consumers;
+  std::vector<NodeID> ready;
+  for (NodeID id = 0; id < numNodes; ++id) {
+    waiting[id] = m_nodes[id].inputs.size();
+    if (waiting[id] == 0)
+      ready.emplace_back(id);
+  }
+  for (const auto &edge : m_edges)
+    ++consumers[{edge.producer, edge.outputProperty}];
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  size_t running = 0;
+  size_t remaining = numNodes;
+  std::exception_ptr error;
+
+  // Runs a node and collects its outputs. Called without the lock held
+  const auto runNode = [this](const NodeID id, const int threads) {
+    auto &node = m_nodes[id];
+    const std::string name = node.algorithm->name();
+    try {
+      PARALLEL_SET_NUM_THREADS(threads);
+      node.algorithm->execute();
+      if (!node.algorithm->isExecuted())
+        throw std::runtime_error("The algorithm did not complete");
+      for (auto *prop : node.algorithm->getProperties()) {
+        auto *wsProp = dynamic_cast<IWorkspaceProperty *>(prop);
+        if (wsProp && prop->direction() != Direction::Input) {
+          if (auto workspace = wsProp->getWorkspace())
+            node.results[prop->name()] = std::move(workspace);
+        }
+      }
+      for (const auto edge : node.outputs) {
+        if (node.results.count(m_edges[edge].outputProperty) == 0) {
+          throw std::runtime_error("No workspace was created for " +
+                                   m_edges[edge].outputProperty);
+        }
+      }
+    } catch (std::exception &e) {
+      throw std::runtime_error("Execution of " + name + " (node " +
+                               std::to_string(id) + ") failed: " + e.what());
+    }
+    // Inputs and outputs are now held only by the graph
+    node.algorithm.reset();
+  };
+
+  // Passes the outputs of a node on and releases its inputs. Called with the
+  // lock held
+  const auto finishNode = [&](const NodeID id) {
+    auto &node = m_nodes[id];
+    for (const auto edge : node.outputs) {
+      const auto &connection = m_edges[edge];
+      m_nodes[connection.consumer].algorithm->setProperty(
+          connection.inputProperty, node.results[connection.outputProperty]);
+      if (--waiting[connection.consumer] == 0)
+        ready.emplace_back(connection.consumer);
+    }
+    for (const auto edge : node.inputs) {
+      const auto &connection = m_edges[edge];
+      auto &producer = m_nodes[connection.producer];
+      const auto &kept = producer.kept;
+      if (--consumers[{connection.producer, connection.outputProperty}] == 0 &&
+          std::find(kept.cbegin(), kept.cend(), connection.outputProperty) ==
+              kept.cend()) {
+        producer.results.erase(connection.outputProperty);
+      }
+    }
+  };
+
+  const auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      changed.wait(lock,
+                   [&]() { return !ready.empty() || remaining == 0 || error; });
+      if (remaining == 0 || error)
+        return;
+      // Start the node with the longest path ahead of it
+      const auto next = std::max_element(
+          ready.begin(), ready.end(), [&](const NodeID a, const NodeID b) {
+            return pathLength[a] < pathLength[b];
+          });
+      const NodeID id = *next;
+      ready.erase(next);
+      ++running;
+      // Share the cores between the nodes that are running
+      const int threads = std::max(1, cores / static_cast<int>(running));
+
+      lock.unlock();
+      std::exception_ptr failure;
+      try {
+        runNode(id, threads);
+      } catch (...) {
+        failure = std::current_exception();
+      }
+      lock.lock();
+
+      --running;
+      --remaining;
+      if (!failure) {
+        try {
+          finishNode(id);
+        } catch (...) {
+          failure = std::current_exception();
+        }
+      }
+      if (failure && !error)
+        error = failure;
+      changed.notify_all();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  const size_t numWorkers = std::min(maxConcurrentNodes, numNodes);
+  workers.reserve(numWorkers);
+  for (size_t i = 0; i < numWorkers; ++i)
+    workers.emplace_back(worker);
+  for (auto &thread : workers)
+    thread.join();
+
+  if (error)
+    std::rethrow_exception(error);
+  m_executed = true;
+}
+
+/**
+ * Returns an output workspace of a node once the graph has been executed
+ * @param node :: The node that created the workspace
+ * @param outputProperty :: The name of the node's output property
+ * @returns The workspace
+ * @throws std::invalid_argument if the graph does not hold the workspace
+ */
+Workspace_sptr
+AlgorithmGraph::getOutput(const NodeID node,
+                          const std::string &outputProperty) const {
+  checkNode(node);
+  const auto &results = m_nodes[node].results;
+  const auto result = results.find(outputProperty);
+  if (!m_executed || result == results.cend()) {
+    throw std::invalid_argument(
+        "Node " + std::to_string(node) + " holds no output " +
+        outputProperty +
+        ". Outputs that are consumed by other nodes must be kept with "
+        "keepOutput() before the graph is executed");
+  }
+  return result->second;
+}
+
+/// @throws std::runtime_error if execute() has been called
+void AlgorithmGraph::checkNotStarted() const {
+  if (m_started)
+    throw std::runtime_error("The graph has already been executed");
+}
+
+/// @throws std::out_of_range if the node is not part of the graph
+void AlgorithmGraph::checkNode(const NodeID node) const {
+  if (node >= m_nodes.size()) {
+    throw std::out_of_range("The graph has no node " + std::to_string(node));
+  }
+}
+
+} // namespace API
+} // namespace Mantid
@@ -5,13 +5,166 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <iterator>
 #include <sstream>
 
 namespace Mantid {
 namespace API {
 
+using HistogramData::Histogram;
+
+namespace {
+/// Logger for the memory budget
+Kernel::Logger g_spillLog("AnalysisDataService");
+
+template <typename T> void writeValue(std::ostream &out, const T value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> T readValue(std::istream &in) {
+  T value{};
+  in.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return value;
+}
+
+void writeValues(std::ostream &out, const std::vector<double> &values) {
+  writeValue<uint64_t>(out, values.size());
+  out.write(reinterpret_cast<const char *>(values.data()),
+            static_cast<std::streamsize>(values.size() * sizeof(double)));
+}
+
+std::vector<double> readValues(std::istream &in) {
+  std::vector<double> values(static_cast<size_t>(readValue<uint64_t>(in)));
+  in.read(reinterpret_cast<char *>(values.data()),
+          static_cast<std::streamsize>(values.size() * sizeof(double)));
+  return values;
+}
+
+/**
+ * Write the histograms of a workspace to a stream. Spectra sharing their X
+ * data with the previous spectrum are flagged so the sharing can be restored.
+ */
+void writeHistograms(std::ostream &out, const MatrixWorkspace &workspace) {
+  const size_t numberOfHistograms = workspace.getNumberHistograms();
+  writeValue<uint64_t>(out, numberOfHistograms);
+  for (size_t i = 0; i < numberOfHistograms; ++i) {
+    const auto histogram = workspace.histogram(i);
+    const bool sharesX = i > 0 && &workspace.x(i) == &workspace.x(i - 1);
+    const bool hasDx = static_cast<bool>(histogram.sharedDx());
+    writeValue(out, static_cast<uint8_t>(histogram.xMode()));
+    writeValue(out, static_cast<uint8_t>(histogram.yMode()));
+    writeValue(out, static_cast<uint8_t>(sharesX));
+    writeValue(out, static_cast<uint8_t>(hasDx));
+    if (!sharesX)
+      writeValues(out, histogram.x().rawData());
+    writeValues(out, histogram.y().rawData());
+    writeValues(out, histogram.e().rawData());
+    if (hasDx)
+      writeValues(out, histogram.dx().rawData());
+  }
+}
+
+/// Read the histograms written by writeHistograms
+std::vector<Histogram> readHistograms(std::istream &in,
+                                      const size_t expectedHistograms) {
+  const auto numberOfHistograms = readValue<uint64_t>(in);
+  if (!in || numberOfHistograms != expectedHistograms)
+    throw std::runtime_error("The spill file does not match the workspace");
+  std::vector<Histogram> histograms;
+  histograms.reserve(expectedHistograms);
+  Kernel::cow_ptr<HistogramData::HistogramX> x(nullptr);
+  for (size_t i = 0; i < numberOfHistograms; ++i) {
+    const auto xMode = static_cast<Histogram::XMode>(readValue<uint8_t>(in));
+    const auto yMode = static_cast<Histogram::YMode>(readValue<uint8_t>(in));
+    const bool sharesX = readValue<uint8_t>(in) != 0;
+    const bool hasDx = readValue<uint8_t>(in) != 0;
+    if (!sharesX)
+      x = Kernel::make_cow<HistogramData::HistogramX>(readValues(in));
+    Histogram histogram = xMode == Histogram::XMode::BinEdges
+                              ? Histogram(HistogramData::BinEdges(x))
+                              : Histogram(HistogramData::Points(x));
+    // Y can only be set once the mode is known
+    histogram.setYMode(yMode == Histogram::YMode::Uninitialized
+                           ? Histogram::YMode::Counts
+                           : yMode);
+    histogram.setSharedY(
+        Kernel::make_cow<HistogramData::HistogramY>(readValues(in)));
+    histogram.setSharedE(
+        Kernel::make_cow<HistogramData::HistogramE>(readValues(in)));
+    if (hasDx) {
+      histogram.setSharedDx(
+          Kernel::make_cow<HistogramData::HistogramDx>(readValues(in)));
+    }
+    histogram.setYMode(yMode);
+    if (!in)
+      throw std::runtime_error("The spill file is truncated");
+    histograms.emplace_back(std::move(histogram));
+  }
+  return histograms;
+}
+
+/// Delete a spill file, warning if that is not possible
+void removeSpillFile(const std::string &filename) {
+  try {
+    Poco::File(filename).remove();
+  } catch (const Poco::Exception &e) {
+    g_spillLog.warning() << "Could not delete spill file " << filename << ": "
+                         << e.displayText() << '\n';
+  }
+}
+} // namespace
+
+/// The statistics of spilled data, shared with the data itself as a
+/// workspace can outlive the service
+struct AnalysisDataServiceImpl::SpillCounters {
+  std::atomic<size_t> spilledMemory{0};
+  std::atomic<size_t> spilledWorkspaces{0};
+  std::atomic<size_t> spills{0};
+  std::atomic<size_t> reloads{0};
+};
+
+/// The spill file of a workspace, deleted with the last reference to it
+struct AnalysisDataServiceImpl::SpilledData {
+  SpilledData(std::string filename, const size_t memorySize,
+              std::shared_ptr<SpillCounters> spillCounters)
+      : file(std::move(filename)), memory(memorySize),
+        counters(std::move(spillCounters)) {
+    counters->spilledMemory += memory;
+    ++counters->spilledWorkspaces;
+  }
+  SpilledData(const SpilledData &) = delete;
+  SpilledData &operator=(const SpilledData &) = delete;
+  ~SpilledData() {
+    uncount();
+    removeSpillFile(file);
+  }
+
+  /// Stop counting the data as spilled by the service, at most once
+  void uncount() {
+    if (counted.exchange(false)) {
+      counters->spilledMemory -= memory;
+      --counters->spilledWorkspaces;
+    }
+  }
+
+  const std::string file;
+  const size_t memory;
+  const std::shared_ptr<SpillCounters> counters;
+  std::atomic<bool> counted{true};
+};
+
 //-------------------------------------------------------------------------
 // Nested class methods
 //-------------------------------------------------------------------------
@@ -79,6 +232,8 @@ void AnalysisDataServiceImpl::add(
   if (workspace)
     workspace->setName(name);
   Kernel::DataService<API::Workspace>::add(name, workspace);
+  trackWorkspace(workspace);
+  enforceMemoryBudget();
 
   // if a group is added add its members as well
   if (!group)
@@ -118,6 +273,8 @@ void AnalysisDataServiceImpl::addOrReplace(
   if (workspace)
     workspace->setName(name);
   Kernel::DataService<API::Workspace>::addOrReplace(name, workspace);
+  trackWorkspace(workspace);
+  enforceMemoryBudget();
 
   if (!group)
     return;
@@ -346,6 +503,77 @@ AnalysisDataServiceImpl::topLevelItems() const {
 
 void AnalysisDataServiceImpl::shutdown() { clear(); }
 
+/**
+ * Set the memory budget of the service. Idle workspaces are spilled to disk
+ * straight away if the workspaces in memory exceed the new budget.
+ * @param bytes :: The budget in bytes, or zero to keep every workspace in
+ * memory. Workspaces that have already been spilled are read back when their
+ * data is next used.
+ */
+void AnalysisDataServiceImpl::setMemoryBudget(const size_t bytes) {
+  m_memoryBudget = bytes;
+  enforceMemoryBudget();
+}
+
+/// @returns The memory budget in bytes, or zero if there is no budget
+size_t AnalysisDataServiceImpl::memoryBudget() const { return m_memoryBudget; }
+
+/**
+ * @returns The memory held by the workspaces in the service and the number of
+ * times workspaces have been spilled to disk and read back
+ */
+AnalysisDataServiceImpl::MemoryStatistics
+AnalysisDataServiceImpl::memoryStatistics() const {
+  MemoryStatistics statistics;
+  statistics.budget = m_memoryBudget;
+  std::lock_guard<std::mutex> lock(m_spillMutex);
+  statistics.residentMemory = residentMemory();
+  statistics.spilledMemory = m_spillCounters->spilledMemory;
+  statistics.spilledWorkspaces = m_spillCounters->spilledWorkspaces;
+  statistics.spills = m_spillCounters->spills;
+  statistics.reloads = m_spillCounters->reloads;
+  return statistics;
+}
+
+//-------------------------------------------------------------------------
+// Protected methods
+//-------------------------------------------------------------------------
+
+/**
+ * Record the access to a workspace for the least recently used ordering. A
+ * spilled workspace reads its data back itself when the data is used.
+ * @param workspace :: A workspace stored in the service
+ */
+void AnalysisDataServiceImpl::prepareForAccess(
+    const Workspace_sptr &workspace) const {
+  if (!workspace || m_memoryBudget == 0)
+    return;
+  std::lock_guard<std::mutex> lock(m_spillMutex);
+  const auto it = m_spillEntries.find(workspace.get());
+  if (it != m_spillEntries.end() && it->second.workspace.lock() == workspace)
+    it->second.lastAccess = ++m_accessCounter;
+}
+
+/**
+ * Stop tracking a workspace that the service no longer holds. Its spill
+ * file, if any, is deleted with the workspace without reading it back.
+ * @param workspace :: The workspace removed from the service
+ */
+void AnalysisDataServiceImpl::objectRemoved(const Workspace_sptr &workspace) {
+  if (!workspace)
+    return;
+  std::lock_guard<std::mutex> lock(m_spillMutex);
+  const auto it = m_spillEntries.find(workspace.get());
+  if (it == m_spillEntries.end() || it->second.workspace.lock() != workspace)
+    return;
+  m_trackedMemory -= std::min(m_trackedMemory, it->second.memory);
+  if (const auto spilled = it->second.spilled.lock())
+    spilled->uncount();
+  if (it->second.releasedInUse)
+    --m_releasedInUse;
+  m_spillEntries.erase(it);
+}
+
 //-------------------------------------------------------------------------
 // Private methods
 //-------------------------------------------------------------------------
@@ -356,7 +584,13 @@ void AnalysisDataServiceImpl::shutdown() { clear(); }
 AnalysisDataServiceImpl::AnalysisDataServiceImpl()
     : Mantid::Kernel::DataService<Mantid::API::Workspace>(
           "AnalysisDataService"),
-      m_illegalChars() {}
+      m_illegalChars(), m_memoryBudget(0),
+      m_spillCounters(std::make_shared<SpillCounters>()) {
+  const auto budget = Kernel::ConfigService::Instance().getValue<double>(
+      "analysisdataservice.memorybudget");
+  if (budget && *budget > 0.)
+    m_memoryBudget = static_cast<size_t>(*budget * 1024. * 1024.);
+}
 
 // The following is commented using /// rather than /** to stop the compiler
 // complaining
@@ -403,5 +637,187 @@ void AnalysisDataServiceImpl::verifyName(
   }
 }
 
+/**
+ * Start tracking the memory of a workspace that has been added to the
+ * service. Groups count as empty as their members are tracked themselves.
+ * @param workspace :: The workspace
+ */
+void AnalysisDataServiceImpl::trackWorkspace(const Workspace_sptr &workspace) {
+  const size_t memory = std::dynamic_pointer_cast<WorkspaceGroup>(workspace)
+                            ? 0
+                            : workspace->getMemorySize();
+  std::lock_guard<std::mutex> lock(m_spillMutex);
+  auto &entry = m_spillEntries[workspace.get()];
+  m_trackedMemory -= std::min(m_trackedMemory, entry.memory);
+  if (entry.workspace.lock() != workspace) {
+    if (entry.releasedInUse)
+      --m_releasedInUse;
+    entry = SpillEntry();
+    entry.workspace = workspace;
+  }
+  entry.memory = memory;
+  entry.lastAccess = ++m_accessCounter;
+  m_trackedMemory += memory;
+}
+
+/**
+ * @returns The memory of the workspaces held by the service that have not
+ * been spilled. Called with the spill mutex held.
+ */
+size_t AnalysisDataServiceImpl::residentMemory() const {
+  const size_t spilled = m_spillCounters->spilledMemory;
+  return m_trackedMemory > spilled ? m_trackedMemory - spilled : 0;
+}
+
+/**
+ * Free the released histograms that were kept because something else held
+ * the workspace when it was spilled, once the service is the only holder.
+ * Called with the spill mutex held.
+ */
+void AnalysisDataServiceImpl::discardReleasedHistograms() {
+  for (auto &item : m_spillEntries) {
+    auto &entry = item.second;
+    if (!entry.releasedInUse)
+      continue;
+    const auto workspace = entry.workspace.lock();
+    // Held only by the service and this function
+    if (workspace && workspace.use_count() > 2)
+      continue;
+    if (workspace)
+      static_cast<MatrixWorkspace &>(*workspace).discardReleasedHistograms();
+    entry.releasedInUse = false;
+    --m_releasedInUse;
+  }
+}
+
+/**
+ * Spill the least recently used idle workspaces to disk until the workspaces
+ * in memory fit within the budget. A workspace is idle if nothing outside the
+ * service holds it. numpy arrays wrapping workspace data hold the workspace,
+ * so they count. The memory of each workspace is tracked as it is added and
+ * spilled, so nothing is measured unless the budget is exceeded.
+ */
+void AnalysisDataServiceImpl::enforceMemoryBudget() {
+  const size_t budget = m_memoryBudget;
+  if (budget == 0)
+    return;
+  std::lock_guard<std::mutex> lock(m_spillMutex);
+  if (m_releasedInUse > 0)
+    discardReleasedHistograms();
+  if (residentMemory() <= budget)
+    return;
+
+  std::vector<std::pair<size_t, Workspace_sptr>> idle;
+  for (const auto &item : m_spillEntries) {
+    const auto &entry = item.second;
+    if (!entry.spilled.expired())
+      continue;
+    auto workspace = entry.workspace.lock();
+    // Held only by the service and this function
+    if (workspace && workspace.use_count() == 2 &&
+        dynamic_cast<const MatrixWorkspace *>(workspace.get()))
+      idle.emplace_back(entry.lastAccess, std::move(workspace));
+  }
+  std::sort(idle.begin(), idle.end(),
+            [](const auto &lhs, const auto &rhs) {
+              return lhs.first < rhs.first;
+            });
+  for (const auto &candidate : idle) {
+    if (residentMemory() <= budget)
+      break;
+    spill(candidate.second, m_spillEntries[candidate.second.get()]);
+  }
+  if (residentMemory() > budget) {
+    g_spillLog.debug() << "Workspaces in use need " << residentMemory()
+                       << " bytes, more than the memory budget of " << budget
+                       << " bytes\n";
+  }
+}
+
+/**
+ * Write the histograms of a workspace to disk and release them from the
+ * workspace, which reads them back when they are next used. The workspace
+ * object itself stays in the service. A weak handle may have been locked
+ * since the workspace was found idle, and data it refers to must stay valid,
+ * so the released histograms are only freed if the service is still the only
+ * holder. Otherwise they are freed by a later call once it is. Called with
+ * the spill mutex held.
+ * @param workspace :: An idle matrix workspace held by the service
+ * @param entry :: Its tracking entry
+ * @returns True if the workspace was spilled
+ */
+bool AnalysisDataServiceImpl::spill(const Workspace_sptr &workspace,
+                                    SpillEntry &entry) {
+  auto &matrixWorkspace = dynamic_cast<MatrixWorkspace &>(*workspace);
+  const size_t memory = matrixWorkspace.getMemorySize();
+  std::shared_ptr<SpilledData> spilled;
+  const auto store =
+      [&](const MatrixWorkspace &matrix) -> MatrixWorkspace::HistogramSource {
+    const std::string filename = spillFileName();
+    {
+      std::ofstream out(filename, std::ios::binary);
+      writeHistograms(out, matrix);
+      if (!out) {
+        g_spillLog.warning() << "Could not spill workspace "
+                             << matrix.getName() << " to " << filename
+                             << '\n';
+        out.close();
+        removeSpillFile(filename);
+        return {};
+      }
+    }
+    spilled = std::make_shared<SpilledData>(filename, memory, m_spillCounters);
+    const size_t numberOfHistograms = matrix.getNumberHistograms();
+    return [spilled, numberOfHistograms]() {
+      std::ifstream in(spilled->file, std::ios::binary);
+      std::vector<Histogram> histograms;
+      try {
+        if (!in)
+          throw std::runtime_error("The spill file cannot be opened");
+        histograms = readHistograms(in, numberOfHistograms);
+      } catch (std::exception &e) {
+        throw std::runtime_error("Could not read spilled data back from " +
+                                 spilled->file + ": " + e.what());
+      }
+      spilled->uncount();
+      ++spilled->counters->reloads;
+      return histograms;
+    };
+  };
+  if (!matrixWorkspace.releaseHistograms(store))
+    return false;
+  // Held only by the service and the caller
+  if (workspace.use_count() > 2) {
+    if (!entry.releasedInUse)
+      ++m_releasedInUse;
+    entry.releasedInUse = true;
+  } else {
+    matrixWorkspace.discardReleasedHistograms();
+  }
+
+  // The workspace was measured again as its data may have changed in place
+  m_trackedMemory -= std::min(m_trackedMemory, entry.memory);
+  m_trackedMemory += memory;
+  entry.memory = memory;
+  entry.spilled = spilled;
+  ++m_spillCounters->spills;
+  g_spillLog.debug() << "Spilled workspace " << workspace->getName() << " to "
+                     << spilled->file << '\n';
+  return true;
+}
+
+/// @returns A new, unique name for a spill file
+std::string AnalysisDataServiceImpl::spillFileName() {
+  auto directory = Kernel::ConfigService::Instance().getString(
+      "analysisdataservice.spilldirectory");
+  if (directory.empty())
+    directory = Poco::Path::temp();
+  Poco::Path path(directory);
+  path.makeDirectory();
+  path.setFileName("mantid_" + std::to_string(Poco::Process::id()) + "_" +
+                   std::to_string(++m_spillFileCounter) + ".spill");
+  return path.toString();
+}
+
 } // Namespace API
 } // Namespace Mantid
@@ -0,0 +1,960 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/CompiledFormula.h"
+
+#include <gsl/gsl_sf_erf.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace API {
+
+namespace {
+/// The number of points evaluated at a time. The intermediate results of a
+/// block stay in the cache.
+constexpr size_t BLOCK_SIZE = 256;
+/// Marks a node without a buffer
+constexpr size_t NO_SLOT = std::numeric_limits<size_t>::max();
+
+bool isNameCharacter(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+double toDouble(bool value) { return value ? 1.0 : 0.0; }
+
+double sign(double value) {
+  return value < 0.0 ? -1.0 : value > 0.0 ? 1.0 : 0.0;
+}
+
+/// An argument of an operation on a block: an array, or a single value when
+/// array is null
+struct Operand {
+  const double *array;
+  double scalar;
+};
+
+template <typename F>
+void unaryLoop(const Operand &a, double *out, size_t n, const F &f) {
+  const double *x = a.array;
+  for (size_t i = 0; i < n; ++i)
+    out[i] = f(x[i]);
+}
+
+template <typename F>
+void binaryLoop(const Operand &a, const Operand &b, double *out, size_t n,
+                const F &f) {
+  if (a.array && b.array) {
+    const double *x = a.array;
+    const double *y = b.array;
+    for (size_t i = 0; i < n; ++i)
+      out[i] = f(x[i], y[i]);
+  } else if (a.array) {
+    const double *x = a.array;
+    const double y = b.scalar;
+    for (size_t i = 0; i < n; ++i)
+      out[i] = f(x[i], y);
+  } else {
+    const double x = a.scalar;
+    const double *y = b.array;
+    for (size_t i = 0; i < n; ++i)
+      out[i] = f(x, y[i]);
+  }
+}
+
+double at(const Operand &a, size_t i) {
+  return a.array ? a.array[i] : a.scalar;
+}
+} // namespace
+
+//----------------------------------------------------------------------------
+// Parser
+//----------------------------------------------------------------------------
+
+/// A recursive descent parser of muParser expressions with muParser's
+/// operator precedence, building the nodes of a CompiledFormula.
+class CompiledFormula::Parser {
+public:
+  Parser(CompiledFormula &formula, const std::string &expression,
+         const std::vector<std::string> &variables,
+         const std::vector<std::string> &parameters,
+         const std::map<std::string, double> &constants)
+      : m_formula(formula), m_expression(expression), m_position(0),
+        m_variables(variables), m_parameters(parameters),
+        m_constants(constants) {
+    m_constants.emplace("_pi", M_PI);
+    m_constants.emplace("_e", M_E);
+  }
+
+  size_t parse() {
+    const size_t result = ternary();
+    skipSpaces();
+    if (m_position != m_expression.size())
+      fail("Unexpected '" + std::string(1, m_expression[m_position]) + "'");
+    return result;
+  }
+
+private:
+  [[noreturn]] void fail(const std::string &message) const {
+    throw std::invalid_argument(message + " at position " +
+                                std::to_string(m_position) +
+                                " of the formula '" + m_expression + "'");
+  }
+
+  void skipSpaces() {
+    while (m_position < m_expression.size() &&
+           std::isspace(static_cast<unsigned char>(m_expression[m_position])))
+      ++m_position;
+  }
+
+  /// Consume the token if it is next
+  bool accept(const char *token) {
+    skipSpaces();
+    const size_t length = std::strlen(token);
+    if (m_expression.compare(m_position, length, token) != 0)
+      return false;
+    m_position += length;
+    return true;
+  }
+
+  void expect(const char *token) {
+    if (!accept(token))
+      fail("Expected '" + std::string(token) + "'");
+  }
+
+  size_t ternary() {
+    const size_t condition = logicalOr();
+    if (!accept("?"))
+      return condition;
+    const size_t ifTrue = ternary();
+    expect(":");
+    const size_t ifFalse = ternary();
+    return m_formula.node(Op::Select, {condition, ifTrue, ifFalse});
+  }
+
+  size_t logicalOr() {
+    size_t result = logicalAnd();
+    while (accept("||"))
+      result = m_formula.node(Op::Or, {result, logicalAnd()});
+    return result;
+  }
+
+  size_t logicalAnd() {
+    size_t result = comparison();
+    while (accept("&&"))
+      result = m_formula.node(Op::And, {result, comparison()});
+    return result;
+  }
+
+  size_t comparison() {
+    size_t result = additive();
+    while (true) {
+      Op op;
+      if (accept("<="))
+        op = Op::LessEqual;
+      else if (accept(">="))
+        op = Op::GreaterEqual;
+      else if (accept("=="))
+        op = Op::Equal;
+      else if (accept("!="))
+        op = Op::NotEqual;
+      else if (accept("<"))
+        op = Op::Less;
+      else if (accept(">"))
+        op = Op::Greater;
+      else
+        return result;
+      result = m_formula.node(op, {result, additive()});
+    }
+  }
+
+  size_t additive() {
+    size_t result = multiplicative();
+    while (true) {
+      if (accept("+"))
+        result = m_formula.node(Op::Add, {result, multiplicative()});
+      else if (accept("-"))
+        result = m_formula.node(Op::Subtract, {result, multiplicative()});
+      else
+        return result;
+    }
+  }
+
+  size_t multiplicative() {
+    size_t result = unary();
+    while (true) {
+      if (accept("*"))
+        result = m_formula.node(Op::Multiply, {result, unary()});
+      else if (accept("/"))
+        result = m_formula.node(Op::Divide, {result, unary()});
+      else
+        return result;
+    }
+  }
+
+  /// Unary signs bind less tightly than powers, so -x^2 is -(x^2)
+  size_t unary() {
+    if (accept("-"))
+      return m_formula.node(Op::Negate, {unary()});
+    if (accept("+"))
+      return unary();
+    return power();
+  }
+
+  /// Powers are right associative
+  size_t power() {
+    const size_t base = primary();
+    if (!accept("^"))
+      return base;
+    return m_formula.node(Op::Power, {base, unary()});
+  }
+
+  size_t primary() {
+    skipSpaces();
+    if (accept("(")) {
+      const size_t result = ternary();
+      expect(")");
+      return result;
+    }
+    if (m_position == m_expression.size())
+      fail("Unexpected end");
+    const char next = m_expression[m_position];
+    if (std::isdigit(static_cast<unsigned char>(next)) || next == '.')
+      return number();
+    if (std::isalpha(static_cast<unsigned char>(next)) || next == '_')
+      return identifier();
+    fail("Unexpected '" + std::string(1, next) + "'");
+  }
+
+  size_t number() {
+    const size_t start = m_position;
+    const auto digits = [this]() {
+      size_t count = 0;
+      while (m_position < m_expression.size() &&
+             std::isdigit(
+                 static_cast<unsigned char>(m_expression[m_position]))) {
+        ++m_position;
+        ++count;
+      }
+      return count;
+    };
+    size_t count = digits();
+    if (m_position < m_expression.size() && m_expression[m_position] == '.') {
+      ++m_position;
+      count += digits();
+    }
+    if (count == 0)
+      fail("Invalid number");
+    if (m_position < m_expression.size() &&
+        (m_expression[m_position] == 'e' || m_expression[m_position] == 'E')) {
+      const size_t mantissaEnd = m_position;
+      ++m_position;
+      if (m_position < m_expression.size() &&
+          (m_expression[m_position] == '+' || m_expression[m_position] == '-'))
+        ++m_position;
+      if (digits() == 0)
+        m_position = mantissaEnd;
+    }
+    return m_formula.constant(
+        std::stod(m_expression.substr(start, m_position - start)));
+  }
+
+  size_t identifier() {
+    const size_t start = m_position;
+    while (m_position < m_expression.size() &&
+           isNameCharacter(m_expression[m_position]))
+      ++m_position;
+    const std::string name = m_expression.substr(start, m_position - start);
+
+    if (accept("("))
+      return function(name);
+
+    const auto variable =
+        std::find(m_variables.cbegin(), m_variables.cend(), name);
+    if (variable != m_variables.cend())
+      return m_formula.node(
+          Op::Variable, {}, 0.0,
+          static_cast<size_t>(std::distance(m_variables.cbegin(), variable)));
+    const auto parameter =
+        std::find(m_parameters.cbegin(), m_parameters.cend(), name);
+    if (parameter != m_parameters.cend())
+      return m_formula.node(
+          Op::Parameter, {}, 0.0,
+          static_cast<size_t>(
+              std::distance(m_parameters.cbegin(), parameter)));
+    const auto constant = m_constants.find(name);
+    if (constant != m_constants.end())
+      return m_formula.constant(constant->second);
+    m_position = start;
+    fail("Unknown name '" + name + "'");
+  }
+
+  /// Parse the arguments of a function, whose opening bracket is consumed
+  size_t function(const std::string &name) {
+    std::vector<size_t> args;
+    if (!accept(")")) {
+      do {
+        args.emplace_back(ternary());
+      } while (accept(","));
+      expect(")");
+    }
+
+    const auto &functions = oneArgumentFunctions();
+    const auto found = functions.find(name);
+    if (found != functions.end()) {
+      if (args.size() != 1)
+        fail("Function '" + name + "' takes one argument");
+      return m_formula.node(found->second, {args.front()});
+    }
+    if (args.empty())
+      fail("Function '" + name + "' needs arguments");
+    if (name == "sum" || name == "avg") {
+      size_t result = args.front();
+      for (auto arg = args.cbegin() + 1; arg != args.cend(); ++arg)
+        result = m_formula.node(Op::Add, {result, *arg});
+      if (name == "avg")
+        result = m_formula.node(
+            Op::Divide,
+            {result, m_formula.constant(static_cast<double>(args.size()))});
+      return result;
+    }
+    if (name == "min" || name == "max") {
+      const Op op = name == "min" ? Op::Min : Op::Max;
+      size_t result = args.front();
+      for (auto arg = args.cbegin() + 1; arg != args.cend(); ++arg)
+        result = m_formula.node(op, {result, *arg});
+      return result;
+    }
+    fail("Unknown function '" + name + "'");
+  }
+
+  CompiledFormula &m_formula;
+  const std::string &m_expression;
+  size_t m_position;
+  const std::vector<std::string> &m_variables;
+  const std::vector<std::string> &m_parameters;
+  std::map<std::string, double> m_constants;
+};
+
+//----------------------------------------------------------------------------
+// CompiledFormula
+//----------------------------------------------------------------------------
+
+/**
+ * Compile a formula.
+ * @param formula :: A muParser expression
+ * @param variables :: The names of the variables, which have a value for each
+ * point
+ * @param parameters :: The names of the parameters, which have a value for
+ * all of the points
+ * @param constants :: Named constants in addition to _pi and _e
+ * @throws std::invalid_argument if the formula cannot be compiled
+ */
+CompiledFormula::CompiledFormula(const std::string &formula,
+                                 const std::vector<std::string> &variables,
+                                 const std::vector<std::string> &parameters,
+                                 const std::map<std::string, double> &constants)
+    : m_root(0), m_numberOfVariables(variables.size()) {
+  m_root = Parser(*this, formula, variables, parameters, constants).parse();
+  std::map<size_t, size_t> cache;
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    cache.clear();
+    m_derivatives.emplace_back(derivative(m_root, i, cache));
+  }
+  m_lookup.clear();
+}
+
+/// The muParser functions of one argument
+const std::map<std::string, CompiledFormula::Op> &
+CompiledFormula::oneArgumentFunctions() {
+  static const std::map<std::string, Op> functions = {
+      {"sin", Op::Sin},     {"cos", Op::Cos},     {"tan", Op::Tan},
+      {"asin", Op::Asin},   {"acos", Op::Acos},   {"atan", Op::Atan},
+      {"sinh", Op::Sinh},   {"cosh", Op::Cosh},   {"tanh", Op::Tanh},
+      {"asinh", Op::Asinh}, {"acosh", Op::Acosh}, {"atanh", Op::Atanh},
+      {"exp", Op::Exp},     {"log", Op::Log},     {"ln", Op::Log},
+      {"log10", Op::Log10}, {"log2", Op::Log2},   {"sqrt", Op::Sqrt},
+      {"abs", Op::Abs},     {"sign", Op::Sign},   {"rint", Op::Rint},
+      {"erf", Op::Erf},     {"erfc", Op::Erfc}};
+  return functions;
+}
+
+/// Apply an operation to single values. Used to fold constants and for the
+/// nodes that do not depend on the variables.
+double CompiledFormula::apply(Op op, double a, double b, double c) {
+  switch (op) {
+  case Op::Negate:
+    return -a;
+  case Op::Add:
+    return a + b;
+  case Op::Subtract:
+    return a - b;
+  case Op::Multiply:
+    return a * b;
+  case Op::Divide:
+    return a / b;
+  case Op::Power:
+    return std::pow(a, b);
+  case Op::Less:
+    return toDouble(a < b);
+  case Op::Greater:
+    return toDouble(a > b);
+  case Op::LessEqual:
+    return toDouble(a <= b);
+  case Op::GreaterEqual:
+    return toDouble(a >= b);
+  case Op::Equal:
+    return toDouble(a == b);
+  case Op::NotEqual:
+    return toDouble(a != b);
+  case Op::And:
+    return toDouble(a != 0.0 && b != 0.0);
+  case Op::Or:
+    return toDouble(a != 0.0 || b != 0.0);
+  case Op::Select:
+    return a != 0.0 ? b : c;
+  case Op::Min:
+    return std::min(a, b);
+  case Op::Max:
+    return std::max(a, b);
+  case Op::Sin:
+    return std::sin(a);
+  case Op::Cos:
+    return std::cos(a);
+  case Op::Tan:
+    return std::tan(a);
+  case Op::Asin:
+    return std::asin(a);
+  case Op::Acos:
+    return std::acos(a);
+  case Op::Atan:
+    return std::atan(a);
+  case Op::Sinh:
+    return std::sinh(a);
+  case Op::Cosh:
+    return std::cosh(a);
+  case Op::Tanh:
+    return std::tanh(a);
+  case Op::Asinh:
+    return std::asinh(a);
+  case Op::Acosh:
+    return std::acosh(a);
+  case Op::Atanh:
+    return std::atanh(a);
+  case Op::Exp:
+    return std::exp(a);
+  case Op::Log:
+    return std::log(a);
+  case Op::Log10:
+    return std::log10(a);
+  case Op::Log2:
+    return std::log2(a);
+  case Op::Sqrt:
+    return std::sqrt(a);
+  case Op::Abs:
+    return std::fabs(a);
+  case Op::Sign:
+    return sign(a);
+  case Op::Rint:
+    return std::floor(a + 0.5);
+  case Op::Erf:
+    return gsl_sf_erf(a);
+  case Op::Erfc:
+    return gsl_sf_erfc(a);
+  default:
+    throw std::logic_error("Cannot apply a leaf of a CompiledFormula");
+  }
+}
+
+/**
+ * Add a node to the graph, or find an equal one. Operations on constants are
+ * folded into a constant.
+ * @returns The index of the node
+ */
+size_t CompiledFormula::node(Op op, std::initializer_list<size_t> args,
+                             double value, size_t index) {
+  Node result{op, value, index, args.size(), {{0, 0, 0}}, true};
+  std::copy(args.begin(), args.end(), result.args.begin());
+  bool allConstant = args.size() > 0;
+  for (const auto arg : args) {
+    result.uniform = result.uniform && m_nodes[arg].uniform;
+    allConstant = allConstant && m_nodes[arg].op == Op::Constant;
+  }
+  if (op == Op::Variable)
+    result.uniform = false;
+  if (allConstant) {
+    const auto argValue = [&](size_t i) {
+      return i < args.size() ? m_nodes[result.args[i]].value : 0.0;
+    };
+    return constant(apply(op, argValue(0), argValue(1), argValue(2)));
+  }
+
+  uint64_t valueBits;
+  std::memcpy(&valueBits, &value, sizeof(valueBits));
+  const auto key = std::make_tuple(op, valueBits, index, result.args);
+  const auto found = m_lookup.find(key);
+  if (found != m_lookup.end())
+    return found->second;
+  m_nodes.emplace_back(result);
+  m_lookup.emplace(key, m_nodes.size() - 1);
+  return m_nodes.size() - 1;
+}
+
+bool CompiledFormula::isConstant(size_t index, double value) const {
+  return m_nodes[index].op == Op::Constant && m_nodes[index].value == value;
+}
+
+// The arithmetic used to build derivatives drops terms that are zero
+
+size_t CompiledFormula::add(size_t lhs, size_t rhs) {
+  if (isConstant(lhs, 0.0))
+    return rhs;
+  if (isConstant(rhs, 0.0))
+    return lhs;
+  return node(Op::Add, {lhs, rhs});
+}
+
+size_t CompiledFormula::subtract(size_t lhs, size_t rhs) {
+  if (isConstant(rhs, 0.0))
+    return lhs;
+  if (isConstant(lhs, 0.0))
+    return negate(rhs);
+  return node(Op::Subtract, {lhs, rhs});
+}
+
+size_t CompiledFormula::multiply(size_t lhs, size_t rhs) {
+  if (isConstant(lhs, 0.0) || isConstant(rhs, 0.0))
+    return constant(0.0);
+  if (isConstant(lhs, 1.0))
+    return rhs;
+  if (isConstant(rhs, 1.0))
+    return lhs;
+  return node(Op::Multiply, {lhs, rhs});
+}
+
+size_t CompiledFormula::divide(size_t lhs, size_t rhs) {
+  if (isConstant(lhs, 0.0))
+    return constant(0.0);
+  if (isConstant(rhs, 1.0))
+    return lhs;
+  return node(Op::Divide, {lhs, rhs});
+}
+
+size_t CompiledFormula::negate(size_t arg) {
+  if (isConstant(arg, 0.0))
+    return arg;
+  return node(Op::Negate, {arg});
+}
+
+/**
+ * Build the derivative of a node with respect to a parameter.
+ * @param index :: The node to differentiate
+ * @param parameter :: The index of the parameter
+ * @param cache :: The derivatives of the nodes already differentiated
+ * @returns The node of the derivative
+ */
+size_t CompiledFormula::derivative(size_t index, size_t parameter,
+                                   std::map<size_t, size_t> &cache) {
+  const auto cached = cache.find(index);
+  if (cached != cache.end())
+    return cached->second;
+
+  // Copy, as adding nodes may reallocate m_nodes
+  const Node n = m_nodes[index];
+  if (n.op == Op::Parameter)
+    return constant(n.index == parameter ? 1.0 : 0.0);
+  if (n.op == Op::Constant || n.op == Op::Variable)
+    return constant(0.0);
+
+  const size_t a = n.args[0];
+  const size_t b = n.args[1];
+  const size_t da = derivative(a, parameter, cache);
+  const size_t db = n.nArgs > 1 ? derivative(b, parameter, cache) : 0;
+  const auto chain = [&](size_t outer) { return multiply(outer, da); };
+  const auto one = [this]() { return constant(1.0); };
+  size_t result = constant(0.0);
+
+  switch (n.op) {
+  case Op::Negate:
+    result = negate(da);
+    break;
+  case Op::Add:
+    result = add(da, db);
+    break;
+  case Op::Subtract:
+    result = subtract(da, db);
+    break;
+  case Op::Multiply:
+    result = add(multiply(da, b), multiply(a, db));
+    break;
+  case Op::Divide:
+    result = subtract(divide(da, b), divide(multiply(a, db), multiply(b, b)));
+    break;
+  case Op::Power:
+    if (isConstant(db, 0.0)) {
+      // d(a^b) = b a^(b-1) da
+      result = chain(multiply(
+          b, node(Op::Power, {a, node(Op::Subtract, {b, one()})})));
+    } else {
+      // d(a^b) = a^b (db ln(a) + b da / a)
+      result = multiply(index, add(multiply(db, node(Op::Log, {a})),
+                                   divide(multiply(b, da), a)));
+    }
+    break;
+  case Op::Select: {
+    const size_t dc = derivative(n.args[2], parameter, cache);
+    if (!(isConstant(db, 0.0) && isConstant(dc, 0.0)))
+      result = node(Op::Select, {a, db, dc});
+    break;
+  }
+  case Op::Min:
+    // std::min(a, b) is b if b < a and otherwise a
+    if (!(isConstant(da, 0.0) && isConstant(db, 0.0)))
+      result = node(Op::Select, {node(Op::Less, {b, a}), db, da});
+    break;
+  case Op::Max:
+    // std::max(a, b) is b if a < b and otherwise a
+    if (!(isConstant(da, 0.0) && isConstant(db, 0.0)))
+      result = node(Op::Select, {node(Op::Less, {a, b}), db, da});
+    break;
+  case Op::Sin:
+    result = chain(node(Op::Cos, {a}));
+    break;
+  case Op::Cos:
+    result = negate(chain(node(Op::Sin, {a})));
+    break;
+  case Op::Tan: {
+    const size_t cosine = node(Op::Cos, {a});
+    result = divide(da, multiply(cosine, cosine));
+    break;
+  }
+  case Op::Asin:
+    result = divide(
+        da, node(Op::Sqrt, {subtract(one(), multiply(a, a))}));
+    break;
+  case Op::Acos:
+    result = negate(
+        divide(da, node(Op::Sqrt, {subtract(one(), multiply(a, a))})));
+    break;
+  case Op::Atan:
+    result = divide(da, add(one(), multiply(a, a)));
+    break;
+  case Op::Sinh:
+    result = chain(node(Op::Cosh, {a}));
+    break;
+  case Op::Cosh:
+    result = chain(node(Op::Sinh, {a}));
+    break;
+  case Op::Tanh:
+    result = chain(subtract(one(), multiply(index, index)));
+    break;
+  case Op::Asinh:
+    result = divide(da, node(Op::Sqrt, {add(multiply(a, a), one())}));
+    break;
+  case Op::Acosh:
+    result = divide(da, node(Op::Sqrt, {subtract(multiply(a, a), one())}));
+    break;
+  case Op::Atanh:
+    result = divide(da, subtract(one(), multiply(a, a)));
+    break;
+  case Op::Exp:
+    result = chain(index);
+    break;
+  case Op::Log:
+    result = divide(da, a);
+    break;
+  case Op::Log10:
+    result = divide(da, multiply(a, constant(M_LN10)));
+    break;
+  case Op::Log2:
+    result = divide(da, multiply(a, constant(M_LN2)));
+    break;
+  case Op::Sqrt:
+    result = divide(da, multiply(constant(2.0), index));
+    break;
+  case Op::Abs:
+    result = chain(node(Op::Sign, {a}));
+    break;
+  case Op::Erf:
+  case Op::Erfc: {
+    // d erf(a) = 2 / sqrt(pi) exp(-a^2) da
+    const size_t gaussian = multiply(
+        constant(M_2_SQRTPI), node(Op::Exp, {negate(multiply(a, a))}));
+    result = n.op == Op::Erf ? chain(gaussian) : negate(chain(gaussian));
+    break;
+  }
+  default:
+    // Comparisons, logical operations, sign and rint are piecewise constant
+    break;
+  }
+  cache.emplace(index, result);
+  return result;
+}
+
+/**
+ * Evaluate the formula.
+ * @param out :: Set to the n values of the formula
+ * @param n :: The number of points
+ * @param variables :: An array of n values for each variable
+ * @param parameters :: The value of each parameter
+ */
+void CompiledFormula::evaluate(double *out, size_t n,
+                               const std::vector<const double *> &variables,
+                               const std::vector<double> &parameters) const {
+  evaluateRoots({m_root}, {out}, n, variables, parameters);
+}
+
+/**
+ * Evaluate the derivatives of the formula with respect to its parameters.
+ * @param derivatives :: An array of n values for each parameter set to the
+ * derivatives with respect to it. Null arrays are skipped.
+ * @param n :: The number of points
+ * @param variables :: An array of n values for each variable
+ * @param parameters :: The value of each parameter
+ */
+void CompiledFormula::evaluateDerivatives(
+    const std::vector<double *> &derivatives, size_t n,
+    const std::vector<const double *> &variables,
+    const std::vector<double> &parameters) const {
+  if (derivatives.size() != m_derivatives.size())
+    throw std::invalid_argument("CompiledFormula needs an array for the "
+                                "derivative with respect to each parameter");
+  evaluateRoots(m_derivatives, derivatives, n, variables, parameters);
+}
+
+/// Evaluate the nodes in roots into the arrays in out
+void CompiledFormula::evaluateRoots(
+    const std::vector<size_t> &roots, const std::vector<double *> &out,
+    size_t n, const std::vector<const double *> &variables,
+    const std::vector<double> &parameters) const {
+  if (variables.size() != m_numberOfVariables ||
+      parameters.size() != m_derivatives.size())
+    throw std::invalid_argument("CompiledFormula needs " +
+                                std::to_string(m_numberOfVariables) +
+                                " variables and " +
+                                std::to_string(m_derivatives.size()) +
+                                " parameters");
+
+  // Find the nodes that are needed
+  std::vector<char> needed(m_nodes.size(), 0);
+  for (size_t r = 0; r < roots.size(); ++r) {
+    if (out[r])
+      needed[roots[r]] = 1;
+  }
+  for (size_t i = m_nodes.size(); i-- > 0;) {
+    if (needed[i]) {
+      for (size_t arg = 0; arg < m_nodes[i].nArgs; ++arg)
+        needed[m_nodes[i].args[arg]] = 1;
+    }
+  }
+
+  // Evaluate the nodes that do not depend on the variables once, and give
+  // the others a buffer for a block of values
+  std::vector<double> scalars(m_nodes.size(), 0.0);
+  std::vector<size_t> slots(m_nodes.size(), NO_SLOT);
+  std::vector<size_t> blockNodes;
+  for (size_t i = 0; i < m_nodes.size(); ++i) {
+    if (!needed[i])
+      continue;
+    const Node &node = m_nodes[i];
+    if (node.uniform) {
+      if (node.op == Op::Constant)
+        scalars[i] = node.value;
+      else if (node.op == Op::Parameter)
+        scalars[i] = parameters[node.index];
+      else
+        scalars[i] = apply(node.op, scalars[node.args[0]],
+                           scalars[node.args[1]], scalars[node.args[2]]);
+    } else if (node.op != Op::Variable) {
+      slots[i] = blockNodes.size();
+      blockNodes.emplace_back(i);
+    }
+  }
+  std::vector<double> buffer(blockNodes.size() * BLOCK_SIZE);
+
+  for (size_t start = 0; start < n; start += BLOCK_SIZE) {
+    const size_t count = std::min(BLOCK_SIZE, n - start);
+    const auto operand = [&](size_t i) {
+      const Node &node = m_nodes[i];
+      if (node.uniform)
+        return Operand{nullptr, scalars[i]};
+      if (node.op == Op::Variable)
+        return Operand{variables[node.index] + start, 0.0};
+      return Operand{buffer.data() + slots[i] * BLOCK_SIZE, 0.0};
+    };
+
+    for (const auto i : blockNodes) {
+      const Node &node = m_nodes[i];
+      double *result = buffer.data() + slots[i] * BLOCK_SIZE;
+      const Operand a = operand(node.args[0]);
+      const Operand b =
+          node.nArgs > 1 ? operand(node.args[1]) : Operand{nullptr, 0.0};
+      switch (node.op) {
+      case Op::Negate:
+        unaryLoop(a, result, count, [](double x) { return -x; });
+        break;
+      case Op::Add:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return x + y; });
+        break;
+      case Op::Subtract:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return x - y; });
+        break;
+      case Op::Multiply:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return x * y; });
+        break;
+      case Op::Divide:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return x / y; });
+        break;
+      case Op::Power:
+        if (!b.array && b.scalar == 2.0)
+          unaryLoop(a, result, count, [](double x) { return x * x; });
+        else
+          binaryLoop(a, b, result, count,
+                     [](double x, double y) { return std::pow(x, y); });
+        break;
+      case Op::Less:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return toDouble(x < y); });
+        break;
+      case Op::Greater:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return toDouble(x > y); });
+        break;
+      case Op::LessEqual:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return toDouble(x <= y); });
+        break;
+      case Op::GreaterEqual:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return toDouble(x >= y); });
+        break;
+      case Op::Equal:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return toDouble(x == y); });
+        break;
+      case Op::NotEqual:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return toDouble(x != y); });
+        break;
+      case Op::Min:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return std::min(x, y); });
+        break;
+      case Op::Max:
+        binaryLoop(a, b, result, count,
+                   [](double x, double y) { return std::max(x, y); });
+        break;
+      case Op::Select: {
+        const Operand c = operand(node.args[2]);
+        for (size_t j = 0; j < count; ++j)
+          result[j] = at(a, j) != 0.0 ? at(b, j) : at(c, j);
+        break;
+      }
+      case Op::Sqrt:
+        unaryLoop(a, result, count, [](double x) { return std::sqrt(x); });
+        break;
+      case Op::Abs:
+        unaryLoop(a, result, count, [](double x) { return std::fabs(x); });
+        break;
+      case Op::And:
+        binaryLoop(a, b, result, count, [](double x, double y) {
+          return toDouble(x != 0.0 && y != 0.0);
+        });
+        break;
+      case Op::Or:
+        binaryLoop(a, b, result, count, [](double x, double y) {
+          return toDouble(x != 0.0 || y != 0.0);
+        });
+        break;
+      case Op::Sin:
+        unaryLoop(a, result, count, [](double x) { return std::sin(x); });
+        break;
+      case Op::Cos:
+        unaryLoop(a, result, count, [](double x) { return std::cos(x); });
+        break;
+      case Op::Tan:
+        unaryLoop(a, result, count, [](double x) { return std::tan(x); });
+        break;
+      case Op::Asin:
+        unaryLoop(a, result, count, [](double x) { return std::asin(x); });
+        break;
+      case Op::Acos:
+        unaryLoop(a, result, count, [](double x) { return std::acos(x); });
+        break;
+      case Op::Atan:
+        unaryLoop(a, result, count, [](double x) { return std::atan(x); });
+        break;
+      case Op::Sinh:
+        unaryLoop(a, result, count, [](double x) { return std::sinh(x); });
+        break;
+      case Op::Cosh:
+        unaryLoop(a, result, count, [](double x) { return std::cosh(x); });
+        break;
+      case Op::Tanh:
+        unaryLoop(a, result, count, [](double x) { return std::tanh(x); });
+        break;
+      case Op::Asinh:
+        unaryLoop(a, result, count, [](double x) { return std::asinh(x); });
+        break;
+      case Op::Acosh:
+        unaryLoop(a, result, count, [](double x) { return std::acosh(x); });
+        break;
+      case Op::Atanh:
+        unaryLoop(a, result, count, [](double x) { return std::atanh(x); });
+        break;
+      case Op::Exp:
+        unaryLoop(a, result, count, [](double x) { return std::exp(x); });
+        break;
+      case Op::Log:
+        unaryLoop(a, result, count, [](double x) { return std::log(x); });
+        break;
+      case Op::Log10:
+        unaryLoop(a, result, count, [](double x) { return std::log10(x); });
+        break;
+      case Op::Log2:
+        unaryLoop(a, result, count, [](double x) { return std::log2(x); });
+        break;
+      case Op::Sign:
+        unaryLoop(a, result, count, [](double x) { return sign(x); });
+        break;
+      case Op::Rint:
+        unaryLoop(a, result, count,
+                  [](double x) { return std::floor(x + 0.5); });
+        break;
+      case Op::Erf:
+        unaryLoop(a, result, count, [](double x) { return gsl_sf_erf(x); });
+        break;
+      case Op::Erfc:
+        unaryLoop(a, result, count, [](double x) { return gsl_sf_erfc(x); });
+        break;
+      default:
+        throw std::logic_error("Cannot apply a leaf of a CompiledFormula");
+      }
+    }
+
+    for (size_t r = 0; r < roots.size(); ++r) {
+      if (!out[r])
+        continue;
+      const Operand root = operand(roots[r]);
+      if (root.array)
+        std::copy(root.array, root.array + count, out[r] + start);
+      else
+        std::fill(out[r] + start, out[r] + start + count, root.scalar);
+    }
+  }
+}
+
+} // namespace API
+} // namespace Mantid
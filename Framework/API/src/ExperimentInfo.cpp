@@ -483,6 +483,8 @@ void ExperimentInfo::setDetectorGrouping(
   }
   m_spectrumInfo->setSpectrumDefinition(index, std::move(specDef));
   m_spectrumDefinitionNeedsUpdate.at(index) = 0;
+  if (m_spectrumInfoWrapper)
+    m_spectrumInfoWrapper->invalidateGeometryCache();
 }
 
 /** Update detector grouping for spectrum with given index.
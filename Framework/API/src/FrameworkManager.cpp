@@ -15,6 +15,7 @@
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyManagerDataService.h"
+#include "MantidKernel/Tracing.h"
 #include "MantidKernel/UsageService.h"
 
 #include <boost/algorithm/string/split.hpp>
@@ -153,6 +154,7 @@ FrameworkManagerImpl::FrameworkManagerImpl()
   loadPlugins();
   disableNexusOutput();
   setNumOMPThreadsToConfigValue();
+  Kernel::Tracing::configureFromConfigService();
 
 #ifdef MPI_BUILD
   g_log.notice() << "This MPI process is rank: "
@@ -225,6 +227,9 @@ void FrameworkManagerImpl::clear() {
 
 void FrameworkManagerImpl::shutdown() {
   Kernel::UsageService::Instance().shutdown();
+  // Write out a trace that is still running
+  if (Kernel::Tracing::isEnabled())
+    Kernel::Tracing::stop();
   // Ensure we don't run into static init ordering issues with TBB
   m_globalTbbControl.reset();
   clear();
@@ -95,6 +95,22 @@ bool convertPropertyToDouble(const Property *property, double &value,
 /// Name of the log entry containing the proton charge when retrieved using
 /// getProtonCharge
 const char *LogManager::PROTON_CHARGE_LOG_NAME = "gd_prtn_chrg";
+
+/// A property that is created when it is first accessed
+struct LogManager::DeferredProperty {
+  explicit DeferredProperty(
+      std::function<std::unique_ptr<Kernel::Property>()> createFunction)
+      : create(std::move(createFunction)) {}
+  /// Creates the property
+  std::function<std::unique_ptr<Kernel::Property>()> create;
+  /// Ensures the property is only created once
+  std::once_flag created;
+  /// The property, once created
+  std::unique_ptr<Kernel::Property> property;
+  /// The reason the property could not be created
+  std::string error;
+};
+
 //----------------------------------------------------------------------
 // Public member functions
 //----------------------------------------------------------------------
@@ -111,7 +127,10 @@ LogManager::LogManager(const LogManager &other)
       m_singleValueCache(
           std::make_unique<Kernel::Cache<
               std::pair<std::string, Kernel::Math::StatisticType>, double>>(
-              *other.m_singleValueCache)) {}
+              *other.m_singleValueCache)) {
+  std::lock_guard<std::recursive_mutex> lock(other.m_deferredMutex);
+  m_deferred = other.m_deferred;
+}
 
 // Defined as default in source for forward declaration with std::unique_ptr.
 LogManager::~LogManager() = default;
@@ -121,6 +140,12 @@ LogManager &LogManager::operator=(const LogManager &other) {
   m_singleValueCache = std::make_unique<Kernel::Cache<
       std::pair<std::string, Kernel::Math::StatisticType>, double>>(
       *other.m_singleValueCache);
+  auto deferred = [&other] {
+    std::lock_guard<std::recursive_mutex> lock(other.m_deferredMutex);
+    return other.m_deferred;
+  }();
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  m_deferred = std::move(deferred);
   return *this;
 }
 
@@ -207,6 +232,7 @@ const Types::Core::DateAndTime LogManager::endTime() const {
  */
 void LogManager::filterByTime(const Types::Core::DateAndTime start,
                               const Types::Core::DateAndTime stop) {
+  materializeDeferredProperties();
   // The propery manager operator will make all timeseriesproperties filter.
   m_manager->filterByTime(start, stop);
 }
@@ -224,8 +250,10 @@ void LogManager::splitByTime(TimeSplitterType &splitter,
   // Make a vector of managers for the splitter. Fun!
   const size_t n = outputs.size();
   std::vector<PropertyManager *> output_managers(outputs.size(), nullptr);
+  materializeDeferredProperties();
   for (size_t i = 0; i < n; i++) {
     if (outputs[i]) {
+      outputs[i]->materializeDeferredProperties();
       output_managers[i] = outputs[i]->m_manager.get();
     }
   }
@@ -247,6 +275,7 @@ void LogManager::filterByLog(
     const std::vector<std::string> &excludedFromFiltering) {
   // This will invalidate the cache
   m_singleValueCache->clear();
+  materializeDeferredProperties();
   m_manager->filterByProperty(filter, excludedFromFiltering);
 }
 
@@ -266,14 +295,68 @@ void LogManager::addProperty(std::unique_ptr<Kernel::Property> prop,
   // separate locations
   // Similar we don't want more than one run_title
   std::string name = prop->name();
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
   if (hasProperty(name) &&
       (overwrite || prop->name() == PROTON_CHARGE_LOG_NAME ||
        prop->name() == "run_title")) {
     removeProperty(name);
+  } else {
+    materializeDeferredProperty(name);
   }
   m_manager->declareProperty(std::move(prop), "");
 }
 
+//-----------------------------------------------------------------------------------------------
+/**
+ * Add a property that is only created when it is first accessed, e.g. a large
+ * log read from a file. Until then hasProperty() reports it as present but it
+ * uses no memory. Any method that needs all of the properties, such as
+ * getProperties(), creates all deferred properties first. If the property
+ * cannot be created a warning is logged and it is dropped.
+ *
+ * Copies of this object share the function and the property is created at
+ * most once between them. The property stays deferred until it has been
+ * declared, and creating it and looking it up hold the same lock, so it may be
+ * first accessed from several threads at once.
+ * @param name :: The name of the property
+ * @param create :: Creates the property, which must be called name
+ * @param overwrite :: If true, a current value is overwritten. (Default:
+ * False)
+ * @throws Exception::ExistsError if the property exists and overwrite is false
+ */
+void LogManager::addDeferredProperty(
+    const std::string &name,
+    std::function<std::unique_ptr<Kernel::Property>()> create,
+    bool overwrite) {
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  if (hasProperty(name)) {
+    if (!overwrite)
+      throw Exception::ExistsError("Property with given name already exists",
+                                   name);
+    removeProperty(name);
+  }
+  m_deferred.emplace(name,
+                     std::make_shared<DeferredProperty>(std::move(create)));
+}
+
+/**
+ * @param name :: The name of the property
+ * @return True if the named property has been added by addDeferredProperty()
+ * and not yet created
+ */
+bool LogManager::isDeferredProperty(const std::string &name) const {
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  return m_deferred.find(name) != m_deferred.end();
+}
+
+/// Create all of the properties added by addDeferredProperty() that have not
+/// been accessed yet
+void LogManager::materializeDeferredProperties() const {
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  while (!m_deferred.empty())
+    materializeDeferredProperty(m_deferred.begin()->first);
+}
+
 //-----------------------------------------------------------------------------------------------
 /**
  * Returns true if the named property exists
@@ -281,7 +364,9 @@ void LogManager::addProperty(std::unique_ptr<Kernel::Property> prop,
  * @return True if the property exists, false otherwise
  */
 bool LogManager::hasProperty(const std::string &name) const {
-  return m_manager->existsProperty(name);
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  return m_manager->existsProperty(name) ||
+         m_deferred.find(name) != m_deferred.end();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -298,6 +383,8 @@ void LogManager::removeProperty(const std::string &name, bool delProperty) {
     m_singleValueCache->removeCache(
         std::make_pair(name, static_cast<Math::StatisticType>(stat)));
   }
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  m_deferred.erase(name);
   m_manager->removeProperty(name, delProperty);
 }
 
@@ -306,6 +393,7 @@ void LogManager::removeProperty(const std::string &name, bool delProperty) {
  * @returns A vector of the current list of properties
  */
 const std::vector<Kernel::Property *> &LogManager::getProperties() const {
+  materializeDeferredProperties();
   return m_manager->getProperties();
 }
 
@@ -440,6 +528,8 @@ int LogManager::getPropertyAsIntegerValue(const std::string &name) const {
  * @return A pointer to the named property
  */
 Kernel::Property *LogManager::getProperty(const std::string &name) const {
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  materializeDeferredProperty(name);
   return m_manager->getProperty(name);
 }
 
@@ -488,7 +578,7 @@ void LogManager::saveNexus(::NeXus::File *file, const std::string &group,
   file->putAttr("version", 1);
 
   // Save all the properties as NXlog
-  std::vector<Property *> props = m_manager->getProperties();
+  std::vector<Property *> props = getProperties();
   for (auto &prop : props) {
     try {
       prop->saveProperty(file);
@@ -538,6 +628,8 @@ void LogManager::loadNexus(::NeXus::File *file,
     if (name_class.second == "NXlog") {
       auto prop = PropertyNexus::loadProperty(file, name_class.first);
       if (prop) {
+        std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+        m_deferred.erase(prop->name());
         if (m_manager->existsProperty(prop->name())) {
           m_manager->removeProperty(prop->name());
         }
@@ -550,7 +642,11 @@ void LogManager::loadNexus(::NeXus::File *file,
 /**
  * Clear the logs.
  */
-void LogManager::clearLogs() { m_manager->clear(); }
+void LogManager::clearLogs() {
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  m_deferred.clear();
+  m_manager->clear();
+}
 
 /// Gets the correct log name for the matching invalid values log for a given
 /// log name
@@ -580,11 +676,56 @@ LogManager::getInvalidValuesFilter(const std::string &logName) const {
 }
 
 bool LogManager::operator==(const LogManager &other) const {
+  materializeDeferredProperties();
+  other.materializeDeferredProperties();
   return *m_manager == *(other.m_manager);
 }
 
 bool LogManager::operator!=(const LogManager &other) const {
-  return *m_manager != *(other.m_manager);
+  return !(*this == other);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+// Protected methods
+//-----------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Create the named property if it was added by addDeferredProperty() and has
+ * not been accessed yet. A property that cannot be created is dropped with a
+ * warning. The property stays deferred until it has been declared, so other
+ * threads never see it missing.
+ * @param name :: The name of the property
+ */
+void LogManager::materializeDeferredProperty(const std::string &name) const {
+  std::lock_guard<std::recursive_mutex> lock(m_deferredMutex);
+  const auto it = m_deferred.find(name);
+  if (it == m_deferred.end())
+    return;
+  const auto &deferred = it->second;
+  // Copies of this object hold their own lock so creation is still guarded
+  std::call_once(deferred->created, [&deferred] {
+    try {
+      deferred->property = deferred->create();
+      if (!deferred->property)
+        deferred->error = "no property was created";
+    } catch (std::exception &exc) {
+      deferred->error = exc.what();
+    }
+    // The function may hold resources, such as the name of a file
+    deferred->create = nullptr;
+  });
+  if (!deferred->property) {
+    g_log.warning() << "Failed to create the deferred log " << name << ": "
+                    << deferred->error << "\n";
+    m_deferred.erase(it);
+    return;
+  }
+  // Take the property if no copy of this object can still ask for it
+  auto property = deferred.use_count() == 1
+                      ? std::move(deferred->property)
+                      : std::unique_ptr<Property>(deferred->property->clone());
+  m_manager->declareProperty(std::move(property), "");
+  m_deferred.erase(it);
 }
 
 //-----------------------------------------------------------------------------------------------------------------------
@@ -72,7 +72,7 @@ bool Run::operator!=(const Run &other) { return !this->operator==(other); }
 
 std::shared_ptr<Run> Run::clone() {
   auto clone = std::make_shared<Run>();
-  for (auto property : this->m_manager->getProperties()) {
+  for (auto property : this->getProperties()) {
     clone->addProperty(property->clone());
   }
   clone->m_goniometer =
@@ -108,6 +108,8 @@ void Run::filterByTime(const Types::Core::DateAndTime start,
  * @returns A reference to the summed object
  */
 Run &Run::operator+=(const Run &rhs) {
+  materializeDeferredProperties();
+  rhs.materializeDeferredProperties();
   // merge and copy properties where there is no risk of corrupting data
   mergeMergables(*m_manager, *rhs.m_manager);
 
@@ -180,11 +182,11 @@ void Run::setProtonCharge(const double charge) {
  */
 double Run::getProtonCharge() const {
   double charge = 0.0;
-  if (!m_manager->existsProperty(PROTON_CHARGE_LOG_NAME)) {
+  if (!hasProperty(PROTON_CHARGE_LOG_NAME)) {
     integrateProtonCharge();
   }
-  if (m_manager->existsProperty(PROTON_CHARGE_LOG_NAME)) {
-    charge = m_manager->getProperty(PROTON_CHARGE_LOG_NAME);
+  if (hasProperty(PROTON_CHARGE_LOG_NAME)) {
+    charge = getPropertyValueAsType<double>(PROTON_CHARGE_LOG_NAME);
   } else {
     g_log.warning() << PROTON_CHARGE_LOG_NAME
                     << " log was not found. Proton Charge set to 0.0\n";
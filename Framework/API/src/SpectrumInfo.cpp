@@ -8,18 +8,30 @@
 #include "MantidAPI/ExperimentInfo.h"
 #include "MantidAPI/SpectrumInfoIterator.h"
 #include "MantidBeamline/SpectrumInfo.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/SolidAngleEngine.h"
+#include "MantidKernel/DeltaEMode.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidTypes/SpectrumDefinition.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 
 namespace Mantid {
 namespace API {
 
+namespace {
+/// Parameters are equal if they compare equal or are both NaN.
+bool sameParameter(const double a, const double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+} // namespace
+
 SpectrumInfo::SpectrumInfo(const Beamline::SpectrumInfo &spectrumInfo,
                            const ExperimentInfo &experimentInfo,
                            Geometry::DetectorInfo &detectorInfo)
@@ -162,6 +174,64 @@ void SpectrumInfo::setMasked(const size_t index, bool masked) {
     m_detectorInfo.setMasked(detIndex, masked);
 }
 
+/// Returns L2 of all spectra, see l2().
+const std::vector<double> &SpectrumInfo::l2s() const {
+  return cachedColumn(GeometryColumn::L2);
+}
+
+/// Returns the scattering angle 2 theta in radians of all spectra, see
+/// twoTheta(). Monitors have a value of NaN.
+const std::vector<double> &SpectrumInfo::twoThetas() const {
+  return cachedColumn(GeometryColumn::TwoTheta);
+}
+
+/// Returns the signed scattering angle 2 theta in radians of all spectra, see
+/// signedTwoTheta(). Monitors have a value of NaN.
+const std::vector<double> &SpectrumInfo::signedTwoThetas() const {
+  return cachedColumn(GeometryColumn::SignedTwoTheta);
+}
+
+/// Returns the out-of-plane angle in radians of all spectra, see azimuthal().
+/// Monitors have a value of NaN.
+const std::vector<double> &SpectrumInfo::azimuthals() const {
+  return cachedColumn(GeometryColumn::Azimuthal);
+}
+
+/** Returns the uncalibrated TOF to d-spacing conversion factor DIFC of all
+ * spectra, computed from L1, L2 and 2 theta. Monitors have a value of NaN. */
+const std::vector<double> &SpectrumInfo::difcs() const {
+  return cachedColumn(GeometryColumn::DIFC);
+}
+
+/** Returns the fixed energy of all spectra, see ExperimentInfo::getEFixed().
+ *
+ * In direct geometry this is Ei for every spectrum with detectors. In indirect
+ * geometry it is the average Efixed parameter of the detectors of the
+ * spectrum, or NaN if a detector has no Efixed parameter. Throws in elastic
+ * mode. */
+const std::vector<double> &SpectrumInfo::eFixeds() const {
+  const auto emode = m_experimentInfo.getEMode();
+  if (emode == Kernel::DeltaEMode::Elastic)
+    throw std::runtime_error("SpectrumInfo::eFixeds - EFixed requested for "
+                             "elastic mode, don't know what to do!");
+  if (emode == Kernel::DeltaEMode::Direct)
+    return cachedColumn(GeometryColumn::EFixed, m_experimentInfo.getEFixed());
+  return cachedColumn(GeometryColumn::EFixed);
+}
+
+/** Returns the solid angle in steradians of all spectra as seen from the
+ * sample position. For grouped spectra this is the sum over all detectors. */
+const std::vector<double> &SpectrumInfo::solidAngles() const {
+  return cachedColumn(GeometryColumn::SolidAngle);
+}
+
+/** Marks all bulk geometry columns as outdated. Thread safe.
+ *
+ * Changes of positions, of the spectrum grouping and of instrument parameters
+ * such as Efixed are detected automatically, so this is only required if
+ * other inputs, such as detector shapes, are modified. */
+void SpectrumInfo::invalidateGeometryCache() const { ++m_groupingRevision; }
+
 /// Return a const reference to the detector or detector group of the spectrum
 /// with given index.
 const Geometry::IDetector &SpectrumInfo::detector(const size_t index) const {
@@ -223,6 +293,121 @@ SpectrumInfo::checkAndGetSpectrumDefinition(const size_t index) const {
   return spectrumDefinition(index);
 }
 
+/** Returns the requested bulk geometry column, recomputing it in parallel if
+ * the geometry, the grouping, or `parameter` changed since it was cached. */
+const std::vector<double> &
+SpectrumInfo::cachedColumn(const GeometryColumn column,
+                           const double parameter) const {
+  // Applies pending grouping updates, which in turn invalidate the cache.
+  const auto &spectrumDefinitions = *sharedSpectrumDefinitions();
+
+  std::lock_guard<std::mutex> lock(m_geometryColumnsMutex);
+  auto &cached = m_geometryColumns[static_cast<size_t>(column)];
+  const auto geometryRevision = m_detectorInfo.geometryRevision();
+  const auto groupingRevision = m_groupingRevision.load();
+  // Only Efixed is read from instrument parameters
+  const auto parameterMapRevision =
+      column == GeometryColumn::EFixed
+          ? m_experimentInfo.constInstrumentParameters().revision()
+          : 0;
+  if (cached.valid && cached.geometryRevision == geometryRevision &&
+      cached.groupingRevision == groupingRevision &&
+      cached.parameterMapRevision == parameterMapRevision &&
+      sameParameter(cached.parameter, parameter))
+    return cached.values;
+
+  // Shapes are triangulated lazily, which must not happen in the loop below
+  if (column == GeometryColumn::SolidAngle)
+    Geometry::SolidAngleEngine(m_experimentInfo.componentInfo())
+        .prepareShapes();
+
+  auto &values = cached.values;
+  values.resize(spectrumDefinitions.size());
+  const auto size = static_cast<int64_t>(values.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < size; ++i)
+    values[i] = computeColumnValue(column, spectrumDefinitions[i], parameter);
+
+  cached.valid = true;
+  cached.geometryRevision = geometryRevision;
+  cached.groupingRevision = groupingRevision;
+  cached.parameterMapRevision = parameterMapRevision;
+  cached.parameter = parameter;
+  return values;
+}
+
+/// Computes the value of a bulk geometry column for a single spectrum, or NaN
+/// if it is not defined.
+double
+SpectrumInfo::computeColumnValue(const GeometryColumn column,
+                                 const SpectrumDefinition &spectrumDefinition,
+                                 const double parameter) const {
+  constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  if (spectrumDefinition.size() == 0)
+    return nan;
+  const auto count = static_cast<double>(spectrumDefinition.size());
+  const bool hasMonitor =
+      std::any_of(spectrumDefinition.begin(), spectrumDefinition.end(),
+                  [this](const std::pair<size_t, size_t> &detIndex) {
+                    return m_detectorInfo.isMonitor(detIndex);
+                  });
+  if (hasMonitor && column != GeometryColumn::L2 &&
+      column != GeometryColumn::EFixed && column != GeometryColumn::SolidAngle)
+    return nan;
+
+  // Single detector methods throw for undefined values, e.g., if sample and
+  // source coincide.
+  try {
+    double sum{0.0};
+    switch (column) {
+    case GeometryColumn::L2:
+      for (const auto &detIndex : spectrumDefinition)
+        sum += m_detectorInfo.l2(detIndex);
+      return sum / count;
+    case GeometryColumn::TwoTheta:
+      for (const auto &detIndex : spectrumDefinition)
+        sum += m_detectorInfo.twoTheta(detIndex);
+      return sum / count;
+    case GeometryColumn::SignedTwoTheta:
+      for (const auto &detIndex : spectrumDefinition)
+        sum += m_detectorInfo.signedTwoTheta(detIndex);
+      return sum / count;
+    case GeometryColumn::Azimuthal:
+      for (const auto &detIndex : spectrumDefinition)
+        sum += m_detectorInfo.azimuthal(detIndex);
+      return sum / count;
+    case GeometryColumn::DIFC: {
+      double l2{0.0};
+      for (const auto &detIndex : spectrumDefinition) {
+        l2 += m_detectorInfo.l2(detIndex);
+        sum += m_detectorInfo.twoTheta(detIndex);
+      }
+      return 1. / Geometry::Conversion::tofToDSpacingFactor(
+                      m_detectorInfo.l1(), l2 / count, sum / count, 0.);
+    }
+    case GeometryColumn::EFixed:
+      if (!std::isnan(parameter))
+        return parameter;
+      for (const auto &detIndex : spectrumDefinition)
+        sum += m_experimentInfo.getEFixed(
+            m_detectorInfo.getDetectorPtr(detIndex.first));
+      return sum / count;
+    case GeometryColumn::SolidAngle: {
+      const Geometry::SolidAngleEngine engine(
+          m_experimentInfo.componentInfo());
+      const auto samplePos = m_detectorInfo.samplePosition();
+      for (const auto &detIndex : spectrumDefinition)
+        sum += engine.solidAngle(detIndex.first, samplePos);
+      return sum;
+    }
+    default:
+      return nan;
+    }
+  } catch (const std::exception &) {
+    return nan;
+  }
+}
+
 // Begin method for iterator
 SpectrumInfoIt SpectrumInfo::begin() { return SpectrumInfoIt(*this, 0); }
 
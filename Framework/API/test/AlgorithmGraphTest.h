@@ -0,0 +1,223 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidKernel/Exception.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Mantid::API;
+using namespace Mantid::Kernel;
+
+namespace {
+/// Creates a workspace holding Value, after waiting for Partners other
+/// instances to be running at the same time
+class GraphSourceAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "GraphSourceAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test summary"; }
+
+  static std::atomic<int> running;
+  static std::weak_ptr<Workspace> lastOutput;
+
+private:
+  void init() override {
+    declareProperty("Value", 0.0);
+    declareProperty("Partners", 0);
+    declareProperty(std::make_unique<WorkspaceProperty<>>("OutputWorkspace",
+                                                          "", Direction::Output));
+  }
+  void exec() override {
+    const int partners = getProperty("Partners");
+    ++running;
+    for (int wait = 0; running <= partners && wait < 500; ++wait)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    setProperty("Partners", running.load() - 1);
+
+    auto out = std::make_shared<WorkspaceTester>();
+    out->initialize(1, 1, 1);
+    out->dataY(0)[0] = getProperty("Value");
+    lastOutput = out;
+    setProperty("OutputWorkspace", std::move(out));
+  }
+};
+std::atomic<int> GraphSourceAlgorithm::running{0};
+std::weak_ptr<Workspace> GraphSourceAlgorithm::lastOutput;
+
+/// Sums the first values of its inputs, failing if asked to
+class GraphSumAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "GraphSumAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test summary"; }
+
+private:
+  void init() override {
+    declareProperty(std::make_unique<WorkspaceProperty<>>("LHSWorkspace", "",
+                                                          Direction::Input));
+    declareProperty(std::make_unique<WorkspaceProperty<>>("RHSWorkspace", "",
+                                                          Direction::Input));
+    declareProperty("Fail", false);
+    declareProperty(std::make_unique<WorkspaceProperty<>>("OutputWorkspace",
+                                                          "", Direction::Output));
+  }
+  void exec() override {
+    if (getProperty("Fail"))
+      throw std::runtime_error("Failed as requested");
+    MatrixWorkspace_const_sptr lhs = getProperty("LHSWorkspace");
+    MatrixWorkspace_const_sptr rhs = getProperty("RHSWorkspace");
+    auto out = std::make_shared<WorkspaceTester>();
+    out->initialize(1, 1, 1);
+    out->dataY(0)[0] = lhs->readY(0)[0] + rhs->readY(0)[0];
+    setProperty("OutputWorkspace", std::move(out));
+  }
+};
+
+IAlgorithm_sptr source(const double value, const int partners = 0) {
+  auto alg = std::make_shared<GraphSourceAlgorithm>();
+  alg->initialize();
+  alg->setProperty("Value", value);
+  alg->setProperty("Partners", partners);
+  return alg;
+}
+
+IAlgorithm_sptr sum(const bool fail = false) {
+  auto alg = std::make_shared<GraphSumAlgorithm>();
+  alg->initialize();
+  alg->setProperty("Fail", fail);
+  return alg;
+}
+
+double value(const Workspace_sptr &workspace) {
+  return std::dynamic_pointer_cast<MatrixWorkspace>(workspace)->readY(0)[0];
+}
+} // namespace
+
+class AlgorithmGraphTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmGraphTest *createSuite() { return new AlgorithmGraphTest(); }
+  static void destroySuite(AlgorithmGraphTest *suite) { delete suite; }
+
+  void setUp() override { GraphSourceAlgorithm::running = 0; }
+
+  void test_empty_graph() {
+    AlgorithmGraph graph;
+    TS_ASSERT_THROWS_NOTHING(graph.execute())
+    TS_ASSERT(graph.isExecuted())
+  }
+
+  void test_diamond() {
+    AlgorithmGraph graph;
+    const auto a = graph.addNode(source(1.));
+    const auto b = graph.addNode(source(2.));
+    const auto c = graph.addNode(sum());
+    const auto d = graph.addNode(sum());
+    graph.connect(a, "OutputWorkspace", c, "LHSWorkspace");
+    graph.connect(b, "OutputWorkspace", c, "RHSWorkspace");
+    graph.connect(c, "OutputWorkspace", d, "LHSWorkspace");
+    graph.connect(a, "OutputWorkspace", d, "RHSWorkspace");
+    TS_ASSERT_EQUALS(graph.size(), 4)
+
+    graph.execute();
+    TS_ASSERT(graph.isExecuted())
+    TS_ASSERT_EQUALS(value(graph.getOutput(d, "OutputWorkspace")), 4.)
+    // Intermediate workspaces are released
+    TS_ASSERT_THROWS(graph.getOutput(a, "OutputWorkspace"),
+                     const std::invalid_argument &)
+    TS_ASSERT_THROWS(graph.getOutput(c, "OutputWorkspace"),
+                     const std::invalid_argument &)
+  }
+
+  void test_kept_outputs_are_not_released() {
+    AlgorithmGraph graph;
+    const auto a = graph.addNode(source(1.));
+    const auto b = graph.addNode(source(2.));
+    const auto c = graph.addNode(sum());
+    graph.connect(a, "OutputWorkspace", c, "LHSWorkspace");
+    graph.connect(b, "OutputWorkspace", c, "RHSWorkspace");
+    graph.keepOutput(a, "OutputWorkspace");
+    graph.execute(1);
+    TS_ASSERT_EQUALS(value(graph.getOutput(a, "OutputWorkspace")), 1.)
+    TS_ASSERT_EQUALS(value(graph.getOutput(c, "OutputWorkspace")), 3.)
+  }
+
+  void test_intermediate_workspace_is_freed_after_last_consumer() {
+    AlgorithmGraph graph;
+    const auto a = graph.addNode(source(1.));
+    const auto b = graph.addNode(sum());
+    graph.connect(a, "OutputWorkspace", b, "LHSWorkspace");
+    graph.connect(a, "OutputWorkspace", b, "RHSWorkspace");
+    graph.execute();
+    TS_ASSERT(GraphSourceAlgorithm::lastOutput.expired())
+    TS_ASSERT_EQUALS(value(graph.getOutput(b, "OutputWorkspace")), 2.)
+  }
+
+  void test_independent_branches_run_concurrently() {
+    AlgorithmGraph graph;
+    auto first = source(1., 1);
+    auto second = source(2., 1);
+    graph.addNode(first);
+    graph.addNode(second);
+    graph.execute(2);
+    // Each source waited for the other to start
+    TS_ASSERT_EQUALS(static_cast<int>(first->getProperty("Partners")), 1)
+    TS_ASSERT_EQUALS(static_cast<int>(second->getProperty("Partners")), 1)
+  }
+
+  void test_failure_is_rethrown_and_stops_downstream_nodes() {
+    AlgorithmGraph graph;
+    const auto a = graph.addNode(source(1.));
+    const auto b = graph.addNode(sum(true));
+    auto downstream = sum();
+    const auto c = graph.addNode(downstream);
+    graph.connect(a, "OutputWorkspace", b, "LHSWorkspace");
+    graph.connect(a, "OutputWorkspace", b, "RHSWorkspace");
+    graph.connect(b, "OutputWorkspace", c, "LHSWorkspace");
+    graph.connect(b, "OutputWorkspace", c, "RHSWorkspace");
+    TS_ASSERT_THROWS_EQUALS(
+        graph.execute(), const std::runtime_error &e, std::string(e.what()),
+        "Execution of GraphSumAlgorithm (node 1) failed: Failed as requested")
+    TS_ASSERT(!graph.isExecuted())
+    TS_ASSERT(!downstream->isExecuted())
+    TS_ASSERT_THROWS(graph.execute(), const std::runtime_error &)
+  }
+
+  void test_connect_requires_producer_before_consumer() {
+    AlgorithmGraph graph;
+    const auto a = graph.addNode(sum());
+    const auto b = graph.addNode(source(1.));
+    TS_ASSERT_THROWS(graph.connect(b, "OutputWorkspace", a, "LHSWorkspace"),
+                     const std::invalid_argument &)
+    TS_ASSERT_THROWS(graph.connect(a, "OutputWorkspace", a, "LHSWorkspace"),
+                     const std::invalid_argument &)
+  }
+
+  void test_connect_checks_the_properties() {
+    AlgorithmGraph graph;
+    const auto a = graph.addNode(source(1.));
+    const auto b = graph.addNode(sum());
+    TS_ASSERT_THROWS(graph.connect(a, "Value", b, "LHSWorkspace"),
+                     const std::invalid_argument &)
+    TS_ASSERT_THROWS(graph.connect(a, "OutputWorkspace", b, "OutputWorkspace"),
+                     const std::invalid_argument &)
+    TS_ASSERT_THROWS(graph.connect(a, "OutputWorkspace", b, "Missing"),
+                     const Exception::NotFoundError &)
+    TS_ASSERT_THROWS(graph.connect(a, "OutputWorkspace", 2, "LHSWorkspace"),
+                     const std::out_of_range &)
+  }
+};
@@ -19,6 +19,7 @@
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/ReadLock.h"
 #include "MantidKernel/RebinParamsValidator.h"
@@ -44,6 +45,7 @@ public:
   int version() const override { return 1; }
   const std::string category() const override { return "Cat;Leopard;Mink"; }
   const std::string summary() const override { return "Test summary"; }
+  bool isGroupProcessingThreadSafe() const override { return true; }
 
   void init() override {
     declareProperty(std::make_unique<WorkspaceProperty<>>("InputWorkspace1", "",
@@ -147,6 +149,7 @@ public:
   const std::string name() const override { return "FailingAlgorithm"; }
   int version() const override { return 1; }
   const std::string summary() const override { return "Test summary"; }
+  bool isGroupProcessingThreadSafe() const override { return true; }
   static const std::string FAIL_MSG;
 
   void init() override {
@@ -819,6 +822,46 @@ public:
     }
   }
 
+  void test_group_processing_is_not_thread_safe_by_default() {
+    StubbedWorkspaceAlgorithm2 alg;
+    TS_ASSERT(!alg.isGroupProcessingThreadSafe());
+  }
+
+  void test_processGroups_inParallel() {
+    auto &config = ConfigService::Instance();
+    config.setString("algorithms.processgroups.parallel", "1");
+    WorkspaceGroup_sptr group =
+        do_test_groups("A", "A_1,A_2,A_3,A_4,A_5,A_6,A_7,A_8", "B", "", "", "",
+                       false, 8);
+    config.setString("algorithms.processgroups.parallel", "0");
+
+    // The members are added in order, however they were executed
+    for (size_t i = 0; i < group->size(); ++i) {
+      const auto entry = std::to_string(i + 1);
+      TS_ASSERT_EQUALS(group->getItem(i)->getName(), "D_" + entry);
+      TS_ASSERT_EQUALS(group->getItem(i)->getTitle(), "A_" + entry + "+B+");
+    }
+  }
+
+  void test_processGroups_inParallel_failOnGroupMemberErrorMessage() {
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4");
+    auto &config = ConfigService::Instance();
+    config.setString("algorithms.processgroups.parallel", "1");
+
+    FailingAlgorithm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setLogging(false);
+    alg.setPropertyValue("InputWorkspace", "A");
+    alg.setPropertyValue("WsNameToFail", "A_3");
+    TS_ASSERT_THROWS_EQUALS(alg.execute(), const std::runtime_error &e,
+                            std::string(e.what()),
+                            "Execution of FailingAlgorithm for group entry 3 "
+                            "failed: " +
+                                FailingAlgorithm::FAIL_MSG);
+    config.setString("algorithms.processgroups.parallel", "0");
+  }
+
   /// Rewrite first input group
   void test_processGroups_rewriteFirstGroup() {
     WorkspaceGroup_sptr group =
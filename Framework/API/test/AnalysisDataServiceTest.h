@@ -10,6 +10,13 @@
 
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+
 #include <memory>
 
 using namespace Mantid::Kernel;
@@ -30,6 +37,67 @@ private:
   }
 };
 using MockWorkspace_sptr = std::shared_ptr<MockWorkspace>;
+
+/// A matrix workspace that releases its histograms as a Workspace2D does
+class ReleasableWorkspaceTester : public WorkspaceTester {
+public:
+  bool releaseHistograms(const HistogramStore &store) override {
+    if (m_source)
+      return false;
+    if (beforeRelease)
+      beforeRelease();
+    auto source = store(*this);
+    if (!source)
+      return false;
+    for (size_t i = 0; i < getNumberHistograms(); ++i) {
+      auto &spectrum = WorkspaceTester::getSpectrum(i);
+      // The histogram shares the data, keeping it alive
+      m_released.emplace_back(spectrum.histogram());
+      spectrum.setHistogram(Mantid::HistogramData::Points(0),
+                            Mantid::HistogramData::Counts(0),
+                            Mantid::HistogramData::CountStandardDeviations(0));
+    }
+    m_source = std::move(source);
+    return true;
+  }
+  void discardReleasedHistograms() override { m_released.clear(); }
+  bool released() const { return static_cast<bool>(m_source); }
+  bool keepsReleasedHistograms() const { return !m_released.empty(); }
+
+  /// Called when the histograms are about to be released
+  std::function<void()> beforeRelease;
+
+  ISpectrum &getSpectrum(const size_t index) override {
+    restore();
+    return WorkspaceTester::getSpectrum(index);
+  }
+  const ISpectrum &getSpectrum(const size_t index) const override {
+    restore();
+    return WorkspaceTester::getSpectrum(index);
+  }
+  size_t size() const override {
+    restore();
+    return WorkspaceTester::size();
+  }
+  size_t blocksize() const override {
+    restore();
+    return WorkspaceTester::blocksize();
+  }
+
+private:
+  void restore() const {
+    if (!m_source)
+      return;
+    auto histograms = m_source();
+    m_source = nullptr;
+    auto &self = const_cast<ReleasableWorkspaceTester &>(*this);
+    for (size_t i = 0; i < histograms.size(); ++i)
+      self.WorkspaceTester::getSpectrum(i).setHistogram(histograms[i]);
+  }
+
+  mutable HistogramSource m_source;
+  std::vector<Mantid::HistogramData::Histogram> m_released;
+};
 } // namespace
 
 class AnalysisDataServiceTest : public CxxTest::TestSuite {
@@ -523,6 +591,129 @@ public:
     TS_ASSERT_THROWS(ads.addToGroup("ws1", "ws1"), const std::runtime_error &);
   }
 
+  void test_idle_workspaces_are_spilled_and_read_back() {
+    const auto before = ads.memoryStatistics();
+    std::weak_ptr<Workspace> original = addMatrixWorkspaceToADS("spilled", 1.);
+    ads.addOrReplace("second", createMatrixWorkspace(2.));
+    TS_ASSERT_EQUALS(ads.memoryStatistics().spilledWorkspaces, 0)
+
+    ads.setMemoryBudget(1);
+    const auto spilled = ads.memoryStatistics();
+    TS_ASSERT_EQUALS(spilled.budget, 1)
+    TS_ASSERT_EQUALS(spilled.spilledWorkspaces, 2)
+    TS_ASSERT_EQUALS(spilled.spills - before.spills, 2)
+    TS_ASSERT(spilled.spilledMemory > 0)
+
+    // Handles to the workspace stay valid, and retrieving it does not read
+    // the data back until it is used
+    auto workspace = std::dynamic_pointer_cast<ReleasableWorkspaceTester>(
+        original.lock());
+    TS_ASSERT(workspace)
+    TS_ASSERT_EQUALS(ads.retrieve("spilled"), workspace)
+    TS_ASSERT(workspace->released())
+    TS_ASSERT_EQUALS(workspace->getName(), "spilled")
+    checkMatrixWorkspace(*workspace, 1.);
+    TS_ASSERT(!workspace->released())
+    const auto reloaded = ads.memoryStatistics();
+    TS_ASSERT_EQUALS(reloaded.reloads - before.reloads, 1)
+    TS_ASSERT_EQUALS(reloaded.spilledWorkspaces, 1)
+    ads.setMemoryBudget(0);
+  }
+
+  void test_workspaces_in_use_are_not_spilled() {
+    auto workspace = createMatrixWorkspace(3.);
+    ads.add("held", workspace);
+    const auto before = ads.memoryStatistics();
+    ads.setMemoryBudget(1);
+    TS_ASSERT_EQUALS(ads.memoryStatistics().spills, before.spills)
+    TS_ASSERT_EQUALS(ads.retrieve("held"), workspace)
+    ads.setMemoryBudget(0);
+  }
+
+  void test_data_referred_to_during_a_spill_stays_valid() {
+    std::weak_ptr<Workspace> handle = addMatrixWorkspaceToADS("raced", 9.);
+    auto &tester = dynamic_cast<ReleasableWorkspaceTester &>(*handle.lock());
+    // A weak handle locked after the workspace was found to be idle
+    MatrixWorkspace_sptr reader;
+    const Mantid::MantidVec *y = nullptr;
+    tester.beforeRelease = [&handle, &reader, &y]() {
+      reader = std::dynamic_pointer_cast<MatrixWorkspace>(handle.lock());
+      y = &reader->readY(1);
+    };
+    ads.setMemoryBudget(1);
+    tester.beforeRelease = nullptr;
+    TS_ASSERT(tester.released())
+    TS_ASSERT(tester.keepsReleasedHistograms())
+    TS_ASSERT(y)
+    if (y) {
+      TS_ASSERT_EQUALS(*y, Mantid::MantidVec({10., 11., 12.}))
+    }
+
+    // Freed once the service is the only holder again
+    reader.reset();
+    ads.setMemoryBudget(1);
+    TS_ASSERT(!tester.keepsReleasedHistograms())
+    checkMatrixWorkspace(tester, 9.);
+    ads.setMemoryBudget(0);
+  }
+
+  void test_spilled_workspaces_are_dropped_on_clear() {
+    addMatrixWorkspaceToADS("cleared", 4.);
+    ads.setMemoryBudget(1);
+    TS_ASSERT_EQUALS(ads.memoryStatistics().spilledWorkspaces, 1)
+    ads.setMemoryBudget(0);
+    ads.clear();
+    const auto statistics = ads.memoryStatistics();
+    TS_ASSERT_EQUALS(statistics.spilledWorkspaces, 0)
+    TS_ASSERT_EQUALS(statistics.residentMemory, 0)
+  }
+
+  void test_removed_or_replaced_spilled_workspaces_are_not_read_back() {
+    auto &config = ConfigService::Instance();
+    const auto oldDirectory =
+        config.getString("analysisdataservice.spilldirectory");
+    Poco::Path directory(Poco::Path::temp());
+    directory.pushDirectory("ads_spill_test_" +
+                            std::to_string(Poco::Process::id()));
+    Poco::File(directory).createDirectories();
+    config.setString("analysisdataservice.spilldirectory",
+                     directory.toString());
+
+    addMatrixWorkspaceToADS("removed", 5.);
+    addMatrixWorkspaceToADS("replaced", 6.);
+    ads.setMemoryBudget(1);
+    const auto spilled = ads.memoryStatistics();
+    TS_ASSERT_EQUALS(spilled.spilledWorkspaces, 2)
+    TS_ASSERT_EQUALS(numberOfFiles(directory), 2)
+    ads.setMemoryBudget(0);
+
+    ads.remove("removed");
+    ads.addOrReplace("replaced", std::make_shared<MockWorkspace>());
+    const auto statistics = ads.memoryStatistics();
+    TS_ASSERT_EQUALS(statistics.reloads, spilled.reloads)
+    TS_ASSERT_EQUALS(statistics.spilledWorkspaces, 0)
+    TS_ASSERT_EQUALS(statistics.spilledMemory, 0)
+    TS_ASSERT_EQUALS(numberOfFiles(directory), 0)
+
+    config.setString("analysisdataservice.spilldirectory", oldDirectory);
+    Poco::File(directory).remove(true);
+  }
+
+  void test_memory_is_tracked_as_workspaces_are_added_and_removed() {
+    TS_ASSERT_EQUALS(ads.memoryStatistics().residentMemory, 0)
+    auto first = createMatrixWorkspace(7.);
+    auto second = createMatrixWorkspace(8.);
+    ads.add("first", first);
+    ads.add("second", second);
+    TS_ASSERT_EQUALS(ads.memoryStatistics().residentMemory,
+                     first->getMemorySize() + second->getMemorySize())
+    ads.rename("second", "first");
+    TS_ASSERT_EQUALS(ads.memoryStatistics().residentMemory,
+                     second->getMemorySize())
+    ads.remove("first");
+    TS_ASSERT_EQUALS(ads.memoryStatistics().residentMemory, 0)
+  }
+
 private:
   /// If replace=true then usea addOrReplace
   void doAddingOnInvalidNameTests(bool replace) {
@@ -603,4 +794,49 @@ private:
   void addOrReplaceToADS(const std::string &name) {
     ads.addOrReplace(name, Workspace_sptr(new MockWorkspace));
   }
+
+  /// Create a matrix workspace whose values are derived from offset
+  MatrixWorkspace_sptr createMatrixWorkspace(const double offset) {
+    auto workspace = std::make_shared<ReleasableWorkspaceTester>();
+    workspace->initialize(3, 4, 3);
+    for (size_t i = 0; i < workspace->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < workspace->blocksize(); ++j) {
+        workspace->mutableY(i)[j] = offset + static_cast<double>(i + j);
+        workspace->mutableE(i)[j] = offset * static_cast<double>(j);
+      }
+    }
+    workspace->mutableX(1)[2] = offset;
+    return workspace;
+  }
+
+  /// Add a matrix workspace, that only the ADS holds, to the ADS
+  Workspace_sptr addMatrixWorkspaceToADS(const std::string &name,
+                                         const double offset) {
+    ads.add(name, createMatrixWorkspace(offset));
+    return ads.retrieve(name);
+  }
+
+  /// The number of files in a directory
+  size_t numberOfFiles(const Poco::Path &directory) {
+    std::vector<std::string> files;
+    Poco::File(directory).list(files);
+    return files.size();
+  }
+
+  void checkMatrixWorkspace(const MatrixWorkspace &workspace,
+                            const double offset) {
+    const auto expected = createMatrixWorkspace(offset);
+    TS_ASSERT_EQUALS(workspace.getNumberHistograms(),
+                     expected->getNumberHistograms())
+    for (size_t i = 0; i < expected->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(workspace.x(i).rawData(), expected->x(i).rawData())
+      TS_ASSERT_EQUALS(workspace.y(i).rawData(), expected->y(i).rawData())
+      TS_ASSERT_EQUALS(workspace.e(i).rawData(), expected->e(i).rawData())
+      TS_ASSERT_EQUALS(workspace.histogram(i).xMode(),
+                       expected->histogram(i).xMode())
+    }
+    // The X data that was shared is shared again
+    TS_ASSERT_EQUALS(&workspace.x(0) == &workspace.x(2),
+                     &expected->x(0) == &expected->x(2))
+  }
 };
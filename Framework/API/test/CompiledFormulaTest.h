@@ -0,0 +1,158 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/CompiledFormula.h"
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace Mantid::API;
+
+class CompiledFormulaTest : public CxxTest::TestSuite {
+public:
+  static CompiledFormulaTest *createSuite() {
+    return new CompiledFormulaTest();
+  }
+  static void destroySuite(CompiledFormulaTest *suite) { delete suite; }
+
+  void test_operator_precedence() {
+    TS_ASSERT_DELTA(evaluate("1 + 2 * 3"), 7.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("(1 + 2) * 3"), 9.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("-2^2"), -4.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("2^3^2"), 512.0, 1e-12);
+    TS_ASSERT_DELTA(evaluate("8 / 4 / 2"), 1.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("1 < 2 && 3 > 4 || 2 == 2"), 1.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("1.5e2 + .5"), 150.5, 1e-12);
+  }
+
+  void test_functions_and_constants() {
+    TS_ASSERT_DELTA(evaluate("sin(_pi / 2) + ln(_e) + log10(100)"), 4.0,
+                    1e-14);
+    TS_ASSERT_DELTA(evaluate("sqrt(16) + abs(-2) + sign(-3)"), 5.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("min(3, 1, 2) + max(3, 1, 2)"), 4.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("sum(1, 2, 3) + avg(1, 2, 3)"), 8.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("erf(0.5) + erfc(0.5)"), 1.0, 1e-14);
+  }
+
+  void test_functions_of_variables() {
+    const CompiledFormula formula(
+        "sin(x) + cos(x) + tan(x) + asin(x) + acos(x) + atan(x) + sinh(x) + "
+        "cosh(x) + tanh(x) + asinh(x) + acosh(x + 1) + atanh(x) + exp(x) + "
+        "ln(x) + log10(x) + log2(x) + sign(x) + rint(10 * x) + erf(x) + "
+        "erfc(x) + (x < 0.5 && x > 0.2) + (x < 0.1 || x > 0.9)",
+        {"x"});
+    const size_t n = 600;
+    std::vector<double> x(n), out(n);
+    for (size_t i = 0; i < n; ++i)
+      x[i] = 0.001 + static_cast<double>(i) / static_cast<double>(n);
+    formula.evaluate(out.data(), n, {x.data()});
+    for (size_t i = 0; i < n; ++i) {
+      const double v = x[i];
+      const double expected =
+          std::sin(v) + std::cos(v) + std::tan(v) + std::asin(v) +
+          std::acos(v) + std::atan(v) + std::sinh(v) + std::cosh(v) +
+          std::tanh(v) + std::asinh(v) + std::acosh(v + 1) + std::atanh(v) +
+          std::exp(v) + std::log(v) + std::log10(v) + std::log2(v) + 1.0 +
+          std::floor(10 * v + 0.5) + std::erf(v) + std::erfc(v) +
+          (v < 0.5 && v > 0.2 ? 1.0 : 0.0) + (v < 0.1 || v > 0.9 ? 1.0 : 0.0);
+      TS_ASSERT_DELTA(out[i], expected, 1e-10);
+    }
+  }
+
+  void test_variables_parameters_and_constants() {
+    const CompiledFormula formula("x > 1 ? a * x^2 + y : c", {"x", "y"},
+                                  {"a"}, {{"c", -1.0}});
+    TS_ASSERT_EQUALS(formula.numberOfVariables(), 2);
+    TS_ASSERT_EQUALS(formula.numberOfParameters(), 1);
+
+    // More points than are evaluated in one block
+    const size_t n = 1000;
+    std::vector<double> x(n), y(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = 0.01 * static_cast<double>(i);
+      y[i] = 2.0 * x[i];
+    }
+    formula.evaluate(out.data(), n, {x.data(), y.data()}, {3.0});
+    for (size_t i = 0; i < n; ++i) {
+      const double expected = x[i] > 1.0 ? 3.0 * x[i] * x[i] + y[i] : -1.0;
+      TS_ASSERT_DELTA(out[i], expected, 1e-12);
+    }
+  }
+
+  void test_derivatives() {
+    const CompiledFormula formula("h * exp(-0.5 * ((x - c) / s)^2) + b",
+                                  {"x"}, {"h", "c", "s", "b"});
+    const double h = 2.0, c = 0.3, s = 0.7;
+    const size_t n = 300;
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i)
+      x[i] = -3.0 + 0.02 * static_cast<double>(i);
+    std::vector<std::vector<double>> derivatives(4, std::vector<double>(n));
+    formula.evaluateDerivatives(
+        {derivatives[0].data(), derivatives[1].data(), derivatives[2].data(),
+         derivatives[3].data()},
+        n, {x.data()}, {h, c, s, 1.0});
+
+    for (size_t i = 0; i < n; ++i) {
+      const double z = (x[i] - c) / s;
+      const double g = std::exp(-0.5 * z * z);
+      TS_ASSERT_DELTA(derivatives[0][i], g, 1e-14);
+      TS_ASSERT_DELTA(derivatives[1][i], h * g * z / s, 1e-13);
+      TS_ASSERT_DELTA(derivatives[2][i], h * g * z * z / s, 1e-13);
+      TS_ASSERT_DELTA(derivatives[3][i], 1.0, 1e-15);
+    }
+  }
+
+  void test_derivatives_of_functions() {
+    const double x = 0.4, a = 1.3;
+    TS_ASSERT_DELTA(derivative("sin(a * x)", x, a), x * std::cos(a * x),
+                    1e-14);
+    TS_ASSERT_DELTA(derivative("log(a) + sqrt(a)", x, a),
+                    1.0 / a + 0.5 / std::sqrt(a), 1e-14);
+    TS_ASSERT_DELTA(derivative("x^a", x, a), std::pow(x, a) * std::log(x),
+                    1e-14);
+    TS_ASSERT_DELTA(derivative("atan(a) / a", x, a),
+                    1.0 / (a * (1.0 + a * a)) - std::atan(a) / (a * a), 1e-14);
+    TS_ASSERT_DELTA(derivative("max(a, x) + min(a, x)", x, a), 1.0, 1e-15);
+    TS_ASSERT_DELTA(derivative("erf(a)", x, a),
+                    M_2_SQRTPI * std::exp(-a * a), 1e-14);
+    TS_ASSERT_DELTA(derivative("a > x ? a^2 : x", x, a), 2.0 * a, 1e-14);
+  }
+
+  void test_unsupported_formulas_throw() {
+    TS_ASSERT_THROWS(CompiledFormula("x + unknown", {"x"}),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("x, 2 * x", {"x"}),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("x = 2", {"x"}),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("foo(x)", {"x"}),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("sin(x, x)", {"x"}),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("(x + 1", {"x"}),
+                     const std::invalid_argument &);
+  }
+
+private:
+  static double evaluate(const std::string &expression) {
+    const CompiledFormula formula(expression, {});
+    double out = 0.0;
+    formula.evaluate(&out, 1, {});
+    return out;
+  }
+
+  static double derivative(const std::string &expression, double x,
+                           double a) {
+    const CompiledFormula formula(expression, {"x"}, {"a"});
+    double out = 0.0;
+    formula.evaluateDerivatives({&out}, 1, {&x}, {a});
+    return out;
+  }
+};
@@ -15,9 +15,12 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/V3D.h"
 #include "MantidTestHelpers/NexusTestHelper.h"
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cxxtest/TestSuite.h>
 #include <json/value.h>
+#include <thread>
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
@@ -639,7 +642,110 @@ public:
     }
   }
 
+  void test_deferred_property_is_created_on_first_access() {
+    LogManager runInfo;
+    auto calls = std::make_shared<int>(0);
+    runInfo.addDeferredProperty("Temp", createDeferred("Temp", calls));
+    TS_ASSERT_EQUALS(*calls, 0);
+    TS_ASSERT(runInfo.hasProperty("Temp"));
+    TS_ASSERT(runInfo.hasProperty("temp"));
+    TS_ASSERT(runInfo.isDeferredProperty("Temp"));
+
+    Property *prop = nullptr;
+    TS_ASSERT_THROWS_NOTHING(prop = runInfo.getProperty("Temp"));
+    TS_ASSERT_EQUALS(*calls, 1);
+    TS_ASSERT(dynamic_cast<ConcreteProperty *>(prop));
+    TS_ASSERT(!runInfo.isDeferredProperty("Temp"));
+    TS_ASSERT_EQUALS(runInfo.getProperty("Temp"), prop);
+    TS_ASSERT_EQUALS(*calls, 1);
+  }
+
+  void test_getProperties_creates_deferred_properties() {
+    LogManager runInfo;
+    auto calls = std::make_shared<int>(0);
+    runInfo.addProperty(new ConcreteProperty("Pressure"));
+    runInfo.addDeferredProperty("Temp", createDeferred("Temp", calls));
+    TS_ASSERT_EQUALS(runInfo.getProperties().size(), 2);
+    TS_ASSERT_EQUALS(*calls, 1);
+  }
+
+  void test_copies_share_a_deferred_property() {
+    LogManager runInfo;
+    auto calls = std::make_shared<int>(0);
+    runInfo.addDeferredProperty("Temp", createDeferred("Temp", calls));
+    LogManager copy(runInfo);
+    TS_ASSERT(copy.isDeferredProperty("Temp"));
+    TS_ASSERT_THROWS_NOTHING(runInfo.getProperty("Temp"));
+    TS_ASSERT_THROWS_NOTHING(copy.getProperty("Temp"));
+    TS_ASSERT_EQUALS(*calls, 1);
+    // Each copy has its own property
+    TS_ASSERT_DIFFERS(runInfo.getProperty("Temp"), copy.getProperty("Temp"));
+  }
+
+  void test_removed_or_overwritten_deferred_property_is_not_created() {
+    LogManager runInfo;
+    auto calls = std::make_shared<int>(0);
+    runInfo.addDeferredProperty("Temp", createDeferred("Temp", calls));
+    TS_ASSERT_THROWS(
+        runInfo.addDeferredProperty("Temp", createDeferred("Temp", calls)),
+        const Exception::ExistsError &);
+    runInfo.removeProperty("Temp");
+    TS_ASSERT(!runInfo.hasProperty("Temp"));
+
+    runInfo.addDeferredProperty("Temp", createDeferred("Temp", calls));
+    runInfo.addProperty(new ConcreteProperty("Temp"), true);
+    TS_ASSERT(!runInfo.isDeferredProperty("Temp"));
+    TS_ASSERT_EQUALS(runInfo.getProperties().size(), 1);
+    TS_ASSERT_EQUALS(*calls, 0);
+  }
+
+  void test_deferred_property_that_fails_is_dropped() {
+    LogManager runInfo;
+    runInfo.addDeferredProperty("Temp", []() -> std::unique_ptr<Property> {
+      throw std::runtime_error("the file has gone");
+    });
+    TS_ASSERT_THROWS(runInfo.getProperty("Temp"),
+                     const Exception::NotFoundError &);
+    TS_ASSERT(!runInfo.hasProperty("Temp"));
+  }
+
+  void test_deferred_property_is_never_missing_while_it_is_created() {
+    LogManager runInfo;
+    auto calls = std::make_shared<int>(0);
+    runInfo.addDeferredProperty("Temp", [calls]() {
+      ++*calls;
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      return std::make_unique<ConcreteProperty>("Temp");
+    });
+    std::atomic<int> missing{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([&runInfo, &missing]() {
+        try {
+          if (!runInfo.hasProperty("Temp") || !runInfo.getProperty("Temp"))
+            ++missing;
+        } catch (Exception::NotFoundError &) {
+          ++missing;
+        }
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    TS_ASSERT_EQUALS(missing.load(), 0);
+    TS_ASSERT_EQUALS(*calls, 1);
+    TS_ASSERT(!runInfo.isDeferredProperty("Temp"));
+  }
+
 private:
+  std::function<std::unique_ptr<Property>()>
+  createDeferred(const std::string &name, std::shared_ptr<int> calls) {
+    return [name, calls]() {
+      ++*calls;
+      return std::make_unique<ConcreteProperty>(name);
+    };
+  }
+
+
   template <typename T>
   void doTest_GetPropertyAsSingleValue_SingleType(const T value) {
     LogManager runInfo;
@@ -8,10 +8,12 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "MantidAPI/Run.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/SpectrumInfoIterator.h"
 #include "MantidBeamline/SpectrumInfo.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidKernel/MultiThreaded.h"
@@ -291,6 +293,115 @@ public:
     detectorInfo.setPosition(1, oldPos);
   }
 
+  void test_bulk_columns_match_single_spectrum_values() {
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    const auto &l2s = spectrumInfo.l2s();
+    const auto &twoThetas = spectrumInfo.twoThetas();
+    const auto &signedTwoThetas = spectrumInfo.signedTwoThetas();
+    const auto &azimuthals = spectrumInfo.azimuthals();
+    TS_ASSERT_EQUALS(l2s.size(), spectrumInfo.size());
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_EQUALS(l2s[i], spectrumInfo.l2(i));
+      TS_ASSERT_EQUALS(twoThetas[i], spectrumInfo.twoTheta(i));
+      TS_ASSERT_EQUALS(signedTwoThetas[i], spectrumInfo.signedTwoTheta(i));
+      TS_ASSERT_EQUALS(azimuthals[i], spectrumInfo.azimuthal(i));
+    }
+    // Monitors
+    for (size_t i = 3; i < 5; ++i) {
+      TS_ASSERT_EQUALS(l2s[i], spectrumInfo.l2(i));
+      TS_ASSERT(std::isnan(twoThetas[i]));
+      TS_ASSERT(std::isnan(signedTwoThetas[i]));
+      TS_ASSERT(std::isnan(azimuthals[i]));
+    }
+  }
+
+  void test_bulk_difc() {
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    const auto &difcs = spectrumInfo.difcs();
+    const double l1 = spectrumInfo.l1();
+    for (size_t i = 0; i < 3; ++i)
+      TS_ASSERT_DELTA(difcs[i],
+                      1. / Conversion::tofToDSpacingFactor(
+                               l1, spectrumInfo.l2(i),
+                               spectrumInfo.twoTheta(i), 0.),
+                      1e-9);
+    TS_ASSERT(std::isnan(difcs[3]));
+  }
+
+  void test_bulk_eFixeds_throws_for_elastic() {
+    TS_ASSERT_THROWS(m_workspace.spectrumInfo().eFixeds(),
+                     const std::runtime_error &);
+  }
+
+  void test_bulk_eFixeds_track_parameter_changes() {
+    auto ws = makeDefaultWorkspace();
+    ws.mutableRun().addProperty("deltaE-mode", std::string("indirect"));
+    const auto &detectorInfo = ws.detectorInfo();
+    auto &pmap = ws.instrumentParameters();
+    for (size_t i = 0; i < detectorInfo.size(); ++i)
+      pmap.addDouble(&detectorInfo.detector(i), "Efixed", 1.5);
+    const auto &spectrumInfo = ws.spectrumInfo();
+    TS_ASSERT_EQUALS(spectrumInfo.eFixeds()[1], 1.5);
+    // Parameters set directly rather than through setEFixed are also tracked
+    pmap.addDouble(&detectorInfo.detector(1), "Efixed", 2.5);
+    TS_ASSERT_EQUALS(spectrumInfo.eFixeds()[1], 2.5);
+    TS_ASSERT_EQUALS(spectrumInfo.eFixeds()[2], 1.5);
+  }
+
+  void test_bulk_columns_are_cached() {
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    const auto *first = spectrumInfo.l2s().data();
+    const auto *second = spectrumInfo.l2s().data();
+    TS_ASSERT_EQUALS(first, second);
+  }
+
+  void test_grouped_bulk_columns() {
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    const auto &l2s = spectrumInfo.l2s();
+    const auto &twoThetas = spectrumInfo.twoThetas();
+    TS_ASSERT_EQUALS(l2s[GroupOfDets2And3], spectrumInfo.l2(GroupOfDets2And3));
+    TS_ASSERT_DELTA(twoThetas[GroupOfDets2And3], 0.0199973 / 2.0, 1e-6);
+    TS_ASSERT_DELTA(twoThetas[GroupOfDets1And2], 0.0199973 / 2.0, 1e-6);
+    // Groups including monitors have no scattering angle
+    TS_ASSERT(std::isnan(twoThetas[GroupOfDets1And4]));
+    TS_ASSERT(std::isnan(twoThetas[GroupOfDets4And5]));
+  }
+
+  void test_bulk_columns_track_position_changes() {
+    auto &detectorInfo = m_grouped.mutableDetectorInfo();
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    TS_ASSERT_DELTA(spectrumInfo.twoThetas()[GroupOfDets2And3],
+                    0.0199973 / 2.0, 1e-6);
+    const auto oldPos = detectorInfo.position(1);
+    // Change Y pos from 0.0 to -0.1
+    detectorInfo.setPosition(1, V3D(0.0, -0.1, 5.0));
+    TS_ASSERT_DELTA(spectrumInfo.twoThetas()[GroupOfDets2And3], 0.0199973,
+                    1e-6);
+    TS_ASSERT_EQUALS(spectrumInfo.l2s()[GroupOfDets2And3],
+                     spectrumInfo.l2(GroupOfDets2And3));
+    // Restore old position
+    detectorInfo.setPosition(1, oldPos);
+    TS_ASSERT_DELTA(spectrumInfo.twoThetas()[GroupOfDets2And3],
+                    0.0199973 / 2.0, 1e-6);
+  }
+
+  void test_bulk_columns_track_sample_position_changes() {
+    auto ws = makeDefaultWorkspace();
+    const auto &spectrumInfo = ws.spectrumInfo();
+    TS_ASSERT_EQUALS(spectrumInfo.l2s()[1], 5.0);
+    auto &componentInfo = ws.mutableComponentInfo();
+    componentInfo.setPosition(componentInfo.sample(), V3D(0.0, 0.0, 1.0));
+    TS_ASSERT_EQUALS(spectrumInfo.l2s()[1], 4.0);
+  }
+
+  void test_bulk_columns_track_grouping_changes() {
+    auto ws = makeDefaultWorkspace();
+    const auto &spectrumInfo = ws.spectrumInfo();
+    TS_ASSERT_DELTA(spectrumInfo.twoThetas()[0], 0.0199973, 1e-6);
+    ws.getSpectrum(0).setDetectorIDs({1, 2});
+    TS_ASSERT_DELTA(spectrumInfo.twoThetas()[0], 0.0199973 / 2.0, 1e-6);
+  }
+
   void test_hasDetectors() {
     const auto &spectrumInfo = m_workspace.spectrumInfo();
     TS_ASSERT(spectrumInfo.hasDetectors(0));
@@ -654,6 +765,20 @@ public:
     TS_ASSERT_DELTA(result, 5214709.740869, 1e-6);
   }
 
+  void test_typical_bulk() {
+    double result = 0.0;
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    const double l1 = spectrumInfo.l1();
+    const auto &l2s = spectrumInfo.l2s();
+    const auto &twoThetas = spectrumInfo.twoThetas();
+    for (size_t i = 0; i < 10000; ++i) {
+      result += l1;
+      result += l2s[i];
+      result += twoThetas[i];
+    }
+    TS_ASSERT_DELTA(result, 5214709.740869, 1e-6);
+  }
+
 private:
   WorkspaceTester m_workspace;
 };
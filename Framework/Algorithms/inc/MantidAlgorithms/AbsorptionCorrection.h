@@ -43,6 +43,9 @@ namespace Algorithms {
    numerical integral is calculated (default: all points). </LI>
     <LI> ExpMethod - The method to calculate exponential function (Normal of
    Fast approximation). </LI>
+    <LI> DirectionTolerance - The angle in degrees below which detectors share
+   the path lengths out of the sample (default: 0, only detectors at the same
+   position). </LI>
     </UL>
 
     This class, which must be overridden to provide the specific sample geometry
@@ -58,6 +61,11 @@ namespace Algorithms {
     and a numerical integration is carried out using these path lengths over the
    volume elements.
 
+    The L1 distances, element volumes and positions are kept between runs with
+    the same sample geometry, element size and beam direction, and the path
+    lengths out of the sample are computed once for each group of detectors
+    sharing a direction.
+
     This algorithm assumes that the beam comes along the Z axis, that Y is up
     and that the sample is at the origin.
 
@@ -79,6 +87,9 @@ public:
            "can be defined by the CreateSampleShape algorithm.";
   }
 
+  static size_t cachedGeometryCount();
+  static void clearCachedGeometries();
+
 protected:
   /** A virtual function in which additional properties of an algorithm should
    * be declared.
@@ -119,17 +130,21 @@ private:
 
   void retrieveBaseProperties();
   void constructSample(API::Sample &sample);
-  void calculateDistances(const Geometry::IDetector &detector,
+  void initialiseOrReuseCachedDistances();
+  std::string cachedDistancesKey() const;
+  std::vector<std::vector<size_t>>
+  groupSpectraByDirection(const std::vector<Kernel::V3D> &detectorPositions,
+                          const std::vector<bool> &hasDetector) const;
+  Kernel::V3D detectorPosition(const Geometry::IDetector &detector) const;
+  void calculateDistances(const Kernel::V3D &detectorPos,
                           std::vector<double> &L2s) const;
-  inline double doIntegration(const double linearCoefAbs,
-                              const std::vector<double> &L2s,
-                              const size_t startIndex,
-                              const size_t endIndex) const;
-  inline double doIntegration(const double linearCoefAbsL1,
-                              const double linearCoefAbsL2,
-                              const std::vector<double> &L2s,
-                              const size_t startIndex,
-                              const size_t endIndex) const;
+  std::vector<double>
+  fixedLegWeights(const double lambdaFixed,
+                  const std::vector<double> &pathLengths) const;
+  double doIntegration(const double linearCoef,
+                       const std::vector<double> &pathLengths,
+                       const std::vector<double> &weights,
+                       const size_t startIndex, const size_t endIndex) const;
 
   Kernel::Material m_material;
   double m_linearCoefTotScatt; ///< The total scattering cross-section in 1/m
@@ -139,10 +154,11 @@ private:
   Kernel::DeltaEMode::Type m_emode;
   double m_lambdaFixed; ///< The wavelength corresponding to the fixed energy,
   /// if provided
-
-  using expfunction =
-      double (*)(double);  ///< Typedef pointer to exponential function
-  expfunction EXPONENTIAL; ///< Pointer to exponential function
+  double m_directionTolerance; ///< Angle in radians below which detectors
+  /// share their L2 distances
+  bool m_useFastExp; ///< Use the fast approximation of the exponential
+  /// The properties declared by the concrete algorithm
+  std::vector<std::string> m_elementPropertyNames;
 };
 
 } // namespace Algorithms
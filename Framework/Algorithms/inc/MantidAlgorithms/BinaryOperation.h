@@ -43,6 +43,8 @@ class MANTID_ALGORITHMS_DLL BinaryOperation : public API::Algorithm {
 public:
   /// Algorithm's category for identification overriding a virtual method
   const std::string category() const override { return "Arithmetic"; }
+  /// Operations only touch their own input and output workspaces
+  bool isGroupProcessingThreadSafe() const override { return true; }
 
   /** BinaryOperationTable: a list of ints.
    * Index into vector: workspace index in the lhs;
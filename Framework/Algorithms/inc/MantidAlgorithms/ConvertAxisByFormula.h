@@ -18,8 +18,9 @@ class Parser;
 namespace Mantid {
 
 namespace API {
+class CompiledFormula;
 class SpectrumInfo;
-}
+} // namespace API
 
 namespace Algorithms {
 /** ConvertAxisByFormula : Performs a unit conversion based on a supplied
@@ -62,7 +63,8 @@ private:
   using Variable_ptr = std::shared_ptr<Variable>;
 
   void setAxisValue(const double &value, std::vector<Variable_ptr> &variables);
-  void calculateValues(mu::Parser &p, std::vector<double> &vec,
+  void calculateValues(mu::Parser &p, const API::CompiledFormula *compiled,
+                       std::vector<double> &vec,
                        std::vector<Variable_ptr> variables);
   void setGeometryValues(const API::SpectrumInfo &specInfo, const size_t index,
                          std::vector<Variable_ptr> &variables);
@@ -0,0 +1,55 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidAlgorithms/DllConfig.h"
+
+namespace Mantid {
+namespace Algorithms {
+
+/** EvaluateWorkspaceExpression : Evaluates an arithmetic expression over
+  MatrixWorkspaces of the same shape in a single pass.
+
+  The expression, e.g. "(A-B)/V*eff", names workspaces in the analysis data
+  service and may contain numeric constants, the operators + - * / ^ and
+  brackets. Each name is bound to a workspace property, InputWorkspace_1 for
+  the first name and so on, which is declared when the expression is set, so
+  the inputs are locked, recorded in the history and may be groups.
+
+  The expression is compiled once into a short stack program that is run
+  over blocks of bins of each spectrum in parallel, so no intermediate
+  workspaces are created. Uncertainties are propagated as variances, with
+  the same formulae as Plus, Minus, Multiply, Divide and Power, and the
+  square root is taken only when the result is written out. Units,
+  distribution flags and masking follow the binary operations.
+*/
+class MANTID_ALGORITHMS_DLL EvaluateWorkspaceExpression
+    : public API::Algorithm {
+public:
+  const std::string name() const override;
+  int version() const override;
+  const std::vector<std::string> seeAlso() const override {
+    return {"Plus", "Minus", "Multiply", "Divide", "Power"};
+  }
+  const std::string category() const override;
+  const std::string summary() const override;
+  std::map<std::string, std::string> validateInputs() override;
+
+private:
+  void init() override;
+  void exec() override;
+  void afterPropertySet(const std::string &propName) override;
+
+  std::vector<API::MatrixWorkspace_const_sptr>
+  retrieveInputs(const std::vector<std::string> &names) const;
+  static std::string inputPropertyName(const size_t index);
+};
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -15,7 +15,6 @@
 #include "MantidHistogramData/BinEdges.h"
 #include "MantidHistogramData/Points.h"
 #include "MantidKernel/cow_ptr.h"
-#include <gsl/gsl_fft_complex.h>
 
 namespace Mantid {
 
@@ -81,8 +80,6 @@ private:
   Mantid::API::MatrixWorkspace_const_sptr m_inWS;
   Mantid::API::MatrixWorkspace_const_sptr m_inImagWS;
   Mantid::API::MatrixWorkspace_sptr m_outWS;
-  gsl_fft_complex_wavetable *m_wavetable;
-  gsl_fft_complex_workspace *m_workspace;
   int m_iIm;
   int m_iRe;
   int m_iAbs;
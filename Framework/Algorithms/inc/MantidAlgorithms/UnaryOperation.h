@@ -34,6 +34,8 @@ class MANTID_ALGORITHMS_DLL UnaryOperation : public API::DistributedAlgorithm {
 public:
   /// Algorithm's category for identification
   const std::string category() const override { return "Arithmetic"; }
+  /// Operations only touch their own input and output workspaces
+  bool isGroupProcessingThreadSafe() const override { return true; }
   /// Summary of algorithms purpose
   const std::string summary() const override {
     return "Supports the implementation of a Unary operation on an input "
@@ -7,6 +7,7 @@
 #include "MantidAlgorithms/AbsorptionCorrection.h"
 #include "MantidAPI/HistoWorkspace.h"
 #include "MantidAPI/InstrumentValidator.h"
+#include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
@@ -14,6 +15,7 @@
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/SampleEnvironment.h"
+#include "MantidGeometry/Objects/CSGObject.h"
 #include "MantidGeometry/Objects/ShapeFactory.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidHistogramData/Interpolate.h"
@@ -28,6 +30,15 @@
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitFactory.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 namespace Mantid {
 namespace Algorithms {
 
@@ -59,14 +70,51 @@ double energyToWavelength(const double energyFixed) {
   return 2. * M_PI * std::sqrt(E_mev_toNeutronWavenumberSq / energyFixed);
 }
 
+/// Sum of weights[i] * exp(coef * pathLengths[i]) over n contiguous elements
+template <typename ExpFunction>
+double integrate(const double coef, const double *pathLengths,
+                 const double *weights, const size_t n,
+                 ExpFunction expFunction) {
+  double integral = 0.0;
+  for (size_t i = 0; i < n; ++i)
+    integral += expFunction(coef * pathLengths[i]) * weights[i];
+  return integral;
+}
+
+/// The element geometry of one sample, shared between runs of the algorithm
+struct CachedDistances {
+  std::vector<double> L1s;
+  std::vector<double> elementVolumes;
+  std::vector<V3D> elementPositions;
+  size_t numVolumeElements;
+  double sampleVolume;
+};
+
+// the number of sample geometries to keep between runs
+constexpr size_t MAX_CACHED_GEOMETRIES{2};
+
+std::mutex &cachedDistancesMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// Most recently used entries first
+std::list<std::pair<std::string, std::shared_ptr<const CachedDistances>>> &
+cachedDistances() {
+  static std::list<
+      std::pair<std::string, std::shared_ptr<const CachedDistances>>>
+      cache;
+  return cache;
+}
+
 } // namespace
 
 AbsorptionCorrection::AbsorptionCorrection()
     : API::Algorithm(), m_inputWS(), m_sampleObject(nullptr), m_L1s(),
       m_elementVolumes(), m_elementPositions(), m_numVolumeElements(0),
       m_sampleVolume(0.0), m_linearCoefTotScatt(0), m_num_lambda(0), m_xStep(0),
-      m_emode(Kernel::DeltaEMode::Undefined), m_lambdaFixed(0.), EXPONENTIAL() {
-}
+      m_emode(Kernel::DeltaEMode::Undefined), m_lambdaFixed(0.),
+      m_directionTolerance(0.), m_useFastExp(false) {}
 
 void AbsorptionCorrection::init() {
 
@@ -118,6 +166,11 @@ void AbsorptionCorrection::init() {
       "ExpMethod", "Normal", std::make_shared<StringListValidator>(exp_options),
       "Select the method to use to calculate exponentials, normal or a\n"
       "fast approximation (default: Normal)");
+  declareProperty(
+      "DirectionTolerance", 0.0, mustBePositive,
+      "Detectors whose directions from the sample differ by less than this\n"
+      "angle, in degrees, share the path lengths out of the sample\n"
+      "(default: 0, only detectors at the same position)");
 
   std::vector<std::string> propOptions{"Elastic", "Direct", "Indirect"};
   declareProperty("EMode", "Elastic",
@@ -130,7 +183,12 @@ void AbsorptionCorrection::init() {
 
   // Call the virtual method for concrete algorithm to define any other
   // properties
+  const auto numberOfBaseProperties = getProperties().size();
   defineProperties();
+  // Those describe the sample and its volume elements, see cachedDistancesKey
+  const auto &properties = getProperties();
+  for (auto i = numberOfBaseProperties; i < properties.size(); ++i)
+    m_elementPropertyNames.emplace_back(properties[i]->name());
 }
 
 std::map<std::string, std::string> AbsorptionCorrection::validateInputs() {
@@ -206,86 +264,121 @@ void AbsorptionCorrection::exec() {
   message.str("");
 
   // Calculate the cached values of L1, element volumes, and geometry size
-  initialiseCachedDistances();
+  initialiseOrReuseCachedDistances();
   if (m_L1s.empty()) {
     throw std::runtime_error(
         "Failed to define any initial scattering gauge volume for geometry");
   }
 
+  // Copy over the bins and find where each detector sits
   const auto &spectrumInfo = m_inputWS->spectrumInfo();
-  Progress prog(this, 0.0, 1.0, numHists);
-  // Loop over the spectra
-  PARALLEL_FOR_IF(Kernel::threadSafe(*m_inputWS, *correctionFactors))
-  for (int64_t i = 0; i < int64_t(numHists); ++i) {
-    PARALLEL_START_INTERUPT_REGION
-    // Copy over bins
+  std::vector<V3D> detectorPositions(numHists);
+  std::vector<bool> hasDetector(numHists, false);
+  for (int64_t i = 0; i < numHists; ++i) {
     correctionFactors->setSharedX(i, m_inputWS->sharedX(i));
-
     if (!spectrumInfo.hasDetectors(i)) {
       g_log.information() << "Spectrum " << i
                           << " does not have a detector defined for it\n";
       continue;
     }
-    const auto &det = spectrumInfo.detector(i);
+    hasDetector[i] = true;
+    detectorPositions[i] = detectorPosition(spectrumInfo.detector(i));
+  }
+  const auto groups = groupSpectraByDirection(detectorPositions, hasDetector);
+  g_log.information() << "Path lengths out of the sample calculated for "
+                      << groups.size() << " detector directions\n";
+
+  if (m_emode != DeltaEMode::Elastic && m_emode != DeltaEMode::Direct &&
+      m_emode != DeltaEMode::Indirect) { // should never happen
+    throw std::runtime_error(
+        "AbsorptionCorrection doesn't have a known DeltaEMode defined");
+  }
+  // In direct geometry the incident leg has the same fixed energy for every
+  // spectrum, so its attenuation is folded into the weights once
+  std::vector<double> directWeights;
+  if (m_emode == DeltaEMode::Direct)
+    directWeights = fixedLegWeights(m_lambdaFixed, m_L1s);
 
+  Progress prog(this, 0.0, 1.0, numHists);
+  // Loop over the groups of spectra sharing a direction
+  PARALLEL_FOR_IF(Kernel::threadSafe(*m_inputWS, *correctionFactors))
+  for (int64_t g = 0; g < static_cast<int64_t>(groups.size()); ++g) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto &group = groups[g];
     std::vector<double> L2s(m_numVolumeElements);
-    calculateDistances(det, L2s);
-
-    // If an indirect instrument, see if there's an efixed in the parameter map
-    double lambdaFixed = m_lambdaFixed;
-    if (m_emode == DeltaEMode::Indirect) {
-      try {
-        Parameter_sptr par = pmap.get(&det, "Efixed");
-        if (par) {
-          lambdaFixed = energyToWavelength(par->value<double>());
+    calculateDistances(detectorPositions[group.front()], L2s);
+
+    // The path lengths and weights of the integration, which only depend on
+    // the wavelength through the exponent's coefficient
+    std::vector<double> pathLengths;
+    const std::vector<double> *weights = &m_elementVolumes;
+    if (m_emode == DeltaEMode::Elastic) {
+      pathLengths.resize(m_numVolumeElements);
+      for (size_t k = 0; k < m_numVolumeElements; ++k)
+        pathLengths[k] = m_L1s[k] + L2s[k];
+    } else if (m_emode == DeltaEMode::Direct) {
+      pathLengths = L2s;
+      weights = &directWeights;
+    } else {
+      pathLengths = m_L1s;
+    }
+
+    std::vector<double> indirectWeights;
+    double indirectLambdaFixed = std::numeric_limits<double>::quiet_NaN();
+    for (const auto i : group) {
+      // In indirect geometry the outgoing leg is attenuated at the Efixed of
+      // the detector, if there is one in the parameter map. The weights are
+      // only rebuilt when it differs from the previous spectrum's.
+      if (m_emode == DeltaEMode::Indirect) {
+        const auto &det = spectrumInfo.detector(i);
+        double lambdaFixed = m_lambdaFixed;
+        try {
+          Parameter_sptr par = pmap.get(&det, "Efixed");
+          if (par) {
+            lambdaFixed = energyToWavelength(par->value<double>());
+          }
+        } catch (std::runtime_error &) { /* Throws if a DetectorGroup, use
+                                            single provided value */
+        }
+        if (lambdaFixed != indirectLambdaFixed) {
+          indirectWeights = fixedLegWeights(lambdaFixed, L2s);
+          indirectLambdaFixed = lambdaFixed;
         }
-      } catch (std::runtime_error &) { /* Throws if a DetectorGroup, use single
-                                          provided value */
+        weights = &indirectWeights;
       }
-    }
 
-    // calculate the absorption coefficient for fixed wavelength
-    const double linearCoefAbsFixed = -m_material.linearAbsorpCoef(lambdaFixed);
-    const auto wavelengths = m_inputWS->points(i);
-    // these need to have the minus sign applied still
-    const auto linearCoefAbs =
-        m_material.linearAbsorpCoef(wavelengths.cbegin(), wavelengths.cend());
-
-    // Get a reference to the Y's in the output WS for storing the factors
-    auto &Y = correctionFactors->mutableY(i);
-
-    // Loop through the bins in the current spectrum every m_xStep
-    for (int64_t j = 0; j < specSize; j = j + m_xStep) {
-      if (m_emode == DeltaEMode::Elastic) {
-        Y[j] = this->doIntegration(-linearCoefAbs[j], L2s, 0, L2s.size());
-      } else if (m_emode == DeltaEMode::Direct) {
-        Y[j] = this->doIntegration(linearCoefAbsFixed, -linearCoefAbs[j], L2s,
-                                   0, L2s.size());
-      } else if (m_emode == DeltaEMode::Indirect) {
-        Y[j] = this->doIntegration(-linearCoefAbs[j], linearCoefAbsFixed, L2s,
-                                   0, L2s.size());
-      } else { // should never happen
-        throw std::runtime_error(
-            "AbsorptionCorrection doesn't have a known DeltaEMode defined");
+      const auto wavelengths = m_inputWS->points(i);
+      // these need to have the minus sign applied still
+      const auto linearCoefAbs =
+          m_material.linearAbsorpCoef(wavelengths.cbegin(), wavelengths.cend());
+
+      // Get a reference to the Y's in the output WS for storing the factors
+      auto &Y = correctionFactors->mutableY(i);
+
+      // Loop through the bins in the current spectrum every m_xStep
+      for (int64_t j = 0; j < specSize; j = j + m_xStep) {
+        Y[j] = this->doIntegration(-linearCoefAbs[j] + m_linearCoefTotScatt,
+                                   pathLengths, *weights, 0,
+                                   m_numVolumeElements);
+        Y[j] /= m_sampleVolume; // Divide by total volume of the shape
+
+        // Make certain that last point is calculated
+        if (m_xStep > 1 && j + m_xStep >= specSize && j + 1 != specSize) {
+          j = specSize - m_xStep - 1;
+        }
       }
-      Y[j] /= m_sampleVolume; // Divide by total volume of the shape
 
-      // Make certain that last point is calculated
-      if (m_xStep > 1 && j + m_xStep >= specSize && j + 1 != specSize) {
-        j = specSize - m_xStep - 1;
+      // Interpolate linearly between points separated by m_xStep,
+      // last point required
+      if (m_xStep > 1) {
+        auto histnew = correctionFactors->histogram(i);
+        interpolateLinearInplace(histnew, m_xStep);
+        correctionFactors->setHistogram(i, histnew);
       }
-    }
 
-    // Interpolate linearly between points separated by m_xStep,
-    // last point required
-    if (m_xStep > 1) {
-      auto histnew = correctionFactors->histogram(i);
-      interpolateLinearInplace(histnew, m_xStep);
-      correctionFactors->setHistogram(i, histnew);
+      prog.report();
     }
 
-    prog.report();
-
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
@@ -348,11 +441,12 @@ void AbsorptionCorrection::retrieveBaseProperties() {
 
   m_num_lambda = getProperty("NumberOfWavelengthPoints");
 
-  std::string exp_string = getProperty("ExpMethod");
-  if (exp_string == "Normal") // Use the system exp function
-    EXPONENTIAL = exp;
-  else if (exp_string == "FastApprox") // Use the compact approximation
-    EXPONENTIAL = fast_exp;
+  const std::string exp_string = getProperty("ExpMethod");
+  // Use the compact approximation rather than the system exp function
+  m_useFastExp = (exp_string == "FastApprox");
+
+  const double directionTolerance = getProperty("DirectionTolerance");
+  m_directionTolerance = directionTolerance * M_PI / 180.0;
 
   // Get the energy mode
   const std::string emodeStr = getProperty("EMode");
@@ -414,12 +508,161 @@ void AbsorptionCorrection::constructSample(API::Sample &sample) {
   }
 }
 
-/// Calculate the distances traversed by the neutrons within the sample
+/// The number of sample geometries whose volume elements are kept
+size_t AbsorptionCorrection::cachedGeometryCount() {
+  std::lock_guard<std::mutex> lock(cachedDistancesMutex());
+  return cachedDistances().size();
+}
+
+/// Discard the volume elements kept from earlier runs
+void AbsorptionCorrection::clearCachedGeometries() {
+  std::lock_guard<std::mutex> lock(cachedDistancesMutex());
+  cachedDistances().clear();
+}
+
+/// Use the element geometry of a previous run with the same sample and
+/// element size if there is one, otherwise calculate it and keep it for later
+/// runs
+void AbsorptionCorrection::initialiseOrReuseCachedDistances() {
+  const auto key = cachedDistancesKey();
+  if (!key.empty()) {
+    std::lock_guard<std::mutex> lock(cachedDistancesMutex());
+    auto &cache = cachedDistances();
+    const auto entry =
+        std::find_if(cache.begin(), cache.end(),
+                     [&key](const auto &item) { return item.first == key; });
+    if (entry != cache.end()) {
+      cache.splice(cache.begin(), cache, entry);
+      const auto &distances = *entry->second;
+      m_L1s = distances.L1s;
+      m_elementVolumes = distances.elementVolumes;
+      m_elementPositions = distances.elementPositions;
+      m_numVolumeElements = distances.numVolumeElements;
+      m_sampleVolume = distances.sampleVolume;
+      g_log.information("Reusing the volume elements of a previous run");
+      return;
+    }
+  }
+
+  initialiseCachedDistances();
+
+  if (!key.empty() && !m_L1s.empty()) {
+    auto distances = std::make_shared<CachedDistances>();
+    distances->L1s = m_L1s;
+    distances->elementVolumes = m_elementVolumes;
+    distances->elementPositions = m_elementPositions;
+    distances->numVolumeElements = m_numVolumeElements;
+    distances->sampleVolume = m_sampleVolume;
+    std::lock_guard<std::mutex> lock(cachedDistancesMutex());
+    auto &cache = cachedDistances();
+    cache.emplace_front(key, std::move(distances));
+    if (cache.size() > MAX_CACHED_GEOMETRIES)
+      cache.pop_back();
+  }
+}
+
+/// A key identifying everything the volume elements depend on: the sample
+/// shape, the beam direction and the properties of the concrete algorithm,
+/// which describe the sample and the element size. The material, the energy
+/// mode and the wavelength points only enter the integration, so runs that
+/// differ in those reuse the elements. Returns an empty string, disabling the
+/// cache, if the shape cannot be identified.
+std::string AbsorptionCorrection::cachedDistancesKey() const {
+  const auto *csgObject = dynamic_cast<const CSGObject *>(m_sampleObject);
+  if (!csgObject)
+    return "";
+  const auto shapeXML = csgObject->getShapeXML();
+  if (shapeXML.empty())
+    return "";
+
+  std::ostringstream key;
+  key << name() << ':' << version() << '\n' << shapeXML << '\n';
+  // The shape may have been moved or rotated since it was defined
+  const auto &boundingBox = m_sampleObject->getBoundingBox();
+  key << boundingBox.minPoint() << boundingBox.maxPoint() << '\n'
+      << m_beamDirection << '\n';
+  for (const auto &propertyName : m_elementPropertyNames)
+    key << propertyName << '=' << getPropertyValue(propertyName) << '\n';
+  const auto &run = m_inputWS->run();
+  if (run.hasProperty("GaugeVolume"))
+    key << run.getProperty("GaugeVolume")->value();
+  return key.str();
+}
+
+/// Group the spectra whose detectors are seen in the same direction from the
+/// sample. The first spectrum of a group gives the direction used for all of
+/// it, and a spectrum joins a group if its direction is within
+/// DirectionTolerance of that direction. Without a tolerance only detectors at
+/// the same position share a group.
+/// @param detectorPositions :: The detector position of each spectrum
+/// @param hasDetector :: Whether each spectrum has a detector
+/// @returns The spectrum indices of each group
+std::vector<std::vector<size_t>> AbsorptionCorrection::groupSpectraByDirection(
+    const std::vector<V3D> &detectorPositions,
+    const std::vector<bool> &hasDetector) const {
+  std::vector<std::vector<size_t>> groups;
+  if (m_directionTolerance <= 0.) {
+    std::unordered_map<std::string, size_t> groupIndices;
+    std::ostringstream key;
+    key.precision(17);
+    for (size_t i = 0; i < detectorPositions.size(); ++i) {
+      if (!hasDetector[i])
+        continue;
+      key.str("");
+      key << detectorPositions[i].X() << ',' << detectorPositions[i].Y()
+          << ',' << detectorPositions[i].Z();
+      const auto inserted = groupIndices.emplace(key.str(), groups.size());
+      if (inserted.second)
+        groups.emplace_back();
+      groups[inserted.first->second].emplace_back(i);
+    }
+    return groups;
+  }
+
+  // The directions of the groups are filed on a grid with a spacing of the
+  // tolerance. Two unit directions within the tolerance of each other are
+  // closer than the spacing, so only the neighbouring points are searched.
+  using GridPoint = std::array<long long, 3>;
+  std::map<GridPoint, std::vector<size_t>> grid;
+  std::vector<V3D> groupDirections;
+  for (size_t i = 0; i < detectorPositions.size(); ++i) {
+    if (!hasDetector[i])
+      continue;
+    const V3D direction = normalize(detectorPositions[i]);
+    const GridPoint point{std::llround(direction.X() / m_directionTolerance),
+                          std::llround(direction.Y() / m_directionTolerance),
+                          std::llround(direction.Z() / m_directionTolerance)};
+    auto group = groups.size();
+    for (long long dx = -1; dx <= 1 && group == groups.size(); ++dx) {
+      for (long long dy = -1; dy <= 1 && group == groups.size(); ++dy) {
+        for (long long dz = -1; dz <= 1 && group == groups.size(); ++dz) {
+          const auto neighbour =
+              grid.find({point[0] + dx, point[1] + dy, point[2] + dz});
+          if (neighbour == grid.end())
+            continue;
+          for (const auto candidate : neighbour->second) {
+            if (direction.angle(groupDirections[candidate]) <
+                m_directionTolerance) {
+              group = candidate;
+              break;
+            }
+          }
+        }
+      }
+    }
+    if (group == groups.size()) {
+      groups.emplace_back();
+      groupDirections.emplace_back(direction);
+      grid[point].emplace_back(group);
+    }
+    groups[group].emplace_back(i);
+  }
+  return groups;
+}
+
+/// The position of a detector as used for the path lengths out of the sample
 /// @param detector :: The detector we are working on
-/// @param L2s :: A vector of the sample-detector distance for  each segment of
-/// the sample
-void AbsorptionCorrection::calculateDistances(const IDetector &detector,
-                                              std::vector<double> &L2s) const {
+V3D AbsorptionCorrection::detectorPosition(const IDetector &detector) const {
   V3D detectorPos(detector.getPos());
   if (detector.nDets() > 1) {
     // We need to make sure this is right for grouped detectors - should use
@@ -429,7 +672,15 @@ void AbsorptionCorrection::calculateDistances(const IDetector &detector,
                               M_PI,
                           detector.getPhi() * 180.0 / M_PI);
   }
+  return detectorPos;
+}
 
+/// Calculate the distances traversed by the neutrons within the sample
+/// @param detectorPos :: The position of the detector we are working on
+/// @param L2s :: A vector of the sample-detector distance for  each segment of
+/// the sample
+void AbsorptionCorrection::calculateDistances(const V3D &detectorPos,
+                                              std::vector<double> &L2s) const {
   for (size_t i = 0; i < m_numVolumeElements; ++i) {
     // Create track for distance in cylinder between scattering point and
     // detector
@@ -440,61 +691,46 @@ void AbsorptionCorrection::calculateDistances(const IDetector &detector,
   }
 }
 
+/// The element volumes multiplied by the attenuation along the leg of the
+/// path travelled at the fixed wavelength, using the chosen ExpMethod
+std::vector<double> AbsorptionCorrection::fixedLegWeights(
+    const double lambdaFixed, const std::vector<double> &pathLengths) const {
+  const double linearCoefAbsFixed =
+      -m_material.linearAbsorpCoef(lambdaFixed) + m_linearCoefTotScatt;
+  std::vector<double> weights(m_numVolumeElements);
+  for (size_t k = 0; k < m_numVolumeElements; ++k) {
+    const double exponent = linearCoefAbsFixed * pathLengths[k];
+    weights[k] = m_elementVolumes[k] *
+                 (m_useFastExp ? fast_exp(exponent) : std::exp(exponent));
+  }
+  return weights;
+}
+
 // the integrations are done using pairwise summation to reduce
 // issues from adding lots of little numbers together
 // https://en.wikipedia.org/wiki/Pairwise_summation
 
-/// Carries out the numerical integration over the sample for elastic
-/// instruments
-double AbsorptionCorrection::doIntegration(const double linearCoefAbs,
-                                           const std::vector<double> &L2s,
-                                           const size_t startIndex,
-                                           const size_t endIndex) const {
-  if (endIndex - startIndex > MAX_INTEGRATION_LENGTH) {
-    size_t middle = findMiddle(startIndex, endIndex);
-
-    return doIntegration(linearCoefAbs, L2s, startIndex, middle) +
-           doIntegration(linearCoefAbs, L2s, middle, endIndex);
-  } else {
-    double integral = 0.0;
-
-    // Iterate over all the elements, summing up the integral
-    for (size_t i = startIndex; i < endIndex; ++i) {
-      const double exponent =
-          (linearCoefAbs + m_linearCoefTotScatt) * (m_L1s[i] + L2s[i]);
-      integral += (EXPONENTIAL(exponent) * (m_elementVolumes[i]));
-    }
-
-    return integral;
-  }
-}
-
-/// Carries out the numerical integration over the sample for inelastic
-/// instruments
-double AbsorptionCorrection::doIntegration(const double linearCoefAbsL1,
-                                           const double linearCoefAbsL2,
-                                           const std::vector<double> &L2s,
-                                           const size_t startIndex,
-                                           const size_t endIndex) const {
+/// Carries out the numerical integration over the sample, the sum of
+/// weights[i] * exp(linearCoef * pathLengths[i])
+double AbsorptionCorrection::doIntegration(
+    const double linearCoef, const std::vector<double> &pathLengths,
+    const std::vector<double> &weights, const size_t startIndex,
+    const size_t endIndex) const {
   if (endIndex - startIndex > MAX_INTEGRATION_LENGTH) {
     size_t middle = findMiddle(startIndex, endIndex);
 
-    return doIntegration(linearCoefAbsL1, linearCoefAbsL2, L2s, startIndex,
+    return doIntegration(linearCoef, pathLengths, weights, startIndex,
                          middle) +
-           doIntegration(linearCoefAbsL1, linearCoefAbsL2, L2s, middle,
-                         endIndex);
-  } else {
-    double integral = 0.0;
-
-    // Iterate over all the elements, summing up the integral
-    for (size_t i = startIndex; i < endIndex; ++i) {
-      double exponent = (linearCoefAbsL1 + m_linearCoefTotScatt) * m_L1s[i];
-      exponent += (linearCoefAbsL2 + m_linearCoefTotScatt) * L2s[i];
-      integral += (EXPONENTIAL(exponent) * (m_elementVolumes[i]));
-    }
-
-    return integral;
+           doIntegration(linearCoef, pathLengths, weights, middle, endIndex);
   }
+
+  const double *lengths = pathLengths.data() + startIndex;
+  const double *volumes = weights.data() + startIndex;
+  const size_t n = endIndex - startIndex;
+  if (m_useFastExp)
+    return integrate(linearCoef, lengths, volumes, n, fast_exp);
+  return integrate(linearCoef, lengths, volumes, n,
+                   [](const double x) { return std::exp(x); });
 }
 
 } // namespace Algorithms
@@ -51,10 +51,22 @@ public:
 
   std::function<double(double)>
   getConversionFunc(const std::set<detid_t> &detIds) const {
+    double difc, difa, tzero;
+    this->getDiffConstants(detIds, difc, difa, tzero);
+    return Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero);
+  }
+
+  /**
+   * The average calibration constants of the detectors
+   * @throws Exception::NotFoundError if the detectors have no calibration
+   * that converts to d-spacing, i.e. DIFC and DIFA are both zero
+   */
+  void getDiffConstants(const std::set<detid_t> &detIds, double &difc,
+                        double &difa, double &tzero) const {
     const std::set<size_t> rows = this->getRow(detIds);
-    double difc = 0.;
-    double difa = 0.;
-    double tzero = 0.;
+    difc = 0.;
+    difa = 0.;
+    tzero = 0.;
     for (auto row : rows) {
       difc += m_difcCol->toDouble(row);
       difa += m_difaCol->toDouble(row);
@@ -66,8 +78,9 @@ public:
       difa = norm * difa;
       tzero = norm * tzero;
     }
-
-    return Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero);
+    if (difc == 0. && difa == 0.)
+      throw Exception::NotFoundError("No DIFC or DIFA calibration for detector",
+                                     detIds.empty() ? -1 : *detIds.begin());
   }
 
 private:
@@ -299,9 +312,23 @@ void AlignDetectors::align(const ConversionFactors &converter,
   for (int64_t i = 0; i < m_numberOfSpectra; ++i) {
     PARALLEL_START_INTERUPT_REGION
 
-    auto toDspacing = converter.getConversionFunc(
-        outputWS.getSpectrum(size_t(i)).getDetectorIDs());
-    outputWS.getSpectrum(i).convertTof(toDspacing);
+    auto &spectrum = outputWS.getSpectrum(size_t(i));
+    try {
+      double difc, difa, tzero;
+      converter.getDiffConstants(spectrum.getDetectorIDs(), difc, difa,
+                                 tzero);
+      if (difa == 0.) {
+        // d=(TOF-tzero)/difc is linear, so use the loop without a function
+        // call per event
+        spectrum.convertTof(1. / difc, -1. * tzero / difc);
+      } else {
+        spectrum.convertTof(
+            Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero));
+      }
+    } catch (const Exception::NotFoundError &) {
+      // Zero the data as for a histogram
+      spectrum.clear(false);
+    }
 
     progress.report();
     PARALLEL_END_INTERUPT_REGION
@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAlgorithms/ConvertAxisByFormula.h"
+#include "MantidAPI/CompiledFormula.h"
 #include "MantidAPI/RefAxis.h"
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumInfo.h"
@@ -17,6 +18,15 @@
 #include <memory>
 #include <sstream>
 
+namespace {
+/// The names of the axis value in a formula
+const std::vector<std::string> AXIS_VARIABLES = {"x", "X", "y", "Y"};
+/// The names of the instrument geometry values in a formula
+const std::vector<std::string> GEOMETRY_VARIABLES = {"twotheta",
+                                                     "signedtwotheta", "l1",
+                                                     "l2"};
+} // namespace
+
 namespace Mantid {
 namespace Algorithms {
 
@@ -117,17 +127,15 @@ void ConvertAxisByFormula::exec() {
   // be a spectraAxis
   auto *spectrumAxisPtr = dynamic_cast<SpectraAxis *>(otherAxisPtr);
   std::vector<Variable_ptr> variables;
-  variables.reserve(8);
+  variables.reserve(AXIS_VARIABLES.size() + GEOMETRY_VARIABLES.size());
   // axis value lookups
-  variables.emplace_back(std::make_shared<Variable>("x", false));
-  variables.emplace_back(std::make_shared<Variable>("X", false));
-  variables.emplace_back(std::make_shared<Variable>("y", false));
-  variables.emplace_back(std::make_shared<Variable>("Y", false));
+  for (const auto &name : AXIS_VARIABLES) {
+    variables.emplace_back(std::make_shared<Variable>(name, false));
+  }
   // geometry lookups
-  variables.emplace_back(std::make_shared<Variable>("twotheta", true));
-  variables.emplace_back(std::make_shared<Variable>("signedtwotheta", true));
-  variables.emplace_back(std::make_shared<Variable>("l1", true));
-  variables.emplace_back(std::make_shared<Variable>("l2", true));
+  for (const auto &name : GEOMETRY_VARIABLES) {
+    variables.emplace_back(std::make_shared<Variable>(name, true));
+  }
 
   bool isGeometryRequired = false;
   for (auto variablesIter = variables.begin();
@@ -148,6 +156,14 @@ void ConvertAxisByFormula::exec() {
     }
   }
 
+  const std::map<std::string, double> constants = {
+      {"pi", M_PI},
+      {"h", PhysicalConstants::h},
+      {"h_bar", PhysicalConstants::h_bar},
+      {"g", PhysicalConstants::g},
+      {"mN", PhysicalConstants::NeutronMass},
+      {"mNAMU", PhysicalConstants::NeutronMassAMU}};
+
   // Create muparser
   mu::Parser p;
   try {
@@ -156,12 +172,9 @@ void ConvertAxisByFormula::exec() {
       p.DefineVar(variable->name, &(variable->value));
     }
     // set some constants
-    p.DefineConst("pi", M_PI);
-    p.DefineConst("h", PhysicalConstants::h);
-    p.DefineConst("h_bar", PhysicalConstants::h_bar);
-    p.DefineConst("g", PhysicalConstants::g);
-    p.DefineConst("mN", PhysicalConstants::NeutronMass);
-    p.DefineConst("mNAMU", PhysicalConstants::NeutronMassAMU);
+    for (const auto &constant : constants) {
+      p.DefineConst(constant.first, constant.second);
+    }
     p.SetExpr(formula);
   } catch (mu::Parser::exception_type &e) {
     std::stringstream ss;
@@ -169,6 +182,16 @@ void ConvertAxisByFormula::exec() {
        << ". Muparser error message is: " << e.GetMsg();
     throw std::invalid_argument(ss.str());
   }
+  // Convert whole arrays of values at a time if the formula can be compiled.
+  // The geometry values are the same for all of the values of a spectrum.
+  std::unique_ptr<CompiledFormula> compiled;
+  try {
+    compiled = std::make_unique<CompiledFormula>(formula, AXIS_VARIABLES,
+                                                 GEOMETRY_VARIABLES, constants);
+  } catch (std::invalid_argument &) {
+    // Evaluated value by value with muparser
+  }
+
   if (isRefAxis) {
     if ((isRaggedBins) || (isGeometryRequired)) {
       // ragged bins or geometry used - we have to calculate for every spectra
@@ -181,7 +204,7 @@ void ConvertAxisByFormula::exec() {
         try {
           MantidVec &vec = outputWs->dataX(i);
           setGeometryValues(spectrumInfo, i, variables);
-          calculateValues(p, vec, variables);
+          calculateValues(p, compiled.get(), vec, variables);
         } catch (std::runtime_error &)
         // two possible exceptions runtime error and NotFoundError
         // both handled the same way
@@ -203,7 +226,7 @@ void ConvertAxisByFormula::exec() {
 
       // Calculate the new (common) X values
       MantidVec &vec = outputWs->dataX(0);
-      calculateValues(p, vec, variables);
+      calculateValues(p, compiled.get(), vec, variables);
 
       // copy xVals to every spectra
       auto numberOfSpectra_i = static_cast<int64_t>(
@@ -220,10 +243,13 @@ void ConvertAxisByFormula::exec() {
       PARALLEL_CHECK_INTERUPT_REGION
     }
   } else {
-    size_t axisLength = axisPtr->length();
-    for (size_t i = 0; i < axisLength; ++i) {
-      setAxisValue(axisPtr->getValue(i), variables);
-      axisPtr->setValue(i, evaluateResult(p));
+    std::vector<double> values(axisPtr->length());
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = axisPtr->getValue(i);
+    }
+    calculateValues(p, compiled.get(), values, variables);
+    for (size_t i = 0; i < values.size(); ++i) {
+      axisPtr->setValue(i, values[i]);
     }
   }
 
@@ -265,7 +291,24 @@ void ConvertAxisByFormula::setAxisValue(const double &value,
 }
 
 void ConvertAxisByFormula::calculateValues(
-    mu::Parser &p, MantidVec &vec, std::vector<Variable_ptr> variables) {
+    mu::Parser &p, const CompiledFormula *compiled, MantidVec &vec,
+    std::vector<Variable_ptr> variables) {
+  if (compiled) {
+    std::vector<double> geometry(GEOMETRY_VARIABLES.size(), 0.0);
+    for (const auto &variable : variables) {
+      const auto name = std::find(GEOMETRY_VARIABLES.cbegin(),
+                                  GEOMETRY_VARIABLES.cend(), variable->name);
+      if (name != GEOMETRY_VARIABLES.cend()) {
+        geometry[std::distance(GEOMETRY_VARIABLES.cbegin(), name)] =
+            variable->value;
+      }
+    }
+    const MantidVec axisValues(vec);
+    const std::vector<const double *> axis(AXIS_VARIABLES.size(),
+                                           axisValues.data());
+    compiled->evaluate(vec.data(), vec.size(), axis, geometry);
+    return;
+  }
   MantidVec::iterator iter;
   for (iter = vec.begin(); iter != vec.end(); ++iter) {
     setAxisValue(*iter, variables);
@@ -15,12 +15,14 @@
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidHistogramData/Histogram.h"
+#include "MantidKernel/BatchUnitConversion.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidParallel/Communicator.h"
 
+#include <cmath>
 #include <numeric>
 
 namespace Mantid {
@@ -425,12 +427,20 @@ bool ConvertUnits::getDetectorValues(const API::SpectrumInfo &spectrumInfo,
     if (emode == 2 && efixed == EMPTY_DBL()) // indirect
     {
       if (spectrumInfo.hasUniqueDetector(wsIndex)) {
-        const auto &det = spectrumInfo.detector(wsIndex);
-        auto par = ws.constInstrumentParameters().getRecursive(&det, "Efixed");
-        if (par) {
-          efixed = par->value<double>();
-          g_log.debug() << "Detector: " << det.getID() << " EFixed: " << efixed
-                        << "\n";
+        if (ws.getEMode() == Kernel::DeltaEMode::Indirect) {
+          // The cached column is only recomputed if the parameters change
+          const double value = spectrumInfo.eFixeds()[wsIndex];
+          if (!std::isnan(value))
+            efixed = value;
+        } else {
+          const auto &det = spectrumInfo.detector(wsIndex);
+          auto par =
+              ws.constInstrumentParameters().getRecursive(&det, "Efixed");
+          if (par) {
+            efixed = par->value<double>();
+            g_log.debug() << "Detector: " << det.getID()
+                          << " EFixed: " << efixed << "\n";
+          }
         }
       }
       // Non-unique detector (i.e., DetectorGroup): use single provided value
@@ -559,12 +569,11 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
 
-      // TODO toTOF and fromTOF need to be reimplemented outside of kernel
-      localFromUnit->toTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                           emode, efixed, delta);
-      // Convert from time-of-flight to the desired unit
-      localOutputUnit->fromTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                               emode, efixed, delta);
+      localFromUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      localOutputUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      // Convert to time-of-flight and on to the desired unit in one pass
+      const BatchUnitConversion conversion(*localFromUnit, *localOutputUnit);
+      conversion.convert(outputWS->dataX(i));
 
       // EventWorkspace part, modifying the EventLists.
       if (m_inputEvents) {
@@ -13,6 +13,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidGeometry/IDetector.h"
+#include "MantidKernel/BatchUnitConversion.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/Unit.h"
@@ -233,12 +234,11 @@ MatrixWorkspace_sptr ConvertUnitsUsingDetectorTable::convertViaTOF(
         std::vector<double> values(outputWS->x(wsid).begin(),
                                    outputWS->x(wsid).end());
 
-        // Convert the input unit to time-of-flight
-        localFromUnit->toTOF(values, emptyVec, l1, l2, twoTheta, emode, efixed,
-                             delta);
-        // Convert from time-of-flight to the desired unit
-        localOutputUnit->fromTOF(values, emptyVec, l1, l2, twoTheta, emode,
-                                 efixed, delta);
+        localFromUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+        localOutputUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+        // Convert to time-of-flight and on to the desired unit in one pass
+        const BatchUnitConversion conversion(*localFromUnit, *localOutputUnit);
+        conversion.convert(values);
 
         outputWS->mutableX(wsid) = std::move(values);
 
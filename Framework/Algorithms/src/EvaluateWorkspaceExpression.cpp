@@ -0,0 +1,601 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAlgorithms/EvaluateWorkspaceExpression.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/Expression.h"
+#include "MantidAPI/HistoWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/Progress.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/WorkspaceOpOverloads.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Unit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Algorithms {
+
+using namespace API;
+using namespace Kernel;
+using DataObjects::create;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(EvaluateWorkspaceExpression)
+
+namespace {
+/// The number of bins evaluated together, small enough for the intermediate
+/// values of the whole expression to stay in the cache
+constexpr size_t BLOCK_SIZE = 512;
+
+/**
+ * The derivative of base^exponent with respect to the base
+ * @param base :: The base
+ * @param exponent :: The exponent
+ * @param result :: base^exponent
+ * @returns The derivative, or its limit as the base goes to zero
+ */
+double powerDerivative(const double base, const double exponent,
+                       const double result) {
+  if (base != 0.)
+    return exponent * result / base;
+  if (exponent == 0. || exponent > 1.)
+    return 0.;
+  if (exponent == 1.)
+    return 1.;
+  return std::numeric_limits<double>::infinity();
+}
+
+/// A single step of an expression compiled into reverse Polish notation
+struct Instruction {
+  enum class Operation {
+    Load,
+    Constant,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+    PowerConstant,
+    Negate
+  };
+  Operation operation;
+  /// The index of the input workspace for Load
+  size_t input;
+  /// The value for Constant and PowerConstant
+  double value;
+};
+
+/// The Y unit and distribution flag of an intermediate value
+struct DataUnits {
+  std::string yUnit;
+  bool distribution;
+  /// True if the value only depends on constants
+  bool constant;
+};
+
+/// Returns true and sets value if the text is a number
+bool parseNumber(const std::string &text, double &value) {
+  try {
+    size_t length = 0;
+    value = std::stod(text, &length);
+    return length == text.size();
+  } catch (std::logic_error &) {
+    return false;
+  }
+}
+
+/**
+ * An arithmetic expression compiled into a stack program. Each stack entry is
+ * a block of values together with their variances.
+ */
+class CompiledExpression {
+public:
+  explicit CompiledExpression(const std::string &text) {
+    Expression expression({"+ -", "* /", "^"}, {"+", "-"});
+    expression.parse(text);
+    compile(expression);
+    if (m_inputNames.empty())
+      throw std::invalid_argument(
+          "The expression must contain at least one workspace");
+  }
+
+  /// The names of the workspaces, in the order of their indices
+  const std::vector<std::string> &inputNames() const { return m_inputNames; }
+
+  /// The number of values of scratch space that evaluate() needs
+  size_t scratchSize() const { return 2 * m_maxDepth * BLOCK_SIZE; }
+
+  /**
+   * Evaluate one block of bins of a spectrum
+   * @param y :: The values of each input for the spectrum
+   * @param e :: The errors of each input for the spectrum
+   * @param start :: The first bin of the block
+   * @param count :: The number of bins in the block
+   * @param scratch :: Space for the stack, of size scratchSize()
+   * @returns The values followed by the variances of the result
+   */
+  const double *evaluate(const std::vector<const double *> &y,
+                         const std::vector<const double *> &e,
+                         const size_t start, const size_t count,
+                         double *scratch) const {
+    using Operation = Instruction::Operation;
+    size_t top = 0;
+    for (const auto &instruction : m_program) {
+      switch (instruction.operation) {
+      case Operation::Load: {
+        double *yOut = values(scratch, top);
+        double *vOut = variances(scratch, top);
+        const double *yIn = y[instruction.input] + start;
+        const double *eIn = e[instruction.input] + start;
+        for (size_t i = 0; i < count; ++i) {
+          yOut[i] = yIn[i];
+          vOut[i] = eIn[i] * eIn[i];
+        }
+        ++top;
+        break;
+      }
+      case Operation::Constant:
+        std::fill_n(values(scratch, top), count, instruction.value);
+        std::fill_n(variances(scratch, top), count, 0.);
+        ++top;
+        break;
+      case Operation::Negate: {
+        double *a = values(scratch, top - 1);
+        for (size_t i = 0; i < count; ++i)
+          a[i] = -a[i];
+        break;
+      }
+      case Operation::PowerConstant: {
+        double *a = values(scratch, top - 1);
+        double *va = variances(scratch, top - 1);
+        const double exponent = instruction.value;
+        for (size_t i = 0; i < count; ++i) {
+          const double result = std::pow(a[i], exponent);
+          const double derivative = powerDerivative(a[i], exponent, result);
+          va[i] = va[i] > 0. ? derivative * derivative * va[i] : 0.;
+          a[i] = result;
+        }
+        break;
+      }
+      default:
+        --top;
+        binaryOperation(instruction.operation, values(scratch, top - 1),
+                        variances(scratch, top - 1), values(scratch, top),
+                        variances(scratch, top), count);
+      }
+    }
+    return scratch;
+  }
+
+  /**
+   * Check that the inputs may be combined as the expression does and find the
+   * Y unit and distribution flag of the result. These follow Plus, Minus,
+   * Multiply and Divide with a single value workspace for each constant.
+   * @param inputs :: The workspaces, in the order of their indices
+   * @returns The units of the result
+   * @throws std::invalid_argument if two inputs are added or subtracted but
+   * have different Y units or distribution flags
+   */
+  DataUnits
+  outputUnits(const std::vector<MatrixWorkspace_const_sptr> &inputs) const {
+    using Operation = Instruction::Operation;
+    std::vector<DataUnits> stack;
+    for (const auto &instruction : m_program) {
+      switch (instruction.operation) {
+      case Operation::Load: {
+        const auto &input = *inputs[instruction.input];
+        stack.push_back({input.YUnit(), input.isDistribution(), false});
+        break;
+      }
+      case Operation::Constant:
+        stack.push_back({"", false, true});
+        break;
+      case Operation::Negate:
+      case Operation::PowerConstant:
+        break;
+      default: {
+        const auto rhs = stack.back();
+        stack.pop_back();
+        combineUnits(instruction.operation, stack.back(), rhs);
+      }
+      }
+    }
+    return stack.back();
+  }
+
+private:
+  /// Combine the units of rhs into lhs as the binary operation algorithms do
+  static void combineUnits(const Instruction::Operation operation,
+                           DataUnits &lhs, const DataUnits &rhs) {
+    using Operation = Instruction::Operation;
+    switch (operation) {
+    case Operation::Add:
+    case Operation::Subtract:
+      if (!lhs.constant && !rhs.constant) {
+        if (lhs.yUnit != rhs.yUnit)
+          throw std::invalid_argument(
+              "The workspaces have different units for the data (Y)");
+        if (lhs.distribution != rhs.distribution)
+          throw std::invalid_argument("The workspaces cannot be added or "
+                                      "subtracted as only one is flagged as "
+                                      "a distribution");
+      }
+      if (lhs.constant)
+        lhs = rhs;
+      break;
+    case Operation::Multiply:
+      if (lhs.constant)
+        lhs.yUnit = rhs.yUnit;
+      lhs.distribution = lhs.distribution && rhs.distribution;
+      lhs.constant = lhs.constant && rhs.constant;
+      break;
+    case Operation::Divide:
+      if (rhs.yUnit.empty()) {
+        // Do nothing
+      } else if (lhs.yUnit == rhs.yUnit) {
+        lhs.yUnit = "";
+        lhs.distribution = true;
+      } else if (!lhs.yUnit.empty()) {
+        lhs.yUnit += "/" + rhs.yUnit;
+      } else {
+        lhs.yUnit = "1/" + rhs.yUnit;
+      }
+      lhs.constant = lhs.constant && rhs.constant;
+      break;
+    default:
+      // A power keeps the units of its base
+      lhs.constant = lhs.constant && rhs.constant;
+    }
+  }
+
+  /// The values at the given depth of the stack
+  static double *values(double *scratch, const size_t depth) {
+    return scratch + 2 * depth * BLOCK_SIZE;
+  }
+  /// The variances at the given depth of the stack
+  static double *variances(double *scratch, const size_t depth) {
+    return scratch + (2 * depth + 1) * BLOCK_SIZE;
+  }
+
+  /// Combine b into a. The loops have no branches so they can be vectorised
+  static void binaryOperation(const Instruction::Operation operation,
+                              double *a, double *va, const double *b,
+                              const double *vb, const size_t count) {
+    using Operation = Instruction::Operation;
+    switch (operation) {
+    case Operation::Add:
+      for (size_t i = 0; i < count; ++i) {
+        a[i] += b[i];
+        va[i] += vb[i];
+      }
+      break;
+    case Operation::Subtract:
+      for (size_t i = 0; i < count; ++i) {
+        a[i] -= b[i];
+        va[i] += vb[i];
+      }
+      break;
+    case Operation::Multiply:
+      for (size_t i = 0; i < count; ++i) {
+        va[i] = va[i] * b[i] * b[i] + vb[i] * a[i] * a[i];
+        a[i] *= b[i];
+      }
+      break;
+    case Operation::Divide:
+      for (size_t i = 0; i < count; ++i) {
+        const double ratio = a[i] / b[i];
+        va[i] = (va[i] + ratio * ratio * vb[i]) / (b[i] * b[i]);
+        a[i] = ratio;
+      }
+      break;
+    case Operation::Power:
+      for (size_t i = 0; i < count; ++i) {
+        const double result = std::pow(a[i], b[i]);
+        const double dBase = powerDerivative(a[i], b[i], result);
+        const double dExponent = std::log(a[i]) * result;
+        va[i] = (va[i] > 0. ? dBase * dBase * va[i] : 0.) +
+                (vb[i] > 0. ? dExponent * dExponent * vb[i] : 0.);
+        a[i] = result;
+      }
+      break;
+    default:
+      throw std::logic_error("Unexpected operation in compiled expression");
+    }
+  }
+
+  void emit(const Instruction::Operation operation, const size_t input = 0,
+            const double value = 0.) {
+    using Operation = Instruction::Operation;
+    m_program.push_back({operation, input, value});
+    if (operation == Operation::Load || operation == Operation::Constant) {
+      m_maxDepth = std::max(m_maxDepth, ++m_depth);
+    } else if (operation != Operation::Negate &&
+               operation != Operation::PowerConstant) {
+      --m_depth;
+    }
+  }
+
+  void compileLeaf(const std::string &name) {
+    double value;
+    if (parseNumber(name, value)) {
+      emit(Instruction::Operation::Constant, 0, value);
+      return;
+    }
+    auto it = std::find(m_inputNames.cbegin(), m_inputNames.cend(), name);
+    const auto index = static_cast<size_t>(it - m_inputNames.cbegin());
+    if (it == m_inputNames.cend())
+      m_inputNames.emplace_back(name);
+    emit(Instruction::Operation::Load, index);
+  }
+
+  void compile(const Expression &term) {
+    using Operation = Instruction::Operation;
+    const auto &expression = term.bracketsRemoved();
+    const auto &name = expression.name();
+    if (!expression.isFunct()) {
+      compileLeaf(name);
+    } else if (expression.size() == 1 && (name == "-" || name == "+")) {
+      compile(expression[0]);
+      if (name == "-")
+        emit(Operation::Negate);
+    } else if (name == "+" || name == "*") {
+      compile(expression[0]);
+      for (size_t i = 1; i < expression.size(); ++i) {
+        compile(expression[i]);
+        const auto &op = expression[i].operator_name();
+        emit(op == "+"   ? Operation::Add
+             : op == "-" ? Operation::Subtract
+             : op == "*" ? Operation::Multiply
+                         : Operation::Divide);
+      }
+    } else if (name == "^") {
+      compile(expression[0]);
+      for (size_t i = 1; i < expression.size(); ++i) {
+        const auto &exponent = expression[i].bracketsRemoved();
+        double value;
+        if (!exponent.isFunct() && parseNumber(exponent.name(), value)) {
+          emit(Operation::PowerConstant, 0, value);
+        } else {
+          compile(exponent);
+          emit(Operation::Power);
+        }
+      }
+    } else {
+      throw std::invalid_argument("Unsupported function '" + name +
+                                  "' in expression");
+    }
+  }
+
+  std::vector<Instruction> m_program;
+  std::vector<std::string> m_inputNames;
+  size_t m_depth = 0;
+  size_t m_maxDepth = 0;
+};
+} // namespace
+
+//----------------------------------------------------------------------------------------------
+
+/// Algorithms name for identification. @see Algorithm::name
+const std::string EvaluateWorkspaceExpression::name() const {
+  return "EvaluateWorkspaceExpression";
+}
+
+/// Algorithm's version for identification. @see Algorithm::version
+int EvaluateWorkspaceExpression::version() const { return 1; }
+
+/// Algorithm's category for identification. @see Algorithm::category
+const std::string EvaluateWorkspaceExpression::category() const {
+  return "Arithmetic";
+}
+
+/// Algorithm's summary for use in the GUI and help. @see Algorithm::summary
+const std::string EvaluateWorkspaceExpression::summary() const {
+  return "Evaluates an arithmetic expression of workspaces and constants in a "
+         "single pass, propagating the errors.";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void EvaluateWorkspaceExpression::init() {
+  declareProperty("Expression", "",
+                  std::make_shared<MandatoryValidator<std::string>>(),
+                  "The expression to evaluate, e.g. (A-B)/V*eff, where the "
+                  "names are workspaces in the analysis data service.");
+  declareProperty(std::make_unique<WorkspaceProperty<>>("OutputWorkspace", "",
+                                                        Direction::Output),
+                  "The result of the expression.");
+}
+
+/** Declare a workspace property for each workspace named in the expression,
+ * set to the workspace of that name. Reading the inputs through properties
+ * means they are locked and recorded in the history, and groups are processed
+ * entry by entry.
+ * @param propName :: The name of the property that was set
+ */
+void EvaluateWorkspaceExpression::afterPropertySet(
+    const std::string &propName) {
+  if (propName != "Expression")
+    return;
+  std::vector<std::string> names;
+  try {
+    names = CompiledExpression(getPropertyValue("Expression")).inputNames();
+  } catch (std::exception &) {
+    // Reported by validateInputs
+  }
+  for (size_t i = 0; i < names.size(); ++i) {
+    const auto propertyName = inputPropertyName(i);
+    if (!existsProperty(propertyName)) {
+      declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>(
+                          propertyName, "", Direction::Input),
+                      "The workspace used for the name with this index in "
+                      "the expression. Defaults to the workspace of that "
+                      "name.");
+    }
+    // Errors, such as a missing workspace, are reported when validating
+    getPointerToProperty(propertyName)->setValue(names[i]);
+  }
+  for (size_t i = names.size(); existsProperty(inputPropertyName(i)); ++i)
+    removeProperty(inputPropertyName(i));
+}
+
+/** Check that the expression can be compiled and that the workspaces it names
+ * can be combined bin by bin, with the checks of the binary operations.
+ */
+std::map<std::string, std::string>
+EvaluateWorkspaceExpression::validateInputs() {
+  std::map<std::string, std::string> issues;
+  const std::string text = getProperty("Expression");
+  try {
+    CompiledExpression expression(text);
+    const auto &names = expression.inputNames();
+    const auto inputs = retrieveInputs(names);
+    const auto &first = *inputs.front();
+    for (size_t i = 1; i < inputs.size(); ++i) {
+      const auto &input = *inputs[i];
+      if (input.getNumberHistograms() != first.getNumberHistograms() ||
+          input.blocksize() != first.blocksize() ||
+          !WorkspaceHelpers::matchingBins(first, input, true)) {
+        issues["Expression"] = "Workspace " + names[i] +
+                               " does not have the same spectra and bins as " +
+                               names.front();
+        break;
+      }
+      if (first.blocksize() > 1 && input.getAxis(0)->unit()->unitID() !=
+                                       first.getAxis(0)->unit()->unitID()) {
+        issues["Expression"] = "Workspace " + names[i] +
+                               " has different units on the X axis to " +
+                               names.front();
+        break;
+      }
+    }
+    if (issues.empty())
+      expression.outputUnits(inputs);
+  } catch (std::exception &e) {
+    issues["Expression"] = e.what();
+  }
+  return issues;
+}
+
+/** Retrieve the workspaces bound to the names in the expression
+ * @param names :: The names in the expression
+ * @returns The workspaces
+ * @throws std::invalid_argument if a name is not bound to a MatrixWorkspace
+ */
+std::vector<MatrixWorkspace_const_sptr>
+EvaluateWorkspaceExpression::retrieveInputs(
+    const std::vector<std::string> &names) const {
+  std::vector<MatrixWorkspace_const_sptr> inputs;
+  inputs.reserve(names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    const auto propertyName = inputPropertyName(i);
+    MatrixWorkspace_const_sptr workspace;
+    if (existsProperty(propertyName))
+      workspace = getProperty(propertyName);
+    if (!workspace)
+      throw std::invalid_argument("'" + names[i] +
+                                  "' is not a MatrixWorkspace");
+    inputs.emplace_back(std::move(workspace));
+  }
+  return inputs;
+}
+
+/// The name of the property holding the input with the given index
+std::string
+EvaluateWorkspaceExpression::inputPropertyName(const size_t index) {
+  return "InputWorkspace_" + std::to_string(index + 1);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void EvaluateWorkspaceExpression::exec() {
+  const CompiledExpression expression(getPropertyValue("Expression"));
+  const auto inputs = retrieveInputs(expression.inputNames());
+  const auto &first = *inputs.front();
+  MatrixWorkspace_sptr out = create<HistoWorkspace>(first);
+
+  // As in the binary operations, a spectrum masked in any input is masked in
+  // the output and its data are cleared
+  const auto numHists = static_cast<int64_t>(first.getNumberHistograms());
+  std::vector<bool> masked(numHists, false);
+  for (size_t j = 0; j < inputs.size(); ++j) {
+    const auto &spectrumInfo = inputs[j]->spectrumInfo();
+    for (int64_t i = 0; i < numHists; ++i) {
+      masked[i] = masked[i] ||
+                  (spectrumInfo.hasDetectors(i) && spectrumInfo.isMasked(i));
+    }
+  }
+
+  Progress progress(this, 0.0, 1.0, numHists);
+  PARALLEL_FOR_IF(Kernel::threadSafe(*out))
+  for (int64_t i = 0; i < numHists; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    auto &yOut = out->mutableY(i);
+    auto &eOut = out->mutableE(i);
+    if (masked[i]) {
+      yOut = 0.;
+      eOut = 0.;
+    } else {
+      // Take shared copies so that event lists are histogrammed only once
+      std::vector<HistogramData::Histogram> histograms;
+      std::vector<const double *> y, e;
+      histograms.reserve(inputs.size());
+      for (const auto &input : inputs) {
+        histograms.emplace_back(input->histogram(i));
+        y.emplace_back(histograms.back().y().rawData().data());
+        e.emplace_back(histograms.back().e().rawData().data());
+      }
+      std::vector<double> scratch(expression.scratchSize());
+      const size_t numBins = yOut.size();
+      for (size_t start = 0; start < numBins; start += BLOCK_SIZE) {
+        const size_t count = std::min(BLOCK_SIZE, numBins - start);
+        const double *result =
+            expression.evaluate(y, e, start, count, scratch.data());
+        const double *variance = result + BLOCK_SIZE;
+        for (size_t k = 0; k < count; ++k) {
+          yOut[start + k] = result[k];
+          eOut[start + k] = std::sqrt(variance[k]);
+        }
+      }
+    }
+    progress.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  auto &spectrumInfo = out->mutableSpectrumInfo();
+  for (int64_t i = 0; i < numHists; ++i) {
+    if (masked[i])
+      spectrumInfo.setMasked(i, true);
+  }
+  // The output already carries the masked bins of the first input
+  for (size_t j = 1; j < inputs.size(); ++j) {
+    const auto &input = *inputs[j];
+    for (int64_t i = 0; i < numHists; ++i) {
+      if (input.hasMaskedBins(i)) {
+        for (const auto &mask : input.maskedBins(i))
+          out->flagMasked(i, mask.first, mask.second);
+      }
+    }
+  }
+
+  const auto units = expression.outputUnits(inputs);
+  out->setYUnit(units.yUnit);
+  out->setDistribution(units.distribution);
+
+  setProperty("OutputWorkspace", out);
+}
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -17,11 +17,10 @@
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/EqualBinsChecker.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/Math/FastFourierTransform.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UnitLabelTypes.h"
 
-#include <gsl/gsl_errno.h>
-
 #include <algorithm>
 #include <cmath>
 #include <functional>
@@ -128,9 +127,6 @@ void FFT::exec() {
 
   const int dys = nPoints % 2;
 
-  m_wavetable = gsl_fft_complex_wavetable_alloc(nPoints);
-  m_workspace = gsl_fft_complex_workspace_alloc(nPoints);
-
   // Hardcoded "centerShift == true" means that the zero on the x axis is
   // assumed to be in the centre, at point with index i = ySize/2.
   // Set to false to make zero at i = 0.
@@ -152,9 +148,6 @@ void FFT::exec() {
     m_outWS->setSharedX(m_iAbs, m_outWS->sharedX(m_iRe));
   }
 
-  gsl_fft_complex_wavetable_free(m_wavetable);
-  gsl_fft_complex_workspace_free(m_workspace);
-
   setProperty("OutputWorkspace", m_outWS);
 }
 
@@ -187,7 +180,7 @@ void FFT::transformForward(std::vector<double> &data, const int xSize,
   double shift = getPhaseShift(
       m_inWS->points(iReal)); // extra phase to be applied to the transform
 
-  gsl_fft_complex_forward(data.data(), 1, ySize, m_wavetable, m_workspace);
+  FastFourierTransform::complexForward(data.data(), ySize);
 
   /* The Fourier transform overwrites array 'data'. Recall that the Fourier
    * transform is
@@ -248,7 +241,7 @@ void FFT::transformBackward(std::vector<double> &data, const int xSize,
     data[2 * i + 1] = isComplex ? m_inImagWS->y(iImag)[j] : 0.;
   }
 
-  gsl_fft_complex_inverse(data.data(), 1, ySize, m_wavetable, m_workspace);
+  FastFourierTransform::complexInverse(data.data(), ySize);
 
   for (int i = 0; i < ySize; i++) {
     double x = df * i;
@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAlgorithms/MaskBinsIf.h"
+#include "MantidAPI/CompiledFormula.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/NumericAxis.h"
 #include "MantidAPI/Progress.h"
@@ -97,25 +98,54 @@ void MaskBinsIf::exec() {
     throw std::runtime_error(
         "Vertical axis must be NumericAxis or SpectraAxis");
   }
+  // Evaluate the criterion for whole spectra at a time if it can be compiled
+  std::unique_ptr<CompiledFormula> compiled;
+  try {
+    compiled = std::make_unique<CompiledFormula>(
+        criterion, std::vector<std::string>{"y", "e", "x", "dx"},
+        std::vector<std::string>{"s"});
+  } catch (std::invalid_argument &) {
+    // Evaluated bin by bin with muParser
+  }
   const auto numberHistograms =
       static_cast<int64_t>(outputWorkspace->getNumberHistograms());
   auto progress = std::make_unique<Progress>(this, 0., 1., numberHistograms);
   PARALLEL_FOR_IF(Mantid::Kernel::threadSafe(*outputWorkspace))
   for (int64_t index = 0; index < numberHistograms; ++index) {
     PARALLEL_START_INTERUPT_REGION
-    double y, e, x, dx;
     double s = spectrumOrNumeric ? verticalAxis->getValue(index) : 0.;
-    mu::Parser parser = makeParser(y, e, x, dx, s, criterion);
     const auto &spectrum = outputWorkspace->histogram(index);
     const bool hasDx = outputWorkspace->hasDx(index);
-    for (auto it = spectrum.begin(); it != spectrum.end(); ++it) {
-      const auto bin = std::distance(spectrum.begin(), it);
-      y = it->counts();
-      x = it->center();
-      e = it->countStandardDeviation();
-      dx = hasDx ? it->centerError() : 0.;
-      if (parser.Eval() != 0.) {
-        outputWorkspace->maskBin(index, bin);
+    if (compiled) {
+      const auto counts = spectrum.counts();
+      const auto errors = spectrum.countStandardDeviations();
+      const auto points = spectrum.points();
+      const size_t numberBins = counts.size();
+      const std::vector<double> noDx(hasDx ? 0 : numberBins, 0.);
+      const double *dxValues =
+          hasDx ? spectrum.dx().rawData().data() : noDx.data();
+      std::vector<double> masked(numberBins);
+      compiled->evaluate(masked.data(), numberBins,
+                         {counts.rawData().data(), errors.rawData().data(),
+                          points.rawData().data(), dxValues},
+                         {s});
+      for (size_t bin = 0; bin < numberBins; ++bin) {
+        if (masked[bin] != 0.) {
+          outputWorkspace->maskBin(index, bin);
+        }
+      }
+    } else {
+      double y, e, x, dx;
+      mu::Parser parser = makeParser(y, e, x, dx, s, criterion);
+      for (auto it = spectrum.begin(); it != spectrum.end(); ++it) {
+        const auto bin = std::distance(spectrum.begin(), it);
+        y = it->counts();
+        x = it->center();
+        e = it->countStandardDeviation();
+        dx = hasDx ? it->centerError() : 0.;
+        if (parser.Eval() != 0.) {
+          outputWorkspace->maskBin(index, bin);
+        }
       }
     }
     progress->report();
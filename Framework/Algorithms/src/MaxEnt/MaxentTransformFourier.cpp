@@ -5,9 +5,9 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAlgorithms/MaxEnt/MaxentTransformFourier.h"
+#include "MantidKernel/Math/FastFourierTransform.h"
 #include <utility>
 
-#include <gsl/gsl_fft_complex.h>
 #include <memory>
 #include <stdexcept>
 
@@ -47,11 +47,7 @@ MaxentTransformFourier::imageToData(const std::vector<double> &image) {
   }
 
   /* Backward FT */
-  gsl_fft_complex_wavetable *wavetable = gsl_fft_complex_wavetable_alloc(n / 2);
-  gsl_fft_complex_workspace *workspace = gsl_fft_complex_workspace_alloc(n / 2);
-  gsl_fft_complex_inverse(complexImage.data(), 1, n / 2, wavetable, workspace);
-  gsl_fft_complex_wavetable_free(wavetable);
-  gsl_fft_complex_workspace_free(workspace);
+  Kernel::FastFourierTransform::complexInverse(complexImage.data(), n / 2);
 
   return m_dataSpace->fromComplex(complexImage);
 }
@@ -82,11 +78,7 @@ MaxentTransformFourier::dataToImage(const std::vector<double> &data) {
   }
 
   /*  Fourier transofrm */
-  gsl_fft_complex_wavetable *wavetable = gsl_fft_complex_wavetable_alloc(n / 2);
-  gsl_fft_complex_workspace *workspace = gsl_fft_complex_workspace_alloc(n / 2);
-  gsl_fft_complex_forward(complexData.data(), 1, n / 2, wavetable, workspace);
-  gsl_fft_complex_wavetable_free(wavetable);
-  gsl_fft_complex_workspace_free(workspace);
+  Kernel::FastFourierTransform::complexForward(complexData.data(), n / 2);
 
   return m_imageSpace->fromComplex(complexData);
 }
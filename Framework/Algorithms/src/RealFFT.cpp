@@ -9,10 +9,9 @@
 #include "MantidAPI/TextAxis.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/Math/FastFourierTransform.h"
 
 #include <gsl/gsl_errno.h>
-#include <gsl/gsl_fft_halfcomplex.h>
-#include <gsl/gsl_fft_real.h>
 
 #define REAL(z, i) ((z)[2 * (i)])
 #define IMAG(z, i) ((z)[2 * (i) + 1])
@@ -107,7 +106,6 @@ void RealFFT::exec() {
     tAxis->setLabel(2, "Modulus");
     outWS->replaceAxis(1, std::move(tAxis));
 
-    gsl_fft_real_workspace *workspace = gsl_fft_real_workspace_alloc(ySize);
     std::vector<double> data(2 * ySize);
 
     auto &yData = inWS->mutableY(spec);
@@ -115,10 +113,7 @@ void RealFFT::exec() {
       data[i] = yData[i];
     }
 
-    gsl_fft_real_wavetable *wavetable = gsl_fft_real_wavetable_alloc(ySize);
-    gsl_fft_real_transform(data.data(), 1, ySize, wavetable, workspace);
-    gsl_fft_real_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
+    FastFourierTransform::realForward(data.data(), ySize);
 
     auto &x = outWS->mutableX(0);
     auto &y1 = outWS->mutableY(0);
@@ -158,8 +153,6 @@ void RealFFT::exec() {
     tAxis->setLabel(0, "Real");
     outWS->replaceAxis(1, std::move(tAxis));
 
-    gsl_fft_real_workspace *workspace = gsl_fft_real_workspace_alloc(yOutSize);
-
     auto &xData = outWS->mutableX(0);
     auto &yData = outWS->mutableY(0);
     auto &y0 = inWS->mutableY(0);
@@ -177,13 +170,8 @@ void RealFFT::exec() {
       }
     }
 
-    gsl_fft_halfcomplex_wavetable *wavetable =
-        gsl_fft_halfcomplex_wavetable_alloc(yOutSize);
-
-    // &(yData[0]) because gsl func wants non const double data[]
-    gsl_fft_halfcomplex_inverse(&(yData[0]), 1, yOutSize, wavetable, workspace);
-    gsl_fft_halfcomplex_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
+    // &(yData[0]) because the transform wants non const double data[]
+    FastFourierTransform::halfComplexInverse(&(yData[0]), yOutSize);
 
     std::generate(xData.begin(), xData.end(),
                   HistogramData::LinearGenerator(0, df));
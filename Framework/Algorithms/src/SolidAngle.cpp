@@ -14,11 +14,13 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/SolidAngleEngine.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/UnitFactory.h"
 
 #include <atomic>
+#include <cmath>
 
 namespace Mantid {
 namespace Algorithms {
@@ -109,10 +111,31 @@ protected:
 };
 
 struct GenericShape : public SolidAngleCalculator {
-  using SolidAngleCalculator::SolidAngleCalculator;
+  GenericShape(const ComponentInfo &componentInfo,
+               const DetectorInfo &detectorInfo, const std::string &method,
+               const double pixelArea)
+      : SolidAngleCalculator(componentInfo, detectorInfo, method, pixelArea),
+        m_engine(componentInfo) {}
+  /// Use precomputed solid angles for all detectors
+  void setDetectorSolidAngles(
+      std::shared_ptr<const std::vector<double>> detectorSolidAngles) {
+    m_detectorSolidAngles = std::move(detectorSolidAngles);
+  }
   double solidAngle(size_t index) const override {
-    return m_detectorInfo.detector(index).solidAngle(m_samplePos);
+    // Scanning detectors have no single position to evaluate the shape at
+    if (m_detectorInfo.isScanning())
+      return m_detectorInfo.detector(index).solidAngle(m_samplePos);
+    if (m_detectorSolidAngles) {
+      const double solidAngle = (*m_detectorSolidAngles)[index];
+      if (!std::isnan(solidAngle))
+        return solidAngle;
+    }
+    return m_engine.solidAngle(index, m_samplePos);
   }
+
+private:
+  const SolidAngleEngine m_engine;
+  std::shared_ptr<const std::vector<double>> m_detectorSolidAngles;
 };
 
 struct Rectangle : public SolidAngleCalculator {
@@ -253,8 +276,18 @@ void SolidAngle::exec() {
 
   std::unique_ptr<SolidAngleCalculator> solidAngleCalculator;
   if (method == GENERIC_SHAPE) {
-    solidAngleCalculator = std::make_unique<GenericShape>(
+    auto genericShape = std::make_unique<GenericShape>(
         componentInfo, detectorInfo, method, pixelArea);
+    // When most of the instrument is needed evaluate every detector up front,
+    // in parallel, and share the result with later runs on the same
+    // instrument and sample position.
+    if (!detectorInfo.isScanning() &&
+        2 * (m_MaxSpec - m_MinSpec + 1) >= numberOfSpectra) {
+      genericShape->setDetectorSolidAngles(
+          SolidAngleEngine::cachedDetectorSolidAngles(
+              componentInfo, detectorInfo.samplePosition()));
+    }
+    solidAngleCalculator = std::move(genericShape);
   } else if (method == RECTANGLE) {
     solidAngleCalculator = std::make_unique<Rectangle>(
         componentInfo, detectorInfo, method, pixelArea);
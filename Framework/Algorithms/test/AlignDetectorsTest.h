@@ -12,7 +12,9 @@
 #include "MantidAPI/Axis.h"
 #include "MantidAlgorithms/AlignDetectors.h"
 #include "MantidDataHandling/LoadNexus.h"
+#include "MantidAPI/TableRow.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/TableWorkspace.h"
 #include "MantidKernel/Unit.h"
 
 using namespace Mantid::Algorithms;
@@ -170,6 +172,42 @@ public:
                       WS->getSpectrum(wkspIndex).getEvents()[0].tof());
   }
 
+  void testEventsWithoutCalibrationAreZeroed() {
+    auto ws =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(1, 2,
+                                                                        false);
+    ws->getAxis(0)->setUnit("TOF");
+    auto calibration = std::make_shared<TableWorkspace>();
+    calibration->addColumn("int", "detid");
+    calibration->addColumn("double", "difc");
+    calibration->addColumn("double", "difa");
+    calibration->addColumn("double", "tzero");
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      TableRow row = calibration->appendRow();
+      // The first detector has no calibration
+      row << *ws->getSpectrum(i).getDetectorIDs().begin()
+          << (i == 0 ? 0. : 1000.) << 0. << 0.;
+    }
+    const double tof = ws->getSpectrum(1).getEvents()[0].tof();
+
+    AlignDetectors alignEvents;
+    alignEvents.initialize();
+    alignEvents.setChild(true);
+    alignEvents.setRethrows(true);
+    alignEvents.setProperty("InputWorkspace", ws);
+    alignEvents.setProperty("CalibrationWorkspace",
+                            std::static_pointer_cast<ITableWorkspace>(
+                                calibration));
+    alignEvents.setPropertyValue("OutputWorkspace", "unused_for_child");
+    TS_ASSERT_THROWS_NOTHING(alignEvents.execute());
+    MatrixWorkspace_sptr out = alignEvents.getProperty("OutputWorkspace");
+    const auto outEvents = std::dynamic_pointer_cast<EventWorkspace>(out);
+    TS_ASSERT(outEvents);
+    TS_ASSERT_EQUALS(outEvents->getSpectrum(0).getNumberEvents(), 0);
+    TS_ASSERT_DELTA(outEvents->getSpectrum(1).getEvents()[0].tof(),
+                    tof / 1000., 1e-12);
+  }
+
 private:
   AlignDetectors align;
   std::string inputWS;
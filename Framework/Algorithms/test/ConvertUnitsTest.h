@@ -13,12 +13,14 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/Run.h"
 #include "MantidAlgorithms/ConvertToDistribution.h"
 #include "MantidAlgorithms/ConvertUnits.h"
 #include "MantidDataHandling/LoadInstrument.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidGeometry/Objects/CSGObject.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/UnitFactory.h"
@@ -631,6 +633,46 @@ public:
     AnalysisDataService::Instance().remove(outputSpace);
   }
 
+  void testIndirectEfixedFollowsInstrumentParameters() {
+    MatrixWorkspace_sptr ws =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(2, 10);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      auto &x = ws->mutableX(i);
+      for (size_t j = 0; j < x.size(); ++j)
+        x[j] = 10000. + 100. * static_cast<double>(j);
+    }
+    ws->mutableRun().addProperty("deltaE-mode", std::string("indirect"));
+    auto &pmap = ws->instrumentParameters();
+    const auto &detectorInfo = ws->detectorInfo();
+    for (size_t i = 0; i < detectorInfo.size(); ++i)
+      pmap.addDouble(&detectorInfo.detector(i), "Efixed", 2.0);
+
+    auto convert = [](const MatrixWorkspace_sptr &input,
+                      const std::string &efixed) {
+      ConvertUnits conv;
+      conv.initialize();
+      conv.setChild(true);
+      conv.setProperty("InputWorkspace", input);
+      conv.setPropertyValue("OutputWorkspace", "unused");
+      conv.setPropertyValue("Target", "DeltaE");
+      conv.setPropertyValue("Emode", "Indirect");
+      if (!efixed.empty())
+        conv.setPropertyValue("Efixed", efixed);
+      conv.execute();
+      MatrixWorkspace_sptr output = conv.getProperty("OutputWorkspace");
+      return output;
+    };
+
+    const auto atTwo = convert(ws, "2.0");
+    TS_ASSERT_DELTA(convert(ws, "")->x(0)[5], atTwo->x(0)[5], 1e-10);
+    // Parameters changed after the first conversion are picked up
+    pmap.addDouble(&detectorInfo.detector(0), "Efixed", 3.0);
+    const auto changed = convert(ws, "");
+    TS_ASSERT_DELTA(changed->x(0)[5], convert(ws, "3.0")->x(0)[5], 1e-10);
+    TS_ASSERT_DELTA(changed->x(1)[5], atTwo->x(1)[5], 1e-10);
+    TS_ASSERT_DIFFERS(changed->x(0)[5], atTwo->x(0)[5]);
+  }
+
   void testZeroLengthVectorExecutesWithNaNOutput() {
     MatrixWorkspace_sptr ws =
         WorkspaceCreationHelper::create2DWorkspaceBinned(1, 2663, 5, 7.5);
@@ -8,12 +8,16 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <cmath>
+
 #include "MantidAPI/Axis.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidAlgorithms/CylinderAbsorption.h"
 #include "MantidDataHandling/SetSample.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/PropertyManager.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/V3D.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
 using Mantid::API::MatrixWorkspace_sptr;
@@ -290,6 +294,89 @@ public:
     Mantid::API::AnalysisDataService::Instance().remove(outputWS);
   }
 
+  void testRepeatedRunsReuseElements() {
+    using Mantid::Algorithms::AbsorptionCorrection;
+    MatrixWorkspace_sptr testWS =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(3, 10);
+    testWS->getAxis(0)->unit() =
+        Mantid::Kernel::UnitFactory::Instance().create("Wavelength");
+    AbsorptionCorrection::clearCachedGeometries();
+
+    const std::string outputWS("factors");
+    auto run = [&](const std::string &numberOfSlices,
+                   const std::string &emode, const std::string &efixed,
+                   const std::string &numberOfPoints) {
+      Mantid::Algorithms::CylinderAbsorption atten;
+      configureAbsCommon(atten, testWS, outputWS, numberOfSlices);
+      configureAbsSample(atten);
+      TS_ASSERT_THROWS_NOTHING(atten.setPropertyValue("EMode", emode));
+      TS_ASSERT_THROWS_NOTHING(atten.setPropertyValue("EFixed", efixed));
+      TS_ASSERT_THROWS_NOTHING(
+          atten.setPropertyValue("NumberOfWavelengthPoints", numberOfPoints));
+      TS_ASSERT_THROWS_NOTHING(atten.execute());
+      TS_ASSERT(atten.isExecuted());
+    };
+
+    run("2", "Elastic", "0", "5");
+    TS_ASSERT_EQUALS(AbsorptionCorrection::cachedGeometryCount(), 1);
+    // The elements do not depend on the energy or the wavelength points
+    run("2", "Direct", "10", "5");
+    run("2", "Indirect", "1.845", "3");
+    TS_ASSERT_EQUALS(AbsorptionCorrection::cachedGeometryCount(), 1);
+    // but do on the element size
+    run("3", "Elastic", "0", "5");
+    TS_ASSERT_EQUALS(AbsorptionCorrection::cachedGeometryCount(), 2);
+
+    AbsorptionCorrection::clearCachedGeometries();
+    TS_ASSERT_EQUALS(AbsorptionCorrection::cachedGeometryCount(), 0);
+    Mantid::API::AnalysisDataService::Instance().remove(outputWS);
+  }
+
+  void testDirectionTolerance() {
+    MatrixWorkspace_sptr testWS =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(3, 10);
+    testWS->getAxis(0)->unit() =
+        Mantid::Kernel::UnitFactory::Instance().create("Wavelength");
+    // Detectors 4.5 and 5.5 degrees away from the first one
+    auto &detectorInfo = testWS->mutableDetectorInfo();
+    const std::vector<double> angles{40.0, 44.5, 45.5};
+    for (size_t i = 0; i < angles.size(); ++i) {
+      const auto detID = *testWS->getSpectrum(i).getDetectorIDs().begin();
+      const double angle = angles[i] * M_PI / 180.0;
+      detectorInfo.setPosition(
+          detectorInfo.indexOf(detID),
+          Mantid::Kernel::V3D(5.0 * std::sin(angle), 0.0,
+                              5.0 * std::cos(angle)));
+    }
+
+    auto run = [&](const double tolerance) {
+      const std::string outputWS("factors");
+      Mantid::Algorithms::CylinderAbsorption atten;
+      configureAbsCommon(atten, testWS, outputWS);
+      configureAbsSample(atten);
+      TS_ASSERT_THROWS_NOTHING(
+          atten.setProperty("DirectionTolerance", tolerance));
+      TS_ASSERT_THROWS_NOTHING(atten.execute());
+      TS_ASSERT(atten.isExecuted());
+      auto &ads = Mantid::API::AnalysisDataService::Instance();
+      const auto result =
+          ads.retrieveWS<Mantid::API::MatrixWorkspace>(outputWS);
+      ads.remove(outputWS);
+      return result;
+    };
+
+    const auto exact = run(0.0);
+    TS_ASSERT_DIFFERS(exact->readY(1), exact->readY(0));
+    TS_ASSERT_DIFFERS(exact->readY(2), exact->readY(0));
+
+    const auto approx = run(5.0);
+    // Within the tolerance the path lengths of the first detector are used
+    TS_ASSERT_EQUALS(approx->readY(1), approx->readY(0));
+    // Outside it the detector has its own
+    TS_ASSERT_DIFFERS(approx->readY(2), approx->readY(0));
+    TS_ASSERT_EQUALS(approx->readY(2), exact->readY(2));
+  }
+
 private:
   MatrixWorkspace_sptr createTestWorkspace() {
     // Create a small test workspace
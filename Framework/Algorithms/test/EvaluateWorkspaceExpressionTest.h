@@ -0,0 +1,381 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AlgorithmHistory.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/WorkspaceGroup.h"
+#include "MantidAPI/WorkspaceHistory.h"
+#include "MantidAPI/WorkspaceOpOverloads.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidAlgorithms/EvaluateWorkspaceExpression.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cmath>
+
+using Mantid::Algorithms::EvaluateWorkspaceExpression;
+using namespace Mantid::API;
+
+namespace {
+struct Values {
+  double offset;
+  double operator()(const double x, std::size_t index) {
+    return offset + x * x + static_cast<double>(index);
+  }
+};
+struct Errors {
+  double offset;
+  double operator()(const double x, std::size_t index) {
+    return 0.1 * offset + 0.01 * x + 0.1 * static_cast<double>(index);
+  }
+};
+
+MatrixWorkspace_sptr createWorkspace(const int nSpec, const double offset) {
+  return WorkspaceCreationHelper::create2DWorkspaceFromFunction(
+      Values{offset}, nSpec, 0., 10., 0.5, true, Errors{offset});
+}
+
+MatrixWorkspace_sptr evaluate(const std::string &expression) {
+  EvaluateWorkspaceExpression alg;
+  alg.setChild(true);
+  alg.setRethrows(true);
+  alg.initialize();
+  alg.setProperty("Expression", expression);
+  alg.setProperty("OutputWorkspace", "_unused_for_child");
+  alg.execute();
+  return alg.getProperty("OutputWorkspace");
+}
+} // namespace
+
+class EvaluateWorkspaceExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EvaluateWorkspaceExpressionTest *createSuite() {
+    return new EvaluateWorkspaceExpressionTest();
+  }
+  static void destroySuite(EvaluateWorkspaceExpressionTest *suite) {
+    delete suite;
+  }
+
+  EvaluateWorkspaceExpressionTest() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("A", createWorkspace(3, 1.));
+    ads.addOrReplace("B", createWorkspace(3, 2.));
+    ads.addOrReplace("V", createWorkspace(3, 3.));
+    ads.addOrReplace("eff", createWorkspace(3, 4.));
+  }
+
+  ~EvaluateWorkspaceExpressionTest() override {
+    AnalysisDataService::Instance().clear();
+  }
+
+  void test_init() {
+    EvaluateWorkspaceExpression alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_matches_the_binary_operations() {
+    const auto a = retrieve("A");
+    const auto b = retrieve("B");
+    const auto v = retrieve("V");
+    const auto eff = retrieve("eff");
+    const MatrixWorkspace_sptr expected = (a - b) / v * eff;
+
+    const auto result = evaluate("(A-B)/V*eff");
+    checkEqual(*result, *expected);
+    TS_ASSERT_EQUALS(result->x(0).rawData(), a->x(0).rawData());
+  }
+
+  void test_constants_and_unary_minus() {
+    const auto a = retrieve("A");
+    const auto b = retrieve("B");
+    const MatrixWorkspace_sptr expected = (a * 2.5 - b) / 1e-3;
+
+    checkEqual(*evaluate("-(B - A*2.5) / 1e-3"), *expected);
+  }
+
+  void test_power_with_constant_exponent_matches_Power() {
+    const auto a = retrieve("A");
+    const auto result = evaluate("A^2");
+    const MatrixWorkspace_sptr expected = a * a;
+    for (size_t i = 0; i < result->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < result->blocksize(); ++j) {
+        TS_ASSERT_DELTA(result->y(i)[j], expected->y(i)[j], 1e-10)
+        // The errors of a power are those of Power, not of a product of
+        // independent values
+        TS_ASSERT_DELTA(result->e(i)[j], 2. * a->y(i)[j] * a->e(i)[j],
+                        1e-10)
+      }
+    }
+  }
+
+  void test_power_of_zero_has_the_limit_of_its_error() {
+    auto zero = WorkspaceCreationHelper::create2DWorkspace123(1, 1, true);
+    zero->mutableY(0)[0] = 0.;
+    zero->mutableE(0)[0] = 0.5;
+    AnalysisDataService::Instance().addOrReplace("zero", zero);
+    TS_ASSERT_EQUALS(evaluate("zero^2")->e(0)[0], 0.)
+    TS_ASSERT_EQUALS(evaluate("zero^1")->e(0)[0], 0.5)
+    TS_ASSERT_EQUALS(evaluate("zero^0")->e(0)[0], 0.)
+    TS_ASSERT(std::isinf(evaluate("zero^0.5")->e(0)[0]))
+    // Without an error the result has none either
+    zero->mutableE(0)[0] = 0.;
+    TS_ASSERT_EQUALS(evaluate("zero^0.5")->e(0)[0], 0.)
+  }
+
+  void test_repeated_names_are_loaded_once() {
+    const auto result = evaluate("A + A + A");
+    const auto a = retrieve("A");
+    const MatrixWorkspace_sptr expected = a + a + a;
+    checkEqual(*result, *expected);
+  }
+
+  void test_masked_spectra_are_propagated() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("unmasked", WorkspaceCreationHelper::maskSpectra(
+                                     WorkspaceCreationHelper::
+                                         create2DWorkspace123(3, 5, true),
+                                     {}));
+    ads.addOrReplace("masked", WorkspaceCreationHelper::create2DWorkspace154(
+                                   3, 5, true, {1}));
+    const auto result = evaluate("unmasked*masked");
+    const auto &spectrumInfo = result->spectrumInfo();
+    TS_ASSERT(!spectrumInfo.isMasked(0))
+    TS_ASSERT(spectrumInfo.isMasked(1))
+    TS_ASSERT(!spectrumInfo.isMasked(2))
+    TS_ASSERT_EQUALS(result->y(1)[0], 0.)
+    TS_ASSERT_EQUALS(result->e(1)[0], 0.)
+    TS_ASSERT_EQUALS(result->y(0)[0], 10.)
+  }
+
+  void test_masked_spectra_of_the_first_workspace_are_cleared() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("unmasked", WorkspaceCreationHelper::maskSpectra(
+                                     WorkspaceCreationHelper::
+                                         create2DWorkspace123(3, 5, true),
+                                     {}));
+    ads.addOrReplace("masked", WorkspaceCreationHelper::create2DWorkspace154(
+                                   3, 5, true, {1}));
+    const auto result = evaluate("masked*unmasked");
+    TS_ASSERT(result->spectrumInfo().isMasked(1))
+    TS_ASSERT_EQUALS(result->y(1)[0], 0.)
+    TS_ASSERT_EQUALS(result->e(1)[0], 0.)
+    TS_ASSERT_EQUALS(result->y(0)[0], 10.)
+  }
+
+  void test_masked_bins_are_propagated() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("plain",
+                     WorkspaceCreationHelper::create2DWorkspace123(3, 5));
+    ads.addOrReplace(
+        "binMasked",
+        WorkspaceCreationHelper::create2DWorkspace123WithMaskedBin(3, 5, 1, 2));
+    const auto result = evaluate("plain - binMasked");
+    TS_ASSERT(!result->hasMaskedBins(0))
+    TS_ASSERT(result->hasMaskedBins(1))
+    TS_ASSERT_EQUALS(result->maskedBins(1).count(2), 1)
+  }
+
+  void test_names_are_bound_through_workspace_properties() {
+    EvaluateWorkspaceExpression alg;
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.initialize();
+    alg.setProperty("Expression", "A+B+V");
+    TS_ASSERT_EQUALS(alg.getPropertyValue("InputWorkspace_3"), "V")
+    alg.setProperty("Expression", "A-B");
+    TS_ASSERT(!alg.existsProperty("InputWorkspace_3"))
+    TS_ASSERT_EQUALS(alg.getPropertyValue("InputWorkspace_1"), "A")
+    alg.setPropertyValue("InputWorkspace_2", "V");
+    alg.setProperty("OutputWorkspace", "_unused_for_child");
+    alg.execute();
+    const MatrixWorkspace_sptr result = alg.getProperty("OutputWorkspace");
+    const MatrixWorkspace_sptr expected = retrieve("A") - retrieve("V");
+    checkEqual(*result, *expected);
+  }
+
+  void test_inputs_are_recorded_in_the_history() {
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "A*B");
+    alg.setProperty("OutputWorkspace", "product");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted())
+    const auto &history = retrieve("product")->getHistory();
+    const auto last = history.getAlgorithmHistory(history.size() - 1);
+    TS_ASSERT_EQUALS(last->getPropertyValue("InputWorkspace_1"), "A")
+    TS_ASSERT_EQUALS(last->getPropertyValue("InputWorkspace_2"), "B")
+    AnalysisDataService::Instance().remove("product");
+  }
+
+  void test_groups_are_processed_entry_by_entry() {
+    WorkspaceCreationHelper::createWorkspaceGroup(2, 3, 4, "G");
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "G*2");
+    alg.setProperty("OutputWorkspace", "doubled");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted())
+
+    auto &ads = AnalysisDataService::Instance();
+    const auto doubled = ads.retrieveWS<WorkspaceGroup>("doubled");
+    TS_ASSERT_EQUALS(doubled->size(), 2)
+    for (size_t i = 0; i < 2; ++i) {
+      const auto entry =
+          std::dynamic_pointer_cast<MatrixWorkspace>(doubled->getItem(i));
+      const auto input = retrieve("G_" + std::to_string(i));
+      TS_ASSERT_EQUALS(entry->y(0)[0], 2. * input->y(0)[0])
+    }
+    ads.deepRemoveGroup("doubled");
+    ads.deepRemoveGroup("G");
+  }
+
+  void test_adding_different_Y_units_is_rejected() {
+    auto counts = createWorkspace(3, 1.);
+    counts->setYUnit("Counts");
+    AnalysisDataService::Instance().addOrReplace("counts", counts);
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "A+counts");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("Expression"), 1)
+    // Multiplying is allowed
+    alg.setProperty("Expression", "A*counts");
+    TS_ASSERT(alg.validateInputs().empty())
+  }
+
+  void test_adding_a_distribution_to_counts_is_rejected() {
+    auto distribution = createWorkspace(3, 1.);
+    distribution->setDistribution(true);
+    AnalysisDataService::Instance().addOrReplace("distribution", distribution);
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "A-distribution");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("Expression"), 1)
+  }
+
+  void test_different_X_units_are_rejected() {
+    auto wavelength = createWorkspace(3, 1.);
+    wavelength->getAxis(0)->unit() =
+        Mantid::Kernel::UnitFactory::Instance().create("Wavelength");
+    AnalysisDataService::Instance().addOrReplace("wavelength", wavelength);
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "A*wavelength");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("Expression"), 1)
+  }
+
+  void test_output_units_follow_the_binary_operations() {
+    auto &ads = AnalysisDataService::Instance();
+    auto counts = createWorkspace(3, 1.);
+    counts->setYUnit("Counts");
+    ads.addOrReplace("counts", counts);
+    auto monitor = createWorkspace(3, 2.);
+    monitor->setYUnit("Counts");
+    ads.addOrReplace("monitor", monitor);
+
+    const auto ratio = evaluate("counts*2/monitor");
+    TS_ASSERT_EQUALS(ratio->YUnit(), "")
+    TS_ASSERT(ratio->isDistribution())
+    const MatrixWorkspace_sptr expectedRatio = counts * 2. / monitor;
+    TS_ASSERT_EQUALS(ratio->YUnit(), expectedRatio->YUnit())
+    TS_ASSERT_EQUALS(ratio->isDistribution(), expectedRatio->isDistribution())
+
+    auto perSecond = createWorkspace(3, 3.);
+    perSecond->setYUnit("s");
+    ads.addOrReplace("perSecond", perSecond);
+    const auto rate = evaluate("counts/perSecond");
+    TS_ASSERT_EQUALS(rate->YUnit(), "Counts/s")
+    TS_ASSERT(!rate->isDistribution())
+  }
+
+  void test_mismatched_workspaces_are_rejected() {
+    AnalysisDataService::Instance().addOrReplace("small",
+                                                 createWorkspace(2, 1.));
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "A+small");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("Expression"), 1)
+  }
+
+  void test_unknown_workspace_is_rejected() {
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "A+doesNotExist");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("Expression"), 1)
+  }
+
+  void test_functions_are_rejected() {
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "sqrt(A)");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("Expression"), 1)
+  }
+
+  void test_expression_without_workspaces_is_rejected() {
+    EvaluateWorkspaceExpression alg;
+    alg.initialize();
+    alg.setProperty("Expression", "2*3");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("Expression"), 1)
+  }
+
+private:
+  static MatrixWorkspace_sptr retrieve(const std::string &name) {
+    return AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(name);
+  }
+
+  static void checkEqual(const MatrixWorkspace &result,
+                         const MatrixWorkspace &expected) {
+    TS_ASSERT_EQUALS(result.getNumberHistograms(),
+                     expected.getNumberHistograms())
+    for (size_t i = 0; i < result.getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(result.y(i).size(), expected.y(i).size())
+      for (size_t j = 0; j < result.y(i).size(); ++j) {
+        TS_ASSERT_DELTA(result.y(i)[j], expected.y(i)[j],
+                        1e-12 * std::abs(expected.y(i)[j]))
+        TS_ASSERT_DELTA(result.e(i)[j], expected.e(i)[j],
+                        1e-12 * std::abs(expected.e(i)[j]))
+      }
+    }
+  }
+};
+
+class EvaluateWorkspaceExpressionTestPerformance : public CxxTest::TestSuite {
+public:
+  static EvaluateWorkspaceExpressionTestPerformance *createSuite() {
+    return new EvaluateWorkspaceExpressionTestPerformance();
+  }
+  static void destroySuite(EvaluateWorkspaceExpressionTestPerformance *suite) {
+    delete suite;
+  }
+
+  void setUp() override {
+    auto &ads = AnalysisDataService::Instance();
+    for (const std::string name : {"A", "B", "V", "eff"}) {
+      ads.addOrReplace(name, WorkspaceCreationHelper::create2DWorkspaceBinned(
+                                 10000, 2000));
+    }
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_fused_expression() { evaluate("(A-B)/V*eff"); }
+
+  void test_chained_binary_operations() {
+    auto &ads = AnalysisDataService::Instance();
+    const MatrixWorkspace_sptr result =
+        (ads.retrieveWS<MatrixWorkspace>("A") -
+         ads.retrieveWS<MatrixWorkspace>("B")) /
+        ads.retrieveWS<MatrixWorkspace>("V") *
+        ads.retrieveWS<MatrixWorkspace>("eff");
+  }
+};
@@ -88,6 +88,8 @@ public:
   const Eigen::Vector3d &sourcePosition() const;
   const Eigen::Vector3d &samplePosition() const;
 
+  size_t geometryRevision() const;
+
   /** The `merge()` operation was made private in `DetectorInfo`, and only
    * accessible through `ComponentInfo` (via this `friend` declaration)
    * because we need to avoid merging `DetectorInfo` without merging
@@ -102,6 +104,8 @@ private:
   void checkNoTimeDependence() const;
   void checkSizes(const DetectorInfo &other) const;
   void merge(const DetectorInfo &other, const std::vector<bool> &merge);
+  void markGeometryChanged();
+  static size_t nextGeometryRevision();
 
   Kernel::cow_ptr<std::vector<bool>> m_isMonitor{nullptr};
   Kernel::cow_ptr<std::vector<bool>> m_isMasked{nullptr};
@@ -111,6 +115,8 @@ private:
       m_rotations{nullptr};
 
   ComponentInfo *m_componentInfo = nullptr; // Geometry::ComponentInfo owner
+  /// Stamp of the last geometry modification, see geometryRevision().
+  size_t m_geometryRevision{nextGeometryRevision()};
 };
 
 /** Returns the number of detectors in the instrument.
@@ -169,12 +175,14 @@ inline void DetectorInfo::setPosition(const size_t index,
                                       const Eigen::Vector3d &position) {
   checkNoTimeDependence();
   m_positions.access()[index] = position;
+  markGeometryChanged();
 }
 
 /// Set the position of the detector with given index.
 inline void DetectorInfo::setPosition(const std::pair<size_t, size_t> &index,
                                       const Eigen::Vector3d &position) {
   m_positions.access()[linearIndex(index)] = position;
+  markGeometryChanged();
 }
 
 /** Set the rotation of the detector with given detector index.
@@ -185,12 +193,30 @@ inline void DetectorInfo::setRotation(const size_t index,
                                       const Eigen::Quaterniond &rotation) {
   checkNoTimeDependence();
   m_rotations.access()[index] = rotation.normalized();
+  markGeometryChanged();
 }
 
 /// Set the rotation of the detector with given index.
 inline void DetectorInfo::setRotation(const std::pair<size_t, size_t> &index,
                                       const Eigen::Quaterniond &rotation) {
   m_rotations.access()[linearIndex(index)] = rotation.normalized();
+  markGeometryChanged();
+}
+
+/** Returns a stamp identifying the current state of the beamline geometry.
+ *
+ * The stamp changes whenever a detector or component (including source and
+ * sample) is moved, rotated or rescaled, so clients can cheaply detect that
+ * values derived from positions, such as cached L2 or 2-theta, are outdated.
+ * Stamps are unique across all instances, i.e., two DetectorInfo objects
+ * share a stamp only if one is an unmodified copy of the other. */
+inline size_t DetectorInfo::geometryRevision() const {
+  return m_geometryRevision;
+}
+
+/// Records that positions, rotations or shapes in the beamline have changed.
+inline void DetectorInfo::markGeometryChanged() {
+  m_geometryRevision = nextGeometryRevision();
 }
 
 /// Throws if this has time-dependent data.
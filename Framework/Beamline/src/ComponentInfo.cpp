@@ -277,16 +277,21 @@ void ComponentInfo::doSetPosition(const std::pair<size_t, size_t> &index,
   const auto componentIndex = index.first;
   const auto timeIndex = index.second;
   const Eigen::Vector3d offset = newPosition - position(componentIndex);
-  for (const auto &subIndex : detectorRange) {
-    m_detectorInfo->setPosition(
-        {subIndex, timeIndex},
-        m_detectorInfo->position({subIndex, timeIndex}) + offset);
+  // Write the detector positions directly so that the geometry revision is
+  // updated once for the whole move rather than once per detector.
+  if (!detectorRange.empty()) {
+    auto &detPositions = m_detectorInfo->m_positions.access();
+    for (const auto &subIndex : detectorRange)
+      detPositions[m_detectorInfo->linearIndex({subIndex, timeIndex})] +=
+          offset;
   }
 
   for (const auto &subIndex : componentRangeInSubtree(componentIndex)) {
     size_t offsetIndex = compOffsetIndex(subIndex);
     m_positions.access()[offsetIndex] += offset;
   }
+  // Also covers non-detector components such as source and sample.
+  m_detectorInfo->markGeometryChanged();
 }
 
 void ComponentInfo::doSetRotation(const std::pair<size_t, size_t> &index,
@@ -301,12 +306,15 @@ void ComponentInfo::doSetRotation(const std::pair<size_t, size_t> &index,
       (newRotation * currentRotInv).normalized();
   auto transform = Eigen::Matrix3d(rotDelta);
 
-  for (const auto &subDetIndex : detectorRange) {
-    auto oldPos = m_detectorInfo->position({subDetIndex, timeIndex});
-    auto newPos = transform * (oldPos - compPos) + compPos;
-    auto newRot = rotDelta * m_detectorInfo->rotation({subDetIndex, timeIndex});
-    m_detectorInfo->setPosition({subDetIndex, timeIndex}, newPos);
-    m_detectorInfo->setRotation({subDetIndex, timeIndex}, newRot);
+  if (!detectorRange.empty()) {
+    auto &detPositions = m_detectorInfo->m_positions.access();
+    auto &detRotations = m_detectorInfo->m_rotations.access();
+    for (const auto &subDetIndex : detectorRange) {
+      const auto linear = m_detectorInfo->linearIndex({subDetIndex, timeIndex});
+      detPositions[linear] =
+          transform * (detPositions[linear] - compPos) + compPos;
+      detRotations[linear] = (rotDelta * detRotations[linear]).normalized();
+    }
   }
 
   for (const auto &subCompIndex : componentRangeInSubtree(componentIndex)) {
@@ -319,6 +327,7 @@ void ComponentInfo::doSetRotation(const std::pair<size_t, size_t> &index,
     m_rotations.access()[linearIndex({childCompIndexOffset, timeIndex})] =
         newRot.normalized();
   }
+  m_detectorInfo->markGeometryChanged();
 }
 
 /**
@@ -562,6 +571,8 @@ size_t ComponentInfo::indexOfAny(const std::string &name) const {
 void ComponentInfo::setScaleFactor(const size_t componentIndex,
                                    const Eigen::Vector3d &scaleFactor) {
   m_scaleFactors.access()[componentIndex] = scaleFactor;
+  if (hasDetectorInfo())
+    m_detectorInfo->markGeometryChanged();
 }
 
 ComponentType ComponentInfo::componentType(const size_t componentIndex) const {
@@ -9,6 +9,7 @@
 #include "MantidKernel/make_cow.h"
 
 #include <algorithm>
+#include <atomic>
 
 namespace Mantid {
 namespace Beamline {
@@ -206,6 +207,13 @@ void DetectorInfo::merge(const DetectorInfo &other,
     rotations.insert(rotations.end(), other.m_rotations->begin() + indexStart,
                      other.m_rotations->begin() + indexEnd);
   }
+  markGeometryChanged();
+}
+
+/// Returns a new, globally unique geometry revision stamp.
+size_t DetectorInfo::nextGeometryRevision() {
+  static std::atomic<size_t> revision{0};
+  return ++revision;
 }
 
 void DetectorInfo::setComponentInfo(ComponentInfo *componentInfo) {
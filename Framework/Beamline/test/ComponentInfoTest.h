@@ -633,6 +633,22 @@ public:
                                                   detectorIndex);
   }
 
+  void test_moving_assembly_updates_geometry_revision_once() {
+    auto infos = makeTreeExample();
+    ComponentInfo &compInfo = *std::get<0>(infos);
+    const DetectorInfo &detInfo = *std::get<1>(infos);
+    const size_t rootIndex = 4;
+
+    auto before = detInfo.geometryRevision();
+    compInfo.setPosition(rootIndex, Eigen::Vector3d{1, 2, 3});
+    TS_ASSERT_EQUALS(detInfo.geometryRevision(), before + 1);
+
+    before = detInfo.geometryRevision();
+    compInfo.setRotation(rootIndex, Eigen::Quaterniond(Eigen::AngleAxisd(
+                                        M_PI / 2, Eigen::Vector3d::UnitZ())));
+    TS_ASSERT_EQUALS(detInfo.geometryRevision(), before + 1);
+  }
+
   void test_detector_indexes() {
 
     auto infos = makeTreeExample();
@@ -274,6 +274,31 @@ public:
     TS_ASSERT_EQUALS(info.rotation(0).coeffs(), rot.normalized().coeffs());
   }
 
+  void test_geometryRevision_unique_per_instance() {
+    DetectorInfo a(PosVec(1), RotVec(1));
+    DetectorInfo b(PosVec(1), RotVec(1));
+    TS_ASSERT_DIFFERS(a.geometryRevision(), b.geometryRevision());
+    DetectorInfo copy(a);
+    TS_ASSERT_EQUALS(copy.geometryRevision(), a.geometryRevision());
+  }
+
+  void test_geometryRevision_changes_on_setPosition_and_setRotation() {
+    DetectorInfo info(PosVec(1), RotVec(1));
+    const auto initial = info.geometryRevision();
+    info.setPosition(0, Eigen::Vector3d{1, 2, 3});
+    const auto moved = info.geometryRevision();
+    TS_ASSERT_DIFFERS(moved, initial);
+    info.setRotation(0, Eigen::Quaterniond{1, 2, 3, 4});
+    TS_ASSERT_DIFFERS(info.geometryRevision(), moved);
+  }
+
+  void test_geometryRevision_unchanged_by_setMasked() {
+    DetectorInfo info(PosVec(1), RotVec(1));
+    const auto initial = info.geometryRevision();
+    info.setMasked(0, true);
+    TS_ASSERT_EQUALS(info.geometryRevision(), initial);
+  }
+
   void test_scanCount() {
     DetectorInfo detInfo;
     Mantid::Beamline::ComponentInfo compInfo;
@@ -14,6 +14,8 @@
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidCurveFitting/Algorithms/PlotPeakByLogValueHelper.h"
 
+#include <functional>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace Algorithms {
@@ -68,11 +70,30 @@ private:
   void setWorkspaceIndexAttribute(const API::IFunction_sptr &fun,
                                   int wsIndex) const;
 
+  /// The result of the fit of one input
+  struct FitResult {
+    std::vector<double> parameters;
+    std::vector<double> errors;
+    double chi2 = 0.;
+    std::string status;
+    API::MatrixWorkspace_sptr fitWorkspace;
+    API::ITableWorkspace_sptr parameterWorkspace;
+    API::ITableWorkspace_sptr covarianceWorkspace;
+  };
+
   std::shared_ptr<Algorithm>
   runSingleFit(bool createFitOutput, bool outputCompositeMembers,
                bool outputConvolvedMembers, const API::IFunction_sptr &ifun,
-               const InputSpectraToFit &data, double startX, double endX,
-               const std::string &exclude);
+               const InputSpectraToFit &data, const std::string &minimizer,
+               double startX, double endX, const std::string &exclude);
+
+  void runParallelFits(
+      const std::vector<InputSpectraToFit> &wsNames,
+      const API::IFunction_sptr &inputFunction, bool isMultiDomainFunction,
+      bool passWSIndexToFunction, bool warmStart,
+      const std::function<FitResult(int, const API::IFunction_sptr &)>
+          &fitSpectrum,
+      std::vector<FitResult> &fitResults);
 
   double calculateLogValue(const std::string &logName,
                            const InputSpectraToFit &data);
@@ -82,9 +103,8 @@ private:
                      const API::IFunction_sptr &ifunSingle, bool &isDataName);
 
   void appendTableRow(bool isDataName, API::ITableWorkspace_sptr &result,
-                      const API::IFunction *const ifun,
-                      const InputSpectraToFit &data, double logValue,
-                      double chi2) const;
+                      const FitResult &fitResult,
+                      const InputSpectraToFit &data, double logValue) const;
 
   void finaliseOutputWorkspaces(
       bool createFitOutput,
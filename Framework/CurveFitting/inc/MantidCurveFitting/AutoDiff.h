@@ -0,0 +1,238 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IFunction.h"
+#include "MantidAPI/Jacobian.h"
+
+#include <gsl/gsl_sf_erf.h>
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace Mantid {
+namespace CurveFitting {
+/**
+  Forward-mode automatic differentiation of fit functions.
+
+  A function that writes its evaluation once as a template over the scalar
+  type, for example
+
+  @code
+  template <typename T>
+  void functionGeneric(T *out, const double *xValues, const size_t nData,
+                       const T *parameters) const;
+  @endcode
+
+  can evaluate itself with doubles for function1D and with Dual<N> numbers,
+  where N is the number of parameters, for the derivatives. Each Dual carries
+  the partial derivatives with respect to all N parameters, so a single
+  evaluation gives the exact Jacobian instead of the N + 1 evaluations of
+  IFunction::calNumericalDeriv.
+
+  The mathematical functions are found by argument dependent lookup, so the
+  generic code calls them unqualified, as it would for doubles. Functions
+  without a standard double overload, such as logErfc, are called qualified
+  with AutoDiff::.
+*/
+namespace AutoDiff {
+
+/// A value and its partial derivatives with respect to N variables
+template <size_t N> class Dual {
+public:
+  /// A constant, whose derivatives are zero
+  Dual(double value = 0.0) : m_value(value), m_derivatives{} {}
+  Dual(double value, const std::array<double, N> &derivatives)
+      : m_value(value), m_derivatives(derivatives) {}
+
+  /// The variable with the given index
+  static Dual variable(double value, size_t index) {
+    assert(index < N);
+    Dual result(value);
+    result.m_derivatives[index] = 1.0;
+    return result;
+  }
+
+  double value() const { return m_value; }
+  double derivative(size_t index) const { return m_derivatives[index]; }
+  const std::array<double, N> &derivatives() const { return m_derivatives; }
+
+  /// The result of a function with this argument, given the value and the
+  /// derivative of the function at the value of this
+  Dual chain(double value, double derivative) const {
+    Dual result(value);
+    for (size_t i = 0; i < N; ++i)
+      result.m_derivatives[i] = derivative * m_derivatives[i];
+    return result;
+  }
+
+  Dual operator-() const { return chain(-m_value, -1.0); }
+
+  Dual &operator+=(const Dual &other) {
+    m_value += other.m_value;
+    for (size_t i = 0; i < N; ++i)
+      m_derivatives[i] += other.m_derivatives[i];
+    return *this;
+  }
+  Dual &operator-=(const Dual &other) {
+    m_value -= other.m_value;
+    for (size_t i = 0; i < N; ++i)
+      m_derivatives[i] -= other.m_derivatives[i];
+    return *this;
+  }
+  Dual &operator*=(const Dual &other) {
+    for (size_t i = 0; i < N; ++i)
+      m_derivatives[i] = m_derivatives[i] * other.m_value +
+                         m_value * other.m_derivatives[i];
+    m_value *= other.m_value;
+    return *this;
+  }
+  Dual &operator/=(const Dual &other) {
+    const double inverse = 1.0 / other.m_value;
+    m_value *= inverse;
+    for (size_t i = 0; i < N; ++i)
+      m_derivatives[i] =
+          (m_derivatives[i] - m_value * other.m_derivatives[i]) * inverse;
+    return *this;
+  }
+  Dual &operator+=(double other) {
+    m_value += other;
+    return *this;
+  }
+  Dual &operator-=(double other) {
+    m_value -= other;
+    return *this;
+  }
+  Dual &operator*=(double other) {
+    m_value *= other;
+    for (auto &derivative : m_derivatives)
+      derivative *= other;
+    return *this;
+  }
+  Dual &operator/=(double other) { return *this *= 1.0 / other; }
+
+  friend Dual operator+(Dual lhs, const Dual &rhs) { return lhs += rhs; }
+  friend Dual operator-(Dual lhs, const Dual &rhs) { return lhs -= rhs; }
+  friend Dual operator*(Dual lhs, const Dual &rhs) { return lhs *= rhs; }
+  friend Dual operator/(Dual lhs, const Dual &rhs) { return lhs /= rhs; }
+  friend Dual operator+(Dual lhs, double rhs) { return lhs += rhs; }
+  friend Dual operator-(Dual lhs, double rhs) { return lhs -= rhs; }
+  friend Dual operator*(Dual lhs, double rhs) { return lhs *= rhs; }
+  friend Dual operator/(Dual lhs, double rhs) { return lhs /= rhs; }
+  friend Dual operator+(double lhs, Dual rhs) { return rhs += lhs; }
+  friend Dual operator-(double lhs, const Dual &rhs) { return -rhs + lhs; }
+  friend Dual operator*(double lhs, Dual rhs) { return rhs *= lhs; }
+  friend Dual operator/(double lhs, const Dual &rhs) {
+    const double value = lhs / rhs.m_value;
+    return rhs.chain(value, -value / rhs.m_value);
+  }
+
+  // Comparisons are of the values, so that the generic code branches as
+  // it would for doubles
+  friend bool operator<(const Dual &lhs, const Dual &rhs) {
+    return lhs.m_value < rhs.m_value;
+  }
+  friend bool operator>(const Dual &lhs, const Dual &rhs) {
+    return lhs.m_value > rhs.m_value;
+  }
+  friend bool operator<=(const Dual &lhs, const Dual &rhs) {
+    return lhs.m_value <= rhs.m_value;
+  }
+  friend bool operator>=(const Dual &lhs, const Dual &rhs) {
+    return lhs.m_value >= rhs.m_value;
+  }
+  friend bool operator==(const Dual &lhs, const Dual &rhs) {
+    return lhs.m_value == rhs.m_value;
+  }
+  friend bool operator!=(const Dual &lhs, const Dual &rhs) {
+    return lhs.m_value != rhs.m_value;
+  }
+
+private:
+  double m_value;
+  std::array<double, N> m_derivatives;
+};
+
+template <size_t N> Dual<N> exp(const Dual<N> &x) {
+  const double value = std::exp(x.value());
+  return x.chain(value, value);
+}
+
+template <size_t N> Dual<N> log(const Dual<N> &x) {
+  return x.chain(std::log(x.value()), 1.0 / x.value());
+}
+
+template <size_t N> Dual<N> sqrt(const Dual<N> &x) {
+  const double value = std::sqrt(x.value());
+  return x.chain(value, 0.5 / value);
+}
+
+template <size_t N> Dual<N> pow(const Dual<N> &x, double power) {
+  const double value = std::pow(x.value(), power - 1.0);
+  return x.chain(value * x.value(), power * value);
+}
+
+template <size_t N> Dual<N> fabs(const Dual<N> &x) {
+  return x.value() < 0.0 ? -x : x;
+}
+
+template <size_t N> Dual<N> abs(const Dual<N> &x) { return fabs(x); }
+
+template <size_t N> Dual<N> sin(const Dual<N> &x) {
+  return x.chain(std::sin(x.value()), std::cos(x.value()));
+}
+
+template <size_t N> Dual<N> cos(const Dual<N> &x) {
+  return x.chain(std::cos(x.value()), -std::sin(x.value()));
+}
+
+template <size_t N> Dual<N> atan(const Dual<N> &x) {
+  return x.chain(std::atan(x.value()), 1.0 / (1.0 + x.value() * x.value()));
+}
+
+/// The logarithm of the complementary error function, which does not
+/// overflow for large arguments
+inline double logErfc(double x) { return gsl_sf_log_erfc(x); }
+
+template <size_t N> Dual<N> logErfc(const Dual<N> &x) {
+  const double value = gsl_sf_log_erfc(x.value());
+  // d/dx log(erfc(x)) = -2 / sqrt(pi) * exp(-x^2) / erfc(x)
+  return x.chain(value,
+                 -M_2_SQRTPI * std::exp(-x.value() * x.value() - value));
+}
+
+/**
+ * Calculate the derivatives of a function with respect to its declared
+ * parameters in one evaluation with Dual numbers.
+ * @param function :: The function, which must have N parameters
+ * @param jacobian :: Set to the derivatives
+ * @param nData :: The number of values of the function
+ * @param evaluate :: Called with the N parameters and the nData output
+ * values as arrays of Dual<N>, to evaluate the function generically
+ */
+template <size_t N, typename Evaluate>
+void calculateJacobian(const API::IFunction &function,
+                       API::Jacobian &jacobian, const size_t nData,
+                       const Evaluate &evaluate) {
+  assert(function.nParams() == N);
+  std::array<Dual<N>, N> parameters;
+  for (size_t i = 0; i < N; ++i)
+    parameters[i] = Dual<N>::variable(function.getParameter(i), i);
+
+  std::vector<Dual<N>> out(nData);
+  evaluate(parameters.data(), out.data());
+  for (size_t i = 0; i < nData; ++i) {
+    for (size_t j = 0; j < N; ++j)
+      jacobian.set(i, j, out[i].derivative(j));
+  }
+}
+
+} // namespace AutoDiff
+} // namespace CurveFitting
+} // namespace Mantid
@@ -0,0 +1,83 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Jacobian.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace Mantid {
+namespace CurveFitting {
+/**
+An implementation of Jacobian that stores one block of a block-sparse
+Jacobian: the derivatives of the values on one domain with respect to the
+parameters of the member functions applied to it (see ParameterBlocks).
+Parameters are addressed by their declared index in the whole function.
+*/
+class BlockJacobian : public API::Jacobian {
+  /// Number of data points
+  size_t m_ny;
+  /// The sorted declared indices of the parameters in the block
+  const std::vector<size_t> &m_parameters;
+  /// Storage for the derivatives
+  std::vector<double> m_data;
+
+  /// Find the column of a parameter
+  size_t column(size_t iP) const {
+    auto it = std::lower_bound(m_parameters.begin(), m_parameters.end(), iP);
+    if (it == m_parameters.end() || *it != iP) {
+      throw std::out_of_range("Parameter index in BlockJacobian is not in "
+                              "the block");
+    }
+    return static_cast<size_t>(it - m_parameters.begin());
+  }
+
+public:
+  /// Constructor.
+  /// @param ny :: Number of data points
+  /// @param parameters :: The sorted declared indices of the parameters
+  BlockJacobian(size_t ny, const std::vector<size_t> &parameters)
+      : m_ny(ny), m_parameters(parameters),
+        m_data(ny * parameters.size(), 0.0) {}
+  /// overwrite base method
+  /// @param value :: the value
+  /// @param iP :: the index of the parameter
+  void addNumberToColumn(const double &value, const size_t &iP) override {
+    const size_t np = m_parameters.size();
+    const size_t ip = column(iP);
+    // add penalty to first and last point and every 10th point in between
+    m_data[ip] += value;
+    m_data[(m_ny - 1) * np + ip] += value;
+    for (size_t iY = 9; iY < m_ny; iY += 10)
+      m_data[iY * np + ip] += value;
+  }
+  /// overwrite base method
+  void set(size_t iY, size_t iP, double value) override {
+    if (iY >= m_ny) {
+      throw std::out_of_range("Data index in Jacobian is out of range");
+    }
+    m_data[iY * m_parameters.size() + column(iP)] = value;
+  }
+  /// overwrite base method
+  double get(size_t iY, size_t iP) override {
+    if (iY >= m_ny) {
+      throw std::out_of_range("Data index in Jacobian is out of range");
+    }
+    return m_data[iY * m_parameters.size() + column(iP)];
+  }
+  /// overwrite base method
+  void zero() override { m_data.assign(m_data.size(), 0.0); }
+  /// The derivatives at a data point, in the order of the parameters
+  const double *row(size_t iY) const {
+    return m_data.data() + iY * m_parameters.size();
+  }
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
@@ -14,6 +14,7 @@
 #include "MantidCurveFitting/DllConfig.h"
 #include "MantidCurveFitting/GSLMatrix.h"
 #include "MantidCurveFitting/GSLVector.h"
+#include "MantidCurveFitting/ParameterBlocks.h"
 
 namespace Mantid {
 namespace CurveFitting {
@@ -58,6 +59,7 @@ public:
                                  bool evalHessian = true) const;
   const GSLVector &getDeriv() const;
   const GSLMatrix &getHessian() const;
+  const ParameterBlocks *getParameterBlocks() const;
   void push();
   void pop();
   void drop();
@@ -130,6 +132,8 @@ protected:
   mutable double m_value;
   mutable GSLVector m_der;
   mutable GSLMatrix m_hessian;
+  /// The block structure of the Hessian or nullptr if it is dense
+  mutable std::unique_ptr<ParameterBlocks> m_parameterBlocks;
 
   mutable bool m_pushed;
   mutable double m_pushedValue;
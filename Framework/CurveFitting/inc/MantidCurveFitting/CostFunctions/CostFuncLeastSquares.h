@@ -49,6 +49,11 @@ protected:
   getFitWeights(API::FunctionValues_sptr values) const;
 
   double m_factor;
+
+private:
+  void addBlockValDerivHessian(const ParameterBlocks &blocks,
+                               API::FunctionValues_sptr values,
+                               bool evalHessian) const;
 };
 
 } // namespace CostFunctions
@@ -12,6 +12,9 @@
 #include "MantidCurveFitting/GSLVector.h"
 #include "MantidKernel/System.h"
 
+#include <memory>
+#include <random>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace CostFunctions {
@@ -28,6 +31,12 @@ namespace FuncMinimisers {
 /** FABADA : Implements the FABADA Algorithm, based on a Adaptive Metropolis
   Algorithm extended with Gibbs Sampling. Designed to obtain the Bayesian
   posterior PDFs
+
+  With NumberOfChains > 1 independent chains, each with its own clone of the
+  cost function and a dispersed starting point, are run concurrently and
+  each contributes an equal share of ChainLength. Their converged parts are
+  merged for the outputs, and the split Gelman-Rubin R-hat and the effective
+  sample size of each parameter are calculated across the chains.
 */
 class MANTID_CURVEFITTING_DLL FABADAMinimizer : public API::IFuncMinimizer {
 public:
@@ -53,6 +62,15 @@ public:
                         double &step);
 
 private:
+  /// Do one iteration of this chain
+  bool iterateChain();
+  /// Create the chains run alongside this one
+  void initReplicas(size_t nChains, size_t maxIterations);
+  /// Merge the chains run alongside this one into this chain
+  void mergeReplicas();
+  /// Output the convergence diagnostics of the chains
+  void outputConvergenceDiagnostics(
+      const std::vector<std::vector<std::vector<double>>> &convergedChains);
   /// Returns the step from a Gaussian given sigma = Jump
   double gaussianStep(const double &jump);
   /// Applied to the other parameters first and sequentially, finally to the
@@ -162,6 +180,14 @@ private:
   std::vector<size_t> m_numInactiveRegenerations;
   /// To track convergence through immobility
   std::vector<int> m_changesOld;
+  /// The length of the converged chain of this chain
+  size_t m_chainLength;
+  /// The random number generator of this chain
+  std::mt19937 m_rng;
+  /// The chains run alongside this one
+  std::vector<std::unique_ptr<FABADAMinimizer>> m_replicas;
+  /// Flags for this chain and each replica that have not finished
+  std::vector<char> m_running;
 };
 
 /// Used to access the setDirty() protected member
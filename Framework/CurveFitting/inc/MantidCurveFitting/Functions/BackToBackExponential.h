@@ -71,6 +71,11 @@ protected:
   void functionDerivLocal(API::Jacobian *, const double *,
                           const size_t) override {}
   double expWidth() const;
+
+private:
+  template <typename T>
+  void functionGeneric(T *out, const double *xValues, const size_t nData,
+                       const T *parameters) const;
 };
 
 using BackToBackExponential_sptr = std::shared_ptr<BackToBackExponential>;
@@ -51,8 +51,6 @@ protected:
                      const size_t nData) const override;
   void functionDerivLocal(API::Jacobian *out, const double *xValues,
                           const size_t nData) override;
-  void functionDeriv(const API::FunctionDomain &domain,
-                     API::Jacobian &jacobian) override;
 
   /// overwrite IFunction base class method, which declare function parameters
   void init() override;
@@ -69,10 +67,15 @@ private:
   void calWavelengthAtEachDataPoint(const double *xValues,
                                     const size_t &nData) const;
 
+  /// evaluate the function for any scalar type of the parameters
+  template <typename T>
+  void functionGeneric(T *out, const double *xValues, const size_t nData,
+                       const T *parameters) const;
+
   /// convert voigt params to pseudo voigt params
-  void convertVoigtToPseudo(const double &voigtSigmaSq,
-                            const double &voigtGamma, double &H,
-                            double &eta) const;
+  template <typename T>
+  void convertVoigtToPseudo(const T &voigtSigmaSq, const T &voigtGamma, T &H,
+                            T &eta) const;
 
   /// constrain all parameters to be non-negative
   void lowerConstraint0(const std::string &paramName);
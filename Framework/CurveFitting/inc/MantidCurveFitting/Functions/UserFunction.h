@@ -19,6 +19,9 @@ class Parser;
 }
 
 namespace Mantid {
+namespace API {
+class CompiledFormula;
+}
 namespace CurveFitting {
 namespace Functions {
 /**
@@ -74,13 +77,14 @@ private:
   mutable double m_x;
   /// True indicates that input formula contains 'x' variable
   bool m_x_set;
-  /// Temporary data storage used in functionDeriv
-  mutable std::vector<double> m_tmp;
-  /// Temporary data storage used in functionDeriv
-  mutable std::vector<double> m_tmp1;
+  /// The formula compiled for evaluation over whole arrays, or null if it
+  /// can only be evaluated by m_parser
+  std::unique_ptr<API::CompiledFormula> m_compiled;
 
   /// mu::Parser callback function for setting variables.
   static double *AddVariable(const char *varName, void *pufun);
+  /// The values of the parameters in the order they are declared
+  std::vector<double> parameterValues() const;
 };
 
 } // namespace Functions
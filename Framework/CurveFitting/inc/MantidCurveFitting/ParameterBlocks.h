@@ -0,0 +1,97 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+
+namespace API {
+class FunctionDomain;
+class IFunction;
+class MultiDomainFunction;
+} // namespace API
+
+namespace CurveFitting {
+class GSLMatrix;
+class GSLVector;
+
+/** ParameterBlocks : The block structure of the Jacobian and the Hessian of
+  a fit of a MultiDomainFunction.
+
+  Each domain of a CompositeDomain is a block: the values calculated on it
+  depend only on the parameters of the member functions applied to it. The
+  Jacobian is then zero outside of the blocks, and an element of the
+  Hessian is zero unless both of its parameters are in the same block.
+
+  An active parameter is local if it is in exactly one block and shared
+  otherwise. A system of linear equations with the Hessian as its matrix is
+  solved by eliminating the local parameters of each block separately and
+  then solving the Schur complement for the shared ones, which takes a time
+  proportional to the number of blocks rather than to the cube of the number
+  of parameters.
+*/
+class MANTID_CURVEFITTING_DLL ParameterBlocks {
+public:
+  /// Marks a parameter of a block that isn't active
+  static constexpr size_t NOT_ACTIVE = std::numeric_limits<size_t>::max();
+
+  static std::unique_ptr<ParameterBlocks>
+  create(const API::IFunction &function, const API::FunctionDomain &domain);
+  ParameterBlocks(const API::MultiDomainFunction &function, size_t nDomains);
+
+  /// @returns The number of blocks, one for each domain
+  size_t nBlocks() const { return m_functions.size(); }
+  /// @returns The number of active parameters
+  size_t nActive() const { return m_nActive; }
+  /// @returns The indices of the member functions applied to a domain
+  const std::vector<size_t> &functions(size_t iBlock) const {
+    return m_functions[iBlock];
+  }
+  /// @returns The index of the first parameter of a member function
+  size_t parameterOffset(size_t iFun) const { return m_offsets[iFun]; }
+  /// @returns The sorted indices of the declared parameters of a block
+  const std::vector<size_t> &parameters(size_t iBlock) const {
+    return m_parameters[iBlock];
+  }
+  /// @returns The active index of each of parameters(iBlock) or NOT_ACTIVE
+  const std::vector<size_t> &activeIndices(size_t iBlock) const {
+    return m_activeIndices[iBlock];
+  }
+  /// @returns The active indices of the parameters local to a block
+  const std::vector<size_t> &localParameters(size_t iBlock) const {
+    return m_local[iBlock];
+  }
+  /// @returns The active indices of the shared parameters
+  const std::vector<size_t> &sharedParameters() const { return m_shared; }
+
+  void solve(const GSLMatrix &hessian, const GSLVector &rhs,
+             GSLVector &x) const;
+
+private:
+  /// The member functions of each block
+  std::vector<std::vector<size_t>> m_functions;
+  /// The index of the first parameter of each member function
+  std::vector<size_t> m_offsets;
+  /// The declared parameters of each block
+  std::vector<std::vector<size_t>> m_parameters;
+  /// The active indices of the declared parameters of each block
+  std::vector<std::vector<size_t>> m_activeIndices;
+  /// The local active parameters of each block
+  std::vector<std::vector<size_t>> m_local;
+  /// The shared active parameters
+  std::vector<size_t> m_shared;
+  /// The number of active parameters
+  size_t m_nActive;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
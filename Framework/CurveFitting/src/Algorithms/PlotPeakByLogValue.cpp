@@ -33,8 +33,11 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
+#include <mutex>
+
 namespace {
 Mantid::Kernel::Logger g_log("PlotPeakByLogValue");
 }
@@ -92,14 +95,21 @@ void PlotPeakByLogValue::init() {
                   "of, the last bin the fitting range\n"
                   "(default the highest value of x)");
 
-  std::vector<std::string> fitOptions{"Sequential", "Individual"};
+  std::vector<std::string> fitOptions{"Sequential", "Individual", "Parallel"};
   declareProperty("FitType", "Sequential",
                   std::make_shared<StringListValidator>(fitOptions),
                   "Defines the way of setting initial values. \n"
                   "If set to 'Sequential' every next fit starts with "
                   "parameters returned by the previous fit. \n"
                   "If set to 'Individual' each fit starts with the same "
-                  "initial values defined in the Function property.");
+                  "initial values defined in the Function property. \n"
+                  "If set to 'Parallel' the fits are independent, as for "
+                  "'Individual', and run concurrently on all cores.");
+
+  declareProperty("WarmStart", false,
+                  "If FitType is 'Parallel', start each fit with the "
+                  "parameters of the nearest input whose fit has already "
+                  "completed instead of the initial values.");
 
   declareProperty("PassWSIndexToFunction", false,
                   "For each spectrum in Input pass its workspace index to all "
@@ -203,6 +213,7 @@ void PlotPeakByLogValue::exec() {
 
   std::string logName = getProperty("LogValue");
   bool individual = getPropertyValue("FitType") == "Individual";
+  bool parallel = getPropertyValue("FitType") == "Parallel";
   bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
   bool createFitOutput = getProperty("CreateOutput");
   bool outputCompositeMembers = getProperty("OutputCompositeMembers");
@@ -257,71 +268,105 @@ void PlotPeakByLogValue::exec() {
     fitChiSquared.reserve(wsNames.size());
   }
 
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
-  for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
-    InputSpectraToFit data = wsNames[i];
-
-    if (!data.ws) {
-      g_log.warning() << "Cannot access workspace " << data.name << '\n';
-      continue;
-    }
-
-    if (data.i < 0) {
-      g_log.warning() << "Zero spectra selected for fitting in workspace "
-                      << wsNames[i].name << '\n';
-      continue;
-    }
+  // Minimizer strings record the workspaces the minimizers output, so they
+  // are made in order
+  std::vector<std::string> minimizers(wsNames.size());
+  for (size_t i = 0; i < wsNames.size(); ++i) {
+    if (wsNames[i].ws && wsNames[i].i >= 0)
+      minimizers[i] =
+          getMinimizerString(wsNames[i].name, std::to_string(wsNames[i].i));
+  }
 
-    IFunction_sptr ifun =
-        setupFunction(individual, passWSIndexToFunction, inputFunction,
-                      initialParams, isMultiDomainFunction, i, data);
+  // Fit the spectrum of input i starting with the function ifun
+  const auto fitSpectrum = [&](int i, const IFunction_sptr &ifun) {
+    const InputSpectraToFit &data = wsNames[i];
     std::shared_ptr<Algorithm> fit;
     if (startX.size() == 0) {
       fit = runSingleFit(createFitOutput, outputCompositeMembers,
-                         outputConvolvedMembers, ifun, data, EMPTY_DBL(),
-                         EMPTY_DBL(), exclude[i]);
+                         outputConvolvedMembers, ifun, data, minimizers[i],
+                         EMPTY_DBL(), EMPTY_DBL(), exclude[i]);
     } else if (startX.size() == 1) {
       fit = runSingleFit(createFitOutput, outputCompositeMembers,
-                         outputConvolvedMembers, ifun, data, startX[0], endX[0],
-                         exclude[i]);
+                         outputConvolvedMembers, ifun, data, minimizers[i],
+                         startX[0], endX[0], exclude[i]);
     } else {
       fit = runSingleFit(createFitOutput, outputCompositeMembers,
-                         outputConvolvedMembers, ifun, data, startX[i], endX[i],
-                         exclude[i]);
+                         outputConvolvedMembers, ifun, data, minimizers[i],
+                         startX[i], endX[i], exclude[i]);
     }
 
-    ifun = fit->getProperty("Function");
-    double chi2 = fit->getProperty("OutputChi2overDoF");
-
+    // The function is fitted in place and may be fitted again to the next
+    // input, so only its values are kept
+    IFunction_sptr fitted = fit->getProperty("Function");
+    FitResult fitResult;
+    for (size_t k = 0; k < fitted->nParams(); ++k) {
+      fitResult.parameters.emplace_back(fitted->getParameter(k));
+      fitResult.errors.emplace_back(fitted->getError(k));
+    }
+    fitResult.chi2 = fit->getProperty("OutputChi2overDoF");
+    fitResult.status = fit->getPropertyValue("OutputStatus");
     if (createFitOutput) {
-      MatrixWorkspace_sptr outputFitWorkspace =
-          fit->getProperty("OutputWorkspace");
-      ITableWorkspace_sptr outputParamWorkspace =
-          fit->getProperty("OutputParameters");
-      ITableWorkspace_sptr outputCovarianceWorkspace =
+      fitResult.fitWorkspace = fit->getProperty("OutputWorkspace");
+      fitResult.parameterWorkspace = fit->getProperty("OutputParameters");
+      fitResult.covarianceWorkspace =
           fit->getProperty("OutputNormalisedCovarianceMatrix");
-      fitWorkspaces.emplace_back(outputFitWorkspace);
-      parameterWorkspaces.emplace_back(outputParamWorkspace);
-      covarianceWorkspaces.emplace_back(outputCovarianceWorkspace);
     }
-    if (outputFitStatus) {
-      fitStatus.push_back(fit->getProperty("OutputStatus"));
-      fitChiSquared.push_back(chi2);
+    g_log.debug() << "Fit result " << fitResult.status << ' '
+                  << fitResult.chi2 << '\n';
+    return fitResult;
+  };
+
+  std::vector<FitResult> fitResults(wsNames.size());
+  if (parallel) {
+    const bool warmStart = getProperty("WarmStart");
+    runParallelFits(wsNames, inputFunction, isMultiDomainFunction,
+                    passWSIndexToFunction, warmStart, fitSpectrum, fitResults);
+  } else {
+    double dProg = 1. / static_cast<double>(wsNames.size());
+    double Prog = 0.;
+    for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
+      const InputSpectraToFit &data = wsNames[i];
+      if (!data.ws || data.i < 0)
+        continue;
+
+      IFunction_sptr ifun =
+          setupFunction(individual, passWSIndexToFunction, inputFunction,
+                        initialParams, isMultiDomainFunction, i, data);
+      fitResults[i] = fitSpectrum(i, ifun);
+
+      Prog += dProg;
+      std::string current = std::to_string(i);
+      progress(Prog, ("Fitting Workspace: (" + current + ") - "));
+      interruption_point();
     }
+  }
 
-    g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
-                  << ' ' << chi2 << '\n';
+  for (size_t i = 0; i < wsNames.size(); ++i) {
+    const InputSpectraToFit &data = wsNames[i];
+    if (!data.ws) {
+      g_log.warning() << "Cannot access workspace " << data.name << '\n';
+      continue;
+    }
+    if (data.i < 0) {
+      g_log.warning() << "Zero spectra selected for fitting in workspace "
+                      << data.name << '\n';
+      continue;
+    }
+    const auto &fitResult = fitResults[i];
+    if (createFitOutput) {
+      fitWorkspaces.emplace_back(fitResult.fitWorkspace);
+      parameterWorkspaces.emplace_back(fitResult.parameterWorkspace);
+      covarianceWorkspaces.emplace_back(fitResult.covarianceWorkspace);
+    }
+    if (outputFitStatus) {
+      fitStatus.push_back(fitResult.status);
+      fitChiSquared.push_back(fitResult.chi2);
+    }
 
     // Find the log value: it is either a log-file value or
     // simply the workspace number
     double logValue = calculateLogValue(logName, data);
-    appendTableRow(isDataName, result, ifun.get(), data, logValue, chi2);
-
-    Prog += dProg;
-    std::string current = std::to_string(i);
-    progress(Prog, ("Fitting Workspace: (" + current + ") - "));
-    interruption_point();
+    appendTableRow(isDataName, result, fitResult, data, logValue);
   }
 
   if (outputFitStatus) {
@@ -333,6 +378,76 @@ void PlotPeakByLogValue::exec() {
                            covarianceWorkspaces);
 }
 
+/**
+ * Fit the inputs independently and concurrently. Each fit starts with a clone
+ * of the input function, or of its member for the input if it is a
+ * MultiDomainFunction, so that no two fits share a function.
+ * @param wsNames :: The inputs to fit
+ * @param inputFunction :: The function to fit
+ * @param isMultiDomainFunction :: True if inputFunction has a member for
+ * each input
+ * @param passWSIndexToFunction :: True to set the WorkspaceIndex attributes
+ * @param warmStart :: True to start each fit with the parameters of the
+ * nearest input whose fit has completed
+ * @param fitSpectrum :: Fits an input starting with a function
+ * @param fitResults :: Set to the result of the fit of each input
+ */
+void PlotPeakByLogValue::runParallelFits(
+    const std::vector<InputSpectraToFit> &wsNames,
+    const IFunction_sptr &inputFunction, bool isMultiDomainFunction,
+    bool passWSIndexToFunction, bool warmStart,
+    const std::function<FitResult(int, const IFunction_sptr &)> &fitSpectrum,
+    std::vector<FitResult> &fitResults) {
+  const auto numberOfFits = static_cast<int>(wsNames.size());
+  // The inputs whose fits have completed, guarded by the mutex
+  std::vector<char> completed(wsNames.size(), 0);
+  std::mutex completedMutex;
+  Progress prog(this, 0.0, 1.0, wsNames.size());
+
+  // Fits take very different times, so they are handed out one at a time
+  PRAGMA_OMP(parallel for schedule(dynamic, 1))
+  for (int i = 0; i < numberOfFits; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const InputSpectraToFit &data = wsNames[i];
+    if (data.ws && data.i >= 0) {
+      IFunction_sptr ifun = isMultiDomainFunction
+                                ? inputFunction->getFunction(i)->clone()
+                                : inputFunction->clone();
+      if (passWSIndexToFunction)
+        setWorkspaceIndexAttribute(ifun, data.i);
+
+      if (warmStart) {
+        std::lock_guard<std::mutex> lock(completedMutex);
+        for (int distance = 1; distance < numberOfFits; ++distance) {
+          const int before = i - distance;
+          const int after = i + distance;
+          const int nearest = before >= 0 && completed[before]
+                                  ? before
+                                  : after < numberOfFits && completed[after]
+                                        ? after
+                                        : -1;
+          if (nearest < 0)
+            continue;
+          const auto &fitted = fitResults[nearest].parameters;
+          if (fitted.size() == ifun->nParams()) {
+            for (size_t k = 0; k < ifun->nParams(); ++k)
+              ifun->setParameter(k, fitted[k]);
+          }
+          break;
+        }
+      }
+
+      auto fitResult = fitSpectrum(i, ifun);
+      std::lock_guard<std::mutex> lock(completedMutex);
+      fitResults[i] = std::move(fitResult);
+      completed[i] = 1;
+    }
+    prog.report("Fitting Workspace: (" + std::to_string(i) + ")");
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+}
+
 IFunction_sptr
 PlotPeakByLogValue::setupFunction(bool individual, bool passWSIndexToFunction,
                                   const IFunction_sptr &inputFunction,
@@ -403,10 +518,10 @@ void PlotPeakByLogValue::finaliseOutputWorkspaces(
 
 void PlotPeakByLogValue::appendTableRow(bool isDataName,
                                         ITableWorkspace_sptr &result,
-                                        const IFunction *const ifun,
+                                        const FitResult &fitResult,
                                         const InputSpectraToFit &data,
-                                        double logValue, double chi2)
-    const { // Extract the fitted parameters and put them into the result table
+                                        double logValue)
+    const { // Put the fitted parameters into the result table
   TableRow row = result->appendRow();
   if (isDataName) {
     row << data.name;
@@ -414,10 +529,10 @@ void PlotPeakByLogValue::appendTableRow(bool isDataName,
     row << logValue;
   }
 
-  for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-    row << ifun->getParameter(iPar) << ifun->getError(iPar);
+  for (size_t iPar = 0; iPar < fitResult.parameters.size(); ++iPar) {
+    row << fitResult.parameters[iPar] << fitResult.errors[iPar];
   }
-  row << chi2;
+  row << fitResult.chi2;
 }
 
 ITableWorkspace_sptr
@@ -450,8 +565,8 @@ PlotPeakByLogValue::createResultsTable(const std::string &logName,
 std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(
     bool createFitOutput, bool outputCompositeMembers,
     bool outputConvolvedMembers, const IFunction_sptr &ifun,
-    const InputSpectraToFit &data, double startX, double endX,
-    const std::string &exclude) {
+    const InputSpectraToFit &data, const std::string &minimizer, double startX,
+    double endX, const std::string &exclude) {
   g_log.debug() << "Fitting " << data.ws->getName() << " index " << data.i
                 << " with \n";
   g_log.debug() << ifun->asString() << '\n';
@@ -475,8 +590,7 @@ std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(
   fit->setProperty("StartX", startX);
   fit->setProperty("EndX", endX);
   fit->setProperty("IgnoreInvalidData", ignoreInvalidData);
-  fit->setPropertyValue("Minimizer",
-                        this->getMinimizerString(data.name, spectrum_index));
+  fit->setPropertyValue("Minimizer", minimizer);
   fit->setPropertyValue("CostFunction", this->getPropertyValue("CostFunction"));
   fit->setPropertyValue("MaxIterations",
                         this->getPropertyValue("MaxIterations"));
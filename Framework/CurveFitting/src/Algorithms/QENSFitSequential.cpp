@@ -490,16 +490,23 @@ void QENSFitSequential::init() {
       "The way the function is evaluated: CentrePoint or Histogram.",
       Kernel::Direction::Input);
 
-  const std::array<std::string, 2> fitTypes = {{"Sequential", "Individual"}};
+  const std::array<std::string, 3> fitTypes = {
+      {"Sequential", "Individual", "Parallel"}};
   declareProperty(
       "FitType", "Sequential",
       Kernel::IValidator_sptr(new Kernel::ListValidator<std::string>(fitTypes)),
       "Defines the way of setting initial values. If set to Sequential every "
       "next fit starts with parameters returned by the previous fit. If set to "
       "Individual each fit starts with the same initial values defined in "
-      "the Function property. Allowed values: [Sequential, Individual]",
+      "the Function property. If set to Parallel the fits are independent, "
+      "as for Individual, and run concurrently. Allowed values: [Sequential, "
+      "Individual, Parallel]",
       Kernel::Direction::Input);
 
+  declareProperty("WarmStart", false,
+                  "If FitType is Parallel, start each fit with the parameters "
+                  "of the nearest spectrum whose fit has already completed.");
+
   declareProperty(std::make_unique<ArrayProperty<double>>("Exclude", ""),
                   "A list of pairs of real numbers, defining the regions to "
                   "exclude from the fit.");
@@ -848,6 +855,7 @@ ITableWorkspace_sptr QENSFitSequential::performFit(const std::string &input,
   plotPeaks->setProperty("LogValue", getPropertyValue("LogName"));
   plotPeaks->setProperty("EvaluationType", getPropertyValue("EvaluationType"));
   plotPeaks->setProperty("FitType", getPropertyValue("FitType"));
+  plotPeaks->setPropertyValue("WarmStart", getPropertyValue("WarmStart"));
   plotPeaks->setProperty("CostFunction", getPropertyValue("CostFunction"));
   plotPeaks->setProperty("OutputFitStatus", outputFitStatus);
 
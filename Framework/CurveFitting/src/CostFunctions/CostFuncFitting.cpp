@@ -250,6 +250,10 @@ void CostFuncFitting::reset() const {
       c->setParamToSatisfyConstraint();
     }
   }
+  m_parameterBlocks.reset();
+  if (m_domain) {
+    m_parameterBlocks = ParameterBlocks::create(*m_function, *m_domain);
+  }
   m_dirtyDeriv = true;
   m_dirtyHessian = true;
 }
@@ -468,6 +472,16 @@ const GSLMatrix &CostFuncFitting::getHessian() const {
   return m_hessian;
 }
 
+/**
+ * Return the block structure of the Hessian if the fit has one, which is
+ * when fitting a MultiDomainFunction to several domains.
+ * @returns The blocks or nullptr if the Hessian is dense.
+ */
+const ParameterBlocks *CostFuncFitting::getParameterBlocks() const {
+  checkValidity();
+  return m_parameterBlocks.get();
+}
+
 /**
  * Save current parameters, derivatives and hessian.
  */
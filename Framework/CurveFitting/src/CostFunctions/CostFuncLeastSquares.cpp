@@ -11,6 +11,8 @@
 #include "MantidAPI/CompositeDomain.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/IConstraint.h"
+#include "MantidAPI/MultiDomainFunction.h"
+#include "MantidCurveFitting/BlockJacobian.h"
 #include "MantidCurveFitting/Jacobian.h"
 #include "MantidCurveFitting/SeqDomain.h"
 #include "MantidKernel/Logger.h"
@@ -73,6 +75,10 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
                                               bool evalDeriv,
                                               bool evalHessian) const {
   UNUSED_ARG(evalDeriv);
+  if (m_parameterBlocks && function == m_function && domain == m_domain) {
+    addBlockValDerivHessian(*m_parameterBlocks, values, evalHessian);
+    return;
+  }
   function->function(*domain, *values);
   size_t np = function->nParams(); // number of parameters
   size_t ny = values->size();      // number of data points
@@ -139,6 +145,95 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
   }
 }
 
+/**
+ * Update the cost function, derivatives and hessian of a fit of a
+ * MultiDomainFunction one domain at a time. Only the block of the Jacobian
+ * for the parameters of the member functions applied to a domain is
+ * calculated, so that neither the Jacobian of the whole fit nor the zero
+ * elements of the Hessian are ever formed.
+ * @param blocks :: The block structure of the fit
+ * @param values :: The fit function values
+ * @param evalHessian :: Flag to evaluate the Hessian
+ */
+void CostFuncLeastSquares::addBlockValDerivHessian(
+    const ParameterBlocks &blocks, API::FunctionValues_sptr values,
+    bool evalHessian) const {
+  auto &function = dynamic_cast<API::MultiDomainFunction &>(*m_function);
+  const auto &domain = dynamic_cast<const API::CompositeDomain &>(*m_domain);
+  function.function(domain, *values);
+  std::vector<double> weights = getFitWeights(values);
+
+  double fVal = 0.0;
+  std::vector<double> der(blocks.nActive(), 0.0);
+  size_t offset = 0; // index of the first value of a domain
+  for (size_t iBlock = 0; iBlock < blocks.nBlocks(); ++iBlock) {
+    const API::FunctionDomain &d = domain.getDomain(iBlock);
+    const size_t ny = d.size();
+    BlockJacobian jacobian(ny, blocks.parameters(iBlock));
+    for (auto iFun : blocks.functions(iBlock)) {
+      API::PartialJacobian J(&jacobian, blocks.parameterOffset(iFun));
+      function.getFunction(iFun)->functionDeriv(d, J);
+    }
+
+    // columns of the active parameters in the block
+    const auto &activeIndices = blocks.activeIndices(iBlock);
+    std::vector<size_t> columns;
+    for (size_t c = 0; c < activeIndices.size(); ++c) {
+      if (activeIndices[c] != ParameterBlocks::NOT_ACTIVE) {
+        columns.emplace_back(c);
+      }
+    }
+    const size_t na = columns.size();
+
+    std::vector<double> hessian(evalHessian ? na * na : 0, 0.0);
+    for (size_t k = 0; k < ny; ++k) {
+      const size_t i = offset + k;
+      const double w = weights[i];
+      const double y = (values->getCalculated(i) - values->getFitData(i)) * w;
+      fVal += y * y;
+      const double *row = jacobian.row(k);
+      for (size_t a = 0; a < na; ++a) {
+        der[activeIndices[columns[a]]] += y * row[columns[a]] * w;
+      }
+      if (!evalHessian)
+        continue;
+      const double w2 = w * w;
+      for (size_t a = 0; a < na; ++a) {
+        const double ja = row[columns[a]] * w2;
+        for (size_t b = 0; b <= a; ++b) {
+          hessian[a * na + b] += ja * row[columns[b]];
+        }
+      }
+    }
+    offset += ny;
+
+    if (!evalHessian)
+      continue;
+    PARALLEL_CRITICAL(hessian_set) {
+      for (size_t a = 0; a < na; ++a) {
+        const size_t i1 = activeIndices[columns[a]];
+        for (size_t b = 0; b <= a; ++b) {
+          const size_t i2 = activeIndices[columns[b]];
+          const double h = m_hessian.get(i1, i2) + hessian[a * na + b];
+          m_hessian.set(i1, i2, h);
+          if (i1 != i2) {
+            m_hessian.set(i2, i1, h);
+          }
+        }
+      }
+    }
+  }
+
+  PARALLEL_CRITICAL(der_set) {
+    for (size_t i = 0; i < der.size(); ++i) {
+      m_der.set(i, m_der.get(i) + der[i]);
+    }
+  }
+
+  PARALLEL_ATOMIC
+  m_value += 0.5 * fVal;
+}
+
 std::vector<double>
 CostFuncLeastSquares::getFitWeights(API::FunctionValues_sptr values) const {
   std::vector<double> weights(values->size());
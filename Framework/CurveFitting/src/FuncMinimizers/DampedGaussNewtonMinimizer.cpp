@@ -95,7 +95,11 @@ bool DampedGaussNewtonMinimizer::iterate(size_t /*iteration*/) {
   // To find dx solve the system of linear equations   H * dx == -m_der
   dd *= -1.0;
   try {
-    H.solve(dd, dx);
+    if (const auto *blocks = m_leastSquares->getParameterBlocks()) {
+      blocks->solve(H, dd, dx);
+    } else {
+      H.solve(dd, dx);
+    }
   } catch (std::runtime_error &e) {
     m_errorString = e.what();
     return false;
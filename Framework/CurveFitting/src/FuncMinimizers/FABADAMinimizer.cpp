@@ -8,6 +8,7 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/CostFunctionFactory.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/IFunction.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidAPI/MatrixWorkspace.h"
@@ -25,13 +26,18 @@
 
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 #include "MantidKernel/normal_distribution.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <exception>
+#include <limits>
+#include <numeric>
 #include <random>
 
 namespace Mantid {
@@ -51,8 +57,8 @@ const size_t LOWER_CONVERGENCE_LIMIT = 350;
 const size_t JUMP_CHECKING_RATE = 200;
 // low jump limit
 const double LOW_JUMP_LIMIT = 1e-25;
-// random number generator
-std::mt19937 rng;
+// R-hat above which the chains are taken not to have mixed
+const double RHAT_WARNING_LIMIT = 1.1;
 
 API::MatrixWorkspace_sptr
 createWorkspace(std::vector<double> const &xValues,
@@ -74,6 +80,90 @@ createWorkspace(std::vector<double> const &xValues,
   return createWorkspaceAlgorithm->getProperty("OutputWorkspace");
 }
 
+/**
+ * Split the converged chains of a parameter into halves of equal length, so
+ * that the convergence diagnostics also detect trends within a chain.
+ * @param chains :: The converged chains of each parameter of each chain
+ * @param parameter :: The index of the parameter
+ * @return :: The halves
+ */
+std::vector<std::vector<double>>
+splitChains(const std::vector<std::vector<std::vector<double>>> &chains,
+            size_t parameter) {
+  size_t length = std::numeric_limits<size_t>::max();
+  for (const auto &chain : chains)
+    length = std::min(length, chain[parameter].size() / 2);
+
+  std::vector<std::vector<double>> halves;
+  for (const auto &chain : chains) {
+    const auto &values = chain[parameter];
+    halves.emplace_back(values.begin(), values.begin() + length);
+    halves.emplace_back(values.begin() + length,
+                        values.begin() + 2 * length);
+  }
+  return halves;
+}
+
+/**
+ * Calculate the Gelman-Rubin potential scale reduction R-hat and the
+ * effective sample size of chains of equal length, as in Gelman et al.,
+ * Bayesian Data Analysis (3rd edition), sections 11.4 and 11.5. The
+ * autocorrelations are summed over Geyer's initial positive sequence.
+ * @param chains :: At least two chains of at least two values
+ * @return :: R-hat and the effective sample size
+ */
+std::pair<double, double>
+convergenceDiagnostics(const std::vector<std::vector<double>> &chains) {
+  if (chains.size() < 2 || chains.front().size() < 2)
+    return {std::nan(""), std::nan("")};
+  const auto m = static_cast<double>(chains.size());
+  const size_t length = chains.front().size();
+  const auto n = static_cast<double>(length);
+
+  std::vector<double> means;
+  double within = 0.0;
+  for (const auto &chain : chains) {
+    const double mean = std::accumulate(chain.begin(), chain.end(), 0.0) / n;
+    double variance = 0.0;
+    for (const auto value : chain)
+      variance += (value - mean) * (value - mean);
+    within += variance / (n - 1.0);
+    means.emplace_back(mean);
+  }
+  within /= m;
+  const double meanOfMeans =
+      std::accumulate(means.begin(), means.end(), 0.0) / m;
+  double between = 0.0;
+  for (const auto mean : means)
+    between += (mean - meanOfMeans) * (mean - meanOfMeans);
+  between *= n / (m - 1.0);
+
+  const double variance = (n - 1.0) / n * within + between / n;
+  // A parameter that never moved
+  if (within <= 0.0 || variance <= 0.0)
+    return {1.0, m * n};
+
+  // The autocorrelation at lag t from the variogram of the chains
+  const auto autocorrelation = [&](size_t t) {
+    double variogram = 0.0;
+    for (const auto &chain : chains) {
+      for (size_t i = t; i < length; ++i)
+        variogram += (chain[i] - chain[i - t]) * (chain[i] - chain[i - t]);
+    }
+    variogram /= m * static_cast<double>(length - t);
+    return 1.0 - variogram / (2.0 * variance);
+  };
+  double tau = -1.0;
+  for (size_t t = 0; t + 1 < length; t += 2) {
+    const double pair = autocorrelation(t) + autocorrelation(t + 1);
+    if (pair <= 0.0)
+      break;
+    tau += 2.0 * pair;
+  }
+  // The effective sample size is at most the number of values
+  return {std::sqrt(variance / within), m * n / std::max(tau, 1.0)};
+}
+
 } // namespace
 
 DECLARE_FUNCMINIMIZER(FABADAMinimizer, FABADA)
@@ -85,7 +175,8 @@ FABADAMinimizer::FABADAMinimizer()
       m_parConverged(), m_criteria(), m_maxIter(0), m_parChanged(),
       m_temperature(0.), m_counterGlobal(0), m_simAnnealingItStep(0),
       m_leftRefrPoints(0), m_tempStep(0.), m_overexploration(false),
-      m_nParams(0), m_numInactiveRegenerations(), m_changesOld() {
+      m_nParams(0), m_numInactiveRegenerations(), m_changesOld(),
+      m_chainLength(0), m_rng(), m_replicas(), m_running() {
   declareProperty("ChainLength", static_cast<size_t>(10000),
                   "Length of the converged chain.");
   declareProperty("StepsBetweenValues", 10,
@@ -114,6 +205,9 @@ FABADAMinimizer::FABADAMinimizer()
                   " no error will jump for that (The temperature is"
                   " constant during the convergence period)."
                   " Useful to find the exact minimum.");
+  declareProperty("NumberOfChains", static_cast<size_t>(1),
+                  "Number of independent chains run concurrently, each"
+                  " producing an equal share of the ChainLength.");
   // Output Properties
   declareProperty("PDF", true, "If the PDF's should be calculated or not.");
   declareProperty("NumberBinsPDF", 20,
@@ -135,6 +229,12 @@ FABADAMinimizer::FABADAMinimizer()
       std::make_unique<API::WorkspaceProperty<API::ITableWorkspace>>(
           "Parameters", "", Kernel::Direction::Output),
       "The name to give the output workspace (Parameter values and errors)");
+  declareProperty(
+      std::make_unique<API::WorkspaceProperty<API::ITableWorkspace>>(
+          "ConvergenceDiagnostics", "", Kernel::Direction::Output,
+          API::PropertyMode::Optional),
+      "The name to give the output workspace of the Gelman-Rubin R-hat and"
+      " the effective sample size of each parameter");
 
   // To be implemented in the future
   /*declareProperty(
@@ -165,6 +265,13 @@ void FABADAMinimizer::initialize(API::ICostFunction_sptr function,
   m_converged = false;
   m_maxIter = maxIterations;
 
+  const size_t nChains = getProperty("NumberOfChains");
+  if (nChains == 0) {
+    throw std::invalid_argument("NumberOfChains must be at least 1.");
+  }
+  const size_t chainLength = getProperty("ChainLength");
+  m_chainLength = (chainLength + nChains - 1) / nChains;
+
   // Initialize member variables related to fitting parameters, such as
   // m_chains, m_jump, etc
   initChainsAndParameters();
@@ -188,13 +295,95 @@ void FABADAMinimizer::initialize(API::ICostFunction_sptr function,
         " 350 iterations for the burn-in period. Increase"
         " MaxIterations property");
   }
+
+  initReplicas(nChains, maxIterations);
 }
 
-/** Do one iteration.
+/** Create the chains run concurrently with this one. Each has a clone of the
+ * cost function and starts one jump away from the initial parameters, so that
+ * the convergence diagnostics can tell whether the chains have mixed.
+ *
+ * @param nChains :: the total number of chains, including this one
+ * @param maxIterations :: maximum number of iterations
+ */
+void FABADAMinimizer::initReplicas(size_t nChains, size_t maxIterations) {
+  m_replicas.clear();
+  m_running.assign(nChains, 1);
+  const auto domain = m_leastSquares->getDomain();
+  const auto values = m_leastSquares->getValues();
+
+  for (size_t i = 1; i < nChains; ++i) {
+    auto replica = std::make_unique<FABADAMinimizer>();
+    for (const auto property : getProperties()) {
+      if (property->direction() == Kernel::Direction::Input)
+        replica->setPropertyValue(property->name(), property->value());
+    }
+    replica->setProperty("ChainLength", m_chainLength);
+    replica->setProperty("NumberOfChains", static_cast<size_t>(1));
+    replica->m_rng.seed(
+        static_cast<std::mt19937::result_type>(std::mt19937::default_seed + i));
+
+    auto function = m_fitFunction->clone();
+    for (size_t j = 0; j < m_nParams; ++j) {
+      if (!function->isActive(j))
+        continue;
+      double value = m_parameters.get(j) + replica->gaussianStep(m_jump[j]);
+      auto *bcon = dynamic_cast<Constraints::BoundaryConstraint *>(
+          function->getConstraint(j));
+      if (bcon && bcon->hasLower())
+        value = std::max(value, bcon->lower());
+      if (bcon && bcon->hasUpper())
+        value = std::min(value, bcon->upper());
+      function->setParameter(j, value);
+    }
+    function->applyTies();
+
+    auto costFunction =
+        std::dynamic_pointer_cast<CostFunctions::CostFuncLeastSquares>(
+            API::CostFunctionFactory::Instance().create(
+                m_leastSquares->name()));
+    costFunction->setFittingFunction(
+        function, domain, std::make_shared<API::FunctionValues>(*values));
+    replica->initialize(costFunction, maxIterations);
+    m_replicas.emplace_back(std::move(replica));
+  }
+}
+
+/** Do one iteration of every chain that has not finished. The chains are
+ * independent, so they iterate concurrently.
  *
  * @return :: true if iterations must be continued, false otherwise
  */
 bool FABADAMinimizer::iterate(size_t /*iteration*/) {
+  if (m_replicas.empty())
+    return iterateChain();
+
+  const auto nChains = static_cast<int>(m_running.size());
+  std::vector<std::exception_ptr> errors(m_running.size());
+  PRAGMA_OMP(parallel for schedule(dynamic, 1))
+  for (int i = 0; i < nChains; ++i) {
+    if (!m_running[i])
+      continue;
+    try {
+      auto &chain = i == 0 ? *this : *m_replicas[i - 1];
+      m_running[i] = chain.iterateChain();
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  for (const auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+  return std::any_of(m_running.cbegin(), m_running.cend(),
+                     [](char running) { return running != 0; });
+}
+
+/** Do one iteration of this chain.
+ *
+ * @return :: true if iterations must be continued, false otherwise
+ */
+bool FABADAMinimizer::iterateChain() {
 
   if (!m_leastSquares) {
     throw std::runtime_error("Cost function isn't set up.");
@@ -205,8 +394,7 @@ bool FABADAMinimizer::iterate(size_t /*iteration*/) {
   // Just for the last iteration. For doing exactly the indicated
   // number of iterations.
   if (m_converged && m_counter == m_chainIterations - 1) {
-    size_t t = getProperty("ChainLength");
-    m = t % m_nParams;
+    m = m_chainLength % m_nParams;
     if (m == 0)
       m = m_nParams;
   }
@@ -305,7 +493,7 @@ bool FABADAMinimizer::iterate(size_t /*iteration*/) {
   // Evaluates if iterations should continue or not
   return iterationContinuation();
 
-} // Iterate() end
+} // iterateChain() end
 
 double FABADAMinimizer::costFunctionVal() { return m_chi2; }
 
@@ -313,10 +501,26 @@ double FABADAMinimizer::costFunctionVal() { return m_chi2; }
  *
  */
 void FABADAMinimizer::finalize() {
+  const size_t nChains = m_replicas.size() + 1;
+  if (!getPropertyValue("ConvergenceDiagnostics").empty()) {
+    std::vector<std::vector<std::vector<double>>> convergedChains;
+    const auto addConvergedChain = [&](const FABADAMinimizer &chain) {
+      std::vector<std::vector<double>> converged;
+      for (size_t j = 0; j < m_nParams; ++j)
+        converged.emplace_back(chain.m_chain[j].begin() + chain.m_convPoint,
+                               chain.m_chain[j].end());
+      convergedChains.emplace_back(std::move(converged));
+    };
+    addConvergedChain(*this);
+    for (const auto &replica : m_replicas)
+      addConvergedChain(*replica);
+    outputConvergenceDiagnostics(convergedChains);
+  }
+  mergeReplicas();
 
   // Creating the reduced chain (considering only one each
   // "Steps between values" values)
-  size_t chainLength = getProperty("ChainLength");
+  const size_t chainLength = m_chainLength * nChains;
   int nSteps = getProperty("StepsBetweenValues");
   if (nSteps <= 0) {
     g_log.warning() << "StepsBetweenValues has a non valid value"
@@ -378,13 +582,77 @@ void FABADAMinimizer::finalize() {
   }*/
 }
 
+/** Merge the chains run alongside this one into this chain. The parts of all
+ * chains before convergence come first, followed by all of the converged
+ * parts, so that the merged chain is treated as one converged chain.
+ *
+ */
+void FABADAMinimizer::mergeReplicas() {
+  if (m_replicas.empty())
+    return;
+
+  std::vector<std::vector<double>> merged(m_nParams + 1);
+  for (size_t j = 0; j <= m_nParams; ++j) {
+    auto &values = merged[j];
+    values.insert(values.end(), m_chain[j].begin(),
+                  m_chain[j].begin() + m_convPoint);
+    for (const auto &replica : m_replicas) {
+      const auto &chain = replica->m_chain[j];
+      values.insert(values.end(), chain.begin(),
+                    chain.begin() + replica->m_convPoint);
+    }
+    values.insert(values.end(), m_chain[j].begin() + m_convPoint,
+                  m_chain[j].end());
+    for (const auto &replica : m_replicas) {
+      const auto &chain = replica->m_chain[j];
+      values.insert(values.end(), chain.begin() + replica->m_convPoint,
+                    chain.end());
+    }
+  }
+  for (const auto &replica : m_replicas)
+    m_convPoint += replica->m_convPoint;
+  m_chain = std::move(merged);
+  m_replicas.clear();
+  m_running.assign(1, 1);
+}
+
+/** Create the table workspace of the convergence diagnostics of each
+ * parameter
+ *
+ * @param convergedChains :: the converged chain of each parameter of each
+ * chain
+ */
+void FABADAMinimizer::outputConvergenceDiagnostics(
+    const std::vector<std::vector<std::vector<double>>> &convergedChains) {
+  API::ITableWorkspace_sptr wsDiagnostics =
+      API::WorkspaceFactory::Instance().createTable("TableWorkspace");
+  wsDiagnostics->addColumn("str", "Name");
+  wsDiagnostics->addColumn("double", "R-hat");
+  wsDiagnostics->addColumn("double", "Effective Sample Size");
+
+  for (size_t j = 0; j < m_nParams; ++j) {
+    const auto diagnostics =
+        convergenceDiagnostics(splitChains(convergedChains, j));
+    if (diagnostics.first > RHAT_WARNING_LIMIT) {
+      g_log.warning() << "The chains have not mixed for parameter "
+                      << m_fitFunction->parameterName(j)
+                      << " (R-hat = " << diagnostics.first
+                      << "). Increase the ChainLength.\n";
+    }
+    API::TableRow row = wsDiagnostics->appendRow();
+    row << m_fitFunction->parameterName(j) << diagnostics.first
+        << diagnostics.second;
+  }
+  setProperty("ConvergenceDiagnostics", wsDiagnostics);
+}
+
 /** Returns the step from a Gaussian given sigma = jump
  *
  * @param jump :: sigma
  * @return :: the step
  */
 double FABADAMinimizer::gaussianStep(const double &jump) {
-  return Kernel::normal_distribution<double>(0.0, std::abs(jump))(rng);
+  return Kernel::normal_distribution<double>(0.0, std::abs(jump))(m_rng);
 }
 
 /** If the new point is out of its bounds, it is changed to fit in the bound
@@ -506,7 +774,7 @@ void FABADAMinimizer::algorithmDisplacement(const size_t &parameterIndex,
     double prob = exp((m_chi2 - chi2New) / (2.0 * m_temperature));
 
     // Decide if changing or not
-    double p = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double p = std::uniform_real_distribution<double>(0.0, 1.0)(m_rng);
     if (p <= prob) {
       for (size_t j = 0; j < m_nParams; j++) {
         m_chain[j].emplace_back(newParameters.get(j));
@@ -1059,8 +1327,8 @@ void FABADAMinimizer::initChainsAndParameters() {
     m_parameters.resize(m_nParams);
   }
 
-  size_t n = getProperty("ChainLength");
-  m_chainIterations = size_t(ceil(double(n) / double(m_nParams)));
+  m_chainIterations =
+      size_t(ceil(double(m_chainLength) / double(m_nParams)));
 
   // Save parameter constraints
   for (size_t i = 0; i < m_nParams; ++i) {
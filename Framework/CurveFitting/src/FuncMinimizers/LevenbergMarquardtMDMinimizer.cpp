@@ -156,7 +156,11 @@ bool LevenbergMarquardtMDMinimizer::iterate(size_t /*iteration*/) {
   // To find dx solve the system of linear equations   H * dx == -m_der
   dd *= -1.0;
   try {
-    H.solve(dd, dx);
+    if (const auto *blocks = m_costFunction->getParameterBlocks()) {
+      blocks->solve(H, dd, dx);
+    } else {
+      H.solve(dd, dx);
+    }
   } catch (std::runtime_error &error) {
     m_errorString = error.what();
     return false;
@@ -9,7 +9,9 @@
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidCurveFitting/AutoDiff.h"
 
+#include <array>
 #include <cmath>
 #include <gsl/gsl_multifit_nlin.h>
 #include <gsl/gsl_sf_erf.h>
@@ -111,41 +113,50 @@ void BackToBackExponential::setFwhm(const double w) {
 
 void BackToBackExponential::function1D(double *out, const double *xValues,
                                        const size_t nData) const {
-  /*
-    const double& I = getParameter("I");
-    const double& a = getParameter("A");
-    const double& b = getParameter("B");
-    const double& x0 = getParameter("X0");
-    const double& s = getParameter("S");
-  */
+  const std::array<double, 5> parameters{
+      {getParameter(0), getParameter(1), getParameter(2), getParameter(3),
+       getParameter(4)}};
+  functionGeneric(out, xValues, nData, parameters.data());
+}
 
-  const double I = getParameter(0);
-  const double a = getParameter(1);
-  const double b = getParameter(2);
-  const double x0 = getParameter(3);
-  const double s = getParameter(4);
+/**
+ * Evaluate the function for any scalar type of the parameters.
+ * @param out :: The function values
+ * @param xValues :: The x values
+ * @param nData :: The number of x values
+ * @param parameters :: The values of I, A, B, X0 and S
+ */
+template <typename T>
+void BackToBackExponential::functionGeneric(T *out, const double *xValues,
+                                            const size_t nData,
+                                            const T *parameters) const {
+  const T &I = parameters[0];
+  const T &a = parameters[1];
+  const T &b = parameters[2];
+  const T &x0 = parameters[3];
+  const T &s = parameters[4];
 
   // find the reasonable extent of the peak ~100 fwhm
   double extent = expWidth();
-  if (s > extent)
-    extent = s;
+  if (getParameter(4) > extent)
+    extent = getParameter(4);
   extent *= 100;
 
-  double s2 = s * s;
-  double normFactor = a * b / (a + b) / 2;
+  const T s2 = s * s;
+  T normFactor = a * b / (a + b) / 2;
   // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
   if (normFactor == 0.0)
     normFactor = 1.0;
+
   for (size_t i = 0; i < nData; i++) {
-    double diff = xValues[i] - x0;
+    const T diff = xValues[i] - x0;
     if (fabs(diff) < extent) {
-      double val = 0.0;
-      double arg1 = a / 2 * (a * s2 + 2 * diff);
-      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) /
-                                        sqrt(2 * s2))); // prevent overflow
-      double arg2 = b / 2 * (b * s2 - 2 * diff);
-      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) /
-                                        sqrt(2 * s2))); // prevent overflow
+      const T arg1 = a / 2 * (a * s2 + 2 * diff);
+      T val = exp(arg1 + AutoDiff::logErfc((a * s2 + diff) /
+                                           sqrt(2 * s2))); // prevent overflow
+      const T arg2 = b / 2 * (b * s2 - 2 * diff);
+      val += exp(arg2 + AutoDiff::logErfc((b * s2 - diff) /
+                                          sqrt(2 * s2))); // prevent overflow
       out[i] = I * val * normFactor;
     } else
       out[i] = 0.0;
@@ -153,13 +164,16 @@ void BackToBackExponential::function1D(double *out, const double *xValues,
 }
 
 /**
- * Evaluate function derivatives numerically.
+ * Evaluate the exact function derivatives by automatic differentiation.
  */
 void BackToBackExponential::functionDeriv1D(Jacobian *jacobian,
                                             const double *xValues,
                                             const size_t nData) {
-  FunctionDomain1DView domain(xValues, nData);
-  this->calNumericalDeriv(domain, *jacobian);
+  using Dual = AutoDiff::Dual<5>;
+  AutoDiff::calculateJacobian<5>(
+      *this, *jacobian, nData, [&](const Dual *parameters, Dual *out) {
+        functionGeneric(out, xValues, nData, parameters);
+      });
 }
 
 /**
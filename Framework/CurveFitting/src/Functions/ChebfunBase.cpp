@@ -9,11 +9,10 @@
 #include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/IFunction1D.h"
 #include "MantidCurveFitting/HalfComplex.h"
+#include "MantidKernel/Math/FastFourierTransform.h"
 
 #include <gsl/gsl_eigen.h>
 #include <gsl/gsl_errno.h>
-#include <gsl/gsl_fft_halfcomplex.h>
-#include <gsl/gsl_fft_real.h>
 
 #include <algorithm>
 #include <cassert>
@@ -537,11 +536,7 @@ std::vector<double> ChebfunBase::calcA(const std::vector<double> &p) const {
     std::reverse_copy(p.begin(), p.end(), tmp.begin());
     std::copy(p.begin() + 1, p.end() - 1, tmp.begin() + m_n + 1);
 
-    gsl_fft_real_workspace *workspace = gsl_fft_real_workspace_alloc(2 * m_n);
-    gsl_fft_real_wavetable *wavetable = gsl_fft_real_wavetable_alloc(2 * m_n);
-    gsl_fft_real_transform(&tmp[0], 1, 2 * m_n, wavetable, workspace);
-    gsl_fft_real_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
+    Kernel::FastFourierTransform::realForward(&tmp[0], 2 * m_n);
 
     HalfComplex fc(&tmp[0], tmp.size());
     for (size_t i = 0; i < nn; ++i) {
@@ -581,14 +576,7 @@ std::vector<double> ChebfunBase::calcP(const std::vector<double> &a) const {
         d *= 2;
       fc.set(i, d, 0.0);
     }
-    gsl_fft_real_workspace *workspace = gsl_fft_real_workspace_alloc(2 * m_n);
-    gsl_fft_halfcomplex_wavetable *wavetable =
-        gsl_fft_halfcomplex_wavetable_alloc(2 * m_n);
-
-    gsl_fft_halfcomplex_transform(tmp.data(), 1, 2 * m_n, wavetable, workspace);
-
-    gsl_fft_halfcomplex_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
+    Kernel::FastFourierTransform::halfComplexBackward(tmp.data(), 2 * m_n);
 
     std::reverse_copy(tmp.begin(), tmp.begin() + nn, p.begin());
   } else {
@@ -14,15 +14,12 @@
 #include "MantidAPI/IFunction.h"
 #include "MantidAPI/IFunction1D.h"
 #include "MantidCurveFitting/Functions/DeltaFunction.h"
+#include "MantidKernel/Math/FastFourierTransform.h"
 
 #include <algorithm>
 #include <cmath>
 #include <functional>
 
-#include <gsl/gsl_errno.h>
-#include <gsl/gsl_fft_halfcomplex.h>
-#include <gsl/gsl_fft_real.h>
-
 #include <fstream>
 #include <sstream>
 
@@ -104,23 +101,6 @@ void Convolution::setAttribute(const std::string &attName,
   CompositeFunction::setAttribute(attName, att);
 }
 
-namespace {
-// anonymous namespace for local definitions
-
-// A struct incapsulating workspaces for real fft
-struct RealFFTWorkspace {
-  explicit RealFFTWorkspace(size_t nData)
-      : workspace(gsl_fft_real_workspace_alloc(nData)),
-        wavetable(gsl_fft_real_wavetable_alloc(nData)) {}
-  ~RealFFTWorkspace() {
-    gsl_fft_real_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
-  }
-  gsl_fft_real_workspace *workspace;
-  gsl_fft_real_wavetable *wavetable;
-};
-} // namespace
-
 /**
  * Calculates convolution of the two member functions. Switches from FFT mode
  * to direct mode if the domain is not symmetric with respect to the
@@ -180,7 +160,6 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
   size_t nData = domain.size();
   const double *xValues = d1d.getPointerAt(0);
   refreshResolution();
-  RealFFTWorkspace workspace(nData);
   int n2 = static_cast<int>(nData) / 2;
   bool odd = n2 * 2 != static_cast<int>(nData);
   if (m_resolution.empty()) {
@@ -218,8 +197,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
         m_resolution[n2 + i] = tmp;
       }
     }
-    gsl_fft_real_transform(m_resolution.data(), 1, nData, workspace.wavetable,
-                           workspace.workspace);
+    FastFourierTransform::realForward(m_resolution.data(), nData);
     std::transform(m_resolution.begin(), m_resolution.end(),
                    m_resolution.begin(),
                    std::bind(std::multiplies<double>(), _1, dx));
@@ -279,8 +257,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
   if (!deltaFunctionsOnly) {
     // Transform the model function
     getFunction(1)->function(domain, values);
-    gsl_fft_real_transform(out, 1, nData, workspace.wavetable,
-                           workspace.workspace);
+    FastFourierTransform::realForward(out, nData);
 
     // Fourier transform is integration - multiply by the step in the
     // integration variable
@@ -305,11 +282,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
     }
 
     // Inverse fourier transform of fun
-    gsl_fft_halfcomplex_wavetable *wavetable_r =
-        gsl_fft_halfcomplex_wavetable_alloc(nData);
-    gsl_fft_halfcomplex_inverse(out, 1, nData, wavetable_r,
-                                workspace.workspace);
-    gsl_fft_halfcomplex_wavetable_free(wavetable_r);
+    FastFourierTransform::halfComplexInverse(out, nData);
 
     // Inverse fourier transform is integration - multiply by the step in the
     // integration variable
@@ -11,6 +11,7 @@
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/PeakFunctionIntegrator.h"
+#include "MantidCurveFitting/AutoDiff.h"
 #include "MantidCurveFitting/Constraints/BoundaryConstraint.h"
 #include "MantidCurveFitting/SpecialFunctionSupport.h"
 #include "MantidGeometry/Instrument.h"
@@ -20,6 +21,7 @@
 #include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidKernel/UnitFactory.h"
 
+#include <array>
 #include <cmath>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_multifit_nlin.h>
@@ -46,6 +48,24 @@ using namespace Constraints;
 
 DECLARE_FUNCTION(IkedaCarpenterPV)
 
+namespace {
+/// The imaginary part of exp(z)E1(z), where z = re + i im
+double imagExponentialIntegral(double re, double im) {
+  return exponentialIntegral(std::complex<double>(re, im)).imag();
+}
+
+template <size_t N>
+AutoDiff::Dual<N> imagExponentialIntegral(const AutoDiff::Dual<N> &re,
+                                          const AutoDiff::Dual<N> &im) {
+  const std::complex<double> z(re.value(), im.value());
+  const auto value = exponentialIntegral(z);
+  // d/dz exp(z)E1(z) = exp(z)E1(z) - 1/z
+  const auto derivative = value - 1.0 / z;
+  return value.imag() + derivative.imag() * (re - re.value()) +
+         derivative.real() * (im - im.value());
+}
+} // namespace
+
 double IkedaCarpenterPV::centre() const { return getParameter("X0"); }
 
 void IkedaCarpenterPV::setHeight(const double h) {
@@ -195,15 +215,16 @@ void IkedaCarpenterPV::calWavelengthAtEachDataPoint(const double *xValues,
  *  @param H :: pseudo voigt param
  *  @param eta :: pseudo voigt param
  */
-void IkedaCarpenterPV::convertVoigtToPseudo(const double &voigtSigmaSq,
-                                            const double &voigtGamma, double &H,
-                                            double &eta) const {
-  double fwhmGsq = 8.0 * M_LN2 * voigtSigmaSq;
-  double fwhmG = sqrt(fwhmGsq);
-  double fwhmG4 = fwhmGsq * fwhmGsq;
-  double fwhmL = voigtGamma;
-  double fwhmLsq = voigtGamma * voigtGamma;
-  double fwhmL4 = fwhmLsq * fwhmLsq;
+template <typename T>
+void IkedaCarpenterPV::convertVoigtToPseudo(const T &voigtSigmaSq,
+                                            const T &voigtGamma, T &H,
+                                            T &eta) const {
+  T fwhmGsq = 8.0 * M_LN2 * voigtSigmaSq;
+  T fwhmG = sqrt(fwhmGsq);
+  T fwhmG4 = fwhmGsq * fwhmGsq;
+  T fwhmL = voigtGamma;
+  T fwhmLsq = voigtGamma * voigtGamma;
+  T fwhmL4 = fwhmLsq * fwhmLsq;
 
   H = pow(fwhmG4 * fwhmG + 2.69269 * fwhmG4 * fwhmL +
               2.42843 * fwhmGsq * fwhmG * fwhmLsq +
@@ -214,113 +235,52 @@ void IkedaCarpenterPV::convertVoigtToPseudo(const double &voigtSigmaSq,
   if (H == 0.0)
     H = std::numeric_limits<double>::epsilon() * 1000.0;
 
-  double tmp = fwhmL / H;
+  T tmp = fwhmL / H;
 
   eta = 1.36603 * tmp - 0.47719 * tmp * tmp + 0.11116 * tmp * tmp * tmp;
 }
 
 void IkedaCarpenterPV::constFunction(double *out, const double *xValues,
                                      const int &nData) const {
-  const double I = getParameter("I");
-  const double alpha0 = getParameter("Alpha0");
-  const double alpha1 = getParameter("Alpha1");
-  const double beta0 = getParameter("Beta0");
-  const double kappa = getParameter("Kappa");
-  const double voigtsigmaSquared = getParameter("SigmaSquared");
-  const double voigtgamma = getParameter("Gamma");
-  const double X0 = getParameter("X0");
-
-  // cal pseudo voigt sigmaSq and gamma and eta
-  double gamma = 1.0; // dummy initialization
-  double eta = 0.5;   // dummy initialization
-  convertVoigtToPseudo(voigtsigmaSquared, voigtgamma, gamma, eta);
-  double sigmaSquared = gamma * gamma / (8.0 * M_LN2);
-
-  const double beta = 1 / beta0;
-
-  // equations taken from Fullprof manual
-
-  const double k = 0.05;
-
-  // Not entirely sure what to do if sigmaSquared ever negative
-  // for now just post a warning
-  double someConst = std::numeric_limits<double>::max() / 100.0;
-  if (sigmaSquared > 0)
-    someConst = 1 / sqrt(2.0 * sigmaSquared);
-  else if (sigmaSquared < 0) {
-    g_log.warning() << "sigmaSquared negative in functionLocal.\n";
-  }
-
-  // update wavelength vector
-  calWavelengthAtEachDataPoint(xValues, nData);
-
-  for (int i = 0; i < nData; i++) {
-    double diff = xValues[i] - X0;
-
-    double R = exp(-81.799 / (m_waveLength[i] * m_waveLength[i] * kappa));
-    double alpha = 1.0 / (alpha0 + m_waveLength[i] * alpha1);
-
-    double a_minus = alpha * (1 - k);
-    double a_plus = alpha * (1 + k);
-    double x = a_minus - beta;
-    double y = alpha - beta;
-    double z = a_plus - beta;
-
-    double Nu = 1 - R * a_minus / x;
-    double Nv = 1 - R * a_plus / z;
-    double Ns = -2 * (1 - R * alpha / y);
-    double Nr = 2 * R * alpha * alpha * beta * k * k / (x * y * z);
-
-    double u = a_minus * (a_minus * sigmaSquared - 2 * diff) / 2.0;
-    double v = a_plus * (a_plus * sigmaSquared - 2 * diff) / 2.0;
-    double s = alpha * (alpha * sigmaSquared - 2 * diff) / 2.0;
-    double r = beta * (beta * sigmaSquared - 2 * diff) / 2.0;
-
-    double yu = (a_minus * sigmaSquared - diff) * someConst;
-    double yv = (a_plus * sigmaSquared - diff) * someConst;
-    double ys = (alpha * sigmaSquared - diff) * someConst;
-    double yr = (beta * sigmaSquared - diff) * someConst;
-
-    std::complex<double> zs =
-        std::complex<double>(-alpha * diff, 0.5 * alpha * gamma);
-    std::complex<double> zu = (1 - k) * zs;
-    std::complex<double> zv = (1 + k) * zs;
-    std::complex<double> zr =
-        std::complex<double>(-beta * diff, 0.5 * beta * gamma);
-
-    double N = 0.25 * alpha * (1 - k * k) / (k * k);
-
-    out[i] = I * N *
-             ((1 - eta) * (Nu * exp(u + gsl_sf_log_erfc(yu)) +
-                           Nv * exp(v + gsl_sf_log_erfc(yv)) +
-                           Ns * exp(s + gsl_sf_log_erfc(ys)) +
-                           Nr * exp(r + gsl_sf_log_erfc(yr))) -
-              eta * 2.0 / M_PI *
-                  (Nu * exponentialIntegral(zu).imag() +
-                   Nv * exponentialIntegral(zv).imag() +
-                   Ns * exponentialIntegral(zs).imag() +
-                   Nr * exponentialIntegral(zr).imag()));
-  }
+  functionLocal(out, xValues, static_cast<size_t>(nData));
 }
 
 void IkedaCarpenterPV::functionLocal(double *out, const double *xValues,
                                      const size_t nData) const {
-  const double I = getParameter("I");
-  const double alpha0 = getParameter("Alpha0");
-  const double alpha1 = getParameter("Alpha1");
-  const double beta0 = getParameter("Beta0");
-  const double kappa = getParameter("Kappa");
-  const double voigtsigmaSquared = getParameter("SigmaSquared");
-  const double voigtgamma = getParameter("Gamma");
-  const double X0 = getParameter("X0");
+  std::array<double, 8> parameters;
+  for (size_t i = 0; i < parameters.size(); ++i)
+    parameters[i] = getParameter(i);
+  functionGeneric(out, xValues, nData, parameters.data());
+}
+
+/**
+ * Evaluate the function for any scalar type of the parameters.
+ * @param out :: The function values
+ * @param xValues :: The x values
+ * @param nData :: The number of x values
+ * @param parameters :: The values of the parameters in the order that they
+ * are declared
+ */
+template <typename T>
+void IkedaCarpenterPV::functionGeneric(T *out, const double *xValues,
+                                       const size_t nData,
+                                       const T *parameters) const {
+  const T &I = parameters[0];
+  const T &alpha0 = parameters[1];
+  const T &alpha1 = parameters[2];
+  const T &beta0 = parameters[3];
+  const T &kappa = parameters[4];
+  const T &voigtsigmaSquared = parameters[5];
+  const T &voigtgamma = parameters[6];
+  const T &X0 = parameters[7];
 
   // cal pseudo voigt sigmaSq and gamma and eta
-  double gamma = 1.0; // dummy initialization
-  double eta = 0.5;   // dummy initialization
+  T gamma = 1.0; // dummy initialization
+  T eta = 0.5;   // dummy initialization
   convertVoigtToPseudo(voigtsigmaSquared, voigtgamma, gamma, eta);
-  double sigmaSquared = gamma * gamma / (8.0 * M_LN2); // pseudo voigt sigma^2
+  T sigmaSquared = gamma * gamma / (8.0 * M_LN2); // pseudo voigt sigma^2
 
-  const double beta = 1 / beta0;
+  const T beta = 1 / beta0;
 
   // equations taken from Fullprof manual
 
@@ -328,7 +288,7 @@ void IkedaCarpenterPV::functionLocal(double *out, const double *xValues,
 
   // Not entirely sure what to do if sigmaSquared ever negative
   // for now just post a warning
-  double someConst = std::numeric_limits<double>::max() / 100.0;
+  T someConst = std::numeric_limits<double>::max() / 100.0;
   if (sigmaSquared > 0)
     someConst = 1 / sqrt(2.0 * sigmaSquared);
   else if (sigmaSquared < 0) {
@@ -339,64 +299,66 @@ void IkedaCarpenterPV::functionLocal(double *out, const double *xValues,
   calWavelengthAtEachDataPoint(xValues, nData);
 
   for (size_t i = 0; i < nData; i++) {
-    double diff = xValues[i] - X0;
+    T diff = xValues[i] - X0;
 
-    double R = exp(-81.799 / (m_waveLength[i] * m_waveLength[i] * kappa));
-    double alpha = 1.0 / (alpha0 + m_waveLength[i] * alpha1);
+    T R = exp(-81.799 / (m_waveLength[i] * m_waveLength[i] * kappa));
+    T alpha = 1.0 / (alpha0 + m_waveLength[i] * alpha1);
 
-    double a_minus = alpha * (1 - k);
-    double a_plus = alpha * (1 + k);
-    double x = a_minus - beta;
-    double y = alpha - beta;
-    double z = a_plus - beta;
+    T a_minus = alpha * (1 - k);
+    T a_plus = alpha * (1 + k);
+    T x = a_minus - beta;
+    T y = alpha - beta;
+    T z = a_plus - beta;
 
-    double Nu = 1 - R * a_minus / x;
-    double Nv = 1 - R * a_plus / z;
-    double Ns = -2 * (1 - R * alpha / y);
-    double Nr = 2 * R * alpha * alpha * beta * k * k / (x * y * z);
+    T Nu = 1 - R * a_minus / x;
+    T Nv = 1 - R * a_plus / z;
+    T Ns = -2 * (1 - R * alpha / y);
+    T Nr = 2 * R * alpha * alpha * beta * k * k / (x * y * z);
 
-    double u = a_minus * (a_minus * sigmaSquared - 2 * diff) / 2.0;
-    double v = a_plus * (a_plus * sigmaSquared - 2 * diff) / 2.0;
-    double s = alpha * (alpha * sigmaSquared - 2 * diff) / 2.0;
-    double r = beta * (beta * sigmaSquared - 2 * diff) / 2.0;
+    T u = a_minus * (a_minus * sigmaSquared - 2 * diff) / 2.0;
+    T v = a_plus * (a_plus * sigmaSquared - 2 * diff) / 2.0;
+    T s = alpha * (alpha * sigmaSquared - 2 * diff) / 2.0;
+    T r = beta * (beta * sigmaSquared - 2 * diff) / 2.0;
 
-    double yu = (a_minus * sigmaSquared - diff) * someConst;
-    double yv = (a_plus * sigmaSquared - diff) * someConst;
-    double ys = (alpha * sigmaSquared - diff) * someConst;
-    double yr = (beta * sigmaSquared - diff) * someConst;
+    T yu = (a_minus * sigmaSquared - diff) * someConst;
+    T yv = (a_plus * sigmaSquared - diff) * someConst;
+    T ys = (alpha * sigmaSquared - diff) * someConst;
+    T yr = (beta * sigmaSquared - diff) * someConst;
 
-    std::complex<double> zs =
-        std::complex<double>(-alpha * diff, 0.5 * alpha * gamma);
-    std::complex<double> zu = (1 - k) * zs;
-    std::complex<double> zv = (1 + k) * zs;
-    std::complex<double> zr =
-        std::complex<double>(-beta * diff, 0.5 * beta * gamma);
+    // the real and imaginary parts of the complex arguments
+    T zsRe = -alpha * diff;
+    T zsIm = 0.5 * alpha * gamma;
+    T zrRe = -beta * diff;
+    T zrIm = 0.5 * beta * gamma;
 
-    double N = 0.25 * alpha * (1 - k * k) / (k * k);
+    T N = 0.25 * alpha * (1 - k * k) / (k * k);
 
     out[i] = I * N *
-             ((1 - eta) * (Nu * exp(u + gsl_sf_log_erfc(yu)) +
-                           Nv * exp(v + gsl_sf_log_erfc(yv)) +
-                           Ns * exp(s + gsl_sf_log_erfc(ys)) +
-                           Nr * exp(r + gsl_sf_log_erfc(yr))) -
+             ((1 - eta) * (Nu * exp(u + AutoDiff::logErfc(yu)) +
+                           Nv * exp(v + AutoDiff::logErfc(yv)) +
+                           Ns * exp(s + AutoDiff::logErfc(ys)) +
+                           Nr * exp(r + AutoDiff::logErfc(yr))) -
               eta * 2.0 / M_PI *
-                  (Nu * exponentialIntegral(zu).imag() +
-                   Nv * exponentialIntegral(zv).imag() +
-                   Ns * exponentialIntegral(zs).imag() +
-                   Nr * exponentialIntegral(zr).imag()));
+                  (Nu * imagExponentialIntegral((1 - k) * zsRe,
+                                                (1 - k) * zsIm) +
+                   Nv * imagExponentialIntegral((1 + k) * zsRe,
+                                                (1 + k) * zsIm) +
+                   Ns * imagExponentialIntegral(zsRe, zsIm) +
+                   Nr * imagExponentialIntegral(zrRe, zrIm)));
   }
 }
 
-void IkedaCarpenterPV::functionDerivLocal(API::Jacobian * /*jacobian*/,
-                                          const double * /*xValues*/,
-                                          const size_t /*nData*/) {
-  throw Mantid::Kernel::Exception::NotImplementedError(
-      "functionDerivLocal is not implemented for IkedaCarpenterPV.");
-}
-
-void IkedaCarpenterPV::functionDeriv(const API::FunctionDomain &domain,
-                                     API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+/**
+ * Evaluate the exact function derivatives by automatic differentiation.
+ */
+void IkedaCarpenterPV::functionDerivLocal(API::Jacobian *jacobian,
+                                          const double *xValues,
+                                          const size_t nData) {
+  using Dual = AutoDiff::Dual<8>;
+  AutoDiff::calculateJacobian<8>(
+      *this, *jacobian, nData, [&](const Dual *parameters, Dual *out) {
+        functionGeneric(out, xValues, nData, parameters);
+      });
 }
 
 /// Returns the integral intensity of the peak
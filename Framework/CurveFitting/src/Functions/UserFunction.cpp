@@ -8,7 +8,10 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidAPI/CompiledFormula.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/Jacobian.h"
 #include "MantidAPI/MuParserUtils.h"
 #include "MantidGeometry/muParser_Silent.h"
 #include <boost/tokenizer.hpp>
@@ -69,6 +72,7 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_x_set = false;
+  m_compiled.reset();
   clearAllParameters();
 
   try {
@@ -99,6 +103,26 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_parser->SetExpr(m_formula);
+
+  std::vector<std::string> names;
+  for (size_t i = 0; i < nParams(); i++) {
+    names.emplace_back(parameterName(i));
+  }
+  try {
+    m_compiled = std::make_unique<CompiledFormula>(
+        m_formula, std::vector<std::string>{"x"}, names);
+  } catch (std::invalid_argument &) {
+    // Evaluated point by point with m_parser
+  }
+}
+
+/// @returns The values of the parameters in the order they are declared
+std::vector<double> UserFunction::parameterValues() const {
+  std::vector<double> values(nParams());
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = getParameter(i);
+  }
+  return values;
 }
 
 /** Calculate the fitting function.
@@ -110,6 +134,10 @@ void UserFunction::setAttribute(const std::string &attName,
  */
 void UserFunction::function1D(double *out, const double *xValues,
                               const size_t nData) const {
+  if (m_compiled) {
+    m_compiled->evaluate(out, nData, {xValues}, parameterValues());
+    return;
+  }
   for (size_t i = 0; i < nData; i++) {
     m_x = xValues[i];
     try {
@@ -121,13 +149,35 @@ void UserFunction::function1D(double *out, const double *xValues,
 }
 
 /**
+ * The derivatives are found symbolically if the formula could be compiled and
+ * numerically otherwise.
  * @param domain :: the space on which the function acts
  * @param jacobian :: the set of partial derivatives of the function with
  * respect to the fitting parameters
  */
 void UserFunction::functionDeriv(const API::FunctionDomain &domain,
                                  API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+  const auto *d1d = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!m_compiled || !d1d ||
+      dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    calNumericalDeriv(domain, jacobian);
+    return;
+  }
+
+  const size_t nData = d1d->size();
+  std::vector<std::vector<double>> derivatives(nParams(),
+                                               std::vector<double>(nData));
+  std::vector<double *> columns;
+  for (auto &column : derivatives) {
+    columns.emplace_back(column.data());
+  }
+  m_compiled->evaluateDerivatives(columns, nData, {d1d->getPointerAt(0)},
+                                  parameterValues());
+  for (size_t iP = 0; iP < derivatives.size(); iP++) {
+    for (size_t i = 0; i < nData; i++) {
+      jacobian.set(i, iP, derivatives[iP][i]);
+    }
+  }
 }
 
 } // namespace Functions
@@ -0,0 +1,238 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/ParameterBlocks.h"
+#include "MantidCurveFitting/GSLMatrix.h"
+#include "MantidCurveFitting/GSLVector.h"
+
+#include "MantidAPI/CompositeDomain.h"
+#include "MantidAPI/MultiDomainFunction.h"
+
+#include <gsl/gsl_linalg.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace CurveFitting {
+
+namespace {
+/// Owns a gsl_permutation
+using Permutation =
+    std::unique_ptr<gsl_permutation, decltype(&gsl_permutation_free)>;
+
+/// Solve a system of linear equations given the LU decomposition of its
+/// matrix and throw if it fails.
+void solveLU(const GSLMatrix &lu, const gsl_permutation *p,
+             const GSLVector &rhs, GSLVector &x) {
+  const int res = gsl_linalg_LU_solve(lu.gsl(), p, rhs.gsl(), x.gsl());
+  if (res != GSL_SUCCESS) {
+    throw std::runtime_error("Failed to solve system of linear equations.\n"
+                             "Error message returned by the GSL:\n" +
+                             std::string(gsl_strerror(res)));
+  }
+}
+} // namespace
+
+/**
+ * Find the block structure of a fit if it has one that is worth using.
+ * @param function :: The fitting function
+ * @param domain :: The domain it is applied to
+ * @returns The blocks or nullptr if the function isn't a MultiDomainFunction
+ *   applied to several domains, its derivatives are numerical or none of
+ *   its active parameters are local to a domain.
+ */
+std::unique_ptr<ParameterBlocks>
+ParameterBlocks::create(const API::IFunction &function,
+                        const API::FunctionDomain &domain) {
+  const auto *multi = dynamic_cast<const API::MultiDomainFunction *>(&function);
+  const auto *composite = dynamic_cast<const API::CompositeDomain *>(&domain);
+  if (!multi || !composite || composite->getNParts() < 2 ||
+      composite->getNParts() <= multi->getMaxIndex() ||
+      multi->getAttribute("NumDeriv").asBool()) {
+    return nullptr;
+  }
+  auto blocks =
+      std::make_unique<ParameterBlocks>(*multi, composite->getNParts());
+  if (blocks->m_shared.size() == blocks->m_nActive) {
+    return nullptr;
+  }
+  return blocks;
+}
+
+/**
+ * Constructor.
+ * @param function :: A MultiDomainFunction
+ * @param nDomains :: The number of domains it is applied to
+ */
+ParameterBlocks::ParameterBlocks(const API::MultiDomainFunction &function,
+                                 size_t nDomains)
+    : m_functions(nDomains), m_parameters(nDomains),
+      m_activeIndices(nDomains), m_local(nDomains), m_nActive(0) {
+  const size_t nParams = function.nParams();
+  std::vector<size_t> activeIndex(nParams, NOT_ACTIVE);
+  for (size_t ip = 0; ip < nParams; ++ip) {
+    if (function.isActive(ip)) {
+      activeIndex[ip] = m_nActive++;
+    }
+  }
+
+  // Member functions and their parameters are added in the order of their
+  // indices so the parameters of each block are sorted.
+  std::vector<size_t> domains;
+  size_t offset = 0;
+  for (size_t iFun = 0; iFun < function.nFunctions(); ++iFun) {
+    function.getDomainIndices(iFun, nDomains, domains);
+    std::sort(domains.begin(), domains.end());
+    domains.erase(std::unique(domains.begin(), domains.end()), domains.end());
+    const size_t np = function.getFunction(iFun)->nParams();
+    m_offsets.emplace_back(offset);
+    for (auto iDomain : domains) {
+      if (iDomain >= nDomains) {
+        throw std::invalid_argument("ParameterBlocks: domain index " +
+                                    std::to_string(iDomain) +
+                                    " is out of range.");
+      }
+      m_functions[iDomain].emplace_back(iFun);
+      for (size_t ip = offset; ip < offset + np; ++ip) {
+        m_parameters[iDomain].emplace_back(ip);
+        m_activeIndices[iDomain].emplace_back(activeIndex[ip]);
+      }
+    }
+    offset += np;
+  }
+
+  // A parameter is local if exactly one block depends on it
+  std::vector<size_t> count(m_nActive, 0);
+  std::vector<size_t> owner(m_nActive, 0);
+  for (size_t iBlock = 0; iBlock < nDomains; ++iBlock) {
+    for (auto ia : m_activeIndices[iBlock]) {
+      if (ia != NOT_ACTIVE) {
+        ++count[ia];
+        owner[ia] = iBlock;
+      }
+    }
+  }
+  for (size_t ia = 0; ia < m_nActive; ++ia) {
+    if (count[ia] == 1) {
+      m_local[owner[ia]].emplace_back(ia);
+    } else {
+      m_shared.emplace_back(ia);
+    }
+  }
+}
+
+/**
+ * Solve a system of linear equations whose matrix has the block structure
+ * of the Hessian, such as the damped Hessian of the Levenberg-Marquardt
+ * method. Elements of the matrix outside of the blocks are ignored.
+ * @param hessian :: The matrix of the system. Its size is nActive().
+ * @param rhs :: The right-hand side
+ * @param x :: Receives the solution
+ */
+void ParameterBlocks::solve(const GSLMatrix &hessian, const GSLVector &rhs,
+                            GSLVector &x) const {
+  if (hessian.size1() != m_nActive || hessian.size2() != m_nActive ||
+      rhs.size() != m_nActive) {
+    throw std::invalid_argument(
+        "ParameterBlocks: system of linear equations has wrong size.");
+  }
+  x.resize(m_nActive);
+  const size_t nShared = m_shared.size();
+
+  // The Schur complement of the local parameters is
+  //   S - sum_i B_i^T D_i^-1 B_i
+  // where D_i is the block of the local parameters of domain i, B_i couples
+  // them to the shared parameters and S is the block of the shared ones.
+  GSLMatrix schur;
+  GSLVector schurRhs;
+  if (nShared > 0) {
+    schur.resize(nShared, nShared);
+    schurRhs.resize(nShared);
+  }
+  for (size_t a = 0; a < nShared; ++a) {
+    schurRhs.set(a, rhs.get(m_shared[a]));
+    for (size_t b = 0; b < nShared; ++b) {
+      schur.set(a, b, hessian.get(m_shared[a], m_shared[b]));
+    }
+  }
+
+  // D_i^-1 times the local right-hand side and times each column of B_i
+  std::vector<GSLVector> localSolution(nBlocks());
+  std::vector<std::vector<GSLVector>> localCoupling(nBlocks());
+  for (size_t iBlock = 0; iBlock < nBlocks(); ++iBlock) {
+    const auto &local = m_local[iBlock];
+    const size_t nLocal = local.size();
+    if (nLocal == 0) {
+      continue;
+    }
+    GSLMatrix lu(nLocal, nLocal);
+    GSLVector localRhs(nLocal);
+    for (size_t k = 0; k < nLocal; ++k) {
+      localRhs.set(k, rhs.get(local[k]));
+      for (size_t l = 0; l < nLocal; ++l) {
+        lu.set(k, l, hessian.get(local[k], local[l]));
+      }
+    }
+    Permutation p(gsl_permutation_alloc(nLocal), gsl_permutation_free);
+    int s;
+    gsl_linalg_LU_decomp(lu.gsl(), p.get(), &s);
+    localSolution[iBlock].resize(nLocal);
+    solveLU(lu, p.get(), localRhs, localSolution[iBlock]);
+
+    auto &coupling = localCoupling[iBlock];
+    coupling.resize(nShared);
+    GSLVector column(nLocal);
+    for (size_t b = 0; b < nShared; ++b) {
+      for (size_t k = 0; k < nLocal; ++k) {
+        column.set(k, hessian.get(local[k], m_shared[b]));
+      }
+      coupling[b].resize(nLocal);
+      solveLU(lu, p.get(), column, coupling[b]);
+    }
+
+    for (size_t a = 0; a < nShared; ++a) {
+      double rhsCorrection = 0.0;
+      for (size_t k = 0; k < nLocal; ++k) {
+        rhsCorrection +=
+            hessian.get(m_shared[a], local[k]) * localSolution[iBlock][k];
+      }
+      schurRhs[a] -= rhsCorrection;
+      for (size_t b = 0; b < nShared; ++b) {
+        double correction = 0.0;
+        for (size_t k = 0; k < nLocal; ++k) {
+          correction += hessian.get(m_shared[a], local[k]) * coupling[b][k];
+        }
+        schur(a, b) -= correction;
+      }
+    }
+  }
+
+  // Solve for the shared parameters and substitute them back
+  std::vector<double> sharedSolution(nShared);
+  if (nShared > 0) {
+    GSLVector xShared;
+    schur.solve(schurRhs, xShared);
+    for (size_t a = 0; a < nShared; ++a) {
+      sharedSolution[a] = xShared.get(a);
+      x.set(m_shared[a], sharedSolution[a]);
+    }
+  }
+  for (size_t iBlock = 0; iBlock < nBlocks(); ++iBlock) {
+    const auto &local = m_local[iBlock];
+    for (size_t k = 0; k < local.size(); ++k) {
+      double value = localSolution[iBlock][k];
+      for (size_t b = 0; b < nShared; ++b) {
+        value -= localCoupling[iBlock][b][k] * sharedSolution[b];
+      }
+      x.set(local[k], value);
+    }
+  }
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
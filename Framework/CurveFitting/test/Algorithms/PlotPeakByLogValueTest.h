@@ -568,6 +568,48 @@ public:
     AnalysisDataService::Instance().clear();
   }
 
+  void test_parallel_fits_match_individual_fits() {
+    createHistogramWorkspace("InputWS", 10, -10.0, 10.0);
+    // Each spectrum has a different level so each row has its own result
+    const std::vector<double> levels{1.0, 1.1, 0.6};
+    const auto input =
+        AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("InputWS");
+    TS_ASSERT_DIFFERS(input->y(0)[0], input->y(1)[0]);
+    TS_ASSERT_DIFFERS(input->y(1)[0], input->y(2)[0]);
+
+    for (const bool warmStart : {false, true}) {
+      std::vector<ITableWorkspace_sptr> results;
+      for (const std::string fitType :
+           {"Sequential", "Individual", "Parallel"}) {
+        PlotPeakByLogValue alg;
+        alg.initialize();
+        alg.setAlwaysStoreInADS(false);
+        alg.setProperty("EvaluationType", "Histogram");
+        alg.setPropertyValue("Input", "InputWS,v1:3");
+        alg.setPropertyValue("OutputWorkspace", "out");
+        alg.setPropertyValue("FitType", fitType);
+        alg.setProperty("WarmStart", warmStart);
+        alg.setProperty("OutputFitStatus", true);
+        alg.setPropertyValue("Function", "name=FlatBackground,A0=2");
+        TS_ASSERT_THROWS_NOTHING(alg.execute());
+        results.emplace_back(alg.getProperty("OutputWorkspace"));
+        std::vector<std::string> status = alg.getProperty("OutputStatus");
+        TS_ASSERT_EQUALS(status.size(), 3);
+      }
+
+      for (const auto &result : results) {
+        TS_ASSERT_EQUALS(result->rowCount(), levels.size());
+        for (size_t row = 0; row < result->rowCount(); ++row) {
+          // The inputs are in order whichever fit completes first
+          TS_ASSERT_EQUALS(result->Double(row, 0), results[0]->Double(row, 0));
+          TS_ASSERT_DELTA(result->Double(row, 1), levels[row], 1e-10);
+        }
+      }
+    }
+
+    AnalysisDataService::Instance().clear();
+  }
+
   void test_single_exclude_range_single_Spectra() {
     createData();
 
@@ -0,0 +1,141 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidCurveFitting/AutoDiff.h"
+#include "MantidCurveFitting/Functions/Gaussian.h"
+#include "MantidCurveFitting/Jacobian.h"
+
+#include <cmath>
+
+using namespace Mantid::CurveFitting;
+using Dual = AutoDiff::Dual<2>;
+
+namespace {
+/// A Gaussian written once for any scalar type
+template <typename T>
+void gaussian(T *out, const double *xValues, const size_t nData,
+              const T *parameters) {
+  const T &height = parameters[0];
+  const T &centre = parameters[1];
+  const T &sigma = parameters[2];
+  for (size_t i = 0; i < nData; ++i) {
+    const T diff = xValues[i] - centre;
+    out[i] = height * exp(-0.5 * diff * diff / (sigma * sigma));
+  }
+}
+} // namespace
+
+class AutoDiffTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AutoDiffTest *createSuite() { return new AutoDiffTest(); }
+  static void destroySuite(AutoDiffTest *suite) { delete suite; }
+
+  void test_constants_have_no_derivatives() {
+    const Dual c(2.5);
+    TS_ASSERT_EQUALS(c.value(), 2.5);
+    TS_ASSERT_EQUALS(c.derivative(0), 0.0);
+    TS_ASSERT_EQUALS(c.derivative(1), 0.0);
+  }
+
+  void test_arithmetic() {
+    const auto x = Dual::variable(3.0, 0);
+    const auto y = Dual::variable(2.0, 1);
+
+    const auto sum = x + 2.0 * y - 1.0;
+    TS_ASSERT_EQUALS(sum.value(), 6.0);
+    TS_ASSERT_EQUALS(sum.derivative(0), 1.0);
+    TS_ASSERT_EQUALS(sum.derivative(1), 2.0);
+
+    const auto product = x * y * x;
+    TS_ASSERT_EQUALS(product.value(), 18.0);
+    TS_ASSERT_EQUALS(product.derivative(0), 12.0);
+    TS_ASSERT_EQUALS(product.derivative(1), 9.0);
+
+    const auto quotient = x / y;
+    TS_ASSERT_DELTA(quotient.value(), 1.5, 1e-15);
+    TS_ASSERT_DELTA(quotient.derivative(0), 0.5, 1e-15);
+    TS_ASSERT_DELTA(quotient.derivative(1), -0.75, 1e-15);
+
+    const auto inverse = 1.0 / y;
+    TS_ASSERT_DELTA(inverse.value(), 0.5, 1e-15);
+    TS_ASSERT_DELTA(inverse.derivative(1), -0.25, 1e-15);
+
+    const auto difference = 1.0 - x;
+    TS_ASSERT_EQUALS(difference.value(), -2.0);
+    TS_ASSERT_EQUALS(difference.derivative(0), -1.0);
+  }
+
+  void test_comparisons_use_values() {
+    const auto x = Dual::variable(3.0, 0);
+    TS_ASSERT(x > 2.0);
+    TS_ASSERT(x < 4.0);
+    TS_ASSERT(x == 3.0);
+    TS_ASSERT(x != Dual::variable(3.5, 1));
+  }
+
+  void test_functions() {
+    const double x0 = 0.7;
+    const auto x = Dual::variable(x0, 0);
+    TS_ASSERT_DELTA(exp(x).derivative(0), std::exp(x0), 1e-15);
+    TS_ASSERT_DELTA(log(x).derivative(0), 1.0 / x0, 1e-15);
+    TS_ASSERT_DELTA(sqrt(x).derivative(0), 0.5 / std::sqrt(x0), 1e-15);
+    TS_ASSERT_DELTA(pow(x, 2.5).derivative(0), 2.5 * std::pow(x0, 1.5),
+                    1e-15);
+    TS_ASSERT_DELTA(sin(x).derivative(0), std::cos(x0), 1e-15);
+    TS_ASSERT_DELTA(cos(x).derivative(0), -std::sin(x0), 1e-15);
+    TS_ASSERT_DELTA(atan(x).derivative(0), 1.0 / (1.0 + x0 * x0), 1e-15);
+    TS_ASSERT_EQUALS(fabs(-x).value(), x0);
+    TS_ASSERT_EQUALS(fabs(-x).derivative(0), 1.0);
+    TS_ASSERT_DELTA(AutoDiff::logErfc(x).value(), std::log(std::erfc(x0)),
+                    1e-14);
+    TS_ASSERT_DELTA(AutoDiff::logErfc(x).derivative(0),
+                    -M_2_SQRTPI * std::exp(-x0 * x0) / std::erfc(x0), 1e-14);
+  }
+
+  void test_logErfc_does_not_overflow() {
+    const auto x = Dual::variable(40.0, 0);
+    const auto result = AutoDiff::logErfc(x);
+    TS_ASSERT(std::isfinite(result.value()));
+    // d/dx log(erfc(x)) tends to -2x for large x
+    TS_ASSERT_DELTA(result.derivative(0), -80.0, 0.01);
+  }
+
+  void test_jacobian_matches_analytical_gaussian() {
+    Functions::Gaussian fn;
+    fn.initialize();
+    fn.setHeight(2.0);
+    fn.setCentre(0.3);
+    fn.setFwhm(1.5);
+
+    Mantid::API::FunctionDomain1DVector x(-3.0, 3.0, 31);
+    Jacobian analytical(x.size(), 3);
+    fn.functionDeriv(x, analytical);
+
+    Jacobian automatic(x.size(), 3);
+    using Dual3 = AutoDiff::Dual<3>;
+    AutoDiff::calculateJacobian<3>(
+        fn, automatic, x.size(), [&](const Dual3 *parameters, Dual3 *out) {
+          gaussian(out, x.getPointerAt(0), x.size(), parameters);
+        });
+
+    // Gaussian differentiates with respect to 1/Sigma^2 rather than Sigma
+    const double sigma = fn.getParameter("Sigma");
+    const double dWeightBySigma = -2.0 / (sigma * sigma * sigma);
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_DELTA(automatic.get(i, 0), analytical.get(i, 0), 1e-12);
+      TS_ASSERT_DELTA(automatic.get(i, 1), analytical.get(i, 1), 1e-12);
+      TS_ASSERT_DELTA(automatic.get(i, 2),
+                      analytical.get(i, 2) * dWeightBySigma, 1e-12);
+    }
+  }
+};
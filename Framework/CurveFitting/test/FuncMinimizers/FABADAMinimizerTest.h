@@ -292,6 +292,59 @@ public:
     TS_ASSERT(!fit.isExecuted());
   }
 
+  void test_multiple_chains() {
+    auto ws2 = createExpDecayWorkspace();
+
+    Mantid::API::IFunction_sptr fun(new ExpDecay);
+    fun->setParameter("Height", 8.);
+    fun->setParameter("Lifetime", 1.0);
+
+    Fit fit;
+    fit.initialize();
+    fit.setChild(true);
+    fit.setProperty("Function", fun);
+    fit.setProperty("InputWorkspace", ws2);
+    fit.setProperty("WorkspaceIndex", 0);
+    fit.setProperty("CreateOutput", true);
+    fit.setProperty("MaxIterations", 100000);
+    fit.setProperty("Minimizer",
+                    "FABADA,ChainLength=10000,StepsBetweenValues=10,"
+                    "ConvergenceCriteria=0.1,NumberOfChains=4,Chains=Chain,"
+                    "ConvergedChain=ConvergedChain,ConvergenceDiagnostics="
+                    "Diagnostics,PDF=false");
+
+    TS_ASSERT_THROWS_NOTHING(fit.execute());
+    TS_ASSERT(fit.isExecuted());
+
+    TS_ASSERT_DELTA(fun->getParameter("Height"), 10.0, 0.1);
+    TS_ASSERT_DELTA(fun->getParameter("Lifetime"), 0.5, 0.01);
+
+    // The converged chains of the four chains are merged
+    const size_t nParams = fun->nParams();
+    MatrixWorkspace_sptr convChain = fit.getProperty("ConvergedChain");
+    TS_ASSERT(convChain);
+    TS_ASSERT_EQUALS(convChain->getNumberHistograms(), nParams + 1);
+    TS_ASSERT_EQUALS(convChain->x(0).size(), 1000);
+    MatrixWorkspace_sptr chain = fit.getProperty("Chains");
+    TS_ASSERT(chain);
+    TS_ASSERT(chain->x(0).size() >= 10000 + 4 * 350 * nParams);
+
+    ITableWorkspace_sptr diagnostics =
+        fit.getProperty("ConvergenceDiagnostics");
+    TS_ASSERT(diagnostics);
+    TS_ASSERT_EQUALS(diagnostics->columnCount(), 3);
+    TS_ASSERT_EQUALS(diagnostics->rowCount(), nParams);
+    TS_ASSERT_EQUALS(diagnostics->getColumn(1)->name(), "R-hat");
+    TS_ASSERT_EQUALS(diagnostics->getColumn(2)->name(),
+                     "Effective Sample Size");
+    TS_ASSERT_EQUALS(diagnostics->String(0, 0), "Height");
+    for (size_t i = 0; i < nParams; ++i) {
+      TS_ASSERT_DELTA(diagnostics->Double(i, 1), 1.0, 0.1);
+      TS_ASSERT_LESS_THAN(0.0, diagnostics->Double(i, 2));
+      TS_ASSERT_LESS_THAN_EQUALS(diagnostics->Double(i, 2), 10000.0);
+    }
+  }
+
   //  void test_cosineWithConstraint() {
   //
   //    auto ws2 = createCosineWorkspace();
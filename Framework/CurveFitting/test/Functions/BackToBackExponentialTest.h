@@ -11,6 +11,7 @@
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <cmath>
 
@@ -90,6 +91,27 @@ public:
     TS_ASSERT_EQUALS(b2bExp.getParameter("S"), 4.5);
   }
 
+  void test_derivatives_match_numerical_derivatives() {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 3.0);
+    b2bExp.setParameter("A", 1.1);
+    b2bExp.setParameter("B", 2.2);
+    b2bExp.setParameter("X0", 0.5);
+    b2bExp.setParameter("S", 0.8);
+
+    Mantid::API::FunctionDomain1DVector x(-5, 5, 41);
+    Mantid::CurveFitting::Jacobian automatic(x.size(), 5);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 5);
+    b2bExp.functionDeriv(x, automatic);
+    b2bExp.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < 5; ++j)
+        TS_ASSERT_DELTA(automatic.get(i, j), numerical.get(i, j),
+                        1e-2 * (1.0 + std::fabs(numerical.get(i, j))));
+    }
+  }
+
   // test that parameter I equals integrated intensity of the peak
   void test_integrated_intensity() {
     BackToBackExponential b2bExp;
@@ -11,6 +11,7 @@
 #include "MantidAPI/Axis.h"
 #include "MantidCurveFitting/Algorithms/Fit.h"
 #include "MantidCurveFitting/Functions/IkedaCarpenterPV.h"
+#include "MantidCurveFitting/Jacobian.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/ConfigService.h"
 
@@ -62,6 +63,30 @@ public:
     TS_ASSERT_DELTA(y[14], 53.8871, 1e-4);
   }
 
+  void test_derivatives_match_numerical_derivatives() {
+    IkedaCarpenterPV fn;
+    fn.initialize();
+    fn.setParameter("I", 3101.672);
+    fn.setParameter("Alpha0", 1.6);
+    fn.setParameter("Alpha1", 1.5);
+    fn.setParameter("Beta0", 31.9);
+    fn.setParameter("Kappa", 46.0);
+    fn.setParameter("SigmaSquared", 99.935);
+    fn.setParameter("Gamma", 2.0);
+    fn.setParameter("X0", 49.984);
+
+    Mantid::API::FunctionDomain1DVector x(0, 155, 31);
+    Mantid::CurveFitting::Jacobian automatic(x.size(), fn.nParams());
+    Mantid::CurveFitting::Jacobian numerical(x.size(), fn.nParams());
+    TS_ASSERT_THROWS_NOTHING(fn.functionDeriv(x, automatic));
+    fn.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < fn.nParams(); ++j)
+        TS_ASSERT_DELTA(automatic.get(i, j), numerical.get(i, j),
+                        1e-2 * (1.0 + std::fabs(numerical.get(i, j))));
+    }
+  }
+
   void test_intensity() {
     IkedaCarpenterPV fn;
     fn.initialize();
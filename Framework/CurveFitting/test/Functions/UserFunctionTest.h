@@ -83,4 +83,33 @@ public:
     TS_ASSERT(categories.size() == 1);
     TS_ASSERT(categories[0] == "General");
   }
+
+  void test_derivatives_are_exact() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute(
+                                    "h*exp(-0.5*((x-c)/s)^2) + b*x"));
+    fun.setParameter("h", 2.0);
+    fun.setParameter("c", 0.3);
+    fun.setParameter("s", 0.7);
+    fun.setParameter("b", 0.1);
+    TS_ASSERT_EQUALS(fun.nParams(), 4);
+
+    const size_t nData = 50;
+    std::vector<double> x(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = -2.0 + 0.1 * static_cast<double>(i);
+    }
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 4);
+    fun.functionDeriv(domain, J);
+
+    for (size_t i = 0; i < nData; i++) {
+      const double z = (x[i] - 0.3) / 0.7;
+      const double g = exp(-0.5 * z * z);
+      TS_ASSERT_DELTA(J.get(i, 0), g, 1e-14);
+      TS_ASSERT_DELTA(J.get(i, 1), 2.0 * g * z / 0.7, 1e-13);
+      TS_ASSERT_DELTA(J.get(i, 2), 2.0 * g * z * z / 0.7, 1e-13);
+      TS_ASSERT_DELTA(J.get(i, 3), x[i], 1e-14);
+    }
+  }
 };
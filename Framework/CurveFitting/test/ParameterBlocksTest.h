@@ -0,0 +1,201 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/JointDomain.h"
+#include "MantidAPI/MultiDomainFunction.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
+#include "MantidCurveFitting/FuncMinimizers/LevenbergMarquardtMDMinimizer.h"
+#include "MantidCurveFitting/Jacobian.h"
+#include "MantidCurveFitting/ParameterBlocks.h"
+
+#include "MantidTestHelpers/MultiDomainFunctionHelper.h"
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::CurveFitting;
+using namespace Mantid::CurveFitting::CostFunctions;
+using Mantid::TestHelpers::MultiDomainFunctionTest_Function;
+
+class ParameterBlocksTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ParameterBlocksTest *createSuite() {
+    return new ParameterBlocksTest();
+  }
+  static void destroySuite(ParameterBlocksTest *suite) { delete suite; }
+
+  void test_blocks() {
+    auto multi = makeFunction();
+    ParameterBlocks blocks(*multi, 3);
+    TS_ASSERT_EQUALS(blocks.nBlocks(), 3);
+    TS_ASSERT_EQUALS(blocks.nActive(), 8);
+    TS_ASSERT_EQUALS(blocks.functions(0), std::vector<size_t>({0, 1}));
+    TS_ASSERT_EQUALS(blocks.functions(2), std::vector<size_t>({0, 3}));
+    TS_ASSERT_EQUALS(blocks.parameters(1), std::vector<size_t>({0, 1, 4, 5}));
+    TS_ASSERT_EQUALS(blocks.activeIndices(1),
+                     std::vector<size_t>({0, 1, 4, 5}));
+    TS_ASSERT_EQUALS(blocks.sharedParameters(), std::vector<size_t>({0, 1}));
+    TS_ASSERT_EQUALS(blocks.localParameters(0), std::vector<size_t>({2, 3}));
+    TS_ASSERT_EQUALS(blocks.localParameters(2), std::vector<size_t>({6, 7}));
+  }
+
+  void test_fixed_parameters_are_not_active() {
+    auto multi = makeFunction();
+    multi->fix(4);
+    ParameterBlocks blocks(*multi, 3);
+    TS_ASSERT_EQUALS(blocks.nActive(), 7);
+    TS_ASSERT_EQUALS(blocks.parameters(1), std::vector<size_t>({0, 1, 4, 5}));
+    TS_ASSERT_EQUALS(blocks.activeIndices(1),
+                     std::vector<size_t>({0, 1, ParameterBlocks::NOT_ACTIVE,
+                                          4}));
+    TS_ASSERT_EQUALS(blocks.localParameters(1), std::vector<size_t>({4}));
+  }
+
+  void test_create() {
+    auto domain = Mantid::TestHelpers::makeMultiDomainDomain3();
+    TS_ASSERT(ParameterBlocks::create(*makeFunction(), *domain));
+    // Every parameter of this function is in more than one block
+    TS_ASSERT(!ParameterBlocks::create(
+        *Mantid::TestHelpers::makeMultiDomainFunction3(), *domain));
+    auto multi = makeFunction();
+    multi->setAttributeValue("NumDeriv", true);
+    TS_ASSERT(!ParameterBlocks::create(*multi, *domain));
+    MultiDomainFunctionTest_Function single;
+    TS_ASSERT(!ParameterBlocks::create(single, domain->getDomain(0)));
+  }
+
+  void test_derivatives_and_hessian_match_dense_jacobian() {
+    auto domain = Mantid::TestHelpers::makeMultiDomainDomain3();
+    auto values = makeValues(*domain);
+    auto multi = makeFunction();
+    for (size_t i = 0; i < multi->nParams(); ++i) {
+      multi->setParameter(i, 0.1 * static_cast<double>(i) - 0.2);
+    }
+
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(multi, domain, values);
+    TS_ASSERT(costFun->getParameterBlocks());
+    const double value = costFun->valDerivHessian();
+    const GSLVector &der = costFun->getDeriv();
+    const GSLMatrix &hessian = costFun->getHessian();
+
+    const size_t ny = values->size();
+    const size_t np = multi->nParams();
+    FunctionValues calculated(*domain);
+    multi->function(*domain, calculated);
+    CurveFitting::Jacobian jacobian(ny, np);
+    multi->functionDeriv(*domain, jacobian);
+
+    double expectedValue = 0.0;
+    for (size_t k = 0; k < ny; ++k) {
+      const double r = calculated.getCalculated(k) - values->getFitData(k);
+      expectedValue += 0.5 * r * r;
+    }
+    TS_ASSERT_DELTA(value, expectedValue, 1e-10);
+    for (size_t i = 0; i < np; ++i) {
+      double d = 0.0;
+      for (size_t k = 0; k < ny; ++k) {
+        d += (calculated.getCalculated(k) - values->getFitData(k)) *
+             jacobian.get(k, i);
+      }
+      TS_ASSERT_DELTA(der.get(i), d, 1e-10);
+      for (size_t j = 0; j < np; ++j) {
+        double h = 0.0;
+        for (size_t k = 0; k < ny; ++k) {
+          h += jacobian.get(k, i) * jacobian.get(k, j);
+        }
+        TS_ASSERT_DELTA(hessian.get(i, j), h, 1e-10);
+      }
+    }
+  }
+
+  void test_solve_matches_dense_solution() {
+    auto domain = Mantid::TestHelpers::makeMultiDomainDomain3();
+    auto values = makeValues(*domain);
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(makeFunction(), domain, values);
+    costFun->valDerivHessian();
+    const auto *blocks = costFun->getParameterBlocks();
+    TS_ASSERT(blocks);
+
+    GSLMatrix H(costFun->getHessian());
+    const size_t n = H.size1();
+    GSLVector rhs(n);
+    for (size_t i = 0; i < n; ++i) {
+      H.set(i, i, H.get(i, i) + 0.01);
+      rhs.set(i, 1.0 - 0.3 * static_cast<double>(i));
+    }
+    GSLVector x;
+    blocks->solve(H, rhs, x);
+    GSLVector expected;
+    H.solve(rhs, expected);
+    TS_ASSERT_EQUALS(x.size(), n);
+    for (size_t i = 0; i < n; ++i) {
+      TS_ASSERT_DELTA(x.get(i), expected.get(i), 1e-8);
+    }
+  }
+
+  void test_levenberg_marquardt_fit() {
+    auto domain = Mantid::TestHelpers::makeMultiDomainDomain3();
+    auto values = makeValues(*domain);
+    auto multi = makeFunction();
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(multi, domain, values);
+    TS_ASSERT(costFun->getParameterBlocks());
+
+    FuncMinimisers::LevenbergMarquardtMDMinimizer s;
+    s.initialize(costFun);
+    TS_ASSERT(s.minimize());
+    TS_ASSERT_EQUALS(s.getError(), "success");
+    TS_ASSERT_DELTA(s.costFunctionVal(), 0, 1e-8);
+
+    const std::vector<double> expected{1.0, -0.5, 0.0, 1.0,
+                                       1.0, 2.0,  2.0, 3.0};
+    for (size_t i = 0; i < expected.size(); ++i) {
+      TS_ASSERT_DELTA(multi->getParameter(i), expected[i], 1e-6);
+    }
+  }
+
+private:
+  /// A global function applied to all domains and a local one to each
+  std::shared_ptr<MultiDomainFunction> makeFunction() {
+    auto multi = std::make_shared<MultiDomainFunction>();
+    for (size_t i = 0; i < 4; ++i) {
+      multi->addFunction(std::make_shared<MultiDomainFunctionTest_Function>());
+    }
+    multi->getFunction(0)->setAttributeValue("Order", 3);
+    multi->clearDomainIndices();
+    multi->setDomainIndex(1, 0);
+    multi->setDomainIndex(2, 1);
+    multi->setDomainIndex(3, 2);
+    return multi;
+  }
+
+  /// Data for the parameters of test_levenberg_marquardt_fit
+  std::shared_ptr<FunctionValues> makeValues(const JointDomain &domain) {
+    auto values = std::make_shared<FunctionValues>(domain);
+    const double A0 = 1.0, B0 = -0.5;
+    size_t offset = 0;
+    for (size_t i = 0; i < domain.getNParts(); ++i) {
+      auto &d = static_cast<const FunctionDomain1D &>(domain.getDomain(i));
+      const double A = static_cast<double>(i), B = A + 1.0;
+      for (size_t k = 0; k < d.size(); ++k) {
+        const double x = d[k];
+        values->setFitData(offset + k, (A0 + B0 * x) * x * x + A + B * x);
+      }
+      offset += d.size();
+    }
+    values->setFitWeights(1);
+    return values;
+  }
+};
@@ -0,0 +1,75 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <cstdint>
+#include <vector>
+
+// forward declarations
+namespace H5 {
+class DataSet;
+} // namespace H5
+
+namespace Mantid {
+namespace DataHandling {
+
+/** CompressedDatasetReader : Reads part of a chunked, gzip-compressed,
+  one-dimensional HDF5 dataset in two steps, so that the decompression is not
+  serialized with the file access.
+
+  The constructor copies the compressed chunks covering the part from the
+  file with direct chunk reads, which bypass the HDF5 filter pipeline.
+  decompress() then inflates the chunks and converts the values, and may be
+  called concurrently from several threads for different ranges. Datasets
+  whose chunks use filters other than deflate and shuffle, or whose values
+  are not little-endian numbers, are not supported.
+*/
+class MANTID_DATAHANDLING_DLL CompressedDatasetReader {
+public:
+  static bool isSupported(const H5::DataSet &dataset);
+
+  CompressedDatasetReader(const H5::DataSet &dataset, const int64_t start,
+                          const int64_t size);
+
+  /// The number of values that are read
+  int64_t size() const { return m_size; }
+  /// The number of values in each chunk of the dataset
+  int64_t chunkSize() const { return m_chunkSize; }
+
+  template <typename T>
+  void decompress(T *out, const int64_t begin, const int64_t end) const;
+
+private:
+  /// The storage type of the values
+  enum class Type { Int8, Int16, Int32, Int64, UInt8, UInt16, UInt32, UInt64,
+                    Float32, Float64 };
+  /// A chunk as stored in the file
+  struct Chunk {
+    /// The index of the first value of the chunk in the dataset
+    int64_t offset;
+    /// Bit i is set if filter i of the pipeline was not applied
+    uint32_t filterMask;
+    std::vector<char> data;
+  };
+
+  std::vector<char> decode(const Chunk &chunk) const;
+
+  int64_t m_start;
+  int64_t m_size;
+  int64_t m_chunkSize;
+  Type m_type;
+  size_t m_valueSize;
+  /// The positions of the filters in the pipeline, or -1 if not used
+  int m_shuffleFilter{-1};
+  int m_deflateFilter{-1};
+  std::vector<Chunk> m_chunks;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
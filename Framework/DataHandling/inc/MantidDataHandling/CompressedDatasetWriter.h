@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <H5Cpp.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** CompressedDatasetWriter : Writes a one-dimensional, chunked and extendible
+  HDF5 dataset from consecutive blocks of values, so that the whole dataset
+  never has to be held in memory.
+
+  The full chunks of each block are shuffled and compressed with deflate in
+  parallel, then passed to HDF5 with direct chunk writes, which bypass its
+  single-threaded filter pipeline. Chunks that do not compress are stored as
+  they are. The dataset can be read back through HDF5 as any other shuffled
+  and deflated dataset. At most one incomplete chunk is buffered between
+  blocks; it is written when the writer is finished.
+*/
+class MANTID_DATAHANDLING_DLL CompressedDatasetWriter {
+public:
+  CompressedDatasetWriter(const H5::Group &group, const std::string &name,
+                          const H5::PredType &type, const hsize_t size,
+                          const hsize_t chunkSize, const int deflateLevel);
+
+  template <typename T> void write(const T *values, const size_t count);
+  void finish();
+
+  /// The dataset being written
+  H5::DataSet &dataSet() { return m_dataset; }
+
+private:
+  void writeChunks(const char *data, const size_t numChunks);
+
+  H5::DataSet m_dataset;
+  size_t m_valueSize;
+  hsize_t m_size;
+  hsize_t m_chunkSize;
+  /// The deflate level, or 0 to store the chunks uncompressed
+  int m_deflateLevel;
+  /// The number of values written in whole chunks
+  hsize_t m_written{0};
+  /// The values of the incomplete chunk
+  std::vector<char> m_pending;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
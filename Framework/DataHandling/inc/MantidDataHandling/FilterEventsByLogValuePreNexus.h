@@ -11,6 +11,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Events.h"
 #include "MantidKernel/BinaryFile.h"
+#include "MantidKernel/MappedBinaryFile.h"
 #include "MantidKernel/FileDescriptor.h"
 #include <fstream>
 #include <string>
@@ -128,7 +129,7 @@ private:
 
   void procEventsLinear(DataObjects::EventWorkspace_sptr &workspace,
                         std::vector<Types::Event::TofEvent> **arrayOfVectors,
-                        DasEvent *event_buffer,
+                        const DasEvent *event_buffer,
                         size_t current_event_buffer_size, size_t fileOffset);
 
   void setProtonCharge(DataObjects::EventWorkspace_sptr &workspace);
@@ -148,7 +149,7 @@ private:
   ///
   void filterEventsLinear(DataObjects::EventWorkspace_sptr &workspace,
                           std::vector<Types::Event::TofEvent> **arrayOfVectors,
-                          DasEvent *event_buffer,
+                          const DasEvent *event_buffer,
                           size_t current_event_buffer_size, size_t fileOffset);
 
   /// Correct wrong event indexes with pulse
@@ -186,7 +187,7 @@ private:
   Mantid::detid_t m_detid_max;
 
   /// Handles loading from the event file
-  std::unique_ptr<Mantid::Kernel::BinaryFile<DasEvent>> m_eventFile;
+  std::unique_ptr<Mantid::Kernel::MappedBinaryFile<DasEvent>> m_eventFile;
   std::size_t m_numEvents; ///< The number of events in the file
   std::size_t m_numPulses; ///< the number of pulses
   uint32_t m_numPixel;     ///< the number of pixels
@@ -8,6 +8,7 @@
 
 #include "MantidAPI/Progress.h"
 #include "MantidDataHandling/DllConfig.h"
+#include "MantidDataHandling/LogPredicateFilter.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadScheduler.h"
 
@@ -20,7 +21,12 @@ namespace DataHandling {
 class DefaultEventLoader;
 
 /** This task does the disk IO from loading the NXS file, and so will be on a
-  disk IO mutex
+  disk IO mutex.
+
+  If the event fields are gzip-compressed, the task only copies their
+  compressed chunks from the file, then schedules copies of itself without
+  the mutex that inflate the chunks in parallel before the events are
+  processed.
 */
 class MANTID_DATAHANDLING_DLL LoadBankFromDiskTask : public Kernel::Task {
 
@@ -45,8 +51,19 @@ private:
   std::unique_ptr<std::vector<uint32_t>> loadEventId(::NeXus::File &file);
   std::unique_ptr<std::vector<float>> loadTof(::NeXus::File &file);
   std::unique_ptr<std::vector<float>> loadEventWeights(::NeXus::File &file);
+  void findIdRange(const std::vector<uint32_t> &event_id);
+  bool selectEvents(std::vector<uint64_t> &event_index);
+  bool readCompressedEvents(::NeXus::File &file);
+  void scheduleDecompression(std::vector<uint64_t> event_index);
+  void decompressEvents();
+  void scheduleProcessing(std::shared_ptr<std::vector<uint32_t>> event_id,
+                          std::shared_ptr<std::vector<float>> event_tof,
+                          std::shared_ptr<std::vector<float>> event_weight,
+                          std::shared_ptr<std::vector<uint64_t>> event_index);
   int64_t recalculateDataSize(const int64_t &size);
 
+  struct CompressedBank;
+
   /// Algorithm being run
   DefaultEventLoader &m_loader;
   /// NXS path to bank
@@ -67,6 +84,9 @@ private:
   std::vector<int64_t> m_loadStart;
   /// How much to load in the file
   std::vector<int64_t> m_loadSize;
+  /// The ranges of events to read when filtering by log values, or empty to
+  /// read all m_loadSize events from m_loadStart
+  std::vector<LogPredicateFilter::Range> m_selectedEvents;
   /// Minimum pixel ID in this data
   uint32_t m_min_id;
   /// Maximum pixel ID in this data
@@ -75,6 +95,11 @@ private:
   bool m_have_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
+  /// The compressed events, if they are inflated by separate tasks
+  std::shared_ptr<CompressedBank> m_compressed;
+  /// The range of the events inflated by this task
+  int64_t m_decompressBegin{0};
+  int64_t m_decompressEnd{0};
 }; // END-DEF-CLASS LoadBankFromDiskTask
 
 } // namespace DataHandling
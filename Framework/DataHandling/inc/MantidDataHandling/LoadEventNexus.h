@@ -12,6 +12,7 @@
 #include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidDataHandling/LoadGeometry.h"
+#include "MantidDataHandling/LogPredicateFilter.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Events.h"
 #include "MantidGeometry/Instrument.h"
@@ -175,6 +176,8 @@ public:
   Mantid::Types::Core::DateAndTime filter_time_start;
   /// Filter by stop time
   Mantid::Types::Core::DateAndTime filter_time_stop;
+  /// Filter by the values of logs at the pulse times, null if not filtering
+  std::unique_ptr<LogPredicateFilter> m_logFilter;
 
   /// Mutex protecting tof limits
   std::mutex m_tofMutex;
@@ -11,6 +11,7 @@
 #include "MantidDataObjects/Events.h"
 #include "MantidKernel/BinaryFile.h"
 #include "MantidKernel/FileDescriptor.h"
+#include "MantidKernel/MappedBinaryFile.h"
 #include <fstream>
 #include <string>
 #include <vector>
@@ -128,7 +129,7 @@ private:
   Mantid::detid_t detid_max;
 
   /// Handles loading from the event file
-  std::unique_ptr<Mantid::Kernel::BinaryFile<DasEvent>> eventfile;
+  std::unique_ptr<Mantid::Kernel::MappedBinaryFile<DasEvent>> eventfile;
   std::size_t num_events; ///< The number of events in the file
   std::size_t num_pulses; ///< the number of pulses
   uint32_t numpixel;      ///< the number of pixels
@@ -168,6 +169,16 @@ private:
 
   /// Whether or not the pulse times are sorted in increasing order.
   bool pulsetimesincreasing;
+  /// Whether or not the event indices are sorted, so that the pulse of an
+  /// event can be found by a binary search
+  bool eventindicesincreasing{false};
+
+  /// Whether the events are limited to the pulses in a time window
+  bool m_timeFiltered{false};
+  /// The start of the time window, if filtering by time
+  Types::Core::DateAndTime m_filterTimeStart;
+  /// The end of the time window, if filtering by time
+  Types::Core::DateAndTime m_filterTimeStop;
 
   /// sample environment event
   std::vector<detid_t> mSEids;
@@ -187,6 +198,8 @@ private:
 
   void readPulseidFile(const std::string &filename, const bool throwError);
 
+  void selectTimeWindow();
+
   void runLoadInstrument(const std::string &eventfilename,
                          const API::MatrixWorkspace_sptr &localWorkspace);
 
@@ -196,7 +209,7 @@ private:
 
   void procEventsLinear(DataObjects::EventWorkspace_sptr &workspace,
                         std::vector<Types::Event::TofEvent> **arrayOfVectors,
-                        DasEvent *event_buffer,
+                        const DasEvent *event_buffer,
                         size_t current_event_buffer_size, size_t fileOffset,
                         bool dbprint);
 
@@ -78,6 +78,9 @@ public:
   /// Returns a confidence value that this algorithm can load a file
   int confidence(Kernel::NexusDescriptor &descriptor) const override;
 
+  /// Set the size in bytes of the slabs the detector counts are read in
+  void setLoadBlockBytes(const int64_t bytes) { m_loadBlockBytes = bytes; }
+
   /// Spectra block descriptor
   struct SpectraBlock {
     /// Constructor - initialize the block
@@ -115,11 +118,14 @@ private:
   void loadPeriodData(int64_t period, Mantid::NeXus::NXEntry &entry,
                       DataObjects::Workspace2D_sptr &local_workspace,
                       bool update_spectra2det_mapping = false);
-  // Load a data block
-  void loadBlock(Mantid::NeXus::NXDataSetTyped<int> &data, int64_t blocksize,
-                 int64_t period, int64_t start, int64_t &hist,
-                 int64_t &spec_num,
-                 DataObjects::Workspace2D_sptr &local_workspace);
+  // Load the spectra of a block of detectors
+  void loadDetectorBlock(Mantid::NeXus::NXData &nxdata, int64_t period,
+                         int64_t start, int64_t numSpectra, int64_t &hist,
+                         DataObjects::Workspace2D &local_workspace);
+  // Copy the counts of a slab of spectra read from the file
+  void copyBlock(const Mantid::NeXus::NXDataSetTyped<int> &data,
+                 int64_t blocksize, int64_t hist,
+                 DataObjects::Workspace2D &local_workspace);
 
   // Create period logs
   void createPeriodLogs(int64_t period,
@@ -165,6 +171,8 @@ private:
   int64_t m_entrynumber;
   /// List of disjoint data blocks to load
   std::vector<SpectraBlock> m_spectraBlocks;
+  /// The counts of detectors are read in slabs of about this many bytes
+  int64_t m_loadBlockBytes;
   /// Time channels
   std::shared_ptr<HistogramData::HistogramX> m_tof_data;
   /// Spectra numbers
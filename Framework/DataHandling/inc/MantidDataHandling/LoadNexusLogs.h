@@ -77,15 +77,15 @@ private:
                 const std::shared_ptr<API::MatrixWorkspace> &workspace) const;
 
   /**
-   * Load an NXlog entry
+   * Load NXlog entries, converting them to properties in parallel
    * @param file input Nexus file handler
-   * @param absolute_entry_name full entry name in Nexus
-   * @param entry_class type of the entry (NXlog)
+   * @param entries full entry names in Nexus and their types (NXlog)
    * @param workspace input workspace
    */
-  void loadNXLog(::NeXus::File &file, const std::string &absolute_entry_name,
-                 const std::string &entry_class,
-                 const std::shared_ptr<API::MatrixWorkspace> &workspace) const;
+  void
+  loadNXLogs(::NeXus::File &file,
+             const std::vector<std::pair<std::string, std::string>> &entries,
+             const std::shared_ptr<API::MatrixWorkspace> &workspace) const;
 
   /**
    * Load an IXseblock entry
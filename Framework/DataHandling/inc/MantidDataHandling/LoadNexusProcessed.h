@@ -12,6 +12,7 @@
 #include "MantidAPI/IFileLoader.h"
 #include "MantidAPI/ITableWorkspace_fwd.h"
 #include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidDataObjects/LazyWorkspace2D.h"
 #include "MantidHistogramData/BinEdges.h"
 #include "MantidKernel/NexusDescriptor.h"
 #include "MantidKernel/cow_ptr.h"
@@ -233,6 +234,11 @@ private:
 
   // Handle to the NeXus file
   std::unique_ptr<::NeXus::File> m_nexusFile;
+
+  /// Flag set if the spectra of a single Workspace2D are read on access
+  bool m_lazy;
+  /// The reader of the spectra, attached once the file is closed
+  std::unique_ptr<DataObjects::LazyWorkspace2D::BlockReader> m_lazyReader;
 };
 /// to sort the algorithmhistory vector
 bool UDlesserExecCount(const Mantid::NeXus::NXClassInfo &elem1,
@@ -0,0 +1,37 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidDataHandling/DllConfig.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+/** LoadPublishedWorkspace : Loads a workspace that another Mantid process has
+  published to shared memory with PublishWorkspace.
+*/
+class MANTID_DATAHANDLING_DLL LoadPublishedWorkspace : public API::Algorithm {
+public:
+  const std::string name() const override { return "LoadPublishedWorkspace"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "DataHandling"; }
+  const std::string summary() const override {
+    return "Loads a workspace published to shared memory by another Mantid "
+           "process.";
+  }
+  const std::vector<std::string> seeAlso() const override {
+    return {"PublishWorkspace", "UnpublishWorkspace"};
+  }
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
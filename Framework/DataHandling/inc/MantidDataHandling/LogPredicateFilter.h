@@ -0,0 +1,96 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class BankPulseTimes;
+
+namespace Mantid {
+namespace API {
+class Run;
+}
+namespace DataHandling {
+
+/** LogPredicateFilter : Selects the pulses of a run at which the values of
+  some of its logs satisfy a set of predicates, such as "SampleTemp>=290".
+
+  The value of a log at a pulse is the last value recorded at or before the
+  pulse time, or the first value for pulses before the log starts. A pulse is
+  accepted if all of the predicates hold. The accepted pulses of a bank can be
+  turned into the ranges of its events to read, so that the events of the
+  rejected pulses are never loaded, and the logs of the run can be cut down to
+  the accepted pulses.
+*/
+class MANTID_DATAHANDLING_DLL LogPredicateFilter {
+public:
+  /// A comparison of the value of a log with a constant
+  struct Predicate {
+    enum class Comparison {
+      Less,
+      LessEqual,
+      Greater,
+      GreaterEqual,
+      Equal,
+      NotEqual
+    };
+    std::string logName;
+    Comparison comparison;
+    double value;
+    bool test(const double logValue) const;
+  };
+
+  /// A half-open range [first, second) of indices
+  using Range = std::pair<uint64_t, uint64_t>;
+
+  /// The events of a bank to read and their index in the loaded events
+  struct EventSelection {
+    /// The ranges of events to read, in increasing order
+    std::vector<Range> ranges;
+    /// The index of the first loaded event of each pulse
+    std::vector<uint64_t> eventIndex;
+    /// The total number of events to read
+    uint64_t numberOfEvents = 0;
+  };
+
+  static Predicate parse(const std::string &predicate);
+
+  LogPredicateFilter(const std::vector<std::string> &predicates,
+                     const API::Run &run);
+
+  std::vector<Range> acceptedPulses(const BankPulseTimes &pulseTimes) const;
+
+  void filterRun(API::Run &run, const BankPulseTimes &pulseTimes) const;
+
+  static EventSelection selectEvents(const std::vector<Range> &pulses,
+                                     const std::vector<uint64_t> &eventIndex,
+                                     const uint64_t startEvent,
+                                     const uint64_t stopEvent);
+
+private:
+  /// The values of a log and the predicates using it
+  struct Log {
+    std::vector<int64_t> times;
+    std::vector<double> values;
+    std::vector<Predicate> predicates;
+  };
+  std::vector<Log> m_logs;
+  /// The accepted pulses of each set of pulse times, which are usually shared
+  /// by many banks
+  mutable std::map<const BankPulseTimes *, std::vector<Range>> m_accepted;
+  mutable std::mutex m_mutex;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
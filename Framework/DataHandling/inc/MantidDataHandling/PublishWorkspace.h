@@ -0,0 +1,38 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidDataHandling/DllConfig.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+/** PublishWorkspace : Publishes a Workspace2D or an EventWorkspace to shared
+  memory so that other Mantid processes can load it by name without reading
+  a file.
+*/
+class MANTID_DATAHANDLING_DLL PublishWorkspace : public API::Algorithm {
+public:
+  const std::string name() const override { return "PublishWorkspace"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "DataHandling"; }
+  const std::string summary() const override {
+    return "Publishes a workspace to shared memory for other Mantid "
+           "processes to load.";
+  }
+  const std::vector<std::string> seeAlso() const override {
+    return {"LoadPublishedWorkspace", "UnpublishWorkspace"};
+  }
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
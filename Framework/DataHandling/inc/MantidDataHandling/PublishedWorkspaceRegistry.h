@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** PublishedWorkspaceRegistry : A file listing the workspaces that have been
+  published to shared memory by the Mantid processes of a user, so that other
+  processes can find them by name.
+
+  Each line of the file holds the name, the shared memory segment and the
+  workspace ID of one workspace. The file is locked while it is read or
+  changed, so any number of processes may use it at the same time, and it is
+  replaced as a whole so that it is never seen half written. Its location is
+  set by the publishedworkspaces.registry property and defaults to the
+  application data directory of the user.
+*/
+class MANTID_DATAHANDLING_DLL PublishedWorkspaceRegistry {
+public:
+  /// A published workspace
+  struct Entry {
+    std::string name;
+    std::string segment;
+    std::string workspaceID;
+  };
+
+  static std::string defaultFilename();
+
+  explicit PublishedWorkspaceRegistry(
+      const std::string &filename = defaultFilename());
+
+  const std::string &filename() const { return m_filename; }
+  void add(const Entry &entry) const;
+  bool replace(const Entry &entry, Entry &replaced) const;
+  bool remove(const std::string &name) const;
+  bool remove(const std::string &name, Entry &removed) const;
+  bool find(const std::string &name, Entry &entry) const;
+  std::vector<Entry> entries() const;
+
+private:
+  std::vector<Entry> read() const;
+  void write(const std::vector<Entry> &entries) const;
+
+  /// The full path to the registry file
+  const std::string m_filename;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
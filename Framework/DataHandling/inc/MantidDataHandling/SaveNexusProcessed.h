@@ -13,6 +13,11 @@
 #include <climits>
 #include <nexus/NeXusFile.hpp>
 
+// forward declarations
+namespace H5 {
+class Group;
+} // namespace H5
+
 namespace Mantid {
 namespace NeXus {
 class NexusFileIO;
@@ -78,13 +83,27 @@ private:
       std::vector<int> &indices,
       const Mantid::API::MatrixWorkspace_const_sptr &matrixWorkspace);
 
-  template <class T>
-  static void appendEventListData(const std::vector<T> &events, size_t offset,
-                                  double *tofs, float *weights,
-                                  float *errorSquareds, int64_t *pulsetimes);
+  template <class T, typename TofType>
+  static void appendEventListData(const std::vector<T> &events, size_t begin,
+                                  size_t end, size_t offset, TofType *tofs,
+                                  float *weights, float *errorSquareds,
+                                  int64_t *pulsetimes);
 
   void execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
                  const bool uniformSpectra, const std::vector<int> &spec);
+  void writeEventArrays(Mantid::NeXus::NexusFileIO *nexusFile,
+                        std::vector<int64_t> &indices, const bool compress);
+  bool writeEventsInChunks(const Mantid::NeXus::NexusFileIO &nexusFile,
+                           std::vector<int64_t> &indices, const bool compress);
+  template <typename TofType>
+  void writeEventBlocks(const H5::Group &group,
+                        const std::vector<int64_t> &indices,
+                        const bool compress);
+  template <typename TofType>
+  void copyEvents(const std::vector<int64_t> &indices, const int64_t begin,
+                  const int64_t end, TofType *tofs, float *weights,
+                  float *errorSquareds, int64_t *pulsetimes);
+  bool tofsFitInFloat() const;
   /// sets non workspace properties for the algorithm
   void setOtherProperties(IAlgorithm *alg, const std::string &propertyName,
                           const std::string &propertyValue,
@@ -0,0 +1,113 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IEventList.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidDataHandling/PublishedWorkspaceRegistry.h"
+#include "MantidDataObjects/Events.h"
+#include "MantidGeometry/IDTypes.h"
+#include "MantidTypes/Event/TofEvent.h"
+
+#include <memory>
+#include <string>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** SharedMemoryWorkspace : A read-only view of a Workspace2D or an
+  EventWorkspace that has been published to a named shared memory segment.
+
+  Publishing copies the data of every spectrum, the spectrum numbers and
+  detector IDs, the units and title, the logs of the run, and the definition
+  of the instrument with its parameters, calibrated positions and masking into
+  a new segment, and adds it to a PublishedWorkspaceRegistry. Any process of
+  the same user can then attach to the segment by the published name and read
+  the arrays in place, without copying or parsing them. createWorkspace()
+  makes an ordinary workspace from the view with a single copy of each array
+  and setInstrument() gives it the published instrument.
+
+  Numeric and boolean time series logs keep their value type, with the values
+  stored as doubles, and other time series are published as strings. Single
+  valued logs keep their type if it is double or int and are otherwise
+  published as strings.
+
+  The segment stays until it is removed with unpublish(), even if the
+  publishing process exits. Each publication writes a segment with a new
+  name and then points the registry entry at it, so a process attaching
+  while a workspace is published again sees either the old or the new
+  workspace. Processes that are attached when it is removed or published
+  again keep the data that they have attached to.
+*/
+class MANTID_DATAHANDLING_DLL SharedMemoryWorkspace {
+public:
+  /// A read-only array in the shared memory
+  template <typename T> class Array {
+  public:
+    Array() = default;
+    Array(const T *data, size_t size) : m_data(data), m_size(size) {}
+    const T *begin() const { return m_data; }
+    const T *end() const { return m_data + m_size; }
+    const T *data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const T &operator[](size_t index) const { return m_data[index]; }
+
+  private:
+    const T *m_data = nullptr;
+    size_t m_size = 0;
+  };
+
+  static void publish(const API::MatrixWorkspace &workspace,
+                      const std::string &name,
+                      const PublishedWorkspaceRegistry &registry);
+  static bool unpublish(const std::string &name,
+                        const PublishedWorkspaceRegistry &registry);
+
+  SharedMemoryWorkspace(const std::string &name,
+                        const PublishedWorkspaceRegistry &registry);
+  ~SharedMemoryWorkspace();
+
+  const std::string &name() const { return m_name; }
+  bool isEventWorkspace() const;
+  API::EventType getEventType() const;
+  size_t getNumberHistograms() const;
+
+  Array<double> x(size_t index) const;
+  Array<double> y(size_t index) const;
+  Array<double> e(size_t index) const;
+  Array<Types::Event::TofEvent> tofEvents(size_t index) const;
+  Array<DataObjects::WeightedEvent> weightedEvents(size_t index) const;
+  specnum_t spectrumNumber(size_t index) const;
+  Array<detid_t> detectorIDs(size_t index) const;
+
+  std::string title() const;
+  std::string xUnitID() const;
+  std::string yUnitLabel() const;
+  bool isDistribution() const;
+  std::string instrumentName() const;
+  std::string instrumentFilename() const;
+  std::string instrumentXML() const;
+  std::string instrumentParameters() const;
+
+  API::MatrixWorkspace_sptr createWorkspace() const;
+  void setInstrument(API::MatrixWorkspace &workspace) const;
+
+private:
+  struct Segment;
+  std::string string(const char *name) const;
+  void addLogs(API::MatrixWorkspace &workspace) const;
+
+  /// The published name of the workspace
+  const std::string m_name;
+  /// The attached segment
+  std::unique_ptr<Segment> m_segment;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -0,0 +1,36 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidDataHandling/DllConfig.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+/** UnpublishWorkspace : Removes a workspace published to shared memory with
+  PublishWorkspace.
+*/
+class MANTID_DATAHANDLING_DLL UnpublishWorkspace : public API::Algorithm {
+public:
+  const std::string name() const override { return "UnpublishWorkspace"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "DataHandling"; }
+  const std::string summary() const override {
+    return "Removes a workspace published to shared memory.";
+  }
+  const std::vector<std::string> seeAlso() const override {
+    return {"PublishWorkspace", "LoadPublishedWorkspace"};
+  }
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -0,0 +1,284 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/CompressedDatasetReader.h"
+
+#include <H5Cpp.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+/// Direct chunk reads were added in HDF5 1.10.3
+#if H5_VERSION_GE(1, 10, 3)
+constexpr bool DIRECT_CHUNK_READS = true;
+#else
+constexpr bool DIRECT_CHUNK_READS = false;
+#endif
+
+/**
+ * Find the positions of the shuffle and deflate filters in the pipeline of a
+ * dataset
+ * @param plist :: The creation property list of the dataset
+ * @param shuffle :: Set to the position of the shuffle filter, or -1
+ * @param deflate :: Set to the position of the deflate filter, or -1
+ * @returns False if the pipeline contains any other filter, or shuffles after
+ * deflating
+ */
+bool findFilters(const H5::DSetCreatPropList &plist, int &shuffle,
+                 int &deflate) {
+  shuffle = -1;
+  deflate = -1;
+  const int numFilters = plist.getNfilters();
+  for (int i = 0; i < numFilters; ++i) {
+    unsigned int flags;
+    size_t numValues = 0;
+    char name[64];
+    unsigned int config;
+    const auto filter = plist.getFilter(i, flags, numValues, nullptr,
+                                        sizeof(name), name, config);
+    if (filter == H5Z_FILTER_SHUFFLE && deflate < 0)
+      shuffle = i;
+    else if (filter == H5Z_FILTER_DEFLATE)
+      deflate = i;
+    else
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+/**
+ * Check whether part of a dataset can be read by this class
+ * @param dataset :: An open dataset
+ * @returns True if the dataset is one-dimensional, chunked, compressed with
+ * deflate and possibly shuffled, and holds little-endian numbers
+ */
+bool CompressedDatasetReader::isSupported(const H5::DataSet &dataset) {
+  if (!DIRECT_CHUNK_READS)
+    return false;
+  if (dataset.getSpace().getSimpleExtentNdims() != 1)
+    return false;
+  const auto plist = dataset.getCreatePlist();
+  if (plist.getLayout() != H5D_CHUNKED)
+    return false;
+  int shuffle, deflate;
+  if (!findFilters(plist, shuffle, deflate) || deflate < 0)
+    return false;
+  const auto typeClass = dataset.getTypeClass();
+  if (typeClass == H5T_INTEGER)
+    return dataset.getIntType().getOrder() == H5T_ORDER_LE;
+  if (typeClass == H5T_FLOAT) {
+    const auto type = dataset.getFloatType();
+    return type.getOrder() == H5T_ORDER_LE &&
+           (type.getSize() == 4 || type.getSize() == 8);
+  }
+  return false;
+}
+
+/**
+ * Read the compressed chunks covering part of a dataset from the file
+ * @param dataset :: An open dataset, for which isSupported() is true
+ * @param start :: The index of the first value to read
+ * @param size :: The number of values to read
+ * @throws std::invalid_argument if the dataset is not supported or is too
+ * small, or std::runtime_error if a chunk has not been written
+ */
+CompressedDatasetReader::CompressedDatasetReader(const H5::DataSet &dataset,
+                                                 const int64_t start,
+                                                 const int64_t size)
+    : m_start(start), m_size(size) {
+  if (!isSupported(dataset))
+    throw std::invalid_argument("The dataset is not a compressed, chunked, "
+                                "one-dimensional array of numbers");
+  const auto plist = dataset.getCreatePlist();
+  findFilters(plist, m_shuffleFilter, m_deflateFilter);
+  hsize_t chunkDims[1];
+  plist.getChunk(1, chunkDims);
+  m_chunkSize = static_cast<int64_t>(chunkDims[0]);
+
+  hsize_t dims[1];
+  dataset.getSpace().getSimpleExtentDims(dims);
+  if (start < 0 || size < 0 || start + size > static_cast<int64_t>(dims[0]))
+    throw std::invalid_argument("The dataset holds only " +
+                                std::to_string(dims[0]) + " values");
+
+  const auto type = dataset.getDataType();
+  m_valueSize = type.getSize();
+  if (type.getClass() == H5T_FLOAT) {
+    m_type = m_valueSize == 4 ? Type::Float32 : Type::Float64;
+  } else {
+    const bool isSigned = dataset.getIntType().getSign() != H5T_SGN_NONE;
+    switch (m_valueSize) {
+    case 1:
+      m_type = isSigned ? Type::Int8 : Type::UInt8;
+      break;
+    case 2:
+      m_type = isSigned ? Type::Int16 : Type::UInt16;
+      break;
+    case 4:
+      m_type = isSigned ? Type::Int32 : Type::UInt32;
+      break;
+    case 8:
+      m_type = isSigned ? Type::Int64 : Type::UInt64;
+      break;
+    default:
+      throw std::invalid_argument("Unsupported integer size " +
+                                  std::to_string(m_valueSize));
+    }
+  }
+
+#if H5_VERSION_GE(1, 10, 3)
+  if (size == 0)
+    return;
+  const int64_t first = start / m_chunkSize;
+  const int64_t last = (start + size - 1) / m_chunkSize;
+  m_chunks.resize(static_cast<size_t>(last - first + 1));
+  for (int64_t i = first; i <= last; ++i) {
+    auto &chunk = m_chunks[static_cast<size_t>(i - first)];
+    chunk.offset = i * m_chunkSize;
+    hsize_t offset[1] = {static_cast<hsize_t>(chunk.offset)};
+    hsize_t bytes = 0;
+    if (H5Dget_chunk_storage_size(dataset.getId(), offset, &bytes) < 0 ||
+        bytes == 0)
+      throw std::runtime_error("Chunk at " + std::to_string(chunk.offset) +
+                               " has not been written");
+    chunk.data.resize(static_cast<size_t>(bytes));
+    if (H5Dread_chunk(dataset.getId(), H5P_DEFAULT, offset, &chunk.filterMask,
+                      chunk.data.data()) < 0)
+      throw std::runtime_error("Failed to read the chunk at " +
+                               std::to_string(chunk.offset));
+  }
+#endif
+}
+
+/**
+ * Undo the filters applied to a chunk
+ * @param chunk :: The chunk as stored in the file
+ * @returns The values of the chunk, in the storage type
+ */
+std::vector<char> CompressedDatasetReader::decode(const Chunk &chunk) const {
+  const size_t bytes = static_cast<size_t>(m_chunkSize) * m_valueSize;
+  std::vector<char> values(bytes);
+  if (chunk.filterMask & (1u << m_deflateFilter)) {
+    // Stored without compression
+    if (chunk.data.size() != bytes)
+      throw std::runtime_error("Chunk at " + std::to_string(chunk.offset) +
+                               " has an unexpected size");
+    std::copy(chunk.data.cbegin(), chunk.data.cend(), values.begin());
+  } else {
+    uLongf length = static_cast<uLongf>(bytes);
+    const auto status = uncompress(
+        reinterpret_cast<Bytef *>(values.data()), &length,
+        reinterpret_cast<const Bytef *>(chunk.data.data()),
+        static_cast<uLong>(chunk.data.size()));
+    if (status != Z_OK || length != bytes)
+      throw std::runtime_error("Failed to inflate the chunk at " +
+                               std::to_string(chunk.offset));
+  }
+  if (m_shuffleFilter >= 0 && !(chunk.filterMask & (1u << m_shuffleFilter))) {
+    // The shuffle filter stores byte b of value i at b * count + i
+    std::vector<char> shuffled(bytes);
+    std::swap(values, shuffled);
+    const auto count = static_cast<size_t>(m_chunkSize);
+    for (size_t b = 0; b < m_valueSize; ++b) {
+      const char *in = shuffled.data() + b * count;
+      for (size_t i = 0; i < count; ++i)
+        values[i * m_valueSize + b] = in[i];
+    }
+  }
+  return values;
+}
+
+namespace {
+/// Convert little-endian values of type S to T
+template <typename S, typename T>
+void convertValues(const char *in, const size_t count, T *out) {
+  for (size_t i = 0; i < count; ++i) {
+    S value;
+    std::memcpy(&value, in + i * sizeof(S), sizeof(S));
+    out[i] = static_cast<T>(value);
+  }
+}
+} // namespace
+
+/**
+ * Inflate and convert a range of the values that were read. This can be
+ * called concurrently for different ranges.
+ * @param out :: Receives end - begin values
+ * @param begin :: The first value, relative to the start of the part read
+ * @param end :: One past the last value, relative to the start of the part
+ * read
+ */
+template <typename T>
+void CompressedDatasetReader::decompress(T *out, const int64_t begin,
+                                         const int64_t end) const {
+  if (begin < 0 || end > m_size || begin > end)
+    throw std::out_of_range("Invalid range of compressed values");
+  for (const auto &chunk : m_chunks) {
+    // The values of the chunk within the requested range, in dataset indices
+    const int64_t from = std::max(chunk.offset, m_start + begin);
+    const int64_t to = std::min(chunk.offset + m_chunkSize, m_start + end);
+    if (from >= to)
+      continue;
+    const auto values = decode(chunk);
+    const char *in =
+        values.data() + static_cast<size_t>(from - chunk.offset) * m_valueSize;
+    T *dest = out + (from - m_start - begin);
+    const auto count = static_cast<size_t>(to - from);
+    switch (m_type) {
+    case Type::Int8:
+      convertValues<int8_t>(in, count, dest);
+      break;
+    case Type::Int16:
+      convertValues<int16_t>(in, count, dest);
+      break;
+    case Type::Int32:
+      convertValues<int32_t>(in, count, dest);
+      break;
+    case Type::Int64:
+      convertValues<int64_t>(in, count, dest);
+      break;
+    case Type::UInt8:
+      convertValues<uint8_t>(in, count, dest);
+      break;
+    case Type::UInt16:
+      convertValues<uint16_t>(in, count, dest);
+      break;
+    case Type::UInt32:
+      convertValues<uint32_t>(in, count, dest);
+      break;
+    case Type::UInt64:
+      convertValues<uint64_t>(in, count, dest);
+      break;
+    case Type::Float32:
+      convertValues<float>(in, count, dest);
+      break;
+    case Type::Float64:
+      convertValues<double>(in, count, dest);
+      break;
+    }
+  }
+}
+
+template MANTID_DATAHANDLING_DLL void
+CompressedDatasetReader::decompress<uint32_t>(uint32_t *, const int64_t,
+                                              const int64_t) const;
+template MANTID_DATAHANDLING_DLL void
+CompressedDatasetReader::decompress<float>(float *, const int64_t,
+                                           const int64_t) const;
+template MANTID_DATAHANDLING_DLL void
+CompressedDatasetReader::decompress<double>(double *, const int64_t,
+                                            const int64_t) const;
+
+} // namespace DataHandling
+} // namespace Mantid
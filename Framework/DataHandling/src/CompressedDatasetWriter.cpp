@@ -0,0 +1,168 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/CompressedDatasetWriter.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataHandling {
+
+/**
+ * Create the dataset
+ * @param group :: The group to create the dataset in
+ * @param name :: The name of the dataset
+ * @param type :: The type of the values, in native byte order
+ * @param size :: The number of values that will be written
+ * @param chunkSize :: The number of values in each chunk
+ * @param deflateLevel :: The deflate level from 1 to 9, or 0 to store the
+ * chunks uncompressed
+ */
+CompressedDatasetWriter::CompressedDatasetWriter(
+    const H5::Group &group, const std::string &name, const H5::PredType &type,
+    const hsize_t size, const hsize_t chunkSize, const int deflateLevel)
+    : m_valueSize(type.getSize()), m_size(size),
+      m_chunkSize(std::max<hsize_t>(chunkSize, 1)),
+      m_deflateLevel(deflateLevel) {
+#if !H5_VERSION_GE(1, 10, 3)
+  throw std::runtime_error("Direct chunk writes require HDF5 1.10.3");
+#endif
+  if (deflateLevel < 0 || deflateLevel > 9)
+    throw std::invalid_argument("The deflate level must be between 0 and 9");
+  const hsize_t dims[1] = {size};
+  const hsize_t maxDims[1] = {H5S_UNLIMITED};
+  const hsize_t chunkDims[1] = {m_chunkSize};
+  H5::DSetCreatPropList plist;
+  plist.setChunk(1, chunkDims);
+  if (m_deflateLevel > 0) {
+    plist.setShuffle();
+    plist.setDeflate(m_deflateLevel);
+  }
+  m_dataset = group.createDataSet(name, type, H5::DataSpace(1, dims, maxDims),
+                                  plist);
+  m_pending.reserve(static_cast<size_t>(m_chunkSize) * m_valueSize);
+}
+
+/**
+ * Append values to the dataset. The whole chunks are compressed in parallel
+ * and written straight away, and the rest is kept until the next call.
+ * @param values :: The values, of the type given on construction
+ * @param count :: The number of values
+ */
+template <typename T>
+void CompressedDatasetWriter::write(const T *values, const size_t count) {
+  if (sizeof(T) != m_valueSize)
+    throw std::invalid_argument("The values do not match the dataset type");
+  if (m_written + m_pending.size() / m_valueSize + count > m_size)
+    throw std::out_of_range("More values written than the dataset holds");
+  const char *data = reinterpret_cast<const char *>(values);
+  size_t bytes = count * m_valueSize;
+  const size_t chunkBytes = static_cast<size_t>(m_chunkSize) * m_valueSize;
+
+  // Complete the pending chunk first
+  if (!m_pending.empty()) {
+    const size_t fill = std::min(bytes, chunkBytes - m_pending.size());
+    m_pending.insert(m_pending.end(), data, data + fill);
+    data += fill;
+    bytes -= fill;
+    if (m_pending.size() < chunkBytes)
+      return;
+    writeChunks(m_pending.data(), 1);
+    m_pending.clear();
+  }
+  const size_t numChunks = bytes / chunkBytes;
+  writeChunks(data, numChunks);
+  m_pending.assign(data + numChunks * chunkBytes, data + bytes);
+}
+
+/**
+ * Write the incomplete chunk, padded to the chunk size. HDF5 ignores the
+ * values beyond the size of the dataset.
+ * @throws std::runtime_error if fewer values were written than the size of
+ * the dataset
+ */
+void CompressedDatasetWriter::finish() {
+  if (!m_pending.empty()) {
+    m_pending.resize(static_cast<size_t>(m_chunkSize) * m_valueSize, 0);
+    writeChunks(m_pending.data(), 1);
+    m_pending.clear();
+  }
+  if (m_written < m_size)
+    throw std::runtime_error("Only " + std::to_string(m_written) + " of " +
+                             std::to_string(m_size) +
+                             " values were written to " +
+                             m_dataset.getObjName());
+}
+
+/**
+ * Compress whole chunks in parallel and write them in order
+ * @param data :: The values of the chunks
+ * @param numChunks :: The number of chunks
+ */
+void CompressedDatasetWriter::writeChunks(const char *data,
+                                          const size_t numChunks) {
+  if (numChunks == 0)
+    return;
+  const size_t chunkBytes = static_cast<size_t>(m_chunkSize) * m_valueSize;
+  std::vector<std::vector<char>> compressed(m_deflateLevel > 0 ? numChunks
+                                                               : 0);
+  if (m_deflateLevel > 0) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(numChunks); ++i) {
+      const char *in = data + static_cast<size_t>(i) * chunkBytes;
+      // The shuffle filter stores byte b of value j at b * count + j
+      const auto count = static_cast<size_t>(m_chunkSize);
+      std::vector<char> shuffled(chunkBytes);
+      for (size_t b = 0; b < m_valueSize; ++b) {
+        char *out = shuffled.data() + b * count;
+        for (size_t j = 0; j < count; ++j)
+          out[j] = in[j * m_valueSize + b];
+      }
+      auto &chunk = compressed[static_cast<size_t>(i)];
+      uLongf length = compressBound(static_cast<uLong>(chunkBytes));
+      chunk.resize(length);
+      if (compress2(reinterpret_cast<Bytef *>(chunk.data()), &length,
+                    reinterpret_cast<const Bytef *>(shuffled.data()),
+                    static_cast<uLong>(chunkBytes), m_deflateLevel) == Z_OK &&
+          length < chunkBytes)
+        chunk.resize(length);
+      else
+        chunk.clear();
+    }
+  }
+
+#if H5_VERSION_GE(1, 10, 3)
+  for (size_t i = 0; i < numChunks; ++i) {
+    const hsize_t offset[1] = {m_written};
+    const bool isCompressed = m_deflateLevel > 0 && !compressed[i].empty();
+    // Bits 0 and 1 mark the shuffle and deflate filters as not applied
+    const uint32_t filterMask = m_deflateLevel > 0 && !isCompressed ? 3 : 0;
+    const char *chunk =
+        isCompressed ? compressed[i].data() : data + i * chunkBytes;
+    const size_t size = isCompressed ? compressed[i].size() : chunkBytes;
+    if (H5Dwrite_chunk(m_dataset.getId(), H5P_DEFAULT, filterMask, offset,
+                       size, chunk) < 0)
+      throw std::runtime_error("Failed to write a chunk of " +
+                               m_dataset.getObjName());
+    m_written = std::min(m_written + m_chunkSize, m_size);
+  }
+#endif
+}
+
+template MANTID_DATAHANDLING_DLL void
+CompressedDatasetWriter::write<double>(const double *, const size_t);
+template MANTID_DATAHANDLING_DLL void
+CompressedDatasetWriter::write<float>(const float *, const size_t);
+template MANTID_DATAHANDLING_DLL void
+CompressedDatasetWriter::write<int64_t>(const int64_t *, const size_t);
+
+} // namespace DataHandling
+} // namespace Mantid
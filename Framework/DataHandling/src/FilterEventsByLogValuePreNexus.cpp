@@ -910,7 +910,6 @@ void FilterEventsByLogValuePreNexus::procEvents(
   //--------------------------------------------------------------------
   // Vector of partial workspaces, for parallel processing.
   std::vector<EventWorkspace_sptr> partWorkspaces;
-  std::vector<DasEvent *> buffers;
 
   /// Pointer to the vector of events
   using EventVector_pt = std::vector<TofEvent> *;
@@ -923,7 +922,6 @@ void FilterEventsByLogValuePreNexus::procEvents(
     numThreads = size_t(PARALLEL_GET_MAX_THREADS);
 
   partWorkspaces.resize(numThreads);
-  buffers.resize(numThreads);
   eventVectors = new EventVector_pt *[numThreads];
 
   // Processing by number of threads
@@ -947,9 +945,6 @@ void FilterEventsByLogValuePreNexus::procEvents(
       } else
         partWS = workspace;
 
-      // Allocate the buffers
-      buffers[i] = new DasEvent[loadBlockSize];
-
       // For each partial workspace, make an array where index = detector ID and
       // value = pointer to the events vector
       eventVectors[i] = new EventVector_pt[m_detid_max + 1];
@@ -983,9 +978,6 @@ void FilterEventsByLogValuePreNexus::procEvents(
       } else
         ws = workspace;
 
-      // Get the buffer (for this thread)
-      DasEvent *event_buffer = buffers[threadNum];
-
       // Get the speeding-up array of vector<tofEvent> where index = detid.
       EventVector_pt *theseEventVectors = eventVectors[threadNum];
 
@@ -997,11 +989,9 @@ void FilterEventsByLogValuePreNexus::procEvents(
               ? (m_maxNumEvents - (numBlocks - 1) * loadBlockSize)
               : loadBlockSize;
 
-      // Load this chunk of event data (critical block)
-      PARALLEL_CRITICAL(FilterEventsByLogValuePreNexus_fileAccess) {
-        current_event_buffer_size = m_eventFile->loadBlockAt(
-            event_buffer, fileOffset, current_event_buffer_size);
-      }
+      // The events are read straight from the mapped file, so every thread
+      // can read its block at the same time
+      const DasEvent *event_buffer = m_eventFile->data() + fileOffset;
 
       // This processes the events. Can be done in parallel!
       procEventsLinear(ws, theseEventVectors, event_buffer,
@@ -1054,9 +1044,8 @@ void FilterEventsByLogValuePreNexus::procEvents(
     }
     PARALLEL_CHECK_INTERUPT_REGION
 
-    // Delete the buffers for each thread.
+    // Delete the event vector arrays for each thread.
     for (size_t i = 0; i < numThreads; i++) {
-      delete[] buffers[i];
       delete[] eventVectors[i];
     }
     delete[] eventVectors;
@@ -1114,7 +1103,7 @@ void FilterEventsByLogValuePreNexus::procEvents(
  */
 void FilterEventsByLogValuePreNexus::procEventsLinear(
     DataObjects::EventWorkspace_sptr & /*workspace*/,
-    std::vector<TofEvent> **arrayOfVectors, DasEvent *event_buffer,
+    std::vector<TofEvent> **arrayOfVectors, const DasEvent *event_buffer,
     size_t current_event_buffer_size, size_t fileOffset) {
   //----------------------------------------------------------------------------------
   // Set up parameters to process events from raw file
@@ -1160,7 +1149,7 @@ void FilterEventsByLogValuePreNexus::procEventsLinear(
 
   for (size_t ievent = 0; ievent < current_event_buffer_size; ++ievent) {
     // Load DasEvent
-    DasEvent &tempevent = *(event_buffer + ievent);
+    const DasEvent &tempevent = *(event_buffer + ievent);
 
     // DasEvetn's pixel ID
     PixelType pixelid = tempevent.pid;
@@ -1505,7 +1494,6 @@ void FilterEventsByLogValuePreNexus::filterEvents() {
   //--------------------------------------------------------------------
   // Vector of partial workspaces, for parallel processing.
   std::vector<EventWorkspace_sptr> partWorkspaces;
-  std::vector<DasEvent *> buffers;
 
   /// Pointer to the vector of events
   using EventVector_pt = std::vector<TofEvent> *;
@@ -1518,7 +1506,6 @@ void FilterEventsByLogValuePreNexus::filterEvents() {
     numThreads = size_t(PARALLEL_GET_MAX_THREADS);
 
   partWorkspaces.resize(numThreads);
-  buffers.resize(numThreads);
   eventVectors = new EventVector_pt *[numThreads];
 
   // Processing by number of threads
@@ -1542,9 +1529,6 @@ void FilterEventsByLogValuePreNexus::filterEvents() {
       } else
         partWS = m_localWorkspace;
 
-      // Allocate the buffers
-      buffers[i] = new DasEvent[loadBlockSize];
-
       // For each partial workspace, make an array where index = detector ID and
       // value = pointer to the events vector
       eventVectors[i] = new EventVector_pt[m_detid_max + 1];
@@ -1581,9 +1565,6 @@ void FilterEventsByLogValuePreNexus::filterEvents() {
       } else
         ws = m_localWorkspace;
 
-      // Get the buffer (for this thread)
-      DasEvent *event_buffer = buffers[threadNum];
-
       // Get the speeding-up array of vector<tofEvent> where index = detid.
       EventVector_pt *theseEventVectors = eventVectors[threadNum];
 
@@ -1595,11 +1576,9 @@ void FilterEventsByLogValuePreNexus::filterEvents() {
               ? (m_maxNumEvents - (numBlocks - 1) * loadBlockSize)
               : loadBlockSize;
 
-      // Load this chunk of event data (critical block)
-      PARALLEL_CRITICAL(FilterEventsByLogValuePreNexus_fileAccess) {
-        current_event_buffer_size = m_eventFile->loadBlockAt(
-            event_buffer, fileOffset, current_event_buffer_size);
-      }
+      // The events are read straight from the mapped file, so every thread
+      // can read its block at the same time
+      const DasEvent *event_buffer = m_eventFile->data() + fileOffset;
 
       // This processes the events. Can be done in parallel!
       filterEventsLinear(ws, theseEventVectors, event_buffer,
@@ -1654,9 +1633,8 @@ void FilterEventsByLogValuePreNexus::filterEvents() {
     }
     PARALLEL_CHECK_INTERUPT_REGION
 
-    // Delete the buffers for each thread.
+    // Delete the event vector arrays for each thread.
     for (size_t i = 0; i < numThreads; i++) {
-      delete[] buffers[i];
       delete[] eventVectors[i];
     }
     delete[] eventVectors;
@@ -1709,7 +1687,7 @@ void FilterEventsByLogValuePreNexus::filterEvents() {
  */
 void FilterEventsByLogValuePreNexus::filterEventsLinear(
     DataObjects::EventWorkspace_sptr & /*workspace*/,
-    std::vector<TofEvent> **arrayOfVectors, DasEvent *event_buffer,
+    std::vector<TofEvent> **arrayOfVectors, const DasEvent *event_buffer,
     size_t current_event_buffer_size, size_t fileOffset) {
   //----------------------------------------------------------------------------------
   // Set up parameters to process events from raw file
@@ -1758,8 +1736,8 @@ void FilterEventsByLogValuePreNexus::filterEventsLinear(
     definedfilterstatus = false;
   } else {
     size_t firstindex = 1234567890;
-    for (size_t i = 0; i <= current_event_buffer_size; ++i) {
-      DasEvent &tempevent = *(event_buffer + i);
+    for (size_t i = 0; i < current_event_buffer_size; ++i) {
+      const DasEvent &tempevent = *(event_buffer + i);
       PixelType pixelid = tempevent.pid;
       if (pixelid == m_vecLogPixelID[0]) {
         filterstatus = -1;
@@ -1815,7 +1793,7 @@ void FilterEventsByLogValuePreNexus::filterEventsLinear(
   for (size_t ievent = 0; ievent < current_event_buffer_size; ++ievent) {
 
     // Load DasEvent
-    DasEvent &tempevent = *(event_buffer + ievent);
+    const DasEvent &tempevent = *(event_buffer + ievent);
 
     // DasEvetn's pixel ID
     PixelType pixelid = tempevent.pid;
@@ -2291,7 +2269,7 @@ void FilterEventsByLogValuePreNexus::loadPixelMap(const std::string &filename) {
 void FilterEventsByLogValuePreNexus::openEventFile(
     const std::string &filename) {
   // Open the file
-  m_eventFile = std::make_unique<BinaryFile<DasEvent>>(filename);
+  m_eventFile = std::make_unique<MappedBinaryFile<DasEvent>>(filename);
   m_numEvents = m_eventFile->getNumElements();
   g_log.debug() << "File contains " << m_numEvents << " event records.\n";
 
@@ -6,16 +6,86 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/BankPulseTimes.h"
+#include "MantidDataHandling/CompressedDatasetReader.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Tracing.h"
 #include "MantidKernel/Unit.h"
 #include "MantidNexus/NexusIOHelper.h"
+
+#include <H5Cpp.h>
+
 #include <algorithm>
+#include <atomic>
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/// Selected events separated by no more than this many others are read
+/// together, as one read is cheaper than many small ones
+constexpr uint64_t MAX_SKIPPED_EVENTS = 16384;
+
+/**
+ * Read the events of a field that are selected to be loaded
+ * @param data :: Filled with the selected events
+ * @param loadStart :: The index of the first event to read, if all are read
+ * @param loadSize :: The number of events to read, if all are read
+ * @param selected :: The ranges of events to read, or empty to read all
+ * @param readSlab :: Reads (buffer, start, size) a block of events
+ */
+template <typename T, typename ReadSlab>
+void readEvents(T *data, const int64_t loadStart, const int64_t loadSize,
+                const std::vector<LogPredicateFilter::Range> &selected,
+                ReadSlab readSlab) {
+  if (selected.empty()) {
+    readSlab(data, loadStart, loadSize);
+    return;
+  }
+  std::vector<T> buffer;
+  auto range = selected.cbegin();
+  while (range != selected.cend()) {
+    // Group the ranges with small gaps between them into one read
+    auto groupEnd = std::next(range);
+    while (groupEnd != selected.cend() &&
+           groupEnd->first - std::prev(groupEnd)->second <= MAX_SKIPPED_EVENTS)
+      ++groupEnd;
+    const auto start = range->first;
+    const auto size = std::prev(groupEnd)->second - start;
+    if (std::next(range) == groupEnd) {
+      readSlab(data, static_cast<int64_t>(start), static_cast<int64_t>(size));
+      data += size;
+      range = groupEnd;
+      continue;
+    }
+    buffer.resize(size);
+    readSlab(buffer.data(), static_cast<int64_t>(start),
+             static_cast<int64_t>(size));
+    for (; range != groupEnd; ++range)
+      data = std::copy(buffer.cbegin() + (range->first - start),
+                       buffer.cbegin() + (range->second - start), data);
+  }
+}
+} // namespace
+
+/// The compressed event fields of a bank, shared by the tasks inflating them
+struct LoadBankFromDiskTask::CompressedBank {
+  std::unique_ptr<CompressedDatasetReader> idReader;
+  std::unique_ptr<CompressedDatasetReader> tofReader;
+  /// Null if the events are not weighted
+  std::unique_ptr<CompressedDatasetReader> weightReader;
+  std::string tofUnit;
+  std::shared_ptr<std::vector<uint32_t>> eventId;
+  std::shared_ptr<std::vector<float>> timeOfFlight;
+  std::shared_ptr<std::vector<float>> weight;
+  std::shared_ptr<std::vector<uint64_t>> eventIndex;
+  /// The number of tasks that have not finished inflating
+  std::atomic<size_t> remaining{0};
+  std::atomic<bool> failed{false};
+};
+
 /** Constructor
  *
  * @param loader :: Handle to the main loader
@@ -215,7 +285,12 @@ LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   if (!m_loadError) {
     // Must be uint32
     if (id_info.type == ::NeXus::UINT32)
-      file.getSlab(event_id->data(), m_loadStart, m_loadSize);
+      readEvents(event_id->data(), m_loadStart[0], m_loadSize[0],
+                 m_selectedEvents,
+                 [&file](uint32_t *data, int64_t start, int64_t size) {
+                   file.getSlab(data, std::vector<int64_t>{start},
+                                std::vector<int64_t>{size});
+                 });
     else {
       m_loader.alg->getLogger().warning()
           << "Entry " << entry_name
@@ -224,34 +299,40 @@ LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
     }
     file.closeData();
 
-    // determine the range of pixel ids
-    m_min_id =
-        *(std::min_element(event_id->data(), event_id->data() + m_loadSize[0]));
-    m_max_id =
-        *(std::max_element(event_id->data(), event_id->data() + m_loadSize[0]));
-
-    if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
-      // All the detector IDs in the bank are higher than the highest 'known'
-      // (from the IDF)
-      // ID. Setting this will abort the loading of the bank.
-      m_loadError = true;
-    }
-    // fixup the minimum pixel id in the case that it's lower than the lowest
-    // 'known' id. We test this by checking that when we add the offset we
-    // would not get a negative index into the vector. Note that m_min_id is
-    // a uint so we have to be cautious about adding it to an int which may be
-    // negative.
-    if (static_cast<int32_t>(m_min_id) + m_loader.pixelID_to_wi_offset < 0) {
-      m_min_id = static_cast<uint32_t>(abs(m_loader.pixelID_to_wi_offset));
-    }
-    // fixup the maximum pixel id in the case that it's higher than the
-    // highest 'known' id
-    if (m_max_id > static_cast<uint32_t>(m_loader.eventid_max))
-      m_max_id = static_cast<uint32_t>(m_loader.eventid_max);
+    findIdRange(*event_id);
   }
   return event_id;
 }
 
+/** Determine the range of pixel IDs of the events, limited to the IDs known
+ * from the instrument
+ * @param event_id :: The pixel IDs of the events to load
+ */
+void LoadBankFromDiskTask::findIdRange(const std::vector<uint32_t> &event_id) {
+  const auto range = std::minmax_element(event_id.cbegin(), event_id.cend());
+  m_min_id = *range.first;
+  m_max_id = *range.second;
+
+  if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
+    // All the detector IDs in the bank are higher than the highest 'known'
+    // (from the IDF)
+    // ID. Setting this will abort the loading of the bank.
+    m_loadError = true;
+  }
+  // fixup the minimum pixel id in the case that it's lower than the lowest
+  // 'known' id. We test this by checking that when we add the offset we
+  // would not get a negative index into the vector. Note that m_min_id is
+  // a uint so we have to be cautious about adding it to an int which may be
+  // negative.
+  if (static_cast<int32_t>(m_min_id) + m_loader.pixelID_to_wi_offset < 0) {
+    m_min_id = static_cast<uint32_t>(abs(m_loader.pixelID_to_wi_offset));
+  }
+  // fixup the maximum pixel id in the case that it's higher than the
+  // highest 'known' id
+  if (m_max_id > static_cast<uint32_t>(m_loader.eventid_max))
+    m_max_id = static_cast<uint32_t>(m_loader.eventid_max);
+}
+
 /** Open and load the times-of-flight data
  * @param file An NeXus::File object opened at the correct group
  * @returns A new array containing the time of flights for this bank
@@ -286,15 +367,20 @@ LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
   // We thus have to consider 32-bit or 64-bit options, and we
   // explicitly allow downcasting using the additional AllowDowncasting
   // template argument.
-  auto vec =
-      NeXus::NeXusIOHelper::readNexusSlab<float,
-                                          NeXus::NeXusIOHelper::AllowNarrowing>(
-          file, key, m_loadStart, m_loadSize);
+  readEvents(
+      event_time_of_flight->data(), m_loadStart[0], m_loadSize[0],
+      m_selectedEvents,
+      [&file, &key](float *data, int64_t start, int64_t size) {
+        const auto vec = NeXus::NeXusIOHelper::readNexusSlab<
+            float, NeXus::NeXusIOHelper::AllowNarrowing>(
+            file, key, std::vector<int64_t>{start}, std::vector<int64_t>{size});
+        std::copy(vec.begin(), vec.end(), data);
+      });
   file.getAttr("units", tof_unit);
   file.closeData();
   // Convert Tof to microseconds
-  Kernel::Units::timeConversionVector(vec, tof_unit, "microseconds");
-  std::copy(vec.begin(), vec.end(), event_time_of_flight->data());
+  Kernel::Units::timeConversionVector(*event_time_of_flight, tof_unit,
+                                      "microseconds");
 
   return event_time_of_flight;
 }
@@ -331,7 +417,12 @@ LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
 
   // Check that the type is what it is supposed to be
   if (weight_info.type == ::NeXus::FLOAT32)
-    file.getSlab(event_weight->data(), m_loadStart, m_loadSize);
+    readEvents(event_weight->data(), m_loadStart[0], m_loadSize[0],
+               m_selectedEvents,
+               [&file](float *data, int64_t start, int64_t size) {
+                 file.getSlab(data, std::vector<int64_t>{start},
+                              std::vector<int64_t>{size});
+               });
   else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
@@ -345,7 +436,187 @@ LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   return event_weight;
 }
 
+/** Find the events of the pulses accepted by the log filters of the loader.
+ * If only some of the events are accepted, the ranges to read are stored in
+ * m_selectedEvents and the event index is changed to index the events read.
+ * @param event_index :: The index of the first event of each pulse
+ * @returns False if none of the events are accepted
+ */
+bool LoadBankFromDiskTask::selectEvents(std::vector<uint64_t> &event_index) {
+  const auto start = static_cast<uint64_t>(m_loadStart[0]);
+  const auto stop = start + static_cast<uint64_t>(m_loadSize[0]);
+  auto selection = LogPredicateFilter::selectEvents(
+      m_loader.alg->m_logFilter->acceptedPulses(*thisBankPulseTimes),
+      event_index, start, stop);
+  if (selection.numberOfEvents == stop - start)
+    return true;
+
+  m_loader.alg->getLogger().debug()
+      << "Reading " << selection.numberOfEvents << " of " << stop - start
+      << " events of bank " << entry_name << " in "
+      << selection.ranges.size() << " ranges.\n";
+  m_selectedEvents = std::move(selection.ranges);
+  event_index = std::move(selection.eventIndex);
+  m_loadSize[0] = static_cast<int64_t>(selection.numberOfEvents);
+  return selection.numberOfEvents > 0;
+}
+
+/** Copy the compressed chunks of the event fields from the file, if they are
+ * all gzip-compressed, so that scheduleDecompression() can inflate them in
+ * parallel outside of the disk IO mutex
+ * @param file :: File handle for the NeXus file, with the event_id field open
+ * @returns True if the chunks were read, false if the fields must be loaded
+ * through the NeXus API
+ */
+bool LoadBankFromDiskTask::readCompressedEvents(::NeXus::File &file) {
+  if (file.getInfo().type != ::NeXus::UINT32 || m_loader.alg->getCancel())
+    return false;
+  const std::string path =
+      "/" + m_loader.alg->m_top_entry_name + "/" + entry_name + "/";
+  const std::string tofKey =
+      m_oldNexusFileNames ? "event_time_of_flight" : "event_time_offset";
+  auto bank = std::make_shared<CompressedBank>();
+  bool haveWeight = m_have_weight;
+  try {
+    H5::Exception::dontPrint();
+    // The file is already open through the NeXus API. A second handle shares
+    // it, which requires the same close degree
+    H5::FileAccPropList access;
+    access.setFcloseDegree(H5F_CLOSE_STRONG);
+    H5::H5File h5file(m_loader.alg->m_filename, H5F_ACC_RDONLY,
+                      H5::FileCreatPropList::DEFAULT, access);
+    const auto ids = h5file.openDataSet(
+        path + (m_oldNexusFileNames ? "event_pixel_id" : "event_id"));
+    const auto tofs = h5file.openDataSet(path + tofKey);
+    if (!CompressedDatasetReader::isSupported(ids) ||
+        !CompressedDatasetReader::isSupported(tofs))
+      return false;
+    H5::DataSet weights;
+    haveWeight = haveWeight && H5Lexists(h5file.getId(),
+                                         (path + "event_weight").c_str(),
+                                         H5P_DEFAULT) > 0;
+    if (haveWeight) {
+      weights = h5file.openDataSet(path + "event_weight");
+      if (!(weights.getDataType() == H5::PredType::NATIVE_FLOAT) ||
+          !CompressedDatasetReader::isSupported(weights))
+        return false;
+    }
+
+    bank->idReader = std::make_unique<CompressedDatasetReader>(
+        ids, m_loadStart[0], m_loadSize[0]);
+    bank->tofReader = std::make_unique<CompressedDatasetReader>(
+        tofs, m_loadStart[0], m_loadSize[0]);
+    if (haveWeight)
+      bank->weightReader = std::make_unique<CompressedDatasetReader>(
+          weights, m_loadStart[0], m_loadSize[0]);
+  } catch (H5::Exception &e) {
+    m_loader.alg->getLogger().debug()
+        << "Reading the events of " << entry_name
+        << " through the NeXus API: " << e.getDetailMsg() << '\n';
+    return false;
+  } catch (std::exception &e) {
+    m_loader.alg->getLogger().debug()
+        << "Reading the events of " << entry_name
+        << " through the NeXus API: " << e.what() << '\n';
+    return false;
+  }
+
+  file.closeData();
+  file.openData(tofKey);
+  file.getAttr("units", bank->tofUnit);
+  file.closeData();
+  m_have_weight = haveWeight;
+  m_compressed = std::move(bank);
+  return true;
+}
+
+/** Schedule copies of this task without the disk IO mutex, which inflate the
+ * compressed events in parallel. Each copy covers whole chunks of the
+ * event_id field.
+ * @param event_index :: The index of the first event of each pulse
+ */
+void LoadBankFromDiskTask::scheduleDecompression(
+    std::vector<uint64_t> event_index) {
+  auto &bank = *m_compressed;
+  const int64_t start = m_loadStart[0];
+  const int64_t size = m_loadSize[0];
+  bank.eventId = std::make_shared<std::vector<uint32_t>>(size);
+  bank.timeOfFlight = std::make_shared<std::vector<float>>(size);
+  if (bank.weightReader)
+    bank.weight = std::make_shared<std::vector<float>>(size);
+  bank.eventIndex =
+      std::make_shared<std::vector<uint64_t>>(std::move(event_index));
+
+  const int64_t chunkSize = bank.idReader->chunkSize();
+  const int64_t firstChunk = start / chunkSize;
+  const int64_t numChunks = (start + size - 1) / chunkSize - firstChunk + 1;
+  const int64_t numTasks = std::min(
+      numChunks, static_cast<int64_t>(std::max(1, PARALLEL_GET_MAX_THREADS)));
+  const int64_t chunksPerTask = (numChunks + numTasks - 1) / numTasks;
+
+  std::vector<std::shared_ptr<LoadBankFromDiskTask>> tasks;
+  for (int64_t begin = 0; begin < size;) {
+    const int64_t end = std::min(
+        (firstChunk + static_cast<int64_t>(tasks.size() + 1) * chunksPerTask) *
+                chunkSize -
+            start,
+        size);
+    auto task = std::make_shared<LoadBankFromDiskTask>(*this);
+    task->m_mutex.reset();
+    task->m_cost = static_cast<double>(end - begin);
+    task->m_decompressBegin = begin;
+    task->m_decompressEnd = end;
+    tasks.emplace_back(std::move(task));
+    begin = end;
+  }
+  bank.remaining = tasks.size();
+  for (auto &task : tasks)
+    scheduler.push(task);
+}
+
+/** Inflate the part of the compressed events assigned to this task. The last
+ * task to finish schedules the processing of the events.
+ */
+void LoadBankFromDiskTask::decompressEvents() {
+  auto &bank = *m_compressed;
+  const auto begin = m_decompressBegin;
+  const auto end = m_decompressEnd;
+  try {
+    Kernel::Tracing::Span traceSpan(entry_name + ": inflate", "cpu");
+    traceSpan.addArgument("events", static_cast<double>(end - begin));
+    if (!bank.failed && !m_loader.alg->getCancel()) {
+      bank.idReader->decompress(bank.eventId->data() + begin, begin, end);
+      bank.tofReader->decompress(bank.timeOfFlight->data() + begin, begin,
+                                 end);
+      if (bank.weightReader)
+        bank.weightReader->decompress(bank.weight->data() + begin, begin,
+                                      end);
+    }
+  } catch (std::exception &e) {
+    m_loader.alg->getLogger().error()
+        << "Error while inflating the events of bank " << entry_name << ":\n"
+        << e.what() << '\n';
+    bank.failed = true;
+  }
+  if (--bank.remaining > 0 || bank.failed || m_loader.alg->getCancel())
+    return;
+
+  // Convert Tof to microseconds
+  Kernel::Units::timeConversionVector(*bank.timeOfFlight, bank.tofUnit,
+                                      "microseconds");
+  findIdRange(*bank.eventId);
+  if (m_loadError)
+    return;
+  scheduleProcessing(bank.eventId, bank.timeOfFlight, bank.weight,
+                     bank.eventIndex);
+}
+
 void LoadBankFromDiskTask::run() {
+  if (m_compressed) {
+    decompressEvents();
+    return;
+  }
+
   // These give the limits in each file as to which events we actually load
   // (when filtering by time).
   m_loadStart.resize(1, 0);
@@ -355,6 +626,7 @@ void LoadBankFromDiskTask::run() {
   m_have_weight = m_loader.m_haveWeights;
 
   prog->report(entry_name + ": load from disk");
+  Kernel::Tracing::Span traceSpan(entry_name + ": load from disk", "io");
 
   // arrays to load into
   std::unique_ptr<std::vector<uint32_t>> event_id;
@@ -394,9 +666,17 @@ void LoadBankFromDiskTask::run() {
       m_loadStart[0] = start_event;
       m_loadSize[0] = stop_event - start_event;
 
-      if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
-        // Load pixel IDs
-        event_id = this->loadEventId(file);
+      if (m_loader.alg->m_logFilter && m_loadSize[0] > 0 &&
+          m_loadStart[0] >= 0 && !this->selectEvents(event_index)) {
+        m_loader.alg->getLogger().debug()
+            << "No events of bank " << entry_name
+            << " pass the log filters.\n";
+        m_loadError = true;
+      } else if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
+        // Copy the compressed events to inflate them in parallel, or load
+        // pixel IDs
+        if (!m_selectedEvents.empty() || !this->readCompressedEvents(file))
+          event_id = this->loadEventId(file);
         if (m_loader.alg->getCancel()) {
           m_loader.alg->getLogger().error()
               << "Loading bank " << entry_name << " is cancelled.\n";
@@ -404,7 +684,7 @@ void LoadBankFromDiskTask::run() {
         }
 
         // And TOF.
-        if (!m_loadError) {
+        if (!m_loadError && !m_compressed) {
           event_time_of_flight = this->loadTof(file);
           if (m_have_weight) {
             event_weight = this->loadEventWeights(file);
@@ -438,12 +718,48 @@ void LoadBankFromDiskTask::run() {
   // Close up the file even if errors occured.
   file.closeGroup();
   file.close();
+  if (!m_loadError) {
+    const size_t bytesPerEvent = sizeof(uint32_t) +
+                                 sizeof(float) * (m_have_weight ? 2 : 1);
+    traceSpan.addArgument("events", static_cast<double>(m_loadSize[0]));
+    traceSpan.addArgument(
+        "bytes", static_cast<double>(static_cast<size_t>(m_loadSize[0]) *
+                                     bytesPerEvent));
+  }
+  traceSpan.end();
 
   // Abort if anything failed
   if (m_loadError) {
     return;
   }
 
+  if (m_compressed) {
+    scheduleDecompression(std::move(event_index));
+    return;
+  }
+
+  // convert things to shared_arrays to share between tasks
+  std::shared_ptr<std::vector<uint32_t>> event_id_shrd(event_id.release());
+  std::shared_ptr<std::vector<float>> event_time_of_flight_shrd(
+      event_time_of_flight.release());
+  std::shared_ptr<std::vector<float>> event_weight_shrd(event_weight.release());
+  auto event_index_shrd =
+      std::make_shared<std::vector<uint64_t>>(std::move(event_index));
+  scheduleProcessing(event_id_shrd, event_time_of_flight_shrd,
+                     event_weight_shrd, event_index_shrd);
+}
+
+/** Schedule the tasks that sort the loaded events into the event lists
+ * @param event_id :: The pixel IDs of the events
+ * @param event_tof :: The times-of-flight of the events, in microseconds
+ * @param event_weight :: The weights of the events, or nullptr
+ * @param event_index :: The index of the first event of each pulse
+ */
+void LoadBankFromDiskTask::scheduleProcessing(
+    std::shared_ptr<std::vector<uint32_t>> event_id,
+    std::shared_ptr<std::vector<float>> event_tof,
+    std::shared_ptr<std::vector<float>> event_weight,
+    std::shared_ptr<std::vector<uint64_t>> event_index) {
   const auto bank_size = m_max_id - m_min_id;
   const auto minSpectraToLoad = static_cast<uint32_t>(m_loader.alg->m_specMin);
   const auto maxSpectraToLoad = static_cast<uint32_t>(m_loader.alg->m_specMax);
@@ -481,26 +797,20 @@ void LoadBankFromDiskTask::run() {
 
   // No error? Launch a new task to process that data.
   auto numEvents = static_cast<size_t>(m_loadSize[0]);
-  auto startAt = static_cast<size_t>(m_loadStart[0]);
-
-  // convert things to shared_arrays to share between tasks
-  std::shared_ptr<std::vector<uint32_t>> event_id_shrd(event_id.release());
-  std::shared_ptr<std::vector<float>> event_time_of_flight_shrd(
-      event_time_of_flight.release());
-  std::shared_ptr<std::vector<float>> event_weight_shrd(event_weight.release());
-  auto event_index_shrd =
-      std::make_shared<std::vector<uint64_t>>(std::move(event_index));
+  // The event index is relative to the selected events, if any
+  auto startAt =
+      m_selectedEvents.empty() ? static_cast<size_t>(m_loadStart[0]) : 0;
 
   std::shared_ptr<Task> newTask1 = std::make_shared<ProcessBankData>(
-      m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-      numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-      event_weight_shrd, m_min_id, mid_id);
+      m_loader, entry_name, prog, event_id, event_tof, numEvents, startAt,
+      event_index, thisBankPulseTimes, m_have_weight, event_weight, m_min_id,
+      mid_id);
   scheduler.push(newTask1);
   if (m_loader.splitProcessing && (mid_id < m_max_id)) {
     std::shared_ptr<Task> newTask2 = std::make_shared<ProcessBankData>(
-        m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-        numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, (mid_id + 1), m_max_id);
+        m_loader, entry_name, prog, event_id, event_tof, numEvents, startAt,
+        event_index, thisBankPulseTimes, m_have_weight, event_weight,
+        (mid_id + 1), m_max_id);
     scheduler.push(newTask2);
   }
 }
@@ -25,6 +25,7 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Timer.h"
+#include "MantidKernel/Tracing.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/VisibleWhenProperty.h"
 #include "MantidNexus/NexusIOHelper.h"
@@ -151,11 +152,20 @@ void LoadEventNexus::init() {
                   "Optional: To only include events before the provided stop "
                   "time, in seconds (relative to the start of the run).");
 
+  declareProperty(
+      std::make_unique<ArrayProperty<string>>("FilterByLogValues",
+                                              Direction::Input),
+      "Optional: To only include events from pulses at which the values of "
+      "logs satisfy all of the given conditions, for example "
+      "SampleTemp>=290,SampleTemp<300. The comparisons are <, <=, >, >=, == "
+      "and !=. The events of other pulses are not read from the file.");
+
   std::string grp1 = "Filter Events";
   setPropertyGroup("FilterByTofMin", grp1);
   setPropertyGroup("FilterByTofMax", grp1);
   setPropertyGroup("FilterByTimeStart", grp1);
   setPropertyGroup("FilterByTimeStop", grp1);
+  setPropertyGroup("FilterByLogValues", grp1);
 
   declareProperty(
       std::make_unique<ArrayProperty<string>>("BankName", Direction::Input),
@@ -909,6 +919,20 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
     m_ws->mutableRun().filterByTime(filter_time_start, filter_time_stop);
   }
 
+  // --------------------------- Log filtering
+  // ------------------------------------
+  m_logFilter.reset();
+  const std::vector<std::string> logFilters = getProperty("FilterByLogValues");
+  if (!monitors && !logFilters.empty()) {
+    const bool loadlogs = getProperty("LoadLogs");
+    if (!loadlogs)
+      throw std::invalid_argument(
+          "FilterByLogValues needs the logs: set LoadLogs to true.");
+    m_logFilter = std::make_unique<LogPredicateFilter>(logFilters, m_ws->run());
+    if (m_allBanksPulseTimes->numPulses > 0)
+      m_logFilter->filterRun(m_ws->mutableRun(), *m_allBanksPulseTimes);
+  }
+
   if (metaDataOnly) {
     // Now, create a default X-vector for histogramming, with just 2 bins.
     auto axis = HistogramData::BinEdges{
@@ -1040,6 +1064,7 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
 
   // Info reporting
   const std::size_t eventsLoaded = m_ws->getNumberEvents();
+  Kernel::Tracing::counter("Events loaded", static_cast<double>(eventsLoaded));
   g_log.information() << "Read " << eventsLoaded << " events"
                       << ". Shortest TOF: " << shortest_tof
                       << " microsec; longest TOF: " << longest_tof
@@ -1542,7 +1567,7 @@ LoadEventNexus::defineLoaderType(const bool haveWeights,
   noParallelConstrictions &=
       !((!isDefault("CompressTolerance") || !isDefault("SpectrumMin") ||
          !isDefault("SpectrumMax") || !isDefault("SpectrumList") ||
-         !isDefault("ChunkNumber")));
+         !isDefault("ChunkNumber") || !isDefault("FilterByLogValues")));
   noParallelConstrictions &= !(classType != "NXevent_data");
 
   if (!noParallelConstrictions)
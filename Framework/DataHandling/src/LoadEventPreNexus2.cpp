@@ -287,6 +287,15 @@ void LoadEventPreNexus2::init() {
   setPropertySettings("TotalChunks", std::make_unique<VisibleWhenProperty>(
                                          "ChunkNumber", IS_NOT_DEFAULT));
 
+  declareProperty("FilterByTimeStart", EMPTY_DBL(),
+                  "Optional: To only include events of pulses after the "
+                  "provided start time, in seconds (relative to the first "
+                  "pulse). The events before it are not read from the file.");
+  declareProperty("FilterByTimeStop", EMPTY_DBL(),
+                  "Optional: To only include events of pulses before the "
+                  "provided stop time, in seconds (relative to the first "
+                  "pulse). The events after it are not read from the file.");
+
   std::vector<std::string> propOptions{"Auto", "Serial", "Parallel"};
   declareProperty("UseParallelProcessing", "Auto",
                   std::make_shared<StringListValidator>(propOptions),
@@ -379,6 +388,9 @@ void LoadEventPreNexus2::exec() {
   // Correct event indexes mased by veto flag
   unmaskVetoEventIndex();
 
+  // Only read the events of the pulses in the time window, if any
+  selectTimeWindow();
+
   // Optinally output event number / pulse file
   std::string diswsname = getPropertyValue("EventNumberWorkspace");
   if (!diswsname.empty()) {
@@ -488,6 +500,9 @@ void LoadEventPreNexus2::unmaskVetoEventIndex() {
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
+
+  eventindicesincreasing =
+      std::is_sorted(event_indices.cbegin(), event_indices.cend());
 }
 
 //------------------------------------------------------------------------------------------------
@@ -743,7 +758,6 @@ void LoadEventPreNexus2::procEvents(
   //-------------------------------------------------------------------------
   // Vector of partial workspaces, for parallel processing.
   std::vector<EventWorkspace_sptr> partWorkspaces;
-  std::vector<DasEvent *> buffers;
 
   /// Pointer to the vector of events
   using EventVector_pt = std::vector<TofEvent> *;
@@ -756,7 +770,6 @@ void LoadEventPreNexus2::procEvents(
     numThreads = size_t(PARALLEL_GET_MAX_THREADS);
 
   partWorkspaces.resize(numThreads);
-  buffers.resize(numThreads);
   eventVectors = new EventVector_pt *[numThreads];
   // cppcheck-suppress syntaxError
     PRAGMA_OMP( parallel for if (parallelProcessing) )
@@ -773,9 +786,6 @@ void LoadEventPreNexus2::procEvents(
       } else
         partWS = workspace;
 
-      // Allocate the buffers
-      buffers[i] = new DasEvent[loadBlockSize];
-
       // For each partial workspace, make an array where index = detector ID and
       // value = pointer to the events vector
       eventVectors[i] = new EventVector_pt[detid_max + 1];
@@ -815,9 +825,6 @@ void LoadEventPreNexus2::procEvents(
       } else
         ws = workspace;
 
-      // Get the buffer (for this thread)
-      DasEvent *event_buffer = buffers[threadNum];
-
       // Get the speeding-up array of vector<tofEvent> where index = detid.
       EventVector_pt *theseEventVectors = eventVectors[threadNum];
 
@@ -829,11 +836,9 @@ void LoadEventPreNexus2::procEvents(
               ? (max_events - (numBlocks - 1) * loadBlockSize)
               : loadBlockSize;
 
-      // Load this chunk of event data (critical block)
-      PARALLEL_CRITICAL(LoadEventPreNexus2_fileAccess) {
-        current_event_buffer_size = eventfile->loadBlockAt(
-            event_buffer, fileOffset, current_event_buffer_size);
-      }
+      // The events are read straight from the mapped file, so every thread
+      // can read its block at the same time
+      const DasEvent *event_buffer = eventfile->data() + fileOffset;
 
       // This processes the events. Can be done in parallel!
       bool dbprint = m_dbOutput && (blockNum == m_dbOpBlockNumber);
@@ -890,9 +895,8 @@ void LoadEventPreNexus2::procEvents(
     // Clean memory
     //-------------------------------------------------------------------------
 
-    // Delete the buffers for each thread.
+    // Delete the event vector arrays for each thread.
     for (size_t i = 0; i < numThreads; i++) {
-      delete[] buffers[i];
       delete[] eventVectors[i];
     }
     delete[] eventVectors;
@@ -966,7 +970,7 @@ void LoadEventPreNexus2::procEvents(
  */
 void LoadEventPreNexus2::procEventsLinear(
     DataObjects::EventWorkspace_sptr & /*workspace*/,
-    std::vector<TofEvent> **arrayOfVectors, DasEvent *event_buffer,
+    std::vector<TofEvent> **arrayOfVectors, const DasEvent *event_buffer,
     size_t current_event_buffer_size, size_t fileOffset, bool dbprint) {
   // Starting pulse time
   DateAndTime pulsetime;
@@ -977,6 +981,17 @@ void LoadEventPreNexus2::procEventsLinear(
         << "Event_indices vector is smaller than the pulsetimes array.\n";
     numPulses = static_cast<int64_t>(event_indices.size());
   }
+  // Start from the pulse of the first event, rather than searching for it
+  // from the first pulse of the run
+  if (eventindicesincreasing && numPulses > 1) {
+    const auto next =
+        std::upper_bound(event_indices.cbegin(),
+                         event_indices.cbegin() + numPulses, fileOffset);
+    pulse_i = std::max(
+        static_cast<int64_t>(std::distance(event_indices.cbegin(), next)) - 1,
+        int64_t{0});
+    pulsetime = pulsetimes[pulse_i];
+  }
 
   // Local stastic parameters
   size_t local_num_error_events = 0;
@@ -998,7 +1013,7 @@ void LoadEventPreNexus2::procEventsLinear(
   std::stringstream dbss;
   // size_t numwrongpid = 0;
   for (size_t i = 0; i < current_event_buffer_size; i++) {
-    DasEvent &temp = *(event_buffer + i);
+    const DasEvent &temp = *(event_buffer + i);
     PixelType pid = temp.pid;
     bool iswrongdetid = false;
 
@@ -1201,7 +1216,10 @@ void LoadEventPreNexus2::setProtonCharge(
   /// TODO set the units for the log
   run.addLogData(log);
   // Force re-integration
-  run.integrateProtonCharge();
+  if (m_timeFiltered)
+    run.filterByTime(m_filterTimeStart, m_filterTimeStop);
+  else
+    run.integrateProtonCharge();
   double integ = run.getProtonCharge();
 
   g_log.information() << "Total proton charge of " << integ
@@ -1256,7 +1274,7 @@ void LoadEventPreNexus2::loadPixelMap(const std::string &filename) {
  */
 void LoadEventPreNexus2::openEventFile(const std::string &filename) {
   // Open the file
-  eventfile = std::make_unique<BinaryFile<DasEvent>>(filename);
+  eventfile = std::make_unique<MappedBinaryFile<DasEvent>>(filename);
   num_events = eventfile->getNumElements();
   g_log.debug() << "File contains " << num_events << " event records.\n";
 
@@ -1296,20 +1314,16 @@ void LoadEventPreNexus2::readPulseidFile(const std::string &filename,
     return;
   }
 
-  std::vector<Pulse> pulses;
-
   // set up for reading
-  // Open the file; will throw if there is any problem
+  // Map the file; will throw if there is any problem
+  MappedBinaryFile<Pulse> pulses;
   try {
-    BinaryFile<Pulse> pulseFile(filename);
+    pulses.open(filename);
 
     // Get the # of pulse
-    this->num_pulses = pulseFile.getNumElements();
+    this->num_pulses = pulses.getNumElements();
     this->g_log.information() << "Using pulseid file \"" << filename
                               << "\", with " << num_pulses << " pulses.\n";
-
-    // Load all the data
-    pulses = pulseFile.loadAll();
   } catch (runtime_error &e) {
     if (throwError) {
       throw;
@@ -1324,6 +1338,8 @@ void LoadEventPreNexus2::readPulseidFile(const std::string &filename,
   if (num_pulses > 0) {
     DateAndTime lastPulseDateTime(0, 0);
     this->pulsetimes.reserve(num_pulses);
+    this->event_indices.reserve(num_pulses);
+    this->proton_charge.reserve(num_pulses);
     for (const auto &pulse : pulses) {
       DateAndTime pulseDateTime(static_cast<int64_t>(pulse.seconds),
                                 static_cast<int64_t>(pulse.nanoseconds));
@@ -1355,6 +1371,62 @@ void LoadEventPreNexus2::readPulseidFile(const std::string &filename,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Limit the events to read to those of the pulses between FilterByTimeStart
+ * and FilterByTimeStop, using the pulse index to seek straight to them in the
+ * event file.
+ */
+void LoadEventPreNexus2::selectTimeWindow() {
+  const double startSeconds = getProperty("FilterByTimeStart");
+  const double stopSeconds = getProperty("FilterByTimeStop");
+  m_timeFiltered = !isEmpty(startSeconds) || !isEmpty(stopSeconds);
+  if (!m_timeFiltered)
+    return;
+
+  const size_t numPulses = std::min(num_pulses, event_indices.size());
+  if (numPulses == 0)
+    throw std::invalid_argument(
+        "Filtering by time needs the pulse times from a pulseid file.");
+  if (!pulsetimesincreasing || !eventindicesincreasing)
+    throw std::runtime_error("Cannot filter by time as the pulse times or "
+                             "event indices of the pulseid file are not in "
+                             "increasing order.");
+
+  const auto pulsesBegin = pulsetimes.cbegin();
+  const auto pulsesEnd = pulsetimes.cbegin() + numPulses;
+  m_filterTimeStart = isEmpty(startSeconds) ? DateAndTime::minimum()
+                                            : pulsetimes.front() + startSeconds;
+  m_filterTimeStop = isEmpty(stopSeconds) ? DateAndTime::maximum()
+                                          : pulsetimes.front() + stopSeconds;
+  if (m_filterTimeStop < m_filterTimeStart)
+    throw std::invalid_argument(
+        "FilterByTimeStop is smaller than FilterByTimeStart.");
+
+  // The events of the pulses in [start, stop)
+  const auto firstPulse = static_cast<size_t>(
+      std::lower_bound(pulsesBegin, pulsesEnd, m_filterTimeStart) -
+      pulsesBegin);
+  const auto stopPulse = static_cast<size_t>(
+      std::lower_bound(pulsesBegin, pulsesEnd, m_filterTimeStop) -
+      pulsesBegin);
+  const auto eventOfPulse = [this, numPulses](const size_t pulse) {
+    return pulse < numPulses
+               ? std::min(static_cast<size_t>(event_indices[pulse]), num_events)
+               : num_events;
+  };
+
+  // Keep within the chunk being loaded
+  const size_t chunkEnd = first_event + max_events;
+  const size_t begin = std::max(first_event, eventOfPulse(firstPulse));
+  const size_t end =
+      std::max(begin, std::min(chunkEnd, eventOfPulse(stopPulse)));
+  first_event = begin;
+  max_events = end - begin;
+  g_log.information() << "Reading " << max_events
+                      << " event records of pulses " << firstPulse << " to "
+                      << stopPulse << " in the time window\n";
+}
+
 //----------------------------------------------------------------------------------------------
 /** Process input properties for purpose of investigation
  */
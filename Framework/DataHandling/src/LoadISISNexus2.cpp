@@ -24,6 +24,7 @@
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/LogFilter.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/UnitFactory.h"
 
@@ -33,14 +34,21 @@
 // clang-format on
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cctype>
 #include <climits>
+#include <exception>
 #include <functional>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 namespace {
+/// The default size in bytes of the slabs the counts of detectors are read in.
+/// Each slab is read while the previous one is copied into the workspace.
+constexpr int64_t LOAD_BLOCK_BYTES = 16 * 1024 * 1024;
+
 Mantid::DataHandling::DataBlockComposite
 getMonitorsFromComposite(Mantid::DataHandling::DataBlockComposite &composite,
                          Mantid::DataHandling::DataBlockComposite &monitors) {
@@ -79,8 +87,9 @@ LoadISISNexus2::LoadISISNexus2()
     : m_filename(), m_instrument_name(), m_samplename(), m_detBlockInfo(),
       m_monBlockInfo(), m_loadBlockInfo(), m_have_detector(false),
       m_hasVMSBlock(false), m_load_selected_spectra(false),
-      m_wsInd2specNum_map(), m_spec2det_map(), m_entrynumber(0), m_tof_data(),
-      m_spec(), m_spec_end(nullptr), m_monitors(), m_logCreator(), m_progress(),
+      m_wsInd2specNum_map(), m_spec2det_map(), m_entrynumber(0),
+      m_loadBlockBytes(LOAD_BLOCK_BYTES), m_tof_data(), m_spec(),
+      m_spec_end(nullptr), m_monitors(), m_logCreator(), m_progress(),
       m_nexusFile() {}
 
 /**
@@ -793,34 +802,17 @@ void LoadISISNexus2::loadPeriodData(
       hist_index++;
     } else if (m_have_detector) {
       NXData nxdata = entry.openNXData("detector_1");
-      NXDataSetTyped<int> data = nxdata.openIntData();
-      data.open();
       // Start with the list members that are lower than the required spectrum
       const int *const spec_begin = m_spec.data();
-      // When reading in blocks we need to be careful that the range is exactly
-      // divisible by the block-size
-      // and if not have an extra read of the left overs
-      const int64_t blocksize = 8;
       const int64_t rangesize = spectraBlock.last - spectraBlock.first + 1;
-      const int64_t fullblocks = rangesize / blocksize;
-      int64_t spectra_no = spectraBlock.first;
 
       // For this to work correctly, we assume that the spectrum list increases
       // monotonically
-      int64_t filestart =
-          std::lower_bound(spec_begin, m_spec_end, spectra_no) - spec_begin;
-      if (fullblocks > 0) {
-        for (int64_t i = 0; i < fullblocks; ++i) {
-          loadBlock(data, blocksize, period_index, filestart, hist_index,
-                    spectra_no, local_workspace);
-          filestart += blocksize;
-        }
-      }
-      int64_t finalblock = rangesize - (fullblocks * blocksize);
-      if (finalblock > 0) {
-        loadBlock(data, finalblock, period_index, filestart, hist_index,
-                  spectra_no, local_workspace);
-      }
+      const int64_t filestart =
+          std::lower_bound(spec_begin, m_spec_end, spectraBlock.first) -
+          spec_begin;
+      loadDetectorBlock(nxdata, period_index, filestart, rangesize, hist_index,
+                        *local_workspace);
     }
   }
 
@@ -847,43 +839,112 @@ void LoadISISNexus2::createPeriodLogs(
 }
 
 /**
- * Perform a call to nxgetslab, via the NexusClasses wrapped methods for a given
- * block-size
- * @param data :: The NXDataSet object
- * @param blocksize :: The block-size to use
- * @param period :: The period number
+ * Load the counts of a contiguous range of spectra of the detector data. The
+ * range is read in slabs through nxgetslab, and each slab is read on a
+ * separate thread while the previous one is copied into the workspace by all
+ * of the others, so the file is read at the same time as the counts are
+ * converted.
+ * @param nxdata :: The detector data group
+ * @param period :: The period index (zero based)
  * @param start :: The index within the file to start reading from (zero based)
- * @param hist :: The workspace index to start reading into
- * @param spec_num :: The spectrum number that matches the hist variable
+ * @param numSpectra :: The number of spectra to load
+ * @param hist :: The workspace index to start reading into, advanced past the
+ * loaded spectra
+ * @param local_workspace :: The workspace to fill the data with
+ */
+void LoadISISNexus2::loadDetectorBlock(
+    NXData &nxdata, int64_t period, int64_t start, int64_t numSpectra,
+    int64_t &hist, DataObjects::Workspace2D &local_workspace) {
+  // Two copies of the data set hold the slab being read and the slab being
+  // copied. They are only ever used by one thread at a time.
+  std::array<NXDataSetTyped<int>, 2> data{
+      {nxdata.openIntData(), nxdata.openIntData()}};
+  data[0].open();
+  data[1].open();
+
+  const auto bytesPerSpectrum =
+      static_cast<int64_t>(m_detBlockInfo.getNumberOfChannels() * sizeof(int));
+  const int64_t blocksize =
+      std::max(int64_t{1}, m_loadBlockBytes / std::max(bytesPerSpectrum,
+                                                       int64_t{1}));
+  const int64_t numBlocks = (numSpectra + blocksize - 1) / blocksize;
+  const auto sizeOfBlock = [blocksize, numSpectra](const int64_t block) {
+    return std::min(blocksize, numSpectra - block * blocksize);
+  };
+  const auto readBlock = [&data, &sizeOfBlock, period, start,
+                          blocksize](const int64_t block) {
+    data[block % 2].load(static_cast<int>(sizeOfBlock(block)),
+                         static_cast<int>(period),
+                         static_cast<int>(start + block * blocksize));
+  };
+
+  if (numBlocks > 0)
+    readBlock(0);
+  for (int64_t block = 0; block < numBlocks; ++block) {
+    // Read the next slab while this one is copied
+    std::exception_ptr readError;
+    std::thread reader;
+    if (block + 1 < numBlocks) {
+      reader = std::thread([&readBlock, &readError, block]() {
+        try {
+          readBlock(block + 1);
+        } catch (...) {
+          readError = std::current_exception();
+        }
+      });
+    }
+    try {
+      copyBlock(data[block % 2], sizeOfBlock(block), hist, local_workspace);
+    } catch (...) {
+      if (reader.joinable())
+        reader.join();
+      throw;
+    }
+    hist += sizeOfBlock(block);
+    if (reader.joinable())
+      reader.join();
+    if (readError)
+      std::rethrow_exception(readError);
+  }
+}
+
+/**
+ * Copy the counts of a slab of spectra read from the file into the workspace,
+ * in parallel. All of the spectra share the time-of-flight bin edges.
+ * @param data :: The data set holding the slab
+ * @param blocksize :: The number of spectra in the slab
+ * @param hist :: The workspace index of the first spectrum of the slab
  * @param local_workspace :: The workspace to fill the data with
  */
-void LoadISISNexus2::loadBlock(NXDataSetTyped<int> &data, int64_t blocksize,
-                               int64_t period, int64_t start, int64_t &hist,
-                               int64_t &spec_num,
-                               DataObjects::Workspace2D_sptr &local_workspace) {
-  data.load(static_cast<int>(blocksize), static_cast<int>(period),
-            static_cast<int>(start)); // TODO this is just wrong
-  int *data_start = data();
-  int *data_end = data_start + m_loadBlockInfo.getNumberOfChannels();
-  int64_t final(hist + blocksize);
-  while (hist < final) {
-    m_progress->report("Loading data");
-    local_workspace->setHistogram(hist, BinEdges(m_tof_data),
-                                  Counts(data_start, data_end));
-    data_start += m_detBlockInfo.getNumberOfChannels();
-    data_end += m_detBlockInfo.getNumberOfChannels();
+void LoadISISNexus2::copyBlock(const NXDataSetTyped<int> &data,
+                               int64_t blocksize, int64_t hist,
+                               DataObjects::Workspace2D &local_workspace) {
+  const int *const slab = data();
+  const auto stride =
+      static_cast<int64_t>(m_detBlockInfo.getNumberOfChannels());
+  const auto numChannels =
+      static_cast<int64_t>(m_loadBlockInfo.getNumberOfChannels());
+  const BinEdges binEdges(m_tof_data);
+
+  PARALLEL_FOR_IF(Kernel::threadSafe(local_workspace))
+  for (int64_t i = 0; i < blocksize; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const int *const counts = slab + i * stride;
+    const auto index = static_cast<size_t>(hist + i);
+    local_workspace.setHistogram(index, binEdges,
+                                 Counts(counts, counts + numChannels));
     if (m_load_selected_spectra) {
-      auto &spec = local_workspace->getSpectrum(hist);
-      specnum_t specNum = m_wsInd2specNum_map.at(hist);
+      auto &spec = local_workspace.getSpectrum(index);
+      specnum_t specNum = m_wsInd2specNum_map.at(hist + i);
       // set detectors corresponding to spectra Number
       spec.setDetectorIDs(m_spec2det_map.getDetectorIDsForSpectrumNo(specNum));
       // set correct spectra Number
       spec.setSpectrumNo(specNum);
     }
-
-    ++hist;
-    ++spec_num;
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
+  m_progress->reportIncrement(static_cast<size_t>(blocksize), "Loading data");
 }
 
 /// Run the Child Algorithm LoadInstrument (or LoadInstrumentFromNexus)
@@ -9,6 +9,8 @@
 #include "MantidAPI/LogManager.h"
 #include "MantidAPI/Run.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include <locale>
 #include <nexus/NeXusException.hpp>
@@ -22,6 +24,10 @@
 #include <boost/scoped_array.hpp>
 
 #include <algorithm>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <set>
 
 namespace Mantid {
 namespace DataHandling {
@@ -132,55 +138,71 @@ bool isControlValue(const char &c, const std::string &propName,
   }
 }
 
+/// The contents of an NXlog entry as read from the file, before conversion to
+/// a property
+struct RawLog {
+  /// The name of the property
+  std::string name;
+  /// The start time of the log as an ISO8601 string
+  std::string start;
+  std::string timeUnits;
+  std::vector<double> times;
+  std::string valueUnits;
+  /// The type of the values
+  ::NeXus::NXnumtype type = ::NeXus::FLOAT64;
+  bool isInt = false;
+  std::vector<int> intValues;
+  std::vector<double> doubleValues;
+  /// Character values, with itemLength characters for each time
+  std::string charValues;
+  int64_t itemLength = 0;
+  /// The value_valid entry, empty if there is none
+  std::vector<int> validity;
+};
+
 /**
- * Creates a time series property from the currently opened log entry. It is
- * assumed to
- * have been checked to have a time field and the value entry's name is given
- * as an argument
+ * Reads the time and value entries of the currently opened log entry. It is
+ * assumed to have been checked to have a time field and the value entry's name
+ * is given as an argument
  * @param file :: A reference to the file handle
  * @param propName :: The name of the property
  * @param freqStart :: A string containing the start time of the frequency log
  * on SNAP
  * @param log :: Reference to logger to print out to
- * @returns A pointer to a new property containing the time series
+ * @returns The contents of the log entry
  */
-std::unique_ptr<Kernel::Property> createTimeSeries(::NeXus::File &file,
-                                                   const std::string &propName,
-                                                   const std::string &freqStart,
-                                                   Kernel::Logger &log) {
+RawLog readRawLog(::NeXus::File &file, const std::string &propName,
+                  const std::string &freqStart, Kernel::Logger &log) {
+  RawLog raw;
+  raw.name = propName;
   file.openData("time");
   //----- Start time is an ISO8601 string date and time. ------
-  std::string start;
   try {
-    file.getAttr("start", start);
+    file.getAttr("start", raw.start);
   } catch (::NeXus::Exception &) {
     // Some logs have "offset" instead of start
     try {
-      file.getAttr("offset", start);
+      file.getAttr("offset", raw.start);
     } catch (::NeXus::Exception &) {
       log.warning() << "Log entry has no start time indicated.\n";
       file.closeData();
       throw;
     }
   }
-  if (start == "No Time") {
-    start = freqStart;
+  if (raw.start == "No Time") {
+    raw.start = freqStart;
   }
 
-  // Convert to date and time
-  Types::Core::DateAndTime start_time = Types::Core::DateAndTime(start);
-  std::string time_units;
-  file.getAttr("units", time_units);
-  if (time_units.compare("second") < 0 && time_units != "s" &&
-      time_units != "minutes") // Can be s/second/seconds/minutes
+  file.getAttr("units", raw.timeUnits);
+  if (raw.timeUnits.compare("second") < 0 && raw.timeUnits != "s" &&
+      raw.timeUnits != "minutes") // Can be s/second/seconds/minutes
   {
     file.closeData();
-    throw ::NeXus::Exception("Unsupported time unit '" + time_units + "'");
+    throw ::NeXus::Exception("Unsupported time unit '" + raw.timeUnits + "'");
   }
   //--- Load the seconds into a double array ---
-  std::vector<double> time_double;
   try {
-    file.getDataCoerce(time_double);
+    file.getDataCoerce(raw.times);
   } catch (::NeXus::Exception &e) {
     log.warning() << "Log entry's time field could not be loaded: '" << e.what()
                   << "'.\n";
@@ -190,115 +212,115 @@ std::unique_ptr<Kernel::Property> createTimeSeries(::NeXus::File &file,
   file.closeData(); // Close time data
   log.debug() << "   done reading \"time\" array\n";
 
-  // Convert to seconds if needed
-  if (time_units == "minutes") {
-    using std::placeholders::_1;
-    std::transform(time_double.begin(), time_double.end(), time_double.begin(),
-                   std::bind(std::multiplies<double>(), _1, 60.0));
-  }
-
   // Now the values: Could be a string, int or double
   file.openData("value");
   // Get the units of the property
-  std::string value_units;
   try {
-    file.getAttr("units", value_units);
+    file.getAttr("units", raw.valueUnits);
   } catch (::NeXus::Exception &) {
     // Ignore missing units field.
-    value_units = "";
+    raw.valueUnits = "";
   }
 
   // Now the actual data
   ::NeXus::Info info = file.getInfo();
+  raw.type = info.type;
   // Check the size
-  if (size_t(info.dims[0]) != time_double.size()) {
+  if (size_t(info.dims[0]) != raw.times.size()) {
     file.closeData();
     throw ::NeXus::Exception("Invalid value entry for time series");
   }
-  if (file.isDataInt()) // Int type
-  {
-    std::vector<int> values;
-    try {
-      file.getDataCoerce(values);
-      file.closeData();
-    } catch (::NeXus::Exception &) {
-      file.closeData();
-      throw;
-    }
-    // Make an int TSP
-    auto tsp = std::make_unique<TimeSeriesProperty<int>>(propName);
-    tsp->create(start_time, time_double, values);
-    tsp->setUnits(value_units);
-    log.debug() << "   done reading \"value\" array\n";
-    return tsp;
-  } else if (info.type == ::NeXus::CHAR) {
-    std::string values;
-    const int64_t item_length = info.dims[1];
-    try {
-      const int64_t nitems = info.dims[0];
-      const int64_t total_length = nitems * item_length;
+  try {
+    if (file.isDataInt()) // Int type
+    {
+      raw.isInt = true;
+      file.getDataCoerce(raw.intValues);
+    } else if (info.type == ::NeXus::CHAR) {
+      raw.itemLength = info.dims[1];
+      const int64_t total_length = info.dims[0] * raw.itemLength;
       boost::scoped_array<char> val_array(new char[total_length]);
       file.getData(val_array.get());
-      file.closeData();
-      values = std::string(val_array.get(), total_length);
-    } catch (::NeXus::Exception &) {
-      file.closeData();
-      throw;
+      raw.charValues = std::string(val_array.get(), total_length);
+    } else if (info.type == ::NeXus::FLOAT32 ||
+               info.type == ::NeXus::FLOAT64) {
+      file.getDataCoerce(raw.doubleValues);
+    } else {
+      throw ::NeXus::Exception(
+          "Invalid value type for time series. Only int, double or strings "
+          "are supported");
     }
+  } catch (::NeXus::Exception &) {
+    file.closeData();
+    throw;
+  }
+  file.closeData();
+  log.debug() << "   done reading \"value\" array\n";
+  return raw;
+}
+
+/**
+ * Creates a time series property from a log entry read by readRawLog. This
+ * does not use the file so may be called concurrently for different logs.
+ * @param raw :: The contents of the log entry
+ * @param log :: Reference to logger to print out to
+ * @returns A pointer to a new property containing the time series
+ */
+std::unique_ptr<Kernel::Property> createTimeSeries(const RawLog &raw,
+                                                   Kernel::Logger &log) {
+  // Convert to date and time
+  Types::Core::DateAndTime start_time = Types::Core::DateAndTime(raw.start);
+  // Convert to seconds if needed
+  std::vector<double> time_double;
+  const std::vector<double> *times = &raw.times;
+  if (raw.timeUnits == "minutes") {
+    time_double.reserve(raw.times.size());
+    std::transform(raw.times.cbegin(), raw.times.cend(),
+                   std::back_inserter(time_double),
+                   [](const double time) { return time * 60.0; });
+    times = &time_double;
+  }
+
+  if (raw.isInt) {
+    // Make an int TSP
+    auto tsp = std::make_unique<TimeSeriesProperty<int>>(raw.name);
+    tsp->create(start_time, *times, raw.intValues);
+    tsp->setUnits(raw.valueUnits);
+    return tsp;
+  } else if (raw.type == ::NeXus::CHAR) {
     // The string may contain non-printable (i.e. control) characters, replace
     // these
+    std::string values = raw.charValues;
     std::replace_if(
         values.begin(), values.end(),
-        [&](const char &c) { return isControlValue(c, propName, log); }, ' ');
-    auto tsp = std::make_unique<TimeSeriesProperty<std::string>>(propName);
-    std::vector<DateAndTime> times;
-    DateAndTime::createVector(start_time, time_double, times);
-    const size_t ntimes = times.size();
+        [&](const char &c) { return isControlValue(c, raw.name, log); }, ' ');
+    auto tsp = std::make_unique<TimeSeriesProperty<std::string>>(raw.name);
+    std::vector<DateAndTime> dates;
+    DateAndTime::createVector(start_time, *times, dates);
+    const size_t ntimes = dates.size();
     for (size_t i = 0; i < ntimes; ++i) {
       std::string value_i =
-          std::string(values.data() + i * item_length, item_length);
-      tsp->addValue(times[i], value_i);
-    }
-    tsp->setUnits(value_units);
-    log.debug() << "   done reading \"value\" array\n";
-    return tsp;
-  } else if (info.type == ::NeXus::FLOAT32 || info.type == ::NeXus::FLOAT64) {
-    std::vector<double> values;
-    try {
-      file.getDataCoerce(values);
-      file.closeData();
-    } catch (::NeXus::Exception &) {
-      file.closeData();
-      throw;
+          std::string(values.data() + i * raw.itemLength, raw.itemLength);
+      tsp->addValue(dates[i], value_i);
     }
-    auto tsp = std::make_unique<TimeSeriesProperty<double>>(propName);
-    tsp->create(start_time, time_double, values);
-    tsp->setUnits(value_units);
-    log.debug() << "   done reading \"value\" array\n";
+    tsp->setUnits(raw.valueUnits);
     return tsp;
   } else {
-    throw ::NeXus::Exception(
-        "Invalid value type for time series. Only int, double or strings are "
-        "supported");
+    auto tsp = std::make_unique<TimeSeriesProperty<double>>(raw.name);
+    tsp->create(start_time, *times, raw.doubleValues);
+    tsp->setUnits(raw.valueUnits);
+    return tsp;
   }
 }
 
 /**
- * Creates a time series validity filter property from the currently opened log
- * entry. It is assumed to have been checked to have a time field and the value
- * entry's name is given as an argument
+ * Reads the validity of the values of the currently opened log entry into
+ * raw. If the entry has no validity array, or it cannot be read, all values
+ * are taken to be valid.
  * @param file :: A reference to the file handle
- * @param prop :: The property to check for a validity array
+ * @param raw :: The log entry read by readRawLog
  * @param log :: Reference to logger to print out to
- * @returns A pointer to a new property containing the time series filter or
- * null
  */
-std::unique_ptr<Kernel::Property> createTimeSeriesValidityFilter(
-    ::NeXus::File &file, const Kernel::Property &prop, Kernel::Logger &log) {
-  const auto tsProp = dynamic_cast<const Kernel::ITimeSeriesProperty *>(&prop);
-  const auto times = tsProp->timesAsVector();
-  std::vector<int> values;
-  std::vector<bool> boolValues;
+void readRawValidity(::NeXus::File &file, RawLog &raw, Kernel::Logger &log) {
   // Now the the validity of the values
   // this should be a match int array to the data values (or times)
   // If not present assume all data is valid
@@ -308,53 +330,57 @@ std::unique_ptr<Kernel::Property> createTimeSeriesValidityFilter(
     // Now the validity data
     ::NeXus::Info info = file.getInfo();
     // Check the size
-    if (size_t(info.dims[0]) != times.size()) {
+    if (size_t(info.dims[0]) != raw.times.size()) {
       throw ::NeXus::Exception("Invalid value entry for validity data");
     }
     if (file.isDataInt()) // Int type
     {
-      try {
-        file.getDataCoerce(values);
-        file.closeData();
-      } catch (::NeXus::Exception &) {
-        throw;
-      }
+      file.getDataCoerce(raw.validity);
+      file.closeData();
     } else {
       throw ::NeXus::Exception(
           "Invalid value type for validity data. Only int is supported");
     }
   } catch (::NeXus::Exception &ex) {
+    raw.validity.clear();
     std::string error_msg = ex.what();
     if (error_msg != "NXopendata(value_valid) failed") {
       log.warning() << error_msg << "\n";
       file.closeData();
-      // no data found
-      return std::unique_ptr<Kernel::Property>(nullptr);
     }
   }
+}
 
-  bool invalidDataFound = false;
-  boolValues.reserve(values.size());
+/**
+ * Creates a time series validity filter property from a log entry read by
+ * readRawLog and readRawValidity.
+ * @param raw :: The contents of the log entry
+ * @param prop :: The property created from the log entry
+ * @param log :: Reference to logger to print out to
+ * @returns A pointer to a new property containing the time series filter or
+ * null
+ */
+std::unique_ptr<Kernel::Property>
+createTimeSeriesValidityFilter(const RawLog &raw, const Kernel::Property &prop,
+                               Kernel::Logger &log) {
   // convert the integer values to boolean with 0=invalid data
-  for (size_t i = 0; i < values.size(); i++) {
-    bool isInvalidData = (values[i] == 0);
-    boolValues.emplace_back(!isInvalidData);
-    if (isInvalidData && !invalidDataFound) {
-      invalidDataFound = true;
-    }
-  }
-  if (invalidDataFound) {
-    const auto tspName =
-        API::LogManager::getInvalidValuesFilterLogName(prop.name());
-    auto tsp = std::make_unique<TimeSeriesProperty<bool>>(tspName);
-    tsp->create(times, boolValues);
-    log.debug() << "   done reading \"value_valid\" array\n";
-
-    return tsp;
-  } else {
+  if (std::none_of(raw.validity.cbegin(), raw.validity.cend(),
+                   [](const int value) { return value == 0; })) {
     // no data found
     return std::unique_ptr<Kernel::Property>(nullptr);
   }
+  std::vector<bool> boolValues;
+  boolValues.reserve(raw.validity.size());
+  for (const auto value : raw.validity) {
+    boolValues.emplace_back(value != 0);
+  }
+  const auto tsProp = dynamic_cast<const Kernel::ITimeSeriesProperty *>(&prop);
+  const auto tspName =
+      API::LogManager::getInvalidValuesFilterLogName(prop.name());
+  auto tsp = std::make_unique<TimeSeriesProperty<bool>>(tspName);
+  tsp->create(tsProp->timesAsVector(), boolValues);
+  log.debug() << "   done reading \"value_valid\" array\n";
+  return tsp;
 }
 
 /**
@@ -365,23 +391,34 @@ std::unique_ptr<Kernel::Property> createTimeSeriesValidityFilter(
  * This is a workaround to ensure that time series averaging of log values works
  * correctly for instruments who do not record log values for the entire run.
  *
- * If the run does not have an end time or if the last time of the time series
- * log is the same as the end time the property is left unmodified.
+ * If the last time of the time series log is the same as the end time the
+ * property is left unmodified.
+ *
+ * @param prop :: a pointer to a TimeSeriesProperty to modify
+ * @param endTime :: the end time of the run
+ */
+void appendEndTimeLog(Kernel::Property *prop,
+                      const Types::Core::DateAndTime &endTime) {
+  auto tsLog = dynamic_cast<TimeSeriesProperty<double> *>(prop);
+  // First check if it is valid to add a additional log entry
+  if (!tsLog || tsLog->size() == 0 || endTime <= tsLog->lastTime() ||
+      prop->name() == "proton_charge")
+    return;
+
+  tsLog->addValue(endTime, tsLog->lastValue());
+}
+
+/**
+ * Appends an additional entry at the end time of the run to a
+ * TimeSeriesProperty, as above. If the run does not have an end time the
+ * property is left unmodified.
  *
  * @param prop :: a pointer to a TimeSeriesProperty to modify
  * @param run :: handle to the run object containing the end time.
  */
 void appendEndTimeLog(Kernel::Property *prop, const API::Run &run) {
   try {
-    auto tsLog = dynamic_cast<TimeSeriesProperty<double> *>(prop);
-    const auto endTime = run.endTime();
-
-    // First check if it is valid to add a additional log entry
-    if (!tsLog || tsLog->size() == 0 || endTime <= tsLog->lastTime() ||
-        prop->name() == "proton_charge")
-      return;
-
-    tsLog->addValue(endTime, tsLog->lastValue());
+    appendEndTimeLog(prop, run.endTime());
   } catch (const Exception::NotFoundError &) {
     // pass
   } catch (const std::runtime_error &) {
@@ -409,6 +446,40 @@ void readStartAndEndTime(::NeXus::File &file, API::Run &run) {
   }
 }
 
+/// Logs that are used while loading, which are never deferred
+const std::set<std::string> LOGS_USED_ON_LOAD{"frequency", "period_log",
+                                              "proton_charge", "proton_log"};
+/// Reports on deferred logs, which are created after the algorithm has
+/// finished
+Kernel::Logger g_deferredLog("LoadNexusLogs");
+
+/**
+ * Add a log to the run that is only converted to a property when it is first
+ * accessed. The values have already been read so the file is not opened
+ * again.
+ * @param run :: The run to add the log to
+ * @param raw :: The contents of the NXlog entry
+ * @param overwrite :: If true an existing log of the same name is replaced
+ */
+void addDeferredLog(API::Run &run, RawLog raw, const bool overwrite) {
+  std::optional<DateAndTime> endTime;
+  try {
+    endTime = run.endTime();
+  } catch (const std::runtime_error &) {
+    // The log is not extended to the end of the run
+  }
+  const auto name = raw.name;
+  // Shared so that the function creating the log can be copied
+  auto values = std::make_shared<const RawLog>(std::move(raw));
+  auto create = [values, endTime]() {
+    auto logValue = createTimeSeries(*values, g_deferredLog);
+    if (endTime)
+      appendEndTimeLog(logValue.get(), *endTime);
+    return logValue;
+  };
+  run.addDeferredProperty(name, create, overwrite);
+}
+
 } // End of anonymous namespace
 
 /// Empty default constructor
@@ -433,6 +504,12 @@ void LoadNexusLogs::init() {
   declareProperty(std::make_unique<PropertyWithValue<std::string>>(
                       "NXentryName", "", Direction::Input),
                   "Entry in the nexus file from which to read the logs");
+  auto mustBePositive = std::make_shared<BoundedValidator<int>>();
+  mustBePositive->setLower(0);
+  declareProperty("DeferredLogSize", EMPTY_INT(), mustBePositive,
+                  "NXlog entries with more values than this are only "
+                  "converted to logs when they are first used. By default "
+                  "all logs are converted immediately.");
 }
 
 /** Executes the algorithm. Reading in the file and creating and populating
@@ -775,11 +852,11 @@ void LoadNexusLogs::loadLogs(
   const std::map<std::string, std::set<std::string>> &allEntries =
       getFileInfo()->getAllEntries();
 
-  auto lf_LoadByLogClass = [&](const std::string &logClass,
-                               const bool isNxLog) {
+  auto lf_FindByLogClass = [&](const std::string &logClass) {
+    std::vector<std::string> logs;
     auto itLogClass = allEntries.find(logClass);
     if (itLogClass == allEntries.end()) {
-      return;
+      return logs;
     }
     const std::set<std::string> &logsSet = itLogClass->second;
     auto itPrefixBegin = logsSet.lower_bound(absolute_entry_name);
@@ -790,95 +867,138 @@ void LoadNexusLogs::loadLogs(
          ++it) {
       // must be third level entry
       if (std::count(it->begin(), it->end(), '/') == 3) {
-        if (isNxLog) {
-          loadNXLog(file, *it, logClass, workspace);
-        } else {
-          loadSELog(file, *it, workspace);
-        }
+        logs.emplace_back(*it);
       }
     }
+    return logs;
   };
 
   const std::string entry_name =
       absolute_entry_name.substr(absolute_entry_name.find_last_of("/") + 1);
   file.openGroup(entry_name, entry_class);
-  lf_LoadByLogClass("NXlog", true);
-  lf_LoadByLogClass("NXpositioner", true);
-  lf_LoadByLogClass("IXseblock", false);
+  std::vector<std::pair<std::string, std::string>> nxLogs;
+  for (const std::string logClass : {"NXlog", "NXpositioner"}) {
+    for (const auto &log : lf_FindByLogClass(logClass)) {
+      nxLogs.emplace_back(log, logClass);
+    }
+  }
+  loadNXLogs(file, nxLogs, workspace);
+  for (const auto &log : lf_FindByLogClass("IXseblock")) {
+    loadSELog(file, log, workspace);
+  }
   loadVetoPulses(file, workspace);
 
   file.closeGroup();
 }
 
 /**
- * Load an NX log entry a group type that has value and time entries.
+ * Load NX log entries, group types that have value and time entries. The
+ * entries are read from the file one at a time and then converted to
+ * properties in parallel.
  * @param file :: A reference to the NeXus file handle opened at the parent
  * group
- * @param absolute_entry_name :: The name of the log entry
- * @param entry_class :: The type of the entry
+ * @param entries :: The names of the log entries and their types
  * @param workspace :: A pointer to the workspace to store the logs
  */
-void LoadNexusLogs::loadNXLog(
-    ::NeXus::File &file, const std::string &absolute_entry_name,
-    const std::string &entry_class,
+void LoadNexusLogs::loadNXLogs(
+    ::NeXus::File &file,
+    const std::vector<std::pair<std::string, std::string>> &entries,
     const std::shared_ptr<API::MatrixWorkspace> &workspace) const {
-
-  const std::string entry_name =
-      absolute_entry_name.substr(absolute_entry_name.find_last_of("/") + 1);
-  g_log.debug() << "processing " << entry_name << ":" << entry_class << "\n";
-  file.openGroup(entry_name, entry_class);
-  // Validate the NX log class.
-  // Just verify that time and value entries exist
-  const std::string timeEntry = absolute_entry_name + "/time";
-  const std::string valueEntry = absolute_entry_name + "/value";
-  bool foundValue = false;
-  bool foundTime = false;
-
   const std::map<std::string, std::set<std::string>> &allEntries =
       getFileInfo()->getAllEntries();
-  // reverse search to take advantage of the fact that these are located in SDS
-  for (auto it = allEntries.rbegin(); it != allEntries.rend(); ++it) {
-    const std::set<std::string> &entriesSet = it->second;
-    if (entriesSet.count(timeEntry) == 1) {
-      foundTime = true;
+  auto lf_HasEntry = [&allEntries](const std::string &name) {
+    // reverse search to take advantage of the fact that these are located in
+    // SDS
+    return std::any_of(allEntries.rbegin(), allEntries.rend(),
+                       [&name](const auto &classEntries) {
+                         return classEntries.second.count(name) == 1;
+                       });
+  };
+
+  // whether or not to overwrite logs on workspace
+  const bool overwritelogs = this->getProperty("OverwriteLogs");
+  const bool deferLogs = !isDefault("DeferredLogSize");
+  const int deferredLogSize = getProperty("DeferredLogSize");
+  auto &run = workspace->mutableRun();
+
+  // The file cannot be read concurrently so read all of the entries first
+  std::vector<std::string> names;
+  std::vector<RawLog> rawLogs;
+  for (const auto &entry : entries) {
+    const std::string &absolute_entry_name = entry.first;
+    const std::string entry_name =
+        absolute_entry_name.substr(absolute_entry_name.find_last_of("/") + 1);
+    g_log.debug() << "processing " << entry_name << ":" << entry.second
+                  << "\n";
+    // Validate the NX log class.
+    // Just verify that time and value entries exist
+    if (!lf_HasEntry(absolute_entry_name + "/time") ||
+        !lf_HasEntry(absolute_entry_name + "/value")) {
+      g_log.warning() << "Invalid NXlog entry " << entry_name
+                      << " found. Did not contain 'value' and 'time'.\n";
+      continue;
     }
-    if (entriesSet.count(valueEntry) == 1) {
-      foundValue = true;
+    if (!overwritelogs && run.hasProperty(entry_name)) {
+      continue;
     }
-    if (foundTime && foundValue) {
-      break;
+
+    file.openGroup(entry_name, entry.second);
+    try {
+      auto raw = readRawLog(file, entry_name, freqStart, g_log);
+      // Logs with a validity filter are never deferred as the filter is a
+      // separate log
+      if (deferLogs && LOGS_USED_ON_LOAD.count(entry_name) == 0 &&
+          !lf_HasEntry(absolute_entry_name + "/value_valid") &&
+          raw.times.size() > static_cast<size_t>(deferredLogSize)) {
+        addDeferredLog(run, std::move(raw), overwritelogs);
+      } else {
+        readRawValidity(file, raw, g_log);
+        rawLogs.emplace_back(std::move(raw));
+        names.emplace_back(entry_name);
+      }
+    } catch (::NeXus::Exception &e) {
+      g_log.warning() << "NXlog entry " << entry_name
+                      << " gave an error when loading:'" << e.what() << "'.\n";
     }
+    file.closeGroup();
   }
 
-  if (!foundTime || !foundValue) {
-    g_log.warning() << "Invalid NXlog entry " << entry_name
-                    << " found. Did not contain 'value' and 'time'.\n";
-    file.closeGroup();
-    return;
+  const auto numberOfLogs = static_cast<int>(rawLogs.size());
+  std::vector<std::unique_ptr<Kernel::Property>> logValues(numberOfLogs);
+  std::vector<std::unique_ptr<Kernel::Property>> validityLogValues(
+      numberOfLogs);
+  std::vector<std::exception_ptr> errors(numberOfLogs);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < numberOfLogs; ++i) {
+    // Release the values read as soon as they have been converted
+    const auto raw = std::move(rawLogs[i]);
+    try {
+      logValues[i] = createTimeSeries(raw, g_log);
+      validityLogValues[i] =
+          createTimeSeriesValidityFilter(raw, *logValues[i], g_log);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
   }
 
-  // whether or not to overwrite logs on workspace
-  bool overwritelogs = this->getProperty("OverwriteLogs");
-  try {
-    if (overwritelogs || !(workspace->run().hasProperty(entry_name))) {
-      auto logValue = createTimeSeries(file, entry_name, freqStart, g_log);
-      auto validityLogValue =
-          createTimeSeriesValidityFilter(file, *logValue, g_log);
-      if (validityLogValue) {
-        appendEndTimeLog(validityLogValue.get(), workspace->run());
-        workspace->mutableRun().addProperty(std::move(validityLogValue),
-                                            overwritelogs);
-        m_logsWithInvalidValues.emplace_back(entry_name);
+  // Add the logs in the order of the entries
+  for (int i = 0; i < numberOfLogs; ++i) {
+    try {
+      if (errors[i]) {
+        std::rethrow_exception(errors[i]);
       }
-      appendEndTimeLog(logValue.get(), workspace->run());
-      workspace->mutableRun().addProperty(std::move(logValue), overwritelogs);
+      if (validityLogValues[i]) {
+        appendEndTimeLog(validityLogValues[i].get(), run);
+        run.addProperty(std::move(validityLogValues[i]), overwritelogs);
+        m_logsWithInvalidValues.emplace_back(names[i]);
+      }
+      appendEndTimeLog(logValues[i].get(), run);
+      run.addProperty(std::move(logValues[i]), overwritelogs);
+    } catch (::NeXus::Exception &e) {
+      g_log.warning() << "NXlog entry " << names[i]
+                      << " gave an error when loading:'" << e.what() << "'.\n";
     }
-  } catch (::NeXus::Exception &e) {
-    g_log.warning() << "NXlog entry " << entry_name
-                    << " gave an error when loading:'" << e.what() << "'.\n";
   }
-
-  file.closeGroup();
 }
 
 void LoadNexusLogs::loadSELog(
@@ -927,9 +1047,11 @@ void LoadNexusLogs::loadSELog(
         throw;
       }
 
-      logValue = createTimeSeries(file, propName, freqStart, g_log);
+      auto raw = readRawLog(file, propName, freqStart, g_log);
+      readRawValidity(file, raw, g_log);
+      logValue = createTimeSeries(raw, g_log);
       auto validityLogValue =
-          createTimeSeriesValidityFilter(file, *logValue, g_log);
+          createTimeSeriesValidityFilter(raw, *logValue, g_log);
       if (validityLogValue) {
         appendEndTimeLog(validityLogValue.get(), workspace->run());
         workspace->mutableRun().addProperty(std::move(validityLogValue));
@@ -34,10 +34,13 @@
 #include "MantidNexus/NexusClasses.h"
 #include "MantidNexus/NexusFileIO.h"
 
+#include <H5Cpp.h>
+#include <Poco/File.h>
 #include <boost/regex.hpp>
 
 #include <nexus/NeXusException.hpp>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -175,13 +178,153 @@ bool isMultiPeriodFile(int nWorkspaceEntries, const Workspace_sptr &sampleWS,
   return isMultiPeriod;
 }
 
+/// The approximate number of bytes of Y values read at once by a lazy load
+constexpr size_t LAZY_BLOCK_BYTES = 1 << 20;
+
+/**
+ * Open the file through HDF5 for reading. A file opened through the NeXus API
+ * can only be opened again with the same, strong, close degree, and a file
+ * opened elsewhere with the default close degree only with that.
+ * @param filename :: The name of the file
+ * @return The open file
+ */
+H5::H5File openForReading(const std::string &filename) {
+  H5::Exception::dontPrint();
+  try {
+    H5::FileAccPropList access;
+    access.setFcloseDegree(H5F_CLOSE_STRONG);
+    return H5::H5File(filename, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT,
+                      access);
+  } catch (const H5::FileIException &) {
+    return H5::H5File(filename, H5F_ACC_RDONLY);
+  }
+}
+
+/**
+ * Read consecutive rows of a two-dimensional dataset of doubles
+ * @param group :: The group containing the dataset
+ * @param name :: The name of the dataset
+ * @param first :: The first row
+ * @param count :: The number of rows
+ * @param columns :: Set to the number of values in each row
+ * @return The values of the rows
+ */
+std::vector<double> readRows(const H5::Group &group, const std::string &name,
+                             const hsize_t first, const hsize_t count,
+                             hsize_t &columns) {
+  const auto dataset = group.openDataSet(name);
+  auto space = dataset.getSpace();
+  if (space.getSimpleExtentNdims() != 2)
+    throw std::runtime_error(name + " is not two-dimensional");
+  hsize_t dims[2];
+  space.getSimpleExtentDims(dims);
+  columns = dims[1];
+  const hsize_t offset[2] = {first, 0};
+  const hsize_t size[2] = {count, columns};
+  space.selectHyperslab(H5S_SELECT_SET, size, offset);
+  std::vector<double> values(count * columns);
+  dataset.read(values.data(), H5::PredType::NATIVE_DOUBLE,
+               H5::DataSpace(2, size), space);
+  return values;
+}
+
+/**
+ * Reads blocks of spectra of a processed Workspace2D from its file, which is
+ * opened for each block so that no handle is left open between accesses.
+ */
+class ProcessedBlockReader : public LazyWorkspace2D::BlockReader {
+public:
+  ProcessedBlockReader(const std::string &filename,
+                       const std::string &groupPath, const bool commonBins,
+                       const bool hasXErrors)
+      : m_filename(filename), m_groupPath(groupPath), m_commonBins(commonBins),
+        m_hasXErrors(hasXErrors),
+        m_modified(
+            Poco::File(filename).getLastModified().epochMicroseconds()),
+        m_fileSize(Poco::File(filename).getSize()) {
+    const auto values =
+        openForReading(filename).openGroup(groupPath).openDataSet("values");
+    hsize_t dims[2] = {0, 0};
+    values.getSpace().getSimpleExtentDims(dims);
+    // Read whole chunks of the dataset, and about LAZY_BLOCK_BYTES at once
+    hsize_t chunkRows = 1;
+    const auto plist = values.getCreatePlist();
+    if (plist.getLayout() == H5D_CHUNKED) {
+      hsize_t chunk[2];
+      plist.getChunk(2, chunk);
+      chunkRows = std::max<hsize_t>(chunk[0], 1);
+    }
+    const auto rowBytes = std::max<hsize_t>(dims[1], 1) * sizeof(double);
+    const auto rows = std::max<hsize_t>(LAZY_BLOCK_BYTES / rowBytes, 1);
+    m_blockSize = static_cast<size_t>((rows + chunkRows - 1) / chunkRows *
+                                      chunkRows);
+  }
+
+  size_t blockSize() const override { return m_blockSize; }
+
+  bool hasCommonBins() const override { return m_commonBins; }
+
+  std::vector<LazyWorkspace2D::SpectrumData> read(size_t first,
+                                                  size_t count) override {
+    const Poco::File file(m_filename);
+    if (!file.exists() ||
+        file.getLastModified().epochMicroseconds() != m_modified ||
+        file.getSize() != m_fileSize)
+      throw std::runtime_error("The file " + m_filename +
+                               " has changed since the workspace was loaded");
+    const auto group = openForReading(m_filename).openGroup(m_groupPath);
+    hsize_t nchannels = 0, xlength = 0, dxlength = 0;
+    const auto y = readRows(group, "values", first, count, nchannels);
+    const auto e = readRows(group, "errors", first, count, nchannels);
+    std::vector<double> x, dx;
+    if (!m_commonBins)
+      x = readRows(group, "axis1", first, count, xlength);
+    if (m_hasXErrors)
+      dx = readRows(group, "xerrors", first, count, dxlength);
+
+    std::vector<LazyWorkspace2D::SpectrumData> spectra(count);
+    for (size_t i = 0; i < count; ++i) {
+      auto &spectrum = spectra[i];
+      const auto *yStart = y.data() + i * nchannels;
+      spectrum.y = make_cow<HistogramData::HistogramY>(yStart,
+                                                       yStart + nchannels);
+      const auto *eStart = e.data() + i * nchannels;
+      spectrum.e = make_cow<HistogramData::HistogramE>(eStart,
+                                                       eStart + nchannels);
+      if (!m_commonBins) {
+        const auto *xStart = x.data() + i * xlength;
+        spectrum.x =
+            make_cow<HistogramData::HistogramX>(xStart, xStart + xlength);
+      }
+      // Legacy files hold an X error for each bin edge. The last is dropped.
+      if (m_hasXErrors) {
+        const auto *dxStart = dx.data() + i * dxlength;
+        spectrum.dx = make_cow<HistogramData::HistogramDx>(
+            dxStart, dxStart + std::min(dxlength, nchannels));
+      }
+    }
+    return spectra;
+  }
+
+private:
+  const std::string m_filename;
+  const std::string m_groupPath;
+  const bool m_commonBins;
+  const bool m_hasXErrors;
+  /// The file must be unchanged when the spectra are read
+  const int64_t m_modified;
+  const uint64_t m_fileSize;
+  size_t m_blockSize;
+};
+
 } // namespace
 
 /// Default constructor
 LoadNexusProcessed::LoadNexusProcessed()
     : m_shared_bins(false), m_xbins(0), m_axis1vals(), m_list(false),
       m_interval(false), m_spec_min(0), m_spec_max(Mantid::EMPTY_INT()),
-      m_spec_list(), m_filtered_spec_idxs(), m_nexusFile() {}
+      m_spec_list(), m_filtered_spec_idxs(), m_nexusFile(), m_lazy(false),
+      m_lazyReader() {}
 
 /// Destructor defined here so that NeXus::File can be forward declared
 /// in header
@@ -247,6 +390,11 @@ void LoadNexusProcessed::init() {
       "For multiperiod workspaces. Copy instrument, parameter and x-data "
       "rather than loading it directly for each workspace. Y, E and log "
       "information is always loaded.");
+  declareProperty(
+      "Lazy", false,
+      "If true, the spectra of a single Workspace2D are read from the file "
+      "the first time they are accessed rather than all at once. The file "
+      "must not be modified while the workspace is in use.");
 }
 
 /**
@@ -425,6 +573,10 @@ void LoadNexusProcessed::exec() {
     os << basename << entrynumber;
     const std::string targetEntryName = os.str();
 
+    // Spectra are only read on access if a single workspace is loaded
+    m_lazy = getProperty("Lazy");
+    m_lazy = m_lazy && (nWorkspaceEntries == 1 || !bDefaultEntryNumber);
+
     // Take the first real workspace obtainable. We need it even if loading
     // groups.
     tempWS = loadEntry(root, targetEntryName, 0, 1);
@@ -532,6 +684,13 @@ void LoadNexusProcessed::exec() {
   loadNexusGeometry(*tempWS, nWorkspaceEntries, g_log,
                     std::string(getProperty("Filename")));
 
+  // Attach the reader last, so that setting up the workspace reads no data
+  if (m_lazyReader) {
+    if (auto lazyWS = std::dynamic_pointer_cast<LazyWorkspace2D>(tempWS))
+      lazyWS->setBlockReader(std::move(m_lazyReader));
+    m_lazyReader.reset();
+  }
+
   m_axis1vals.clear();
 } // namespace DataHandling
 
@@ -698,9 +857,17 @@ LoadNexusProcessed::loadEventEntry(NXData &wksp_cls, NXDouble &xbins,
 
   std::vector<double> tofs;
   if (wksp_cls.isValid("tof")) {
-    NXDouble tof = wksp_cls.openNXDouble("tof");
-    tof.load();
-    tofs = tof.vecBuffer();
+    // Times of flight that are exact in single precision are saved as floats
+    if (wksp_cls.getDataSetInfo("tof").type == NX_FLOAT32) {
+      NXFloat tof = wksp_cls.openNXFloat("tof");
+      tof.load();
+      const auto &values = tof.vecBuffer();
+      tofs.assign(values.cbegin(), values.cend());
+    } else {
+      NXDouble tof = wksp_cls.openNXDouble("tof");
+      tof.load();
+      tofs = tof.vecBuffer();
+    }
   }
 
   std::vector<float> error_squareds;
@@ -1289,10 +1456,23 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
     workspaceType = "RebinnedOutput";
   }
 
-  API::MatrixWorkspace_sptr local_workspace =
-      std::dynamic_pointer_cast<API::MatrixWorkspace>(
-          WorkspaceFactory::Instance().create(workspaceType, total_specs,
-                                              xlength, nchannels));
+  // Spectra are read on access only for a whole Workspace2D in an HDF5 file
+  const std::string filename = getPropertyValue("Filename");
+  bool lazy = m_lazy && workspaceType == "Workspace2D" && !m_interval &&
+              !m_list && H5::H5File::isHdf5(filename);
+  if (m_lazy && !lazy)
+    g_log.information("Only whole workspaces of type Workspace2D in HDF5 "
+                      "files can be loaded lazily. Loading all spectra.");
+
+  API::MatrixWorkspace_sptr local_workspace;
+  if (lazy) {
+    local_workspace = std::make_shared<LazyWorkspace2D>();
+    local_workspace->initialize(total_specs, xlength, nchannels);
+  } else {
+    local_workspace = std::dynamic_pointer_cast<API::MatrixWorkspace>(
+        WorkspaceFactory::Instance().create(workspaceType, total_specs,
+                                            xlength, nchannels));
+  }
   try {
     local_workspace->setTitle(mtd_entry.getString("title"));
   } catch (std::runtime_error &) {
@@ -1336,6 +1516,16 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
                          "last value will be dropped.\n";
   }
 
+  if (lazy) {
+    if (m_shared_bins) {
+      for (size_t i = 0; i < total_specs; ++i)
+        local_workspace->setSharedX(i, m_xbins.cowData());
+    }
+    m_lazyReader = std::make_unique<ProcessedBlockReader>(
+        filename, wksp_cls.path(), m_shared_bins, hasXErrors);
+    return local_workspace;
+  }
+
   int blocksize = 8;
   // const int fullblocks = nspectra / blocksize;
   // size of the workspace
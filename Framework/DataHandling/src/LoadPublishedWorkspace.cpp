@@ -0,0 +1,51 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/LoadPublishedWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidDataHandling/SharedMemoryWorkspace.h"
+#include "MantidKernel/MandatoryValidator.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+DECLARE_ALGORITHM(LoadPublishedWorkspace)
+
+using namespace Kernel;
+using namespace API;
+
+void LoadPublishedWorkspace::init() {
+  declareProperty("Name", "",
+                  std::make_shared<MandatoryValidator<std::string>>(),
+                  "The name the workspace was published as.");
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>(
+                      "OutputWorkspace", "", Direction::Output),
+                  "The loaded workspace.");
+  declareProperty("LoadInstrument", true,
+                  "If true, set the instrument of the published workspace, "
+                  "with its parameters, calibrated positions and masking.");
+}
+
+void LoadPublishedWorkspace::exec() {
+  const SharedMemoryWorkspace published(getPropertyValue("Name"),
+                                        PublishedWorkspaceRegistry());
+  MatrixWorkspace_sptr workspace = published.createWorkspace();
+
+  const bool loadInstrument = getProperty("LoadInstrument");
+  if (loadInstrument && !published.instrumentName().empty()) {
+    try {
+      published.setInstrument(*workspace);
+    } catch (std::exception &error) {
+      g_log.warning() << "Unable to set the instrument "
+                      << published.instrumentName() << ": " << error.what()
+                      << "\n";
+    }
+  }
+  setProperty("OutputWorkspace", workspace);
+}
+
+} // namespace DataHandling
+} // namespace Mantid
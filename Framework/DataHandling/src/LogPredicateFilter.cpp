@@ -0,0 +1,286 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/LogPredicateFilter.h"
+#include "MantidAPI/Run.h"
+#include "MantidDataHandling/BankPulseTimes.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/TimeSplitter.h"
+
+#include <algorithm>
+#include <regex>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataHandling {
+
+using Kernel::TimeSeriesProperty;
+using Types::Core::DateAndTime;
+
+namespace {
+/**
+ * Copy the times and values of a numeric time series log
+ * @param prop :: The log
+ * @param times :: Set to the times of the log in nanoseconds
+ * @param values :: Set to the values of the log
+ * @returns False if the log is not a time series of type T
+ */
+template <typename T>
+bool copyLog(const Kernel::Property *prop, std::vector<int64_t> &times,
+             std::vector<double> &values) {
+  const auto log = dynamic_cast<const TimeSeriesProperty<T> *>(prop);
+  if (!log)
+    return false;
+  const auto logTimes = log->timesAsVector();
+  const auto logValues = log->valuesAsVector();
+  times.resize(logTimes.size());
+  std::transform(logTimes.cbegin(), logTimes.cend(), times.begin(),
+                 [](const DateAndTime &time) {
+                   return time.totalNanoseconds();
+                 });
+  values.assign(logValues.cbegin(), logValues.cend());
+  return true;
+}
+} // namespace
+
+/// @returns True if the value of the log satisfies the predicate
+bool LogPredicateFilter::Predicate::test(const double logValue) const {
+  switch (comparison) {
+  case Comparison::Less:
+    return logValue < value;
+  case Comparison::LessEqual:
+    return logValue <= value;
+  case Comparison::Greater:
+    return logValue > value;
+  case Comparison::GreaterEqual:
+    return logValue >= value;
+  case Comparison::Equal:
+    return logValue == value;
+  case Comparison::NotEqual:
+    return logValue != value;
+  }
+  return false;
+}
+
+/**
+ * Parse a predicate of the form <log name><comparison><value>, where the
+ * comparison is one of <, <=, >, >=, == or !=, e.g. "SampleTemp<300"
+ * @param predicate :: The predicate to parse
+ * @returns The predicate
+ * @throws std::invalid_argument if the predicate cannot be parsed
+ */
+LogPredicateFilter::Predicate
+LogPredicateFilter::parse(const std::string &predicate) {
+  static const std::regex form(
+      R"(^\s*([^<>=!]*[^<>=!\s])\s*(<=|>=|==|!=|<|>)\s*(\S+)\s*$)");
+  std::smatch parts;
+  if (!std::regex_match(predicate, parts, form))
+    throw std::invalid_argument("The log filter '" + predicate +
+                                "' is not of the form <log name><comparison>"
+                                "<value>, e.g. SampleTemp<300");
+  Predicate result;
+  result.logName = parts[1];
+  const std::string comparison = parts[2];
+  if (comparison == "<")
+    result.comparison = Predicate::Comparison::Less;
+  else if (comparison == "<=")
+    result.comparison = Predicate::Comparison::LessEqual;
+  else if (comparison == ">")
+    result.comparison = Predicate::Comparison::Greater;
+  else if (comparison == ">=")
+    result.comparison = Predicate::Comparison::GreaterEqual;
+  else if (comparison == "==")
+    result.comparison = Predicate::Comparison::Equal;
+  else
+    result.comparison = Predicate::Comparison::NotEqual;
+
+  const std::string value = parts[3];
+  size_t parsed = 0;
+  try {
+    result.value = std::stod(value, &parsed);
+  } catch (std::logic_error &) {
+    parsed = 0;
+  }
+  if (parsed != value.size())
+    throw std::invalid_argument("The value '" + value +
+                                "' of the log filter '" + predicate +
+                                "' is not a number");
+  return result;
+}
+
+/**
+ * Constructor
+ * @param predicates :: The predicates that the logs must satisfy
+ * @param run :: The run containing the logs
+ * @throws std::invalid_argument if a predicate cannot be parsed or its log is
+ * not a numeric time series in the run
+ */
+LogPredicateFilter::LogPredicateFilter(
+    const std::vector<std::string> &predicates, const API::Run &run) {
+  std::map<std::string, size_t> logIndices;
+  for (const auto &text : predicates) {
+    auto predicate = parse(text);
+    auto index = logIndices.find(predicate.logName);
+    if (index == logIndices.end()) {
+      Kernel::Property *prop = nullptr;
+      try {
+        prop = run.getLogData(predicate.logName);
+      } catch (Kernel::Exception::NotFoundError &) {
+        throw std::invalid_argument("The log " + predicate.logName +
+                                    " of the log filter '" + text +
+                                    "' was not found");
+      }
+      Log log;
+      if (!(copyLog<double>(prop, log.times, log.values) ||
+            copyLog<float>(prop, log.times, log.values) ||
+            copyLog<int32_t>(prop, log.times, log.values) ||
+            copyLog<int64_t>(prop, log.times, log.values) ||
+            copyLog<uint32_t>(prop, log.times, log.values) ||
+            copyLog<uint64_t>(prop, log.times, log.values) ||
+            copyLog<bool>(prop, log.times, log.values)))
+        throw std::invalid_argument("The log " + predicate.logName +
+                                    " of the log filter '" + text +
+                                    "' is not a numeric time series");
+      if (log.times.empty())
+        throw std::invalid_argument("The log " + predicate.logName +
+                                    " of the log filter '" + text +
+                                    "' is empty");
+      index = logIndices.emplace(predicate.logName, m_logs.size()).first;
+      m_logs.emplace_back(std::move(log));
+    }
+    m_logs[index->second].predicates.emplace_back(std::move(predicate));
+  }
+}
+
+/**
+ * Find the pulses at which all of the predicates hold. The result is cached
+ * for each set of pulse times, which must outlive this object.
+ * @param pulseTimes :: The pulse times of a bank
+ * @returns The ranges of accepted pulse indices, in increasing order
+ */
+std::vector<LogPredicateFilter::Range>
+LogPredicateFilter::acceptedPulses(const BankPulseTimes &pulseTimes) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto cached = m_accepted.find(&pulseTimes);
+  if (cached != m_accepted.end())
+    return cached->second;
+
+  std::vector<Range> accepted;
+  for (size_t pulse = 0; pulse < pulseTimes.numPulses; ++pulse) {
+    const int64_t time = pulseTimes.pulseTimes[pulse].totalNanoseconds();
+    const bool isAccepted =
+        std::all_of(m_logs.cbegin(), m_logs.cend(), [time](const Log &log) {
+          // The last value at or before the pulse, or the first value
+          const auto next =
+              std::upper_bound(log.times.cbegin(), log.times.cend(), time);
+          const auto index =
+              next == log.times.cbegin()
+                  ? 0
+                  : std::distance(log.times.cbegin(), next) - 1;
+          const double value = log.values[index];
+          return std::all_of(
+              log.predicates.cbegin(), log.predicates.cend(),
+              [value](const Predicate &predicate) {
+                return predicate.test(value);
+              });
+        });
+    if (!isAccepted)
+      continue;
+    if (!accepted.empty() && accepted.back().second == pulse)
+      accepted.back().second = pulse + 1;
+    else
+      accepted.emplace_back(pulse, pulse + 1);
+  }
+  m_accepted.emplace(&pulseTimes, accepted);
+  return accepted;
+}
+
+/**
+ * Keep only the parts of the logs of a run recorded during the accepted
+ * pulses. The total proton charge is integrated again from what is left.
+ * @param run :: The run to filter
+ * @param pulseTimes :: The pulse times of the run
+ */
+void LogPredicateFilter::filterRun(API::Run &run,
+                                   const BankPulseTimes &pulseTimes) const {
+  Kernel::TimeSplitterType splitter;
+  for (const auto &range : acceptedPulses(pulseTimes)) {
+    // A pulse lasts until the next one, and the last until the end of the run
+    const auto stop = range.second < pulseTimes.numPulses
+                          ? pulseTimes.pulseTimes[range.second]
+                          : DateAndTime::maximum();
+    splitter.emplace_back(pulseTimes.pulseTimes[range.first], stop, 0);
+  }
+  API::Run filtered(run);
+  run.splitByTime(splitter, {&filtered});
+  filtered.integrateProtonCharge();
+  run = filtered;
+}
+
+/**
+ * Find the events of the accepted pulses of a bank
+ * @param pulses :: The ranges of accepted pulses, in increasing order
+ * @param eventIndex :: The index of the first event of each pulse in the bank
+ * @param startEvent :: The index of the first event that may be read
+ * @param stopEvent :: The index after the last event that may be read
+ * @returns The ranges of events to read and the index of the first of the
+ * events read for each pulse
+ */
+LogPredicateFilter::EventSelection
+LogPredicateFilter::selectEvents(const std::vector<Range> &pulses,
+                                 const std::vector<uint64_t> &eventIndex,
+                                 const uint64_t startEvent,
+                                 const uint64_t stopEvent) {
+  EventSelection selection;
+  const size_t numberOfPulses = eventIndex.size();
+  for (const auto &range : pulses) {
+    if (range.first >= numberOfPulses)
+      break;
+    // The events of the last pulse run to the end of the bank
+    const uint64_t first = std::max(eventIndex[range.first], startEvent);
+    const uint64_t last =
+        std::min(range.second < numberOfPulses ? eventIndex[range.second]
+                                               : stopEvent,
+                 stopEvent);
+    if (first >= last)
+      continue;
+    if (!selection.ranges.empty() && selection.ranges.back().second >= first)
+      selection.ranges.back().second =
+          std::max(selection.ranges.back().second, last);
+    else
+      selection.ranges.emplace_back(first, last);
+  }
+
+  // The number of events read before each range
+  std::vector<uint64_t> before;
+  before.reserve(selection.ranges.size());
+  for (const auto &range : selection.ranges) {
+    before.emplace_back(selection.numberOfEvents);
+    selection.numberOfEvents += range.second - range.first;
+  }
+
+  // Each pulse starts after the events read that come before it in the bank
+  selection.eventIndex.resize(numberOfPulses);
+  for (size_t pulse = 0; pulse < numberOfPulses; ++pulse) {
+    const uint64_t event = eventIndex[pulse];
+    const auto next = std::partition_point(
+        selection.ranges.cbegin(), selection.ranges.cend(),
+        [event](const Range &range) { return range.first < event; });
+    if (next == selection.ranges.cbegin()) {
+      selection.eventIndex[pulse] = 0;
+      continue;
+    }
+    const auto index = std::distance(selection.ranges.cbegin(), next) - 1;
+    const auto &range = selection.ranges[index];
+    selection.eventIndex[pulse] =
+        before[index] + std::min(event, range.second) - range.first;
+  }
+  return selection;
+}
+
+} // namespace DataHandling
+} // namespace Mantid
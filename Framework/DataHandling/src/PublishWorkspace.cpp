@@ -0,0 +1,41 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/PublishWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidDataHandling/SharedMemoryWorkspace.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+DECLARE_ALGORITHM(PublishWorkspace)
+
+using namespace Kernel;
+using namespace API;
+
+void PublishWorkspace::init() {
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>(
+                      "InputWorkspace", "", Direction::Input),
+                  "A Workspace2D or EventWorkspace to publish.");
+  declareProperty("Name", "",
+                  "The name to publish the workspace as, made of letters, "
+                  "digits, underscores and hyphens. Defaults to the name of "
+                  "the input workspace.");
+}
+
+void PublishWorkspace::exec() {
+  MatrixWorkspace_const_sptr workspace = getProperty("InputWorkspace");
+  std::string publishedName = getPropertyValue("Name");
+  if (publishedName.empty())
+    publishedName = getPropertyValue("InputWorkspace");
+  SharedMemoryWorkspace::publish(*workspace, publishedName,
+                                 PublishedWorkspaceRegistry());
+  g_log.information() << "Published " << getPropertyValue("InputWorkspace")
+                      << " as " << publishedName << "\n";
+}
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -0,0 +1,206 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/PublishedWorkspaceRegistry.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+/**
+ * Holds an exclusive lock on a file next to the registry for its lifetime.
+ * A separate file is locked because on POSIX systems closing any handle to a
+ * file releases the locks of the process on it.
+ */
+class RegistryLock {
+public:
+  explicit RegistryLock(const std::string &registry)
+      : m_filename(registry + ".lock") {
+    // The file must exist to be locked
+    std::ofstream(m_filename, std::ios::app);
+    m_lock = boost::interprocess::file_lock(m_filename.c_str());
+    m_lock.lock();
+  }
+  ~RegistryLock() { m_lock.unlock(); }
+  RegistryLock(const RegistryLock &) = delete;
+  RegistryLock &operator=(const RegistryLock &) = delete;
+
+private:
+  const std::string m_filename;
+  boost::interprocess::file_lock m_lock;
+};
+} // namespace
+
+/// @returns The registry set by the publishedworkspaces.registry property,
+/// or the one in the application data directory of the user if it is unset
+std::string PublishedWorkspaceRegistry::defaultFilename() {
+  auto &config = Kernel::ConfigService::Instance();
+  const auto configured = config.getString("publishedworkspaces.registry");
+  if (!configured.empty())
+    return configured;
+  Poco::Path path(config.getAppDataDir());
+  path.makeDirectory();
+  path.setFileName("published_workspaces.txt");
+  return path.toString();
+}
+
+/**
+ * Constructor
+ * @param filename :: The full path to the registry file, which is created if
+ * it does not exist
+ */
+PublishedWorkspaceRegistry::PublishedWorkspaceRegistry(
+    const std::string &filename)
+    : m_filename(filename) {
+  Poco::File(Poco::Path(filename).parent()).createDirectories();
+}
+
+/**
+ * Add a workspace to the registry, replacing any entry with the same name
+ * @param entry :: The published workspace
+ * @throws std::invalid_argument if a field of the entry contains a tab or a
+ * newline
+ */
+void PublishedWorkspaceRegistry::add(const Entry &entry) const {
+  Entry replaced;
+  replace(entry, replaced);
+}
+
+/**
+ * Add a workspace to the registry, replacing any entry with the same name in
+ * a single change of the registry
+ * @param entry :: The published workspace
+ * @param replaced :: Set to the entry that was replaced, if there was one
+ * @returns True if an entry was replaced
+ * @throws std::invalid_argument if a field of the entry contains a tab or a
+ * newline
+ */
+bool PublishedWorkspaceRegistry::replace(const Entry &entry,
+                                         Entry &replaced) const {
+  for (const auto &field : {entry.name, entry.segment, entry.workspaceID})
+    if (field.find_first_of("\t\n") != std::string::npos)
+      throw std::invalid_argument("The published workspace '" + field +
+                                  "' contains a tab or newline");
+  RegistryLock lock(m_filename);
+  auto current = read();
+  const auto found = std::find_if(
+      current.begin(), current.end(),
+      [&entry](const Entry &other) { return other.name == entry.name; });
+  const bool isReplaced = found != current.end();
+  if (isReplaced) {
+    replaced = *found;
+    *found = entry;
+  } else {
+    current.emplace_back(entry);
+  }
+  write(current);
+  return isReplaced;
+}
+
+/**
+ * Remove a workspace from the registry
+ * @param name :: The name of the workspace
+ * @returns True if the workspace was in the registry
+ */
+bool PublishedWorkspaceRegistry::remove(const std::string &name) const {
+  Entry removed;
+  return remove(name, removed);
+}
+
+/**
+ * Remove a workspace from the registry
+ * @param name :: The name of the workspace
+ * @param removed :: Set to the entry that was removed, if there was one
+ * @returns True if the workspace was in the registry
+ */
+bool PublishedWorkspaceRegistry::remove(const std::string &name,
+                                        Entry &removed) const {
+  RegistryLock lock(m_filename);
+  auto current = read();
+  const auto found = std::find_if(
+      current.begin(), current.end(),
+      [&name](const Entry &entry) { return entry.name == name; });
+  if (found == current.end())
+    return false;
+  removed = *found;
+  current.erase(found);
+  write(current);
+  return true;
+}
+
+/**
+ * Find a workspace in the registry
+ * @param name :: The name of the workspace
+ * @param entry :: Set to the entry of the workspace if it is found
+ * @returns True if the workspace was found
+ */
+bool PublishedWorkspaceRegistry::find(const std::string &name,
+                                      Entry &entry) const {
+  const auto current = entries();
+  const auto found = std::find_if(
+      current.cbegin(), current.cend(),
+      [&name](const Entry &other) { return other.name == name; });
+  if (found == current.cend())
+    return false;
+  entry = *found;
+  return true;
+}
+
+/// @returns All of the workspaces in the registry
+std::vector<PublishedWorkspaceRegistry::Entry>
+PublishedWorkspaceRegistry::entries() const {
+  RegistryLock lock(m_filename);
+  return read();
+}
+
+/// Read the registry file, which must be locked
+std::vector<PublishedWorkspaceRegistry::Entry>
+PublishedWorkspaceRegistry::read() const {
+  std::vector<Entry> result;
+  std::ifstream file(m_filename);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    Entry entry;
+    if (std::getline(fields, entry.name, '\t') &&
+        std::getline(fields, entry.segment, '\t') &&
+        std::getline(fields, entry.workspaceID, '\t'))
+      result.emplace_back(std::move(entry));
+  }
+  return result;
+}
+
+/// Replace the registry file, which must be locked, with a new file holding
+/// the entries
+void PublishedWorkspaceRegistry::write(
+    const std::vector<Entry> &entries) const {
+  const std::string temporary = m_filename + ".new";
+  {
+    std::ofstream file(temporary, std::ios::trunc);
+    for (const auto &entry : entries)
+      file << entry.name << '\t' << entry.segment << '\t'
+           << entry.workspaceID << '\n';
+    if (!file)
+      throw std::runtime_error("Unable to write the published workspace "
+                               "registry " +
+                               m_filename);
+  }
+  Poco::File(temporary).renameTo(m_filename);
+}
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -12,6 +12,7 @@
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataHandling/CompressedDatasetWriter.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/MaskWorkspace.h"
 #include "MantidDataObjects/OffsetsWorkspace.h"
@@ -20,7 +21,13 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidNexus/NexusFileIO.h"
+
+#include <H5Cpp.h>
+
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 using namespace Mantid::API;
@@ -107,6 +114,18 @@ bool makeMappings(const MatrixWorkspace &ws, const std::vector<int> &ws_indices,
   return true;
 }
 
+/// The number of events in each chunk of the event fields
+constexpr int64_t EVENT_CHUNK_SIZE = 1 << 16;
+/// The deflate level the NeXus API uses for NX_COMP_LZW
+constexpr int DEFLATE_LEVEL = 6;
+
+/// Whether the times of flight of the events are exact as floats
+template <class T> bool isExactInFloat(const std::vector<T> &events) {
+  return std::all_of(events.cbegin(), events.cend(), [](const T &event) {
+    return static_cast<double>(static_cast<float>(event.tof())) == event.tof();
+  });
+}
+
 } // namespace
 
 /** Initialisation method.
@@ -396,31 +415,34 @@ void SaveNexusProcessed::exec() {
 }
 
 //-------------------------------------------------------------------------------------
-/** Append out each field of a vector of events to separate array.
+/** Append out each field of a range of a vector of events to separate arrays.
  *
  * @param events :: vector of TofEvent or WeightedEvent, etc.
- * @param offset :: where the first event goes in the array
+ * @param begin, end :: the range of events to append
+ * @param offset :: where the first event goes in the arrays
  * @param tofs, weights, errorSquareds, pulsetimes :: arrays to write to.
  *        Must be initialized and big enough,
  *        or NULL if they are not meant to be written to.
  */
-template <class T>
+template <class T, typename TofType>
 void SaveNexusProcessed::appendEventListData(const std::vector<T> &events,
-                                             size_t offset, double *tofs,
+                                             size_t begin, size_t end,
+                                             size_t offset, TofType *tofs,
                                              float *weights,
                                              float *errorSquareds,
                                              int64_t *pulsetimes) {
   // Do nothing if there are no events.
-  if (events.empty())
+  if (begin >= end)
     return;
 
-  const auto it = events.cbegin();
-  const auto it_end = events.cend();
+  const auto it = std::next(events.cbegin(), begin);
+  const auto it_end = std::next(events.cbegin(), end);
 
   // Fill the C-arrays with the fields from all the events, as requested.
   if (tofs) {
-    std::transform(it, it_end, std::next(tofs, offset),
-                   [](const T &event) { return event.tof(); });
+    std::transform(it, it_end, std::next(tofs, offset), [](const T &event) {
+      return static_cast<TofType>(event.tof());
+    });
   }
   if (weights) {
     std::transform(it, it_end, std::next(weights, offset), [](const T &event) {
@@ -440,6 +462,95 @@ void SaveNexusProcessed::appendEventListData(const std::vector<T> &events,
   }
 }
 
+//-------------------------------------------------------------------------------------
+/** Copy a range of the combined list of events into separate arrays. The
+ * range is split into pieces of one chunk that are copied in parallel.
+ *
+ * @param indices :: the index of the first event of each spectrum in the
+ *        combined list, followed by the total number of events
+ * @param begin, end :: the range of the combined list to copy
+ * @param tofs, weights, errorSquareds, pulsetimes :: arrays of at least
+ *        end - begin values to write to, or NULL if they are not meant to be
+ *        written to.
+ */
+template <typename TofType>
+void SaveNexusProcessed::copyEvents(const std::vector<int64_t> &indices,
+                                    const int64_t begin, const int64_t end,
+                                    TofType *tofs, float *weights,
+                                    float *errorSquareds, int64_t *pulsetimes) {
+  const int64_t numPieces =
+      (end - begin + EVENT_CHUNK_SIZE - 1) / EVENT_CHUNK_SIZE;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t piece = 0; piece < numPieces; ++piece) {
+    PARALLEL_START_INTERUPT_REGION
+    const int64_t pieceBegin = begin + piece * EVENT_CHUNK_SIZE;
+    const int64_t pieceEnd = std::min(pieceBegin + EVENT_CHUNK_SIZE, end);
+    // The last spectrum starting at or before the piece
+    auto wi = static_cast<size_t>(std::upper_bound(indices.cbegin(),
+                                                   indices.cend(), pieceBegin) -
+                                  indices.cbegin()) -
+              1;
+    for (; wi + 1 < indices.size() && indices[wi] < pieceEnd; ++wi) {
+      const int64_t from = std::max(indices[wi], pieceBegin);
+      const int64_t to = std::min(indices[wi + 1], pieceEnd);
+      if (from >= to)
+        continue;
+      const DataObjects::EventList &el = m_eventWorkspace->getSpectrum(wi);
+      const auto first = static_cast<size_t>(from - indices[wi]);
+      const auto last = static_cast<size_t>(to - indices[wi]);
+      // This is where it will land in the output arrays.
+      // It is okay to write in parallel since none should step on each other.
+      const auto offset = static_cast<size_t>(from - begin);
+      switch (el.getEventType()) {
+      case TOF:
+        appendEventListData(el.getEvents(), first, last, offset, tofs, weights,
+                            errorSquareds, pulsetimes);
+        break;
+      case WEIGHTED:
+        appendEventListData(el.getWeightedEvents(), first, last, offset, tofs,
+                            weights, errorSquareds, pulsetimes);
+        break;
+      case WEIGHTED_NOTIME:
+        appendEventListData(el.getWeightedEventsNoTime(), first, last, offset,
+                            tofs, weights, errorSquareds, pulsetimes);
+        break;
+      }
+    }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+}
+
+//-------------------------------------------------------------------------------------
+/** Check whether the times of flight of all events are exactly representable
+ * in single precision, so that they can be saved as floats without loss.
+ */
+bool SaveNexusProcessed::tofsFitInFloat() const {
+  std::atomic<bool> fits{true};
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int wi = 0;
+       wi < static_cast<int>(m_eventWorkspace->getNumberHistograms()); wi++) {
+    if (!fits)
+      continue;
+    const DataObjects::EventList &el = m_eventWorkspace->getSpectrum(wi);
+    bool spectrumFits = true;
+    switch (el.getEventType()) {
+    case TOF:
+      spectrumFits = isExactInFloat(el.getEvents());
+      break;
+    case WEIGHTED:
+      spectrumFits = isExactInFloat(el.getWeightedEvents());
+      break;
+    case WEIGHTED_NOTIME:
+      spectrumFits = isExactInFloat(el.getWeightedEventsNoTime());
+      break;
+    }
+    if (!spectrumFits)
+      fits = false;
+  }
+  return fits;
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Execute the saving of event data.
  * This will make one long event list for all events contained.
@@ -467,89 +578,170 @@ void SaveNexusProcessed::execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
   }
   indices.emplace_back(index);
 
-  // Initialize all the arrays
-  int64_t num = index;
-  double *tofs = nullptr;
-  float *weights = nullptr;
-  float *errorSquareds = nullptr;
-  int64_t *pulsetimes = nullptr;
+  /*Default = DONT compress - much faster*/
+  bool CompressNexus = getProperty("CompressNexus");
+
+  // HDF5 files are written a few chunks at a time
+  if (!nexusFile->isXML() &&
+      writeEventsInChunks(*nexusFile, indices, CompressNexus))
+    return;
+  writeEventArrays(nexusFile, indices, CompressNexus);
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Write the events through the NeXus API from arrays holding all of them.
+ *
+ * @param nexusFile :: the file, with the workspace entry open
+ * @param indices :: the index of the first event of each spectrum, followed
+ *        by the total number of events
+ * @param compress :: if true, compress the event fields
+ */
+void SaveNexusProcessed::writeEventArrays(Mantid::NeXus::NexusFileIO *nexusFile,
+                                          std::vector<int64_t> &indices,
+                                          const bool compress) {
+  const int64_t num = indices.back();
 
   // overall event type.
   EventType type = m_eventWorkspace->getEventType();
-  bool writeTOF = true;
-  bool writePulsetime = false;
-  bool writeWeight = false;
-  bool writeError = false;
-
-  switch (type) {
-  case TOF:
-    writePulsetime = true;
-    break;
-  case WEIGHTED:
-    writePulsetime = true;
-    writeWeight = true;
-    writeError = true;
-    break;
-  case WEIGHTED_NOTIME:
-    writeWeight = true;
-    writeError = true;
-    break;
-  }
+  const bool writePulsetime = type != WEIGHTED_NOTIME;
+  const bool writeWeight = type != TOF;
+
+  // --- Initialize and fill in the combined event arrays ----
+  std::vector<double> tofs(num);
+  std::vector<float> weights(writeWeight ? num : 0);
+  std::vector<float> errorSquareds(writeWeight ? num : 0);
+  std::vector<int64_t> pulsetimes(writePulsetime ? num : 0);
+  copyEvents(indices, 0, num, tofs.data(),
+             writeWeight ? weights.data() : nullptr,
+             writeWeight ? errorSquareds.data() : nullptr,
+             writePulsetime ? pulsetimes.data() : nullptr);
+  m_progress->reportIncrement(static_cast<size_t>(num), "Copying EventList");
 
-  // --- Initialize the combined event arrays ----
-  if (writeTOF)
-    tofs = new double[num];
-  if (writeWeight)
-    weights = new float[num];
-  if (writeError)
-    errorSquareds = new float[num];
-  if (writePulsetime)
-    pulsetimes = new int64_t[num];
+  // Write out to the NXS file.
+  nexusFile->writeNexusProcessedDataEventCombined(
+      m_eventWorkspace, indices, tofs.data(),
+      writeWeight ? weights.data() : nullptr,
+      writeWeight ? errorSquareds.data() : nullptr,
+      writePulsetime ? pulsetimes.data() : nullptr, compress);
+}
+//-----------------------------------------------------------------------------------------------
+/** Write the events straight to the HDF5 file a few chunks at a time, so that
+ * they are never all copied at once. The chunks are compressed in parallel.
+ *
+ * @param nexusFile :: the file, with the workspace entry open
+ * @param indices :: the index of the first event of each spectrum, followed
+ *        by the total number of events
+ * @param compress :: if true, shuffle and compress the event fields
+ * @returns false, having written nothing, if the file cannot be opened
+ *          through HDF5
+ */
+bool SaveNexusProcessed::writeEventsInChunks(
+    const Mantid::NeXus::NexusFileIO &nexusFile, std::vector<int64_t> &indices,
+    const bool compress) {
+  // The NeXus API keeps the file open, so open it a second time with the same
+  // close degree to share its state
+  H5::H5File file;
+  H5::Group group;
+  try {
+    H5::FileAccPropList access;
+    access.setFcloseDegree(H5F_CLOSE_STRONG);
+    file = H5::H5File(nexusFile.filename(), H5F_ACC_RDWR,
+                      H5::FileCreatPropList::DEFAULT, access);
+    group = file.openGroup(nexusFile.currentPath() + "/event_workspace");
+  } catch (const H5::Exception &e) {
+    g_log.debug() << "Cannot write the events in chunks: "
+                  << e.getDetailMsg() << "\n";
+    return false;
+  }
 
-  // --- Fill in the combined event arrays ----
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int wi = 0;
-       wi < static_cast<int>(m_eventWorkspace->getNumberHistograms()); wi++) {
-    PARALLEL_START_INTERUPT_REGION
-    const DataObjects::EventList &el = m_eventWorkspace->getSpectrum(wi);
+  // Write the indices only
+  nexusFile.writeNexusProcessedDataEventCombined(
+      m_eventWorkspace, indices, nullptr, nullptr, nullptr, nullptr, compress);
+  try {
+    if (tofsFitInFloat())
+      writeEventBlocks<float>(group, indices, compress);
+    else
+      writeEventBlocks<double>(group, indices, compress);
+  } catch (const H5::Exception &e) {
+    throw std::runtime_error("Failed to write the events: " +
+                             e.getDetailMsg());
+  }
+  return true;
+}
 
-    // This is where it will land in the output array.
-    // It is okay to write in parallel since none should step on each other.
-    size_t offset = indices[wi];
+//-----------------------------------------------------------------------------------------------
+/** Create the event fields and fill them one block of chunks at a time.
+ *
+ * @param group :: the event_workspace group
+ * @param indices :: the index of the first event of each spectrum, followed
+ *        by the total number of events
+ * @param compress :: if true, shuffle and compress the event fields
+ */
+template <typename TofType>
+void SaveNexusProcessed::writeEventBlocks(const H5::Group &group,
+                                          const std::vector<int64_t> &indices,
+                                          const bool compress) {
+  const int64_t num = indices.back();
+  const auto size = static_cast<hsize_t>(num);
+  const int deflateLevel = compress ? DEFLATE_LEVEL : 0;
+  const EventType type = m_eventWorkspace->getEventType();
+  const bool writePulsetime = type != WEIGHTED_NOTIME;
+  const bool writeWeight = type != TOF;
+
+  // Same order of fields as the NeXus API writes them
+  CompressedDatasetWriter tofWriter(group, "tof",
+                                    std::is_same<TofType, float>::value
+                                        ? H5::PredType::NATIVE_FLOAT
+                                        : H5::PredType::NATIVE_DOUBLE,
+                                    size, EVENT_CHUNK_SIZE, deflateLevel);
+  std::unique_ptr<CompressedDatasetWriter> pulsetimeWriter, weightWriter,
+      errorWriter;
+  if (writePulsetime)
+    pulsetimeWriter = std::make_unique<CompressedDatasetWriter>(
+        group, "pulsetime", H5::PredType::NATIVE_INT64, size, EVENT_CHUNK_SIZE,
+        deflateLevel);
+  if (writeWeight) {
+    weightWriter = std::make_unique<CompressedDatasetWriter>(
+        group, "weight", H5::PredType::NATIVE_FLOAT, size, EVENT_CHUNK_SIZE,
+        deflateLevel);
+    errorWriter = std::make_unique<CompressedDatasetWriter>(
+        group, "error_squared", H5::PredType::NATIVE_FLOAT, size,
+        EVENT_CHUNK_SIZE, deflateLevel);
+  }
 
-    switch (el.getEventType()) {
-    case TOF:
-      appendEventListData(el.getEvents(), offset, tofs, weights, errorSquareds,
-                          pulsetimes);
-      break;
-    case WEIGHTED:
-      appendEventListData(el.getWeightedEvents(), offset, tofs, weights,
-                          errorSquareds, pulsetimes);
-      break;
-    case WEIGHTED_NOTIME:
-      appendEventListData(el.getWeightedEventsNoTime(), offset, tofs, weights,
-                          errorSquareds, pulsetimes);
-      break;
+  // Enough chunks to keep every thread busy compressing
+  const int64_t blockSize =
+      EVENT_CHUNK_SIZE * static_cast<int64_t>(PARALLEL_GET_MAX_THREADS);
+  const auto bufferSize = static_cast<size_t>(std::min(blockSize, num));
+  std::vector<TofType> tofs(bufferSize);
+  std::vector<int64_t> pulsetimes(writePulsetime ? bufferSize : 0);
+  std::vector<float> weights(writeWeight ? bufferSize : 0);
+  std::vector<float> errorSquareds(writeWeight ? bufferSize : 0);
+
+  for (int64_t begin = 0; begin < num; begin += blockSize) {
+    const int64_t end = std::min(begin + blockSize, num);
+    const auto count = static_cast<size_t>(end - begin);
+    copyEvents(indices, begin, end, tofs.data(),
+               writeWeight ? weights.data() : nullptr,
+               writeWeight ? errorSquareds.data() : nullptr,
+               writePulsetime ? pulsetimes.data() : nullptr);
+    tofWriter.write(tofs.data(), count);
+    if (pulsetimeWriter)
+      pulsetimeWriter->write(pulsetimes.data(), count);
+    if (weightWriter) {
+      weightWriter->write(weights.data(), count);
+      errorWriter->write(errorSquareds.data(), count);
     }
-    m_progress->reportIncrement(el.getNumberEvents(), "Copying EventList");
-
-    PARALLEL_END_INTERUPT_REGION
+    m_progress->reportIncrement(count, "Writing events");
   }
-  PARALLEL_CHECK_INTERUPT_REGION
 
-  /*Default = DONT compress - much faster*/
-  bool CompressNexus = getProperty("CompressNexus");
-
-  // Write out to the NXS file.
-  nexusFile->writeNexusProcessedDataEventCombined(m_eventWorkspace, indices,
-                                                  tofs, weights, errorSquareds,
-                                                  pulsetimes, CompressNexus);
-
-  // Free mem.
-  delete[] tofs;
-  delete[] weights;
-  delete[] errorSquareds;
-  delete[] pulsetimes;
+  tofWriter.finish();
+  if (pulsetimeWriter)
+    pulsetimeWriter->finish();
+  if (weightWriter) {
+    weightWriter->finish();
+    errorWriter->finish();
+  }
 }
 
 //-----------------------------------------------------------------------------------------------
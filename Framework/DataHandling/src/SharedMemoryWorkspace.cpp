@@ -0,0 +1,812 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/SharedMemoryWorkspace.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/InstrumentDataService.h"
+#include "MantidAPI/Run.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/PropertyWithValue.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/UnitFactory.h"
+
+#include <Poco/Process.h>
+#include <boost/interprocess/managed_shared_memory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+
+namespace ip = boost::interprocess;
+
+namespace Mantid {
+namespace DataHandling {
+
+using namespace DataObjects;
+using namespace HistogramData;
+using Kernel::TimeSeriesProperty;
+using Types::Core::DateAndTime;
+using Types::Event::TofEvent;
+
+namespace {
+/// Changed whenever the layout of the segment changes
+constexpr uint32_t LAYOUT_VERSION = 1;
+
+/// The fixed size part of a published workspace
+struct Header {
+  uint32_t version;
+  uint32_t isEventWorkspace;
+  uint32_t eventType;
+  uint32_t isDistribution;
+  uint64_t numberOfHistograms;
+  uint64_t numberOfLogs;
+};
+
+/// How a log is stored
+enum class LogType : uint32_t {
+  Double,
+  Int,
+  String,
+  DoubleSeries,
+  StringSeries,
+  FloatSeries,
+  Int32Series,
+  Int64Series,
+  UInt32Series,
+  UInt64Series,
+  BoolSeries
+};
+
+/// The name of an object of a log in the segment
+std::string logObject(size_t log, const char *object) {
+  return "Log" + std::to_string(log) + "." + object;
+}
+
+/// Counts the bytes and objects that are written to a segment
+struct SizeCounter {
+  template <typename T> void add(size_t count) {
+    if (count == 0)
+      return;
+    bytes += count * sizeof(T);
+    ++objects;
+  }
+  /// A generous bound on the size of the segment, which is shrunk afterwards
+  size_t segmentSize() const { return 64 * 1024 + bytes + objects * 256; }
+
+  size_t bytes = 0;
+  size_t objects = 0;
+};
+
+/// Writes named arrays into a segment
+class SegmentWriter {
+public:
+  explicit SegmentWriter(ip::managed_shared_memory &segment)
+      : m_segment(segment) {}
+  /// Allocate an uninitialised named array, or return nullptr if it is empty
+  template <typename T> T *allocate(const std::string &name, size_t count) {
+    if (count == 0)
+      return nullptr;
+    return m_segment.construct<T>(name.c_str())[count]();
+  }
+  template <typename Iterator>
+  void write(const std::string &name, Iterator begin, Iterator end) {
+    using T = typename std::iterator_traits<Iterator>::value_type;
+    auto data = allocate<T>(name, std::distance(begin, end));
+    std::copy(begin, end, data);
+  }
+  void write(const std::string &name, const std::string &value) {
+    write(name, value.cbegin(), value.cend());
+  }
+
+private:
+  ip::managed_shared_memory &m_segment;
+};
+
+/// The logs of a run as they are published
+struct PublishedLog {
+  std::string name;
+  std::string units;
+  LogType type;
+  std::vector<int64_t> times;
+  std::vector<double> values;
+  std::vector<std::string> strings;
+};
+
+/// Copy the values of a numeric time series if the log is one with values
+/// of type T, tagging them with the type so that it can be restored
+template <typename T>
+bool copyNumericSeries(const Kernel::Property *prop, LogType type,
+                       PublishedLog &log) {
+  const auto series = dynamic_cast<const TimeSeriesProperty<T> *>(prop);
+  if (!series)
+    return false;
+  log.type = type;
+  const auto values = series->valuesAsVector();
+  log.values.assign(values.cbegin(), values.cend());
+  return true;
+}
+
+/**
+ * Convert a log for publishing
+ * @param prop :: The log
+ * @returns The log in the form in which it is published
+ */
+PublishedLog publishedLog(const Kernel::Property *prop) {
+  PublishedLog log;
+  log.name = prop->name();
+  log.units = prop->units();
+  if (const auto series =
+          dynamic_cast<const Kernel::ITimeSeriesProperty *>(prop)) {
+    const auto times = series->timesAsVector();
+    log.times.resize(times.size());
+    std::transform(
+        times.cbegin(), times.cend(), log.times.begin(),
+        [](const DateAndTime &time) { return time.totalNanoseconds(); });
+    if (!(copyNumericSeries<double>(prop, LogType::DoubleSeries, log) ||
+          copyNumericSeries<float>(prop, LogType::FloatSeries, log) ||
+          copyNumericSeries<int32_t>(prop, LogType::Int32Series, log) ||
+          copyNumericSeries<int64_t>(prop, LogType::Int64Series, log) ||
+          copyNumericSeries<uint32_t>(prop, LogType::UInt32Series, log) ||
+          copyNumericSeries<uint64_t>(prop, LogType::UInt64Series, log) ||
+          copyNumericSeries<bool>(prop, LogType::BoolSeries, log))) {
+      log.type = LogType::StringSeries;
+      if (const auto strings =
+              dynamic_cast<const TimeSeriesProperty<std::string> *>(prop))
+        log.strings = strings->valuesAsVector();
+      else
+        log.strings.assign(times.size(), std::string());
+    }
+  } else if (const auto value =
+                 dynamic_cast<const Kernel::PropertyWithValue<double> *>(
+                     prop)) {
+    log.type = LogType::Double;
+    log.values.emplace_back((*value)());
+  } else if (const auto value =
+                 dynamic_cast<const Kernel::PropertyWithValue<int> *>(prop)) {
+    log.type = LogType::Int;
+    log.values.emplace_back(static_cast<double>((*value)()));
+  } else {
+    log.type = LogType::String;
+    log.strings.emplace_back(prop->value());
+  }
+  return log;
+}
+
+/// The offsets of the arrays of each spectrum in a concatenated array
+template <typename SizeOf>
+std::vector<uint64_t> offsets(size_t numberOfHistograms, SizeOf sizeOf) {
+  std::vector<uint64_t> result(numberOfHistograms + 1, 0);
+  for (size_t i = 0; i < numberOfHistograms; ++i)
+    result[i + 1] = result[i] + sizeOf(i);
+  return result;
+}
+
+/// Make a histogram from published arrays
+template <typename X>
+Histogram makeHistogram(X x, const SharedMemoryWorkspace::Array<double> &y,
+                        const SharedMemoryWorkspace::Array<double> &e,
+                        const bool distribution) {
+  if (distribution)
+    return Histogram(std::move(x), Frequencies(y.begin(), y.end()),
+                     FrequencyStandardDeviations(e.begin(), e.end()));
+  return Histogram(std::move(x), Counts(y.begin(), y.end()),
+                   CountStandardDeviations(e.begin(), e.end()));
+}
+
+/**
+ * Create an empty segment with a name that no other segment has
+ * @param name :: The published name of the workspace
+ * @param size :: The size of the segment in bytes
+ * @returns The name of the segment
+ */
+std::string createSegment(const std::string &name, const size_t size) {
+  static std::atomic<uint64_t> count{0};
+  const std::string prefix =
+      "mantid_ws_" + name + "_" + std::to_string(Poco::Process::id()) + "_";
+  for (;;) {
+    const std::string segment = prefix + std::to_string(count++);
+    try {
+      ip::managed_shared_memory(ip::create_only, segment.c_str(), size);
+      return segment;
+    } catch (ip::interprocess_exception &error) {
+      // Left behind by an earlier process with the same ID
+      if (error.get_error_code() != ip::already_exists_error)
+        throw;
+    }
+  }
+}
+
+/// Check that a published name can be used as the name of a segment
+void validateName(const std::string &name) {
+  if (name.empty() ||
+      !std::all_of(name.cbegin(), name.cend(), [](const char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' ||
+               c == '-';
+      }))
+    throw std::invalid_argument(
+        "The published name '" + name +
+        "' must only contain letters, digits, underscores and hyphens");
+}
+
+/// Make a time series with values of type T from published values
+template <typename T>
+std::unique_ptr<Kernel::Property>
+numericSeries(const std::string &name, const std::vector<DateAndTime> &times,
+              const SharedMemoryWorkspace::Array<double> &values) {
+  auto series = std::make_unique<TimeSeriesProperty<T>>(name);
+  std::vector<T> converted;
+  converted.reserve(values.size());
+  std::transform(values.begin(), values.end(), std::back_inserter(converted),
+                 [](double value) { return static_cast<T>(value); });
+  series->addValues(times, converted);
+  return series;
+}
+} // namespace
+
+/// The attached segment and the arrays in it
+struct SharedMemoryWorkspace::Segment {
+  explicit Segment(const std::string &name)
+      : memory(ip::open_read_only, name.c_str()) {}
+
+  template <typename T> Array<T> find(const std::string &name) {
+    const auto found = memory.find_no_lock<T>(name.c_str());
+    return Array<T>(found.first, found.second);
+  }
+
+  template <typename T>
+  Array<T> spectrum(const Array<T> &values, const Array<uint64_t> &offsets,
+                    size_t index) const {
+    if (index + 1 >= offsets.size())
+      return Array<T>();
+    return Array<T>(values.data() + offsets[index],
+                    offsets[index + 1] - offsets[index]);
+  }
+
+  ip::managed_shared_memory memory;
+  const Header *header = nullptr;
+  Array<double> x, y, e;
+  Array<uint64_t> xOffsets, yOffsets;
+  Array<TofEvent> tofEvents;
+  Array<WeightedEvent> weightedEvents;
+  Array<uint64_t> eventOffsets;
+  Array<specnum_t> spectrumNumbers;
+  Array<detid_t> detectorIDs;
+  Array<uint64_t> detectorOffsets;
+};
+
+/**
+ * Publish a workspace to a new shared memory segment, replacing any workspace
+ * already published with the same name. The registry is only changed once the
+ * new segment is complete, and the segment it pointed to before is removed.
+ * @param workspace :: A Workspace2D or an EventWorkspace
+ * @param name :: The name to publish the workspace as, made of letters,
+ * digits, underscores and hyphens
+ * @param registry :: The registry to add the workspace to
+ * @throws std::invalid_argument if the name is not valid or the workspace has
+ * weighted events without times
+ */
+void SharedMemoryWorkspace::publish(
+    const API::MatrixWorkspace &workspace, const std::string &name,
+    const PublishedWorkspaceRegistry &registry) {
+  validateName(name);
+  const auto eventWorkspace = dynamic_cast<const EventWorkspace *>(&workspace);
+  const auto eventType =
+      eventWorkspace ? eventWorkspace->getEventType() : API::TOF;
+  if (eventType == API::WEIGHTED_NOTIME)
+    throw std::invalid_argument("Event workspaces with weighted events "
+                                "without times cannot be published");
+
+  const size_t numberOfHistograms = workspace.getNumberHistograms();
+  const auto xOffsets = offsets(numberOfHistograms, [&workspace](size_t i) {
+    return workspace.x(i).size();
+  });
+  const auto yOffsets = offsets(
+      eventWorkspace ? 0 : numberOfHistograms,
+      [&workspace](size_t i) { return workspace.y(i).size(); });
+  const auto eventOffsets =
+      offsets(eventWorkspace ? numberOfHistograms : 0,
+              [eventWorkspace](size_t i) {
+                return eventWorkspace->getSpectrum(i).getNumberEvents();
+              });
+  const auto detectorOffsets =
+      offsets(numberOfHistograms, [&workspace](size_t i) {
+        return workspace.getSpectrum(i).getDetectorIDs().size();
+      });
+  std::vector<PublishedLog> logs;
+  for (const auto prop : workspace.run().getProperties())
+    logs.emplace_back(publishedLog(prop));
+  const auto &instrument = workspace.getInstrument();
+  // The legacy form of the map holds the positions and masking of DetectorInfo
+  const std::string instrumentParameters =
+      instrument->isParametrized()
+          ? instrument->makeLegacyParameterMap()->asString()
+          : "";
+  const std::string title = workspace.getTitle();
+  const auto xUnit = workspace.getAxis(0)->unit();
+  const std::string xUnitID = xUnit ? xUnit->unitID() : "";
+
+  SizeCounter size;
+  size.add<Header>(1);
+  for (const auto &text :
+       {title, xUnitID, workspace.YUnitLabel(), instrument->getName(),
+        instrument->getFilename(), instrument->getXmlText(),
+        instrumentParameters})
+    size.add<char>(text.size());
+  size.add<double>(xOffsets.back());
+  size.add<uint64_t>(xOffsets.size());
+  size.add<double>(2 * yOffsets.back());
+  size.add<uint64_t>(yOffsets.size());
+  if (eventType == API::TOF)
+    size.add<TofEvent>(eventOffsets.back());
+  else
+    size.add<WeightedEvent>(eventOffsets.back());
+  size.add<uint64_t>(eventOffsets.size());
+  size.add<specnum_t>(numberOfHistograms);
+  size.add<detid_t>(detectorOffsets.back());
+  size.add<uint64_t>(detectorOffsets.size());
+  for (const auto &log : logs) {
+    size.add<uint32_t>(1);
+    size.add<char>(log.name.size());
+    size.add<char>(log.units.size());
+    size.add<int64_t>(log.times.size());
+    size.add<double>(log.values.size());
+    size.add<uint64_t>(log.strings.size() + 1);
+    for (const auto &text : log.strings)
+      size.add<char>(text.size());
+  }
+
+  const std::string segment = createSegment(name, size.segmentSize());
+  try {
+    ip::managed_shared_memory memory(ip::open_only, segment.c_str());
+    SegmentWriter writer(memory);
+    auto header = memory.construct<Header>("Header")();
+    header->version = LAYOUT_VERSION;
+    header->isEventWorkspace = eventWorkspace ? 1 : 0;
+    header->eventType = static_cast<uint32_t>(eventType);
+    header->isDistribution = workspace.isDistribution() ? 1 : 0;
+    header->numberOfHistograms = numberOfHistograms;
+    header->numberOfLogs = logs.size();
+    writer.write("Title", title);
+    writer.write("XUnit", xUnitID);
+    writer.write("YUnitLabel", workspace.YUnitLabel());
+    writer.write("InstrumentName", instrument->getName());
+    writer.write("InstrumentFilename", instrument->getFilename());
+    writer.write("InstrumentXML", instrument->getXmlText());
+    writer.write("InstrumentParameters", instrumentParameters);
+
+    writer.write("XOffsets", xOffsets.cbegin(), xOffsets.cend());
+    writer.write("YOffsets", yOffsets.cbegin(), yOffsets.cend());
+    writer.write("EventOffsets", eventOffsets.cbegin(), eventOffsets.cend());
+    writer.write("DetectorOffsets", detectorOffsets.cbegin(),
+                 detectorOffsets.cend());
+    auto x = writer.allocate<double>("X", xOffsets.back());
+    auto y = writer.allocate<double>("Y", yOffsets.back());
+    auto e = writer.allocate<double>("E", yOffsets.back());
+    auto tofEvents = writer.allocate<TofEvent>(
+        "TofEvents", eventType == API::TOF ? eventOffsets.back() : 0);
+    auto weightedEvents = writer.allocate<WeightedEvent>(
+        "WeightedEvents", eventType == API::WEIGHTED ? eventOffsets.back() : 0);
+    auto spectrumNumbers =
+        writer.allocate<specnum_t>("SpectrumNumbers", numberOfHistograms);
+    auto detectorIDs =
+        writer.allocate<detid_t>("DetectorIDs", detectorOffsets.back());
+
+    // Copy the spectra, which each have their own part of the arrays
+    PARALLEL_FOR_IF(Kernel::threadSafe(workspace))
+    for (int64_t i = 0; i < static_cast<int64_t>(numberOfHistograms); ++i) {
+      const auto &spectrum = workspace.getSpectrum(i);
+      const auto &xData = spectrum.x();
+      std::copy(xData.cbegin(), xData.cend(), x + xOffsets[i]);
+      if (eventWorkspace) {
+        const auto &events = eventWorkspace->getSpectrum(i);
+        // Spectra of TOF events are weighted if any spectrum is weighted
+        if (eventType == API::TOF)
+          std::copy(events.getEvents().cbegin(), events.getEvents().cend(),
+                    tofEvents + eventOffsets[i]);
+        else if (events.getEventType() == API::TOF)
+          std::copy(events.getEvents().cbegin(), events.getEvents().cend(),
+                    weightedEvents + eventOffsets[i]);
+        else
+          std::copy(events.getWeightedEvents().cbegin(),
+                    events.getWeightedEvents().cend(),
+                    weightedEvents + eventOffsets[i]);
+      } else {
+        const auto &yData = spectrum.y();
+        const auto &eData = spectrum.e();
+        std::copy(yData.cbegin(), yData.cend(), y + yOffsets[i]);
+        std::copy(eData.cbegin(), eData.cend(), e + yOffsets[i]);
+      }
+      spectrumNumbers[i] = spectrum.getSpectrumNo();
+      const auto &ids = spectrum.getDetectorIDs();
+      std::copy(ids.cbegin(), ids.cend(), detectorIDs + detectorOffsets[i]);
+    }
+
+    for (size_t i = 0; i < logs.size(); ++i) {
+      const auto &log = logs[i];
+      *memory.construct<uint32_t>(logObject(i, "Type").c_str())() =
+          static_cast<uint32_t>(log.type);
+      writer.write(logObject(i, "Name"), log.name);
+      writer.write(logObject(i, "Units"), log.units);
+      writer.write(logObject(i, "Times"), log.times.cbegin(), log.times.cend());
+      writer.write(logObject(i, "Values"), log.values.cbegin(),
+                   log.values.cend());
+      const auto stringOffsets =
+          offsets(log.strings.size(),
+                  [&log](size_t j) { return log.strings[j].size(); });
+      writer.write(logObject(i, "Offsets"), stringOffsets.cbegin(),
+                   stringOffsets.cend());
+      auto chars = writer.allocate<char>(logObject(i, "Chars"),
+                                         stringOffsets.back());
+      for (size_t j = 0; j < log.strings.size(); ++j)
+        std::copy(log.strings[j].cbegin(), log.strings[j].cend(),
+                  chars + stringOffsets[j]);
+    }
+  } catch (...) {
+    ip::shared_memory_object::remove(segment.c_str());
+    throw;
+  }
+  ip::managed_shared_memory::shrink_to_fit(segment.c_str());
+
+  PublishedWorkspaceRegistry::Entry entry;
+  entry.name = name;
+  entry.segment = segment;
+  entry.workspaceID = workspace.id();
+  PublishedWorkspaceRegistry::Entry replaced;
+  bool isReplaced = false;
+  try {
+    isReplaced = registry.replace(entry, replaced);
+  } catch (...) {
+    ip::shared_memory_object::remove(segment.c_str());
+    throw;
+  }
+  if (isReplaced)
+    ip::shared_memory_object::remove(replaced.segment.c_str());
+}
+
+/**
+ * Remove a published workspace and its segment. Processes that are attached
+ * to it keep their data until they detach.
+ * @param name :: The published name of the workspace
+ * @param registry :: The registry the workspace was added to
+ * @returns True if the workspace was published
+ */
+bool SharedMemoryWorkspace::unpublish(
+    const std::string &name, const PublishedWorkspaceRegistry &registry) {
+  PublishedWorkspaceRegistry::Entry entry;
+  if (!registry.remove(name, entry))
+    return false;
+  ip::shared_memory_object::remove(entry.segment.c_str());
+  return true;
+}
+
+/**
+ * Attach to a published workspace
+ * @param name :: The published name of the workspace
+ * @param registry :: The registry the workspace was added to
+ * @throws std::invalid_argument if no workspace is published with the name
+ * @throws std::runtime_error if the segment of the workspace cannot be opened
+ */
+SharedMemoryWorkspace::SharedMemoryWorkspace(
+    const std::string &name, const PublishedWorkspaceRegistry &registry)
+    : m_name(name) {
+  PublishedWorkspaceRegistry::Entry entry;
+  while (!m_segment) {
+    if (!registry.find(name, entry))
+      throw std::invalid_argument("No workspace has been published as '" +
+                                  name + "'");
+    try {
+      m_segment = std::make_unique<Segment>(entry.segment);
+    } catch (ip::interprocess_exception &error) {
+      // The workspace may have been published again since it was found
+      PublishedWorkspaceRegistry::Entry current;
+      if (registry.find(name, current) && current.segment != entry.segment)
+        continue;
+      throw std::runtime_error(
+          "Unable to attach to the workspace published as '" + name +
+          "': " + error.what());
+    }
+  }
+  auto &segment = *m_segment;
+  const auto header = segment.find<Header>("Header");
+  if (header.size() != 1 || header[0].version != LAYOUT_VERSION)
+    throw std::runtime_error("The workspace published as '" + name +
+                             "' was published by an incompatible version");
+  segment.header = header.data();
+  segment.x = segment.find<double>("X");
+  segment.y = segment.find<double>("Y");
+  segment.e = segment.find<double>("E");
+  segment.xOffsets = segment.find<uint64_t>("XOffsets");
+  segment.yOffsets = segment.find<uint64_t>("YOffsets");
+  segment.tofEvents = segment.find<TofEvent>("TofEvents");
+  segment.weightedEvents = segment.find<WeightedEvent>("WeightedEvents");
+  segment.eventOffsets = segment.find<uint64_t>("EventOffsets");
+  segment.spectrumNumbers = segment.find<specnum_t>("SpectrumNumbers");
+  segment.detectorIDs = segment.find<detid_t>("DetectorIDs");
+  segment.detectorOffsets = segment.find<uint64_t>("DetectorOffsets");
+}
+
+SharedMemoryWorkspace::~SharedMemoryWorkspace() = default;
+
+/// @returns True if an EventWorkspace was published
+bool SharedMemoryWorkspace::isEventWorkspace() const {
+  return m_segment->header->isEventWorkspace != 0;
+}
+
+/// @returns The type of the events of an EventWorkspace
+API::EventType SharedMemoryWorkspace::getEventType() const {
+  return static_cast<API::EventType>(m_segment->header->eventType);
+}
+
+/// @returns The number of spectra
+size_t SharedMemoryWorkspace::getNumberHistograms() const {
+  return static_cast<size_t>(m_segment->header->numberOfHistograms);
+}
+
+/// @returns The X values of a spectrum
+SharedMemoryWorkspace::Array<double>
+SharedMemoryWorkspace::x(size_t index) const {
+  return m_segment->spectrum(m_segment->x, m_segment->xOffsets, index);
+}
+
+/// @returns The Y values of a spectrum, which are empty for event workspaces
+SharedMemoryWorkspace::Array<double>
+SharedMemoryWorkspace::y(size_t index) const {
+  return m_segment->spectrum(m_segment->y, m_segment->yOffsets, index);
+}
+
+/// @returns The E values of a spectrum, which are empty for event workspaces
+SharedMemoryWorkspace::Array<double>
+SharedMemoryWorkspace::e(size_t index) const {
+  return m_segment->spectrum(m_segment->e, m_segment->yOffsets, index);
+}
+
+/// @returns The events of a spectrum of an event workspace of TOF events
+SharedMemoryWorkspace::Array<TofEvent>
+SharedMemoryWorkspace::tofEvents(size_t index) const {
+  return m_segment->spectrum(m_segment->tofEvents, m_segment->eventOffsets,
+                             index);
+}
+
+/// @returns The events of a spectrum of an event workspace of weighted events
+SharedMemoryWorkspace::Array<WeightedEvent>
+SharedMemoryWorkspace::weightedEvents(size_t index) const {
+  return m_segment->spectrum(m_segment->weightedEvents,
+                             m_segment->eventOffsets, index);
+}
+
+/// @returns The spectrum number of a spectrum
+specnum_t SharedMemoryWorkspace::spectrumNumber(size_t index) const {
+  return m_segment->spectrumNumbers[index];
+}
+
+/// @returns The IDs of the detectors of a spectrum
+SharedMemoryWorkspace::Array<detid_t>
+SharedMemoryWorkspace::detectorIDs(size_t index) const {
+  return m_segment->spectrum(m_segment->detectorIDs,
+                             m_segment->detectorOffsets, index);
+}
+
+/// @returns The title of the workspace
+std::string SharedMemoryWorkspace::title() const { return string("Title"); }
+
+/// @returns The ID of the unit of the X axis
+std::string SharedMemoryWorkspace::xUnitID() const { return string("XUnit"); }
+
+/// @returns The label of the Y values
+std::string SharedMemoryWorkspace::yUnitLabel() const {
+  return string("YUnitLabel");
+}
+
+/// @returns True if the Y values are a distribution
+bool SharedMemoryWorkspace::isDistribution() const {
+  return m_segment->header->isDistribution != 0;
+}
+
+/// @returns The name of the instrument
+std::string SharedMemoryWorkspace::instrumentName() const {
+  return string("InstrumentName");
+}
+
+/// @returns The definition file of the instrument, if it was loaded from one
+std::string SharedMemoryWorkspace::instrumentFilename() const {
+  return string("InstrumentFilename");
+}
+
+/// @returns The definition of the instrument, or an empty string if it was
+/// not created from one
+std::string SharedMemoryWorkspace::instrumentXML() const {
+  return string("InstrumentXML");
+}
+
+/// @returns The parameters of the instrument in the form of
+/// Geometry::ParameterMap::asString(), including the calibrated positions and
+/// masking of the detectors
+std::string SharedMemoryWorkspace::instrumentParameters() const {
+  return string("InstrumentParameters");
+}
+
+/// @returns A string stored in the segment, or an empty string
+std::string SharedMemoryWorkspace::string(const char *name) const {
+  const auto chars = m_segment->find<char>(name);
+  return std::string(chars.begin(), chars.end());
+}
+
+/**
+ * Create a workspace with a copy of the published data and logs. The
+ * instrument is set separately by setInstrument().
+ * @returns A new Workspace2D or EventWorkspace
+ */
+API::MatrixWorkspace_sptr SharedMemoryWorkspace::createWorkspace() const {
+  const size_t numberOfHistograms = getNumberHistograms();
+  API::MatrixWorkspace_sptr workspace;
+  if (isEventWorkspace()) {
+    auto events = create<EventWorkspace>(numberOfHistograms, BinEdges(2));
+    const auto eventType = getEventType();
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(numberOfHistograms); ++i) {
+      auto &spectrum = events->getSpectrum(i);
+      const auto xData = x(i);
+      spectrum.setBinEdges(BinEdges(xData.begin(), xData.end()));
+      spectrum.switchTo(eventType);
+      if (eventType == API::TOF) {
+        const auto published = tofEvents(i);
+        spectrum.getEvents().assign(published.begin(), published.end());
+      } else {
+        const auto published = weightedEvents(i);
+        spectrum.getWeightedEvents().assign(published.begin(),
+                                            published.end());
+      }
+    }
+    workspace = std::move(events);
+  } else {
+    const bool distribution = isDistribution();
+    const auto histogram = [this, distribution](size_t i) {
+      const auto xData = x(i);
+      const auto yData = y(i);
+      const auto eData = e(i);
+      if (xData.size() == yData.size() + 1)
+        return makeHistogram(BinEdges(xData.begin(), xData.end()), yData,
+                             eData, distribution);
+      return makeHistogram(Points(xData.begin(), xData.end()), yData, eData,
+                           distribution);
+    };
+    auto histograms = create<Workspace2D>(
+        numberOfHistograms,
+        numberOfHistograms > 0 ? histogram(0) : Histogram(BinEdges(2)));
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 1; i < static_cast<int64_t>(numberOfHistograms); ++i)
+      histograms->setHistogram(i, histogram(i));
+    workspace = std::move(histograms);
+  }
+
+  for (size_t i = 0; i < numberOfHistograms; ++i) {
+    auto &spectrum = workspace->getSpectrum(i);
+    spectrum.setSpectrumNo(spectrumNumber(i));
+    const auto ids = detectorIDs(i);
+    spectrum.setDetectorIDs(std::set<detid_t>(ids.begin(), ids.end()));
+  }
+  workspace->setTitle(title());
+  const auto unitID = xUnitID();
+  if (!unitID.empty())
+    workspace->getAxis(0)->unit() =
+        Kernel::UnitFactory::Instance().create(unitID);
+  workspace->setYUnitLabel(yUnitLabel());
+  addLogs(*workspace);
+  return workspace;
+}
+
+/**
+ * Give a workspace the published instrument with its parameters, calibrated
+ * positions and masking. The instrument is built from the published
+ * definition, unless an instrument from the same definition is already in the
+ * InstrumentDataService.
+ * @param workspace :: The workspace to set the instrument of, with the
+ * published spectra
+ * @throws std::runtime_error if the instrument was not published with its
+ * definition
+ */
+void SharedMemoryWorkspace::setInstrument(
+    API::MatrixWorkspace &workspace) const {
+  const std::string name = instrumentName();
+  const std::string xml = instrumentXML();
+  if (name.empty() || xml.empty())
+    throw std::runtime_error("The workspace published as '" + m_name +
+                             "' has no instrument definition");
+  Geometry::InstrumentDefinitionParser parser(instrumentFilename(), name, xml);
+  const std::string mangledName = parser.getMangledName();
+  auto &instruments = API::InstrumentDataService::Instance();
+  Geometry::Instrument_sptr instrument;
+  if (instruments.doesExist(mangledName)) {
+    instrument = instruments.retrieve(mangledName);
+  } else {
+    instrument = parser.parseXML(nullptr);
+    instrument->parseTreeAndCacheBeamline();
+    instruments.add(mangledName, instrument);
+  }
+  workspace.setInstrument(instrument);
+  workspace.readParameterMap(instrumentParameters());
+}
+
+/// Add the published logs to the run of a workspace
+void SharedMemoryWorkspace::addLogs(API::MatrixWorkspace &workspace) const {
+  auto &run = workspace.mutableRun();
+  auto &segment = *m_segment;
+  for (size_t i = 0; i < segment.header->numberOfLogs; ++i) {
+    const auto type = segment.find<uint32_t>(logObject(i, "Type"));
+    if (type.empty())
+      continue;
+    const std::string name = string(logObject(i, "Name").c_str());
+    const std::string units = string(logObject(i, "Units").c_str());
+    const auto times = segment.find<int64_t>(logObject(i, "Times"));
+    const auto values = segment.find<double>(logObject(i, "Values"));
+    const auto offsets = segment.find<uint64_t>(logObject(i, "Offsets"));
+    const auto chars = segment.find<char>(logObject(i, "Chars"));
+    const auto stringAt = [&offsets, &chars](size_t j) {
+      return std::string(chars.data() + offsets[j],
+                         chars.data() + offsets[j + 1]);
+    };
+    std::vector<DateAndTime> logTimes(times.begin(), times.end());
+
+    std::unique_ptr<Kernel::Property> log;
+    switch (static_cast<LogType>(type[0])) {
+    case LogType::Double:
+      log = std::make_unique<Kernel::PropertyWithValue<double>>(name,
+                                                                values[0]);
+      break;
+    case LogType::Int:
+      log = std::make_unique<Kernel::PropertyWithValue<int>>(
+          name, static_cast<int>(values[0]));
+      break;
+    case LogType::String:
+      log = std::make_unique<Kernel::PropertyWithValue<std::string>>(
+          name, stringAt(0));
+      break;
+    case LogType::DoubleSeries:
+      log = numericSeries<double>(name, logTimes, values);
+      break;
+    case LogType::FloatSeries:
+      log = numericSeries<float>(name, logTimes, values);
+      break;
+    case LogType::Int32Series:
+      log = numericSeries<int32_t>(name, logTimes, values);
+      break;
+    case LogType::Int64Series:
+      log = numericSeries<int64_t>(name, logTimes, values);
+      break;
+    case LogType::UInt32Series:
+      log = numericSeries<uint32_t>(name, logTimes, values);
+      break;
+    case LogType::UInt64Series:
+      log = numericSeries<uint64_t>(name, logTimes, values);
+      break;
+    case LogType::BoolSeries:
+      log = numericSeries<bool>(name, logTimes, values);
+      break;
+    case LogType::StringSeries: {
+      auto series = std::make_unique<TimeSeriesProperty<std::string>>(name);
+      std::vector<std::string> strings;
+      for (size_t j = 0; j + 1 < offsets.size(); ++j)
+        strings.emplace_back(stringAt(j));
+      series->addValues(logTimes, strings);
+      log = std::move(series);
+      break;
+    }
+    }
+    log->setUnits(units);
+    run.addProperty(std::move(log), true);
+  }
+}
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -0,0 +1,33 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/UnpublishWorkspace.h"
+#include "MantidDataHandling/SharedMemoryWorkspace.h"
+#include "MantidKernel/MandatoryValidator.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+DECLARE_ALGORITHM(UnpublishWorkspace)
+
+using namespace Kernel;
+
+void UnpublishWorkspace::init() {
+  declareProperty("Name", "",
+                  std::make_shared<MandatoryValidator<std::string>>(),
+                  "The name the workspace was published as.");
+}
+
+void UnpublishWorkspace::exec() {
+  const std::string publishedName = getPropertyValue("Name");
+  if (!SharedMemoryWorkspace::unpublish(publishedName,
+                                        PublishedWorkspaceRegistry()))
+    g_log.warning() << "No workspace has been published as " << publishedName
+                    << "\n";
+}
+
+} // namespace DataHandling
+} // namespace Mantid
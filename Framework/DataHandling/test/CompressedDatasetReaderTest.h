@@ -0,0 +1,118 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/CompressedDatasetReader.h"
+
+#include <H5Cpp.h>
+#include <Poco/File.h>
+
+#include <numeric>
+
+using namespace H5;
+using Mantid::DataHandling::CompressedDatasetReader;
+
+class CompressedDatasetReaderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompressedDatasetReaderTest *createSuite() {
+    return new CompressedDatasetReaderTest();
+  }
+  static void destroySuite(CompressedDatasetReaderTest *suite) {
+    delete suite;
+  }
+
+  CompressedDatasetReaderTest() : m_values(1000) {
+    std::iota(m_values.begin(), m_values.end(), 100000u);
+    removeFile();
+    H5File file(FILENAME, H5F_ACC_EXCL);
+    writeDataSet(file, "deflated", false, true);
+    writeDataSet(file, "shuffled", true, true);
+    writeDataSet(file, "chunked", false, false);
+    const hsize_t dims[1] = {m_values.size()};
+    file.createDataSet("contiguous", PredType::NATIVE_UINT32, DataSpace(1, dims))
+        .write(m_values.data(), PredType::NATIVE_UINT32);
+  }
+
+  ~CompressedDatasetReaderTest() override { removeFile(); }
+
+  void test_isSupported() {
+    H5File file(FILENAME, H5F_ACC_RDONLY);
+    TS_ASSERT(CompressedDatasetReader::isSupported(
+        file.openDataSet("deflated")))
+    TS_ASSERT(CompressedDatasetReader::isSupported(
+        file.openDataSet("shuffled")))
+    TS_ASSERT(
+        !CompressedDatasetReader::isSupported(file.openDataSet("chunked")))
+    TS_ASSERT(
+        !CompressedDatasetReader::isSupported(file.openDataSet("contiguous")))
+  }
+
+  void test_read_deflated() { checkRead("deflated"); }
+
+  void test_read_shuffled() { checkRead("shuffled"); }
+
+  void test_conversion_to_float() {
+    H5File file(FILENAME, H5F_ACC_RDONLY);
+    CompressedDatasetReader reader(file.openDataSet("shuffled"), 10, 20);
+    std::vector<float> out(20);
+    reader.decompress(out.data(), 0, 20);
+    for (size_t i = 0; i < out.size(); ++i)
+      TS_ASSERT_EQUALS(out[i], static_cast<float>(m_values[10 + i]))
+  }
+
+  void test_range_beyond_the_dataset_throws() {
+    H5File file(FILENAME, H5F_ACC_RDONLY);
+    TS_ASSERT_THROWS(
+        CompressedDatasetReader(file.openDataSet("deflated"), 990, 20),
+        const std::invalid_argument &)
+    CompressedDatasetReader reader(file.openDataSet("deflated"), 0, 20);
+    std::vector<uint32_t> out(30);
+    TS_ASSERT_THROWS(reader.decompress(out.data(), 0, 30),
+                     const std::out_of_range &)
+  }
+
+private:
+  void checkRead(const std::string &name) {
+    H5File file(FILENAME, H5F_ACC_RDONLY);
+    // A range starting and ending within chunks
+    CompressedDatasetReader reader(file.openDataSet(name), 150, 700);
+    TS_ASSERT_EQUALS(reader.size(), 700)
+    TS_ASSERT_EQUALS(reader.chunkSize(), 128)
+    std::vector<uint32_t> out(700);
+    // Decompress in pieces, as the loader does
+    reader.decompress(out.data(), 0, 106);
+    reader.decompress(out.data() + 106, 106, 490);
+    reader.decompress(out.data() + 490, 490, 700);
+    TS_ASSERT(std::equal(out.cbegin(), out.cend(), m_values.cbegin() + 150))
+  }
+
+  void writeDataSet(H5File &file, const std::string &name, const bool shuffle,
+                    const bool deflate) {
+    const hsize_t dims[1] = {m_values.size()};
+    const hsize_t chunk[1] = {128};
+    DSetCreatPropList plist;
+    plist.setChunk(1, chunk);
+    if (shuffle)
+      plist.setShuffle();
+    if (deflate)
+      plist.setDeflate(6);
+    file.createDataSet(name, PredType::NATIVE_UINT32, DataSpace(1, dims), plist)
+        .write(m_values.data(), PredType::NATIVE_UINT32);
+  }
+
+  void removeFile() {
+    if (Poco::File(FILENAME).exists())
+      Poco::File(FILENAME).remove();
+  }
+
+  const std::string FILENAME{"CompressedDatasetReaderTest.h5"};
+  std::vector<uint32_t> m_values;
+};
@@ -0,0 +1,125 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/CompressedDatasetReader.h"
+#include "MantidDataHandling/CompressedDatasetWriter.h"
+
+#include <H5Cpp.h>
+#include <Poco/File.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace H5;
+using Mantid::DataHandling::CompressedDatasetReader;
+using Mantid::DataHandling::CompressedDatasetWriter;
+
+class CompressedDatasetWriterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompressedDatasetWriterTest *createSuite() {
+    return new CompressedDatasetWriterTest();
+  }
+  static void destroySuite(CompressedDatasetWriterTest *suite) {
+    delete suite;
+  }
+
+  CompressedDatasetWriterTest() { removeFile(); }
+
+  ~CompressedDatasetWriterTest() override { removeFile(); }
+
+  void test_write_compressed_in_blocks() {
+    std::vector<double> values(1000);
+    std::iota(values.begin(), values.end(), 0.5);
+    {
+      H5File file(FILENAME, H5F_ACC_TRUNC);
+      CompressedDatasetWriter writer(file, "values", PredType::NATIVE_DOUBLE,
+                                     values.size(), 128, 6);
+      // Blocks smaller than, equal to and spanning several chunks
+      writer.write(values.data(), 100);
+      writer.write(values.data() + 100, 128);
+      writer.write(values.data() + 228, 700);
+      writer.write(values.data() + 928, 72);
+      writer.finish();
+    }
+    TS_ASSERT_EQUALS(readBack<double>("values", PredType::NATIVE_DOUBLE),
+                     values)
+    // The dataset is filtered as if HDF5 had written it
+    H5File file(FILENAME, H5F_ACC_RDONLY);
+    const auto dataset = file.openDataSet("values");
+    TS_ASSERT(CompressedDatasetReader::isSupported(dataset))
+    CompressedDatasetReader reader(dataset, 0, 1000);
+    std::vector<double> out(1000);
+    reader.decompress(out.data(), 0, 1000);
+    TS_ASSERT_EQUALS(out, values)
+  }
+
+  void test_chunks_that_do_not_compress_are_stored_as_they_are() {
+    std::vector<int64_t> values(300);
+    std::mt19937_64 generator(1);
+    std::generate(values.begin(), values.end(),
+                  [&generator]() { return static_cast<int64_t>(generator()); });
+    {
+      H5File file(FILENAME, H5F_ACC_TRUNC);
+      CompressedDatasetWriter writer(file, "random", PredType::NATIVE_INT64,
+                                     values.size(), 64, 6);
+      writer.write(values.data(), values.size());
+      writer.finish();
+    }
+    TS_ASSERT_EQUALS(readBack<int64_t>("random", PredType::NATIVE_INT64),
+                     values)
+  }
+
+  void test_write_uncompressed() {
+    std::vector<float> values(200);
+    std::iota(values.begin(), values.end(), 1.f);
+    {
+      H5File file(FILENAME, H5F_ACC_TRUNC);
+      CompressedDatasetWriter writer(file, "plain", PredType::NATIVE_FLOAT,
+                                     values.size(), 64, 0);
+      writer.write(values.data(), values.size());
+      writer.finish();
+    }
+    TS_ASSERT_EQUALS(readBack<float>("plain", PredType::NATIVE_FLOAT), values)
+  }
+
+  void test_wrong_number_of_values_throws() {
+    H5File file(FILENAME, H5F_ACC_TRUNC);
+    std::vector<float> values(100);
+    CompressedDatasetWriter writer(file, "short", PredType::NATIVE_FLOAT, 50,
+                                   16, 6);
+    TS_ASSERT_THROWS(writer.write(values.data(), 51), const std::out_of_range &)
+    TS_ASSERT_THROWS(writer.write(std::vector<double>(10).data(), 10),
+                     const std::invalid_argument &)
+    writer.write(values.data(), 40);
+    TS_ASSERT_THROWS(writer.finish(), const std::runtime_error &)
+  }
+
+private:
+  template <typename T>
+  std::vector<T> readBack(const std::string &name, const PredType &type) {
+    H5File file(FILENAME, H5F_ACC_RDONLY);
+    const auto dataset = file.openDataSet(name);
+    hsize_t dims[1];
+    dataset.getSpace().getSimpleExtentDims(dims);
+    std::vector<T> values(dims[0]);
+    dataset.read(values.data(), type);
+    return values;
+  }
+
+  void removeFile() {
+    if (Poco::File(FILENAME).exists())
+      Poco::File(FILENAME).remove();
+  }
+
+  const std::string FILENAME{"CompressedDatasetWriterTest.h5"};
+};
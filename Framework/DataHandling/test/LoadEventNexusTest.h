@@ -28,6 +28,8 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <numeric>
+
 using namespace Mantid;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
@@ -491,6 +493,76 @@ public:
                min >= filterStart);
   }
 
+  void test_log_value_filtered_loading() {
+    const std::string wsName = "test_log_filtering";
+    LoadEventNexus ldAll;
+    ldAll.initialize();
+    ldAll.setPropertyValue("OutputWorkspace", wsName);
+    ldAll.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    TS_ASSERT(ldAll.execute());
+    auto allWs =
+        AnalysisDataService::Instance().retrieveWS<EventWorkspace>(wsName);
+    const auto protonCharge = dynamic_cast<TimeSeriesProperty<double> *>(
+        allWs->run().getLogData("proton_charge"));
+    TS_ASSERT(protonCharge);
+    const auto charges = protonCharge->valuesAsVector();
+    const double threshold =
+        std::accumulate(charges.cbegin(), charges.cend(), 0.0) /
+        static_cast<double>(charges.size());
+
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("OutputWorkspace", wsName);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("FilterByLogValues",
+                        "proton_charge>=" + std::to_string(threshold));
+    TS_ASSERT(ld.execute());
+    auto outWs =
+        AnalysisDataService::Instance().retrieveWS<EventWorkspace>(wsName);
+
+    TS_ASSERT_LESS_THAN(0, outWs->getNumberEvents());
+    TS_ASSERT_LESS_THAN(outWs->getNumberEvents(), allWs->getNumberEvents());
+    for (size_t i = 0; i < outWs->getNumberHistograms(); i += 100) {
+      for (const auto &event : outWs->getSpectrum(i).getEvents()) {
+        TS_ASSERT_LESS_THAN_EQUALS(
+            threshold, protonCharge->getSingleValue(event.pulseTime()));
+      }
+    }
+
+    // The logs only cover the accepted pulses
+    const auto filteredCharge = dynamic_cast<TimeSeriesProperty<double> *>(
+        outWs->run().getLogData("proton_charge"));
+    TS_ASSERT(filteredCharge);
+    const auto filteredCharges = filteredCharge->valuesAsVector();
+    TS_ASSERT_LESS_THAN(filteredCharges.size(), charges.size());
+    double accepted = 0.0;
+    for (const double charge : charges) {
+      if (charge >= threshold)
+        accepted += charge;
+    }
+    TS_ASSERT_DELTA(std::accumulate(filteredCharges.cbegin(),
+                                    filteredCharges.cend(), 0.0),
+                    accepted, 1e-6 * accepted);
+    const double total =
+        std::accumulate(charges.cbegin(), charges.cend(), 0.0);
+    const double expected = allWs->run().getProtonCharge() * accepted / total;
+    TS_ASSERT_DELTA(
+        outWs->run().getPropertyValueAsType<double>("gd_prtn_chrg"),
+        expected, 1e-6 * expected);
+    AnalysisDataService::Instance().remove(wsName);
+  }
+
+  void test_log_value_filtering_needs_logs() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("OutputWorkspace", "test_log_filtering");
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("FilterByLogValues", "proton_charge>0");
+    ld.setProperty<bool>("LoadLogs", false);
+    ld.setRethrows(true);
+    TS_ASSERT_THROWS(ld.execute(), const std::invalid_argument &);
+  }
+
   void test_partial_spectra_loading() {
     std::string wsName = "test_partial_spectra_loading_SpectrumList";
     std::vector<int32_t> specList;
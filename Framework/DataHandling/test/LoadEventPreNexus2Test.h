@@ -293,6 +293,44 @@ public:
     TS_ASSERT_EQUALS(chunk1->getNumberEvents(), 56139)
     TS_ASSERT_EQUALS(chunk2->getNumberEvents(), 56127)
   }
+
+  void test_loading_time_window() {
+    eventLoader->setPropertyValue("EventFilename",
+                                  "CNCS_7860_neutron_event.dat");
+    eventLoader->setPropertyValue("OutputWorkspace", "LoadPreNexus2_all");
+    TS_ASSERT(eventLoader->execute());
+    auto all = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+        "LoadPreNexus2_all");
+    const DateAndTime firstPulse =
+        all->run().getTimeSeriesProperty<double>("proton_charge")->firstTime();
+
+    LoadEventPreNexus2 loader;
+    loader.initialize();
+    loader.setPropertyValue("EventFilename", "CNCS_7860_neutron_event.dat");
+    loader.setPropertyValue("OutputWorkspace", "LoadPreNexus2_window");
+    loader.setProperty("FilterByTimeStart", 30.);
+    loader.setProperty("FilterByTimeStop", 90.);
+    TS_ASSERT(loader.execute());
+    auto window = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+        "LoadPreNexus2_window");
+
+    TS_ASSERT_LESS_THAN(0, window->getNumberEvents());
+    TS_ASSERT_LESS_THAN(window->getNumberEvents(), all->getNumberEvents());
+    const DateAndTime start = firstPulse + 30.;
+    const DateAndTime stop = firstPulse + 90.;
+    for (size_t i = 0; i < window->getNumberHistograms(); ++i) {
+      for (const auto &event : window->getSpectrum(i).getEvents()) {
+        TS_ASSERT_LESS_THAN_EQUALS(start, event.pulseTime());
+        TS_ASSERT_LESS_THAN(event.pulseTime(), stop);
+      }
+    }
+    // The proton charge is only of the pulses in the window
+    TS_ASSERT_LESS_THAN(window->run().getProtonCharge(),
+                        all->run().getProtonCharge());
+
+    AnalysisDataService::Instance().remove("LoadPreNexus2_all");
+    AnalysisDataService::Instance().remove("LoadPreNexus2_window");
+  }
 };
 
 //------------------------------------------------------------------------------
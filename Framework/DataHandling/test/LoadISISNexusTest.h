@@ -1552,6 +1552,41 @@ public:
     AnalysisDataService::Instance().remove("outWS_monitors");
   }
 
+  void test_loading_in_several_slabs_matches_loading_in_one() {
+    // A few spectra per slab, with a partial slab at the end
+    const auto loadInSlabs = [](const int64_t loadBlockBytes,
+                                const std::string &outputName) {
+      LoadISISNexus2 ld;
+      ld.initialize();
+      ld.setLoadBlockBytes(loadBlockBytes);
+      ld.setPropertyValue("Filename", "LOQ49886.nxs");
+      ld.setPropertyValue("OutputWorkspace", outputName);
+      ld.setPropertyValue("SpectrumMin", "3");
+      ld.setPropertyValue("SpectrumMax", "1003");
+      TS_ASSERT_THROWS_NOTHING(ld.execute());
+      TS_ASSERT(ld.isExecuted());
+      return AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(
+          outputName);
+    };
+    const auto single = loadInSlabs(int64_t{1} << 30, "outWS_single");
+    const auto slabs = loadInSlabs(7 * 5 * sizeof(int), "outWS_slabs");
+
+    TS_ASSERT_EQUALS(single->getNumberHistograms(), 1001);
+    TS_ASSERT_EQUALS(slabs->getNumberHistograms(),
+                     single->getNumberHistograms());
+    for (size_t i = 0; i < single->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(slabs->x(i).rawData(), single->x(i).rawData());
+      TS_ASSERT_EQUALS(slabs->y(i).rawData(), single->y(i).rawData());
+      TS_ASSERT_EQUALS(slabs->e(i).rawData(), single->e(i).rawData());
+      TS_ASSERT_EQUALS(slabs->getSpectrum(i).getSpectrumNo(),
+                       single->getSpectrum(i).getSpectrumNo());
+      TS_ASSERT_EQUALS(slabs->getSpectrum(i).getDetectorIDs(),
+                       single->getSpectrum(i).getDetectorIDs());
+    }
+    AnalysisDataService::Instance().remove("outWS_single");
+    AnalysisDataService::Instance().remove("outWS_slabs");
+  }
+
   void test_that_multiple_time_regime_file_is_detected_and_loads() {
     // Arrange
     LoadISISNexus2 ld;
@@ -293,6 +293,36 @@ public:
     TS_ASSERT_EQUALS(endTime.totalNanoseconds(), lastTime.totalNanoseconds());
   }
 
+  void test_deferred_logs_match_logs_read_immediately() {
+    MatrixWorkspace_sptr ws = createTestWorkspace();
+    MatrixWorkspace_sptr deferredWS = createTestWorkspace();
+    for (const auto &workspace : {ws, deferredWS}) {
+      LoadNexusLogs ld;
+      ld.initialize();
+      ld.setPropertyValue("Filename", "REF_L_32035.nxs");
+      ld.setProperty("Workspace", workspace);
+      if (workspace == deferredWS)
+        ld.setProperty("DeferredLogSize", 1);
+      ld.execute();
+      TS_ASSERT(ld.isExecuted());
+    }
+
+    Run &run = deferredWS->mutableRun();
+    TS_ASSERT(run.isDeferredProperty("Phase1"));
+    TS_ASSERT(run.hasProperty("Phase1"));
+    TS_ASSERT(!run.isDeferredProperty("proton_charge"));
+
+    auto tsp =
+        dynamic_cast<TimeSeriesProperty<double> *>(run.getLogData("Phase1"));
+    TS_ASSERT(tsp);
+    TS_ASSERT(!run.isDeferredProperty("Phase1"));
+    TS_ASSERT_DELTA(tsp->nthValue(1), 13715.55, 2);
+    TS_ASSERT_EQUALS(tsp->lastTime(), run.endTime());
+
+    TS_ASSERT_EQUALS(run.getLogData().size(), ws->run().getLogData().size());
+    TS_ASSERT(run == ws->mutableRun());
+  }
+
   void test_load_file_with_invalid_log_entries() {
     LoadNexusLogs ld;
     ld.initialize();
@@ -18,6 +18,7 @@
 #include "MantidDataHandling/LoadNexusProcessed.h"
 #include "MantidDataHandling/SaveNexusProcessed.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/LazyWorkspace2D.h"
 #include "MantidDataObjects/Peak.h"
 #include "MantidDataObjects/PeakShapeSpherical.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
@@ -1109,6 +1110,23 @@ public:
     }
   }
 
+  void test_lazy_load_reads_spectra_on_access() {
+    MatrixWorkspace_sptr inputWs =
+        WorkspaceCreationHelper::create2DWorkspaceBinned(20, 10);
+    for (size_t i = 0; i < 20; ++i)
+      inputWs->mutableY(i)[3] = static_cast<double>(i);
+    doTestLazyLoad(inputWs);
+  }
+
+  void test_lazy_load_with_varying_bins_and_x_errors() {
+    MatrixWorkspace_sptr inputWs =
+        WorkspaceCreationHelper::create2DWorkspaceBinned(5, 4);
+    inputWs->mutableX(2)[0] = -1.;
+    for (size_t i = 0; i < 5; ++i)
+      inputWs->setPointStandardDeviations(i, 4, static_cast<double>(i));
+    doTestLazyLoad(inputWs);
+  }
+
   void test_Log_invalid_value_filtering_survives_save_and_load() {
     LoadNexus alg;
 
@@ -1495,6 +1513,53 @@ private:
     Poco::File("TestSaveAndLoadNexusProcessed.nxs").remove();
   }
 
+  void doTestLazyLoad(const MatrixWorkspace_sptr &inputWs) {
+    const std::string filename = "LoadNexusProcessedLazyTest.nxs";
+    auto save = AlgorithmManager::Instance().create("SaveNexusProcessed");
+    save->initialize();
+    save->setChild(true);
+    save->setProperty("InputWorkspace", inputWs);
+    save->setPropertyValue("Filename", filename);
+    TS_ASSERT_THROWS_NOTHING(save->execute());
+
+    const auto load = [&filename](const bool lazy) {
+      LoadNexusProcessed loader;
+      loader.setChild(true);
+      loader.initialize();
+      loader.setPropertyValue("Filename", filename);
+      loader.setPropertyValue("OutputWorkspace", "unused");
+      loader.setProperty("Lazy", lazy);
+      TS_ASSERT(loader.execute());
+      Workspace_sptr output = loader.getProperty("OutputWorkspace");
+      return std::dynamic_pointer_cast<MatrixWorkspace>(output);
+    };
+    const auto loadedWs = load(false);
+    const auto lazyWs = std::dynamic_pointer_cast<LazyWorkspace2D>(load(true));
+    TS_ASSERT(!std::dynamic_pointer_cast<LazyWorkspace2D>(loadedWs));
+    TS_ASSERT(lazyWs);
+    if (!lazyWs)
+      return;
+    const auto numberOfSpectra = inputWs->getNumberHistograms();
+    TS_ASSERT_EQUALS(lazyWs->numberOfUnloadedSpectra(), numberOfSpectra);
+    TS_ASSERT_EQUALS(lazyWs->getSpectrum(0).getSpectrumNo(),
+                     loadedWs->getSpectrum(0).getSpectrumNo());
+    TS_ASSERT_EQUALS(lazyWs->y(numberOfSpectra - 1),
+                     inputWs->y(numberOfSpectra - 1));
+
+    auto compare =
+        AlgorithmManager::Instance().createUnmanaged("CompareWorkspaces");
+    compare->initialize();
+    compare->setChild(true);
+    compare->setProperty<MatrixWorkspace_sptr>("Workspace1", loadedWs);
+    compare->setProperty<MatrixWorkspace_sptr>("Workspace2", lazyWs);
+    compare->execute();
+    TS_ASSERT(compare->isExecuted());
+    TS_ASSERT(compare->getProperty("Result"));
+    TS_ASSERT(lazyWs->isMaterialized());
+
+    Poco::File(filename).remove();
+  }
+
   void doTestLoadAndSavePointWS(bool useXErrors = false) {
     // Test SaveNexusProcessed/LoadNexusProcessed on a point-like workspace
 
@@ -0,0 +1,150 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Run.h"
+#include "MantidDataHandling/BankPulseTimes.h"
+#include "MantidDataHandling/LogPredicateFilter.h"
+#include "MantidKernel/PropertyWithValue.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+
+#include <cxxtest/TestSuite.h>
+
+using Mantid::API::Run;
+using Mantid::DataHandling::LogPredicateFilter;
+using Mantid::Kernel::PropertyWithValue;
+using Mantid::Kernel::TimeSeriesProperty;
+using Mantid::Types::Core::DateAndTime;
+using Range = LogPredicateFilter::Range;
+using Comparison = LogPredicateFilter::Predicate::Comparison;
+
+class LogPredicateFilterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LogPredicateFilterTest *createSuite() {
+    return new LogPredicateFilterTest();
+  }
+  static void destroySuite(LogPredicateFilterTest *suite) { delete suite; }
+
+  void test_parse() {
+    const auto predicate = LogPredicateFilter::parse(" Sample Temp <= 2.5e2 ");
+    TS_ASSERT_EQUALS(predicate.logName, "Sample Temp");
+    TS_ASSERT_EQUALS(predicate.comparison, Comparison::LessEqual);
+    TS_ASSERT_EQUALS(predicate.value, 250.);
+
+    TS_ASSERT_EQUALS(LogPredicateFilter::parse("a<1").comparison,
+                     Comparison::Less);
+    TS_ASSERT_EQUALS(LogPredicateFilter::parse("a>1").comparison,
+                     Comparison::Greater);
+    TS_ASSERT_EQUALS(LogPredicateFilter::parse("a>=1").comparison,
+                     Comparison::GreaterEqual);
+    TS_ASSERT_EQUALS(LogPredicateFilter::parse("a==1").comparison,
+                     Comparison::Equal);
+    TS_ASSERT_EQUALS(LogPredicateFilter::parse("a!=-1").value, -1.);
+  }
+
+  void test_parse_throws_for_bad_predicates() {
+    for (const std::string predicate :
+         {"", "temp", "temp<", "<300", "temp=300", "temp<300K", "temp<<300"})
+      TS_ASSERT_THROWS(LogPredicateFilter::parse(predicate),
+                       const std::invalid_argument &);
+  }
+
+  void test_predicate_test() {
+    const auto predicate = LogPredicateFilter::parse("temp>=300");
+    TS_ASSERT(predicate.test(300.));
+    TS_ASSERT(predicate.test(301.));
+    TS_ASSERT(!predicate.test(299.));
+  }
+
+  void test_constructor_throws_for_missing_or_non_numeric_logs() {
+    Run run = createRun();
+    TS_ASSERT_THROWS(LogPredicateFilter({"missing<1"}, run),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(LogPredicateFilter({"single<1"}, run),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS_NOTHING(LogPredicateFilter({"temp<1", "count>0"}, run));
+  }
+
+  void test_acceptedPulses() {
+    const Run run = createRun();
+    BankPulseTimes pulses(pulseTimes());
+
+    LogPredicateFilter warm({"temp>=300"}, run);
+    const std::vector<Range> warmPulses{{0, 2}, {4, 6}, {8, 10}};
+    TS_ASSERT_EQUALS(warm.acceptedPulses(pulses), warmPulses);
+    // The cached result is the same
+    TS_ASSERT_EQUALS(warm.acceptedPulses(pulses), warmPulses);
+
+    // All of the predicates must hold
+    LogPredicateFilter warmAndCounting({"temp>=300", "count>2"}, run);
+    const std::vector<Range> warmAndCountingPulses{{4, 6}, {8, 10}};
+    TS_ASSERT_EQUALS(warmAndCounting.acceptedPulses(pulses),
+                     warmAndCountingPulses);
+
+    LogPredicateFilter none({"temp>1000"}, run);
+    TS_ASSERT(none.acceptedPulses(pulses).empty());
+  }
+
+  void test_selectEvents() {
+    // Pulses 0-5 have 10 events each
+    const std::vector<uint64_t> eventIndex{0, 10, 20, 30, 40, 50};
+    const std::vector<Range> pulses{{1, 2}, {3, 4}, {5, 6}};
+
+    const auto selection =
+        LogPredicateFilter::selectEvents(pulses, eventIndex, 0, 60);
+    const std::vector<Range> ranges{{10, 20}, {30, 40}, {50, 60}};
+    TS_ASSERT_EQUALS(selection.ranges, ranges);
+    TS_ASSERT_EQUALS(selection.numberOfEvents, 30u);
+    const std::vector<uint64_t> selectedIndex{0, 0, 10, 10, 20, 20};
+    TS_ASSERT_EQUALS(selection.eventIndex, selectedIndex);
+  }
+
+  void test_selectEvents_limited_and_merged() {
+    const std::vector<uint64_t> eventIndex{0, 10, 20, 30, 40, 50};
+    const std::vector<Range> pulses{{0, 2}, {2, 3}, {4, 6}};
+
+    const auto selection =
+        LogPredicateFilter::selectEvents(pulses, eventIndex, 5, 45);
+    const std::vector<Range> ranges{{5, 30}, {40, 45}};
+    TS_ASSERT_EQUALS(selection.ranges, ranges);
+    TS_ASSERT_EQUALS(selection.numberOfEvents, 30u);
+    const std::vector<uint64_t> selectedIndex{0, 5, 15, 25, 25, 30};
+    TS_ASSERT_EQUALS(selection.eventIndex, selectedIndex);
+  }
+
+private:
+  std::vector<DateAndTime> pulseTimes() {
+    std::vector<DateAndTime> times;
+    for (int i = 0; i < 10; ++i)
+      times.emplace_back(m_start + static_cast<double>(i));
+    return times;
+  }
+
+  Run createRun() {
+    Run run;
+    // Warm for two pulses then cold for two pulses, starting before the run
+    auto temp = std::make_unique<TimeSeriesProperty<double>>("temp");
+    temp->addValue(m_start - 0.5, 310.);
+    temp->addValue(m_start + 1.5, 250.);
+    temp->addValue(m_start + 3.5, 305.);
+    temp->addValue(m_start + 5.5, 250.);
+    temp->addValue(m_start + 7.5, 300.);
+    run.addProperty(std::move(temp));
+    // Starts after the first pulse
+    auto count = std::make_unique<TimeSeriesProperty<int>>("count");
+    count->addValue(m_start + 0.5, 1);
+    count->addValue(m_start + 2.5, 3);
+    run.addProperty(std::move(count));
+    run.addProperty(
+        std::make_unique<PropertyWithValue<double>>("single", 1.));
+    return run;
+  }
+
+  const DateAndTime m_start{"2021-03-01T12:00:00"};
+};
@@ -0,0 +1,121 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidDataHandling/LoadPublishedWorkspace.h"
+#include "MantidDataHandling/PublishWorkspace.h"
+#include "MantidDataHandling/PublishedWorkspaceRegistry.h"
+#include "MantidDataHandling/UnpublishWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+using namespace Mantid::API;
+using namespace Mantid::DataHandling;
+using Mantid::Kernel::ConfigService;
+
+class PublishWorkspaceTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PublishWorkspaceTest *createSuite() {
+    return new PublishWorkspaceTest();
+  }
+  static void destroySuite(PublishWorkspaceTest *suite) { delete suite; }
+
+  PublishWorkspaceTest()
+      : m_registryFile(
+            Poco::Path(Poco::Path::temp(), "PublishWorkspaceTest.txt")
+                .toString()),
+        m_previousRegistry(ConfigService::Instance().getString(
+            "publishedworkspaces.registry")) {
+    // Keep the registry of the user untouched
+    ConfigService::Instance().setString("publishedworkspaces.registry",
+                                        m_registryFile);
+  }
+
+  ~PublishWorkspaceTest() override {
+    ConfigService::Instance().setString("publishedworkspaces.registry",
+                                        m_previousRegistry);
+    for (const auto &file : {m_registryFile, m_registryFile + ".lock"})
+      if (Poco::File(file).exists())
+        Poco::File(file).remove();
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_publish_load_and_unpublish() {
+    const auto input =
+        WorkspaceCreationHelper::create2DWorkspaceWhereYIsWorkspaceIndex(4, 6);
+    AnalysisDataService::Instance().addOrReplace("PublishWorkspaceTest_ws",
+                                                 input);
+
+    PublishWorkspace publish;
+    publish.initialize();
+    publish.setRethrows(true);
+    publish.setPropertyValue("InputWorkspace", "PublishWorkspaceTest_ws");
+    TS_ASSERT_THROWS_NOTHING(publish.execute());
+    PublishedWorkspaceRegistry::Entry entry;
+    const PublishedWorkspaceRegistry registry(m_registryFile);
+    // Published with the name of the input workspace
+    TS_ASSERT(registry.find("PublishWorkspaceTest_ws", entry));
+
+    LoadPublishedWorkspace load;
+    load.initialize();
+    load.setRethrows(true);
+    load.setPropertyValue("Name", "PublishWorkspaceTest_ws");
+    load.setProperty("LoadInstrument", false);
+    load.setPropertyValue("OutputWorkspace", "PublishWorkspaceTest_loaded");
+    TS_ASSERT_THROWS_NOTHING(load.execute());
+    const auto loaded =
+        AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(
+            "PublishWorkspaceTest_loaded");
+    TS_ASSERT(loaded);
+    TS_ASSERT_EQUALS(loaded->getNumberHistograms(), 4);
+    for (size_t i = 0; i < 4; ++i) {
+      TS_ASSERT_EQUALS(loaded->x(i).rawData(), input->x(i).rawData());
+      TS_ASSERT_EQUALS(loaded->y(i).rawData(), input->y(i).rawData());
+    }
+
+    UnpublishWorkspace unpublish;
+    unpublish.initialize();
+    unpublish.setRethrows(true);
+    unpublish.setPropertyValue("Name", "PublishWorkspaceTest_ws");
+    TS_ASSERT_THROWS_NOTHING(unpublish.execute());
+    TS_ASSERT(!registry.find("PublishWorkspaceTest_ws", entry));
+
+    // It can no longer be loaded
+    LoadPublishedWorkspace loadAgain;
+    loadAgain.initialize();
+    loadAgain.setRethrows(true);
+    loadAgain.setPropertyValue("Name", "PublishWorkspaceTest_ws");
+    loadAgain.setPropertyValue("OutputWorkspace",
+                               "PublishWorkspaceTest_loaded");
+    TS_ASSERT_THROWS(loadAgain.execute(), const std::invalid_argument &);
+  }
+
+  void test_publish_with_invalid_name_throws() {
+    PublishWorkspace publish;
+    publish.initialize();
+    publish.setRethrows(true);
+    publish.setProperty<MatrixWorkspace_sptr>(
+        "InputWorkspace",
+        WorkspaceCreationHelper::create2DWorkspaceWhereYIsWorkspaceIndex(1, 2));
+    publish.setPropertyValue("Name", "not/valid");
+    TS_ASSERT_THROWS(publish.execute(), const std::invalid_argument &);
+  }
+
+private:
+  const std::string m_registryFile;
+  const std::string m_previousRegistry;
+};
@@ -325,6 +325,29 @@ public:
         true /* DONT preserve events */, true /* Compress */);
   }
 
+  void testExec_EventWorkspace_TofsExactInFloatAreSavedAsFloat() {
+    std::string outputFile;
+    auto ws = do_testExec_EventWorkspaces("SaveNexusProcessed_FloatTof", TOF,
+                                          outputFile, false, false, true, true);
+
+    ::NeXus::File savedNexus(outputFile);
+    savedNexus.openGroup("mantid_workspace_1", "NXentry");
+    savedNexus.openGroup("event_workspace", "NXdata");
+    savedNexus.openData("tof");
+    const ::NeXus::Info info = savedNexus.getInfo();
+    TS_ASSERT_EQUALS(info.type, NX_FLOAT32);
+    TS_ASSERT_EQUALS(info.dims[0], ws->getNumberEvents());
+    std::vector<float> tofs;
+    savedNexus.getData(tofs);
+    const auto &events = ws->getSpectrum(0).getEvents();
+    for (size_t i = 0; i < events.size(); ++i)
+      TS_ASSERT_EQUALS(tofs[i], events[i].tof());
+    savedNexus.close();
+
+    if (clearfiles)
+      Poco::File(outputFile).remove();
+  }
+
   void testExecSaveLabel() {
     SaveNexusProcessed alg;
     if (!alg.isInitialized())
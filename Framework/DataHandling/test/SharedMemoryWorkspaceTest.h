@@ -0,0 +1,358 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidDataHandling/PublishedWorkspaceRegistry.h"
+#include "MantidDataHandling/SharedMemoryWorkspace.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidKernel/PropertyWithValue.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+using namespace Mantid::API;
+using namespace Mantid::DataHandling;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+using Mantid::detid_t;
+using Mantid::Types::Core::DateAndTime;
+
+class SharedMemoryWorkspaceTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SharedMemoryWorkspaceTest *createSuite() {
+    return new SharedMemoryWorkspaceTest();
+  }
+  static void destroySuite(SharedMemoryWorkspaceTest *suite) { delete suite; }
+
+  SharedMemoryWorkspaceTest()
+      : m_registryFile(
+            Poco::Path(Poco::Path::temp(), "SharedMemoryWorkspaceTest.txt")
+                .toString()),
+        m_registry(m_registryFile) {}
+
+  ~SharedMemoryWorkspaceTest() override {
+    for (const auto &file : {m_registryFile, m_registryFile + ".lock"})
+      if (Poco::File(file).exists())
+        Poco::File(file).remove();
+  }
+
+  void test_registry() {
+    PublishedWorkspaceRegistry::Entry entry;
+    entry.name = "a";
+    entry.segment = "segment_a";
+    entry.workspaceID = "Workspace2D";
+    m_registry.add(entry);
+    entry.name = "b";
+    m_registry.add(entry);
+    entry.segment = "segment_b";
+    m_registry.add(entry);
+
+    TS_ASSERT_EQUALS(m_registry.entries().size(), 2);
+    PublishedWorkspaceRegistry::Entry found;
+    TS_ASSERT(m_registry.find("b", found));
+    TS_ASSERT_EQUALS(found.segment, "segment_b");
+    TS_ASSERT_EQUALS(found.workspaceID, "Workspace2D");
+
+    entry.segment = "segment_c";
+    PublishedWorkspaceRegistry::Entry replaced;
+    TS_ASSERT(m_registry.replace(entry, replaced));
+    TS_ASSERT_EQUALS(replaced.segment, "segment_b");
+    TS_ASSERT_EQUALS(m_registry.entries().size(), 2);
+
+    TS_ASSERT(m_registry.remove("a"));
+    TS_ASSERT(!m_registry.remove("a"));
+    TS_ASSERT(!m_registry.find("a", found));
+    TS_ASSERT(m_registry.remove("b"));
+    TS_ASSERT(m_registry.entries().empty());
+  }
+
+  void test_publish_throws_for_invalid_name() {
+    const auto workspace =
+        WorkspaceCreationHelper::create2DWorkspaceWhereYIsWorkspaceIndex(2, 3);
+    TS_ASSERT_THROWS(
+        SharedMemoryWorkspace::publish(*workspace, "bad name", m_registry),
+        const std::invalid_argument &);
+    TS_ASSERT_THROWS(SharedMemoryWorkspace::publish(*workspace, "", m_registry),
+                     const std::invalid_argument &);
+  }
+
+  void test_attach_throws_if_not_published() {
+    TS_ASSERT_THROWS(
+        SharedMemoryWorkspace("SharedMemoryWorkspaceTest_missing", m_registry),
+        const std::invalid_argument &);
+  }
+
+  void test_Workspace2D() {
+    auto workspace =
+        WorkspaceCreationHelper::create2DWorkspaceWhereYIsWorkspaceIndex(3, 5);
+    workspace->setTitle("A title");
+    workspace->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+    workspace->setYUnitLabel("Counts per bin");
+    workspace->getSpectrum(1).setSpectrumNo(7);
+    workspace->getSpectrum(1).setDetectorIDs({3, 4});
+    addLogs(*workspace);
+
+    const std::string name = "SharedMemoryWorkspaceTest_2D";
+    SharedMemoryWorkspace::publish(*workspace, name, m_registry);
+    PublishedWorkspaceRegistry::Entry entry;
+    TS_ASSERT(m_registry.find(name, entry));
+    TS_ASSERT_EQUALS(entry.workspaceID, "Workspace2D");
+
+    {
+      const SharedMemoryWorkspace published(name, m_registry);
+      TS_ASSERT(!published.isEventWorkspace());
+      TS_ASSERT_EQUALS(published.getNumberHistograms(), 3);
+      TS_ASSERT_EQUALS(published.title(), "A title");
+      TS_ASSERT_EQUALS(published.xUnitID(), "TOF");
+      TS_ASSERT_EQUALS(published.yUnitLabel(), "Counts per bin");
+      TS_ASSERT_EQUALS(published.spectrumNumber(1), 7);
+      const auto ids = published.detectorIDs(1);
+      TS_ASSERT_EQUALS(std::vector<detid_t>(ids.begin(), ids.end()),
+                       std::vector<detid_t>({3, 4}));
+      for (size_t i = 0; i < 3; ++i) {
+        const auto y = published.y(i);
+        TS_ASSERT_EQUALS(std::vector<double>(y.begin(), y.end()),
+                         workspace->y(i).rawData());
+      }
+
+      const auto loaded = published.createWorkspace();
+      TS_ASSERT(std::dynamic_pointer_cast<Workspace2D>(loaded));
+      TS_ASSERT_EQUALS(loaded->getNumberHistograms(), 3);
+      for (size_t i = 0; i < 3; ++i) {
+        TS_ASSERT_EQUALS(loaded->x(i).rawData(), workspace->x(i).rawData());
+        TS_ASSERT_EQUALS(loaded->y(i).rawData(), workspace->y(i).rawData());
+        TS_ASSERT_EQUALS(loaded->e(i).rawData(), workspace->e(i).rawData());
+        TS_ASSERT_EQUALS(loaded->getSpectrum(i).getSpectrumNo(),
+                         workspace->getSpectrum(i).getSpectrumNo());
+        TS_ASSERT_EQUALS(loaded->getSpectrum(i).getDetectorIDs(),
+                         workspace->getSpectrum(i).getDetectorIDs());
+      }
+      TS_ASSERT_EQUALS(loaded->getTitle(), "A title");
+      TS_ASSERT_EQUALS(loaded->getAxis(0)->unit()->unitID(), "TOF");
+      checkLogs(*loaded);
+    }
+
+    TS_ASSERT(SharedMemoryWorkspace::unpublish(name, m_registry));
+    TS_ASSERT(!SharedMemoryWorkspace::unpublish(name, m_registry));
+    TS_ASSERT_THROWS(SharedMemoryWorkspace(name, m_registry),
+                     const std::invalid_argument &);
+  }
+
+  void test_EventWorkspace() {
+    const auto workspace = WorkspaceCreationHelper::createEventWorkspace2(4, 5);
+    const std::string name = "SharedMemoryWorkspaceTest_events";
+    SharedMemoryWorkspace::publish(*workspace, name, m_registry);
+
+    {
+      const SharedMemoryWorkspace published(name, m_registry);
+      TS_ASSERT(published.isEventWorkspace());
+      TS_ASSERT_EQUALS(published.getEventType(), TOF);
+      TS_ASSERT_EQUALS(published.getNumberHistograms(), 4);
+      TS_ASSERT(published.y(0).empty());
+      const auto events = published.tofEvents(2);
+      TS_ASSERT_EQUALS(events.size(),
+                       workspace->getSpectrum(2).getNumberEvents());
+      TS_ASSERT(std::equal(events.begin(), events.end(),
+                           workspace->getSpectrum(2).getEvents().cbegin()));
+
+      const auto loaded = std::dynamic_pointer_cast<EventWorkspace>(
+          published.createWorkspace());
+      TS_ASSERT(loaded);
+      TS_ASSERT_EQUALS(loaded->getNumberEvents(),
+                       workspace->getNumberEvents());
+      for (size_t i = 0; i < 4; ++i) {
+        TS_ASSERT_EQUALS(loaded->getSpectrum(i).getEvents(),
+                         workspace->getSpectrum(i).getEvents());
+        TS_ASSERT_EQUALS(loaded->x(i).rawData(), workspace->x(i).rawData());
+        TS_ASSERT_EQUALS(loaded->y(i).rawData(), workspace->y(i).rawData());
+      }
+    }
+    SharedMemoryWorkspace::unpublish(name, m_registry);
+  }
+
+  void test_weighted_events() {
+    auto workspace = WorkspaceCreationHelper::createEventWorkspace2(2, 5);
+    workspace->getSpectrum(1).switchTo(WEIGHTED);
+    const std::string name = "SharedMemoryWorkspaceTest_weighted";
+    SharedMemoryWorkspace::publish(*workspace, name, m_registry);
+
+    {
+      const SharedMemoryWorkspace published(name, m_registry);
+      TS_ASSERT_EQUALS(published.getEventType(), WEIGHTED);
+      const auto loaded = std::dynamic_pointer_cast<EventWorkspace>(
+          published.createWorkspace());
+      TS_ASSERT_EQUALS(loaded->getSpectrum(1).getWeightedEvents(),
+                       workspace->getSpectrum(1).getWeightedEvents());
+    }
+    SharedMemoryWorkspace::unpublish(name, m_registry);
+  }
+
+  void test_publishing_again_replaces_the_workspace() {
+    const std::string name = "SharedMemoryWorkspaceTest_replaced";
+    SharedMemoryWorkspace::publish(
+        *WorkspaceCreationHelper::create2DWorkspaceWhereYIsWorkspaceIndex(2, 3),
+        name, m_registry);
+    const SharedMemoryWorkspace first(name, m_registry);
+    PublishedWorkspaceRegistry::Entry firstEntry;
+    TS_ASSERT(m_registry.find(name, firstEntry));
+    SharedMemoryWorkspace::publish(
+        *WorkspaceCreationHelper::create2DWorkspaceWhereYIsWorkspaceIndex(5, 3),
+        name, m_registry);
+
+    // The new workspace has its own segment and the old one is removed
+    PublishedWorkspaceRegistry::Entry secondEntry;
+    TS_ASSERT(m_registry.find(name, secondEntry));
+    TS_ASSERT_DIFFERS(secondEntry.segment, firstEntry.segment);
+    TS_ASSERT_THROWS(boost::interprocess::shared_memory_object(
+                         boost::interprocess::open_only,
+                         firstEntry.segment.c_str(),
+                         boost::interprocess::read_only),
+                     const boost::interprocess::interprocess_exception &);
+
+    // The attached workspace is unchanged
+    TS_ASSERT_EQUALS(first.getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(SharedMemoryWorkspace(name, m_registry)
+                         .getNumberHistograms(),
+                     5);
+    TS_ASSERT_EQUALS(m_registry.entries().size(), 1);
+    SharedMemoryWorkspace::unpublish(name, m_registry);
+  }
+
+  void test_instrument_keeps_parameters_and_calibration() {
+    auto workspace =
+        WorkspaceCreationHelper::create2DWorkspaceWhereYIsWorkspaceIndex(2, 3);
+    Mantid::Geometry::InstrumentDefinitionParser parser(
+        "", "SharedMemoryInstrument", instrumentXML());
+    workspace->setInstrument(parser.parseXML(nullptr));
+    workspace->getSpectrum(0).setDetectorID(1);
+    workspace->getSpectrum(1).setDetectorID(2);
+    auto &detectorInfo = workspace->mutableDetectorInfo();
+    detectorInfo.setPosition(1, V3D(2., 0.5, 0.));
+    detectorInfo.setMasked(0, true);
+    workspace->instrumentParameters().addDouble(
+        workspace->getInstrument()->baseInstrument()->getDetector(2).get(),
+        "Efixed", 3.5);
+
+    const std::string name = "SharedMemoryWorkspaceTest_instrument";
+    SharedMemoryWorkspace::publish(*workspace, name, m_registry);
+    {
+      const SharedMemoryWorkspace published(name, m_registry);
+      TS_ASSERT_EQUALS(published.instrumentName(), "SharedMemoryInstrument");
+      const auto loaded = published.createWorkspace();
+      TS_ASSERT_THROWS_NOTHING(published.setInstrument(*loaded));
+
+      const auto &loadedInfo = loaded->detectorInfo();
+      TS_ASSERT_EQUALS(loadedInfo.size(), 2);
+      TS_ASSERT_EQUALS(loadedInfo.position(0), V3D(1., 0., 0.));
+      TS_ASSERT_EQUALS(loadedInfo.position(1), V3D(2., 0.5, 0.));
+      TS_ASSERT(loadedInfo.isMasked(0));
+      TS_ASSERT(!loadedInfo.isMasked(1));
+      const auto efixed =
+          loaded->getInstrument()->getDetector(2)->getNumberParameter(
+              "Efixed");
+      TS_ASSERT_EQUALS(efixed.size(), 1);
+      if (!efixed.empty())
+        TS_ASSERT_EQUALS(efixed[0], 3.5);
+      TS_ASSERT_EQUALS(loaded->spectrumInfo().detector(1).getID(), 2);
+    }
+    SharedMemoryWorkspace::unpublish(name, m_registry);
+  }
+
+private:
+  /// A source, a sample and two detectors with IDs 1 and 2 along x
+  static std::string instrumentXML() {
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"
+           "<instrument name=\"SharedMemoryInstrument\" "
+           "valid-from=\"1900-01-31 23:59:59\" "
+           "valid-to=\"2100-01-31 23:59:59\" "
+           "last-modified=\"2021-03-01T12:00:00\">"
+           "<defaults />"
+           "<component type=\"source\"><location z=\"-10\" /></component>"
+           "<type name=\"source\" is=\"Source\" />"
+           "<component type=\"sample\"><location /></component>"
+           "<type name=\"sample\" is=\"SamplePos\" />"
+           "<component type=\"pixel\" idlist=\"pixels\">"
+           "<location x=\"1\" /><location x=\"2\" />"
+           "</component>"
+           "<type is=\"detector\" name=\"pixel\">"
+           "<cuboid id=\"pixel-shape\" />"
+           "<algebra val=\"pixel-shape\" />"
+           "</type>"
+           "<idlist idname=\"pixels\"><id start=\"1\" end=\"2\" /></idlist>"
+           "</instrument>";
+  }
+
+  void addLogs(MatrixWorkspace &workspace) {
+    auto &run = workspace.mutableRun();
+    auto temperature = std::make_unique<TimeSeriesProperty<double>>("temp");
+    temperature->addValue(DateAndTime("2021-03-01T12:00:00"), 290.);
+    temperature->addValue(DateAndTime("2021-03-01T12:00:10"), 300.);
+    temperature->setUnits("K");
+    run.addProperty(std::move(temperature));
+    auto state = std::make_unique<TimeSeriesProperty<std::string>>("state");
+    state->addValue(DateAndTime("2021-03-01T12:00:00"), "running");
+    run.addProperty(std::move(state));
+    auto running = std::make_unique<TimeSeriesProperty<bool>>("running");
+    running->addValue(DateAndTime("2021-03-01T12:00:00"), true);
+    running->addValue(DateAndTime("2021-03-01T12:00:05"), false);
+    run.addProperty(std::move(running));
+    auto counts = std::make_unique<TimeSeriesProperty<int>>("counts");
+    counts->addValue(DateAndTime("2021-03-01T12:00:00"), 7);
+    run.addProperty(std::move(counts));
+    run.addProperty("run_title", std::string("A run"));
+    run.addProperty("frames", 12);
+    run.addProperty("wavelength", 1.5);
+  }
+
+  void checkLogs(const MatrixWorkspace &workspace) {
+    const auto &run = workspace.run();
+    const auto temperature = dynamic_cast<TimeSeriesProperty<double> *>(
+        run.getProperty("temp"));
+    TS_ASSERT(temperature);
+    TS_ASSERT_EQUALS(temperature->valuesAsVector(),
+                     std::vector<double>({290., 300.}));
+    TS_ASSERT_EQUALS(temperature->firstTime(),
+                     DateAndTime("2021-03-01T12:00:00"));
+    TS_ASSERT_EQUALS(temperature->units(), "K");
+    const auto state = dynamic_cast<TimeSeriesProperty<std::string> *>(
+        run.getProperty("state"));
+    TS_ASSERT(state);
+    TS_ASSERT_EQUALS(state->firstValue(), "running");
+    const auto running = dynamic_cast<TimeSeriesProperty<bool> *>(
+        run.getProperty("running"));
+    TS_ASSERT(running);
+    TS_ASSERT_EQUALS(running->valuesAsVector(),
+                     std::vector<bool>({true, false}));
+    const auto counts =
+        dynamic_cast<TimeSeriesProperty<int> *>(run.getProperty("counts"));
+    TS_ASSERT(counts);
+    TS_ASSERT_EQUALS(counts->firstValue(), 7);
+    TS_ASSERT_EQUALS(run.getPropertyValueAsType<std::string>("run_title"),
+                     "A run");
+    TS_ASSERT_EQUALS(run.getPropertyValueAsType<int>("frames"), 12);
+    TS_ASSERT_EQUALS(run.getPropertyValueAsType<double>("wavelength"), 1.5);
+  }
+
+  const std::string m_registryFile;
+  const PublishedWorkspaceRegistry m_registry;
+};
@@ -21,6 +21,7 @@ class DateAndTime;
 }
 } // namespace Types
 namespace Kernel {
+class BatchUnitConversion;
 class SplittingInterval;
 using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
@@ -275,6 +276,19 @@ public:
 
   std::vector<Mantid::Types::Core::DateAndTime> getPulseTimes() const override;
 
+  void copyColumns(double *tofs, int64_t *pulseTimes, double *weights,
+                   double *errors) const;
+
+  /// One field of the stored events, seen in place as a strided array
+  struct StridedField {
+    /// The field of the first event, or nullptr if there are no events
+    const char *data;
+    /// The number of bytes from one event to the next
+    size_t stride;
+  };
+  StridedField tofField() const;
+  StridedField pulseTimeField() const;
+
   void setTofs(const MantidVec &tofs) override;
 
   void reverse();
@@ -478,6 +492,10 @@ private:
   getPulseTimesHelper(const std::vector<T> &events,
                       std::vector<Mantid::Types::Core::DateAndTime> &times);
   template <class T>
+  static void copyColumnsHelper(const std::vector<T> &events, double *tofs,
+                                int64_t *pulseTimes, double *weights,
+                                double *errors);
+  template <class T>
   static void setTofsHelper(std::vector<T> &events,
                             const std::vector<double> &tofs);
   template <class T>
@@ -540,9 +558,9 @@ private:
   static void divideHistogramHelper(std::vector<T> &events, const MantidVec &X,
                                     const MantidVec &Y, const MantidVec &E);
   template <class T>
-  void convertUnitsViaTofHelper(typename std::vector<T> &events,
-                                Mantid::Kernel::Unit *fromUnit,
-                                Mantid::Kernel::Unit *toUnit);
+  static void
+  convertUnitsViaTofHelper(typename std::vector<T> &events,
+                           const Kernel::BatchUnitConversion &conversion);
   template <class T>
   void convertUnitsQuicklyHelper(typename std::vector<T> &events,
                                  const double &factor, const double &power);
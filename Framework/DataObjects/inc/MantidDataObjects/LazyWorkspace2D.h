@@ -0,0 +1,108 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidHistogramData/HistogramDx.h"
+#include "MantidHistogramData/HistogramX.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** LazyWorkspace2D : A Workspace2D whose spectra are read from a backing
+  store the first time they are accessed.
+
+  The spectra are read in blocks by a BlockReader. A small MRU list keeps the
+  most recently read blocks so that the neighbours of an accessed spectrum
+  can be filled without another read. A filled spectrum is never dropped, so
+  references to spectra stay valid, and once every spectrum has been filled
+  the reader is released. materialize() fills all remaining spectra at once.
+
+  The workspace behaves as a Workspace2D in every other respect: its id is
+  "Workspace2D" and clones are fully loaded Workspace2Ds that no longer
+  refer to the backing store.
+*/
+class DLLExport LazyWorkspace2D : public Workspace2D {
+public:
+  /// The data of a single spectrum. X and Dx are null if not read.
+  struct SpectrumData {
+    Kernel::cow_ptr<HistogramData::HistogramX> x{nullptr};
+    Kernel::cow_ptr<HistogramData::HistogramY> y{nullptr};
+    Kernel::cow_ptr<HistogramData::HistogramE> e{nullptr};
+    Kernel::cow_ptr<HistogramData::HistogramDx> dx{nullptr};
+  };
+
+  /// Reads consecutive spectra from the backing store
+  class DLLExport BlockReader {
+  public:
+    virtual ~BlockReader() = default;
+    /// The number of spectra read at once
+    virtual size_t blockSize() const = 0;
+    /// True if all spectra share the X values already set on the workspace,
+    /// in which case read() returns no X
+    virtual bool hasCommonBins() const = 0;
+    /// Read count spectra starting at workspace index first
+    virtual std::vector<SpectrumData> read(size_t first, size_t count) = 0;
+  };
+
+  LazyWorkspace2D(
+      const Parallel::StorageMode storageMode = Parallel::StorageMode::Cloned);
+  LazyWorkspace2D &operator=(const LazyWorkspace2D &other) = delete;
+
+  void setBlockReader(std::unique_ptr<BlockReader> reader);
+  void materialize() const;
+  /// True if every spectrum has been read
+  bool isMaterialized() const { return m_remaining.load() == 0; }
+  /// The number of spectra still to be read
+  size_t numberOfUnloadedSpectra() const { return m_remaining.load(); }
+
+  Histogram1D &getSpectrum(const size_t index) override;
+  const Histogram1D &getSpectrum(const size_t index) const override;
+
+  bool isCommonBins() const override;
+
+  void setImageY(const API::MantidImage &image, size_t start = 0,
+                 bool parallelExecution = true) override;
+  void setImageE(const API::MantidImage &image, size_t start = 0,
+                 bool parallelExecution = true) override;
+  void setImageYAndE(const API::MantidImage &imageY,
+                     const API::MantidImage &imageE, size_t start = 0,
+                     bool loadAsRectImg = false, double scale_1 = 1.0,
+                     bool parallelExecution = true);
+
+protected:
+  /// Protected copy constructor. The copy is fully loaded.
+  LazyWorkspace2D(const LazyWorkspace2D &other);
+
+private:
+  using Block = TypeWithMarker<std::vector<SpectrumData>>;
+
+  LazyWorkspace2D *doClone() const override;
+  void load(const size_t index) const;
+  void fill(const size_t index, const SpectrumData &spectrum) const;
+
+  /// Reads the spectra, released once all of them are loaded
+  mutable std::unique_ptr<BlockReader> m_reader;
+  /// The most recently read blocks, keyed by their first workspace index
+  mutable Kernel::MRUList<Block> m_blocks{4};
+  /// Whether each spectrum has been filled
+  std::unique_ptr<std::atomic<bool>[]> m_loaded;
+  /// The number of spectra not yet filled
+  mutable std::atomic<size_t> m_remaining{0};
+  /// True if the reader provides no X and the X have not been modified
+  std::atomic<bool> m_commonBins{false};
+  /// Serialises reads and fills
+  mutable std::mutex m_mutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -13,6 +13,9 @@
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidDataObjects/Workspace2D_fwd.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Mantid {
 
 namespace DataObjects {
@@ -22,6 +25,12 @@ namespace DataObjects {
     Since Histogram1D have share ownership of X, Y or E arrays,
     duplication is avoided for workspaces for example with identical time bins.
 
+    The X, Y, E and Dx arrays can be released to a store by
+    releaseHistograms(). They are read back, under a lock, the next time any
+    spectrum or size is accessed. The released Histogram1D objects are set
+    aside rather than freed, so references taken before the release stay
+    valid until discardReleasedHistograms() is called.
+
     \author Laurent C Chapon, ISIS, RAL
     \date 26/09/2007
 */
@@ -69,6 +78,13 @@ public:
   }
   const Histogram1D &getSpectrum(const size_t index) const override;
 
+  bool releaseHistograms(const HistogramStore &store) override;
+  void discardReleasedHistograms() override;
+  /// True if the histograms have been released and not yet read back
+  bool histogramsReleased() const {
+    return m_histogramsReleased.load(std::memory_order_acquire);
+  }
+
   /// Generate a new histogram by rebinning the existing histogram.
   void generateHistogram(const std::size_t index, const MantidVec &X,
                          MantidVec &Y, MantidVec &E,
@@ -112,6 +128,23 @@ private:
 
   Histogram1D &getSpectrumWithoutInvalidation(const size_t index) override;
   virtual std::size_t getHistogramNumberHelper() const;
+
+  /// Read the histograms back if they have been released
+  void restoreHistograms() const {
+    if (histogramsReleased())
+      readBackHistograms();
+  }
+  void readBackHistograms() const;
+  const std::vector<std::unique_ptr<Histogram1D>> &residentData() const;
+
+  /// Released spectra, kept until nothing can refer to them
+  std::vector<std::unique_ptr<Histogram1D>> m_releasedData;
+  /// Reads the released histograms back, empty if they are in memory
+  mutable HistogramSource m_histogramSource;
+  /// True while the histograms are released
+  mutable std::atomic<bool> m_histogramsReleased{false};
+  /// Serialises releasing and reading back the histograms
+  mutable std::mutex m_histogramMutex;
 };
 } // namespace DataObjects
 } // Namespace Mantid
@@ -8,6 +8,7 @@
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidDataObjects/Histogram1D.h"
+#include "MantidKernel/BatchUnitConversion.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
@@ -3041,6 +3042,113 @@ std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
   return times;
 }
 
+// --------------------------------------------------------------------------
+/** Write the fields of all events in a list to arrays
+ *
+ * @param events :: source vector of events
+ * @param tofs :: array for the TOFs, or nullptr
+ * @param pulseTimes :: array for the pulse times, or nullptr
+ * @param weights :: array for the weights, or nullptr
+ * @param errors :: array for the weight errors, or nullptr
+ */
+template <class T>
+void EventList::copyColumnsHelper(const std::vector<T> &events, double *tofs,
+                                  int64_t *pulseTimes, double *weights,
+                                  double *errors) {
+  const size_t numEvents = events.size();
+  for (size_t i = 0; i < numEvents; ++i) {
+    const auto &event = events[i];
+    if (tofs)
+      tofs[i] = event.tof();
+    if (pulseTimes)
+      pulseTimes[i] = event.pulseTime().totalNanoseconds();
+    if (weights)
+      weights[i] = event.weight();
+    if (errors)
+      errors[i] = event.error();
+  }
+}
+
+/** Write the fields of each event in this EventList to arrays in one pass,
+ * without allocating a vector per field. Each array must hold at least
+ * getNumberEvents() values; a nullptr skips that field.
+ *
+ * @param tofs :: array for the TOFs
+ * @param pulseTimes :: array for the pulse times, in nanoseconds since the
+ * DateAndTime epoch
+ * @param weights :: array for the weights
+ * @param errors :: array for the weight errors
+ */
+void EventList::copyColumns(double *tofs, int64_t *pulseTimes, double *weights,
+                            double *errors) const {
+  switch (eventType) {
+  case TOF:
+    copyColumnsHelper(this->events, tofs, pulseTimes, weights, errors);
+    break;
+  case WEIGHTED:
+    copyColumnsHelper(this->weightedEvents, tofs, pulseTimes, weights, errors);
+    break;
+  case WEIGHTED_NOTIME:
+    copyColumnsHelper(this->weightedEventsNoTime, tofs, pulseTimes, weights,
+                      errors);
+    break;
+  }
+}
+
+/** Locate the TOFs of the events as stored, so that they can be viewed
+ * without copying. The location is invalidated by any change to the list.
+ *
+ * @return The address of the first TOF and the stride between events
+ */
+EventList::StridedField EventList::tofField() const {
+  switch (eventType) {
+  case TOF:
+    return {events.empty()
+                ? nullptr
+                : reinterpret_cast<const char *>(&events.front().m_tof),
+            sizeof(Types::Event::TofEvent)};
+  case WEIGHTED:
+    return {weightedEvents.empty() ? nullptr
+                                   : reinterpret_cast<const char *>(
+                                         &weightedEvents.front().m_tof),
+            sizeof(WeightedEvent)};
+  case WEIGHTED_NOTIME:
+    return {weightedEventsNoTime.empty()
+                ? nullptr
+                : reinterpret_cast<const char *>(
+                      &weightedEventsNoTime.front().m_tof),
+            sizeof(WeightedEventNoTime)};
+  }
+  throw std::runtime_error("EventList: invalid event type");
+}
+
+/** Locate the pulse times of the events as stored, as 64 bit nanoseconds
+ * since the DateAndTime epoch, so that they can be viewed without copying.
+ * The location is invalidated by any change to the list.
+ *
+ * @return The address of the first pulse time and the stride between events
+ * @throws std::runtime_error if the events do not have pulse times
+ */
+EventList::StridedField EventList::pulseTimeField() const {
+  static_assert(sizeof(Types::Core::DateAndTime) == sizeof(int64_t),
+                "DateAndTime must hold only its nanoseconds");
+  switch (eventType) {
+  case TOF:
+    return {events.empty()
+                ? nullptr
+                : reinterpret_cast<const char *>(&events.front().m_pulsetime),
+            sizeof(Types::Event::TofEvent)};
+  case WEIGHTED:
+    return {weightedEvents.empty() ? nullptr
+                                   : reinterpret_cast<const char *>(
+                                         &weightedEvents.front().m_pulsetime),
+            sizeof(WeightedEvent)};
+  default:
+    throw std::runtime_error(
+        "EventList: WEIGHTED_NOTIME events do not have pulse times");
+  }
+}
+
 // --------------------------------------------------------------------------
 /**
  * @return The minimum tof value for the list of the events.
@@ -4829,23 +4937,26 @@ void getEventsFrom(const EventList &el,
 
 //--------------------------------------------------------------------------
 /** Helper function for the conversion to TOF. This handles the different
- *  event types.
+ *  event types. The times are copied out in blocks so that the conversion
+ *  runs over contiguous arrays.
  *
  * @param events the list of events
- * @param fromUnit the unit to convert from
- * @param toUnit the unit to convert to
+ * @param conversion the conversion between the units
  */
 template <class T>
-void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
-                                         Mantid::Kernel::Unit *fromUnit,
-                                         Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+void EventList::convertUnitsViaTofHelper(
+    typename std::vector<T> &events,
+    const Mantid::Kernel::BatchUnitConversion &conversion) {
+  constexpr size_t blockSize{1024};
+  std::array<double, blockSize> block;
+  for (size_t start = 0; start < events.size(); start += blockSize) {
+    const size_t count = std::min(blockSize, events.size() - start);
+    auto first = events.begin() + start;
+    for (size_t i = 0; i < count; ++i)
+      block[i] = first[i].m_tof;
+    conversion.convert(block.data(), count);
+    for (size_t i = 0; i < count; ++i)
+      first[i].m_tof = block[i];
   }
 }
 
@@ -4870,15 +4981,16 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
     throw std::runtime_error(
         "EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  const Kernel::BatchUnitConversion conversion(*fromUnit, *toUnit);
   switch (eventType) {
   case TOF:
-    convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
+    convertUnitsViaTofHelper(this->events, conversion);
     break;
   case WEIGHTED:
-    convertUnitsViaTofHelper(this->weightedEvents, fromUnit, toUnit);
+    convertUnitsViaTofHelper(this->weightedEvents, conversion);
     break;
   case WEIGHTED_NOTIME:
-    convertUnitsViaTofHelper(this->weightedEventsNoTime, fromUnit, toUnit);
+    convertUnitsViaTofHelper(this->weightedEventsNoTime, conversion);
     break;
   }
 }
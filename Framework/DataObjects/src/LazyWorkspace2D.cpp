@@ -0,0 +1,182 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/LazyWorkspace2D.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Load all spectra of a workspace before it is copied
+const LazyWorkspace2D &materialized(const LazyWorkspace2D &workspace) {
+  workspace.materialize();
+  return workspace;
+}
+} // namespace
+
+/// Constructor
+LazyWorkspace2D::LazyWorkspace2D(const Parallel::StorageMode storageMode)
+    : Workspace2D(storageMode) {}
+
+/// Copy constructor. The other workspace is loaded first, and the copy does
+/// not refer to its reader.
+LazyWorkspace2D::LazyWorkspace2D(const LazyWorkspace2D &other)
+    : Workspace2D(materialized(other)) {}
+
+/**
+ * Set the reader of the spectra. The workspace must already be initialized,
+ * and any data set on it is replaced as the spectra are read. Spectrum
+ * numbers, detector IDs and masking are kept.
+ * @param reader :: The reader for the spectra of this workspace
+ */
+void LazyWorkspace2D::setBlockReader(std::unique_ptr<BlockReader> reader) {
+  if (!reader)
+    throw std::invalid_argument("LazyWorkspace2D: the reader is null");
+  if (reader->blockSize() == 0)
+    throw std::invalid_argument("LazyWorkspace2D: the block size is zero");
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const size_t numberOfSpectra = data.size();
+  m_loaded.reset(new std::atomic<bool>[numberOfSpectra]);
+  for (size_t i = 0; i < numberOfSpectra; ++i)
+    m_loaded[i].store(false);
+  m_commonBins.store(reader->hasCommonBins());
+  invalidateCommonBinsFlag();
+  m_blocks.clear();
+  m_reader = std::move(reader);
+  m_remaining.store(numberOfSpectra);
+  if (numberOfSpectra == 0)
+    m_reader.reset();
+}
+
+/// Read all spectra that have not been read yet
+void LazyWorkspace2D::materialize() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_remaining.load() == 0)
+    return;
+  const size_t blockSize = m_reader->blockSize();
+  for (size_t first = 0; first < data.size() && m_remaining.load() > 0;
+       first += blockSize) {
+    const size_t count = std::min(blockSize, data.size() - first);
+    if (std::all_of(
+            m_loaded.get() + first, m_loaded.get() + first + count,
+            [](const std::atomic<bool> &loaded) { return loaded.load(); }))
+      continue;
+    // Blocks read here are not added to the MRU list as they will not be
+    // wanted again
+    std::vector<SpectrumData> read;
+    const auto *block = m_blocks.find(first);
+    if (!block)
+      read = m_reader->read(first, count);
+    const auto &spectra = block ? block->m_data : read;
+    for (size_t i = 0; i < count; ++i)
+      if (!m_loaded[first + i].load())
+        fill(first + i, spectra[i]);
+  }
+}
+
+/// Return the spectrum at the given workspace index, marking the bins as
+/// possibly modified
+Histogram1D &LazyWorkspace2D::getSpectrum(const size_t index) {
+  m_commonBins.store(false);
+  return Workspace2D::getSpectrum(index);
+}
+
+/// Return the spectrum at the given workspace index, reading it if needed
+const Histogram1D &LazyWorkspace2D::getSpectrum(const size_t index) const {
+  const auto &spectrum = Workspace2D::getSpectrum(index);
+  if (m_remaining.load(std::memory_order_acquire) > 0 &&
+      !m_loaded[index].load(std::memory_order_acquire))
+    load(index);
+  return spectrum;
+}
+
+/// Whether all spectra have the same bins. This does not read the spectra
+/// if the reader provides a single set of X values.
+bool LazyWorkspace2D::isCommonBins() const {
+  if (m_commonBins.load())
+    return true;
+  return Workspace2D::isCommonBins();
+}
+
+/// Copy the data (Y's) from an image to this workspace, after reading it.
+void LazyWorkspace2D::setImageY(const API::MantidImage &image, size_t start,
+                                bool parallelExecution) {
+  materialize();
+  Workspace2D::setImageY(image, start, parallelExecution);
+}
+
+/// Copy the data from an image to this workspace's errors, after reading it.
+void LazyWorkspace2D::setImageE(const API::MantidImage &image, size_t start,
+                                bool parallelExecution) {
+  materialize();
+  Workspace2D::setImageE(image, start, parallelExecution);
+}
+
+/// Copy the data from an image to the (Y's) and the errors for this
+/// workspace, after reading it.
+void LazyWorkspace2D::setImageYAndE(const API::MantidImage &imageY,
+                                    const API::MantidImage &imageE,
+                                    size_t start, bool loadAsRectImg,
+                                    double scale_1, bool parallelExecution) {
+  materialize();
+  Workspace2D::setImageYAndE(imageY, imageE, start, loadAsRectImg, scale_1,
+                             parallelExecution);
+}
+
+LazyWorkspace2D *LazyWorkspace2D::doClone() const {
+  return new LazyWorkspace2D(*this);
+}
+
+/**
+ * Fill a spectrum from its block, reading the block if it is not in the MRU
+ * list
+ * @param index :: The workspace index of the spectrum
+ */
+void LazyWorkspace2D::load(const size_t index) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_loaded[index].load())
+    return;
+  const size_t blockSize = m_reader->blockSize();
+  const size_t first = index / blockSize * blockSize;
+  auto *block = m_blocks.find(first);
+  if (!block) {
+    auto newBlock = std::make_shared<Block>(first);
+    newBlock->m_data =
+        m_reader->read(first, std::min(blockSize, data.size() - first));
+    block = newBlock.get();
+    m_blocks.insert(std::move(newBlock));
+  }
+  fill(index, block->m_data[index - first]);
+}
+
+/**
+ * Set the data of a spectrum. The reader and the blocks are released after
+ * the last spectrum. Must be called with the mutex locked.
+ * @param index :: The workspace index of the spectrum
+ * @param spectrum :: The data read for the spectrum
+ */
+void LazyWorkspace2D::fill(const size_t index,
+                           const SpectrumData &spectrum) const {
+  // The spectrum is logically part of this workspace already
+  auto &histogram = *data[index];
+  if (spectrum.x)
+    histogram.setSharedX(spectrum.x);
+  histogram.setSharedY(spectrum.y);
+  histogram.setSharedE(spectrum.e);
+  if (spectrum.dx)
+    histogram.setSharedDx(spectrum.dx);
+  m_loaded[index].store(true, std::memory_order_release);
+  if (--m_remaining == 0) {
+    m_reader.reset();
+    m_blocks.clear();
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <sstream>
+#include <typeinfo>
 
 using Mantid::API::MantidImage;
 
@@ -31,9 +32,10 @@ Workspace2D::Workspace2D(const Parallel::StorageMode storageMode)
 
 Workspace2D::Workspace2D(const Workspace2D &other)
     : HistoWorkspace(other), m_monitorList(other.m_monitorList) {
-  data.resize(other.data.size());
+  const auto &otherData = other.residentData();
+  data.resize(otherData.size());
   for (size_t i = 0; i < data.size(); ++i) {
-    data[i] = std::make_unique<Histogram1D>(*(other.data[i]));
+    data[i] = std::make_unique<Histogram1D>(*(otherData[i]));
   }
 }
 
@@ -107,6 +109,7 @@ void Workspace2D::init(const HistogramData::Histogram &histogram) {
 ///  Returns true if the workspace is ragged (has differently sized spectra).
 /// @returns true if the workspace is ragged.
 bool Workspace2D::isRaggedWorkspace() const {
+  restoreHistograms();
   if (data.empty()) {
     throw std::runtime_error("There is no data in the Workspace2D, "
                              "therefore cannot determine if it is ragged.");
@@ -128,6 +131,7 @@ size_t Workspace2D::getNumberHistograms() const {
 
 /// get pseudo size
 size_t Workspace2D::size() const {
+  restoreHistograms();
   return std::accumulate(
       data.begin(), data.end(), static_cast<size_t>(0),
       [](const size_t value, const std::unique_ptr<Histogram1D> &histo) {
@@ -137,6 +141,7 @@ size_t Workspace2D::size() const {
 
 /// get the size of each vector
 size_t Workspace2D::blocksize() const {
+  restoreHistograms();
   if (data.empty()) {
     return 0;
   } else {
@@ -154,6 +159,7 @@ size_t Workspace2D::blocksize() const {
  * @return the number of bins for a given histogram index.
  */
 std::size_t Workspace2D::getNumberBins(const std::size_t &index) const {
+  restoreHistograms();
   if (index < data.size())
     return data[index]->size();
 
@@ -166,6 +172,7 @@ std::size_t Workspace2D::getNumberBins(const std::size_t &index) const {
  * @return the maximum number of bins in a workspace.
  */
 std::size_t Workspace2D::getMaxNumberBins() const {
+  restoreHistograms();
   if (data.empty()) {
     return 0;
   } else {
@@ -225,6 +232,7 @@ void Workspace2D::setImageYAndE(const API::MantidImage &imageY,
                                 bool parallelExecution) {
   UNUSED_ARG(parallelExecution) // for parallel for
 
+  restoreHistograms();
   if (imageY.empty() && imageE.empty())
     return;
   if (imageY.empty() && imageE[0].empty())
@@ -327,9 +335,74 @@ const Histogram1D &Workspace2D::getSpectrum(const size_t index) const {
        << " out of range " << data.size();
     throw std::range_error(ss.str());
   }
+  restoreHistograms();
   return *data[index];
 }
 
+/**
+ * Store the histograms and replace each spectrum with an empty one. Spectrum
+ * numbers, detector IDs and everything else but the data stay in memory. The
+ * released spectra are set aside, not freed, so a reference to their data
+ * taken before the release stays valid until discardReleasedHistograms() is
+ * called. Only plain Workspace2Ds are released, as derived types hold data of
+ * their own.
+ * @param store :: Stores the histograms and returns how to read them back
+ * @return True if the histograms were released
+ */
+bool Workspace2D::releaseHistograms(const HistogramStore &store) {
+  if (typeid(*this) != typeid(Workspace2D))
+    return false;
+  std::lock_guard<std::mutex> lock(m_histogramMutex);
+  if (histogramsReleased())
+    return false;
+  auto source = store(*this);
+  if (!source)
+    return false;
+  m_releasedData.reserve(m_releasedData.size() + data.size());
+  for (auto &spectrum : data) {
+    auto empty = std::make_unique<Histogram1D>(*spectrum);
+    empty->setHistogram(HistogramData::Points(0), HistogramData::Counts(0),
+                        HistogramData::CountStandardDeviations(0));
+    m_releasedData.emplace_back(std::move(spectrum));
+    spectrum = std::move(empty);
+  }
+  m_histogramSource = std::move(source);
+  m_histogramsReleased.store(true, std::memory_order_release);
+  return true;
+}
+
+/// Free the spectra set aside by releaseHistograms()
+void Workspace2D::discardReleasedHistograms() {
+  std::vector<std::unique_ptr<Histogram1D>> released;
+  {
+    std::lock_guard<std::mutex> lock(m_histogramMutex);
+    released.swap(m_releasedData);
+  }
+}
+
+/// Read released histograms back. The workspace stays released if that fails
+void Workspace2D::readBackHistograms() const {
+  std::lock_guard<std::mutex> lock(m_histogramMutex);
+  if (!histogramsReleased())
+    return;
+  auto histograms = m_histogramSource();
+  if (histograms.size() != data.size())
+    throw std::runtime_error("Workspace2D: the released histograms do not "
+                             "match the workspace");
+  // The histograms are logically part of this workspace already
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i]->setHistogram(std::move(histograms[i]));
+  m_histogramSource = nullptr;
+  m_histogramsReleased.store(false, std::memory_order_release);
+}
+
+/// The spectra, with any released histograms read back
+const std::vector<std::unique_ptr<Histogram1D>> &
+Workspace2D::residentData() const {
+  restoreHistograms();
+  return data;
+}
+
 //--------------------------------------------------------------------------------------------
 /** Returns the number of histograms.
  *  For some reason Visual Studio couldn't deal with the main
@@ -354,6 +427,7 @@ void Workspace2D::generateHistogram(const std::size_t index, const MantidVec &X,
                                     MantidVec &Y, MantidVec &E,
                                     bool skipError) const {
   UNUSED_ARG(skipError);
+  restoreHistograms();
   if (index >= data.size())
     throw std::range_error(
         "Workspace2D::generateHistogram, histogram number out of range");
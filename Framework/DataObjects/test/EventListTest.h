@@ -18,6 +18,7 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <cmath>
+#include <cstring>
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -1386,6 +1387,60 @@ public:
     TS_ASSERT_EQUALS(times[2].totalNanoseconds(), 2);
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_copyColumns_matches_the_getters() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_time_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      const size_t numEvents = el.getNumberEvents();
+      std::vector<double> tofs(numEvents), weights(numEvents),
+          errors(numEvents);
+      std::vector<int64_t> times(numEvents, -1);
+      el.copyColumns(tofs.data(),
+                     this_type == WEIGHTED_NOTIME ? nullptr : times.data(),
+                     weights.data(), errors.data());
+      TSM_ASSERT_EQUALS(this_type, tofs, el.getTofs());
+      TSM_ASSERT_EQUALS(this_type, weights, el.getWeights());
+      TSM_ASSERT_EQUALS(this_type, errors, el.getWeightErrors());
+      if (this_type == WEIGHTED_NOTIME) {
+        TS_ASSERT_EQUALS(times[0], -1);
+      } else {
+        const auto pulseTimes = el.getPulseTimes();
+        for (size_t i = 0; i < numEvents; ++i)
+          TS_ASSERT_EQUALS(times[i], pulseTimes[i].totalNanoseconds());
+      }
+    }
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  void test_strided_fields_view_the_stored_events() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_time_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      const auto tofs = el.getTofs();
+      const auto tofField = el.tofField();
+      for (size_t i = 0; i < tofs.size(); ++i) {
+        double tof;
+        std::memcpy(&tof, tofField.data + i * tofField.stride, sizeof(tof));
+        TSM_ASSERT_EQUALS(this_type, tof, tofs[i]);
+      }
+      if (this_type == WEIGHTED_NOTIME) {
+        TS_ASSERT_THROWS(el.pulseTimeField(), const std::runtime_error &);
+        continue;
+      }
+      const auto times = el.getPulseTimes();
+      const auto timeField = el.pulseTimeField();
+      for (size_t i = 0; i < times.size(); ++i) {
+        int64_t time;
+        std::memcpy(&time, timeField.data + i * timeField.stride,
+                    sizeof(time));
+        TSM_ASSERT_EQUALS(this_type, time, times[i].totalNanoseconds());
+      }
+    }
+    el.clear();
+    TS_ASSERT(!el.tofField().data);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_convertTof_allTypes() {
     // Go through each possible EventType as the input
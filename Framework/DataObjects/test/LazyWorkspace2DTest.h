@@ -0,0 +1,149 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/LazyWorkspace2D.h"
+
+using namespace Mantid::DataObjects;
+using namespace Mantid::HistogramData;
+using Mantid::Kernel::make_cow;
+
+namespace {
+/// Reads spectra with Y = 100 * index + bin, counting the reads
+class FakeBlockReader : public LazyWorkspace2D::BlockReader {
+public:
+  FakeBlockReader(size_t blockSize, bool commonBins,
+                  std::shared_ptr<size_t> reads)
+      : m_blockSize(blockSize), m_commonBins(commonBins),
+        m_reads(std::move(reads)) {}
+  size_t blockSize() const override { return m_blockSize; }
+  bool hasCommonBins() const override { return m_commonBins; }
+  std::vector<LazyWorkspace2D::SpectrumData> read(size_t first,
+                                                  size_t count) override {
+    ++*m_reads;
+    std::vector<LazyWorkspace2D::SpectrumData> spectra(count);
+    for (size_t i = 0; i < count; ++i) {
+      const auto index = static_cast<double>(first + i);
+      auto &spectrum = spectra[i];
+      spectrum.y = make_cow<HistogramY>(
+          std::vector<double>{100. * index, 100. * index + 1.,
+                              100. * index + 2.});
+      spectrum.e = make_cow<HistogramE>(3, index);
+      if (!m_commonBins)
+        spectrum.x = make_cow<HistogramX>(
+            std::vector<double>{index, index + 1., index + 2., index + 3.});
+    }
+    return spectra;
+  }
+
+private:
+  size_t m_blockSize;
+  bool m_commonBins;
+  std::shared_ptr<size_t> m_reads;
+};
+} // namespace
+
+class LazyWorkspace2DTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LazyWorkspace2DTest *createSuite() {
+    return new LazyWorkspace2DTest();
+  }
+  static void destroySuite(LazyWorkspace2DTest *suite) { delete suite; }
+
+  void test_spectra_are_read_on_first_access() {
+    auto ws = createWorkspace(10, 4, true);
+    TS_ASSERT_EQUALS(*m_reads, 0)
+    TS_ASSERT_EQUALS(ws->numberOfUnloadedSpectra(), 10)
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 10)
+    TS_ASSERT_EQUALS(ws->blocksize(), 3)
+
+    TS_ASSERT_EQUALS(ws->y(5)[1], 501.)
+    TS_ASSERT_EQUALS(ws->e(5)[0], 5.)
+    TS_ASSERT_EQUALS(*m_reads, 1)
+    // The neighbour is in the same block
+    TS_ASSERT_EQUALS(ws->y(6)[2], 602.)
+    TS_ASSERT_EQUALS(*m_reads, 1)
+    // The last block is short
+    TS_ASSERT_EQUALS(ws->y(9)[0], 900.)
+    TS_ASSERT_EQUALS(*m_reads, 2)
+    TS_ASSERT_EQUALS(ws->numberOfUnloadedSpectra(), 7)
+    TS_ASSERT(!ws->isMaterialized())
+  }
+
+  void test_blocks_dropped_from_the_MRU_list_are_read_again() {
+    auto ws = createWorkspace(12, 2, true);
+    // Read five blocks, one more than the MRU list holds
+    for (size_t i = 0; i < 10; i += 2)
+      ws->y(i);
+    TS_ASSERT_EQUALS(*m_reads, 5)
+    TS_ASSERT_EQUALS(ws->y(3)[0], 300.)
+    TS_ASSERT_EQUALS(*m_reads, 5)
+    TS_ASSERT_EQUALS(ws->y(1)[0], 100.)
+    TS_ASSERT_EQUALS(*m_reads, 6)
+    // Spectra already read are kept
+    TS_ASSERT_EQUALS(ws->y(0)[2], 2.)
+    TS_ASSERT_EQUALS(*m_reads, 6)
+  }
+
+  void test_modified_spectra_are_not_read_again() {
+    auto ws = createWorkspace(4, 4, true);
+    ws->mutableY(2)[0] = -1.;
+    TS_ASSERT_EQUALS(ws->y(2)[0], -1.)
+    TS_ASSERT_EQUALS(ws->y(2)[1], 201.)
+  }
+
+  void test_materialize_reads_all_remaining_blocks() {
+    auto ws = createWorkspace(10, 3, false);
+    ws->y(4);
+    ws->materialize();
+    TS_ASSERT(ws->isMaterialized())
+    TS_ASSERT_EQUALS(*m_reads, 4)
+    for (size_t i = 0; i < 10; ++i) {
+      TS_ASSERT_EQUALS(ws->y(i)[2], 100. * static_cast<double>(i) + 2.)
+      TS_ASSERT_EQUALS(ws->x(i)[0], static_cast<double>(i))
+    }
+    ws->materialize();
+    TS_ASSERT_EQUALS(*m_reads, 4)
+  }
+
+  void test_clone_is_fully_read() {
+    auto ws = createWorkspace(6, 4, true);
+    auto clone = ws->clone();
+    TS_ASSERT(ws->isMaterialized())
+    TS_ASSERT_EQUALS(*m_reads, 2)
+    TS_ASSERT_EQUALS(clone->id(), "Workspace2D")
+    TS_ASSERT_EQUALS(clone->y(5)[1], 501.)
+    TS_ASSERT_EQUALS(*m_reads, 2)
+  }
+
+  void test_common_bins_do_not_need_a_read() {
+    auto ws = createWorkspace(8, 4, true);
+    TS_ASSERT(ws->isCommonBins())
+    TS_ASSERT_EQUALS(*m_reads, 0)
+
+    auto varying = createWorkspace(8, 4, false);
+    TS_ASSERT(!varying->isCommonBins())
+    TS_ASSERT(varying->isMaterialized())
+  }
+
+private:
+  std::shared_ptr<LazyWorkspace2D>
+  createWorkspace(size_t numberOfSpectra, size_t blockSize, bool commonBins) {
+    m_reads = std::make_shared<size_t>(0);
+    auto ws = std::make_shared<LazyWorkspace2D>();
+    ws->initialize(numberOfSpectra, 4, 3);
+    ws->setBlockReader(
+        std::make_unique<FakeBlockReader>(blockSize, commonBins, m_reads));
+    return ws;
+  }
+
+  std::shared_ptr<size_t> m_reads;
+};
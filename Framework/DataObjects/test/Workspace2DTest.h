@@ -281,6 +281,95 @@ public:
     TS_ASSERT_THROWS_ANYTHING(ws->getSpectrum(4));
   }
 
+  void test_released_histograms_are_read_back_when_used() {
+    auto workspace = create2DWorkspaceBinned(3, 4);
+    workspace->mutableY(1)[2] = 7.;
+    const auto expected = workspace->clone();
+    int reads = 0;
+    const auto store = [&reads](const MatrixWorkspace &matrix)
+        -> Workspace2D::HistogramSource {
+      std::vector<Histogram> histograms;
+      for (size_t i = 0; i < matrix.getNumberHistograms(); ++i)
+        histograms.emplace_back(matrix.histogram(i));
+      return [histograms, &reads]() {
+        ++reads;
+        return histograms;
+      };
+    };
+    TS_ASSERT(workspace->releaseHistograms(store));
+    TS_ASSERT(workspace->histogramsReleased())
+    TS_ASSERT_EQUALS(workspace->getNumberHistograms(), 3)
+    TS_ASSERT_EQUALS(reads, 0)
+
+    TS_ASSERT_EQUALS(workspace->y(1), expected->y(1))
+    TS_ASSERT(!workspace->histogramsReleased())
+    TS_ASSERT_EQUALS(reads, 1)
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_EQUALS(workspace->x(i), expected->x(i))
+      TS_ASSERT_EQUALS(workspace->e(i), expected->e(i))
+      TS_ASSERT_EQUALS(workspace->getSpectrum(i).getSpectrumNo(),
+                       expected->getSpectrum(i).getSpectrumNo())
+    }
+    TS_ASSERT_EQUALS(reads, 1)
+  }
+
+  void test_clone_of_released_workspace_has_the_data() {
+    auto workspace = create2DWorkspaceBinned(2, 3);
+    const auto expected = workspace->clone();
+    TS_ASSERT(workspace->releaseHistograms(
+        [](const MatrixWorkspace &matrix) -> Workspace2D::HistogramSource {
+          std::vector<Histogram> histograms;
+          for (size_t i = 0; i < matrix.getNumberHistograms(); ++i)
+            histograms.emplace_back(matrix.histogram(i));
+          return [histograms]() { return histograms; };
+        }));
+    const auto cloned = workspace->clone();
+    TS_ASSERT_EQUALS(cloned->size(), expected->size())
+    TS_ASSERT_EQUALS(cloned->y(1), expected->y(1))
+  }
+
+  void test_released_spectra_are_kept_until_discarded() {
+    auto workspace = create2DWorkspaceBinned(2, 3);
+    workspace->mutableY(1)[2] = 7.;
+    const auto &y = workspace->y(1);
+    TS_ASSERT(workspace->releaseHistograms(
+        [](const MatrixWorkspace &matrix) -> Workspace2D::HistogramSource {
+          std::vector<Histogram> histograms;
+          for (size_t i = 0; i < matrix.getNumberHistograms(); ++i) {
+            // Stored separately from the data in the workspace
+            histograms.emplace_back(matrix.histogram(i));
+            histograms.back().mutableY();
+          }
+          return [histograms]() { return histograms; };
+        }));
+    // A reference taken before the release still refers to the data
+    TS_ASSERT_EQUALS(y[2], 7.)
+    TS_ASSERT_EQUALS(workspace->y(1)[2], 7.)
+    TS_ASSERT_DIFFERS(&workspace->y(1), &y)
+    workspace->discardReleasedHistograms();
+    TS_ASSERT_EQUALS(workspace->y(1)[2], 7.)
+  }
+
+  void test_histograms_are_kept_if_they_cannot_be_stored() {
+    auto workspace = create2DWorkspaceBinned(2, 3);
+    TS_ASSERT(!workspace->releaseHistograms(
+        [](const MatrixWorkspace &) { return Workspace2D::HistogramSource(); }))
+    TS_ASSERT(!workspace->histogramsReleased())
+    TS_ASSERT_EQUALS(workspace->size(), 6)
+  }
+
+  void test_derived_workspaces_do_not_release_histograms() {
+    class DerivedWorkspace2D : public Workspace2D {};
+    DerivedWorkspace2D workspace;
+    workspace.initialize(2, 3, 3);
+    bool stored = false;
+    TS_ASSERT(!workspace.releaseHistograms([&stored](const MatrixWorkspace &) {
+      stored = true;
+      return Workspace2D::HistogramSource();
+    }))
+    TS_ASSERT(!stored)
+  }
+
   /**
    * Test that a Workspace2D_sptr can be held as a property and
    * retrieved as const or non-const sptr,
@@ -14,6 +14,7 @@
 
 #include "tbb/concurrent_unordered_map.h"
 
+#include <atomic>
 #include <memory>
 #include <typeinfo>
 #include <vector>
@@ -65,6 +66,10 @@ public:
   inline bool empty() const { return m_map.empty(); }
   /// Return the size of the map
   inline int size() const { return static_cast<int>(m_map.size()); }
+  /** Returns a stamp that changes whenever parameters are added, removed or
+   * replaced by a different value. Stamps are unique across all instances, a
+   * copy shares the stamp of the original until either is modified. */
+  size_t revision() const { return m_revision; }
   /// Return string to be used in the map
   static const std::string &pos();
   static const std::string &posx();
@@ -93,12 +98,15 @@ public:
   /// Clears the map
   inline void clear() {
     m_map.clear();
+    m_revision = nextRevision();
     clearPositionSensitiveCaches();
   }
   /// method swaps two parameter maps contents  each other. All caches contents
   /// is nullified (TO DO: it can be efficiently swapped too)
   void swap(ParameterMap &other) {
     m_map.swap(other.m_map);
+    m_revision = nextRevision();
+    other.m_revision = nextRevision();
     clearPositionSensitiveCaches();
   }
   /// Clear any parameters with the given name
@@ -339,6 +347,7 @@ private:
 
   /// Assignment operator
   ParameterMap &operator=(ParameterMap *rhs);
+  static size_t nextRevision();
   /// internal function to get position of the parameter in the parameter map
   component_map_it positionOf(const IComponent *comp, const char *name,
                               const char *type);
@@ -352,6 +361,8 @@ private:
 
   /// internal parameter map instance
   pmap m_map;
+  /// Stamp of the last modification of m_map, see revision()
+  std::atomic<size_t> m_revision{nextRevision()};
   /// internal cache map instance for cached position values
   std::unique_ptr<Kernel::Cache<const ComponentID, Kernel::V3D>> m_cacheLocMap;
   /// internal cache map instance for cached rotation values
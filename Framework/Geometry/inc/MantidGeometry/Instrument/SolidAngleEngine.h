@@ -0,0 +1,66 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class ComponentInfo;
+class IObject;
+
+/** SolidAngleEngine : Evaluates the solid angles subtended by the components
+  of an instrument.
+
+  Hexahedra and hollow cylinders, which CSGObject can only triangulate, are
+  handled directly in the shape's own frame: the observer is moved into that
+  frame once and the solid angle is evaluated from the faces (hexahedron) or
+  precomputed slice tables (hollow cylinder). Every other shape, including
+  the primitives CSGObject already treats specially, goes through
+  ComponentInfo::solidAngle.
+
+  detectorSolidAngles evaluates every detector in parallel and
+  cachedDetectorSolidAngles keeps the results of the most recent evaluations,
+  keyed on the instrument name, the detector geometry (including the content
+  of the detector shapes) and the observer position. The full key is kept
+  and compared, so repeated reductions with the same instrument and sample
+  position reuse the results and no other instrument ever does.
+*/
+class MANTID_GEOMETRY_DLL SolidAngleEngine {
+public:
+  explicit SolidAngleEngine(const ComponentInfo &componentInfo);
+
+  double solidAngle(const size_t componentIndex,
+                    const Kernel::V3D &observer) const;
+  std::vector<double> detectorSolidAngles(const Kernel::V3D &observer) const;
+  void prepareShapes() const;
+
+  static bool hasFastPath(const IObject &shape);
+  static double shapeSolidAngle(const IObject &shape,
+                                const Kernel::V3D &observer);
+  static double shapeSolidAngle(const IObject &shape,
+                                const Kernel::V3D &observer,
+                                const Kernel::V3D &scaleFactor);
+
+  static std::shared_ptr<const std::vector<double>>
+  cachedDetectorSolidAngles(const ComponentInfo &componentInfo,
+                            const Kernel::V3D &observer);
+  static void clearCache();
+  static size_t cacheSize();
+
+private:
+  size_t numberOfDetectors() const;
+
+  const ComponentInfo &m_componentInfo;
+};
+
+} // namespace Geometry
+} // namespace Mantid
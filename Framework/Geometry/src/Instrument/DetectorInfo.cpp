@@ -422,6 +422,13 @@ Kernel::V3D DetectorInfo::samplePosition() const {
 /// Returns L1 (distance from source to sample).
 double DetectorInfo::l1() const { return m_detectorInfo->l1(); }
 
+/** Returns a stamp that changes whenever detector or component positions,
+ * rotations or scale factors are modified. See
+ * Beamline::DetectorInfo::geometryRevision(). */
+size_t DetectorInfo::geometryRevision() const {
+  return m_detectorInfo->geometryRevision();
+}
+
 /// Returns a sorted vector of all detector IDs.
 const std::vector<detid_t> &DetectorInfo::detectorIDs() const {
   return *m_detectorIDs;
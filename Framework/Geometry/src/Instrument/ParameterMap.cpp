@@ -69,6 +69,7 @@ ParameterMap::ParameterMap()
 
 ParameterMap::ParameterMap(const ParameterMap &other)
     : m_parameterFileNames(other.m_parameterFileNames), m_map(other.m_map),
+      m_revision(other.m_revision.load()),
       m_cacheLocMap(
           std::make_unique<Kernel::Cache<const ComponentID, Kernel::V3D>>(
               *other.m_cacheLocMap)),
@@ -303,13 +304,17 @@ const std::string ParameterMap::diff(const ParameterMap &rhs,
 void ParameterMap::clearParametersByName(const std::string &name) {
   checkIsNotMaskingParameter(name);
   // Key is component ID so have to search through whole lot
+  bool erased(false);
   for (auto itr = m_map.begin(); itr != m_map.end();) {
     if (itr->second->name() == name) {
       PARALLEL_CRITICAL(unsafe_erase) { itr = m_map.unsafe_erase(itr); }
+      erased = true;
     } else {
       ++itr;
     }
   }
+  if (erased)
+    m_revision = nextRevision();
   // Check if the caches need invalidating
   if (name == pos() || name == rot())
     clearPositionSensitiveCaches();
@@ -326,13 +331,17 @@ void ParameterMap::clearParametersByName(const std::string &name,
   if (!m_map.empty()) {
     const ComponentID id = comp->getComponentID();
     auto itrs = m_map.equal_range(id);
+    bool erased(false);
     for (auto it = itrs.first; it != itrs.second;) {
       if (it->second->name() == name) {
         PARALLEL_CRITICAL(unsafe_erase) { it = m_map.unsafe_erase(it); }
+        erased = true;
       } else {
         ++it;
       }
     }
+    if (erased)
+      m_revision = nextRevision();
 
     // Check if the caches need invalidating
     if (name == pos() || name == rot())
@@ -387,7 +396,11 @@ void ParameterMap::add(const IComponent *comp,
   // an
   // add/replace-style function
   if (existing_par != m_map.end()) {
+    // Re-setting an identical value does not change the revision
+    const bool changed = !(*existing_par->second == *par);
     std::atomic_store(&(existing_par->second), par);
+    if (!changed)
+      return;
   } else {
 // When using Clang & Linux, TBB 4.4 doesn't detect C++11 features.
 // https://software.intel.com/en-us/forums/intel-threading-building-blocks/topic/641658
@@ -402,6 +415,7 @@ void ParameterMap::add(const IComponent *comp,
     m_map.insert(std::make_pair(comp->getComponentID(), par));
 #endif
   }
+  m_revision = nextRevision();
 }
 
 /** Create or adjust "pos" parameter for a component
@@ -641,6 +655,7 @@ void ParameterMap::forceUnsafeSetMasked(const IComponent *comp, bool value) {
 #else
   m_map.insert(std::make_pair(comp->getComponentID(), param));
 #endif
+  m_revision = nextRevision();
 }
 
 /**
@@ -1039,6 +1054,12 @@ void ParameterMap::clearPositionSensitiveCaches() {
   m_cacheRotMap->clear();
 }
 
+/// Returns a new, globally unique revision stamp.
+size_t ParameterMap::nextRevision() {
+  static std::atomic<size_t> revision{0};
+  return ++revision;
+}
+
 /// Sets a cached location on the location cache
 /// @param comp :: The Component to set the location of
 /// @param location :: The location
@@ -1095,6 +1116,8 @@ void ParameterMap::copyFromParameterMap(const IComponent *oldComp,
         std::make_pair(newComp->getComponentID(), std::move(thisParameter)));
 #endif
   }
+  if (!oldParameterNames.empty())
+    m_revision = nextRevision();
 }
 
 //--------------------------------------------------------------------------------------------
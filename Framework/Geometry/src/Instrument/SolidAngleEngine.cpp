@@ -0,0 +1,592 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Instrument/SolidAngleEngine.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/MeshObject.h"
+#include "MantidGeometry/Objects/MeshObject2D.h"
+#include "MantidGeometry/Rendering/GeometryHandler.h"
+#include "MantidGeometry/Rendering/ShapeInfo.h"
+#include "MantidGeometry/Surfaces/Cylinder.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Quat.h"
+#include "MantidKernel/Tolerance.h"
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::Quat;
+using Kernel::V3D;
+using detail::ShapeInfo;
+
+namespace {
+
+/// Number of instrument/observer combinations kept by the cache
+constexpr size_t MAX_CACHED_EVALUATIONS = 4;
+
+/// Cosine and sine of the slice boundaries used to facet round primitives.
+template <int NSlices> struct UnitCircle {
+  UnitCircle() {
+    constexpr double angleStep = 2. * M_PI / static_cast<double>(NSlices);
+    for (int slice = 0; slice < NSlices; ++slice) {
+      cosines[slice] = std::cos(angleStep * slice);
+      sines[slice] = std::sin(angleStep * slice);
+    }
+  }
+  std::array<double, NSlices> cosines;
+  std::array<double, NSlices> sines;
+};
+
+template <int NSlices> const UnitCircle<NSlices> &unitCircle() {
+  static const UnitCircle<NSlices> circle;
+  return circle;
+}
+
+/**
+ * Signed solid angle of the triangle a, b, c seen from the origin (Oosterom).
+ * Triangles whose vertices appear clockwise to the observer are positive.
+ */
+double signedTriangleSolidAngle(const V3D &a, const V3D &b, const V3D &c) {
+  const double modA = a.norm();
+  const double modB = b.norm();
+  const double modC = c.norm();
+  const double tripleProduct = a.scalar_prod(b.cross_prod(c));
+  const double denom = modA * modB * modC + modC * a.scalar_prod(b) +
+                       modB * a.scalar_prod(c) + modA * b.scalar_prod(c);
+  if (denom != 0.0)
+    return 2.0 * std::atan2(tripleProduct, denom);
+  return 0.0;
+}
+
+/**
+ * Solid angle of the triangle a, b, c seen from the origin if it faces the
+ * observer, zero otherwise. The triple product decides the facing without
+ * evaluating any square roots for the hidden half of a shape.
+ */
+double frontTriangleSolidAngle(const V3D &a, const V3D &b, const V3D &c) {
+  if (a.scalar_prod(b.cross_prod(c)) < 0.0)
+    return 0.0;
+  return std::max(signedTriangleSolidAngle(a, b, c), 0.0);
+}
+
+/**
+ * Moves an observer into the frame of an axially symmetric primitive whose
+ * base sits at the origin and whose axis is +Z. The rotation is the one used
+ * to facet these primitives in CSGObject so the slice edges line up.
+ */
+V3D toAxialFrame(const V3D &observer, const V3D &base, const V3D &axis) {
+  constexpr V3D initialAxis(0., 0., 1.);
+  const V3D direction = Kernel::normalize(axis);
+  V3D local = observer - base;
+  // Quat cannot build the half turn onto -Z, so rotate about X explicitly
+  if ((direction + initialAxis).nullVector(1e-12))
+    return V3D(local.X(), -local.Y(), -local.Z());
+  Quat transform(initialAxis, direction);
+  transform.inverse();
+  transform.rotate(local);
+  return local;
+}
+
+/**
+ * Solid angle of a convex hexahedron given its corners in the order
+ * lbb, lfb, rfb, rbb, lbt, lft, rft, rbt. Faces are split into triangles that
+ * are wound so that they are positive when seen from outside.
+ */
+double hexahedronSolidAngle(const V3D &observer,
+                            const std::array<V3D, 8> &corners) {
+  static constexpr std::array<std::array<int, 4>, 6> faces{{{{0, 1, 2, 3}},
+                                                            {{4, 5, 6, 7}},
+                                                            {{0, 1, 5, 4}},
+                                                            {{1, 2, 6, 5}},
+                                                            {{2, 3, 7, 6}},
+                                                            {{3, 0, 4, 7}}}};
+  V3D centroid;
+  for (const auto &corner : corners)
+    centroid += corner;
+  centroid /= 8.;
+
+  double front(0.0), total(0.0);
+  for (const auto &face : faces) {
+    for (int split = 1; split <= 2; ++split) {
+      const V3D &a = corners[face[0]];
+      const V3D *b = &corners[face[split]];
+      const V3D *c = &corners[face[split + 1]];
+      // wind with the normal pointing inwards
+      if ((*b - a).cross_prod(*c - a).scalar_prod(a - centroid) > 0.0)
+        std::swap(b, c);
+      const double sa =
+          signedTriangleSolidAngle(a - observer, *b - observer, *c - observer);
+      total += sa;
+      if (sa > 0.0)
+        front += sa;
+    }
+  }
+  // The faces of a closed surface add up to -4pi around an internal point
+  if (total < -2.0 * M_PI)
+    return 4.0 * M_PI;
+  return front;
+}
+
+std::array<V3D, 8>
+hexahedronCorners(const ShapeInfo::HexahedronGeometry &hex) {
+  return {hex.leftBackBottom, hex.leftFrontBottom, hex.rightFrontBottom,
+          hex.rightBackBottom, hex.leftBackTop,     hex.leftFrontTop,
+          hex.rightFrontTop,   hex.rightBackTop};
+}
+
+/**
+ * Solid angle of the side of a cylinder seen from a point in its axial frame.
+ * The end caps are excluded so that stacked cylinders (tubes) add up
+ * correctly, matching CSGObject.
+ */
+double cylinderSidesSolidAngle(const V3D &local, const double radius,
+                               const double height) {
+  constexpr int nSlices = Cylinder::g_NSLICES;
+  const auto &circle = unitCircle<nSlices>();
+  double solidAngle(0.0);
+  for (int slice = 0; slice < nSlices; ++slice) {
+    const int next = (slice + 1) % nSlices;
+    const double x0 = radius * circle.cosines[slice];
+    const double y0 = radius * circle.sines[slice];
+    const double x1 = radius * circle.cosines[next];
+    const double y1 = radius * circle.sines[next];
+    // Skip the facets facing away from the observer entirely
+    const double midX = x0 + x1, midY = y0 + y1;
+    if (midX * (local.X() - 0.5 * midX) + midY * (local.Y() - 0.5 * midY) <=
+        0.0)
+      continue;
+    const V3D pt1 = V3D(x0, y0, 0.0) - local;
+    const V3D pt2 = V3D(x0, y0, height) - local;
+    const V3D pt3 = V3D(x1, y1, 0.0) - local;
+    const V3D pt4 = V3D(x1, y1, height) - local;
+    solidAngle += frontTriangleSolidAngle(pt1, pt4, pt3);
+    solidAngle += frontTriangleSolidAngle(pt1, pt2, pt4);
+  }
+  return solidAngle;
+}
+
+/**
+ * Where a point lies with respect to a solid cylindrical shell in its axial
+ * frame: inside the material, on its surface or outside it.
+ */
+enum class Containment { Inside, OnSurface, Outside };
+
+Containment shellContainment(const V3D &local, const double innerRadius,
+                             const double radius, const double height) {
+  const double rho = std::hypot(local.X(), local.Y());
+  const double tol = Kernel::Tolerance;
+  if (rho > radius + tol || rho < innerRadius - tol || local.Z() < -tol ||
+      local.Z() > height + tol)
+    return Containment::Outside;
+  if (rho < radius - tol && (innerRadius <= 0. || rho > innerRadius + tol) &&
+      local.Z() > tol && local.Z() < height - tol)
+    return Containment::Inside;
+  return Containment::OnSurface;
+}
+
+/**
+ * Solid angle of a hollow cylinder. Seen from outside the bore only the outer
+ * wall is visible; seen from inside the bore only the inner wall is.
+ */
+double hollowCylinderSolidAngle(const V3D &observer,
+                                const ShapeInfo::HollowCylinderGeometry &hc) {
+  const V3D local = toAxialFrame(observer, hc.centreOfBottomBase, hc.axis);
+  switch (shellContainment(local, hc.innerRadius, hc.radius, hc.height)) {
+  case Containment::Inside:
+    return 4.0 * M_PI;
+  case Containment::OnSurface:
+    return 2.0 * M_PI;
+  default:
+    break;
+  }
+  const double rho = std::hypot(local.X(), local.Y());
+  if (rho >= hc.innerRadius)
+    return cylinderSidesSolidAngle(local, hc.radius, hc.height);
+  // Inside the bore the inner wall faces the observer, so it is wound the
+  // other way round to the outer wall.
+  constexpr int nSlices = Cylinder::g_NSLICES;
+  const auto &circle = unitCircle<nSlices>();
+  double solidAngle(0.0);
+  for (int slice = 0; slice < nSlices; ++slice) {
+    const int next = (slice + 1) % nSlices;
+    const V3D pt1 = V3D(hc.innerRadius * circle.cosines[slice],
+                        hc.innerRadius * circle.sines[slice], 0.0) -
+                    local;
+    const V3D pt2 = pt1 + V3D(0., 0., hc.height);
+    const V3D pt3 = V3D(hc.innerRadius * circle.cosines[next],
+                        hc.innerRadius * circle.sines[next], 0.0) -
+                    local;
+    const V3D pt4 = pt3 + V3D(0., 0., hc.height);
+    solidAngle += frontTriangleSolidAngle(pt1, pt3, pt4);
+    solidAngle += frontTriangleSolidAngle(pt1, pt4, pt2);
+  }
+  return solidAngle;
+}
+
+template <typename T> void hashCombine(size_t &seed, const T &value) {
+  seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <typename T>
+void hashCombine(size_t &seed, const std::vector<T> &values) {
+  hashCombine(seed, values.size());
+  for (const auto &value : values)
+    hashCombine(seed, value);
+}
+
+/// The geometry of a shape: the ShapeInfo parameters of a primitive, the XML
+/// definition of any other CSGObject or the vertices and triangles of a mesh
+struct ShapeContent {
+  int type{0};
+  std::vector<double> values;
+  std::vector<uint32_t> triangles;
+  std::string xml;
+
+  bool operator==(const ShapeContent &other) const {
+    return type == other.type && values == other.values &&
+           triangles == other.triangles && xml == other.xml;
+  }
+  size_t hash() const {
+    auto seed = static_cast<size_t>(type);
+    hashCombine(seed, values);
+    hashCombine(seed, triangles);
+    hashCombine(seed, xml);
+    return seed;
+  }
+};
+
+/// Gives none for shapes whose geometry cannot be identified
+boost::optional<ShapeContent> shapeContent(const IObject &shape) {
+  ShapeContent content;
+  content.type = static_cast<int>(shape.shape());
+  if (shape.shape() != ShapeInfo::GeometryShape::NOSHAPE) {
+    const auto &info = shape.shapeInfo();
+    for (const auto &point : info.points())
+      for (size_t j = 0; j < 3; ++j)
+        content.values.emplace_back(point[j]);
+    content.values.emplace_back(info.radius());
+    content.values.emplace_back(info.innerRadius());
+    content.values.emplace_back(info.height());
+  } else if (const auto *csg = dynamic_cast<const CSGObject *>(&shape)) {
+    content.xml = csg->getShapeXML();
+    if (content.xml.empty())
+      return boost::none;
+  } else if (const auto *mesh = dynamic_cast<const MeshObject *>(&shape)) {
+    content.values = mesh->getVertices();
+    content.triangles = mesh->getTriangles();
+  } else if (const auto *mesh2D = dynamic_cast<const MeshObject2D *>(&shape)) {
+    content.values = mesh2D->getVertices();
+    content.triangles = mesh2D->getTriangles();
+  } else {
+    return boost::none;
+  }
+  return content;
+}
+
+/**
+ * Everything that determines the detector solid angles: positions,
+ * orientations, scale factors and shapes. Shapes are stored once however many
+ * detectors share them. The hash is only used to reject unequal geometries
+ * quickly, a cached evaluation is reused only if the full content matches.
+ */
+struct DetectorGeometry {
+  static constexpr size_t NO_SHAPE = std::numeric_limits<size_t>::max();
+
+  /// Position, scale factor and rotation of each detector
+  std::vector<double> transforms;
+  /// Index into shapes of the shape of each detector, or NO_SHAPE
+  std::vector<size_t> shapeIndices;
+  std::vector<ShapeContent> shapes;
+  size_t hash{0};
+
+  bool operator==(const DetectorGeometry &other) const {
+    return hash == other.hash && shapeIndices == other.shapeIndices &&
+           transforms == other.transforms && shapes == other.shapes;
+  }
+};
+
+/**
+ * Gives none if any detector shape cannot be identified, in which case the
+ * evaluation must not be cached.
+ */
+boost::optional<DetectorGeometry>
+detectorGeometry(const ComponentInfo &componentInfo,
+                 const size_t numberOfDetectors) {
+  DetectorGeometry geometry;
+  geometry.transforms.reserve(10 * numberOfDetectors);
+  geometry.shapeIndices.reserve(numberOfDetectors);
+  // Detectors share a handful of shapes so look at each of them once
+  std::unordered_map<const IObject *, size_t> shapeIndices;
+  for (size_t i = 0; i < numberOfDetectors; ++i) {
+    const auto position = componentInfo.position(i);
+    const auto rotation = componentInfo.rotation(i);
+    const auto scale = componentInfo.scaleFactor(i);
+    for (size_t j = 0; j < 3; ++j) {
+      geometry.transforms.emplace_back(position[j]);
+      geometry.transforms.emplace_back(scale[j]);
+    }
+    for (int j = 0; j < 4; ++j)
+      geometry.transforms.emplace_back(rotation[j]);
+    if (!componentInfo.hasValidShape(i)) {
+      geometry.shapeIndices.emplace_back(DetectorGeometry::NO_SHAPE);
+      continue;
+    }
+    const auto &shape = componentInfo.shape(i);
+    auto shapeIndex = shapeIndices.find(&shape);
+    if (shapeIndex == shapeIndices.end()) {
+      auto content = shapeContent(shape);
+      if (!content)
+        return boost::none;
+      // Equal shapes held by different objects are stored once
+      const auto equal = std::find(geometry.shapes.cbegin(),
+                                   geometry.shapes.cend(), *content);
+      const auto index =
+          static_cast<size_t>(std::distance(geometry.shapes.cbegin(), equal));
+      if (equal == geometry.shapes.cend())
+        geometry.shapes.emplace_back(std::move(*content));
+      shapeIndex = shapeIndices.emplace(&shape, index).first;
+    }
+    geometry.shapeIndices.emplace_back(shapeIndex->second);
+  }
+  hashCombine(geometry.hash, geometry.transforms);
+  hashCombine(geometry.hash, geometry.shapeIndices);
+  for (const auto &shape : geometry.shapes)
+    hashCombine(geometry.hash, shape.hash());
+  return geometry;
+}
+
+/// Identifies one evaluation of all detector solid angles
+struct CacheKey {
+  std::string instrumentName;
+  V3D observer;
+  DetectorGeometry geometry;
+
+  bool operator==(const CacheKey &other) const {
+    return observer == other.observer && geometry == other.geometry &&
+           instrumentName == other.instrumentName;
+  }
+};
+
+using CacheEntry =
+    std::pair<CacheKey, std::shared_ptr<const std::vector<double>>>;
+
+std::mutex &cacheMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// Most recently used entries first
+std::list<CacheEntry> &cacheEntries() {
+  static std::list<CacheEntry> entries;
+  return entries;
+}
+
+} // namespace
+
+/**
+ * Constructor.
+ * @param componentInfo : The components whose solid angles are required
+ */
+SolidAngleEngine::SolidAngleEngine(const ComponentInfo &componentInfo)
+    : m_componentInfo(componentInfo) {}
+
+/**
+ * Solid angle of a component seen from a point.
+ * @param componentIndex : Index of the component
+ * @param observer : Position of the observer in the instrument frame
+ * @return The solid angle in steradians
+ * @throw NullPointerException if the component has no valid shape
+ */
+double SolidAngleEngine::solidAngle(const size_t componentIndex,
+                                    const Kernel::V3D &observer) const {
+  if (!m_componentInfo.hasValidShape(componentIndex) ||
+      !hasFastPath(m_componentInfo.shape(componentIndex)))
+    return m_componentInfo.solidAngle(componentIndex, observer);
+  // This is the observer position in the shape's coordinate system.
+  auto rotation = m_componentInfo.rotation(componentIndex);
+  rotation.inverse();
+  V3D relativeObserver = observer - m_componentInfo.position(componentIndex);
+  rotation.rotate(relativeObserver);
+  return shapeSolidAngle(m_componentInfo.shape(componentIndex),
+                         relativeObserver,
+                         m_componentInfo.scaleFactor(componentIndex));
+}
+
+/**
+ * Solid angles of all detectors seen from a point, evaluated in parallel.
+ * Detectors without a valid shape are given NaN.
+ * @param observer : Position of the observer in the instrument frame
+ * @return The solid angles indexed by detector index
+ */
+std::vector<double>
+SolidAngleEngine::detectorSolidAngles(const Kernel::V3D &observer) const {
+  prepareShapes();
+  const auto nDetectors = numberOfDetectors();
+  std::vector<double> solidAngles(nDetectors,
+                                  std::numeric_limits<double>::quiet_NaN());
+  const auto size = static_cast<int64_t>(nDetectors);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < size; ++i) {
+    if (m_componentInfo.hasValidShape(static_cast<size_t>(i)))
+      solidAngles[i] = solidAngle(static_cast<size_t>(i), observer);
+  }
+  return solidAngles;
+}
+
+/**
+ * Shapes build their bounding box and triangulation on first use, which is
+ * not thread safe. Build them now for every detector shape so that
+ * solidAngle may then be called for detectors from several threads.
+ */
+void SolidAngleEngine::prepareShapes() const {
+  const auto nDetectors = numberOfDetectors();
+  std::unordered_set<const IObject *> prepared;
+  for (size_t i = 0; i < nDetectors; ++i) {
+    if (!m_componentInfo.hasValidShape(i))
+      continue;
+    const auto &shape = m_componentInfo.shape(i);
+    if (!prepared.insert(&shape).second)
+      continue;
+    shape.getBoundingBox();
+    if (const auto handler = shape.getGeometryHandler())
+      handler->numberOfTriangles();
+  }
+}
+
+/**
+ * @param shape : A shape
+ * @return True if the solid angle of the shape is evaluated here rather than
+ * by the shape itself. These are the primitives CSGObject can only
+ * triangulate.
+ */
+bool SolidAngleEngine::hasFastPath(const IObject &shape) {
+  switch (shape.shape()) {
+  case ShapeInfo::GeometryShape::HEXAHEDRON:
+  case ShapeInfo::GeometryShape::HOLLOWCYLINDER:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Solid angle of a shape seen from a point in the shape's frame.
+ * @param shape : The shape
+ * @param observer : Position of the observer in the shape's frame
+ * @return The solid angle in steradians
+ */
+double SolidAngleEngine::shapeSolidAngle(const IObject &shape,
+                                         const Kernel::V3D &observer) {
+  switch (shape.shape()) {
+  case ShapeInfo::GeometryShape::HEXAHEDRON:
+    return hexahedronSolidAngle(
+        observer, hexahedronCorners(shape.shapeInfo().hexahedronGeometry()));
+  case ShapeInfo::GeometryShape::HOLLOWCYLINDER:
+    return hollowCylinderSolidAngle(
+        observer, shape.shapeInfo().hollowCylinderGeometry());
+  default:
+    return shape.solidAngle(observer);
+  }
+}
+
+/**
+ * Solid angle of a scaled shape seen from a point in the shape's frame. A
+ * hexahedron stays a hexahedron under an arbitrary scaling; other shapes use
+ * IObject::solidAngle.
+ * @param shape : The shape
+ * @param observer : Position of the observer in the shape's frame
+ * @param scaleFactor : Scaling applied to the shape (not the observer)
+ * @return The solid angle in steradians
+ */
+double SolidAngleEngine::shapeSolidAngle(const IObject &shape,
+                                         const Kernel::V3D &observer,
+                                         const Kernel::V3D &scaleFactor) {
+  if ((scaleFactor - V3D(1.0, 1.0, 1.0)).norm() < 1e-12)
+    return shapeSolidAngle(shape, observer);
+  if (shape.shape() != ShapeInfo::GeometryShape::HEXAHEDRON)
+    return shape.solidAngle(observer, scaleFactor);
+  auto corners = hexahedronCorners(shape.shapeInfo().hexahedronGeometry());
+  for (auto &corner : corners)
+    corner *= scaleFactor;
+  return hexahedronSolidAngle(observer, corners);
+}
+
+/**
+ * Solid angles of all detectors seen from a point, reusing an earlier
+ * evaluation for the same instrument, detector geometry and observer.
+ * @param componentInfo : The instrument components
+ * @param observer : Position of the observer in the instrument frame
+ * @return The solid angles indexed by detector index
+ */
+std::shared_ptr<const std::vector<double>>
+SolidAngleEngine::cachedDetectorSolidAngles(const ComponentInfo &componentInfo,
+                                            const Kernel::V3D &observer) {
+  SolidAngleEngine engine(componentInfo);
+  const auto nDetectors = engine.numberOfDetectors();
+  auto geometry = detectorGeometry(componentInfo, nDetectors);
+  if (!geometry)
+    return std::make_shared<const std::vector<double>>(
+        engine.detectorSolidAngles(observer));
+  CacheKey key{componentInfo.name(componentInfo.root()), observer,
+               std::move(*geometry)};
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex());
+    auto &entries = cacheEntries();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->first == key) {
+        entries.splice(entries.begin(), entries, it);
+        return entries.front().second;
+      }
+    }
+  }
+  auto solidAngles = std::make_shared<const std::vector<double>>(
+      engine.detectorSolidAngles(observer));
+  std::lock_guard<std::mutex> lock(cacheMutex());
+  auto &entries = cacheEntries();
+  entries.emplace_front(std::move(key), solidAngles);
+  if (entries.size() > MAX_CACHED_EVALUATIONS)
+    entries.pop_back();
+  return solidAngles;
+}
+
+/// Discard all cached detector solid angles
+void SolidAngleEngine::clearCache() {
+  std::lock_guard<std::mutex> lock(cacheMutex());
+  cacheEntries().clear();
+}
+
+/// @return The number of cached evaluations
+size_t SolidAngleEngine::cacheSize() {
+  std::lock_guard<std::mutex> lock(cacheMutex());
+  return cacheEntries().size();
+}
+
+/// Detectors come first in the component indexing
+size_t SolidAngleEngine::numberOfDetectors() const {
+  size_t nDetectors = 0;
+  while (nDetectors < m_componentInfo.size() &&
+         m_componentInfo.isDetector(nDetectors))
+    ++nDetectors;
+  return nDetectors;
+}
+
+} // namespace Geometry
+} // namespace Mantid
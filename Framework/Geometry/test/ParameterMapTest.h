@@ -516,6 +516,33 @@ public:
     TSM_ASSERT("Cleared parameter map should be empty", pmap.empty())
   }
 
+  void test_revision_changes_when_parameters_change() {
+    ParameterMap pmap;
+    auto revision = pmap.revision();
+    pmap.addDouble(m_testInstrument.get(), "Efixed", 1.8);
+    TS_ASSERT_DIFFERS(pmap.revision(), revision);
+    revision = pmap.revision();
+    pmap.addDouble(m_testInstrument.get(), "Efixed", 2.1);
+    TS_ASSERT_DIFFERS(pmap.revision(), revision);
+    // Re-setting the same value is not a change
+    revision = pmap.revision();
+    pmap.addDouble(m_testInstrument.get(), "Efixed", 2.1);
+    TS_ASSERT_EQUALS(pmap.revision(), revision);
+    pmap.clearParametersByName("NotThere");
+    TS_ASSERT_EQUALS(pmap.revision(), revision);
+
+    ParameterMap copy(pmap);
+    TS_ASSERT_EQUALS(copy.revision(), pmap.revision());
+
+    revision = pmap.revision();
+    pmap.clearParametersByName("Efixed");
+    TS_ASSERT_DIFFERS(pmap.revision(), revision);
+    revision = pmap.revision();
+    pmap.clear();
+    TS_ASSERT_DIFFERS(pmap.revision(), revision);
+    TS_ASSERT_DIFFERS(ParameterMap().revision(), copy.revision());
+  }
+
   void test_lookup_via_type_returns_null_if_fails() {
     // Add a parameter for the first component of the instrument
     IComponent_sptr comp = m_testInstrument->getChild(0);
@@ -0,0 +1,287 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Component.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
+#include "MantidGeometry/Instrument/SolidAngleEngine.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/Quat.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace Mantid::Geometry;
+using namespace Mantid::Kernel;
+
+namespace {
+IObject_sptr createCone(const double angle, const double height) {
+  std::ostringstream xml;
+  xml << "<cone id=\"shape\">"
+      << "<tip-point x=\"0.0\" y=\"0.0\" z=\"0.0\" />"
+      << "<axis x=\"0.0\" y=\"0.0\" z=\"1.0\" />"
+      << "<angle val=\"" << angle << "\" />"
+      << "<height val=\"" << height << "\" />"
+      << "</cone>";
+  return ShapeFactory().createShape(xml.str());
+}
+
+/// An instrument with one detector of each shape, all at the same rotation
+Instrument_sptr createInstrument(const std::vector<IObject_sptr> &shapes,
+                                 const Quat &rotation) {
+  auto instrument = std::make_shared<Instrument>("SolidAngleEngineTest");
+  auto source = new ObjComponent("source");
+  source->setPos(V3D(0., 0., -10.));
+  instrument->add(source);
+  instrument->markAsSource(source);
+  auto sample = new Component("sample");
+  instrument->add(sample);
+  instrument->markAsSamplePos(sample);
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    auto det = new Detector("det" + std::to_string(i),
+                            static_cast<int>(i) + 1, nullptr);
+    det->setShape(shapes[i]);
+    det->setPos(V3D(0.3 * static_cast<double>(i) - 1., 0.5, 2.));
+    det->setRot(rotation);
+    instrument->add(det);
+    instrument->markAsDetector(det);
+  }
+  return instrument;
+}
+} // namespace
+
+class SolidAngleEngineTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SolidAngleEngineTest *createSuite() {
+    return new SolidAngleEngineTest();
+  }
+  static void destroySuite(SolidAngleEngineTest *suite) { delete suite; }
+
+  void tearDown() override { SolidAngleEngine::clearCache(); }
+
+  void test_primitives_match_shape_solid_angle() {
+    using namespace ComponentCreationHelper;
+    const std::vector<IObject_sptr> shapes{
+        createCuboid(0.01, 0.02, 0.005),
+        createSphere(0.02),
+        createCappedCylinder(0.01, 0.05, V3D(0., -0.025, 0.), V3D(0., 1., 0.),
+                             "cyl"),
+        createCappedCylinder(0.01, 0.05, V3D(), V3D(1., 1., 0.5), "tilted"),
+        createHollowCylinder(0.005, 0.01, 0.05, V3D(), V3D(0., 1., 0.),
+                             "hollow")};
+    const Quat rotation(35., V3D(1., 2., 3.));
+    const auto instrument = createInstrument(shapes, rotation);
+    const auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const auto &componentInfo = *wrappers.first;
+    const SolidAngleEngine engine(componentInfo);
+    const V3D samplePos = componentInfo.samplePosition();
+
+    for (size_t i = 0; i < shapes.size(); ++i) {
+      const double expected = componentInfo.solidAngle(i, samplePos);
+      TS_ASSERT_DELTA(engine.solidAngle(i, samplePos), expected,
+                      1e-3 * expected);
+    }
+  }
+
+  void test_only_shapes_csgobject_triangulates_have_fast_path() {
+    using namespace ComponentCreationHelper;
+    TS_ASSERT(!SolidAngleEngine::hasFastPath(*createCuboid(0.01)));
+    TS_ASSERT(!SolidAngleEngine::hasFastPath(*createSphere(0.01)));
+    TS_ASSERT(!SolidAngleEngine::hasFastPath(*createCappedCylinder(
+        0.01, 0.05, V3D(), V3D(0., 1., 0.), "cyl")));
+    TS_ASSERT(SolidAngleEngine::hasFastPath(*createHollowCylinder(
+        0.005, 0.01, 0.05, V3D(), V3D(0., 1., 0.), "hollow")));
+  }
+
+  void test_sphere_is_exact() {
+    const auto sphere = ComponentCreationHelper::createSphere(0.5);
+    const double ratio = 0.5 / 4.;
+    TS_ASSERT_DELTA(SolidAngleEngine::shapeSolidAngle(*sphere, V3D(0, 4., 0)),
+                    2. * M_PI * (1. - std::sqrt(1. - ratio * ratio)), 1e-12);
+  }
+
+  void test_internal_points_see_full_sphere() {
+    using namespace ComponentCreationHelper;
+    const auto cuboid = createCuboid(0.5);
+    const auto cylinder =
+        createCappedCylinder(0.5, 1., V3D(), V3D(0., 0., 1.), "cyl");
+    const auto cone = createCone(45., 1.);
+    TS_ASSERT_DELTA(SolidAngleEngine::shapeSolidAngle(*cuboid, V3D(0.1, 0, 0)),
+                    4. * M_PI, 1e-12);
+    TS_ASSERT_DELTA(
+        SolidAngleEngine::shapeSolidAngle(*cylinder, V3D(0.1, 0, 0.5)),
+        4. * M_PI, 1e-12);
+    TS_ASSERT_DELTA(SolidAngleEngine::shapeSolidAngle(*cone, V3D(0, 0, -0.5)),
+                    4. * M_PI, 1e-12);
+    TS_ASSERT_DELTA(
+        SolidAngleEngine::shapeSolidAngle(*cylinder, V3D(0.5, 0, 0.5)),
+        2. * M_PI, 1e-12);
+  }
+
+  void test_cone_seen_from_base_is_polygon() {
+    // Tip at the origin, base of radius 1 at z = -1
+    const auto cone = createCone(45., 1.);
+    const double distance = 100.;
+    const double polygonArea = 5. * std::sin(2. * M_PI / 10.);
+    const double solidAngle =
+        SolidAngleEngine::shapeSolidAngle(*cone, V3D(0., 0., -distance));
+    TS_ASSERT_DELTA(solidAngle,
+                    polygonArea / ((distance - 1.) * (distance - 1.)),
+                    1e-3 * solidAngle);
+    // From the tip side the same outline is seen further away
+    const double fromTip =
+        SolidAngleEngine::shapeSolidAngle(*cone, V3D(0., 0., distance));
+    TS_ASSERT_DELTA(fromTip, polygonArea / ((distance + 1.) * (distance + 1.)),
+                    1e-3 * fromTip);
+  }
+
+  void test_hollow_cylinder_seen_from_outside_is_its_outer_wall() {
+    using namespace ComponentCreationHelper;
+    const auto hollow = createHollowCylinder(0.05, 0.1, 0.3, V3D(),
+                                             V3D(0., 0., 1.), "hollow");
+    const auto solid =
+        createCappedCylinder(0.1, 0.3, V3D(), V3D(0., 0., 1.), "solid");
+    const V3D observer(2., 0.3, 0.1);
+    const double expected = SolidAngleEngine::shapeSolidAngle(*solid, observer);
+    TS_ASSERT_DELTA(SolidAngleEngine::shapeSolidAngle(*hollow, observer),
+                    expected, 1e-10 * expected);
+    // Within the wall material
+    TS_ASSERT_DELTA(
+        SolidAngleEngine::shapeSolidAngle(*hollow, V3D(0.07, 0., 0.15)),
+        4. * M_PI, 1e-12);
+    // In the bore the inner wall surrounds the observer
+    const double inBore =
+        SolidAngleEngine::shapeSolidAngle(*hollow, V3D(0., 0., 0.15));
+    TS_ASSERT_LESS_THAN(2. * M_PI, inBore);
+    TS_ASSERT_LESS_THAN(inBore, 4. * M_PI);
+  }
+
+  void test_scaled_cuboid_matches_larger_cuboid() {
+    using namespace ComponentCreationHelper;
+    const auto small = createCuboid(0.01, 0.02, 0.03);
+    const auto large = createCuboid(0.02, 0.02, 0.06);
+    const V3D observer(0.1, 0.5, 1.);
+    const double expected =
+        SolidAngleEngine::shapeSolidAngle(*large, observer);
+    TS_ASSERT_DELTA(SolidAngleEngine::shapeSolidAngle(*small, observer,
+                                                      V3D(2., 1., 2.)),
+                    expected, 1e-10 * expected);
+  }
+
+  void test_detectorSolidAngles() {
+    const std::vector<IObject_sptr> shapes(
+        5, ComponentCreationHelper::createCappedCylinder(
+               0.01, 0.05, V3D(), V3D(0., 1., 0.), "cyl"));
+    const auto instrument = createInstrument(shapes, Quat());
+    const auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const auto &componentInfo = *wrappers.first;
+    const SolidAngleEngine engine(componentInfo);
+    const V3D samplePos = componentInfo.samplePosition();
+
+    const auto solidAngles = engine.detectorSolidAngles(samplePos);
+    TS_ASSERT_EQUALS(solidAngles.size(), shapes.size());
+    for (size_t i = 0; i < shapes.size(); ++i)
+      TS_ASSERT_EQUALS(solidAngles[i], engine.solidAngle(i, samplePos));
+  }
+
+  void test_cache_reused_for_same_instrument_and_observer() {
+    const std::vector<IObject_sptr> shapes(
+        3, ComponentCreationHelper::createCuboid(0.01));
+    const auto instrument = createInstrument(shapes, Quat());
+    const auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    auto &componentInfo = *wrappers.first;
+    const V3D samplePos = componentInfo.samplePosition();
+
+    const auto first =
+        SolidAngleEngine::cachedDetectorSolidAngles(componentInfo, samplePos);
+    // A second copy of the same instrument shares the evaluation
+    const auto otherWrappers = InstrumentVisitor::makeWrappers(*instrument);
+    TS_ASSERT_EQUALS(SolidAngleEngine::cachedDetectorSolidAngles(
+                         *otherWrappers.first, samplePos),
+                     first);
+    TS_ASSERT_EQUALS(SolidAngleEngine::cacheSize(), 1);
+
+    const auto otherObserver = SolidAngleEngine::cachedDetectorSolidAngles(
+        componentInfo, V3D(0., 0., 0.1));
+    TS_ASSERT_DIFFERS(otherObserver, first);
+
+    componentInfo.setPosition(1, V3D(0., 1., 1.));
+    const auto moved =
+        SolidAngleEngine::cachedDetectorSolidAngles(componentInfo, samplePos);
+    TS_ASSERT_DIFFERS(moved, first);
+    TS_ASSERT_EQUALS((*moved)[0], (*first)[0]);
+    TS_ASSERT_DIFFERS((*moved)[1], (*first)[1]);
+    TS_ASSERT_EQUALS(SolidAngleEngine::cacheSize(), 3);
+
+    SolidAngleEngine::clearCache();
+    TS_ASSERT_EQUALS(SolidAngleEngine::cacheSize(), 0);
+  }
+
+  void test_cache_is_keyed_on_shape_content() {
+    using namespace ComponentCreationHelper;
+    const auto instrument =
+        createInstrument({createCuboid(0.01), createCuboid(0.01)}, Quat());
+    const auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const V3D samplePos = wrappers.first->samplePosition();
+    const auto first = SolidAngleEngine::cachedDetectorSolidAngles(
+        *wrappers.first, samplePos);
+
+    // Equal shapes held by different objects share the evaluation
+    const auto sameShapes =
+        createInstrument({createCuboid(0.01), createCuboid(0.01)}, Quat());
+    const auto sameWrappers = InstrumentVisitor::makeWrappers(*sameShapes);
+    TS_ASSERT_EQUALS(SolidAngleEngine::cachedDetectorSolidAngles(
+                         *sameWrappers.first, samplePos),
+                     first);
+
+    // A different shape does not
+    const auto otherShapes =
+        createInstrument({createCuboid(0.01), createCuboid(0.02)}, Quat());
+    const auto otherWrappers = InstrumentVisitor::makeWrappers(*otherShapes);
+    const auto other = SolidAngleEngine::cachedDetectorSolidAngles(
+        *otherWrappers.first, samplePos);
+    TS_ASSERT_DIFFERS(other, first);
+    TS_ASSERT_EQUALS((*other)[0], (*first)[0]);
+    TS_ASSERT_LESS_THAN((*first)[1], (*other)[1]);
+  }
+};
+
+class SolidAngleEngineTestPerformance : public CxxTest::TestSuite {
+public:
+  static SolidAngleEngineTestPerformance *createSuite() {
+    return new SolidAngleEngineTestPerformance();
+  }
+  static void destroySuite(SolidAngleEngineTestPerformance *suite) {
+    delete suite;
+  }
+
+  SolidAngleEngineTestPerformance()
+      : m_instrument(
+            ComponentCreationHelper::createTestInstrumentCylindrical(100)),
+        m_wrappers(InstrumentVisitor::makeWrappers(*m_instrument)) {}
+
+  void test_detectorSolidAngles() {
+    const SolidAngleEngine engine(*m_wrappers.first);
+    const auto samplePos = m_wrappers.first->samplePosition();
+    for (size_t i = 0; i < 10; ++i)
+      engine.detectorSolidAngles(samplePos);
+  }
+
+private:
+  Instrument_sptr m_instrument;
+  std::pair<std::unique_ptr<ComponentInfo>, std::unique_ptr<DetectorInfo>>
+      m_wrappers;
+};
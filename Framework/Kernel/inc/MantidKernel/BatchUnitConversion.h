@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/Unit.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** BatchUnitConversion : Converts arrays of values between two initialized
+  units by way of time-of-flight.
+
+  The pair of units is resolved once, on construction, into a kernel that
+  applies both steps inline: the constants are taken from the units'
+  toTOFStep() and fromTOFStep() and the loop over the values makes no virtual
+  calls, so the compiler can vectorise it. The results are identical to
+  calling singleToTOF() followed by singleFromTOF(). Units without a step
+  description fall back to those virtual methods.
+
+  The units must stay alive, and must not be re-initialized, while the
+  conversion is in use.
+*/
+class MANTID_KERNEL_DLL BatchUnitConversion {
+public:
+  BatchUnitConversion(const Unit &fromUnit, const Unit &toUnit);
+
+  /// Convert the values in place
+  void convert(double *values, const size_t count) const;
+  /// Convert the values in place
+  void convert(std::vector<double> &values) const {
+    convert(values.data(), values.size());
+  }
+
+  /// Returns true if the conversion avoids the virtual calls
+  bool isSpecialised() const { return m_kernel != nullptr; }
+
+private:
+  /// A conversion of an array of values
+  using ConversionKernel = void (*)(const UnitConversionStep &,
+                                    const UnitConversionStep &, double *,
+                                    size_t);
+
+  const Unit &m_fromUnit;
+  const Unit &m_toUnit;
+  UnitConversionStep m_toTOF;
+  UnitConversionStep m_fromTOF;
+  /// The specialised kernel, or nullptr for the generic path
+  ConversionKernel m_kernel;
+};
+
+} // namespace Kernel
+} // namespace Mantid
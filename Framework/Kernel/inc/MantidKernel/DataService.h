@@ -240,15 +240,17 @@ public:
     // find if the Tobject already exists
     auto it = datamap.find(name);
     if (it != datamap.end()) {
+      auto oldObject = it->second;
       lock.unlock();
       g_log.debug("Data Object '" + name + "' replaced in data service.\n");
 
       notificationCenter.postNotification(
-          new BeforeReplaceNotification(name, it->second, Tobject));
+          new BeforeReplaceNotification(name, oldObject, Tobject));
 
       lock.lock();
       it->second = Tobject;
       lock.unlock();
+      objectRemoved(oldObject);
 
       notificationCenter.postNotification(
           new AfterReplaceNotification(name, Tobject));
@@ -281,6 +283,7 @@ public:
     // Do NOT use "it" iterator after this point. Other threads may modify the
     // map
     lock.unlock();
+    objectRemoved(data);
     notificationCenter.postNotification(new PreDeleteNotification(name, data));
     data.reset(); // DataService now has no references to the object
     g_log.debug("Data Object '" + name + "' deleted from data service.");
@@ -314,8 +317,9 @@ public:
     auto targetNameIter = datamap.find(newName);
 
     // If we are overriding send a notification for observers
+    std::shared_ptr<T> targetNameObject;
     if (targetNameIter != datamap.end()) {
-      auto targetNameObject = targetNameIter->second;
+      targetNameObject = targetNameIter->second;
       // As we are renaming the existing name turns into the new name
       lock.unlock();
       notificationCenter.postNotification(new BeforeReplaceNotification(
@@ -328,6 +332,8 @@ public:
     if (targetNameIter != datamap.end()) {
       targetNameIter->second = std::move(existingNameObject);
       lock.unlock();
+      if (targetNameObject != targetNameIter->second)
+        objectRemoved(targetNameObject);
       notificationCenter.postNotification(
           new AfterReplaceNotification(newName, targetNameIter->second));
     } else {
@@ -351,9 +357,17 @@ public:
   /// Empty the service
   void clear() {
     {
-      // Make DataService access thread-safe
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
-      datamap.clear();
+      std::vector<std::shared_ptr<T>> objects;
+      {
+        // Make DataService access thread-safe
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        objects.reserve(datamap.size());
+        for (auto &item : datamap)
+          objects.emplace_back(std::move(item.second));
+        datamap.clear();
+      }
+      for (const auto &object : objects)
+        objectRemoved(object);
     }
     notificationCenter.postNotification(new ClearNotification());
     g_log.debug() << typeid(this).name() << " cleared.\n";
@@ -366,18 +380,22 @@ public:
   /** Get a shared pointer to a stored data object
    * @param name :: name of the object */
   std::shared_ptr<T> retrieve(const std::string &name) const {
-    // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
+    std::shared_ptr<T> object;
+    {
+      // Make DataService access thread-safe
+      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
 
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
-      return it->second;
-    } else {
-      throw Kernel::Exception::NotFoundError(
-          "Unable to find Data Object type with name '" + name +
-              "': data service ",
-          name);
+      auto it = datamap.find(name);
+      if (it == datamap.end()) {
+        throw Kernel::Exception::NotFoundError(
+            "Unable to find Data Object type with name '" + name +
+                "': data service ",
+            name);
+      }
+      object = it->second;
     }
+    prepareForAccess(object);
+    return object;
   }
 
   /// Checks all elements within the specified vector exist in the ADS
@@ -514,6 +532,19 @@ protected:
   DataService(const std::string &name) : svcName(name), g_log(svcName) {}
   virtual ~DataService() = default;
 
+  /** Called, without the service locked, on the stored object before it is
+   * handed out by retrieve(). Derived services can override this to record
+   * the access. Listing the objects with getObjects() does not call it. It
+   * may be called concurrently.
+   */
+  virtual void prepareForAccess(const std::shared_ptr<T> & /*object*/) const {}
+
+  /** Called, without the service locked, on every object that is removed,
+   * replaced or cleared from the service, once the service no longer stores
+   * it. It may be called concurrently.
+   */
+  virtual void objectRemoved(const std::shared_ptr<T> & /*object*/) {}
+
 private:
   void checkForEmptyName(const std::string &name) {
     if (name.empty()) {
@@ -0,0 +1,117 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <Poco/File.h>
+#include <Poco/SharedMemory.h>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+ * The MappedBinaryFile template gives random access to a simple binary file,
+ * a sequence of objects of type T, by mapping it into memory read-only.
+ *  - Unlike BinaryFile it has no file position, so any number of threads may
+ *    read any part of the file at the same time without locking.
+ *  - Only the pages that are read are loaded from disk, and a file that is
+ *    already in the page cache is not copied at all.
+ *  - The file size must be a multiple of sizeof(T); an error is thrown
+ *    otherwise.
+ *
+ * NOTE: As for BinaryFile, the objects are read in the native byte order with
+ *       a reinterpret_cast<T>, so T must be a packed plain-data type.
+ */
+template <typename T> class DLLExport MappedBinaryFile {
+public:
+  /// Empty constructor
+  MappedBinaryFile() = default;
+
+  /// Constructor - map a file
+  explicit MappedBinaryFile(const std::string &filename) {
+    this->open(filename);
+  }
+
+  //---------------------------------------------------------------------------
+  /** Map a file into memory
+   * @param filename :: full path to open
+   * @throw runtime_error if the file size is not an even multiple of the type
+   * size
+   * @throw invalid_argument if the file does not exist
+   */
+  void open(const std::string &filename) {
+    this->close();
+    Poco::File file(filename);
+    if (!file.exists()) {
+      throw std::invalid_argument("MappedBinaryFile::open: File " + filename +
+                                  " was not found.");
+    }
+    const auto fileSize = static_cast<size_t>(file.getSize());
+    if (fileSize % sizeof(T) != 0) {
+      std::stringstream msg;
+      msg << "MappedBinaryFile::open: File size is not compatible with data "
+             "size "
+          << fileSize << "%" << sizeof(T) << "=" << fileSize % sizeof(T);
+      throw std::runtime_error(msg.str());
+    }
+    m_numElements = fileSize / sizeof(T);
+    // Empty files cannot be mapped
+    if (m_numElements > 0)
+      m_memory = Poco::SharedMemory(file, Poco::SharedMemory::AM_READ);
+  }
+
+  /// Unmap the file
+  void close() {
+    m_memory = Poco::SharedMemory();
+    m_numElements = 0;
+  }
+
+  /// Returns the # of elements in the file
+  size_t getNumElements() const { return m_numElements; }
+
+  /// Returns the first element in the file, or nullptr if it is empty
+  const T *data() const {
+    return m_numElements > 0 ? reinterpret_cast<const T *>(m_memory.begin())
+                             : nullptr;
+  }
+  const T *begin() const { return data(); }
+  const T *end() const { return data() + m_numElements; }
+
+  //---------------------------------------------------------------------------
+  /** Copy a block of elements out of the file.
+   * @param buffer :: array of at least block_size elements
+   * @param offset :: index of the first element to copy
+   * @param block_size :: how many elements to copy. If there are not enough
+   * elements, fewer are copied.
+   * @return how many elements were copied
+   */
+  size_t loadBlockAt(T *buffer, size_t offset, size_t block_size) const {
+    if (offset >= m_numElements)
+      return 0;
+    const size_t loaded_size = std::min(block_size, m_numElements - offset);
+    std::copy(begin() + offset, begin() + offset + loaded_size, buffer);
+    return loaded_size;
+  }
+
+  /// Copies the entire contents of the file into a std::vector
+  std::vector<T> loadAll() const { return std::vector<T>(begin(), end()); }
+
+private:
+  /// The mapping of the file
+  Poco::SharedMemory m_memory;
+  /// Number of elements of size T in the file
+  size_t m_numElements{0};
+};
+
+} // Namespace Kernel
+} // Namespace Mantid
@@ -0,0 +1,58 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstddef>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+  Fast Fourier transforms of the GSL with their set-up cached.
+
+  The GSL mixed-radix transforms need a wavetable of trigonometric factors
+  for their length, and scratch space of the same length. Wavetables are
+  cached by length and type of transform and shared between all threads,
+  as the transforms only read them. Each thread keeps a pool of scratch
+  space for the lengths it has used. Repeated transforms of the same length,
+  such as those of a fit function evaluated on the same domain many times,
+  then allocate nothing.
+
+  The data layouts are those of the GSL. A real transform of n values
+  leaves the result in the half-complex packing of gsl_fft_real_transform,
+  which is what halfComplexInverse expects. Complex data are n pairs of real
+  and imaginary parts. The inverse transforms include the factor 1/n and
+  halfComplexBackward is the same transform without it.
+
+  The batched overloads transform count arrays stored one after another in
+  data, n values apart for the real and half-complex transforms and 2n for
+  the complex ones, on all threads.
+*/
+class MANTID_KERNEL_DLL FastFourierTransform {
+public:
+  /// The kinds of transform, each needing its own wavetable
+  enum class Type { Real, HalfComplex, Complex };
+
+  static void realForward(double *data, size_t n);
+  static void halfComplexInverse(double *data, size_t n);
+  static void halfComplexBackward(double *data, size_t n);
+  static void complexForward(double *data, size_t n);
+  static void complexInverse(double *data, size_t n);
+
+  static void realForward(double *data, size_t n, size_t count);
+  static void halfComplexInverse(double *data, size_t n, size_t count);
+  static void complexForward(double *data, size_t n, size_t count);
+  static void complexInverse(double *data, size_t n, size_t count);
+
+  static size_t numberOfCachedPlans();
+  static void clearCache();
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,75 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** Tracing : Records a timeline of the work done by the framework and writes
+  it in the Chrome trace event format, which can be opened in
+  chrome://tracing or https://ui.perfetto.dev.
+
+  Tracing is switched on at runtime, either by setting the configuration key
+  tracing.enabled (with tracing.filename giving the output file) or by calling
+  start(). Every algorithm execution is recorded as a span, so child
+  algorithms appear nested inside their parents, and code can add its own
+  spans and counters. Each thread records into its own buffer without taking
+  a lock, and OpenMP and TBB worker threads are labelled as such in the
+  output. When tracing is off every call returns after a single check.
+*/
+namespace Tracing {
+
+/// Begin a new trace, discarding any events recorded so far
+MANTID_KERNEL_DLL void start(const std::string &filename = "");
+/// End the trace and write it to its file. Returns the file name
+MANTID_KERNEL_DLL std::string stop();
+/// Returns true if events are being recorded
+MANTID_KERNEL_DLL bool isEnabled();
+/// Start or stop tracing according to the configuration
+MANTID_KERNEL_DLL void configureFromConfigService();
+
+/// Record the value of a counter, e.g. the number of events processed
+MANTID_KERNEL_DLL void counter(const std::string &name, const double value);
+/// Record the current and peak resident memory of the process
+MANTID_KERNEL_DLL void recordMemoryUsage();
+
+/// The events recorded so far in the Chrome trace JSON format
+MANTID_KERNEL_DLL std::string toJSON();
+/// The number of events recorded so far
+MANTID_KERNEL_DLL size_t numberOfEvents();
+
+/** Span : Records the time between its construction and destruction (or a
+  call to end()) as a single span on the calling thread.
+ */
+class MANTID_KERNEL_DLL Span {
+public:
+  explicit Span(std::string name, const char *category = "function");
+  Span(const Span &) = delete;
+  Span &operator=(const Span &) = delete;
+  ~Span();
+
+  void addArgument(const std::string &name, const double value);
+  void end();
+
+private:
+  bool m_active;
+  std::string m_name;
+  const char *m_category;
+  std::chrono::steady_clock::time_point m_start;
+  std::vector<std::pair<std::string, double>> m_arguments;
+};
+
+} // namespace Tracing
+} // namespace Kernel
+} // namespace Mantid
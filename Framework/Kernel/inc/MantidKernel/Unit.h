@@ -22,6 +22,41 @@
 namespace Mantid {
 namespace Kernel {
 
+/** UnitConversionStep : Describes how an initialized unit converts values to
+    or from time-of-flight, with the constants that initialize() set. A step
+    other than Generic reproduces singleToTOF() or singleFromTOF() exactly, so
+    that arrays of values can be converted without a virtual call per value
+    (see BatchUnitConversion).
+*/
+struct MANTID_KERNEL_DLL UnitConversionStep {
+  /// The form of the conversion, x being the value converted
+  enum class Form {
+    Generic,          ///< Only available through the virtual methods
+    Identity,         ///< x
+    Scale,            ///< x * factor
+    ScaleShift,       ///< x * factor + offset
+    ShiftScale,       ///< (x - offset) * factor
+    Divide,           ///< x / factor
+    Reciprocal,       ///< factor / x, with x = 0 taken as DBL_MIN
+    ReciprocalSqrt,   ///< factor / sqrt(x), with x = 0 taken as DBL_MIN
+    ReciprocalSquare, ///< factor / x^2, with x = 0 taken as DBL_MIN
+    /// factor / sqrt(efixed + sign * x / scaling) + offset, or limit if the
+    /// argument of the square root is not positive
+    EnergyTransferToTOF,
+    /// sign * (factor / (x - offset)^2 - efixed) * scaling, or limit if
+    /// x - offset is not positive
+    EnergyTransferFromTOF
+  };
+
+  Form form = Form::Generic;
+  double factor = 0.;
+  double offset = 0.;
+  double efixed = 0.;
+  double scaling = 1.;
+  double sign = 1.;
+  double limit = 0.;
+};
+
 /** The base units (abstract) class. All concrete units should inherit from
     this class and provide implementations of the caption(), label(),
     toTOF() and fromTOF() methods. They also need to declare (but NOT define)
@@ -173,6 +208,13 @@ public:
    */
   virtual double singleFromTOF(const double tof) const = 0;
 
+  /// The constants of singleToTOF(). Units that override singleToTOF() must
+  /// also override this method
+  virtual UnitConversionStep toTOFStep() const { return {}; }
+  /// The constants of singleFromTOF(). Units that override singleFromTOF()
+  /// must also override this method
+  virtual UnitConversionStep fromTOFStep() const { return {}; }
+
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
@@ -291,6 +333,8 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -308,6 +352,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   void init() override;
   Unit *clone() const override;
 
@@ -335,6 +381,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   void init() override;
   Unit *clone() const override;
 
@@ -382,6 +430,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -432,6 +482,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -454,6 +506,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -477,6 +531,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   void init() override;
   Unit *clone() const override;
 
@@ -562,6 +618,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -581,6 +639,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  UnitConversionStep toTOFStep() const override;
+  UnitConversionStep fromTOFStep() const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -0,0 +1,171 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/BatchUnitConversion.h"
+
+#include <cfloat>
+#include <cmath>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+using Form = UnitConversionStep::Form;
+using KernelFunction = void (*)(const UnitConversionStep &,
+                                const UnitConversionStep &, double *, size_t);
+
+/// Protect against division by zero in the same way as the units do
+inline double nonZero(const double x) { return x == 0.0 ? DBL_MIN : x; }
+
+/// Applies a step of the given form to a single value. Each specialisation
+/// performs the same operations, in the same order, as the unit it describes
+template <Form form> struct Step;
+
+template <> struct Step<Form::Identity> {
+  static double apply(const UnitConversionStep &, const double x) { return x; }
+};
+
+template <> struct Step<Form::Scale> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    return x * s.factor;
+  }
+};
+
+template <> struct Step<Form::ScaleShift> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    return x * s.factor + s.offset;
+  }
+};
+
+template <> struct Step<Form::ShiftScale> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    return (x - s.offset) * s.factor;
+  }
+};
+
+template <> struct Step<Form::Divide> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    return x / s.factor;
+  }
+};
+
+template <> struct Step<Form::Reciprocal> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    return s.factor / nonZero(x);
+  }
+};
+
+template <> struct Step<Form::ReciprocalSqrt> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    return s.factor / std::sqrt(nonZero(x));
+  }
+};
+
+template <> struct Step<Form::ReciprocalSquare> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    const double temp = nonZero(x);
+    return s.factor / (temp * temp);
+  }
+};
+
+template <> struct Step<Form::EnergyTransferToTOF> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    const double energy = s.efixed + s.sign * (x / s.scaling);
+    return energy <= 0.0 ? s.limit : s.factor / std::sqrt(energy) + s.offset;
+  }
+};
+
+template <> struct Step<Form::EnergyTransferFromTOF> {
+  static double apply(const UnitConversionStep &s, const double x) {
+    const double time = x - s.offset;
+    return time <= 0.0 ? s.limit
+                       : s.sign * (s.factor / (time * time) - s.efixed) *
+                             s.scaling;
+  }
+};
+
+/// Converts the values with both steps inlined
+template <Form toTOF, Form fromTOF>
+void convertValues(const UnitConversionStep &toTOFStep,
+                   const UnitConversionStep &fromTOFStep, double *values,
+                   const size_t count) {
+  // Local copies tell the compiler the constants cannot alias the values
+  const UnitConversionStep to(toTOFStep);
+  const UnitConversionStep from(fromTOFStep);
+  for (size_t i = 0; i < count; ++i) {
+    values[i] = Step<fromTOF>::apply(from, Step<toTOF>::apply(to, values[i]));
+  }
+}
+
+/// Select the kernel for the forms that the units use from time-of-flight
+template <Form toTOF> KernelFunction selectKernel(const Form fromTOF) {
+  switch (fromTOF) {
+  case Form::Identity:
+    return &convertValues<toTOF, Form::Identity>;
+  case Form::Scale:
+    return &convertValues<toTOF, Form::Scale>;
+  case Form::ShiftScale:
+    return &convertValues<toTOF, Form::ShiftScale>;
+  case Form::Divide:
+    return &convertValues<toTOF, Form::Divide>;
+  case Form::Reciprocal:
+    return &convertValues<toTOF, Form::Reciprocal>;
+  case Form::ReciprocalSquare:
+    return &convertValues<toTOF, Form::ReciprocalSquare>;
+  case Form::EnergyTransferFromTOF:
+    return &convertValues<toTOF, Form::EnergyTransferFromTOF>;
+  default:
+    return nullptr;
+  }
+}
+
+/// Select the kernel for the forms that the units use to time-of-flight
+KernelFunction selectKernel(const Form toTOF, const Form fromTOF) {
+  switch (toTOF) {
+  case Form::Identity:
+    return selectKernel<Form::Identity>(fromTOF);
+  case Form::Scale:
+    return selectKernel<Form::Scale>(fromTOF);
+  case Form::ScaleShift:
+    return selectKernel<Form::ScaleShift>(fromTOF);
+  case Form::Reciprocal:
+    return selectKernel<Form::Reciprocal>(fromTOF);
+  case Form::ReciprocalSqrt:
+    return selectKernel<Form::ReciprocalSqrt>(fromTOF);
+  case Form::EnergyTransferToTOF:
+    return selectKernel<Form::EnergyTransferToTOF>(fromTOF);
+  default:
+    return nullptr;
+  }
+}
+} // namespace
+
+/**
+ * @param fromUnit :: The unit of the values, initialized for the spectrum
+ * @param toUnit :: The unit to convert to, initialized for the spectrum
+ */
+BatchUnitConversion::BatchUnitConversion(const Unit &fromUnit,
+                                         const Unit &toUnit)
+    : m_fromUnit(fromUnit), m_toUnit(toUnit), m_toTOF(fromUnit.toTOFStep()),
+      m_fromTOF(toUnit.fromTOFStep()),
+      m_kernel(selectKernel(m_toTOF.form, m_fromTOF.form)) {}
+
+/**
+ * @param values :: The values to convert
+ * @param count :: The number of values
+ */
+void BatchUnitConversion::convert(double *values, const size_t count) const {
+  if (m_kernel) {
+    m_kernel(m_toTOF, m_fromTOF, values, count);
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    values[i] = m_toUnit.singleFromTOF(m_fromUnit.singleToTOF(values[i]));
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,318 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/Math/FastFourierTransform.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_real.h>
+
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+using Type = FastFourierTransform::Type;
+using Key = std::pair<size_t, Type>;
+
+/// The largest number of plans or scratch spaces kept in one cache
+constexpr size_t MAX_CACHE_SIZE = 64;
+
+/// The wavetable of a transform of one length and type
+struct Plan {
+  Plan(size_t n, Type type) {
+    switch (type) {
+    case Type::Real:
+      real = gsl_fft_real_wavetable_alloc(n);
+      break;
+    case Type::HalfComplex:
+      halfComplex = gsl_fft_halfcomplex_wavetable_alloc(n);
+      break;
+    case Type::Complex:
+      complex = gsl_fft_complex_wavetable_alloc(n);
+      break;
+    }
+    if (!real && !halfComplex && !complex) {
+      throw std::runtime_error("Failed to create an FFT wavetable of length " +
+                               std::to_string(n));
+    }
+  }
+  ~Plan() {
+    if (real)
+      gsl_fft_real_wavetable_free(real);
+    if (halfComplex)
+      gsl_fft_halfcomplex_wavetable_free(halfComplex);
+    if (complex)
+      gsl_fft_complex_wavetable_free(complex);
+  }
+  Plan(const Plan &) = delete;
+  Plan &operator=(const Plan &) = delete;
+
+  gsl_fft_real_wavetable *real = nullptr;
+  gsl_fft_halfcomplex_wavetable *halfComplex = nullptr;
+  gsl_fft_complex_wavetable *complex = nullptr;
+};
+
+/// The plans shared by all threads
+class PlanCache {
+public:
+  std::shared_ptr<const Plan> get(size_t n, Type type) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_plans.find(Key(n, type));
+    if (it != m_plans.end()) {
+      return it->second;
+    }
+    if (m_plans.size() >= MAX_CACHE_SIZE) {
+      m_plans.clear();
+    }
+    auto plan = std::make_shared<const Plan>(n, type);
+    m_plans.emplace(Key(n, type), plan);
+    return plan;
+  }
+  size_t size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_plans.size();
+  }
+  void clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_plans.clear();
+  }
+
+private:
+  std::mutex m_mutex;
+  std::map<Key, std::shared_ptr<const Plan>> m_plans;
+};
+
+PlanCache &planCache() {
+  static PlanCache cache;
+  return cache;
+}
+
+template <typename T, void (*Free)(T *)> struct Deleter {
+  void operator()(T *p) const { Free(p); }
+};
+using RealWorkspace =
+    std::unique_ptr<gsl_fft_real_workspace,
+                    Deleter<gsl_fft_real_workspace,
+                            gsl_fft_real_workspace_free>>;
+using ComplexWorkspace =
+    std::unique_ptr<gsl_fft_complex_workspace,
+                    Deleter<gsl_fft_complex_workspace,
+                            gsl_fft_complex_workspace_free>>;
+
+/// The plans used by one thread, so that finding them needs no lock, and
+/// its pool of scratch space
+class ThreadCache {
+public:
+  std::shared_ptr<const Plan> plan(size_t n, Type type) {
+    auto it = m_plans.find(Key(n, type));
+    if (it != m_plans.end()) {
+      return it->second;
+    }
+    if (m_plans.size() >= MAX_CACHE_SIZE) {
+      m_plans.clear();
+    }
+    auto plan = planCache().get(n, type);
+    m_plans.emplace(Key(n, type), plan);
+    return plan;
+  }
+  gsl_fft_real_workspace *realWorkspace(size_t n) {
+    return scratch(m_real, n, gsl_fft_real_workspace_alloc);
+  }
+  gsl_fft_complex_workspace *complexWorkspace(size_t n) {
+    return scratch(m_complex, n, gsl_fft_complex_workspace_alloc);
+  }
+
+private:
+  template <typename Pointer, typename Alloc>
+  static typename Pointer::pointer
+  scratch(std::map<size_t, Pointer> &pool, size_t n, Alloc alloc) {
+    auto it = pool.find(n);
+    if (it != pool.end()) {
+      return it->second.get();
+    }
+    if (pool.size() >= MAX_CACHE_SIZE) {
+      pool.clear();
+    }
+    Pointer workspace(alloc(n));
+    if (!workspace) {
+      throw std::runtime_error("Failed to allocate FFT scratch space of "
+                               "length " +
+                               std::to_string(n));
+    }
+    return pool.emplace(n, std::move(workspace)).first->second.get();
+  }
+
+  std::map<Key, std::shared_ptr<const Plan>> m_plans;
+  std::map<size_t, RealWorkspace> m_real;
+  std::map<size_t, ComplexWorkspace> m_complex;
+};
+
+thread_local ThreadCache t_cache;
+
+/// Throw if a GSL transform failed
+void checkStatus(int status, const char *transform) {
+  if (status != GSL_SUCCESS) {
+    throw std::runtime_error(std::string(transform) +
+                             " FFT failed: " + gsl_strerror(status));
+  }
+}
+
+/// Apply a transform to count arrays a fixed distance apart on all threads
+template <typename Transform>
+void transformMany(const Transform &transform, double *data, size_t distance,
+                   size_t count) {
+  const auto nTransforms = static_cast<int>(count);
+  std::vector<std::exception_ptr> errors(count);
+  PARALLEL_FOR_IF(nTransforms > 1)
+  for (int i = 0; i < nTransforms; ++i) {
+    try {
+      transform(data + static_cast<size_t>(i) * distance);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  for (const auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+} // namespace
+
+/**
+ * Forward transform of real data.
+ * @param data :: n real values, replaced by their transform in the
+ *   half-complex packing
+ * @param n :: The length of the transform
+ */
+void FastFourierTransform::realForward(double *data, size_t n) {
+  const auto plan = t_cache.plan(n, Type::Real);
+  checkStatus(gsl_fft_real_transform(data, 1, n, plan->real,
+                                     t_cache.realWorkspace(n)),
+              "Real forward");
+}
+
+/**
+ * Inverse transform of half-complex data to real values.
+ * @param data :: n values in the half-complex packing, replaced by the real
+ *   inverse transform
+ * @param n :: The length of the transform
+ */
+void FastFourierTransform::halfComplexInverse(double *data, size_t n) {
+  const auto plan = t_cache.plan(n, Type::HalfComplex);
+  checkStatus(gsl_fft_halfcomplex_inverse(data, 1, n, plan->halfComplex,
+                                          t_cache.realWorkspace(n)),
+              "Half-complex inverse");
+}
+
+/**
+ * Inverse transform of half-complex data to real values without the
+ * normalising factor 1/n.
+ * @param data :: n values in the half-complex packing, replaced by n times
+ *   the real inverse transform
+ * @param n :: The length of the transform
+ */
+void FastFourierTransform::halfComplexBackward(double *data, size_t n) {
+  const auto plan = t_cache.plan(n, Type::HalfComplex);
+  checkStatus(gsl_fft_halfcomplex_backward(data, 1, n, plan->halfComplex,
+                                           t_cache.realWorkspace(n)),
+              "Half-complex backward");
+}
+
+/**
+ * Forward transform of complex data.
+ * @param data :: n complex values as pairs of real and imaginary parts,
+ *   replaced by their transform
+ * @param n :: The length of the transform
+ */
+void FastFourierTransform::complexForward(double *data, size_t n) {
+  const auto plan = t_cache.plan(n, Type::Complex);
+  checkStatus(gsl_fft_complex_forward(data, 1, n, plan->complex,
+                                      t_cache.complexWorkspace(n)),
+              "Complex forward");
+}
+
+/**
+ * Inverse transform of complex data.
+ * @param data :: n complex values as pairs of real and imaginary parts,
+ *   replaced by their inverse transform
+ * @param n :: The length of the transform
+ */
+void FastFourierTransform::complexInverse(double *data, size_t n) {
+  const auto plan = t_cache.plan(n, Type::Complex);
+  checkStatus(gsl_fft_complex_inverse(data, 1, n, plan->complex,
+                                      t_cache.complexWorkspace(n)),
+              "Complex inverse");
+}
+
+/**
+ * Forward transforms of several arrays of real data.
+ * @param data :: count arrays of n real values one after another
+ * @param n :: The length of each transform
+ * @param count :: The number of transforms
+ */
+void FastFourierTransform::realForward(double *data, size_t n, size_t count) {
+  transformMany([n](double *array) { realForward(array, n); }, data, n,
+                count);
+}
+
+/**
+ * Inverse transforms of several arrays of half-complex data.
+ * @param data :: count arrays of n half-complex values one after another
+ * @param n :: The length of each transform
+ * @param count :: The number of transforms
+ */
+void FastFourierTransform::halfComplexInverse(double *data, size_t n,
+                                              size_t count) {
+  transformMany([n](double *array) { halfComplexInverse(array, n); }, data, n,
+                count);
+}
+
+/**
+ * Forward transforms of several arrays of complex data.
+ * @param data :: count arrays of n complex values one after another
+ * @param n :: The length of each transform
+ * @param count :: The number of transforms
+ */
+void FastFourierTransform::complexForward(double *data, size_t n,
+                                          size_t count) {
+  transformMany([n](double *array) { complexForward(array, n); }, data,
+                2 * n, count);
+}
+
+/**
+ * Inverse transforms of several arrays of complex data.
+ * @param data :: count arrays of n complex values one after another
+ * @param n :: The length of each transform
+ * @param count :: The number of transforms
+ */
+void FastFourierTransform::complexInverse(double *data, size_t n,
+                                          size_t count) {
+  transformMany([n](double *array) { complexInverse(array, n); }, data,
+                2 * n, count);
+}
+
+/// @returns The number of wavetables shared between the threads
+size_t FastFourierTransform::numberOfCachedPlans() {
+  return planCache().size();
+}
+
+/// Release the shared wavetables. Those still used by a thread are released
+/// when it no longer needs them.
+void FastFourierTransform::clearCache() { planCache().clear(); }
+
+} // namespace Kernel
+} // namespace Mantid
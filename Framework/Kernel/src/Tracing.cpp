@@ -0,0 +1,444 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/Tracing.h"
+#include "MantidKernel/ConfigPropertyObserver.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <Poco/Process.h>
+
+#include "tbb/task_arena.h"
+
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace Mantid {
+namespace Kernel {
+namespace Tracing {
+
+namespace {
+/// static logger
+Logger g_log("Tracing");
+
+using Clock = std::chrono::steady_clock;
+
+const std::string ENABLED_KEY = "tracing.enabled";
+const std::string FILENAME_KEY = "tracing.filename";
+const std::string DEFAULT_FILENAME = "mantid_trace.json";
+
+/// One entry of the trace
+struct TraceEvent {
+  std::string name;
+  const char *category = "";
+  /// 'X' for a span, 'C' for a counter
+  char phase = 'X';
+  /// Nanoseconds since the start of the trace
+  int64_t start = 0;
+  int64_t duration = 0;
+  std::vector<std::pair<std::string, double>> arguments;
+};
+
+constexpr size_t EVENTS_PER_CHUNK{1024};
+
+struct EventChunk {
+  std::array<TraceEvent, EVENTS_PER_CHUNK> events;
+  std::atomic<size_t> size{0};
+  std::atomic<EventChunk *> next{nullptr};
+};
+
+/** The events recorded by one thread. Only the owning thread appends, and it
+  publishes each event by a release store of the chunk size, so the trace can
+  be read at any time without locking the writer.
+ */
+class ThreadBuffer {
+public:
+  ThreadBuffer(const int threadId, std::string threadName)
+      : m_threadId(threadId), m_threadName(std::move(threadName)),
+        m_head(new EventChunk), m_tail(m_head) {}
+  ThreadBuffer(const ThreadBuffer &) = delete;
+  ThreadBuffer &operator=(const ThreadBuffer &) = delete;
+  ~ThreadBuffer() {
+    auto *chunk = m_head;
+    while (chunk) {
+      auto *next = chunk->next.load(std::memory_order_relaxed);
+      delete chunk;
+      chunk = next;
+    }
+  }
+
+  void append(TraceEvent &&event) {
+    auto size = m_tail->size.load(std::memory_order_relaxed);
+    if (size == EVENTS_PER_CHUNK) {
+      auto *chunk = new EventChunk;
+      m_tail->next.store(chunk, std::memory_order_release);
+      m_tail = chunk;
+      size = 0;
+    }
+    m_tail->events[size] = std::move(event);
+    m_tail->size.store(size + 1, std::memory_order_release);
+  }
+
+  template <typename Function> void forEach(Function function) const {
+    for (const auto *chunk = m_head; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      const auto size = chunk->size.load(std::memory_order_acquire);
+      for (size_t i = 0; i < size; ++i)
+        function(chunk->events[i]);
+    }
+  }
+
+  int threadId() const { return m_threadId; }
+  const std::string &threadName() const { return m_threadName; }
+
+private:
+  const int m_threadId;
+  const std::string m_threadName;
+  EventChunk *const m_head;
+  EventChunk *m_tail;
+};
+
+/// Everything recorded between a call to start() and stop()
+struct Session {
+  Session(std::string name, const unsigned id)
+      : filename(std::move(name)), generation(id), startTime(Clock::now()) {}
+
+  const std::string filename;
+  const unsigned generation;
+  const Clock::time_point startTime;
+  /// Guards the list of buffers, which only changes when a thread records
+  /// its first event of the session
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+std::atomic<bool> g_enabled{false};
+std::atomic<unsigned> g_generation{0};
+std::mutex g_sessionMutex;
+std::shared_ptr<Session> g_session;
+
+/// The calling thread's buffer and the session it belongs to
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+thread_local std::shared_ptr<Session> t_session;
+
+/// Describe the calling thread for the trace viewer
+std::string describeThread(const int threadId) {
+#ifdef _OPENMP
+  if (omp_in_parallel() && PARALLEL_THREAD_NUMBER > 0)
+    return "OpenMP worker " + std::to_string(PARALLEL_THREAD_NUMBER);
+#endif
+  const int tbbIndex = tbb::this_task_arena::current_thread_index();
+  if (tbbIndex > 0)
+    return "TBB worker " + std::to_string(tbbIndex);
+  return "Thread " + std::to_string(threadId);
+}
+
+/// The calling thread's buffer in the current session, or nullptr if the
+/// trace has just been stopped
+ThreadBuffer *currentBuffer() {
+  if (!t_session ||
+      t_session->generation != g_generation.load(std::memory_order_acquire)) {
+    std::shared_ptr<Session> session;
+    {
+      std::lock_guard<std::mutex> lock(g_sessionMutex);
+      session = g_session;
+    }
+    if (!session) {
+      t_buffer.reset();
+      t_session.reset();
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    const auto threadId = static_cast<int>(session->buffers.size());
+    t_buffer = std::make_shared<ThreadBuffer>(threadId,
+                                              describeThread(threadId));
+    session->buffers.emplace_back(t_buffer);
+    t_session = std::move(session);
+  }
+  return t_buffer.get();
+}
+
+int64_t nanosecondsSince(const Clock::time_point &start,
+                         const Clock::time_point &time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time - start)
+      .count();
+}
+
+void writeEscaped(std::ostream &out, const std::string &text) {
+  out << '"';
+  for (const char c : text) {
+    switch (c) {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+            << static_cast<int>(c) << std::dec << std::setfill(' ');
+      else
+        out << c;
+    }
+  }
+  out << '"';
+}
+
+/// Write the session's events in the Chrome trace event format. Times are in
+/// microseconds.
+void writeJSON(std::ostream &out, Session &session) {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    buffers = session.buffers;
+  }
+  const auto pid = static_cast<long>(Poco::Process::id());
+
+  out << std::setprecision(15) << "{\"traceEvents\":[";
+  bool first = true;
+  const auto separator = [&out, &first]() {
+    if (!first)
+      out << ",\n";
+    first = false;
+  };
+  for (const auto &buffer : buffers) {
+    separator();
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":" << buffer->threadId() << ",\"args\":{\"name\":";
+    writeEscaped(out, buffer->threadName());
+    out << "}}";
+    buffer->forEach([&](const TraceEvent &event) {
+      separator();
+      out << "{\"name\":";
+      writeEscaped(out, event.name);
+      out << ",\"cat\":\"" << event.category << "\",\"ph\":\"" << event.phase
+          << "\",\"ts\":" << static_cast<double>(event.start) * 1e-3;
+      if (event.phase == 'X')
+        out << ",\"dur\":" << static_cast<double>(event.duration) * 1e-3;
+      out << ",\"pid\":" << pid << ",\"tid\":" << buffer->threadId();
+      if (!event.arguments.empty()) {
+        out << ",\"args\":{";
+        for (size_t i = 0; i < event.arguments.size(); ++i) {
+          if (i > 0)
+            out << ',';
+          writeEscaped(out, event.arguments[i].first);
+          out << ':' << event.arguments[i].second;
+        }
+        out << '}';
+      }
+      out << '}';
+    });
+  }
+  out << "],\n\"displayTimeUnit\":\"ms\"}\n";
+}
+
+/// Starts and stops tracing when tracing.enabled changes
+class EnabledObserver : public ConfigPropertyObserver {
+public:
+  EnabledObserver() : ConfigPropertyObserver(ENABLED_KEY) {}
+
+protected:
+  void onPropertyValueChanged(const std::string &newValue,
+                              const std::string &) override {
+    const bool enable = (newValue == "1" || newValue == "true" ||
+                         newValue == "True" || newValue == "On");
+    if (enable && !isEnabled())
+      start(ConfigService::Instance().getString(FILENAME_KEY));
+    else if (!enable && isEnabled())
+      stop();
+  }
+};
+
+/// Writes out a trace that is still running when the process exits
+struct WriteOnExit {
+  ~WriteOnExit() {
+    if (isEnabled())
+      stop();
+  }
+} g_writeOnExit;
+} // namespace
+
+/**
+ * Begin a new trace. Any events recorded since an earlier call are discarded.
+ * @param filename :: The file the trace is written to when it is stopped. If
+ * empty, mantid_trace.json in the current directory is used.
+ */
+void start(const std::string &filename) {
+  std::lock_guard<std::mutex> lock(g_sessionMutex);
+  const auto generation = g_generation.load() + 1;
+  g_session = std::make_shared<Session>(
+      filename.empty() ? DEFAULT_FILENAME : filename, generation);
+  g_generation.store(generation, std::memory_order_release);
+  g_enabled.store(true, std::memory_order_release);
+  g_log.information() << "Tracing started, writing to "
+                      << g_session->filename << " when stopped\n";
+}
+
+/**
+ * End the trace and write it out.
+ * @returns The name of the file written, or an empty string if there was no
+ * trace running
+ */
+std::string stop() {
+  std::shared_ptr<Session> session;
+  {
+    std::lock_guard<std::mutex> lock(g_sessionMutex);
+    g_enabled.store(false, std::memory_order_release);
+    session = std::move(g_session);
+    g_session.reset();
+    g_generation.fetch_add(1, std::memory_order_acq_rel);
+  }
+  if (!session)
+    return "";
+
+  std::ofstream out(session->filename);
+  if (!out) {
+    g_log.error() << "Unable to write the trace to " << session->filename
+                  << '\n';
+    return "";
+  }
+  writeJSON(out, *session);
+  g_log.notice() << "Trace written to " << session->filename << '\n';
+  return session->filename;
+}
+
+bool isEnabled() { return g_enabled.load(std::memory_order_acquire); }
+
+/**
+ * Start tracing if the configuration asks for it and follow any later change
+ * of tracing.enabled.
+ */
+void configureFromConfigService() {
+  static EnabledObserver observer;
+  auto &config = ConfigService::Instance();
+  if (config.getValue<bool>(ENABLED_KEY).get_value_or(false) && !isEnabled())
+    start(config.getString(FILENAME_KEY));
+}
+
+/**
+ * Record the value of a counter at the current time.
+ * @param name :: The name of the counter, e.g. "Events processed"
+ * @param value :: Its current value
+ */
+void counter(const std::string &name, const double value) {
+  if (!isEnabled())
+    return;
+  auto *buffer = currentBuffer();
+  if (!buffer)
+    return;
+  TraceEvent event;
+  event.name = name;
+  event.category = "counter";
+  event.phase = 'C';
+  event.start = nanosecondsSince(t_session->startTime, Clock::now());
+  event.arguments.emplace_back("value", value);
+  buffer->append(std::move(event));
+}
+
+/// Record the current and peak resident set size of the process in MiB
+void recordMemoryUsage() {
+  if (!isEnabled())
+    return;
+  const MemoryStats memory(MEMORY_STATS_IGNORE_SYSTEM);
+  constexpr double bytesToMiB = 1. / (1024. * 1024.);
+  counter("Resident memory (MiB)",
+          static_cast<double>(memory.getCurrentRSS()) * bytesToMiB);
+  counter("Peak resident memory (MiB)",
+          static_cast<double>(memory.getPeakRSS()) * bytesToMiB);
+}
+
+/// The events recorded so far in the current trace
+std::string toJSON() {
+  std::shared_ptr<Session> session;
+  {
+    std::lock_guard<std::mutex> lock(g_sessionMutex);
+    session = g_session;
+  }
+  std::ostringstream out;
+  if (session)
+    writeJSON(out, *session);
+  else
+    out << "{\"traceEvents\":[]}\n";
+  return out.str();
+}
+
+/// The number of events recorded so far in the current trace
+size_t numberOfEvents() {
+  std::shared_ptr<Session> session;
+  {
+    std::lock_guard<std::mutex> lock(g_sessionMutex);
+    session = g_session;
+  }
+  if (!session)
+    return 0;
+  std::lock_guard<std::mutex> lock(session->mutex);
+  size_t count = 0;
+  for (const auto &buffer : session->buffers)
+    buffer->forEach([&count](const TraceEvent &) { ++count; });
+  return count;
+}
+
+/**
+ * Begin a span on the calling thread. Nothing is recorded if tracing is off.
+ * @param name :: The name shown for the span
+ * @param category :: A category used to filter spans in the viewer. It must
+ * outlive the trace, e.g. a string literal.
+ */
+Span::Span(std::string name, const char *category)
+    : m_active(isEnabled()), m_category(category) {
+  if (m_active) {
+    m_name = std::move(name);
+    m_start = Clock::now();
+  }
+}
+
+Span::~Span() { end(); }
+
+/// Attach a value, shown with the span in the viewer
+void Span::addArgument(const std::string &name, const double value) {
+  if (m_active)
+    m_arguments.emplace_back(name, value);
+}
+
+/// Close the span. Later calls do nothing.
+void Span::end() {
+  if (!m_active)
+    return;
+  m_active = false;
+  if (!isEnabled())
+    return;
+  const auto endTime = Clock::now();
+  auto *buffer = currentBuffer();
+  // Spans begun before the current trace started are dropped
+  if (!buffer || m_start < t_session->startTime)
+    return;
+  TraceEvent event;
+  event.name = std::move(m_name);
+  event.category = m_category;
+  event.phase = 'X';
+  event.start = nanosecondsSince(t_session->startTime, m_start);
+  event.duration = nanosecondsSince(m_start, endTime);
+  event.arguments = std::move(m_arguments);
+  buffer->append(std::move(event));
+}
+
+} // namespace Tracing
+} // namespace Kernel
+} // namespace Mantid
@@ -287,6 +287,14 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+UnitConversionStep TOF::toTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::Identity;
+  return step;
+}
+
+UnitConversionStep TOF::fromTOFStep() const { return toTOFStep(); }
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -388,6 +396,30 @@ double Wavelength::singleFromTOF(const double tof) const {
   x *= factorFrom;
   return x;
 }
+
+UnitConversionStep Wavelength::toTOFStep() const {
+  UnitConversionStep step;
+  step.factor = factorTo;
+  if (emode == 1 || emode == 2) {
+    step.form = UnitConversionStep::Form::ScaleShift;
+    step.offset = sfpTo;
+  } else {
+    step.form = UnitConversionStep::Form::Scale;
+  }
+  return step;
+}
+
+UnitConversionStep Wavelength::fromTOFStep() const {
+  UnitConversionStep step;
+  step.factor = factorFrom;
+  if (do_sfpFrom) {
+    step.form = UnitConversionStep::Form::ShiftScale;
+    step.offset = sfpFrom;
+  } else {
+    step.form = UnitConversionStep::Form::Scale;
+  }
+  return step;
+}
 ///@return  Minimal time of flight, which can be reversively converted into
 /// wavelength
 double Wavelength::conversionTOFMin() const {
@@ -464,6 +496,20 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+UnitConversionStep Energy::toTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::ReciprocalSqrt;
+  step.factor = factorTo;
+  return step;
+}
+
+UnitConversionStep Energy::fromTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::ReciprocalSquare;
+  step.factor = factorFrom;
+  return step;
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -570,6 +616,21 @@ double dSpacing::singleToTOF(const double x) const { return x * factorTo; }
 double dSpacing::singleFromTOF(const double tof) const {
   return tof / factorFrom;
 }
+
+UnitConversionStep dSpacing::toTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::Scale;
+  step.factor = factorTo;
+  return step;
+}
+
+UnitConversionStep dSpacing::fromTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::Divide;
+  step.factor = factorFrom;
+  return step;
+}
+
 double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
@@ -681,6 +742,20 @@ double MomentumTransfer::singleFromTOF(const double tof) const {
   return factorFrom / temp;
 }
 
+UnitConversionStep MomentumTransfer::toTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::Reciprocal;
+  step.factor = factorTo;
+  return step;
+}
+
+UnitConversionStep MomentumTransfer::fromTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::Reciprocal;
+  step.factor = factorFrom;
+  return step;
+}
+
 double MomentumTransfer::conversionTOFMin() const {
   return factorFrom / DBL_MAX;
 }
@@ -734,6 +809,20 @@ double QSquared::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+UnitConversionStep QSquared::toTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::ReciprocalSqrt;
+  step.factor = factorTo;
+  return step;
+}
+
+UnitConversionStep QSquared::fromTOFStep() const {
+  UnitConversionStep step;
+  step.form = UnitConversionStep::Form::ReciprocalSquare;
+  step.factor = factorFrom;
+  return step;
+}
+
 double QSquared::conversionTOFMin() const {
   if (factorTo > 0)
     return factorTo / sqrt(DBL_MAX);
@@ -854,6 +943,35 @@ double DeltaE::singleFromTOF(const double tof) const {
     return DBL_MAX;
 }
 
+UnitConversionStep DeltaE::toTOFStep() const {
+  UnitConversionStep step;
+  if (emode != 1 && emode != 2)
+    return step;
+  step.form = UnitConversionStep::Form::EnergyTransferToTOF;
+  step.factor = factorTo;
+  step.offset = t_other;
+  step.efixed = efixed;
+  step.scaling = unitScaling;
+  // The direct geometry final energy is efixed - x
+  step.sign = emode == 1 ? -1. : 1.;
+  step.limit = DeltaE::conversionTOFMax();
+  return step;
+}
+
+UnitConversionStep DeltaE::fromTOFStep() const {
+  UnitConversionStep step;
+  if (emode != 1 && emode != 2)
+    return step;
+  step.form = UnitConversionStep::Form::EnergyTransferFromTOF;
+  step.factor = factorFrom;
+  step.offset = t_otherFrom;
+  step.efixed = efixed;
+  step.scaling = unitScaling;
+  step.sign = emode == 1 ? -1. : 1.;
+  step.limit = emode == 1 ? -DBL_MAX : DBL_MAX;
+  return step;
+}
+
 double DeltaE::conversionTOFMin() const {
   double time(
       DBL_MAX); // impossible for elastic, this units do not work for elastic
@@ -1101,6 +1219,12 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// Not one of the Wavelength forms so only available as a virtual call
+UnitConversionStep SpinEchoLength::toTOFStep() const { return {}; }
+
+/// Not one of the Wavelength forms so only available as a virtual call
+UnitConversionStep SpinEchoLength::fromTOFStep() const { return {}; }
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1146,6 +1270,12 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// Not one of the Wavelength forms so only available as a virtual call
+UnitConversionStep SpinEchoTime::toTOFStep() const { return {}; }
+
+/// Not one of the Wavelength forms so only available as a virtual call
+UnitConversionStep SpinEchoTime::fromTOFStep() const { return {}; }
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
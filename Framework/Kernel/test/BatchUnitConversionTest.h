@@ -0,0 +1,145 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/BatchUnitConversion.h"
+#include "MantidKernel/UnitFactory.h"
+
+#include <cmath>
+
+using namespace Mantid::Kernel;
+
+class BatchUnitConversionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BatchUnitConversionTest *createSuite() {
+    return new BatchUnitConversionTest();
+  }
+  static void destroySuite(BatchUnitConversionTest *suite) { delete suite; }
+
+  void test_common_units_are_specialised() {
+    const std::vector<std::string> units{
+        "TOF",      "Wavelength",       "Energy",
+        "dSpacing", "MomentumTransfer", "QSquared"};
+    for (const auto &from : units) {
+      for (const auto &to : units) {
+        auto fromUnit = createUnit(from, 0);
+        auto toUnit = createUnit(to, 0);
+        TSM_ASSERT(from + " to " + to,
+                   BatchUnitConversion(*fromUnit, *toUnit).isSpecialised());
+      }
+    }
+  }
+
+  void test_energy_transfer_is_specialised() {
+    for (const int emode : {1, 2}) {
+      auto fromUnit = createUnit("TOF", emode);
+      auto toUnit = createUnit("DeltaE", emode);
+      TS_ASSERT(BatchUnitConversion(*fromUnit, *toUnit).isSpecialised());
+      TS_ASSERT(BatchUnitConversion(*toUnit, *fromUnit).isSpecialised());
+    }
+  }
+
+  void test_other_units_use_the_virtual_methods() {
+    auto fromUnit = createUnit("TOF", 0);
+    for (const std::string to :
+         {"Momentum", "SpinEchoLength", "dSpacingPerpendicular"}) {
+      auto toUnit = createUnit(to, 0);
+      TSM_ASSERT(to,
+                 !BatchUnitConversion(*fromUnit, *toUnit).isSpecialised());
+    }
+  }
+
+  void test_results_match_the_virtual_methods() {
+    const std::vector<std::string> units{"TOF",
+                                         "Wavelength",
+                                         "Energy",
+                                         "dSpacing",
+                                         "MomentumTransfer",
+                                         "QSquared",
+                                         "DeltaE",
+                                         "DeltaE_inWavenumber",
+                                         "Momentum",
+                                         "SpinEchoLength"};
+    // Include zero, negative and out of range values
+    const std::vector<double> values{0., -1., 1e-3, 0.5, 3.7, 12.2, 55., 1e3,
+                                     2e4, 1e6};
+    for (const int emode : {0, 1, 2}) {
+      for (const auto &from : units) {
+        for (const auto &to : units) {
+          // Energy transfer needs an inelastic mode
+          if (emode == 0 && (from.find("DeltaE") != std::string::npos ||
+                             to.find("DeltaE") != std::string::npos))
+            continue;
+          auto fromUnit = createUnit(from, emode);
+          auto toUnit = createUnit(to, emode);
+          auto converted = values;
+          BatchUnitConversion(*fromUnit, *toUnit).convert(converted);
+          for (size_t i = 0; i < values.size(); ++i) {
+            const double expected =
+                toUnit->singleFromTOF(fromUnit->singleToTOF(values[i]));
+            if (std::isnan(expected)) {
+              TS_ASSERT(std::isnan(converted[i]));
+            } else {
+              TSM_ASSERT_EQUALS(from + " to " + to, converted[i], expected);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void test_empty_array() {
+    auto fromUnit = createUnit("TOF", 0);
+    auto toUnit = createUnit("dSpacing", 0);
+    std::vector<double> values;
+    TS_ASSERT_THROWS_NOTHING(
+        BatchUnitConversion(*fromUnit, *toUnit).convert(values));
+  }
+
+private:
+  static Unit_sptr createUnit(const std::string &name, const int emode) {
+    auto unit = UnitFactory::Instance().create(name);
+    unit->initialize(10., 2.5, 0.7, emode, 12.3, 0.);
+    return unit;
+  }
+};
+
+class BatchUnitConversionTestPerformance : public CxxTest::TestSuite {
+public:
+  static BatchUnitConversionTestPerformance *createSuite() {
+    return new BatchUnitConversionTestPerformance();
+  }
+  static void destroySuite(BatchUnitConversionTestPerformance *suite) {
+    delete suite;
+  }
+
+  BatchUnitConversionTestPerformance()
+      : m_values(10000000, 1234.5),
+        m_tof(UnitFactory::Instance().create("TOF")),
+        m_dSpacing(UnitFactory::Instance().create("dSpacing")) {
+    m_tof->initialize(10., 2.5, 0.7, 0, 0., 0.);
+    m_dSpacing->initialize(10., 2.5, 0.7, 0, 0., 0.);
+  }
+
+  void test_virtual_calls() {
+    for (auto &value : m_values)
+      value = m_dSpacing->singleFromTOF(m_tof->singleToTOF(value));
+  }
+
+  void test_batch_conversion() {
+    BatchUnitConversion(*m_tof, *m_dSpacing).convert(m_values);
+  }
+
+private:
+  std::vector<double> m_values;
+  Unit_sptr m_tof;
+  Unit_sptr m_dSpacing;
+};
@@ -12,6 +12,7 @@
 #include <cxxtest/TestSuite.h>
 #include <memory>
 
+#include <atomic>
 #include <mutex>
 #include <sstream>
 
@@ -24,6 +25,22 @@ public:
   FakeDataService() : DataService<int>("FakeDataService") {}
 };
 
+/// A data service counting the objects it hands out and removes
+class AccessCountingDataService : public DataService<int> {
+public:
+  AccessCountingDataService() : DataService<int>("AccessCountingDataService") {}
+  mutable std::atomic<int> accesses{0};
+  std::vector<int> removed;
+
+protected:
+  void prepareForAccess(const std::shared_ptr<int> &) const override {
+    ++accesses;
+  }
+  void objectRemoved(const std::shared_ptr<int> &object) override {
+    removed.emplace_back(*object);
+  }
+};
+
 class DataServiceTest : public CxxTest::TestSuite {
 private:
   // A data service storing an int
@@ -525,4 +542,40 @@ public:
                                         "^~");
     TS_ASSERT(!FakeDataService::showingHiddenObjects());
   }
+
+  void test_objects_are_prepared_before_they_are_handed_out() {
+    AccessCountingDataService service;
+    service.add("one", std::make_shared<int>(1));
+    TS_ASSERT_EQUALS(service.accesses.load(), 0)
+    service.retrieve("one");
+    TS_ASSERT_EQUALS(service.accesses.load(), 1)
+    service.retrieve("one");
+    TS_ASSERT_EQUALS(service.accesses.load(), 2)
+    // Listing the objects is not an access
+    service.getObjects();
+    TS_ASSERT_EQUALS(service.accesses.load(), 2)
+    // Objects that are replaced or removed are not prepared
+    service.addOrReplace("one", std::make_shared<int>(2));
+    service.remove("one");
+    TS_ASSERT_EQUALS(service.accesses.load(), 2)
+  }
+
+  void test_objectRemoved_is_called_for_every_object_no_longer_stored() {
+    AccessCountingDataService service;
+    service.add("one", std::make_shared<int>(1));
+    service.addOrReplace("one", std::make_shared<int>(2));
+    TS_ASSERT_EQUALS(service.removed, std::vector<int>({1}))
+    service.add("three", std::make_shared<int>(3));
+    service.rename("three", "one");
+    TS_ASSERT_EQUALS(service.removed, std::vector<int>({1, 2}))
+    service.remove("one");
+    TS_ASSERT_EQUALS(service.removed, std::vector<int>({1, 2, 3}))
+    service.add("four", std::make_shared<int>(4));
+    service.clear();
+    TS_ASSERT_EQUALS(service.removed, std::vector<int>({1, 2, 3, 4}))
+    // Renaming to a new name removes nothing
+    service.add("five", std::make_shared<int>(5));
+    service.rename("five", "six");
+    TS_ASSERT_EQUALS(service.removed.size(), 4)
+  }
 };
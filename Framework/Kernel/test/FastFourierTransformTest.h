@@ -0,0 +1,150 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/Math/FastFourierTransform.h"
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using Mantid::Kernel::FastFourierTransform;
+
+class FastFourierTransformTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FastFourierTransformTest *createSuite() {
+    return new FastFourierTransformTest();
+  }
+  static void destroySuite(FastFourierTransformTest *suite) { delete suite; }
+
+  void test_real_forward_matches_discrete_transform() {
+    // An odd length to check the half-complex packing of the last value
+    const size_t n = 15;
+    auto data = makeData(n, 0);
+    const auto original = data;
+    FastFourierTransform::realForward(data.data(), n);
+
+    TS_ASSERT_DELTA(data[0], dft(original, 0).first, 1e-12);
+    for (size_t k = 1; k <= n / 2; ++k) {
+      const auto expected = dft(original, k);
+      TS_ASSERT_DELTA(data[2 * k - 1], expected.first, 1e-12);
+      TS_ASSERT_DELTA(data[2 * k], expected.second, 1e-12);
+    }
+  }
+
+  void test_half_complex_inverse_undoes_real_forward() {
+    for (size_t n : {16, 21}) {
+      auto data = makeData(n, 1);
+      const auto original = data;
+      FastFourierTransform::realForward(data.data(), n);
+      FastFourierTransform::halfComplexInverse(data.data(), n);
+      for (size_t i = 0; i < n; ++i) {
+        TS_ASSERT_DELTA(data[i], original[i], 1e-12);
+      }
+    }
+  }
+
+  void test_half_complex_backward_is_not_normalised() {
+    const size_t n = 20;
+    auto data = makeData(n, 4);
+    const auto original = data;
+    FastFourierTransform::realForward(data.data(), n);
+    FastFourierTransform::halfComplexBackward(data.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      TS_ASSERT_DELTA(data[i], 20.0 * original[i], 1e-11);
+    }
+  }
+
+  void test_complex_inverse_undoes_complex_forward() {
+    const size_t n = 12;
+    auto data = makeData(2 * n, 2);
+    const auto original = data;
+    FastFourierTransform::complexForward(data.data(), n);
+    // the zero frequency is the sum of the values
+    double sumRe = 0.0, sumIm = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      sumRe += original[2 * i];
+      sumIm += original[2 * i + 1];
+    }
+    TS_ASSERT_DELTA(data[0], sumRe, 1e-12);
+    TS_ASSERT_DELTA(data[1], sumIm, 1e-12);
+    FastFourierTransform::complexInverse(data.data(), n);
+    for (size_t i = 0; i < 2 * n; ++i) {
+      TS_ASSERT_DELTA(data[i], original[i], 1e-12);
+    }
+  }
+
+  void test_batched_transforms_match_single_ones() {
+    const size_t n = 30, count = 7;
+    std::vector<double> batch;
+    std::vector<std::vector<double>> single;
+    for (size_t i = 0; i < count; ++i) {
+      single.emplace_back(makeData(2 * n, i));
+      batch.insert(batch.end(), single.back().begin(), single.back().end());
+    }
+
+    FastFourierTransform::complexForward(batch.data(), n, count);
+    for (size_t i = 0; i < count; ++i) {
+      FastFourierTransform::complexForward(single[i].data(), n);
+      for (size_t j = 0; j < 2 * n; ++j) {
+        TS_ASSERT_EQUALS(batch[2 * n * i + j], single[i][j]);
+      }
+    }
+
+    // Pairs of real arrays of length n fill the same storage
+    FastFourierTransform::realForward(batch.data(), n, 2 * count);
+    FastFourierTransform::halfComplexInverse(batch.data(), n, 2 * count);
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t j = 0; j < 2 * n; ++j) {
+        TS_ASSERT_DELTA(batch[2 * n * i + j], single[i][j], 1e-10);
+      }
+    }
+  }
+
+  void test_plans_are_cached() {
+    FastFourierTransform::clearCache();
+    TS_ASSERT_EQUALS(FastFourierTransform::numberOfCachedPlans(), 0);
+    // lengths not used by the other tests so the thread's own plans are new
+    auto data = makeData(2 * 37, 3);
+    FastFourierTransform::complexForward(data.data(), 37);
+    FastFourierTransform::complexInverse(data.data(), 37);
+    TS_ASSERT_EQUALS(FastFourierTransform::numberOfCachedPlans(), 1);
+    FastFourierTransform::realForward(data.data(), 38);
+    FastFourierTransform::halfComplexInverse(data.data(), 38);
+    TS_ASSERT_EQUALS(FastFourierTransform::numberOfCachedPlans(), 3);
+    FastFourierTransform::clearCache();
+    TS_ASSERT_EQUALS(FastFourierTransform::numberOfCachedPlans(), 0);
+  }
+
+private:
+  static std::vector<double> makeData(size_t n, size_t seed) {
+    std::vector<double> data(n);
+    for (size_t i = 0; i < n; ++i) {
+      const auto x = static_cast<double>(i + seed);
+      data[i] = std::sin(0.7 * x) + 0.1 * x - std::cos(2.3 * x * x);
+    }
+    return data;
+  }
+
+  /// The k-th term of the discrete Fourier transform of real data
+  static std::pair<double, double> dft(const std::vector<double> &data,
+                                       size_t k) {
+    const auto n = static_cast<double>(data.size());
+    double re = 0.0, im = 0.0;
+    for (size_t j = 0; j < data.size(); ++j) {
+      const double phase =
+          -2.0 * M_PI * static_cast<double>(k * j) / n;
+      re += data[j] * std::cos(phase);
+      im += data[j] * std::sin(phase);
+    }
+    return {re, im};
+  }
+};
@@ -0,0 +1,101 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/MappedBinaryFile.h"
+#include <cxxtest/TestSuite.h>
+
+#include <Poco/File.h>
+#include <cstdint>
+#include <fstream>
+
+using Mantid::Kernel::MappedBinaryFile;
+
+namespace {
+struct Event {
+  uint32_t tof;
+  uint32_t pid;
+};
+
+/// Write the events (i, i + 1) for i = 0, 2, ..., 2 * (num_events - 1)
+void makeEventFile(const std::string &filename, size_t num_events) {
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+  for (uint32_t i = 0; i < num_events; ++i) {
+    const Event event{2 * i, 2 * i + 1};
+    file.write(reinterpret_cast<const char *>(&event), sizeof(event));
+  }
+}
+} // namespace
+
+class MappedBinaryFileTest : public CxxTest::TestSuite {
+public:
+  static MappedBinaryFileTest *createSuite() {
+    return new MappedBinaryFileTest();
+  }
+  static void destroySuite(MappedBinaryFileTest *suite) { delete suite; }
+
+  void tearDown() override {
+    if (Poco::File(m_filename).exists())
+      Poco::File(m_filename).remove();
+  }
+
+  void test_file_not_found() {
+    MappedBinaryFile<Event> file;
+    TS_ASSERT_THROWS(file.open("nonexistentfile.dat"),
+                     const std::invalid_argument &);
+  }
+
+  void test_file_wrong_size() {
+    std::ofstream(m_filename.c_str(), std::ios::binary) << "abc";
+    MappedBinaryFile<Event> file;
+    TS_ASSERT_THROWS(file.open(m_filename), const std::runtime_error &);
+  }
+
+  void test_empty_file() {
+    makeEventFile(m_filename, 0);
+    MappedBinaryFile<Event> file(m_filename);
+    TS_ASSERT_EQUALS(file.getNumElements(), 0u);
+    TS_ASSERT_EQUALS(file.begin(), file.end());
+    TS_ASSERT(file.loadAll().empty());
+  }
+
+  void test_random_access() {
+    makeEventFile(m_filename, 100);
+    MappedBinaryFile<Event> file(m_filename);
+    TS_ASSERT_EQUALS(file.getNumElements(), 100u);
+    TS_ASSERT_EQUALS(file.end() - file.begin(), 100);
+    TS_ASSERT_EQUALS(file.data()[0].tof, 0);
+    TS_ASSERT_EQUALS(file.data()[0].pid, 1);
+    TS_ASSERT_EQUALS(file.data()[99].tof, 198);
+    TS_ASSERT_EQUALS(file.data()[99].pid, 199);
+    TS_ASSERT_EQUALS(file.loadAll().size(), 100u);
+  }
+
+  void test_loadBlockAt() {
+    makeEventFile(m_filename, 100);
+    const MappedBinaryFile<Event> file(m_filename);
+    std::vector<Event> buffer(30);
+    TS_ASSERT_EQUALS(file.loadBlockAt(buffer.data(), 10, 30), 30u);
+    TS_ASSERT_EQUALS(buffer.front().tof, 20);
+    TS_ASSERT_EQUALS(buffer.back().tof, 78);
+    // Only the remaining elements are copied at the end of the file
+    TS_ASSERT_EQUALS(file.loadBlockAt(buffer.data(), 90, 30), 10u);
+    TS_ASSERT_EQUALS(buffer.front().tof, 180);
+    TS_ASSERT_EQUALS(file.loadBlockAt(buffer.data(), 100, 30), 0u);
+  }
+
+  void test_close() {
+    makeEventFile(m_filename, 10);
+    MappedBinaryFile<Event> file(m_filename);
+    file.close();
+    TS_ASSERT_EQUALS(file.getNumElements(), 0u);
+    TS_ASSERT(!file.data());
+  }
+
+private:
+  const std::string m_filename{"MappedBinaryFileTest.bin"};
+};
@@ -0,0 +1,157 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Tracing.h"
+
+#include <Poco/TemporaryFile.h>
+
+#include <fstream>
+#include <sstream>
+
+using namespace Mantid::Kernel;
+
+class TracingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TracingTest *createSuite() { return new TracingTest(); }
+  static void destroySuite(TracingTest *suite) { delete suite; }
+
+  void tearDown() override {
+    if (Tracing::isEnabled())
+      Tracing::stop();
+  }
+
+  void test_nothing_is_recorded_when_disabled() {
+    TS_ASSERT(!Tracing::isEnabled());
+    {
+      Tracing::Span span("disabled");
+      Tracing::counter("disabled counter", 1.);
+    }
+    TS_ASSERT_EQUALS(Tracing::numberOfEvents(), 0);
+    TS_ASSERT_EQUALS(Tracing::stop(), "");
+  }
+
+  void test_spans_and_counters_are_recorded() {
+    Tracing::start(m_file.path());
+    TS_ASSERT(Tracing::isEnabled());
+    {
+      Tracing::Span outer("outer", "test");
+      outer.addArgument("items", 3.);
+      { Tracing::Span inner("inner"); }
+      Tracing::counter("Events processed", 42.);
+    }
+    TS_ASSERT_EQUALS(Tracing::numberOfEvents(), 3);
+
+    const auto json = Tracing::toJSON();
+    TS_ASSERT(json.find("\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"X\"") !=
+              std::string::npos);
+    TS_ASSERT(json.find("\"args\":{\"items\":3}") != std::string::npos);
+    TS_ASSERT(json.find("\"name\":\"inner\"") != std::string::npos);
+    TS_ASSERT(json.find("\"ph\":\"C\"") != std::string::npos);
+    TS_ASSERT(json.find("\"args\":{\"value\":42}") != std::string::npos);
+    TS_ASSERT(json.find("thread_name") != std::string::npos);
+  }
+
+  void test_span_can_be_ended_early() {
+    Tracing::start(m_file.path());
+    Tracing::Span span("ended");
+    span.end();
+    span.end();
+    TS_ASSERT_EQUALS(Tracing::numberOfEvents(), 1);
+  }
+
+  void test_start_discards_previous_events() {
+    Tracing::start(m_file.path());
+    { Tracing::Span span("first"); }
+    Tracing::start(m_file.path());
+    TS_ASSERT_EQUALS(Tracing::numberOfEvents(), 0);
+    { Tracing::Span span("second"); }
+    TS_ASSERT_EQUALS(Tracing::numberOfEvents(), 1);
+  }
+
+  void test_spans_begun_before_start_are_dropped() {
+    Tracing::start(m_file.path());
+    Tracing::Span early("early");
+    Tracing::start(m_file.path());
+    early.end();
+    TS_ASSERT_EQUALS(Tracing::numberOfEvents(), 0);
+  }
+
+  void test_threads_record_into_their_own_buffers() {
+    Tracing::start(m_file.path());
+    constexpr int numSpans{1000};
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < numSpans; ++i) {
+      Tracing::Span span("work");
+      span.addArgument("index", static_cast<double>(i));
+    }
+    TS_ASSERT_EQUALS(Tracing::numberOfEvents(), numSpans);
+  }
+
+  void test_stop_writes_the_trace() {
+    Poco::TemporaryFile file;
+    Tracing::start(file.path());
+    Tracing::recordMemoryUsage();
+    TS_ASSERT_EQUALS(Tracing::stop(), file.path());
+    TS_ASSERT(!Tracing::isEnabled());
+
+    std::ifstream in(file.path());
+    std::stringstream contents;
+    contents << in.rdbuf();
+    TS_ASSERT_EQUALS(contents.str().find("{\"traceEvents\":["), 0);
+    TS_ASSERT(contents.str().find("Peak resident memory (MiB)") !=
+              std::string::npos);
+  }
+
+  void test_config_service_switches_tracing() {
+    Poco::TemporaryFile file;
+    auto &config = ConfigService::Instance();
+    config.setString("tracing.filename", file.path());
+    Tracing::configureFromConfigService();
+    config.setString("tracing.enabled", "1");
+    TS_ASSERT(Tracing::isEnabled());
+    config.setString("tracing.enabled", "0");
+    TS_ASSERT(!Tracing::isEnabled());
+    std::ifstream in(file.path());
+    TS_ASSERT(in.good());
+    config.setString("tracing.filename", "");
+  }
+
+private:
+  /// Where the traces begun by the tests are written
+  Poco::TemporaryFile m_file;
+};
+
+class TracingTestPerformance : public CxxTest::TestSuite {
+public:
+  static TracingTestPerformance *createSuite() {
+    return new TracingTestPerformance();
+  }
+  static void destroySuite(TracingTestPerformance *suite) { delete suite; }
+
+  void test_disabled_spans() {
+    for (int i = 0; i < 10000000; ++i) {
+      Tracing::Span span("disabled");
+    }
+  }
+
+  void test_enabled_spans_in_parallel() {
+    Poco::TemporaryFile file;
+    Tracing::start(file.path());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 1000000; ++i) {
+      Tracing::Span span("enabled");
+    }
+    Tracing::stop();
+  }
+};
@@ -8,6 +8,8 @@
 
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
+#include <algorithm>
+
 namespace Mantid {
 namespace MDAlgorithms {
 /**function converts particular list of events of type T into MD workspace and
@@ -52,12 +54,18 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   getEventsFrom(el, events_ptr);
   const typename std::vector<T> &events = *events_ptr;
 
+  // convert the units of all the events at once
+  std::vector<double> values(numEvents);
+  std::transform(events.cbegin(), events.cend(), values.begin(),
+                 [](const T &event) { return event.tof(); });
+  localUnitConv.convertUnits(values);
+
   // Iterators to start/end
-  for (auto it = events.cbegin(); it != events.cend(); it++) {
-    double val = localUnitConv.convertUnits(it->tof());
+  auto val = values.cbegin();
+  for (auto it = events.cbegin(); it != events.cend(); it++, val++) {
     double signal = it->weight();
     double errorSq = it->errorSquared();
-    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
+    if (!m_QConverter->calcMatrixCoord(*val, locCoord, signal, errorSq))
       continue; // skip ND outside the range
 
     sig_err.emplace_back(static_cast<float>(signal));
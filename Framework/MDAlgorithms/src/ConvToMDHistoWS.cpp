@@ -100,20 +100,14 @@ size_t ConvToMDHistoWS::conversionChunk(size_t startSpectra) {
 
     // convert units
     localUnitConv.updateConversion(i);
-    std::vector<double> XtargetUnits;
-    XtargetUnits.resize(X.size());
+    std::vector<double> XtargetUnits(X.begin(), X.end());
+    localUnitConv.convertUnits(XtargetUnits);
 
     if (histogram) {
-      double xm1 = localUnitConv.convertUnits(X[0]);
-      for (size_t j = 1; j < XtargetUnits.size(); j++) {
-        double xm = localUnitConv.convertUnits(X[j]);
-        XtargetUnits[j - 1] = 0.5 * (xm + xm1);
-        xm1 = xm;
-      }
-      XtargetUnits.back() = xm1; // just in case, should not be used
-    } else
-      for (size_t j = 0; j < XtargetUnits.size(); j++)
-        XtargetUnits[j] = localUnitConv.convertUnits(X[j]);
+      // bin centres; the last value is left as is and should not be used
+      for (size_t j = 1; j < XtargetUnits.size(); j++)
+        XtargetUnits[j - 1] = 0.5 * (XtargetUnits[j] + XtargetUnits[j - 1]);
+    }
 
     //=> START INTERNAL LOOP OVER THE "TIME"
     for (size_t j = 0; j < specSize; ++j) {
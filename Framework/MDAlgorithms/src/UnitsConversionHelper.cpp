@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 #include "MantidAPI/NumericAxis.h"
+#include "MantidKernel/BatchUnitConversion.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/UnitFactory.h"
 #include <cmath>
@@ -338,6 +339,33 @@ double UnitsConversionHelper::convertUnits(double val) const {
         "updateConversion: unknown type of conversion requested");
   }
 }
+/** do actual unit conversion of an array of values from input to output data
+@param   values -- the values to convert, replaced by the values in the units
+requested
+*/
+void UnitsConversionHelper::convertUnits(std::vector<double> &values) const {
+  switch (m_UnitCnvrsn) {
+  case (CnvrtToMD::ConvertNo): {
+    return;
+  }
+  case (CnvrtToMD::ConvertFast): {
+    for (auto &val : values)
+      val = m_Factor * std::pow(val, m_Power);
+    return;
+  }
+  case (CnvrtToMD::ConvertFromTOF):
+  case (CnvrtToMD::ConvertByTOF): {
+    // the source unit is TOF itself when converting from TOF
+    const Kernel::BatchUnitConversion conversion(*m_SourceWSUnit,
+                                                 *m_TargetUnit);
+    conversion.convert(values);
+    return;
+  }
+  default:
+    throw std::runtime_error(
+        "updateConversion: unknown type of conversion requested");
+  }
+}
 // copy constructor;
 UnitsConversionHelper::UnitsConversionHelper(
     const UnitsConversionHelper &another) {
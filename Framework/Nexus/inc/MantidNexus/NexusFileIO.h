@@ -108,6 +108,13 @@ public:
   /// Reset the pointer to the progress object.
   void resetProgress(Mantid::API::Progress *prog);
 
+  /// The name of the open file
+  const std::string &filename() const { return m_filename; }
+  /// Whether the file is in the NeXus XML format rather than HDF5
+  bool isXML() const;
+  /// The path of the currently open group
+  std::string currentPath() const { return m_filehandle->getPath(); }
+
   /// Nexus file handle
   NXhandle fileID;
 
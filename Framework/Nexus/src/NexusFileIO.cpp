@@ -98,8 +98,7 @@ void NexusFileIO::openNexusWrite(const std::string &fileName,
     mode = NXACC_RDWR;
 
   else {
-    if (fileName.find(".xml") < fileName.size() ||
-        fileName.find(".XML") < fileName.size()) {
+    if (isXML()) {
       mode = NXACC_CREATEXML;
       m_nexuscompression = NX_COMP_NONE;
     }
@@ -162,6 +161,11 @@ void NexusFileIO::openNexusWrite(const std::string &fileName,
 
 void NexusFileIO::closeGroup() { m_filehandle->closeGroup(); }
 
+bool NexusFileIO::isXML() const {
+  return m_filename.find(".xml") < m_filename.size() ||
+         m_filename.find(".XML") < m_filename.size();
+}
+
 //-----------------------------------------------------------------------------------------------
 void NexusFileIO::closeNexusFile() {
   if (m_filehandle) {
@@ -735,7 +739,8 @@ int NexusFileIO::writeNexusTableWorkspace(
 }
 
 //-------------------------------------------------------------------------------------
-/** Write out a combined chunk of event data
+/** Write out a combined chunk of event data. Fields whose array is NULL are
+ * not written.
  *
  * @param ws :: an EventWorkspace
  * @param indices :: array of event list indexes
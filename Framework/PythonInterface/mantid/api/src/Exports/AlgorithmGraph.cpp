@@ -0,0 +1,58 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/IAlgorithm.h"
+#include "MantidAPI/Workspace.h"
+#include "MantidPythonInterface/core/ReleaseGlobalInterpreterLock.h"
+
+#include <boost/python/class.hpp>
+
+using Mantid::API::AlgorithmGraph;
+using namespace boost::python;
+
+namespace {
+/**
+ * Execute the graph without holding the GIL, so that Python algorithms in the
+ * graph can run on the worker threads
+ * @param self :: A reference to the graph
+ * @param maxConcurrentNodes :: The maximum number of nodes to run at once
+ */
+void execute(AlgorithmGraph &self, const size_t maxConcurrentNodes) {
+  Mantid::PythonInterface::ReleaseGlobalInterpreterLock
+      releaseGlobalInterpreterLock;
+  self.execute(maxConcurrentNodes);
+}
+} // namespace
+
+void export_AlgorithmGraph() {
+  class_<AlgorithmGraph, boost::noncopyable>("AlgorithmGraph")
+      .def("addNode", &AlgorithmGraph::addNode, (arg("self"), arg("algorithm")),
+           "Adds an algorithm, with its non-workspace properties set, to the "
+           "graph and returns the ID of the new node.")
+      .def("connect", &AlgorithmGraph::connect,
+           (arg("self"), arg("producer"), arg("outputProperty"),
+            arg("consumer"), arg("inputProperty")),
+           "Passes an output workspace of the producer node to an input of the "
+           "consumer node, which must have been added after it.")
+      .def("keepOutput", &AlgorithmGraph::keepOutput,
+           (arg("self"), arg("node"), arg("outputProperty")),
+           "Keeps an output workspace after the nodes consuming it have "
+           "finished, so that it can be retrieved with getOutput.")
+      .def("execute", &execute,
+           (arg("self"), arg("maxConcurrentNodes") = 0),
+           "Executes every node of the graph, running independent nodes "
+           "concurrently. If maxConcurrentNodes is zero the number of "
+           "available cores is used.")
+      .def("getOutput", &AlgorithmGraph::getOutput,
+           (arg("self"), arg("node"), arg("outputProperty")),
+           "Returns an output workspace of a node once the graph has been "
+           "executed.")
+      .def("size", &AlgorithmGraph::size, arg("self"),
+           "Returns the number of nodes in the graph.")
+      .def("isExecuted", &AlgorithmGraph::isExecuted, arg("self"),
+           "Returns True if the graph has been executed successfully.");
+}
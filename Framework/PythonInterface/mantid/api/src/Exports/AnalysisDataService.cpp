@@ -11,6 +11,7 @@
 #include "MantidPythonInterface/core/DataServiceExporter.h"
 #include "MantidPythonInterface/core/GetPointer.h"
 
+#include <boost/python/dict.hpp>
 #include <boost/python/enum.hpp>
 #include <boost/python/list.hpp>
 #include <boost/python/overloads.hpp>
@@ -63,6 +64,21 @@ BOOST_PYTHON_FUNCTION_OVERLOADS(AdsRetrieveWorkspacesOverloads,
                                 retrieveWorkspaces, 2, 3)
 GNU_DIAG_ON("conversion")
 GNU_DIAG_ON("unused-local-typedef")
+/**
+ * @param self A reference to the AnalysisDataServiceImpl
+ * @return a python dict of the memory statistics of the ADS
+ */
+dict memoryStatistics(AnalysisDataServiceImpl &self) {
+  const auto statistics = self.memoryStatistics();
+  dict result;
+  result["budget"] = statistics.budget;
+  result["residentMemory"] = statistics.residentMemory;
+  result["spilledMemory"] = statistics.spilledMemory;
+  result["spilledWorkspaces"] = statistics.spilledWorkspaces;
+  result["spills"] = statistics.spills;
+  result["reloads"] = statistics.reloads;
+  return result;
+}
 } // namespace
 
 void export_AnalysisDataService() {
@@ -83,5 +99,15 @@ void export_AnalysisDataService() {
            "Add a workspace in the ADS to a group in the ADS")
       .def("removeFromGroup", &AnalysisDataServiceImpl::removeFromGroup,
            (arg("groupName"), arg("wsName")),
-           "Remove a workspace from a group in the ADS");
+           "Remove a workspace from a group in the ADS")
+      .def("setMemoryBudget", &AnalysisDataServiceImpl::setMemoryBudget,
+           (arg("self"), arg("bytes")),
+           "Set the memory, in bytes, that workspaces in the ADS may use "
+           "before idle workspaces are spilled to disk. Zero removes the "
+           "budget.")
+      .def("memoryBudget", &AnalysisDataServiceImpl::memoryBudget,
+           arg("self"), "Return the memory budget in bytes, zero if unset")
+      .def("memoryStatistics", memoryStatistics, arg("self"),
+           "Return a dict of the memory held by the workspaces in the ADS "
+           "and the number of workspaces spilled to disk and read back");
 }
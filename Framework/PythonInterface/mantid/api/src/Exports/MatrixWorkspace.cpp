@@ -19,9 +19,9 @@
 #include "MantidPythonInterface/core/Converters/NDArrayToVector.h"
 #include "MantidPythonInterface/core/Converters/PySequenceToVector.h"
 #include "MantidPythonInterface/core/Converters/WrapWithNDArray.h"
+#include "MantidPythonInterface/core/ExtractSharedPtr.h"
 #include "MantidPythonInterface/core/GetPointer.h"
 #include "MantidPythonInterface/core/Policies/RemoveConst.h"
-#include "MantidPythonInterface/core/Policies/VectorToNumpy.h"
 
 #include <boost/python/class.hpp>
 #include <boost/python/copy_const_reference.hpp>
@@ -52,12 +52,9 @@ namespace {
 using data_modifier =
     Mantid::MantidVec &(MatrixWorkspace::*)(const std::size_t);
 
-/// return_value_policy for read-only numpy array
-using return_readonly_numpy =
-    return_value_policy<VectorRefToNumpy<WrapReadOnly>>;
-/// return_value_policy for read-write numpy array
-using return_readwrite_numpy =
-    return_value_policy<VectorRefToNumpy<WrapReadWrite>>;
+/// Typedef for read-only data access, i.e. readX,Y,E members
+using data_accessor =
+    const Mantid::MantidVec &(MatrixWorkspace::*)(const std::size_t) const;
 
 //------------------------------- Overload macros ---------------------------
 GNU_DIAG_OFF("unused-local-typedef")
@@ -94,6 +91,77 @@ void setSpectrumFromPyObject(MatrixWorkspace &self, data_modifier accessor,
   }
 }
 
+/// Releases the workspace reference held by the base of a numpy array
+void releaseWorkspaceReference(PyObject *capsule) {
+  delete static_cast<Workspace_sptr *>(PyCapsule_GetPointer(capsule, nullptr));
+}
+
+/**
+ * Wrap the data of a spectrum in a numpy array without copying it. The array
+ * holds a reference to the workspace, so the data stays valid while the array
+ * is alive, even if the workspace is removed from the AnalysisDataService, and
+ * the service does not spill the workspace to disk meanwhile.
+ * @param self :: A reference to the calling object
+ * @param accessor :: A member-function pointer to the data{X,Y,E,Dx} or
+ * read{X,Y,E,Dx} member
+ * @param wsIndex :: The workspace index of the spectrum
+ * @return A new numpy array wrapping the data
+ */
+template <typename WrapPolicy, typename Accessor>
+PyObject *wrapSpectrumData(const object &self, Accessor accessor,
+                           const size_t wsIndex) {
+  const ExtractSharedPtr<Workspace> owner(self);
+  MatrixWorkspace &workspace = extract<MatrixWorkspace &>(self)();
+  const Mantid::MantidVec &values = (workspace.*accessor)(wsIndex);
+  PyObject *array = WrapPolicy::template apply<double>::create1D(values);
+  if (owner.check()) {
+    PyObject *capsule = PyCapsule_New(new Workspace_sptr(owner()), nullptr,
+                                      releaseWorkspaceReference);
+    PyArray_SetBaseObject(reinterpret_cast<PyArrayObject *>(array), capsule);
+  }
+  return array;
+}
+
+PyObject *readXAsNumpy(const object &self, const size_t wsIndex) {
+  return wrapSpectrumData<WrapReadOnly>(
+      self, static_cast<data_accessor>(&MatrixWorkspace::readX), wsIndex);
+}
+
+PyObject *readYAsNumpy(const object &self, const size_t wsIndex) {
+  return wrapSpectrumData<WrapReadOnly>(
+      self, static_cast<data_accessor>(&MatrixWorkspace::readY), wsIndex);
+}
+
+PyObject *readEAsNumpy(const object &self, const size_t wsIndex) {
+  return wrapSpectrumData<WrapReadOnly>(
+      self, static_cast<data_accessor>(&MatrixWorkspace::readE), wsIndex);
+}
+
+PyObject *readDxAsNumpy(const object &self, const size_t wsIndex) {
+  return wrapSpectrumData<WrapReadOnly>(
+      self, static_cast<data_accessor>(&MatrixWorkspace::readDx), wsIndex);
+}
+
+PyObject *dataXAsNumpy(const object &self, const size_t wsIndex) {
+  return wrapSpectrumData<WrapReadWrite>(
+      self, static_cast<data_modifier>(&MatrixWorkspace::dataX), wsIndex);
+}
+
+PyObject *dataYAsNumpy(const object &self, const size_t wsIndex) {
+  return wrapSpectrumData<WrapReadWrite>(
+      self, static_cast<data_modifier>(&MatrixWorkspace::dataY), wsIndex);
+}
+
+PyObject *dataEAsNumpy(const object &self, const size_t wsIndex) {
+  return wrapSpectrumData<WrapReadWrite>(
+      self, static_cast<data_modifier>(&MatrixWorkspace::dataE), wsIndex);
+}
+
+PyObject *dataDxAsNumpy(const object &self, const size_t wsIndex) {
+  return wrapSpectrumData<WrapReadWrite>(
+      self, static_cast<data_modifier>(&MatrixWorkspace::dataDx), wsIndex);
+}
+
 /**
  * Set a workspace as monitor workspace for current workspace.
  *
@@ -457,23 +525,19 @@ void export_MatrixWorkspace() {
 
       //--------------------------------------- Read spectrum data
       //-------------------------
-      .def("readX", &MatrixWorkspace::readX,
-           (arg("self"), arg("workspaceIndex")), return_readonly_numpy(),
+      .def("readX", &readXAsNumpy, (arg("self"), arg("workspaceIndex")),
            "Creates a read-only numpy wrapper "
            "around the original X data at the "
            "given index")
-      .def("readY", &MatrixWorkspace::readY, return_readonly_numpy(),
-           args("self", "workspaceIndex"),
+      .def("readY", &readYAsNumpy, args("self", "workspaceIndex"),
            "Creates a read-only numpy wrapper "
            "around the original Y data at the "
            "given index")
-      .def("readE", &MatrixWorkspace::readE, return_readonly_numpy(),
-           args("self", "workspaceIndex"),
+      .def("readE", &readEAsNumpy, args("self", "workspaceIndex"),
            "Creates a read-only numpy wrapper "
            "around the original E data at the "
            "given index")
-      .def("readDx", &MatrixWorkspace::readDx, return_readonly_numpy(),
-           args("self", "workspaceIndex"),
+      .def("readDx", &readDxAsNumpy, args("self", "workspaceIndex"),
            "Creates a read-only numpy wrapper "
            "around the original Dx data at the "
            "given index")
@@ -482,20 +546,16 @@ void export_MatrixWorkspace() {
            "False.")
       //--------------------------------------- Write spectrum data
       //------------------------
-      .def("dataX", (data_modifier)&MatrixWorkspace::dataX,
-           return_readwrite_numpy(), args("self", "workspaceIndex"),
+      .def("dataX", &dataXAsNumpy, args("self", "workspaceIndex"),
            "Creates a writable numpy wrapper around the original X data at the "
            "given index")
-      .def("dataY", (data_modifier)&MatrixWorkspace::dataY,
-           return_readwrite_numpy(), args("self", "workspaceIndex"),
+      .def("dataY", &dataYAsNumpy, args("self", "workspaceIndex"),
            "Creates a writable numpy wrapper around the original Y data at the "
            "given index")
-      .def("dataE", (data_modifier)&MatrixWorkspace::dataE,
-           return_readwrite_numpy(), args("self", "workspaceIndex"),
+      .def("dataE", &dataEAsNumpy, args("self", "workspaceIndex"),
            "Creates a writable numpy wrapper around the original E data at the "
            "given index")
-      .def("dataDx", (data_modifier)&MatrixWorkspace::dataDx,
-           return_readwrite_numpy(), args("self", "workspaceIndex"),
+      .def("dataDx", &dataDxAsNumpy, args("self", "workspaceIndex"),
            "Creates a writable numpy wrapper around the original Dx data at "
            "the given index")
       .def("setX", &setXFromPyObject, args("self", "workspaceIndex", "x"),
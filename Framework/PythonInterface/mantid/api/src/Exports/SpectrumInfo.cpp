@@ -8,6 +8,7 @@
 #include "MantidAPI/SpectrumInfoItem.h"
 #include "MantidAPI/SpectrumInfoIterator.h"
 #include "MantidPythonInterface/api/SpectrumInfoPythonIterator.h"
+#include "MantidPythonInterface/core/Policies/VectorToNumpy.h"
 #include "MantidTypes/SpectrumDefinition.h"
 
 #include <boost/python/class.hpp>
@@ -20,8 +21,16 @@ using Mantid::API::SpectrumInfo;
 using Mantid::API::SpectrumInfoItem;
 using Mantid::API::SpectrumInfoIterator;
 using Mantid::PythonInterface::SpectrumInfoPythonIterator;
+using Mantid::PythonInterface::Policies::VectorRefToNumpy;
+using Mantid::PythonInterface::Converters::WrapReadOnly;
 using namespace boost::python;
 
+namespace {
+/// return_value_policy for read-only numpy array
+using return_readonly_numpy =
+    return_value_policy<VectorRefToNumpy<WrapReadOnly>>;
+} // namespace
+
 // Helper method to make the python iterator
 SpectrumInfoPythonIterator make_pyiterator(SpectrumInfo &spectrumInfo) {
   return SpectrumInfoPythonIterator(spectrumInfo);
@@ -78,5 +87,31 @@ void export_SpectrumInfo() {
            "Returns the SpectrumDefinition of the spectrum with the given "
            "index.")
       .def("detectorCount", &SpectrumInfo::detectorCount, arg("self"),
-           "Returns the total number of detectors used across spectrum info.");
+           "Returns the total number of detectors used across spectrum info.")
+      .def("l2s", &SpectrumInfo::l2s, return_readonly_numpy(), arg("self"),
+           "Returns a read-only numpy array with the distance from the sample "
+           "to each spectrum.")
+      .def("twoThetas", &SpectrumInfo::twoThetas, return_readonly_numpy(),
+           arg("self"),
+           "Returns a read-only numpy array with the scattering angle 2 theta "
+           "in radians of each spectrum. Monitors are NaN.")
+      .def("signedTwoThetas", &SpectrumInfo::signedTwoThetas,
+           return_readonly_numpy(), arg("self"),
+           "Returns a read-only numpy array with the signed scattering angle 2 "
+           "theta in radians of each spectrum. Monitors are NaN.")
+      .def("azimuthals", &SpectrumInfo::azimuthals, return_readonly_numpy(),
+           arg("self"),
+           "Returns a read-only numpy array with the out-of-plane angle in "
+           "radians of each spectrum. Monitors are NaN.")
+      .def("difcs", &SpectrumInfo::difcs, return_readonly_numpy(), arg("self"),
+           "Returns a read-only numpy array with the uncalibrated DIFC of each "
+           "spectrum. Monitors are NaN.")
+      .def("eFixeds", &SpectrumInfo::eFixeds, return_readonly_numpy(),
+           arg("self"),
+           "Returns a read-only numpy array with the fixed energy of each "
+           "spectrum.")
+      .def("solidAngles", &SpectrumInfo::solidAngles, return_readonly_numpy(),
+           arg("self"),
+           "Returns a read-only numpy array with the solid angle of each "
+           "spectrum as seen from the sample.");
 }
@@ -10,6 +10,10 @@
 #include <boost/python/register_ptr_to_python.hpp>
 #include <boost/python/return_arg.hpp>
 
+#define PY_ARRAY_UNIQUE_SYMBOL DATAOBJECTS_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+
 using namespace boost::python;
 using namespace Mantid::DataObjects;
 
@@ -27,6 +31,40 @@ void addWeightedEventToEventList(EventList &self, double tof, double weight,
   self.addEventQuickly(WeightedEvent(
       Mantid::Types::Event::TofEvent(tof, pulsetime), weight, errorsquare));
 }
+
+/**
+ * Wraps a field of the stored events as a read-only numpy array without
+ * copying. The array keeps the python event list alive, but is invalidated by
+ * any change to the list.
+ * @param self :: The python event list
+ * @param field :: The location of the field
+ * @param typenum :: The numpy type of the field
+ */
+PyObject *wrapField(const object &self, const EventList::StridedField &field,
+                    const int typenum) {
+  const EventList &eventList = extract<const EventList &>(self)();
+  npy_intp dims[1] = {static_cast<npy_intp>(eventList.getNumberEvents())};
+  if (!field.data)
+    return PyArray_SimpleNew(1, dims, typenum);
+  npy_intp strides[1] = {static_cast<npy_intp>(field.stride)};
+  PyObject *array = PyArray_New(
+      &PyArray_Type, 1, dims, typenum, strides,
+      static_cast<void *>(const_cast<char *>(field.data)), 0,
+      NPY_ARRAY_ALIGNED, nullptr);
+  Py_INCREF(self.ptr());
+  PyArray_SetBaseObject(reinterpret_cast<PyArrayObject *>(array), self.ptr());
+  return array;
+}
+
+PyObject *tofsView(const object &self) {
+  return wrapField(self, extract<const EventList &>(self)().tofField(),
+                   NPY_DOUBLE);
+}
+
+PyObject *pulseTimesView(const object &self) {
+  return wrapField(self, extract<const EventList &>(self)().pulseTimeField(),
+                   NPY_INT64);
+}
 } // namespace
 
 void export_EventList() {
@@ -40,6 +78,13 @@ void export_EventList() {
       .def("addWeightedEventQuickly", &addWeightedEventToEventList,
            args("self", "tof", "weight", "errorsquare", "pulsetime"),
            "Create weighted TofEvent and add to eventlist")
+      .def("tofsView", &tofsView, arg("self"),
+           "Returns a read-only numpy array viewing the TOFs of the events in "
+           "place. It is invalidated by any change to the event list.")
+      .def("pulseTimesView", &pulseTimesView, arg("self"),
+           "Returns a read-only numpy array viewing the pulse times of the "
+           "events in place, in nanoseconds since 1990-01-01. It is "
+           "invalidated by any change to the event list.")
       .def("__iadd__",
            (EventList & (EventList::*)(const EventList &)) &
                EventList::operator+=,
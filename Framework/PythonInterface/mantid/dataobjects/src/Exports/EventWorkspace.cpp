@@ -5,22 +5,189 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidPythonInterface/api/RegisterWorkspacePtrToPython.h"
+#include "MantidPythonInterface/core/ExtractSharedPtr.h"
 #include "MantidPythonInterface/core/GetPointer.h"
+#include "MantidPythonInterface/core/ReleaseGlobalInterpreterLock.h"
 
 #include <boost/python/class.hpp>
+#include <boost/python/dict.hpp>
+#include <boost/python/iterator.hpp>
 #include <boost/python/object/inheritance.hpp>
 
+#define PY_ARRAY_UNIQUE_SYMBOL DATAOBJECTS_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+
+#include <stdexcept>
+
 using Mantid::API::IEventWorkspace;
+using Mantid::API::Workspace;
 using Mantid::DataObjects::EventWorkspace;
+using Mantid::DataObjects::EventWorkspace_const_sptr;
+using Mantid::PythonInterface::ExtractSharedPtr;
+using Mantid::PythonInterface::ReleaseGlobalInterpreterLock;
 using namespace Mantid::PythonInterface::Registry;
 using namespace boost::python;
 
 GET_POINTER_SPECIALIZATION(EventWorkspace)
 
+namespace {
+/// Creates an uninitialized one-dimensional numpy array
+PyArrayObject *newArray(const size_t size, const int typenum) {
+  npy_intp dims[1] = {static_cast<npy_intp>(size)};
+  return reinterpret_cast<PyArrayObject *>(PyArray_SimpleNew(1, dims, typenum));
+}
+
+/// Transfers ownership of an array to a python object
+object toObject(PyArrayObject *array) {
+  return object(handle<>(reinterpret_cast<PyObject *>(array)));
+}
+
+/**
+ * Copies the events of a range of spectra into numpy arrays, which are
+ * filled in parallel with the GIL released
+ * @param self :: The workspace
+ * @param start :: The first workspace index
+ * @param stop :: One past the last workspace index
+ * @returns A dict of the arrays: tof, pulsetime (nanoseconds since the
+ * DateAndTime epoch), weight and error, which hold the events of each spectrum
+ * in turn, and offsets, whose entries i and i + 1 bound the events of spectrum
+ * start + i
+ */
+dict eventColumns(const EventWorkspace &self, const size_t start,
+                  const size_t stop) {
+  const size_t numSpectra = stop - start;
+  auto *offsets = newArray(numSpectra + 1, NPY_INT64);
+  auto *offsetData = static_cast<npy_int64 *>(PyArray_DATA(offsets));
+  offsetData[0] = 0;
+  for (size_t i = 0; i < numSpectra; ++i) {
+    offsetData[i + 1] = offsetData[i] + static_cast<npy_int64>(
+                                            self.getSpectrum(start + i)
+                                                .getNumberEvents());
+  }
+  const auto numEvents = static_cast<size_t>(offsetData[numSpectra]);
+  auto *tofs = newArray(numEvents, NPY_DOUBLE);
+  auto *pulseTimes = newArray(numEvents, NPY_INT64);
+  auto *weights = newArray(numEvents, NPY_DOUBLE);
+  auto *errors = newArray(numEvents, NPY_DOUBLE);
+  auto *tofData = static_cast<double *>(PyArray_DATA(tofs));
+  auto *pulseTimeData = static_cast<int64_t *>(PyArray_DATA(pulseTimes));
+  auto *weightData = static_cast<double *>(PyArray_DATA(weights));
+  auto *errorData = static_cast<double *>(PyArray_DATA(errors));
+  {
+    ReleaseGlobalInterpreterLock releaseGIL;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(numSpectra); ++i) {
+      const auto offset = offsetData[i];
+      self.getSpectrum(start + static_cast<size_t>(i))
+          .copyColumns(tofData + offset, pulseTimeData + offset,
+                       weightData + offset, errorData + offset);
+    }
+  }
+  dict columns;
+  columns["workspaceIndex"] = start;
+  columns["offsets"] = toObject(offsets);
+  columns["tof"] = toObject(tofs);
+  columns["pulsetime"] = toObject(pulseTimes);
+  columns["weight"] = toObject(weights);
+  columns["error"] = toObject(errors);
+  return columns;
+}
+
+/**
+ * Copies the events of a range of spectra into numpy arrays
+ * @param self :: The workspace
+ * @param startIndex :: The first workspace index
+ * @param stopIndex :: One past the last workspace index, or -1 for all
+ * remaining spectra
+ */
+dict extractEventColumns(const EventWorkspace &self, const size_t startIndex,
+                         const int64_t stopIndex) {
+  const size_t numSpectra = self.getNumberHistograms();
+  const size_t stop =
+      stopIndex < 0 ? numSpectra : static_cast<size_t>(stopIndex);
+  if (stop > numSpectra || startIndex > stop) {
+    throw std::out_of_range("extractEventColumns: invalid workspace index "
+                            "range for a workspace of " +
+                            std::to_string(numSpectra) + " spectra");
+  }
+  return eventColumns(self, startIndex, stop);
+}
+
+/// Yields the event columns of consecutive blocks of whole spectra, so that
+/// the events of a large workspace can be processed without copying all of
+/// them at once. The iterator holds the workspace, so it stays valid if the
+/// workspace is removed from the AnalysisDataService.
+class EventColumnsPythonIterator {
+public:
+  EventColumnsPythonIterator(EventWorkspace_const_sptr workspace,
+                             const size_t maxEvents)
+      : m_workspace(std::move(workspace)), m_maxEvents(maxEvents) {}
+
+  /// Returns the columns of the next block, which holds at least one
+  /// spectrum and otherwise at most maxEvents events
+  dict next() {
+    const size_t numSpectra = m_workspace->getNumberHistograms();
+    if (m_next >= numSpectra)
+      objects::stop_iteration_error();
+    size_t stop = m_next + 1;
+    size_t numEvents = m_workspace->getSpectrum(m_next).getNumberEvents();
+    while (stop < numSpectra) {
+      const size_t spectrumEvents =
+          m_workspace->getSpectrum(stop).getNumberEvents();
+      if (numEvents + spectrumEvents > m_maxEvents)
+        break;
+      numEvents += spectrumEvents;
+      ++stop;
+    }
+    const size_t start = m_next;
+    m_next = stop;
+    return eventColumns(*m_workspace, start, stop);
+  }
+
+private:
+  const EventWorkspace_const_sptr m_workspace;
+  const size_t m_maxEvents;
+  size_t m_next = 0;
+};
+
+EventColumnsPythonIterator iterEventColumns(const object &self,
+                                            const size_t maxEvents) {
+  if (maxEvents == 0)
+    throw std::invalid_argument("iterEventColumns: maxEvents must be positive");
+  const ExtractSharedPtr<Workspace> extracted(self);
+  if (!extracted.check())
+    throw std::runtime_error("Variable invalidated, data has been deleted.");
+  auto workspace =
+      std::dynamic_pointer_cast<const EventWorkspace>(extracted());
+  if (!workspace)
+    throw std::invalid_argument("iterEventColumns: expected an EventWorkspace");
+  return EventColumnsPythonIterator(std::move(workspace), maxEvents);
+}
+} // namespace
+
 void export_EventWorkspace() {
+  class_<EventColumnsPythonIterator>("EventColumnsPythonIterator", no_init)
+      .def("__iter__", objects::identity_function())
+      .def("__next__", &EventColumnsPythonIterator::next);
+
   class_<EventWorkspace, bases<IEventWorkspace>, boost::noncopyable>(
-      "EventWorkspace", no_init);
+      "EventWorkspace", no_init)
+      .def("extractEventColumns", &extractEventColumns,
+           (arg("self"), arg("startIndex") = 0, arg("stopIndex") = -1),
+           "Returns a dict of numpy arrays holding the events of the given "
+           "spectra: 'tof', 'pulsetime' (nanoseconds since 1990-01-01), "
+           "'weight' and 'error', with the events of spectrum "
+           "startIndex + i between offsets[i] and offsets[i + 1] of "
+           "'offsets'. The arrays are filled in parallel.")
+      .def("iterEventColumns", &iterEventColumns,
+           (arg("self"), arg("maxEvents") = 10000000),
+           "Returns an iterator over blocks of whole spectra, yielding for "
+           "each the dict of extractEventColumns, whose 'workspaceIndex' is "
+           "the first spectrum of the block. A block holds at most "
+           "maxEvents events unless a single spectrum has more.");
 
   // register pointers
   RegisterWorkspacePtrToPython<EventWorkspace>();
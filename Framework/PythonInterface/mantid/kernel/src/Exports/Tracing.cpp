@@ -0,0 +1,81 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/Tracing.h"
+#include "MantidKernel/WarningSuppressions.h"
+
+#include <boost/python/class.hpp>
+#include <boost/python/overloads.hpp>
+#include <boost/python/scope.hpp>
+
+using Mantid::Kernel::Tracing::Span;
+using namespace boost::python;
+
+namespace {
+///@cond
+// Dummy class used to define the Tracing scope
+class TracingScope {};
+
+GNU_DIAG_OFF("unused-local-typedef")
+// Ignore -Wconversion warnings coming from boost::python
+// Seen with GCC 7.1.1 and Boost 1.63.0
+GNU_DIAG_OFF("conversion")
+// Define an overload to handle the default argument
+BOOST_PYTHON_FUNCTION_OVERLOADS(startOverloads, Mantid::Kernel::Tracing::start,
+                                0, 1)
+GNU_DIAG_ON("conversion")
+GNU_DIAG_ON("unused-local-typedef")
+///@endcond
+
+/// Entering a with block returns the span itself
+object enterSpan(object self) { return self; }
+
+/// Leaving a with block ends the span
+void exitSpan(Span &self, const object &, const object &, const object &) {
+  self.end();
+}
+} // namespace
+
+void export_Tracing() {
+  // define a new "Tracing" scope so that everything is called as
+  // Tracing.xxx
+  scope tracing =
+      class_<TracingScope>("Tracing", no_init)
+          .def("start", &Mantid::Kernel::Tracing::start,
+               startOverloads(arg("filename"),
+                              "Begin a new trace, written to the given file "
+                              "(default: mantid_trace.json) when stopped"))
+          .staticmethod("start")
+          .def("stop", &Mantid::Kernel::Tracing::stop,
+               "End the trace and write it out. Returns the file name")
+          .staticmethod("stop")
+          .def("isEnabled", &Mantid::Kernel::Tracing::isEnabled,
+               "Returns True if events are being recorded")
+          .staticmethod("isEnabled")
+          .def("counter", &Mantid::Kernel::Tracing::counter,
+               (arg("name"), arg("value")),
+               "Record the current value of a counter")
+          .staticmethod("counter")
+          .def("recordMemoryUsage", &Mantid::Kernel::Tracing::recordMemoryUsage,
+               "Record the current and peak resident memory of the process")
+          .staticmethod("recordMemoryUsage")
+          .def("toJSON", &Mantid::Kernel::Tracing::toJSON,
+               "Returns the events recorded so far in the Chrome trace format")
+          .staticmethod("toJSON");
+
+  // Want this in the same scope as above so must be here
+  class_<Span, boost::noncopyable>(
+      "Span", init<std::string>((arg("self"), arg("name")),
+                                "Begin a span, ended by end() or by leaving a "
+                                "with block"))
+      .def("addArgument", &Span::addArgument,
+           (arg("self"), arg("name"), arg("value")),
+           "Attach a value shown with the span")
+      .def("end", &Span::end, arg("self"), "End the span")
+      .def("__enter__", &enterSpan, arg("self"))
+      .def("__exit__", &exitSpan,
+           (arg("self"), arg("type"), arg("value"), arg("traceback")));
+}
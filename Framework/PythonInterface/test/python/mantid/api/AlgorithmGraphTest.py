@@ -0,0 +1,50 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+#   NScD Oak Ridge National Laboratory, European Spallation Source,
+#   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+# SPDX - License - Identifier: GPL - 3.0 +
+import unittest
+from mantid.api import AlgorithmGraph, AlgorithmManager, FrameworkManagerImpl
+
+
+def _create_workspace(value):
+    alg = AlgorithmManager.createUnmanaged("CreateWorkspace")
+    alg.initialize()
+    alg.setProperty("DataX", [0., 1.])
+    alg.setProperty("DataY", [value])
+    return alg
+
+
+class AlgorithmGraphTest(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        FrameworkManagerImpl.Instance()
+
+    def test_graph_executes_connected_algorithms(self):
+        graph = AlgorithmGraph()
+        lhs = graph.addNode(_create_workspace(1.))
+        rhs = graph.addNode(_create_workspace(2.))
+        plus = AlgorithmManager.createUnmanaged("Plus")
+        plus.initialize()
+        total = graph.addNode(plus)
+        graph.connect(lhs, "OutputWorkspace", total, "LHSWorkspace")
+        graph.connect(rhs, "OutputWorkspace", total, "RHSWorkspace")
+        self.assertEqual(graph.size(), 3)
+
+        graph.execute()
+
+        self.assertTrue(graph.isExecuted())
+        self.assertEqual(graph.getOutput(total, "OutputWorkspace").readY(0)[0], 3.)
+        self.assertRaises(ValueError, graph.getOutput, lhs, "OutputWorkspace")
+
+    def test_bad_connection_raises(self):
+        graph = AlgorithmGraph()
+        source = graph.addNode(_create_workspace(1.))
+        self.assertRaises(ValueError, graph.connect, source, "OutputWorkspace",
+                          source, "InputWorkspace")
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -5,6 +5,7 @@
 #   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 # SPDX - License - Identifier: GPL - 3.0 +
 import unittest
+import numpy as np
 from testhelpers import run_algorithm
 from mantid.api import (AnalysisDataService, AnalysisDataServiceImpl,
                         FrameworkManagerImpl, MatrixWorkspace, Workspace)
@@ -192,6 +193,43 @@ class AnalysisDataServiceTest(unittest.TestCase):
         self.assertEqual(group.size(), 2)
         self.assertCountEqual(group.getNames(), ["ws1", "ws2"])
 
+    def test_idle_workspaces_are_spilled_and_read_back_with_a_memory_budget(self):
+        from mantid.simpleapi import CreateSampleWorkspace
+        CreateSampleWorkspace(OutputWorkspace="spilled")
+        handle = mtd['spilled']
+        expected = handle.readY(0).copy()
+        before = AnalysisDataService.memoryStatistics()
+        try:
+            AnalysisDataService.setMemoryBudget(1)
+            self.assertEqual(AnalysisDataService.memoryBudget(), 1)
+            statistics = AnalysisDataService.memoryStatistics()
+            self.assertEqual(statistics['spills'] - before['spills'], 1)
+            self.assertEqual(statistics['spilledWorkspaces'], 1)
+
+            # The handle taken before spilling reads the data back
+            np.testing.assert_array_equal(handle.readY(0), expected)
+            self.assertEqual(AnalysisDataService.memoryStatistics()['reloads'] - before['reloads'], 1)
+        finally:
+            AnalysisDataService.setMemoryBudget(0)
+
+    def test_arrays_held_from_a_workspace_stay_valid_with_a_memory_budget(self):
+        from mantid.simpleapi import CreateSampleWorkspace
+        CreateSampleWorkspace(OutputWorkspace="held")
+        y = mtd['held'].readY(0)
+        expected = y.copy()
+        before = AnalysisDataService.memoryStatistics()
+        try:
+            # The array holds the workspace, so it is not spilled
+            AnalysisDataService.setMemoryBudget(1)
+            self.assertEqual(AnalysisDataService.memoryStatistics()['spills'], before['spills'])
+            np.testing.assert_array_equal(y, expected)
+
+            # Nor is the data freed when the workspace is removed
+            AnalysisDataService.remove("held")
+            np.testing.assert_array_equal(y, expected)
+        finally:
+            AnalysisDataService.setMemoryBudget(0)
+
 
 if __name__ == '__main__':
     unittest.main()
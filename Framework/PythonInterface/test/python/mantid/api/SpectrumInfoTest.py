@@ -5,6 +5,7 @@
 #   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 # SPDX - License - Identifier: GPL - 3.0 +
 import unittest
+import numpy as np
 from testhelpers import WorkspaceCreationHelper
 from mantid.kernel import V3D
 from mantid.api import SpectrumDefinition
@@ -100,6 +101,23 @@ class SpectrumInfoTest(unittest.TestCase):
         self.assertEqual(info.hasUniqueDetector(0), False)
         self.assertEqual(info.hasUniqueDetector(1), True)
 
+    def test_bulk_columns(self):
+        """ Check that the bulk geometry columns match per-spectrum values. """
+        info = self._ws.spectrumInfo()
+        l2s = info.l2s()
+        twoThetas = info.twoThetas()
+        self.assertTrue(isinstance(l2s, np.ndarray))
+        self.assertEqual(len(l2s), 3)
+        self.assertFalse(l2s.flags.writeable)
+        # Spectrum 0 has no detectors
+        self.assertTrue(np.isnan(l2s[0]))
+        self.assertAlmostEqual(l2s[1], info.l2(1))
+        self.assertAlmostEqual(twoThetas[1], info.twoTheta(1))
+        self.assertAlmostEqual(info.signedTwoThetas()[2], info.signedTwoTheta(2))
+        self.assertEqual(len(info.azimuthals()), 3)
+        self.assertEqual(len(info.difcs()), 3)
+        self.assertEqual(len(info.solidAngles()), 3)
+
     """
     The following are test cases test for returned V3D objects. The objects
     represent a vector in 3 dimensions.
@@ -0,0 +1,86 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+#   NScD Oak Ridge National Laboratory, European Spallation Source,
+#   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+# SPDX - License - Identifier: GPL - 3.0 +
+# pylint: disable=invalid-name, too-many-public-methods
+import unittest
+import numpy as np
+
+from mantid.kernel import DateAndTime
+from mantid.simpleapi import CreateSampleWorkspace, DeleteWorkspace
+from mantid.dataobjects import EventList
+
+
+class EventWorkspaceTest(unittest.TestCase):
+
+    def setUp(self):
+        self.ws = CreateSampleWorkspace(WorkspaceType='Event', NumBanks=1, BankPixelWidth=3,
+                                        NumEvents=20, OutputWorkspace='EventWorkspaceTest_ws')
+
+    def tearDown(self):
+        DeleteWorkspace(self.ws)
+
+    def check_columns(self, columns, start, stop):
+        offsets = columns['offsets']
+        self.assertEqual(len(offsets), stop - start + 1)
+        self.assertEqual(offsets[0], 0)
+        self.assertEqual(len(columns['tof']), offsets[-1])
+        for i in range(stop - start):
+            spectrum = self.ws.getSpectrum(start + i)
+            events = slice(offsets[i], offsets[i + 1])
+            np.testing.assert_equal(columns['tof'][events], spectrum.getTofs())
+            np.testing.assert_equal(columns['weight'][events], spectrum.getWeights())
+            np.testing.assert_equal(columns['error'][events], spectrum.getWeightErrors())
+            np.testing.assert_equal(columns['pulsetime'][events],
+                                    [time.totalNanoseconds() for time in spectrum.getPulseTimes()])
+
+    def test_extractEventColumns_returns_all_events(self):
+        columns = self.ws.extractEventColumns()
+        self.assertEqual(columns['workspaceIndex'], 0)
+        self.assertEqual(len(columns['tof']), self.ws.getNumberEvents())
+        self.check_columns(columns, 0, self.ws.getNumberHistograms())
+
+    def test_extractEventColumns_with_index_range(self):
+        self.check_columns(self.ws.extractEventColumns(2, 5), 2, 5)
+        self.assertRaises(IndexError, self.ws.extractEventColumns, 0, 100)
+
+    def test_iterEventColumns_yields_blocks_of_whole_spectra(self):
+        numSpectra = self.ws.getNumberHistograms()
+        maxEvents = self.ws.getSpectrum(0).getNumberEvents() * 2
+        start = 0
+        for columns in self.ws.iterEventColumns(maxEvents):
+            self.assertEqual(columns['workspaceIndex'], start)
+            stop = start + len(columns['offsets']) - 1
+            self.assertTrue(stop > start)
+            self.assertTrue(stop - start == 1 or len(columns['tof']) <= maxEvents)
+            self.check_columns(columns, start, stop)
+            start = stop
+        self.assertEqual(start, numSpectra)
+
+    def test_iterEventColumns_holds_the_workspace(self):
+        numEvents = self.ws.getNumberEvents()
+        blocks = self.ws.iterEventColumns(1)
+        DeleteWorkspace(self.ws)
+        self.assertEqual(sum(len(columns['tof']) for columns in blocks), numEvents)
+        self.ws = CreateSampleWorkspace(WorkspaceType='Event', NumBanks=1, BankPixelWidth=3,
+                                        NumEvents=20, OutputWorkspace='EventWorkspaceTest_ws')
+
+    def test_event_list_views_do_not_copy(self):
+        el = EventList()
+        for i in range(5):
+            el.addEventQuickly(float(i) + 0.5, DateAndTime(42 + i))
+        tofs = el.tofsView()
+        times = el.pulseTimesView()
+        np.testing.assert_equal(tofs, el.getTofs())
+        np.testing.assert_equal(times, np.arange(42, 47))
+        self.assertFalse(tofs.flags.writeable)
+        self.assertFalse(tofs.flags.owndata)
+        del el
+        # The views keep the event list alive
+        self.assertEqual(tofs[4], 4.5)
+
+
+if __name__ == '__main__':
+    unittest.main()
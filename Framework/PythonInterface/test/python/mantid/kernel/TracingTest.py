@@ -0,0 +1,46 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+#   NScD Oak Ridge National Laboratory, European Spallation Source,
+#   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+# SPDX - License - Identifier: GPL - 3.0 +
+import json
+import os
+import tempfile
+import unittest
+
+from mantid.kernel import Tracing
+
+
+class TracingTest(unittest.TestCase):
+
+    def setUp(self):
+        handle, self._filename = tempfile.mkstemp(suffix='.json')
+        os.close(handle)
+
+    def tearDown(self):
+        if Tracing.isEnabled():
+            Tracing.stop()
+        os.remove(self._filename)
+
+    def test_spans_and_counters_are_written(self):
+        Tracing.start(self._filename)
+        self.assertTrue(Tracing.isEnabled())
+        with Tracing.Span('script step') as span:
+            span.addArgument('items', 2)
+            Tracing.counter('Files reduced', 1)
+        self.assertEqual(Tracing.stop(), self._filename)
+        self.assertFalse(Tracing.isEnabled())
+
+        with open(self._filename) as trace:
+            events = json.load(trace)['traceEvents']
+        names = [event['name'] for event in events]
+        self.assertTrue('script step' in names)
+        self.assertTrue('Files reduced' in names)
+
+    def test_toJSON_when_disabled_is_empty(self):
+        self.assertEqual(json.loads(Tracing.toJSON())['traceEvents'], [])
+
+
+if __name__ == '__main__':
+    unittest.main()